@@ -347,6 +347,38 @@ namespace Problems
 
 		typedef Chromosome::Representation::GaSDAChromosome<int>::GaType CspChromosome;
 
+		class CspChromosomeComparator : public Chromosome::GaChromosomeComparator
+		{
+
+		public:
+
+			virtual float GACALL operator ()(const Chromosome::GaChromosome& chromosome1,
+				const Chromosome::GaChromosome& chromosome2,
+				const Chromosome::GaChromosomeComparatorParams& parameters) const { return Equal( chromosome1, chromosome2, parameters ) ? 0.0f : 1.0f; }
+
+			virtual bool GACALL Equal(const Chromosome::GaChromosome& chromosome1,
+				const Chromosome::GaChromosome& chromosome2,
+				const Chromosome::GaChromosomeComparatorParams& parameters) const
+				{ return ( (const CspChromosome&)chromosome1 ).GetGenes() == ( (const CspChromosome&)chromosome2 ).GetGenes(); }
+
+			virtual bool GACALL GetHash(const Chromosome::GaChromosome& chromosome,
+				const Chromosome::GaChromosomeComparatorParams& parameters,
+				unsigned long long& hash) const
+			{
+				// genes store order in which items are placed, so the order is hashed
+				const Common::Data::GaSingleDimensionArray<int>& genes = ( (const CspChromosome&)chromosome ).GetGenes();
+
+				hash = 14695981039346656037ULL;
+				for( int i = 0; i < genes.GetSize(); i++ )
+					hash = ( hash ^ (unsigned int)genes[ i ] ) * 1099511628211ULL;
+
+				return true;
+			}
+
+			virtual Common::GaParameters* GACALL CreateParameters() const { return NULL; }
+
+		};
+
 		class CspInitializator : public Chromosome::GaInitializator
 		{
 
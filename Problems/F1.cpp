@@ -65,6 +65,30 @@ namespace Problems
 			values[ 1 ] = x * x;
 		}
 
+		void F1FitnessOperation::EvaluateBatch(const Chromosome::GaChromosome* const* objects,
+			Fitness::GaFitness* const* fitness,
+			int count,
+			const Fitness::GaFitnessOperationParams& operationParams) const
+		{
+			float x[ MAX_BATCH_SIZE ], f1[ MAX_BATCH_SIZE ], f2[ MAX_BATCH_SIZE ];
+
+			for( int i = 0; i < count; i++ )
+				x[ i ] = ( (const F1Chromosome*)objects[ i ] )->GetGene();
+
+			for( int i = 0; i < count; i++ )
+			{
+				f1[ i ] = x[ i ] * x[ i ];
+				f2[ i ] = ( x[ i ] - 2 ) * ( x[ i ] - 2 );
+			}
+
+			for( int i = 0; i < count; i++ )
+			{
+				Common::Data::GaSingleDimensionArray<float>& values = ( (F1Fitness*)fitness[ i ] )->GetTypedValues();
+				values[ 0 ] = f1[ i ];
+				values[ 1 ] = f2[ i ];
+			}
+		}
+
 		Chromosome::GaChromosomePtr F1Initializator::operator ()(bool empty,
 			const Chromosome::GaInitializatorParams& parameters,
 			Common::Memory::GaSmartPtr<Chromosome::GaChromosomeConfigBlock> configBlock) const
@@ -2,6 +2,7 @@
 #ifndef __PR_F1_H__
 #define __PR_F1_H__
 
+#include <cstring>
 #include "..\source\ChromosomeOperations.h"
 #include "..\source\Representation.h"
 #include "..\source\FitnessValues.h"
@@ -53,6 +54,13 @@ namespace Problems
 				Fitness::GaFitness& fitness,
 				const Fitness::GaFitnessOperationParams& operationParams) const;
 
+			virtual void GACALL EvaluateBatch(const Chromosome::GaChromosome* const* objects,
+				Fitness::GaFitness* const* fitness,
+				int count,
+				const Fitness::GaFitnessOperationParams& operationParams) const;
+
+			virtual int GACALL GetBatchSize() const { return 16; }
+
 			virtual Fitness::GaFitness* GACALL CreateFitnessObject(Common::Memory::GaSmartPtr<const Fitness::GaFitnessParams> params) const { return new F1Fitness( params ); }
 
 			virtual Common::GaParameters* GACALL CreateParameters() const { return NULL; }
@@ -87,6 +95,20 @@ namespace Problems
 				const Chromosome::GaChromosome& chromosome2,
 				const Chromosome::GaChromosomeComparatorParams& parameters) const { return ( (F1Chromosome&)chromosome1 ).GetGene() == ( (F1Chromosome&)chromosome2 ).GetGene(); }
 
+			virtual bool GACALL GetHash(const Chromosome::GaChromosome& chromosome,
+				const Chromosome::GaChromosomeComparatorParams& parameters,
+				unsigned long long& hash) const
+			{
+				// positive and negative zeros are equal so they must have same hash
+				float gene = ( (const F1Chromosome&)chromosome ).GetGene();
+				unsigned int bits = 0;
+				if( gene != 0 )
+					memcpy( &bits, &gene, sizeof( gene ) );
+
+				hash = bits;
+				return true;
+			}
+
 			virtual Common::GaParameters* GACALL CreateParameters() const { return NULL; }
 
 		};
@@ -521,5 +521,33 @@ namespace Problems
 				( (TngConfigBlock&)*chromosome1.GetConfigBlock() ).GetNumbers() );
 		}
 
+		// hashes the same properties of nodes that are compared by CompareTngNodes, so equal trees have equal hashes
+		void HashTngNodes(const Common::Data::GaTreeNode<TngNode>* node,
+			const int* numbers,
+			unsigned long long& hash)
+		{
+			hash = ( hash ^ (unsigned long long)node->GetValue()._type ) * 1099511628211ULL;
+			hash = ( hash ^ (unsigned long long)node->GetChildren()->GetCount() ) * 1099511628211ULL;
+
+			if( node->GetValue()._type == TNT_NUMBER )
+			{
+				hash = ( hash ^ (unsigned int)numbers[ node->GetValue()._value ] ) * 1099511628211ULL;
+				return;
+			}
+
+			for( const Common::Data::GaListNode<Common::Data::GaTreeNodeBase*>* c = node->GetChildren()->GetHead(); c; c = c->GetNext() )
+				HashTngNodes( (Common::Data::GaTreeNode<TngNode>*)c->GetValue(), numbers, hash );
+		}
+
+		bool TngChromosomeComparator::GetHash(const Chromosome::GaChromosome& chromosome,
+			const Chromosome::GaChromosomeComparatorParams& parameters,
+			unsigned long long& hash) const
+		{
+			hash = 14695981039346656037ULL;
+			HashTngNodes( ( (const TngChromosome&)chromosome ).GetGenes().GetRoot(), ( (const TngConfigBlock&)*chromosome.GetConfigBlock() ).GetNumbers(), hash );
+
+			return true;
+		}
+
 	}
 } // Problems
@@ -168,6 +168,10 @@ namespace Problems
 				const Chromosome::GaChromosome& chromosome2,
 				const Chromosome::GaChromosomeComparatorParams& parameters) const;
 
+			virtual bool GACALL GetHash(const Chromosome::GaChromosome& chromosome,
+				const Chromosome::GaChromosomeComparatorParams& parameters,
+				unsigned long long& hash) const;
+
 			virtual Common::GaParameters* GACALL CreateParameters() const { return NULL; }
 
 		};
@@ -81,6 +81,18 @@ namespace Problems
 				const Chromosome::GaChromosomeComparatorParams& parameters) const
 				{ return ( (const XkcdChromosome&)chromosome1 ).GetGenes() == ( (const XkcdChromosome&)chromosome2 ).GetGenes(); }
 
+			virtual bool GACALL GetHash(const Chromosome::GaChromosome& chromosome,
+				const Chromosome::GaChromosomeComparatorParams& parameters,
+				unsigned long long& hash) const
+			{
+				// genes are equal if their values are equal, so only values are hashed
+				hash = 14695981039346656037ULL;
+				for( const XkcdGeneList::GaNodeType* gene = ( (const XkcdChromosome&)chromosome ).GetGenes().GetHead(); gene != NULL; gene = gene->GetNext() )
+					hash = ( hash ^ (unsigned int)gene->GetValue().GetValue() ) * 1099511628211ULL;
+
+				return true;
+			}
+
 			virtual Common::GaParameters* GACALL CreateParameters() const { return NULL; }
 
 		};
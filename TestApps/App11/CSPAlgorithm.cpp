@@ -62,6 +62,8 @@ CSPAlgorithm::CSPAlgorithm(Common::Observing::GaEventHandler* newGenHandler) :
 
 	Common::Workflows::GaDataCache<Population::GaPopulation> population( _workflow.GetWorkflowData(), WDID_POPULATION );
 
+	// offspring often repeat placement orders of their parents, so their fitness values are cached
+	population.GetData().SetFitnessCache( 256, Chromosome::GaChromosomeComparatorSetup( &_chromosomeComparator, NULL, NULL ) );
 	population.GetData().GetEventManager().AddEventHandler( Population::GaPopulation::GAPE_NEW_GENERATION, newGenHandler );
 }
 
@@ -97,5 +99,8 @@ void CSPAlgorithm::SetParameters(int sWidth, int sHeight, int iMinWidth, int iMa
 	Common::Workflows::GaDataCache<Population::GaPopulation> population( _workflow.GetWorkflowData(), WDID_POPULATION );
 	population.GetData().SetInitializator( initializatorSetup );
 
+	// cached fitness values were evaluated for previous items
+	population.GetData().GetFitnessCache().Clear();
+
 	population.GetData().Clear( true );
 }
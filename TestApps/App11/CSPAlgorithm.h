@@ -29,6 +29,7 @@ private:
 	Chromosome::MutationOperations::GaSwapArrayNodesMutation _mutation;
 	Problems::CSP::CspFitnessOperation _fitnessOperation;
 	Fitness::Comparators::GaSimpleComparator _fitnessComparator;
+	Problems::CSP::CspChromosomeComparator _chromosomeComparator;
 
 	Population::GaCombinedFitnessOperation _populationFitnessOperation;
 
@@ -0,0 +1,180 @@
+#include "..\..\source\Initialization.h"
+#include "..\..\Problems\F1.h"
+#include "..\..\source\NondominatedSorting.h"
+
+#include <cmath>
+#include <stdio.h>
+
+enum WorkflowDataIDs
+{
+	WDID_POPULATION
+};
+
+// objective values are rounded so the population contains duplicate points and many pareto fronts
+class SortingFitnessOperation : public Chromosome::GaChromosomeFitnessOperation
+{
+
+public:
+
+	virtual void GACALL operator ()(const Chromosome::GaChromosome& object,
+		Fitness::GaFitness& fitness,
+		const Fitness::GaFitnessOperationParams& operationParams) const
+	{
+		float x = ( (const Problems::F1::F1Chromosome&)object ).GetGene();
+
+		Common::Data::GaSingleDimensionArray<float>& values = ( (Problems::F1::F1Fitness&)fitness ).GetTypedValues();
+
+		values[ 0 ] = std::floor( x * x / 4 );
+		values[ 1 ] = std::floor( ( x - 2 ) * ( x - 2 ) / 4 );
+		values[ 2 ] = std::floor( 4 * std::sin( 3 * x ) );
+	}
+
+	virtual Fitness::GaFitness* GACALL CreateFitnessObject(Common::Memory::GaSmartPtr<const Fitness::GaFitnessParams> params) const { return new Problems::F1::F1Fitness( params ); }
+
+	virtual Common::GaParameters* GACALL CreateParameters() const { return NULL; }
+
+};
+
+const Multiobjective::GaNondominatedSortingType sortingTypes[] =
+{
+	Multiobjective::GANST_PAIRWISE,
+	Multiobjective::GANST_ENS_SEQUENTIAL,
+	Multiobjective::GANST_ENS_BINARY,
+	Multiobjective::GANST_DIVIDE_AND_CONQUER,
+	Multiobjective::GANST_BEST_ORDER
+};
+
+const char* sortingNames[] = { "pairwise", "ens-ss", "ens-bs", "divide and conquer", "best order" };
+
+const int SORTING_TYPE_COUNT = sizeof( sortingTypes ) / sizeof( sortingTypes[ 0 ] );
+
+// sorts population using all algorithms and compares fronts to the ones produced by pairwise comparison
+class SortingCheckStep : public Common::Workflows::GaSimpleWorkStep
+{
+
+private:
+
+	Common::Workflows::GaDataCache<Population::GaPopulation> _population;
+
+	Multiobjective::GaNondominatedSorter _sorters[ SORTING_TYPE_COUNT ];
+
+	int _mismatches[ SORTING_TYPE_COUNT ];
+
+public:
+
+	SortingCheckStep(Common::Workflows::GaDataStorage* dataStorage,
+		int populationID) : _population(dataStorage, populationID)
+	{
+		for( int i = 0; i < SORTING_TYPE_COUNT; i++ )
+			_mismatches[ i ] = 0;
+	}
+
+	virtual void GACALL operator ()(Common::Workflows::GaBranch* branch)
+	{
+		Population::GaPopulation& population = _population.GetData();
+
+		for( int i = 0; i < SORTING_TYPE_COUNT; i++ )
+			_sorters[ i ].Sort( population, sortingTypes[ i ], branch );
+
+		GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
+		{
+			const Multiobjective::GaNondominatedSorter& reference = _sorters[ 0 ];
+
+			for( int i = 1; i < SORTING_TYPE_COUNT; i++ )
+			{
+				if( _sorters[ i ].GetFrontCount() != reference.GetFrontCount() )
+					_mismatches[ i ]++;
+
+				for( int j = population.GetCount() - 1; j >= 0; j-- )
+				{
+					if( _sorters[ i ].GetFront( j ) != reference.GetFront( j ) )
+						_mismatches[ i ]++;
+				}
+			}
+		}
+	}
+
+	inline int GACALL GetFrontCount() const { return _sorters[ 0 ].GetFrontCount(); }
+
+	inline int GACALL GetMismatches(int type) const { return _mismatches[ type ]; }
+
+};
+
+Problems::F1::F1Initializator initializator;
+SortingFitnessOperation fitnessOperation;
+Problems::F1::F1FitnessComparator fitnessComparator;
+
+Population::GaCombinedFitnessOperation populationFitnessOperation( &fitnessOperation );
+
+bool RunTest(int populationSize,
+	int branchCount)
+{
+	Common::Workflows::GaWorkflow workflow( NULL );
+	Common::Workflows::GaDataStorage* storage = workflow.GetWorkflowData();
+
+	Population::GaPopulation* population = new Population::GaPopulation( Population::GaPopulationParams( populationSize, 0, Population::GaPopulationParams::GAPFO_FILL_ON_INIT ),
+		Chromosome::GaInitializatorSetup( &initializator, NULL, &Chromosome::GaInitializatorConfig() ),
+		Population::GaPopulationFitnessOperationSetup( &populationFitnessOperation, NULL, &Fitness::GaFitnessOperationConfig( &Fitness::Representation::GaMVFitnessParams( 3 ) ) ),
+		Fitness::GaFitnessComparatorSetup( &fitnessComparator, &Fitness::Comparators::GaSimpleComparatorParams( Fitness::Comparators::GACT_MINIMIZE_ALL ), NULL ) );
+
+	storage->AddData( new Common::Workflows::GaDataEntry<Population::GaPopulation>( WDID_POPULATION, population ), Common::Workflows::GADSL_WORKFLOW );
+
+	Common::Workflows::GaBranchGroup* bg1 = (Common::Workflows::GaBranchGroup*)*workflow.GetFirstStep()->GetOutboundConnections().begin();
+	bg1->SetBranchCount( branchCount );
+
+	Common::Workflows::GaFlowStep* initStep =
+		new Common::Workflows::GaSimpleMethodExecStep<Population::GaPopulation, Common::Workflows::GaMethodExecIgnoreBranch<Population::GaPopulation> >(
+		&Population::GaPopulation::Initialize, storage, WDID_POPULATION );
+
+	SortingCheckStep* checkStep = new SortingCheckStep( storage, WDID_POPULATION );
+
+	bg1->GetBranchGroupFlow()->SetFirstStep( initStep );
+	bg1->GetBranchGroupFlow()->ConnectSteps( initStep, checkStep, 0 );
+
+	workflow.Start();
+	workflow.Wait();
+
+	printf( "size: %4d branches: %d fronts: %3d |", populationSize, branchCount, checkStep->GetFrontCount() );
+
+	bool passed = true;
+	for( int i = 1; i < SORTING_TYPE_COUNT; i++ )
+	{
+		printf( " %s: %d", sortingNames[ i ], checkStep->GetMismatches( i ) );
+		passed &= checkStep->GetMismatches( i ) == 0;
+	}
+
+	printf( passed ? " | OK\n" : " | FAILED\n" );
+
+	return passed;
+}
+
+int main()
+{
+	GaInitialize();
+
+	int failed = 0;
+
+	{
+		const int sizes[] = { 1, 2, 3, 17, 64, 250, 1000 };
+		const int sizeCount = sizeof( sizes ) / sizeof( sizes[ 0 ] );
+
+		const int branchCounts[] = { 1, 4 };
+		const int branchCountCount = sizeof( branchCounts ) / sizeof( branchCounts[ 0 ] );
+
+		for( int i = 0; i < sizeCount; i++ )
+		{
+			for( int j = 0; j < branchCountCount; j++ )
+			{
+				if( !RunTest( sizes[ i ], branchCounts[ j ] ) )
+					failed++;
+			}
+		}
+	}
+
+	printf( "\n==========================================\n\n" );
+	printf( failed ? "%d test(s) failed\n" : "all tests passed\n", failed );
+
+	GaFinalize();
+
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,141 @@
+#include "..\..\source\Initialization.h"
+#include "..\..\Problems\F1.h"
+#include "..\..\source\Population.h"
+
+#include <stdio.h>
+
+// number of chromosomes with different codes produced by initializator
+const int DISTINCT_CODES = 8;
+
+// initializator produces chromosomes whose codes repeat after DISTINCT_CODES chromosomes
+class CacheInitializator : public Chromosome::GaInitializator
+{
+
+private:
+
+	mutable int _next;
+
+public:
+
+	CacheInitializator() : _next(0) { }
+
+	virtual Chromosome::GaChromosomePtr GACALL operator ()(bool empty,
+		const Chromosome::GaInitializatorParams& parameters,
+		Common::Memory::GaSmartPtr<Chromosome::GaChromosomeConfigBlock> configBlock) const
+	{
+		Problems::F1::F1Chromosome* newChromosome = new Problems::F1::F1Chromosome( configBlock );
+		newChromosome->SetGene( (float)( _next++ % DISTINCT_CODES ) );
+
+		return newChromosome;
+	}
+
+	virtual Common::GaParameters* GACALL CreateParameters() const { return NULL; }
+
+	inline void GACALL Restart() { _next = 0; }
+
+};
+
+// fitness operation counts number of performed evaluations
+class CountingFitnessOperation : public Problems::F1::F1FitnessOperation
+{
+
+private:
+
+	mutable int _evaluations;
+
+public:
+
+	CountingFitnessOperation() : _evaluations(0) { }
+
+	virtual void GACALL operator ()(const Chromosome::GaChromosome& object,
+		Fitness::GaFitness& fitness,
+		const Fitness::GaFitnessOperationParams& operationParams) const
+	{
+		_evaluations++;
+		Problems::F1::F1FitnessOperation::operator ()( object, fitness, operationParams );
+	}
+
+	inline int GACALL TakeEvaluations()
+	{
+		int evaluations = _evaluations;
+		_evaluations = 0;
+
+		return evaluations;
+	}
+
+};
+
+CacheInitializator initializator;
+CountingFitnessOperation fitnessOperation;
+Problems::F1::F1FitnessComparator fitnessComparator;
+Problems::F1::F1ChromosomeComparator chromosomeComparator;
+
+Population::GaCombinedFitnessOperation populationFitnessOperation( &fitnessOperation );
+
+bool RunTest(const char* name,
+	int populationSize,
+	int cacheSize,
+	int expectedHits,
+	int expectedMisses,
+	int expectedEvaluations)
+{
+	initializator.Restart();
+	fitnessOperation.TakeEvaluations();
+
+	Population::GaPopulation population( Population::GaPopulationParams( populationSize, 0, Population::GaPopulationParams::GAPFO_FILL_ON_INIT ),
+		Chromosome::GaInitializatorSetup( &initializator, NULL, &Chromosome::GaInitializatorConfig() ),
+		Population::GaPopulationFitnessOperationSetup( &populationFitnessOperation, NULL, &Fitness::GaFitnessOperationConfig( &Fitness::Representation::GaMVFitnessParams( 2 ) ) ),
+		Fitness::GaFitnessComparatorSetup( &fitnessComparator, &Fitness::Comparators::GaSimpleComparatorParams( Fitness::Comparators::GACT_MINIMIZE_ALL ), NULL ) );
+
+	population.SetFitnessCache( cacheSize, Chromosome::GaChromosomeComparatorSetup( &chromosomeComparator, NULL, NULL ) );
+	population.Initialize();
+
+	int hits, misses;
+	population.GetFitnessCache().TakeCounters( hits, misses );
+	int evaluations = fitnessOperation.TakeEvaluations();
+
+	// fitness values copied from the cache must be equal to the ones calculated by fitness operation
+	int wrongValues = 0;
+	for( int i = population.GetCount() - 1; i >= 0; i-- )
+	{
+		float x = ( (Problems::F1::F1Chromosome*)population[ i ].GetChromosome().GetRawPtr() )->GetGene();
+		Common::Data::GaSingleDimensionArray<float>& values =
+			( (Problems::F1::F1Fitness&)population[ i ].GetFitness( Population::GaChromosomeStorage::GAFT_RAW ) ).GetTypedValues();
+
+		if( values[ 0 ] != x * x || values[ 1 ] != ( x - 2 ) * ( x - 2 ) )
+			wrongValues++;
+	}
+
+	bool passed = hits == expectedHits && misses == expectedMisses && evaluations == expectedEvaluations && wrongValues == 0;
+
+	printf( "%-10s hits: %3d (%3d) misses: %3d (%3d) evaluations: %3d (%3d) wrong values: %d | %s\n",
+		name, hits, expectedHits, misses, expectedMisses, evaluations, expectedEvaluations, wrongValues, passed ? "OK" : "FAILED" );
+
+	return passed;
+}
+
+int main()
+{
+	GaInitialize();
+
+	int failed = 0;
+
+	// cache large enough to store all distinct codes, so only the first chromosome with each code is evaluated
+	if( !RunTest( "fits", 64, 1024, 64 - DISTINCT_CODES, DISTINCT_CODES, DISTINCT_CODES ) )
+		failed++;
+
+	// cache has single set that is smaller than cycle of codes, so CLOCK evicts each entry before it is needed again
+	if( !RunTest( "thrashing", 64, Population::GaFitnessCache::WAYS, 0, 64, 64 ) )
+		failed++;
+
+	// disabled cache does not count lookups and all chromosomes are evaluated
+	if( !RunTest( "disabled", 64, 0, 0, 0, 64 ) )
+		failed++;
+
+	printf( "\n==========================================\n\n" );
+	printf( failed ? "%d test(s) failed\n" : "all tests passed\n", failed );
+
+	GaFinalize();
+
+	return failed ? 1 : 0;
+}
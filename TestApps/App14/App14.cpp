@@ -0,0 +1,159 @@
+#include "..\..\source\Initialization.h"
+#include "..\..\Problems\F1.h"
+#include "..\..\source\RemoteFitness.h"
+
+#include <stdio.h>
+#include <vector>
+
+// chromosome whose code cannot be restored by workers that evaluate F1 chromosomes
+typedef Chromosome::Representation::GaSingleGeneChromosome<double> IncompatibleChromosome;
+
+Problems::F1::F1FitnessOperation fitnessOperation;
+
+// evaluates chromosomes using the pool and compares received fitness values to the ones calculated locally
+int EvaluateBatch(Population::GaFitnessWorkerPool& pool,
+	const Chromosome::GaChromosomeFitnessOperationSetup& fitnessSetup,
+	int count)
+{
+	std::vector<Chromosome::GaChromosomePtr> chromosomes;
+	std::vector<const Chromosome::GaChromosome*> objects;
+	std::vector<Fitness::GaFitness*> fitness;
+
+	for( int i = 0; i < count; i++ )
+	{
+		Problems::F1::F1Chromosome* chromosome = new Problems::F1::F1Chromosome( Common::Memory::GaSmartPtr<Chromosome::GaChromosomeConfigBlock>() );
+		chromosome->SetGene( GaGlobalRandomFloatGenerator->Generate( -10, 10 ) );
+
+		chromosomes.push_back( chromosome );
+		objects.push_back( chromosome );
+		fitness.push_back( fitnessOperation.CreateFitnessObject( fitnessSetup.GetConfiguration().GetFitnessParams() ) );
+	}
+
+	pool.Evaluate( &objects[ 0 ], &fitness[ 0 ], count );
+
+	int wrongValues = 0;
+	Fitness::GaFitness* expected = fitnessOperation.CreateFitnessObject( fitnessSetup.GetConfiguration().GetFitnessParams() );
+	for( int i = 0; i < count; i++ )
+	{
+		fitnessOperation( *objects[ i ], *expected, fitnessSetup.GetParameters() );
+
+		if( *fitness[ i ] != *expected )
+			wrongValues++;
+
+		delete fitness[ i ];
+	}
+
+	delete expected;
+
+	return wrongValues;
+}
+
+// sends batch in which one chromosome cannot be evaluated by workers
+bool EvaluateFailingBatch(Population::GaFitnessWorkerPool& pool,
+	const Chromosome::GaChromosomeFitnessOperationSetup& fitnessSetup,
+	int count)
+{
+	std::vector<Chromosome::GaChromosomePtr> chromosomes;
+	std::vector<const Chromosome::GaChromosome*> objects;
+	std::vector<Fitness::GaFitness*> fitness;
+
+	for( int i = 0; i < count; i++ )
+	{
+		Chromosome::GaChromosome* chromosome;
+		if( i == count / 2 )
+		{
+			IncompatibleChromosome* incompatible = new IncompatibleChromosome( Common::Memory::GaSmartPtr<Chromosome::GaChromosomeConfigBlock>() );
+			incompatible->SetGene( 0 );
+			chromosome = incompatible;
+		}
+		else
+		{
+			Problems::F1::F1Chromosome* compatible = new Problems::F1::F1Chromosome( Common::Memory::GaSmartPtr<Chromosome::GaChromosomeConfigBlock>() );
+			compatible->SetGene( 0 );
+			chromosome = compatible;
+		}
+
+		chromosomes.push_back( chromosome );
+		objects.push_back( chromosome );
+		fitness.push_back( fitnessOperation.CreateFitnessObject( fitnessSetup.GetConfiguration().GetFitnessParams() ) );
+	}
+
+	bool failed = false;
+	try
+	{
+		pool.Evaluate( &objects[ 0 ], &fitness[ 0 ], count );
+	}
+	catch( Common::Exceptions::GaInvalidOperationException& )
+	{
+		failed = true;
+	}
+
+	for( int i = 0; i < count; i++ )
+		delete fitness[ i ];
+
+	return failed;
+}
+
+bool RunTest(const Chromosome::GaChromosomeFitnessOperationSetup& fitnessSetup,
+	int workerCount,
+	int depth,
+	int batchSize)
+{
+	Population::GaFitnessWorkerPool pool( depth );
+
+	Chromosome::GaChromosomePtr prototype = new Problems::F1::F1Chromosome( Common::Memory::GaSmartPtr<Chromosome::GaChromosomeConfigBlock>() );
+	for( int i = 0; i < workerCount; i++ )
+		pool.StartLocal( prototype, fitnessSetup );
+
+	// round trip of valid chromosomes
+	int wrongValues = EvaluateBatch( pool, fitnessSetup, batchSize );
+
+	// failure of single chromosome must be reported and responses still in flight must be discarded
+	bool failureReported = EvaluateFailingBatch( pool, fitnessSetup, batchSize );
+
+	// the next evaluation must not receive stale responses of the failed one
+	int wrongValuesAfterFailure = EvaluateBatch( pool, fitnessSetup, batchSize );
+
+	bool passed = wrongValues == 0 && failureReported && wrongValuesAfterFailure == 0 && pool.GetWorkerCount() == workerCount;
+
+	printf( "workers: %d depth: %d batch: %3d | wrong values: %d failure reported: %s wrong values after failure: %d workers left: %d | %s\n",
+		workerCount, depth, batchSize, wrongValues, failureReported ? "yes" : "no", wrongValuesAfterFailure, pool.GetWorkerCount(), passed ? "OK" : "FAILED" );
+
+	pool.Shutdown();
+
+	return passed;
+}
+
+int main()
+{
+	GaInitialize();
+
+	int failed = 0;
+
+	{
+		Chromosome::GaChromosomeFitnessOperationSetup fitnessSetup( &fitnessOperation, NULL,
+			&Fitness::GaFitnessOperationConfig( &Fitness::Representation::GaMVFitnessParams( 2 ) ) );
+
+		const int workerCounts[] = { 1, 2, 4 };
+		const int workerCountCount = sizeof( workerCounts ) / sizeof( workerCounts[ 0 ] );
+
+		const int depths[] = { 1, Population::GaFitnessWorkerPool::DEFAULT_DEPTH };
+		const int depthCount = sizeof( depths ) / sizeof( depths[ 0 ] );
+
+		for( int i = 0; i < workerCountCount; i++ )
+		{
+			for( int j = 0; j < depthCount; j++ )
+			{
+				if( !RunTest( fitnessSetup, workerCounts[ i ], depths[ j ], 100 ) )
+					failed++;
+			}
+		}
+	}
+
+	printf( "\n==========================================\n\n" );
+	printf( failed ? "%d test(s) failed\n" : "all tests passed\n", failed );
+
+	GaFinalize();
+
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,214 @@
+#include "..\..\source\Initialization.h"
+#include "..\..\source\SlabAllocator.h"
+#include "..\..\source\Workflows.h"
+
+#include <stdio.h>
+#include <vector>
+
+// fills slot with pattern that identifies its owner
+void FillSlot(int* slot,
+	int size,
+	int owner)
+{
+	for( int i = size / (int)sizeof( int ) - 1; i >= 0; i-- )
+		slot[ i ] = owner;
+}
+
+// returns true if the slot still contains pattern of its owner
+bool CheckSlot(const int* slot,
+	int size,
+	int owner)
+{
+	for( int i = size / (int)sizeof( int ) - 1; i >= 0; i-- )
+	{
+		if( slot[ i ] != owner )
+			return false;
+	}
+
+	return true;
+}
+
+// allocates slots from multiple threads and checks that no slot is given to two owners at the same time
+class AllocationStep : public Common::Workflows::GaSimpleWorkStep
+{
+
+public:
+
+	static const int SLOTS_PER_BRANCH = 16;
+
+	static const int ITERATIONS = 5000;
+
+	static const int MAX_BRANCHES = 16;
+
+private:
+
+	Common::Memory::GaSlabAllocator& _allocator;
+
+	int _corruptions[ MAX_BRANCHES ];
+
+public:
+
+	AllocationStep(Common::Memory::GaSlabAllocator& allocator) : _allocator(allocator)
+	{
+		for( int i = 0; i < MAX_BRANCHES; i++ )
+			_corruptions[ i ] = 0;
+	}
+
+	virtual void GACALL operator ()(Common::Workflows::GaBranch* branch)
+	{
+		int id = branch->GetFilteredID();
+		int* slots[ SLOTS_PER_BRANCH ];
+
+		for( int i = 0; i < ITERATIONS; i++ )
+		{
+			for( int j = 0; j < SLOTS_PER_BRANCH; j++ )
+			{
+				slots[ j ] = (int*)_allocator.Allocate();
+				FillSlot( slots[ j ], _allocator.GetSlotSize(), id * SLOTS_PER_BRANCH + j );
+			}
+
+			for( int j = 0; j < SLOTS_PER_BRANCH; j++ )
+			{
+				if( !CheckSlot( slots[ j ], _allocator.GetSlotSize(), id * SLOTS_PER_BRANCH + j ) )
+					_corruptions[ id ]++;
+
+				_allocator.Free( slots[ j ] );
+			}
+		}
+	}
+
+	inline int GACALL GetCorruptions() const
+	{
+		int corruptions = 0;
+		for( int i = 0; i < MAX_BRANCHES; i++ )
+			corruptions += _corruptions[ i ];
+
+		return corruptions;
+	}
+
+};
+
+// checks slot size, alignment and reuse of freed slots
+bool TestSequential(int slotSize,
+	int blockSlots,
+	int count)
+{
+	Common::Memory::GaSlabAllocator allocator( slotSize, blockSlots );
+
+	int misaligned = 0, corruptions = 0;
+	std::vector<int*> slots;
+
+	for( int i = 0; i < count; i++ )
+	{
+		int* slot = (int*)allocator.Allocate();
+		if( (size_t)slot % Common::Memory::GaSlabAllocator::SLOT_ALIGNMENT != 0 )
+			misaligned++;
+
+		FillSlot( slot, allocator.GetSlotSize(), i );
+		slots.push_back( slot );
+	}
+
+	// slots must not overlap
+	for( int i = 0; i < count; i++ )
+	{
+		if( !CheckSlot( slots[ i ], allocator.GetSlotSize(), i ) )
+			corruptions++;
+	}
+
+	int expectedBlocks = ( count + blockSlots - 1 ) / blockSlots;
+	int blocks = allocator.GetBlockCount();
+
+	for( int i = 0; i < count; i++ )
+		allocator.Free( slots[ i ] );
+
+	int freed = allocator.GetFreeCount();
+
+	// freed slots must be reused before new blocks are allocated
+	for( int i = 0; i < count; i++ )
+		slots[ i ] = (int*)allocator.Allocate();
+
+	int blocksAfterReuse = allocator.GetBlockCount();
+	int freeAfterReuse = allocator.GetFreeCount();
+
+	for( int i = 0; i < count; i++ )
+		allocator.Free( slots[ i ] );
+
+	bool passed = allocator.GetSlotSize() >= slotSize && allocator.GetSlotSize() % Common::Memory::GaSlabAllocator::SLOT_ALIGNMENT == 0 &&
+		misaligned == 0 && corruptions == 0 && blocks == expectedBlocks && freed == count && blocksAfterReuse == blocks && freeAfterReuse == 0;
+
+	printf( "sequential slot: %3d (%3d) block: %3d count: %4d | misaligned: %d corruptions: %d blocks: %d (%d) freed: %d blocks after reuse: %d | %s\n",
+		slotSize, allocator.GetSlotSize(), blockSlots, count, misaligned, corruptions, blocks, expectedBlocks, freed, blocksAfterReuse, passed ? "OK" : "FAILED" );
+
+	return passed;
+}
+
+// allocates and frees slots from multiple branches
+bool TestConcurrent(int slotSize,
+	int blockSlots,
+	int branchCount)
+{
+	Common::Memory::GaSlabAllocator allocator( slotSize, blockSlots );
+
+	int corruptions, blocks;
+
+	{
+		Common::Workflows::GaWorkflow workflow( NULL );
+
+		Common::Workflows::GaBranchGroup* bg1 = (Common::Workflows::GaBranchGroup*)*workflow.GetFirstStep()->GetOutboundConnections().begin();
+		bg1->SetBranchCount( branchCount );
+
+		AllocationStep* allocationStep = new AllocationStep( allocator );
+		bg1->GetBranchGroupFlow()->SetFirstStep( allocationStep );
+
+		workflow.Start();
+		workflow.Wait();
+
+		corruptions = allocationStep->GetCorruptions();
+		blocks = allocator.GetBlockCount();
+	}
+
+	// slots are taken from blocks only when there are no freed slots, so number of taken slots never exceeds number of slots in use
+	int maxBlocks = ( branchCount * AllocationStep::SLOTS_PER_BRANCH + blockSlots - 1 ) / blockSlots;
+
+	// all taken slots are freed and only the last block can have slots that have never been taken
+	int freed = allocator.GetFreeCount();
+
+	bool passed = corruptions == 0 && blocks <= maxBlocks && freed > ( blocks - 1 ) * blockSlots && freed <= blocks * blockSlots;
+
+	printf( "concurrent slot: %3d block: %3d branches: %2d | corruptions: %d blocks: %d (max %d) free: %d | %s\n",
+		slotSize, blockSlots, branchCount, corruptions, blocks, maxBlocks, freed, passed ? "OK" : "FAILED" );
+
+	return passed;
+}
+
+int main()
+{
+	GaInitialize();
+
+	int failed = 0;
+
+	if( !TestSequential( 1, 8, 20 ) )
+		failed++;
+
+	if( !TestSequential( 24, 8, 64 ) )
+		failed++;
+
+	if( !TestSequential( 100, Common::Memory::GaSlabAllocator::DEFAULT_BLOCK_SLOTS, 1000 ) )
+		failed++;
+
+	if( !TestConcurrent( 40, 8, 1 ) )
+		failed++;
+
+	if( !TestConcurrent( 40, 8, 4 ) )
+		failed++;
+
+	if( !TestConcurrent( 40, 8, AllocationStep::MAX_BRANCHES ) )
+		failed++;
+
+	printf( "\n==========================================\n\n" );
+	printf( failed ? "%d test(s) failed\n" : "all tests passed\n", failed );
+
+	GaFinalize();
+
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,168 @@
+#include "..\..\source\Initialization.h"
+#include "..\..\source\GlobalRandomGenerator.h"
+#include "..\..\source\Grid.h"
+
+#include <stdio.h>
+#include <map>
+#include <vector>
+
+typedef std::vector<int> Coordinates;
+
+typedef std::map<Coordinates, int> ReferenceGrid;
+
+Common::Grid::GaHyperBox MakeHyperBox(const Coordinates& coordinates)
+{
+	Common::Grid::GaHyperBox hyperBox;
+	hyperBox.SetSize( (int)coordinates.size() );
+
+	for( int i = (int)coordinates.size() - 1; i >= 0; i-- )
+		hyperBox[ i ] = coordinates[ i ];
+
+	return hyperBox;
+}
+
+// compares state of the grid with occupancy of hyperboxes stored in reference grid
+int CheckGrid(const Common::Grid::GaSparseHyperGrid& grid,
+	const ReferenceGrid& reference,
+	const std::vector<Coordinates>& itemCoordinates,
+	int range)
+{
+	int errors = 0, itemCount = 0, maxCount = 0;
+
+	for( ReferenceGrid::const_iterator it = reference.begin(); it != reference.end(); ++it )
+	{
+		Common::Grid::GaHyperBox hyperBox = MakeHyperBox( it->first );
+
+		itemCount += it->second;
+		if( it->second > maxCount )
+			maxCount = it->second;
+
+		int cell = grid.Find( hyperBox );
+		if( cell < 0 || grid.GetCount( cell ) != it->second || grid.GetOccupancy( hyperBox ) != it->second )
+		{
+			errors++;
+			continue;
+		}
+
+		for( int i = grid.GetDimensionCount() - 1; i >= 0; i-- )
+		{
+			if( grid.GetCoordinates( cell )[ i ] != it->first[ i ] )
+				errors++;
+		}
+
+		// items of the hyperbox must be linked and they must have coordinates of the hyperbox
+		int count = 0;
+		for( int item = grid.GetFirstItem( cell ); item >= 0; item = grid.GetNextItem( item ), count++ )
+		{
+			if( grid.GetItemCell( item ) != cell || itemCoordinates[ item ] != it->first )
+				errors++;
+		}
+
+		if( count != it->second )
+			errors++;
+	}
+
+	if( grid.GetItemCount() != itemCount || grid.GetCellCount() != (int)reference.size() || grid.GetMaxCount() != maxCount )
+		errors++;
+
+	if( maxCount > 0 ? grid.GetCount( grid.GetMostCrowded() ) != maxCount : grid.GetMostCrowded() != -1 )
+		errors++;
+
+	// hyperbox outside of the range of used coordinates is never occupied
+	if( grid.GetDimensionCount() > 0 )
+	{
+		Common::Grid::GaHyperBox empty;
+		empty.SetSize( grid.GetDimensionCount(), range + 1 );
+
+		if( grid.Find( empty ) != -1 || grid.GetOccupancy( empty ) != 0 )
+			errors++;
+	}
+
+	return errors;
+}
+
+// inserts and removes items at random and checks the grid after each change
+bool RunTest(int size,
+	int dimensions,
+	int range,
+	int operations)
+{
+	Common::Grid::GaSparseHyperGrid grid;
+	grid.SetSize( size, dimensions );
+
+	ReferenceGrid reference;
+	std::vector<Coordinates> itemCoordinates( size );
+	std::vector<bool> inserted( size, false );
+
+	int errors = 0;
+	for( int i = 0; i < operations; i++ )
+	{
+		int item = GaGlobalRandomIntegerGenerator->Generate( 0, size - 1 );
+
+		if( inserted[ item ] )
+		{
+			grid.Remove( item );
+
+			ReferenceGrid::iterator it = reference.find( itemCoordinates[ item ] );
+			if( --it->second == 0 )
+				reference.erase( it );
+
+			inserted[ item ] = false;
+		}
+		else
+		{
+			Coordinates& coordinates = itemCoordinates[ item ];
+			coordinates.resize( dimensions );
+			for( int j = 0; j < dimensions; j++ )
+				coordinates[ j ] = GaGlobalRandomIntegerGenerator->Generate( -range, range );
+
+			int cell = grid.Insert( item, MakeHyperBox( coordinates ) );
+			if( cell != grid.GetItemCell( item ) )
+				errors++;
+
+			reference[ coordinates ]++;
+			inserted[ item ] = true;
+		}
+
+		errors += CheckGrid( grid, reference, itemCoordinates, range );
+	}
+
+	// grid must be empty after it is cleared
+	grid.Clear();
+	reference.clear();
+	errors += CheckGrid( grid, reference, itemCoordinates, range );
+
+	bool passed = errors == 0;
+
+	printf( "items: %4d dimensions: %3d range: %3d operations: %5d | errors: %d | %s\n", size, dimensions, range, operations, errors, passed ? "OK" : "FAILED" );
+
+	return passed;
+}
+
+int main()
+{
+	GaInitialize();
+
+	int failed = 0;
+
+	// small range produces crowded hyperboxes
+	if( !RunTest( 200, 2, 2, 5000 ) )
+		failed++;
+
+	if( !RunTest( 200, 3, 1000, 5000 ) )
+		failed++;
+
+	// key has single bit per coordinate, so most hyperboxes share keys
+	if( !RunTest( 100, 70, 1, 2000 ) )
+		failed++;
+
+	if( !RunTest( 1, 4, 3, 100 ) )
+		failed++;
+
+	printf( "\n==========================================\n\n" );
+	printf( failed ? "%d test(s) failed\n" : "all tests passed\n", failed );
+
+	GaFinalize();
+
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,277 @@
+#include "..\..\source\Initialization.h"
+#include "..\..\source\GlobalRandomGenerator.h"
+#include "..\..\source\ParetoArchive.h"
+
+#include <stdio.h>
+#include <vector>
+
+// solution stored in reference archive
+struct Solution
+{
+
+	int _id;
+
+	int _entry;
+
+	std::vector<double> _values;
+
+};
+
+typedef std::vector<Solution> ReferenceArchive;
+
+// archive does not access chromosomes, so addresses of solution identifiers are used instead of real chromosomes
+std::vector<int> ids;
+
+inline Population::GaChromosomeStorage* GetChromosome(int id) { return reinterpret_cast<Population::GaChromosomeStorage*>( &ids[ id ] ); }
+
+inline int GetID(Population::GaChromosomeStorage* chromosome) { return (int)( reinterpret_cast<int*>( chromosome ) - &ids[ 0 ] ); }
+
+// returns true if the first solution dominates the second one
+bool Dominates(const double* values1,
+	const double* values2,
+	int objectiveCount)
+{
+	bool better = false;
+	for( int i = 0; i < objectiveCount; i++ )
+	{
+		if( values1[ i ] > values2[ i ] )
+			return false;
+
+		if( values1[ i ] < values2[ i ] )
+			better = true;
+	}
+
+	return better;
+}
+
+// returns true if the solution is dominated by a solution in reference archive
+bool IsDominated(const ReferenceArchive& reference,
+	const double* values,
+	int objectiveCount)
+{
+	for( ReferenceArchive::const_iterator it = reference.begin(); it != reference.end(); ++it )
+	{
+		if( Dominates( &it->_values[ 0 ], values, objectiveCount ) )
+			return true;
+	}
+
+	return false;
+}
+
+// generates random objective keys rounded so solutions often share values
+void GenerateValues(double* values,
+	int objectiveCount,
+	int range)
+{
+	for( int i = 0; i < objectiveCount; i++ )
+		values[ i ] = GaGlobalRandomIntegerGenerator->Generate( 0, range );
+}
+
+Common::Grid::GaHyperBox MakeHyperBox(const double* values,
+	int objectiveCount)
+{
+	Common::Grid::GaHyperBox hyperBox;
+	hyperBox.SetSize( objectiveCount );
+
+	for( int i = 0; i < objectiveCount; i++ )
+		hyperBox[ i ] = (int)values[ i ] / 4;
+
+	return hyperBox;
+}
+
+// compares content of the archive to reference archive
+int CheckArchive(const Multiobjective::GaParetoArchive& archive,
+	const ReferenceArchive& reference)
+{
+	int errors = 0;
+
+	if( archive.GetCount() != (int)reference.size() || archive.GetGrid().GetItemCount() != (int)reference.size() )
+		errors++;
+
+	for( ReferenceArchive::const_iterator it = reference.begin(); it != reference.end(); ++it )
+	{
+		if( archive.GetChromosome( it->_entry ) != GetChromosome( it->_id ) || archive.GetGrid().GetItemCell( it->_entry ) < 0 )
+			errors++;
+
+		for( int i = archive.GetObjectiveCount() - 1; i >= 0; i-- )
+		{
+			if( archive.GetValues( it->_entry )[ i ] != it->_values[ i ] )
+				errors++;
+		}
+	}
+
+	return errors;
+}
+
+// inserts random solutions into the archive, removes some of them and checks the archive against brute-force reference
+bool RunTest(int objectiveCount,
+	int range,
+	int insertions,
+	int batchSize)
+{
+	Multiobjective::GaParetoArchive archive;
+	archive.SetSize( insertions, objectiveCount );
+
+	ids.assign( insertions, 0 );
+	ReferenceArchive reference;
+
+	int errors = 0, rejected = 0, removed = 0;
+	std::vector<double> values( objectiveCount );
+
+	for( int i = 0; i < insertions; i++ )
+	{
+		GenerateValues( &values[ 0 ], objectiveCount, range );
+
+		bool dominated = IsDominated( reference, &values[ 0 ], objectiveCount );
+		if( archive.IsDominated( &values[ 0 ] ) != dominated )
+			errors++;
+
+		int entry = archive.Insert( GetChromosome( i ), &values[ 0 ], MakeHyperBox( &values[ 0 ], objectiveCount ) );
+
+		if( dominated )
+		{
+			rejected++;
+			if( entry != -1 || archive.GetRemovedCount() != 0 )
+				errors++;
+		}
+		else
+		{
+			// archived solutions dominated by the new one must be reported as removed
+			int expectedRemoved = 0;
+			for( ReferenceArchive::iterator it = reference.begin(); it != reference.end(); )
+			{
+				if( Dominates( &values[ 0 ], &it->_values[ 0 ], objectiveCount ) )
+				{
+					bool reported = false;
+					for( int j = archive.GetRemovedCount() - 1; j >= 0; j-- )
+					{
+						if( GetID( archive.GetRemoved( j ) ) == it->_id )
+							reported = true;
+					}
+
+					if( !reported )
+						errors++;
+
+					expectedRemoved++;
+					it = reference.erase( it );
+				}
+				else
+					++it;
+			}
+
+			if( entry < 0 || archive.GetRemovedCount() != expectedRemoved )
+				errors++;
+
+			removed += expectedRemoved;
+
+			Solution solution;
+			solution._id = i;
+			solution._entry = entry;
+			solution._values = values;
+			reference.push_back( solution );
+		}
+
+		// explicit removal of random solution
+		if( !reference.empty() && GaGlobalRandomIntegerGenerator->Generate( 0, 9 ) == 0 )
+		{
+			int index = GaGlobalRandomIntegerGenerator->Generate( 0, (int)reference.size() - 1 );
+			archive.Remove( reference[ index ]._entry );
+			reference.erase( reference.begin() + index );
+		}
+
+		errors += CheckArchive( archive, reference );
+	}
+
+	// batch filtering must match brute-force dominance check
+	archive.BeginBatch( batchSize );
+	for( int i = 0; i < batchSize; i++ )
+		GenerateValues( archive.GetBatchValues( i ), objectiveCount, range );
+
+	int filtered = 0;
+	for( int i = 0; i < batchSize; i++ )
+	{
+		archive.Filter( i );
+
+		if( archive.IsFiltered( i ) )
+			filtered++;
+
+		if( archive.IsFiltered( i ) != IsDominated( reference, archive.GetBatchValues( i ), objectiveCount ) )
+			errors++;
+	}
+
+	// archive must be empty after it is cleared
+	archive.Clear();
+	reference.clear();
+	errors += CheckArchive( archive, reference );
+
+	bool passed = errors == 0;
+
+	printf( "objectives: %d range: %4d insertions: %5d | rejected: %5d removed: %5d filtered: %3d/%3d errors: %d | %s\n",
+		objectiveCount, range, insertions, rejected, removed, filtered, batchSize, errors, passed ? "OK" : "FAILED" );
+
+	return passed;
+}
+
+// checks that insertion into full archive is refused
+bool TestFull()
+{
+	Multiobjective::GaParetoArchive archive;
+	archive.SetSize( 2, 2 );
+
+	double values[][ 2 ] = { { 0, 2 }, { 2, 0 }, { 1, 1 } };
+
+	archive.Insert( GetChromosome( 0 ), values[ 0 ], MakeHyperBox( values[ 0 ], 2 ) );
+	archive.Insert( GetChromosome( 1 ), values[ 1 ], MakeHyperBox( values[ 1 ], 2 ) );
+
+	bool refused = false;
+	try
+	{
+		archive.Insert( GetChromosome( 2 ), values[ 2 ], MakeHyperBox( values[ 2 ], 2 ) );
+	}
+	catch( Common::Exceptions::GaInvalidOperationException& )
+	{
+		refused = true;
+	}
+
+	bool passed = refused && archive.GetCount() == 2;
+
+	printf( "full archive | refused: %s count: %d | %s\n", refused ? "yes" : "no", archive.GetCount(), passed ? "OK" : "FAILED" );
+
+	return passed;
+}
+
+int main()
+{
+	GaInitialize();
+
+	int failed = 0;
+
+	// small range produces many duplicate and dominated solutions
+	if( !RunTest( 2, 20, 2000, 200 ) )
+		failed++;
+
+	// large range rarely produces solutions with equal values
+	if( !RunTest( 2, 100000, 3000, 200 ) )
+		failed++;
+
+	if( !RunTest( 3, 50, 3000, 200 ) )
+		failed++;
+
+	// most solutions are nondominated with many objectives
+	if( !RunTest( 6, 1000, 1500, 200 ) )
+		failed++;
+
+	if( !RunTest( 1, 10, 200, 50 ) )
+		failed++;
+
+	ids.assign( 3, 0 );
+	if( !TestFull() )
+		failed++;
+
+	printf( "\n==========================================\n\n" );
+	printf( failed ? "%d test(s) failed\n" : "all tests passed\n", failed );
+
+	GaFinalize();
+
+	return failed ? 1 : 0;
+}
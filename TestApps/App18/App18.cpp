@@ -0,0 +1,201 @@
+#include "..\..\source\Initialization.h"
+#include "..\..\Problems\F1.h"
+#include "..\..\source\SPEA.h"
+
+#include <stdio.h>
+#include <vector>
+
+enum WorkflowDataIDs
+{
+	WDID_POPULATION
+};
+
+enum ChromosomeTagIDs
+{
+	CTID_DOMINANCE_LIST,
+	CTID_STRENGTH,
+	CTID_DOMINATED,
+	CTID_KTH_NEIGHBOUR
+};
+
+enum PopulationTagIDs
+{
+	PTID_DISTANCE_STORAGE,
+	PTID_NONDOMINATED_COUNT,
+	PTID_SPATIAL_INDEX
+};
+
+// genes of chromosomes, the same genes are used for each truncation that is compared
+std::vector<float> genes;
+
+// initializator produces chromosomes with prepared genes
+class ListInitializator : public Chromosome::GaInitializator
+{
+
+private:
+
+	mutable int _next;
+
+public:
+
+	ListInitializator() : _next(0) { }
+
+	virtual Chromosome::GaChromosomePtr GACALL operator ()(bool empty,
+		const Chromosome::GaInitializatorParams& parameters,
+		Common::Memory::GaSmartPtr<Chromosome::GaChromosomeConfigBlock> configBlock) const
+	{
+		Problems::F1::F1Chromosome* newChromosome = new Problems::F1::F1Chromosome( configBlock );
+		newChromosome->SetGene( genes[ _next++ % genes.size() ] );
+
+		return newChromosome;
+	}
+
+	virtual Common::GaParameters* GACALL CreateParameters() const { return NULL; }
+
+	inline void GACALL Restart() { _next = 0; }
+
+};
+
+ListInitializator initializator;
+Problems::F1::F1FitnessOperation fitnessOperation;
+Problems::F1::F1FitnessComparator fitnessComparator;
+
+Population::GaCombinedFitnessOperation populationFitnessOperation( &fitnessOperation );
+
+Multiobjective::SPEA::GaSPEA2 scaling;
+
+// F1 chromosome is nondominated if its gene is in [0, 2] interval
+inline bool IsNondominated(float gene) { return gene >= 0 && gene <= 2; }
+
+// performs SPEA2 scaling over population and marks chromosomes removed by truncation
+void Truncate(int populationSize,
+	int archiveSize,
+	int branchCount,
+	int spatialIndexTagID,
+	Multiobjective::GaSpatialIndexType spatialIndexType,
+	std::vector<float>& removed,
+	int& dominatedRemoved,
+	int& nondominatedKept)
+{
+	initializator.Restart();
+
+	Common::Workflows::GaWorkflow workflow( NULL );
+	Common::Workflows::GaDataStorage* storage = workflow.GetWorkflowData();
+
+	Population::GaPopulation* population = new Population::GaPopulation( Population::GaPopulationParams( populationSize, populationSize - archiveSize,
+		Population::GaPopulationParams::GAPFO_FILL_ON_INIT | Population::GaPopulationParams::GAPFO_FILL_CROWDING_SPACE ),
+		Chromosome::GaInitializatorSetup( &initializator, NULL, &Chromosome::GaInitializatorConfig() ),
+		Population::GaPopulationFitnessOperationSetup( &populationFitnessOperation, NULL, &Fitness::GaFitnessOperationConfig( &Fitness::Representation::GaMVFitnessParams( 2 ) ) ),
+		Fitness::GaFitnessComparatorSetup( &fitnessComparator, &Fitness::Comparators::GaSimpleComparatorParams( Fitness::Comparators::GACT_MINIMIZE_ALL ), NULL ) );
+
+	storage->AddData( new Common::Workflows::GaDataEntry<Population::GaPopulation>( WDID_POPULATION, population ), Common::Workflows::GADSL_WORKFLOW );
+
+	Common::Workflows::GaBranchGroup* bg1 = (Common::Workflows::GaBranchGroup*)*workflow.GetFirstStep()->GetOutboundConnections().begin();
+	bg1->SetBranchCount( branchCount );
+
+	Multiobjective::SPEA::GaSPEA2Params params( CTID_DOMINANCE_LIST, CTID_STRENGTH, CTID_DOMINATED, PTID_DISTANCE_STORAGE, PTID_NONDOMINATED_COUNT, CTID_KTH_NEIGHBOUR, 4,
+		-1, spatialIndexTagID, spatialIndexType );
+
+	Common::Workflows::GaFlowStep* initStep =
+		new Common::Workflows::GaSimpleMethodExecStep<Population::GaPopulation, Common::Workflows::GaMethodExecIgnoreBranch<Population::GaPopulation> >(
+		&Population::GaPopulation::Initialize, storage, WDID_POPULATION );
+
+	Population::GaScalingStep* scalingStep = new Population::GaScalingStep(
+		Population::GaScalingSetup( &scaling, &params, &Population::GaScalingConfig() ), storage, WDID_POPULATION );
+
+	bg1->GetBranchGroupFlow()->SetFirstStep( initStep );
+	bg1->GetBranchGroupFlow()->ConnectSteps( initStep, scalingStep, 0 );
+
+	workflow.Start();
+	workflow.Wait();
+
+	removed.clear();
+	dominatedRemoved = nondominatedKept = 0;
+
+	for( int i = 0; i < population->GetCount(); i++ )
+	{
+		float gene = ( (Problems::F1::F1Chromosome*)( *population )[ i ].GetChromosome().GetRawPtr() )->GetGene();
+
+		if( ( *population )[ i ].GetFlags().IsFlagSetAny( Population::GaChromosomeStorage::GACF_REMOVE_CHROMOSOME ) )
+		{
+			removed.push_back( gene );
+
+			if( !IsNondominated( gene ) )
+				dominatedRemoved++;
+		}
+		else if( IsNondominated( gene ) )
+			nondominatedKept++;
+	}
+}
+
+// compares chromosomes removed by truncation using neighbour buffers and using spatial index
+bool RunTest(int populationSize,
+	int archiveSize,
+	int nondominatedCount,
+	int branchCount,
+	Multiobjective::GaSpatialIndexType spatialIndexType)
+{
+	genes.clear();
+	for( int i = 0; i < populationSize; i++ )
+	{
+		genes.push_back( i < nondominatedCount ? GaGlobalRandomFloatGenerator->Generate( 0, 2 )
+			: ( i % 2 ? GaGlobalRandomFloatGenerator->Generate( -4, -0.1f ) : GaGlobalRandomFloatGenerator->Generate( 2.1f, 6 ) ) );
+	}
+
+	std::vector<float> pairwiseRemoved, spatialRemoved;
+	int pairwiseDominatedRemoved, pairwiseKept, spatialDominatedRemoved, spatialKept;
+
+	Truncate( populationSize, archiveSize, branchCount, -1, spatialIndexType, pairwiseRemoved, pairwiseDominatedRemoved, pairwiseKept );
+	Truncate( populationSize, archiveSize, branchCount, PTID_SPATIAL_INDEX, spatialIndexType, spatialRemoved, spatialDominatedRemoved, spatialKept );
+
+	// archive is truncated to its size only when there is more nondominated chromosomes
+	int expectedKept = nondominatedCount > archiveSize ? archiveSize : nondominatedCount;
+
+	bool passed = pairwiseRemoved == spatialRemoved && pairwiseDominatedRemoved == 0 && spatialDominatedRemoved == 0 &&
+		pairwiseKept == expectedKept && spatialKept == expectedKept;
+
+	printf( "size: %3d archive: %3d nondominated: %3d branches: %d index: %d | removed: %3d (%3d) dominated removed: %d (%d) kept: %3d (%3d) expected: %3d | %s\n",
+		populationSize, archiveSize, nondominatedCount, branchCount, spatialIndexType, (int)pairwiseRemoved.size(), (int)spatialRemoved.size(),
+		pairwiseDominatedRemoved, spatialDominatedRemoved, pairwiseKept, spatialKept, expectedKept, passed ? "OK" : "FAILED" );
+
+	return passed;
+}
+
+int main()
+{
+	GaInitialize();
+
+	int failed = 0;
+
+	{
+		const Multiobjective::GaSpatialIndexType indexTypes[] = { Multiobjective::GASIT_KD_TREE, Multiobjective::GASIT_VP_TREE };
+		const int indexTypeCount = sizeof( indexTypes ) / sizeof( indexTypes[ 0 ] );
+
+		const int branchCounts[] = { 1, 4 };
+		const int branchCountCount = sizeof( branchCounts ) / sizeof( branchCounts[ 0 ] );
+
+		for( int i = 0; i < indexTypeCount; i++ )
+		{
+			for( int j = 0; j < branchCountCount; j++ )
+			{
+				// dominated chromosomes must not be removed while nondominated archive is oversized
+				if( !RunTest( 100, 40, 70, branchCounts[ j ], indexTypes[ i ] ) )
+					failed++;
+
+				if( !RunTest( 250, 50, 200, branchCounts[ j ], indexTypes[ i ] ) )
+					failed++;
+
+				// archive is not truncated when it is not oversized
+				if( !RunTest( 100, 60, 30, branchCounts[ j ], indexTypes[ i ] ) )
+					failed++;
+			}
+		}
+	}
+
+	printf( "\n==========================================\n\n" );
+	printf( failed ? "%d test(s) failed\n" : "all tests passed\n", failed );
+
+	GaFinalize();
+
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,188 @@
+#include "..\..\source\Initialization.h"
+#include "..\..\Problems\F1.h"
+#include "..\..\source\Matings.h"
+#include "..\..\source\AsyncStub.h"
+#include "..\..\source\PopulationStatistics.h"
+#include "..\..\source\StopCriteria.h"
+
+#include <stdio.h>
+
+enum WorkflowDataIDs
+{
+	WDID_POPULATION,
+	WDID_POPULATION_STATS
+};
+
+enum PopulationTagIDs
+{
+	PTID_CROSSOVER_BUFFERS
+};
+
+const int POPULATION_SIZE = 40;
+const int EPOCH_LENGTH = 25;
+
+// the first generation initializes population and each of the others performs a single epoch
+const int GENERATION_COUNT = 6;
+
+// number of matings performed since the last generation
+volatile long matings = 0;
+
+// mating operation that counts how many times it is executed by all branches
+class CountingMating : public Chromosome::MatingOperations::GaBasicMatingOperation
+{
+
+public:
+
+	virtual void GACALL operator ()(const Chromosome::GaMatingConfig& operations,
+		Chromosome::GaCrossoverBuffer& crossoverBuffer,
+		const Chromosome::GaMatingParams& parameters) const
+	{
+		Common::Threading::GaAtomicOps<long>::Inc( &matings );
+		GaBasicMatingOperation::operator ()( operations, crossoverBuffer, parameters );
+	}
+
+};
+
+Problems::F1::F1Initializator initializator;
+Problems::F1::F1Crossover crossover;
+Problems::F1::F1Mutation mutation;
+Problems::F1::F1FitnessOperation fitnessOperation;
+Problems::F1::F1FitnessComparator fitnessComparator;
+
+Population::GaCombinedFitnessOperation populationFitnessOperation( &fitnessOperation );
+
+CountingMating mating;
+
+Population::GaPopulationSizeTracker sizeTracker;
+Population::GaRawFitnessTracker rawTracker;
+
+Algorithm::StopCriteria::GaGenerationCriterion stopCriterion;
+
+// state of the current run
+int generations = 0;
+int errors = 0;
+
+// checks population and its statistics at the end of each generation
+void GACALL MyHandler(int id, Common::Observing::GaEventData& data)
+{
+	const Population::GaPopulation& population = ( (Population::GaPopulationEventData&)data ).GetPopulation();
+	const Statistics::GaStatistics& stats = population.GetStatistics();
+
+	// the first generation only initializes population, every other generation performs a single epoch
+	int expectedMatings = ++generations == 1 ? 0 : EPOCH_LENGTH;
+
+	// all branches have left the epoch when the event is raised
+	int performed = matings;
+	matings = 0;
+
+	if( performed != expectedMatings )
+		errors++;
+
+	// replacement keeps size of the population
+	if( population.GetCount() != POPULATION_SIZE )
+		errors++;
+
+	if( stats.GetValue<int>( Population::GADV_POPULATION_SIZE ).GetCurrentValue() != population.GetCount() )
+		errors++;
+
+	if( stats.GetCurrentGeneration() != generations )
+		errors++;
+}
+
+Common::Observing::GaNonmemberEventHandler newGenHandler( MyHandler );
+
+// runs the stub with specified number of branches and checks that each epoch performed all of its matings
+bool RunTest(Common::Workflows::GaWorkflow& workflow,
+	Algorithm::Stubs::GaAsyncSteadyStateStub& stub,
+	Population::GaPopulation& population,
+	int branchCount,
+	int run)
+{
+	generations = errors = 0;
+	matings = 0;
+
+	// runs are repeated on the same stub, so counters left by the previous run must not affect the new one
+	population.Clear( true );
+	stub.SetBranchCount( branchCount );
+
+	workflow.Start();
+	workflow.Wait();
+
+	bool passed = errors == 0 && generations == GENERATION_COUNT;
+
+	printf( "branches: %d run: %d | generations: %d size: %d errors: %d | %s\n",
+		branchCount, run, generations, population.GetCount(), errors, passed ? "OK" : "FAILED" );
+
+	return passed;
+}
+
+int main()
+{
+	GaInitialize();
+
+	int failed = 0;
+
+	{
+		Chromosome::GaMatingConfig matingConfiguration(
+			Chromosome::GaCrossoverSetup( &crossover, &Chromosome::GaCrossoverParams( 0.8f, 2 ), NULL ),
+			Chromosome::GaMutationSetup( &mutation, &Chromosome::GaMutationParams( 0.03f, false ), NULL ) );
+
+		Algorithm::Stubs::GaAsyncSteadyStateStub::GaStatTrackersCollection trackers;
+		trackers[ Population::GaPopulationSizeTracker::TRACKER_ID ] =  &sizeTracker;
+		trackers[ Population::GaRawFitnessTracker::TRACKER_ID ] =  &rawTracker;
+
+		Algorithm::Stubs::GaAsyncSteadyStateStub asyncStub( WDID_POPULATION, WDID_POPULATION_STATS,
+			Chromosome::GaInitializatorSetup( &initializator, NULL, &Chromosome::GaInitializatorConfig() ),
+			Population::GaPopulationFitnessOperationSetup( &populationFitnessOperation, NULL, &Fitness::GaFitnessOperationConfig( &Fitness::Representation::GaMVFitnessParams( 2 ) ) ),
+			Fitness::GaFitnessComparatorSetup( &fitnessComparator, &Fitness::Comparators::GaSimpleComparatorParams( Fitness::Comparators::GACT_MINIMIZE_ALL ), NULL ),
+			Population::GaPopulationParams( POPULATION_SIZE, 0, Population::GaPopulationParams::GAPFO_FILL_ON_INIT ),
+			trackers,
+			Chromosome::GaMatingSetup( &mating, NULL, &matingConfiguration ),
+			2, 2, EPOCH_LENGTH, PTID_CROSSOVER_BUFFERS );
+
+		Common::Workflows::GaWorkflow workflow( NULL );
+
+		workflow.RemoveConnection( *workflow.GetFirstStep()->GetOutboundConnections().begin(), true );
+
+		Common::Workflows::GaWorkflowBarrier* br1 = new Common::Workflows::GaWorkflowBarrier();
+		asyncStub.Connect( workflow.GetFirstStep(), br1 );
+
+		Common::Workflows::GaBranchGroup* bg1 = (Common::Workflows::GaBranchGroup*)workflow.ConnectSteps( br1, workflow.GetLastStep(), 0 );
+
+		Algorithm::StopCriteria::GaStopCriterionStep* stopStep = new Algorithm::StopCriteria::GaStopCriterionStep(
+			Algorithm::StopCriteria::GaStopCriterionSetup( &stopCriterion, &Algorithm::StopCriteria::GaGenerationCriterionParams( GENERATION_COUNT ), NULL ),
+			workflow.GetWorkflowData(), WDID_POPULATION_STATS );
+
+		Common::Workflows::GaBranchGroupTransition* bt1 = new Common::Workflows::GaBranchGroupTransition();
+
+		bg1->GetBranchGroupFlow()->SetFirstStep( stopStep );
+		bg1->GetBranchGroupFlow()->ConnectSteps( stopStep, bt1, 0 );
+		workflow.ConnectSteps( bt1, asyncStub.GetStubFlow().GetFirstStep(), 1 );
+
+		Common::Workflows::GaDataCache<Population::GaPopulation> population( workflow.GetWorkflowData(), WDID_POPULATION );
+
+		population.GetData().GetEventManager().AddEventHandler( Population::GaPopulation::GAPE_NEW_GENERATION, &newGenHandler );
+
+		const int branchCounts[] = { 1, 2, 4, 3 };
+		const int branchCountCount = sizeof( branchCounts ) / sizeof( branchCounts[ 0 ] );
+
+		// each branch count is run twice to check that the stub can be restarted
+		for( int i = 0; i < branchCountCount; i++ )
+		{
+			for( int run = 1; run <= 2; run++ )
+			{
+				if( !RunTest( workflow, asyncStub, population.GetData(), branchCounts[ i ], run ) )
+					failed++;
+			}
+		}
+
+		population.GetData().GetEventManager().RemoveEventHandlers( Population::GaPopulation::GAPE_NEW_GENERATION );
+	}
+
+	printf( "\n==========================================\n\n" );
+	printf( failed ? "%d test(s) failed\n" : "all tests passed\n", failed );
+
+	GaFinalize();
+
+	return failed ? 1 : 0;
+}
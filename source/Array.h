@@ -15,6 +15,7 @@
 
 #include "SysInfo.h"
 #include "SmartPtr.h"
+#include "SlabAllocator.h"
 
 /// <summary><c>GaAllocatorHelper</c> struct is used for detonating custom <c>new</c> and <c>delete</c> operators for managing arrays' memory.</summary>
 struct GaAllocatorHelper { };
@@ -263,16 +264,25 @@ namespace Common
 			/// <summary>Size of allocated memory for the array in a number of elements that it can store.</summary>
 			int _allocatedSize;
 
+			/// <summary>Allocator that provides memory for the array if the elements fit into single slot.</summary>
+			Memory::GaSmartPtr<Memory::GaSlabAllocator> _allocator;
+
+			/// <summary>Indicates whether the memory used by the elements is a slot provided by the allocator.</summary>
+			bool _pooled;
+
 		public:
 
 			/// <summary>This constiructor initializes array with size of zero.</summary>
 			GaArray() : _array(NULL),
-				_allocatedSize(0) { }
+				_allocatedSize(0),
+				_pooled(false) { }
 
-			/// <summary>This constructor initializes array by copying another one.</summary>
+			/// <summary>This constructor initializes array by copying another one. The new array uses the same allocator as the source array.</summary>
 			/// <param name="rhs">reference to array that should be copied.</param>
 			GaArray(const GaArray<GaValueType>& rhs) : _array(NULL),
-				_allocatedSize(0) { GaArray<GaValueType>::Copy( &rhs ); }
+				_allocatedSize(0),
+				_allocator(rhs._allocator),
+				_pooled(false) { GaArray<GaValueType>::Copy( &rhs ); }
 
 			/// <summary>Destorys elements of the array and free used memory.</summary>
 			virtual ~GaArray() { Clear(); }
@@ -294,14 +304,12 @@ namespace Common
 						if( src->_size > _allocatedSize )
 						{
 							// allocate memory large enough to store source elements and copy them then destroy existing elements in the destination
-							Memory::GaAutoPtr<char> memory = src->AllocateMemory();
+							Memory::GaAutoPtr<char> memory = AllocateMemory( src->_size );
 							GaCopyArray( (GaValueType*)memory.GetRawPtr(), src->_array, src->_size );
 							Clear();
 
 							// apply new array
-							_array = (GaValueType*)memory.DetachPointer();
-							_size = src->_size;
-							_allocatedSize = _size;
+							ApplyMemory( memory, src->_size );
 						}
 						else
 						{
@@ -351,10 +359,15 @@ namespace Common
 					GaDestructArray( _array, _size );
 
 					// free memory used by the array
-					delete[] (char*)_array;
+					if( _pooled )
+						_allocator->Free( _array );
+					else
+						delete[] (char*)_array;
 
 					_array = NULL;
 					_size = 0;
+					_allocatedSize = 0;
+					_pooled = false;
 				}
 			}
 
@@ -416,16 +429,41 @@ namespace Common
 
 		protected:
 
-			/// <summary><c>AllocateMemory</c> method allocates memory to large enough to store defined number of elements.</summary>
+			/// <summary><c>AllocateMemory</c> method allocates memory to large enough to store defined number of elements.
+			/// Memory is taken from the allocator if the elements fit into single slot.</summary>
 			/// <param name="size">number of elements that should be stored in the memory location.</param>
 			/// <returns>Method returns auto pointer to allocated block.</returns>
 			inline Memory::GaAutoPtr<char> GACALL AllocateMemory(int size)
-				{ return Memory::GaAutoPtr<char>( new char[ size * sizeof( GaValueType ) ], Memory::GaArrayDeletionPolicy<char>::GetInstance() ); }
+			{
+				if( IsPooled( size ) )
+					return Memory::GaAutoPtr<char>( (char*)_allocator->Allocate(), _allocator.GetRawPtr() );
+
+				return Memory::GaAutoPtr<char>( new char[ size * sizeof( GaValueType ) ], Memory::GaArrayDeletionPolicy<char>::GetInstance() );
+			}
 
 			/// <summary><c>AllocateMemory</c> method allocates memory to large enough to store current number of elements.</summary>
 			/// <returns>Method returns auto pointer to allocated block.</returns>
 			inline Memory::GaAutoPtr<char> GACALL AllocateMemory() { return AllocateMemory( _size ); }
 
+			/// <summary><c>ApplyMemory</c> method sets memory allocated by <see cref="AllocateMemory" /> method as storage of the elements.
+			/// Previously used memory must be freed before this method is called.</summary>
+			/// <param name="memory">memory that stores the elements.</param>
+			/// <param name="size">number of elements stored in the memory.</param>
+			inline void GACALL ApplyMemory(Memory::GaAutoPtr<char>& memory,
+				int size)
+			{
+				_pooled = IsPooled( size );
+				_array = (GaValueType*)memory.DetachPointer();
+				_size = size;
+				_allocatedSize = _pooled ? _allocator->GetSlotSize() / (int)sizeof( GaValueType ) : size;
+			}
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <param name="size">number of elements.</param>
+			/// <returns>Method returns <c>true</c> if memory for specified number of elements should be taken from the allocator.</returns>
+			inline bool GACALL IsPooled(int size) const
+				{ return !_allocator.IsNull() && size > 0 && size * (int)sizeof( GaValueType ) <= _allocator->GetSlotSize(); }
+
 		private:
 
 			/// <summary>Disables <c>operator =</c> on arrays for which the exact type is unknown.</summary>
@@ -460,8 +498,7 @@ namespace Common
 					GaCopyArray( (GaValueType*)memory.GetRawPtr(), source, size );
 
 					// apply new array
-					_array = (GaValueType*)memory.DetachPointer();
-					_size = size;
+					ApplyMemory( memory, size );
 				}
 			}
 
@@ -510,21 +547,58 @@ namespace Common
 						Clear();
 
 						// apply new array
-						_array = (GaValueType*)memory.DetachPointer();
-						_size = size;
-						_allocatedSize = _size;
+						ApplyMemory( memory, size );
 					}
-					else if( size > _size )
-						// intialize new elements
-						GaInitializeArray( _array + _size, size - _size, sizeof( GaValueType ), defaultValue );
 					else
-						// destory unneeded elements
-						GaDestructArray( _array + size, _size - size );
+					{
+						if( size > _size )
+							// intialize new elements
+							GaInitializeArray( _array + _size, size - _size, sizeof( GaValueType ), defaultValue );
+						else
+							// destory unneeded elements
+							GaDestructArray( _array + size, _size - size );
+
+						_size = size;
+					}
 				}
 				else
 					Clear();
 			}
 
+			/// <summary><c>SetAllocator</c> method sets allocator that provides memory for the array when its elements fit into single slot.
+			/// Elements currently stored in the array are moved to memory provided by the new allocator.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="allocator">smart pointer to the allocator. If it is <c>NULL</c>, memory is always allocated from the heap.</param>
+			void GACALL SetAllocator(Memory::GaSmartPtr<Memory::GaSlabAllocator> allocator)
+			{
+				if( _allocator == allocator )
+					return;
+
+				if( _array )
+				{
+					// copy elements to memory provided by the new allocator and destroy elements at old location
+					Memory::GaSmartPtr<Memory::GaSlabAllocator> previous = _allocator;
+					_allocator = allocator;
+					Memory::GaAutoPtr<char> memory = AllocateMemory( _size );
+					GaCopyArray( (GaValueType*)memory.GetRawPtr(), _array, _size );
+
+					int size = _size;
+					_allocator = previous;
+					Clear();
+
+					// apply new array
+					_allocator = allocator;
+					ApplyMemory( memory, size );
+				}
+				else
+					_allocator = allocator;
+			}
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns smart pointer to allocator that provides memory for the array.</returns>
+			inline Memory::GaSmartPtr<Memory::GaSlabAllocator> GACALL GetAllocator() const { return _allocator; }
+
 			/// <summary><c>operator =</c> clears current content of the array and copies element from another.
 			///
 			/// This method is not thread-safe.</summary>
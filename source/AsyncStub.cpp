@@ -0,0 +1,365 @@
+
+/*! \file AsyncStub.cpp
+    \brief This file conatins implementation of classes that implement algorithm stub for asynchronous steady-state GA.
+*/
+
+/*
+ *
+ * website: http://kataklinger.com/
+ * contact: me[at]kataklinger.com
+ *
+ */
+
+#include "GlobalRandomGenerator.h"
+#include "PopulationStatistics.h"
+#include "AsyncStub.h"
+
+namespace Algorithm
+{
+	namespace Stubs
+	{
+
+		// Initializes step
+		GaAsyncSteadyStateStep::GaAsyncSteadyStateStep(Common::Workflows::GaDataStorage* dataStorage,
+			int populationID,
+			const Chromosome::GaMatingSetup& mating,
+			int selectionSize,
+			int replacementSize,
+			int epochLength,
+			int crossoverBuffersTagID) : _population(dataStorage, populationID),
+			_mating(mating),
+			_crossoverBuffersTagID(crossoverBuffersTagID)
+		{
+			SetSelectionSize( selectionSize );
+			SetReplacementSize( replacementSize );
+
+			SetEpochLength( epochLength );
+
+			// branches are synchronized only when population statistics are rebuilt at the end of the epoch
+			SetSyncOnExit( false );
+
+			Prepare();
+		}
+
+		// Produces offspring and inserts them into population
+		void GaAsyncSteadyStateStep::operator ()(Common::Workflows::GaBranch* branch)
+		{
+			Population::GaPopulation& population = _population.GetData();
+			Population::GaCouplingCounters counters( population, Population::GADV_COUPLING_TIME );
+
+			Population::GaCrossoverStorageBuffer& crossoverBuffer = population.GetTagByID<Population::GaPartialCrossoverBuffer>( _crossoverBuffersTagID )[ branch->GetFilteredID() ];
+			Population::GaChromosomeGroup& parents = crossoverBuffer.GetParents();
+			Population::GaChromosomeGroup& offspring = crossoverBuffer.GetOffspring();
+
+			const Chromosome::GaMatingConfig& config = _mating.GetMating().GetConfiguration();
+			int parentCount = config.GetParentCount();
+			int count = population.GetCount();
+
+			// by default single epoch replaces as many chromosomes as there are in the population
+			int epochLength = _epochLength ? _epochLength : ( count + config.GetOffspringCount() - 1 ) / config.GetOffspringCount();
+
+			// branches claim matings until all matings of the epoch are performed
+			for( int i = Common::Threading::GaAtomicOps<long>::Inc( &_matings ) - 1; i < epochLength; i = Common::Threading::GaAtomicOps<long>::Inc( &_matings ) - 1 )
+			{
+				// random numbers used by selection and mating operation are mapped to substream of the mating
+				branch->SelectRandomSubstream( i );
+
+				// selects parents from population, including offspring accepted by previous matings
+				for( int j = 0; j < parentCount; j++ )
+					parents.Add( &Select( population, count ) );
+
+				// produce offspring and offer them to replacement
+				_mating.Mate( crossoverBuffer );
+				while( Population::GaChromosomeStorage* child = offspring.PopLast( true ) )
+					Replace( population, child, count );
+
+				// update operation counters
+				counters.CollectCrossoverBufferCounters( crossoverBuffer );
+
+				crossoverBuffer.Clear();
+			}
+
+			// no branch enters the next epoch until all branches leave this one and statistics are rebuilt,
+			// so the last branch that leaves can reset counters without waiting for other branches
+			if( Common::Threading::GaAtomicOps<long>::Inc( &_departed ) == branch->GetBarrierCount() )
+				_matings = _departed = 0;
+
+			// update population statistics with new state of counters
+			counters.UpdateStatistics();
+		}
+
+		// Sets mating operation
+		void GaAsyncSteadyStateStep::SetMating(const Chromosome::GaMatingSetup& mating)
+		{
+			Clear();
+			_mating.SetMating( mating );
+
+			try
+			{
+				Prepare();
+			}
+			catch( ... )
+			{
+				// undo changes
+				Clear();
+
+				throw;
+			}
+		}
+
+		// Updates crossover buffers
+		void GaAsyncSteadyStateStep::BranchCountChanged()
+		{
+			if( _mating.GetMating().HasOperation() && _population.HasData() )
+			{
+				Population::GaPopulation& population = _population.GetData();
+				const Chromosome::GaMatingConfig& config = _mating.GetMating().GetConfiguration();
+
+				population.GetTagByID<Population::GaPartialCrossoverBuffer>( _crossoverBuffersTagID ).SetSize( _branchFilter.GetBranchCount(),
+					Population::GaCrossoverStorageBuffer( &population, config.GetParentCount(), config.GetOffspringCount() ) );
+			}
+		}
+
+		// Resets counters and creates crossover buffers
+		void GaAsyncSteadyStateStep::Prepare()
+		{
+			_matings = _departed = 0;
+
+			if( _mating.GetMating().HasOperation() && _population.HasData() )
+			{
+				Population::GaPopulation& population = _population.GetData();
+				const Chromosome::GaMatingConfig& config = _mating.GetMating().GetConfiguration();
+
+				int index = population.GetTagManager().AddTag( _crossoverBuffersTagID, Common::Data::GaSizableTagLifecycle<Population::GaPartialCrossoverBuffer>() );
+				population.GetTagByIndex<Population::GaPartialCrossoverBuffer>( index ).SetSize( _branchFilter.GetBranchCount(),
+					Population::GaCrossoverStorageBuffer( &population, config.GetParentCount(), config.GetOffspringCount() ) );
+			}
+		}
+
+		// Removes crossover buffers
+		void GaAsyncSteadyStateStep::Clear()
+		{
+			if( _mating.GetMating().HasOperation() && _population.HasData() )
+				_population.GetData().GetTagManager().RemoveTag( _crossoverBuffersTagID );
+		}
+
+		// Selects parent using tournament
+		Population::GaChromosomeStorage& GaAsyncSteadyStateStep::Select(Population::GaPopulation& population,
+			int count)
+		{
+			// chromosomes replaced concurrently are recycled only when the next generation starts, so no locking is needed
+			Population::GaChromosomeStorage* best = &population[ GaGlobalRandomIntegerGenerator->Generate( count - 1 ) ];
+			for( int i = _selectionSize - 1; i > 0; i-- )
+			{
+				Population::GaChromosomeStorage* candidate = &population[ GaGlobalRandomIntegerGenerator->Generate( count - 1 ) ];
+				if( population.CompareFitness( *candidate, *best ) < 0 )
+					best = candidate;
+			}
+
+			return *best;
+		}
+
+		// Inserts offspring into population if it is better than the worst chromosome in replacement tournament
+		void GaAsyncSteadyStateStep::Replace(Population::GaPopulation& population,
+			Population::GaChromosomeStorage* offspring,
+			int count)
+		{
+			// chooses the worst chromosome of the tournament - chromosome that is replaced concurrently is not recycled until the next generation,
+			// so it is safe to inspect it even if other branch replaces it in the meantime
+			int worst = GaGlobalRandomIntegerGenerator->Generate( count - 1 );
+			for( int i = _replacementSize - 1; i > 0; i-- )
+			{
+				int candidate = GaGlobalRandomIntegerGenerator->Generate( count - 1 );
+				if( population.CompareFitness( population[ candidate ], population[ worst ] ) > 0 )
+					worst = candidate;
+			}
+
+			Common::Threading::GaSpinlock& lock = GetLock( worst );
+
+			GA_LOCK( lock );
+
+			// slot might be taken by other branch in the meantime
+			bool accepted = population.CompareFitness( *offspring, population[ worst ] ) < 0;
+			if( accepted )
+			{
+				// replaced chromosome is moved to the list of removed chromosomes and it is recycled when the next generation starts
+				GA_LOCK( _populationLock );
+				population.Replace( worst, offspring );
+				GA_UNLOCK( _populationLock );
+			}
+
+			GA_UNLOCK( lock );
+
+			if( !accepted )
+				population.ReleaseStorageObject( offspring );
+		}
+
+		// Initializes asynchronous steady-state GA stub
+		GaAsyncSteadyStateStub::GaAsyncSteadyStateStub(int populationID,
+			int statisticsID,
+			const Chromosome::GaInitializatorSetup& initializator,
+			const Population::GaPopulationFitnessOperationSetup& fitnessOperation,
+			const Fitness::GaFitnessComparatorSetup& comparator,
+			const Population::GaPopulationParams& populationParameters,
+			const GaStatTrackersCollection& statTrackers,
+			const Chromosome::GaMatingSetup& mating,
+			int selectionSize,
+			int replacementSize,
+			int epochLength,
+			int crossoverBuffersTagID) : GaBasicStub(populationID, statisticsID),
+			_crossoverBuffersTagID(crossoverBuffersTagID)
+		{
+			Clear();
+
+			// stores operations and their parameters
+			SetPopulationParameters( populationParameters );
+			SetInitializator( initializator );
+			SetFitnessOperation( fitnessOperation );
+			SetFitnessComparator( comparator );
+			SetStatsTrackers( statTrackers );
+			SetMating( mating );
+			SetTournamentSizes( selectionSize, replacementSize );
+			SetEpochLength( epochLength );
+		}
+
+		// Sets fitness operation
+		void GaAsyncSteadyStateStub::SetFitnessOperation(const Population::GaPopulationFitnessOperationSetup& fitnessOperation)
+		{
+			GA_ARG_ASSERT( Common::Exceptions::GaArgumentException, fitnessOperation.GetOperation().AllowsIndividualEvaluation(), "fitnessOperation",
+				"Fitness operation must allow individual-based evaluation of chromosomes.", "Algorithm" );
+
+			UpdateFitnessOperation( fitnessOperation );
+		}
+
+		// Sets mating operation
+		void GaAsyncSteadyStateStub::SetMating(const Chromosome::GaMatingSetup& mating)
+		{
+			_mating = mating;
+
+			// update mating operation stored in flow step if stub is connected
+			if( IsConnected() )
+				_breedStep->SetMating( _mating );
+		}
+
+		// Sets sizes of tournaments
+		void GaAsyncSteadyStateStub::SetTournamentSizes(int selectionSize,
+			int replacementSize)
+		{
+			GA_ARG_ASSERT( Common::Exceptions::GaArgumentOutOfRangeException, selectionSize > 0, "selectionSize", "Size of tournament must be positive.", "Algorithm" );
+			GA_ARG_ASSERT( Common::Exceptions::GaArgumentOutOfRangeException, replacementSize > 0, "replacementSize", "Size of tournament must be positive.", "Algorithm" );
+
+			_selectionSize = selectionSize;
+			_replacementSize = replacementSize;
+
+			// update tournament sizes stored in flow step if stub is connected
+			if( IsConnected() )
+			{
+				_breedStep->SetSelectionSize( _selectionSize );
+				_breedStep->SetReplacementSize( _replacementSize );
+			}
+		}
+
+		// Sets length of epoch
+		void GaAsyncSteadyStateStub::SetEpochLength(int length)
+		{
+			GA_ARG_ASSERT( Common::Exceptions::GaArgumentOutOfRangeException, length >= 0, "length", "Length of epoch cannot be negative.", "Algorithm" );
+
+			_epochLength = length;
+
+			// update epoch length stored in flow step if stub is connected
+			if( IsConnected() )
+				_breedStep->SetEpochLength( _epochLength );
+		}
+
+		// Sets statistical trackers that are required by the algorithm
+		void GaAsyncSteadyStateStub::SetStatsTrackers(const GaAsyncSteadyStateStub::GaStatTrackersCollection& trackers)
+		{
+			if( IsConnected() )
+			{
+				GaCachedPopulation population( GetWorkflowStorage(), _populationID );
+
+				// unregister previously registered trackers
+				for( GaStatTrackersCollection::iterator it = _statTrackers.begin(); it != _statTrackers.end(); ++it )
+					population.GetData().UnregisterTracker( it->first );
+
+				// register new trackers
+				for( GaStatTrackersCollection::const_iterator it = trackers.begin(); it != trackers.end(); ++it )
+					population.GetData().RegisterTracker( it->first, it->second );
+			}
+
+			// store required trackers
+			_statTrackers.clear();
+			_statTrackers = trackers;
+		}
+
+		// Connects stub to the workflow
+		void GaAsyncSteadyStateStub::Connected()
+		{
+			GaBasicStub::Connected();
+
+			GaCachedPopulation population( GetWorkflowStorage(), _populationID );
+
+			// register statistics trackers required by the algorithm
+			for( GaStatTrackersCollection::iterator it = _statTrackers.begin(); it != _statTrackers.end(); ++it )
+				population.GetData().RegisterTracker( it->first, it->second );
+
+			// create flow steps
+
+			_checkStep = new GaCheckPopulationStep( GetWorkflowStorage(), _populationID );
+			_initStep = new Common::Workflows::GaSimpleMethodExecStep<Population::GaPopulation, Common::Workflows::GaMethodExecIgnoreBranch<Population::GaPopulation> >
+				( &Population::GaPopulation::Initialize, GetWorkflowStorage(), _populationID );
+
+			_breedStep = new GaAsyncSteadyStateStep( GetWorkflowStorage(), _populationID, _mating, _selectionSize, _replacementSize, _epochLength, _crossoverBuffersTagID );
+
+			_nextGenStep = new Common::Workflows::GaSimpleMethodExecStep<Population::GaPopulation>( &Population::GaPopulation::NextGeneration, GetWorkflowStorage(), _populationID );
+
+			Common::Workflows::GaBranchGroupFlow* flow = _brachGroup->GetBranchGroupFlow();
+
+			// connect created flow steps
+
+			flow->SetFirstStep( _checkStep );
+			flow->ConnectSteps( _checkStep, _breedStep, 1 );
+			flow->ConnectSteps( _breedStep, _nextGenStep, 0 );
+
+			flow->ConnectSteps( _checkStep, _initStep, 0 );
+			flow->ConnectSteps( _initStep, _nextGenStep, 0 );
+		}
+
+		// Disconnects stub from the workflow
+		void GaAsyncSteadyStateStub::Disconnecting()
+		{
+			Common::Workflows::GaBranchGroupFlow* flow = _brachGroup->GetBranchGroupFlow();
+
+			// disconnect and destroy flow steps created by the stub
+
+			flow->RemoveStep( _checkStep, true, true );
+			flow->RemoveStep( _initStep, true, true );
+			flow->RemoveStep( _breedStep, true, true );
+			flow->RemoveStep( _nextGenStep, true, true );
+
+			// clear internal bookkeeping
+			Clear();
+
+			GaCachedPopulation population( GetWorkflowStorage(), _populationID );
+
+			// remove statistics trackers
+			for( GaStatTrackersCollection::reverse_iterator it = _statTrackers.rbegin(); it != _statTrackers.rend(); ++it )
+				population.GetData().UnregisterTracker( it->first );
+
+			population.Clear();
+
+			GaBasicStub::Disconnecting();
+		}
+
+		// Clears internal bookkeeping.
+		void GaAsyncSteadyStateStub::Clear()
+		{
+			// clear pointers that cache flow steps used by stub
+			_checkStep = NULL;
+			_initStep = NULL;
+			_breedStep = NULL;
+			_nextGenStep = NULL;
+		}
+
+	} // Stubs
+} // Algorithm
@@ -0,0 +1,370 @@
+
+/*! \file AsyncStub.h
+    \brief This file conatins declaration of classes that implement algorithm stub for asynchronous steady-state GA.
+*/
+
+/*
+ *
+ * website: http://kataklinger.com/
+ * contact: me[at]kataklinger.com
+ *
+ */
+
+#ifndef __GA_ASYNC_STUB_H__
+#define __GA_ASYNC_STUB_H__
+
+#include "AlgorithmStub.h"
+
+namespace Algorithm
+{
+	namespace Stubs
+	{
+
+		/// <summary><c>GaAsyncSteadyStateStep</c> class represents workflow step that produces offspring and inserts them into population without synchronizing
+		/// branches after each offspring. Each branch independently claims mating, selects parents using tournament selection, produces offspring
+		/// (offspring are evaluated by crossover buffer as they are created) and offers offspring to concurrent replacement. Replacement chooses the worst
+		/// chromosome of random tournament and replaces it if offspring is better. Slots of the population are protected by striped locks, so branches compete
+		/// only when they replace chromosomes in the same stripe. Accepted offspring are inserted into population immediately, so they can be selected as parents
+		/// by matings that follow. Chromosomes that are replaced are recycled by the population when the next generation starts, so branches that still inspect them
+		/// do not access recycled objects.
+		///
+		/// Step ends when all matings of the epoch are claimed. Branches do not synchronize in the step, they synchronize only when population statistics are
+		/// rebuilt by the following step. Since branches do not wait for each other during the epoch, slow fitness evaluation of one chromosome does not stall
+		/// other branches.
+		///
+		/// Fitness operation of the population must allow individual-based evaluation of chromosomes.
+		///
+		/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
+		/// No public or private methods are thread-safe.</summary>
+		class GaAsyncSteadyStateStep : public Common::Workflows::GaFilteredStep
+		{
+
+		public:
+
+			/// <summary>Number of locks that protect slots of the population.</summary>
+			static const int LOCK_COUNT = 64;
+
+		private:
+
+			/// <summary>Population on which the step operates.</summary>
+			GaCachedPopulation _population;
+
+			/// <summary>Mating operation used to produce offspring.</summary>
+			Population::GaCouplingConfig _mating;
+
+			/// <summary>Number of chromosomes that compete in tournament for parent selection.</summary>
+			int _selectionSize;
+
+			/// <summary>Number of chromosomes that compete in tournament for replacement.</summary>
+			int _replacementSize;
+
+			/// <summary>Number of matings performed in single epoch. If it is set to 0, number of matings is chosen so that single epoch produces
+			/// as many offspring as there are chromosomes in the population.</summary>
+			int _epochLength;
+
+			/// <summary>ID of population tag that stores crossover buffers of branches.</summary>
+			int _crossoverBuffersTagID;
+
+			/// <summary>Number of matings claimed by branches in the current epoch.</summary>
+			volatile long _matings;
+
+			/// <summary>Number of branches that have left the current epoch. The last branch that leaves the epoch resets both counters.</summary>
+			volatile long _departed;
+
+			/// <summary>Locks that protect slots of the population.</summary>
+			Common::Threading::GaSpinlock _locks[ LOCK_COUNT ];
+
+			/// <summary>Lock that protects population's lists of new and removed chromosomes.</summary>
+			Common::Threading::GaSpinlock _populationLock;
+
+		public:
+
+			/// <summary>Initializes step.</summary>
+			/// <param name="dataStorage">storage that contains population on which the step operates.</param>
+			/// <param name="populationID">ID of the population.</param>
+			/// <param name="mating">mating operation used to produce offspring.</param>
+			/// <param name="selectionSize">number of chromosomes that compete in tournament for parent selection.</param>
+			/// <param name="replacementSize">number of chromosomes that compete in tournament for replacement.</param>
+			/// <param name="epochLength">number of matings performed in single epoch or 0 if epoch should produce as many offspring as there are
+			/// chromosomes in the population.</param>
+			/// <param name="crossoverBuffersTagID">ID of population tag that stores crossover buffers of branches.</param>
+			/// <exception cref="GaArgumentOutOfRangeException" />Thrown if <c>selectionSize</c> or <c>replacementSize</c> is not positive
+			/// or if <c>epochLength</c> is negative.</exception>
+			GAL_API
+			GaAsyncSteadyStateStep(Common::Workflows::GaDataStorage* dataStorage,
+				int populationID,
+				const Chromosome::GaMatingSetup& mating,
+				int selectionSize,
+				int replacementSize,
+				int epochLength,
+				int crossoverBuffersTagID);
+
+			/// <summary>Removes crossover buffers from the population.</summary>
+			virtual ~GaAsyncSteadyStateStep() { Clear(); }
+
+			/// <summary><c>operator ()</c> produces offspring and inserts them into population until all matings of the epoch are claimed.
+			///
+			/// This operator is thread-safe.</summary>
+			/// <param name="branch">pointer to workflow branch that executes this step.</param>
+			GAL_API
+			virtual void GACALL operator ()(Common::Workflows::GaBranch* branch);
+
+			/// <summary><c>SetMating</c> method sets mating operation used to produce offspring.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="mating">mating operation.</param>
+			GAL_API
+			void GACALL SetMating(const Chromosome::GaMatingSetup& mating);
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns mating operation used to produce offspring.</returns>
+			inline const Chromosome::GaMatingSetup& GACALL GetMating() const { return _mating.GetMating(); }
+
+			/// <summary><c>SetSelectionSize</c> method sets number of chromosomes that compete in tournament for parent selection.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="size">size of tournament.</param>
+			/// <exception cref="GaArgumentOutOfRangeException" />Thrown if <c>size</c> is not positive.</exception>
+			inline void GACALL SetSelectionSize(int size)
+			{
+				GA_ARG_ASSERT( Common::Exceptions::GaArgumentOutOfRangeException, size > 0, "size", "Size of tournament must be positive.", "Algorithm" );
+				_selectionSize = size;
+			}
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns number of chromosomes that compete in tournament for parent selection.</returns>
+			inline int GACALL GetSelectionSize() const { return _selectionSize; }
+
+			/// <summary><c>SetReplacementSize</c> method sets number of chromosomes that compete in tournament for replacement.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="size">size of tournament.</param>
+			/// <exception cref="GaArgumentOutOfRangeException" />Thrown if <c>size</c> is not positive.</exception>
+			inline void GACALL SetReplacementSize(int size)
+			{
+				GA_ARG_ASSERT( Common::Exceptions::GaArgumentOutOfRangeException, size > 0, "size", "Size of tournament must be positive.", "Algorithm" );
+				_replacementSize = size;
+			}
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns number of chromosomes that compete in tournament for replacement.</returns>
+			inline int GACALL GetReplacementSize() const { return _replacementSize; }
+
+			/// <summary><c>SetEpochLength</c> method sets number of matings performed in single epoch.
+			/// Population statistics are updated only once per epoch.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="length">number of matings or 0 if epoch should produce as many offspring as there are chromosomes in the population.</param>
+			/// <exception cref="GaArgumentOutOfRangeException" />Thrown if <c>length</c> is negative.</exception>
+			inline void GACALL SetEpochLength(int length)
+			{
+				GA_ARG_ASSERT( Common::Exceptions::GaArgumentOutOfRangeException, length >= 0, "length", "Length of epoch cannot be negative.", "Algorithm" );
+				_epochLength = length;
+			}
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns number of matings performed in single epoch or 0 if epoch produces as many offspring
+			/// as there are chromosomes in the population.</returns>
+			inline int GACALL GetEpochLength() const { return _epochLength; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns ID of population tag that stores crossover buffers of branches.</returns>
+			inline int GACALL GetCrossoverBuffersTagID() const { return _crossoverBuffersTagID; }
+
+		protected:
+
+			/// <summary>Updates crossover buffers to reflect new number of branches.</summary>
+			GAL_API
+			virtual void GACALL BranchCountChanged();
+
+		private:
+
+			/// <summary><c>Prepare</c> method resets counters of the epoch and creates crossover buffers.</summary>
+			void GACALL Prepare();
+
+			/// <summary><c>Clear</c> method removes crossover buffers from the population.</summary>
+			void GACALL Clear();
+
+			/// <summary><c>Select</c> method selects parent using tournament selection.</summary>
+			/// <param name="population">population from which the parent is selected.</param>
+			/// <param name="count">number of chromosomes in the population.</param>
+			/// <returns>Method returns reference to selected chromosome.</returns>
+			Population::GaChromosomeStorage& GACALL Select(Population::GaPopulation& population,
+				int count);
+
+			/// <summary><c>Replace</c> method offers offspring chromosome to replacement. If it is accepted, it is inserted into population immediately,
+			/// otherwise storage object of the offspring is returned to the population's pool.</summary>
+			/// <param name="population">population in which the chromosome should be inserted.</param>
+			/// <param name="offspring">offspring chromosome.</param>
+			/// <param name="count">number of chromosomes in the population.</param>
+			void GACALL Replace(Population::GaPopulation& population,
+				Population::GaChromosomeStorage* offspring,
+				int count);
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns lock that protects specified slot.</returns>
+			inline Common::Threading::GaSpinlock& GACALL GetLock(int slot) { return _locks[ slot & ( LOCK_COUNT - 1 ) ]; }
+
+		};
+
+		/// <summary><c>GaAsyncSteadyStateStub</c> class represents steady-state genetic algorithm for single-objective optimization whose branches produce
+		/// and insert offspring independently. Algorithm does not have per-generation barriers between selection, coupling, evaluation and replacement.
+		/// Instead, branches synchronize only at the end of an epoch when population statistics are updated.
+		/// More details are given in specification of <see cref="GaAsyncSteadyStateStep" /> class.
+		///
+		/// This class has no built-in synchronizator, so <c>LOCK_OBJECT</c> and <c>LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
+		/// No public or private methods are thread-safe.</summary>
+		class GaAsyncSteadyStateStub : public GaBasicStub
+		{
+
+		public:
+
+			/// <summary>Hash map that stores trackers for statistical information that are required by the algorithm.</summary>
+			typedef STLEXT::hash_map<int, Population::GaPopulationStatTracker*> GaStatTrackersCollection;
+
+		protected:
+
+			/// <summary>Statistical information trackers that are required by the algorithm.</summary>
+			GaStatTrackersCollection _statTrackers;
+
+			/// <summary>Mating operation that is used by algorithm to produce offspring.</summary>
+			Chromosome::GaMatingSetup _mating;
+
+			/// <summary>Number of chromosomes that compete in tournament for parent selection.</summary>
+			int _selectionSize;
+
+			/// <summary>Number of chromosomes that compete in tournament for replacement.</summary>
+			int _replacementSize;
+
+			/// <summary>Number of matings performed in single epoch or 0 if epoch produces as many offspring as there are chromosomes in the population.</summary>
+			int _epochLength;
+
+			/// <summary>ID of population tag that stores crossover buffers of branches.</summary>
+			int _crossoverBuffersTagID;
+
+			/// <summary>Flow steps which checks whether initialization of the population is required.</summary>
+			Common::Workflows::GaFlowStep* _checkStep;
+
+			/// <summary>Flow step that initializes population.</summary>
+			Common::Workflows::GaFlowStep* _initStep;
+
+			/// <summary>Flow step that produces offspring and inserts them into population.</summary>
+			GaAsyncSteadyStateStep* _breedStep;
+
+			/// <summary>Flow step that updates statistics and prepares population for the next epoch.</summary>
+			Common::Workflows::GaFlowStep* _nextGenStep;
+
+		public:
+
+			/// <summary>Initializes stub with population on which it will operate and all operations and parameters.</summary>
+			/// <param name="populationID">ID of the population on which the stub will operate.</param>
+			/// <param name="statisticsID">ID of the object that whill store statistical information.</param>
+			/// <param name="initializator">initialization operation for the population.</param>
+			/// <param name="fitnessOperation">fitness operation that evaluates chromosomes in the population. It must allow individual-based evaluation.</param>
+			/// <param name="comparator">fitness comparator used by the population.</param>
+			/// <param name="populationParameters">parameters of the population on which the stub operates.</param>
+			/// <param name="statTrackers">required population statistics trackers.</param>
+			/// <param name="mating">mating operation that produce offspring chromosomes.</param>
+			/// <param name="selectionSize">number of chromosomes that compete in tournament for parent selection.</param>
+			/// <param name="replacementSize">number of chromosomes that compete in tournament for replacement.</param>
+			/// <param name="epochLength">number of matings performed in single epoch or 0 if epoch should produce as many offspring as there are
+			/// chromosomes in the population.</param>
+			/// <param name="crossoverBuffersTagID">ID of population tag that stores crossover buffers of branches.</param>
+			GAL_API
+			GaAsyncSteadyStateStub(int populationID,
+				int statisticsID,
+				const Chromosome::GaInitializatorSetup& initializator,
+				const Population::GaPopulationFitnessOperationSetup& fitnessOperation,
+				const Fitness::GaFitnessComparatorSetup& comparator,
+				const Population::GaPopulationParams& populationParameters,
+				const GaStatTrackersCollection& statTrackers,
+				const Chromosome::GaMatingSetup& mating,
+				int selectionSize,
+				int replacementSize,
+				int epochLength,
+				int crossoverBuffersTagID);
+
+			/// <summary>Initializes stub without population on which it will operate and with default operations and parameters.</summary>
+			GaAsyncSteadyStateStub() : _selectionSize(2),
+				_replacementSize(2),
+				_epochLength(0),
+				_crossoverBuffersTagID(-1) { Clear(); }
+
+			/// <summary><c>SetPopulationParameters</c> method new parameters for the population.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="params">new population parameters.</param>
+			inline void GACALL SetPopulationParameters(Population::GaPopulationParams params) { UpdatePopulationParameters( params ); }
+
+			/// <summary><c>SetInitializator</c> method sets new population initialization operation.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="initializator">new initialization operation.</param>
+			inline void GACALL SetInitializator(const Chromosome::GaInitializatorSetup& initializator) { UpdateInitializator( initializator ); }
+
+			/// <summary><c>SetFitnessOperation</c> method sets new fitness operation for evaluation population's chromosomes.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="fitnessOperation">new fitness operation.</param>
+			/// <exception cref="GaArgumentException" />Thrown if fitness operation does not allow individual-based evaluation of chromosomes.</exception>
+			GAL_API
+			void GACALL SetFitnessOperation(const Population::GaPopulationFitnessOperationSetup& fitnessOperation);
+
+			/// <summary><c>SetFitnessComparator</c> method sets new fitness comparator used by the population.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="comparator">new fitness comparator.</param>
+			inline void GACALL SetFitnessComparator(const Fitness::GaFitnessComparatorSetup& comparator) { UpdateFitnessComparator( comparator ); }
+
+			/// <summary><c>SetMating</c> method sets new mating operation used by the algorithm.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="mating">new mating operation.</param>
+			GAL_API
+			void GACALL SetMating(const Chromosome::GaMatingSetup& mating);
+
+			/// <summary><c>SetTournamentSizes</c> method sets sizes of tournaments used for parent selection and replacement.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="selectionSize">number of chromosomes that compete in tournament for parent selection.</param>
+			/// <param name="replacementSize">number of chromosomes that compete in tournament for replacement.</param>
+			/// <exception cref="GaArgumentOutOfRangeException" />Thrown if <c>selectionSize</c> or <c>replacementSize</c> is not positive.</exception>
+			GAL_API
+			void GACALL SetTournamentSizes(int selectionSize,
+				int replacementSize);
+
+			/// <summary><c>SetEpochLength</c> method sets number of matings performed in single epoch.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="length">number of matings or 0 if epoch should produce as many offspring as there are chromosomes in the population.</param>
+			/// <exception cref="GaArgumentOutOfRangeException" />Thrown if <c>length</c> is negative.</exception>
+			GAL_API
+			void GACALL SetEpochLength(int length);
+
+			/// <summary><c>SetStatsTrackers</c> method registers required population statistics trackers.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="trackers">trackers that should be registered.</param>
+			GAL_API
+			void GACALL SetStatsTrackers(const GaStatTrackersCollection& trackers);
+
+		protected:
+
+			/// <summary>Prepares workflow for the execution.</summary>
+			GAL_API
+			virtual void GACALL Connected();
+
+			/// <summary>Cleans workflow.</summary>
+			GAL_API
+			virtual void GACALL Disconnecting();
+
+			/// <summary>Clears internal bookkeeping of created data objects and flow steps.</summary>
+			GAL_API
+			void GACALL Clear();
+
+		};
+
+	} // Stubs
+} // Algorithm
+
+#endif // __GA_ASYNC_STUB_H__
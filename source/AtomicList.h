@@ -164,6 +164,41 @@ namespace Common
 				return oldHead._first;
 			}
 
+			/// <summary><c>PushRange</c> method puts specified elements at the begining of the queue using single atomic operation.
+			/// Elements are linked in the order in which they are stored in the array.
+			///
+			/// This method is thread-safe.</summary>
+			/// <param name="entries">array of new nodes that should be inserted.</param>
+			/// <param name="count">number of nodes in the array.</param>
+			void PushRange(GaType** entries,
+				int count)
+			{
+				GA_ARG_ASSERT( Exceptions::GaNullArgumentException, entries != NULL, "entries", "New entries that should be inserted must be specified.", "Data" );
+
+				if( count <= 0 )
+					return;
+
+				// link new elements
+				for( int i = 1; i < count; i++ )
+					_nextAccess( *entries[ i - 1 ] ) = entries[ i ];
+
+				GaHead newHead, oldHead;
+				newHead._first = entries[ 0 ];
+
+				do
+				{
+					oldHead = _head;
+
+					// link the last new element to the rest of the queue
+					_nextAccess( *entries[ count - 1 ] ) = oldHead._first;
+
+					// new head unique tag and increase count
+					newHead._tag = oldHead._tag + GaMask + 1 + count;
+
+					// try to replacing head atomically
+				} while( !Threading::GaCmpXchg2<GaHead>::Op( &_head, &oldHead, newHead ) );
+			}
+
 			/// <summary><c>Clear</c> method detaches all elements in the queue.
 			///
 			/// This method is thread-safe.</summary>
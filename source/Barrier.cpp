@@ -24,40 +24,62 @@ namespace Common
 			// don't lock barrier one thread only
 			if( count > 1 )
 			{
-				// wait for previous barrier to finish
-				_event1->Wait();
-
-				// sets number of threads that should reach barrier
-				_currentCount.CompareAndExchange( 0, count );
-
-				// decrease number of thread that should reach the barrier before it can be released
-				bool last = --_currentCount == 0;
+				// sense cannot be changed before this thread arrives
+				int sense = GetCounter( GAC_SENSE );
 
 				// all threads have reached barrier?
-				if( last )
+				if( GaAtomicOps<int>::Add( &GetCounter( GAC_ARRIVED ), 1 ) + 1 == count )
 				{
-					// block usage of this barrier until all waiting threads exit current barrier
-					_event1->Reset();
+					// prepare counter for the next phase
+					GetCounter( GAC_ARRIVED ) = 0;
 
-					// should the last thread that enter the barrier release other threads?
-					if( !releaseIfLast )
-						return true;
+					// release threads waiting for barrier if required
+					if( releaseIfLast )
+						Open( sense );
 
-					// release threads waiting for barrier
-					_event2->Signal();
+					return true;
 				}
-				else
-					// wait for other threads to reach barrier
-					_event2->Wait();
 
-				// exit barrier and wakes all thread that waits
-				Exit( count );
-
-				return last;
+				// wait for other threads to reach barrier
+				Wait( sense );
+				return false;
 			}
 			else
 				return true;
 		}
 
+		// Waits for barrier phase to finish
+		void GaBarrier::Wait(int sense)
+		{
+			volatile int& currentSense = GetCounter( GAC_SENSE );
+			volatile int& spinCount = GetCounter( GAC_SPIN_COUNT );
+
+			// spin for a while before the thread is parked
+			int limit = spinCount;
+			for( int i = 0; i < limit; i++ )
+			{
+				if( currentSense != sense )
+				{
+					// waiting was short so thread should spin longer next time
+					if( limit < MAX_SPIN_COUNT )
+						spinCount = limit + ( limit >> 3 ) + 1;
+
+					return;
+				}
+
+				GaYieldProcessor();
+			}
+
+			// waiting was long so thread should park sooner next time
+			if( limit > MIN_SPIN_COUNT )
+				spinCount = limit >> 1;
+
+			// announce parked thread before checking sense for the last time so releasing thread cannot miss it
+			GaAtomicOps<int>::Add( &GetCounter( GAC_PARKED ), 1 );
+			if( currentSense == sense )
+				_events[ sense ]->Wait();
+			GaAtomicOps<int>::Sub( &GetCounter( GAC_PARKED ), 1 );
+		}
+
 	} // Threading
 } // Common
\ No newline at end of file
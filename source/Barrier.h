@@ -13,6 +13,7 @@
 #ifndef __GA_BARRIER_H__
 #define __GA_BARRIER_H__
 
+#include "Array.h"
 #include "EventPool.h"
 
 /// <summary>This macro synchronize access of multiple threads to a block of code by allowing only one thread to execute it and blocking all others until that block is excuted.</summary>
@@ -26,31 +27,66 @@ namespace Common
 	namespace Threading
 	{
 
-		/// <summary><c>GaBarrier</c> class represent synchronization object which blocks threads which enter it until all required thread reach the barrier.</summary>
+		/// <summary><c>GaBarrier</c> class represent synchronization object which blocks threads which enter it until all required thread reach the barrier.
+		/// Barrier is sense-reversing so it can be reused immediately after it is released. Threads that wait for the barrier first spin for a limited
+		/// number of iterations before they are parked on system event. Spinning interval adapts to the observed waiting time. Counters used by the barrier
+		/// are placed on separate cache lines to prevent false sharing between arriving and waiting threads.</summary>
 		class GaBarrier
 		{
 
+		public:
+
+			/// <summary>Cache line size that is used for padding when the size cannot be obtained from the system.</summary>
+			static const int DEFAULT_CACHE_LINE_SIZE = 64;
+
+			/// <summary>Minimal number of spinning iterations before waiting thread is parked.</summary>
+			static const int MIN_SPIN_COUNT = 64;
+
+			/// <summary>Maximal number of spinning iterations before waiting thread is parked.</summary>
+			static const int MAX_SPIN_COUNT = 16384;
+
 		private:
 
-			/// <summary>Event used to guard barrier from overlapping usage of the barrier. It blocks barrier from using it again while all threads
-			/// exit previsouly initiated barrier.</summary>
-			Memory::GaAutoPtr<GaEvent> _event1;
+			/// <summary>Indices of counters stored in padded array.</summary>
+			enum GaCounter
+			{
+
+				/// <summary>Number of threads that have reached the barrier in the current phase.</summary>
+				GAC_ARRIVED,
+
+				/// <summary>Sense of the current barrier phase.</summary>
+				GAC_SENSE,
+
+				/// <summary>Number of threads currently parked on the event.</summary>
+				GAC_PARKED,
+
+				/// <summary>Current number of spinning iterations before waiting thread is parked.</summary>
+				GAC_SPIN_COUNT,
+
+				/// <summary>Number of counters used by the barrier.</summary>
+				GAC_COUNT
+
+			};
+
+			/// <summary>Counters used by the barrier. Each counter is stored on its own cache line.</summary>
+			Data::GaAlignedArray<int> _counters;
 
-			/// <summary>Event object used to block threads until all reach the barrier.</summary>
-			Memory::GaAutoPtr<GaEvent> _event2;
+			/// <summary>Events on which threads are parked. Event is selected by the sense of the phase in which threads are waiting.</summary>
+			Memory::GaAutoPtr<GaEvent> _events[ 2 ];
 
-			/// <summary>Number of threads currently waiting for barrier to be released.</summary>
-			Common::Threading::GaAtomic<int> _currentCount;
+			/// <summary>Indicates whether the events are signaled. These flags are accessed only by the thread that releases the barrier.</summary>
+			bool _signaled[ 2 ];
 
 		public:
 
-			/// <summary>This counstructor initializes barrier with thread count.</summary>
-			GaBarrier()
+			/// <summary>This counstructor initializes barrier.</summary>
+			GaBarrier() : _counters( GAC_COUNT, GetPadding(), 0 )
 			{
-				_event1 = GaEventPool::GetInstance()->GetEventWithAutoPtr( GaEvent::GAET_MANUAL );
-				_event1->Signal();
+				_events[ 0 ] = GaEventPool::GetInstance()->GetEventWithAutoPtr( GaEvent::GAET_MANUAL );
+				_events[ 1 ] = GaEventPool::GetInstance()->GetEventWithAutoPtr( GaEvent::GAET_MANUAL );
+				_signaled[ 0 ] = _signaled[ 1 ] = false;
 
-				_event2 = GaEventPool::GetInstance()->GetEventWithAutoPtr( GaEvent::GAET_MANUAL );
+				_counters[ GAC_SPIN_COUNT ] = MIN_SPIN_COUNT * 16;
 			}
 
 			/// <summary><c>Enter</c> blocks calling thread until all threads reach the barrier. If this method does not automatically release the barrier, the last thread is not blocked
@@ -72,26 +108,50 @@ namespace Common
 			inline void GACALL Release(int count)
 			{
 				if( count > 1 )
-				{
-					_event2->Signal();
-					Exit( count );
-				}
+					Open( GetCounter( GAC_SENSE ) );
 			}
 
 		private:
 
-			/// <summary>Exits barrier and if the last thread exits it unblocks barrier so it can be used again.</summary>
-			/// <param name="count">number of threads that should reach the barrier so it can be released.</param>
-			inline void GACALL Exit(int count)
+			/// <summary><c>Open</c> method reverses sense of the barrier and wakes threads parked in the current phase.</summary>
+			/// <param name="sense">sense of the phase that is finished.</param>
+			inline void GACALL Open(int sense)
 			{
-				if( count > 1 && ++_currentCount == count )
+				// prepare event for the next phase before any thread can wait on it
+				if( _signaled[ sense ^ 1 ] )
+				{
+					_events[ sense ^ 1 ]->Reset();
+					_signaled[ sense ^ 1 ] = false;
+				}
+
+				GaAtomicOps<int>::Xchg( &GetCounter( GAC_SENSE ), sense ^ 1 );
+
+				// wake parked threads only if there are any
+				if( GetCounter( GAC_PARKED ) > 0 )
 				{
-					_currentCount = 0;
-					_event2->Reset();
-					_event1->Signal();
+					_signaled[ sense ] = true;
+					_events[ sense ]->Signal();
 				}
 			}
 
+			/// <summary><c>Wait</c> method blocks calling thread until the barrier phase with specified sense is finished.</summary>
+			/// <param name="sense">sense of the phase in which the thread waits.</param>
+			GAL_API
+			void GACALL Wait(int sense);
+
+			/// <summary><c>GetCounter</c> method returns counter stored in padded array.</summary>
+			/// <param name="counter">index of the counter.</param>
+			/// <returns>Method returns reference to the counter.</returns>
+			inline volatile int& GACALL GetCounter(GaCounter counter) { return _counters[ counter ]; }
+
+			/// <summary><c>GetPadding</c> method returns size of padding used to separate counters.</summary>
+			/// <returns>Method returns size of CPU cache line or default size if it cannot be obtained.</returns>
+			static inline int GACALL GetPadding()
+			{
+				int size = GaCpuInfo::GetInstance().GetCacheLineSize();
+				return size > 0 ? size : DEFAULT_CACHE_LINE_SIZE;
+			}
+
 		};
 
 		/// <summary><c>GaBarrierLock</c> class provides mechanism to synchronize access of multiple threads to a block of code by allowing only
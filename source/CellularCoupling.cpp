@@ -73,8 +73,12 @@ namespace Population
 			int branchID = branch->GetFilteredID();
 			int branchCount = branch->GetBarrierCount();
 
+			// reserve positions for all offspring
 			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+			{
 				output.Clear();
+				output.SetCount( parameters.GetNumberOfOffsprings() );
+			}
 
 			GaChromosomeTagGetter<Common::Grid::GaHyperBox> getHyperBox( parameters.GetHyperBoxTagID(), population.GetChromosomeTagManager() );
 			GaChromosomeTagGetter<int> getRank( parameters.GetRankTagID(), population.GetChromosomeTagManager() );
@@ -101,6 +105,9 @@ namespace Population
 			int parentCount = configuration.GetMating().GetConfiguration().GetParentCount();
 			for( int i = start + count - 1; i >= start; i-- )
 			{
+				// random numbers used by mating operation are mapped to substream of the offspring
+				branch->SelectRandomSubstream( i );
+
 				GaChromosomeStorage* parent1 = &input[ i % input.GetCount() ];
 				GaChromosomeStorage* parent2 = bestChromosomes[ getHyperBox( parent1 ) ].GetBest();
 
@@ -145,23 +152,34 @@ namespace Population
 				// produce offspring
 				configuration.Mate( crossoverBuffer );
 
-				// store offspring to result set
-				for( int j = offspring.GetCount() - 1; j >= 0; j-- )
+				// find offspring of selected chromosome, if there is no such offspring the last one is used
+				int j = offspring.GetCount() - 1;
+				for( int k = j; k >= 0; k-- )
 				{
-					if( offspring[ j ].GetParent() == parent1 )
+					if( offspring[ k ].GetParent() == parent1 )
 					{
-						output.Add( &offspring[ j ] );
-						offspring.Remove( j, true );
+						j = k;
 						break;
 					}
 				}
 
+				// store offspring to result set at position reserved for it
+				if( j >= 0 )
+				{
+					output.SetAt( i, &offspring[ j ] );
+					offspring.Remove( j, true );
+				}
+
 				// update operation counters
 				counters.CollectCrossoverBufferCounters( crossoverBuffer );
 
 				crossoverBuffer.Clear();
 			}
 
+			// remove positions of offspring that matings have not produced
+			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+				output.Compact();
+
 			// update population statistics with new state of counters
 			counters.UpdateStatistics();
 		}
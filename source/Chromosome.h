@@ -13,7 +13,10 @@
 #ifndef __GA_CHROMOSOME_H__
 #define __GA_CHROMOSOME_H__
 
+#include <algorithm>
+#include <vector>
 #include "SmartPtr.h"
+#include "SlabAllocator.h"
 
 /// <summary>Contains interfaces, classes and datatypes that are needed to represent chromosomes in the library.</summary>
 namespace Chromosome
@@ -34,6 +37,9 @@ namespace Chromosome
 		/// <summary>Auto pointer to chromosome parameters.</summary>
 		Common::Memory::GaAutoPtr<GaChromosomeParams> _chromosomeParams;
 
+		/// <summary>Allocator shared by chromosomes that use this CCB which provides memory for their genes.</summary>
+		Common::Memory::GaSmartPtr<Common::Memory::GaSlabAllocator> _geneAllocator;
+
 	public:
 
 		/// <summary>This constructor initializes CCB with pointer to chromosome parameters. The constructor creates and stores copy of provided parameters' object.</summary>
@@ -43,9 +49,10 @@ namespace Chromosome
 		/// <summary>This constructor initializes empty CCB.</summary>
 		GaChromosomeConfigBlock() : _chromosomeParams(NULL) { }
 
-		/// <summary>Copy constructor. The constructor creates and stored copy of chromosome parameters that ar stored in proveded CCB.</summary>
+		/// <summary>Copy constructor. The constructor creates and stored copy of chromosome parameters that ar stored in proveded CCB.
+		/// Gene allocator is shared with the source CCB.</summary>
 		/// <param name="rhs">source CCB which should be copied.</param>
-		GaChromosomeConfigBlock(const GaChromosomeConfigBlock& rhs) { SetChromosomeParams( rhs._chromosomeParams.GetRawPtr() ); }
+		GaChromosomeConfigBlock(const GaChromosomeConfigBlock& rhs) : _geneAllocator(rhs._geneAllocator) { SetChromosomeParams( rhs._chromosomeParams.GetRawPtr() ); }
 
 		/// <summary>Virtual destructor must be defined because this is base class.</summary>
 		virtual ~GaChromosomeConfigBlock() { }
@@ -70,6 +77,18 @@ namespace Chromosome
 		/// <returns>Method returns pointer to chromosome parameters sotred in CCB.</returns>
 		inline const GaChromosomeParams* GACALL GetChromosomeParams() const { return _chromosomeParams.GetRawPtr(); }
 
+		/// <summary><c>SetGeneAllocator</c> method sets allocator that provides memory for genes of chromosomes which use this CCB.
+		/// Chromosomes that store genes in single-dimensional arrays take memory from the allocator when their genes fit into single slot, so slot size
+		/// should match length of fixed-length chromosomes. Chromosomes keep reference to the allocator, so it lives until the last chromosome is destroyed.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="allocator">smart pointer to the allocator. If it is <c>NULL</c>, genes are allocated from the heap.</param>
+		inline void GACALL SetGeneAllocator(Common::Memory::GaSmartPtr<Common::Memory::GaSlabAllocator> allocator) { _geneAllocator = allocator; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns smart pointer to allocator that provides memory for genes.</returns>
+		inline Common::Memory::GaSmartPtr<Common::Memory::GaSlabAllocator> GACALL GetGeneAllocator() const { return _geneAllocator; }
+
 		/// <summary><c>operator =</c> copies data from provided CCB.
 		///
 		/// This operator is not thread-safe.</summary>
@@ -78,6 +97,7 @@ namespace Chromosome
 		virtual GaChromosomeConfigBlock& GACALL operator =(const GaChromosomeConfigBlock& rhs)
 		{
 			SetChromosomeParams( rhs._chromosomeParams.GetRawPtr() );
+			_geneAllocator = rhs._geneAllocator;
 			return *this;
 		}
 
@@ -157,8 +177,66 @@ namespace Chromosome
 		/// <param name="e">event that was raised.</param>
 		virtual void GACALL MutationEvent(GaMuataionEvent e) = 0;
 
+		/// <summary><c>Serialize</c> method appends code of the chromosome to the buffer, so it can be transfered to another process.
+		/// Chromosomes that can be evaluated out of process should override this method and <see cref="Deserialize" /> method.</summary>
+		/// <param name="buffer">buffer to which the code is appended.</param>
+		/// <returns>Default implementation returns <c>false</c> which indicates that chromosome does not support serialization.</returns>
+		virtual bool GACALL Serialize(std::vector<char>& buffer) const { return false; }
+
+		/// <summary><c>Deserialize</c> method restores code of the chromosome from data produced by <see cref="Serialize" /> method.</summary>
+		/// <param name="data">pointer to serialized code.</param>
+		/// <param name="size">size of serialized code in bytes.</param>
+		/// <returns>Method returns <c>true</c> if the code is restored. Default implementation returns <c>false</c>.</returns>
+		virtual bool GACALL Deserialize(const char* data,
+			int size) { return false; }
+
 	};
 
+	/// <summary><c>GaSerializeValue</c> function serializes value stored in chromosome's code.
+	/// This version is used for types which cannot be serialized and it does nothing.</summary>
+	/// <typeparam name="VALUE_TYPE">type of value.</typeparam>
+	/// <param name="value">value that should be serialized.</param>
+	/// <param name="buffer">buffer to which the value is appended.</param>
+	/// <returns>Function returns <c>false</c>.</returns>
+	template<typename VALUE_TYPE>
+	inline bool GACALL GaSerializeValue(const VALUE_TYPE& value,
+		std::vector<char>& buffer) { return false; }
+
+	/// <summary><c>GaDeserializeValue</c> function restores value stored in chromosome's code.
+	/// This version is used for types which cannot be serialized and it does nothing.</summary>
+	/// <typeparam name="VALUE_TYPE">type of value.</typeparam>
+	/// <param name="value">reference to variable that will store restored value.</param>
+	/// <param name="data">pointer to serialized value.</param>
+	/// <param name="size">number of available bytes.</param>
+	/// <returns>Function returns -1.</returns>
+	template<typename VALUE_TYPE>
+	inline int GACALL GaDeserializeValue(VALUE_TYPE& value,
+		const char* data,
+		int size) { return -1; }
+
+	/// <summary><c>GA_SERIALIZABLE_VALUE</c> macro defines functions that serialize and restore values of plain type by copying their memory.
+	/// Restoring function returns number of consumed bytes or -1 if there is not enough data.</summary>
+	/// <param name="TYPE">plain type.</param>
+	#define GA_SERIALIZABLE_VALUE(TYPE) \
+		inline bool GACALL GaSerializeValue(const TYPE& value, std::vector<char>& buffer) \
+			{ buffer.insert( buffer.end(), (const char*)&value, (const char*)&value + sizeof( TYPE ) ); return true; } \
+		inline int GACALL GaDeserializeValue(TYPE& value, const char* data, int size) \
+			{ if( size < (int)sizeof( TYPE ) ) return -1; std::copy( data, data + sizeof( TYPE ), (char*)&value ); return (int)sizeof( TYPE ); }
+
+	GA_SERIALIZABLE_VALUE( bool )
+	GA_SERIALIZABLE_VALUE( char )
+	GA_SERIALIZABLE_VALUE( unsigned char )
+	GA_SERIALIZABLE_VALUE( short )
+	GA_SERIALIZABLE_VALUE( unsigned short )
+	GA_SERIALIZABLE_VALUE( int )
+	GA_SERIALIZABLE_VALUE( unsigned int )
+	GA_SERIALIZABLE_VALUE( long )
+	GA_SERIALIZABLE_VALUE( unsigned long )
+	GA_SERIALIZABLE_VALUE( long long )
+	GA_SERIALIZABLE_VALUE( unsigned long long )
+	GA_SERIALIZABLE_VALUE( float )
+	GA_SERIALIZABLE_VALUE( double )
+
 	/// <summary><c>GaChromosomePtr</c> type is instance of <see cref="GaSmartPtr" /> template class and represents smart pointer to a chromosome.
 	/// Detailed description can be found in specification of <see cref="GaSmartPtr" /> template class.</summary>
 	typedef Common::Memory::GaSmartPtr<GaChromosome> GaChromosomePtr;
@@ -61,6 +61,37 @@ namespace Population
 		return pos;
 	}
 
+	// Reserves positions for chromosomes
+	void GaChromosomeGroup::SetCount(int count)
+	{
+		GA_ARG_ASSERT( Common::Exceptions::GaArgumentOutOfRangeException, count >= 0, "count", "Number of chromosomes cannot be negative value.", "Population" );
+		GA_ASSERT( Common::Exceptions::GaInvalidOperationException, !_count, "Group must be empty before positions are reserved.", "Population" );
+
+		_hasShuffleBackup = false;
+
+		// expand group to accommodate all chromosomes
+		if( count > _array.GetSize() )
+			ResizeArray( count );
+
+		for( int i = count - 1; i >= 0; i-- )
+			_chromosomes[ i ] = NULL;
+
+		_count = count;
+	}
+
+	// Removes empty reserved positions
+	void GaChromosomeGroup::Compact()
+	{
+		int count = 0;
+		for( int i = 0; i < _count; i++ )
+		{
+			if( _chromosomes[ i ] )
+				_chromosomes[ count++ ] = _chromosomes[ i ];
+		}
+
+		_count = count;
+	}
+
 	// Removes chromosome from the group
 	bool GaChromosomeGroup::Remove(GaChromosomeStorage* chromosome,
 		bool dontRecycle/* = false*/)
@@ -178,6 +178,37 @@ namespace Population
 		GAL_API
 		int GACALL AddAtomic(GaChromosomeStorage* chromosome);
 
+		/// <summary><c>SetAt</c> method stores chromosome at specified position in the group. Position must be within the number of chromosomes
+		/// reserved by <see cref="SetCount" /> method. Unlike <see cref="AddAtomic" /> the position of the chromosome does not depend on the order
+		/// in which threads store chromosomes, so different threads can safely store chromosomes at different positions simultaneously,
+		/// but no other methods on this object should be executed from other threads at that time.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="index">position at which the chromosome should be stored.</param>
+		/// <param name="chromosome">pointer to chromosome that should be stored.</param>
+		inline void GACALL SetAt(int index,
+			GaChromosomeStorage* chromosome)
+		{
+			_chromosomes[ index ] = chromosome;
+			chromosome->GetFlags().SetFlags( _membershipFlag );
+		}
+
+		/// <summary><c>SetCount</c> method reserves positions for specified number of chromosomes, so they can be stored using <see cref="SetAt" /> method.
+		/// Group must be empty and all reserved positions must be filled or removed by <see cref="Compact" /> method before the group is used.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="count">number of chromosomes that will be stored in the group.</param>
+		/// <exception cref="GaArgumentOutOfRangeException" />Thrown if <c>count</c> is negative value.</exception>
+		/// <exception cref="GaInvalidOperationException" />Thrown if the group is not empty.</exception>
+		GAL_API
+		void GACALL SetCount(int count);
+
+		/// <summary><c>Compact</c> method removes reserved positions that have not been filled and preserves order of stored chromosomes.
+		///
+		/// This method is not thread-safe.</summary>
+		GAL_API
+		void GACALL Compact();
+
 		/// <summary><c>Remove</c> method removes specified chromosome from the group.
 		///
 		/// This method is not thread-safe.</summary>
@@ -688,6 +688,17 @@ namespace Chromosome
 			const GaChromosome& chromosome2,
 			const GaChromosomeComparatorParams& parameters) const = 0;
 
+		/// <summary><c>GetHash</c> method calculates fingerprint of chromosome's code, so equal chromosomes can be found without comparing them against
+		/// all other chromosomes. Chromosomes for which <see cref="Equal" /> method returns <c>true</c> must have same hash values.
+		/// Comparators that can calculate hash should override this method.</summary>
+		/// <param name="chromosome">reference to the chromosome whose hash should be calculated.</param>
+		/// <param name="parameters">reference to parameters of chromosome comparison operation.</param>
+		/// <param name="hash">reference to variable that will store calculated hash.</param>
+		/// <returns>Default implementation returns <c>false</c> which indicates that comparator does not support hashing.</returns>
+		virtual bool GACALL GetHash(const GaChromosome& chromosome,
+			const GaChromosomeComparatorParams& parameters,
+			unsigned long long& hash) const { return false; }
+
 		/// <summary>More details are given in specification of <see cref="GaOperation::CreateConfiguration" /> method.
 		///
 		/// This method is thread-safe.</summary>
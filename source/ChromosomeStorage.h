@@ -72,6 +72,9 @@ namespace Population
 		/// <summary>Chromosome's tags.</summary>
 		Common::Data::GaTagBuffer _tagBuffer;
 
+		/// <summary>Slot assigned by tag manager at which chromosome's tags are stored in tag columns.</summary>
+		int _tagSlot;
+
 		/// <summary>Chromosome's flags.</summary>
 		GaFlagType _flags;
 
@@ -84,7 +87,8 @@ namespace Population
 		/// <param name="rawFitness">pointer to fitness object that will be used to store raw fitness value of chromosome. Storage object takse ownership of the object.</param>
 		/// <param name="scaledFitness">pointer to fitness object that will be used to store scaled fitness value of chromosome. Storage object takse ownership of the object.</param>
 		GaChromosomeStorage(Fitness::GaFitness* rawFitness,
-			Fitness::GaFitness* scaledFitness) : _parent(NULL)
+			Fitness::GaFitness* scaledFitness) : _tagSlot(-1),
+			_parent(NULL)
 		{
 			_fitness[ GAFT_RAW ] = rawFitness;
 			_fitness[ GAFT_SCALED ] = scaledFitness;
@@ -146,6 +150,16 @@ namespace Population
 		/// <returns>Method returns reference to buffer that contaions chromosome's tags.</summary>
 		inline const Common::Data::GaTagBuffer& GetTags() const { return _tagBuffer; }
 
+		/// <summary><c>SetTagSlot</c> method sets slot at which chromosome's tags are stored in tag columns.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="slot">slot assigned by tag manager or -1 if tags are not stored in columns.</param>
+		inline void GACALL SetTagSlot(int slot) { _tagSlot = slot; }
+
+		/// <summary>This method is thread-safe.</summary>
+		/// <returns>Method returns slot at which chromosome's tags are stored in tag columns or -1 if tags are not stored in columns.</returns>
+		inline int GACALL GetTagSlot() const { return _tagSlot; }
+
 		/// <summary>This method is not thread-safe.</summary>
 		/// <returns>Method returns pointer object that sotres chromosome's flags.</returns>
 		inline GaFlagType& GACALL GetFlags() { return _flags; }
@@ -183,16 +197,87 @@ namespace Population
 	class GaChromosomeTagGetter : public Common::Data::GaTagGetter<DATA_TYPE, GaChromosomeStorage>
 	{
 
+	public:
+
+		/// <summary>Type of data stored in tag.</summary>
+		typedef DATA_TYPE GaDataType;
+
+		/// <summary>Type of getter that accesses tags stored in chromosomes' tag buffers.</summary>
+		typedef Common::Data::GaTagGetter<GaDataType, GaChromosomeStorage> GaBufferGetter;
+
+		/// <summary>Type of column that stores tag.</summary>
+		typedef Common::Data::GaTypedTagColumn<GaDataType> GaColumnType;
+
+	private:
+
+		/// <summary>Manager that stores tags in columns or <c>NULL</c> if tags are stored in chromosomes' tag buffers.
+		/// Column is queried on each access, since it is replaced or deleted when the tag is replaced or removed.</summary>
+		const Common::Data::GaTagManager* _tagManager;
+
 	public:
 
 		/// <summary>Initializes tag getter for specific tag.</summary>
 		/// <param name="tagID">tag ID.</param>
 		/// <param name="tagManager">pointer to manager that handles tags and tag buffers</param>
 		GaChromosomeTagGetter(int tagID,
-			const Common::Data::GaTagManager& tagManager) : GaTagGetter(tagID, tagManager) { }
+			const Common::Data::GaTagManager& tagManager) : _tagManager(NULL) { SetTagID( tagID, tagManager ); }
 
 		/// <summary>Default constructor.</summary>
-		GaChromosomeTagGetter() { }
+		GaChromosomeTagGetter() : _tagManager(NULL) { }
+
+		/// <summary><c>SetTagID</c> sets which tag should be accessed.
+		///
+		/// This operator is not thread-safe.</summary>
+		/// <param name="tagID">tag ID.</param>
+		/// <param name="tagManager">pointer to manager that handles tags and tag buffers</param>
+		inline void GACALL SetTagID(int tagID,
+			const Common::Data::GaTagManager& tagManager)
+		{
+			GaBufferGetter::SetTagID( tagID, tagManager );
+			_tagManager = tagManager.IsColumnStorage() ? &tagManager : NULL;
+		}
+
+		/// <summary><c>operator ()</c> operator extracts tag data directly from column or from chromosome's tag buffer.
+		///
+		/// This operator is not thread-safe.</summary>
+		/// <param name="object">reference to chromosome from which the tag data should be extracted.</param>
+		/// <returns>Operator returns reference to tag's data.</returns>
+		inline GaDataType& GACALL operator ()(GaChromosomeStorage& object)
+		{
+			GaColumnType* column = GetColumn();
+			return column ? column->GetTag( object.GetTagSlot() ).GetData() : GaBufferGetter::operator ()( object );
+		}
+
+		/// <summary><c>operator ()</c> operator extracts tag data directly from column or from chromosome's tag buffer.
+		///
+		/// This operator is not thread-safe.</summary>
+		/// <param name="object">reference to chromosome from which the tag data should be extracted.</param>
+		/// <returns>Operator returns reference to tag's data.</returns>
+		inline const GaDataType& GACALL operator ()(const GaChromosomeStorage& object) const
+		{
+			GaColumnType* column = GetColumn();
+			return column ? column->GetTag( object.GetTagSlot() ).GetData() : GaBufferGetter::operator ()( object );
+		}
+
+		/// <summary><c>operator ()</c> operator extracts tag data directly from column or from chromosome's tag buffer.
+		///
+		/// This operator is not thread-safe.</summary>
+		/// <param name="object">pointer to chromosome from which the tag data should be extracted.</param>
+		/// <returns>Operator returns reference to tag's data.</returns>
+		inline GaDataType& GACALL operator ()(GaChromosomeStorage* object) { return operator ()( *object ); }
+
+		/// <summary><c>operator ()</c> operator extracts tag data directly from column or from chromosome's tag buffer.
+		///
+		/// This operator is not thread-safe.</summary>
+		/// <param name="object">pointer to chromosome from which the tag data should be extracted.</param>
+		/// <returns>Operator returns reference to tag's data.</returns>
+		inline const GaDataType& GACALL operator ()(const GaChromosomeStorage* object) const { return operator ()( *object ); }
+
+	private:
+
+		/// <summary><c>GetColumn</c> method queries tag manager for column that currently stores the tag.</summary>
+		/// <returns>Method returns pointer to the column or <c>NULL</c> if tag is stored in chromosomes' tag buffers.</returns>
+		inline GaColumnType* GACALL GetColumn() const { return _tagManager ? (GaColumnType*)_tagManager->GetColumn( this->GetTagIndex() ) : NULL; }
 
 	};
 
@@ -0,0 +1,174 @@
+/*! \file Clustering.cpp
+    \brief This file contains implementation of classes that implement agglomerative hierarchical clustering of points.
+*/
+
+/*
+ *
+ * website: http://kataklinger.com/
+ * contact: me[at]kataklinger.com
+ *
+ */
+
+#include <algorithm>
+#include "Clustering.h"
+
+namespace Multiobjective
+{
+
+	// Sets number of points
+	void GaAgglomerativeClustering::SetSize(int count)
+	{
+		GA_ARG_ASSERT( Common::Exceptions::GaArgumentOutOfRangeException, count >= 0 && count <= MAX_POINTS, "count", "Number of points is out of range.", "Multiobjective" );
+
+		_count = count;
+		_clusterCount = 0;
+
+		if( _sizes.GetSize() < count )
+		{
+			_sizes.SetSize( count );
+			_active.SetSize( count );
+			_chain.SetSize( count );
+			_merges.SetSize( count );
+			_parents.SetSize( count );
+			_clusters.SetSize( count );
+			_clusterStarts.SetSize( count + 1 );
+			_members.SetSize( count );
+		}
+
+		if( _distances.GetSize() < GetPairCount() )
+			_distances.SetSize( GetPairCount() );
+	}
+
+	// Groups points into clusters
+	void GaAgglomerativeClustering::Merge(int clusterCount)
+	{
+		if( clusterCount < 1 )
+			clusterCount = 1;
+
+		for( int i = 0; i < _count; i++ )
+		{
+			_sizes[ i ] = 1;
+			_active[ i ] = true;
+			_parents[ i ] = i;
+		}
+
+		int required = _count - clusterCount;
+		if( required > 0 )
+		{
+			// build complete hierarchy using nearest-neighbour chain
+			int mergeCount = 0;
+			for( int chainLength = 0, next = 0; mergeCount < _count - 1; )
+			{
+				// start new chain from any cluster
+				if( chainLength == 0 )
+				{
+					while( !_active[ next ] )
+						next++;
+
+					_chain[ chainLength++ ] = next;
+				}
+
+				int current = _chain[ chainLength - 1 ];
+				int previous = chainLength > 1 ? _chain[ chainLength - 2 ] : -1;
+
+				// find nearest cluster, previous cluster in the chain is preferred when distances are equal
+				int nearest = previous;
+				float minDist = previous >= 0 ? GetDistance( current, previous ) : 0;
+				for( int i = 0; i < _count; i++ )
+				{
+					if( i != current && _active[ i ] )
+					{
+						float dist = GetDistance( current, i );
+						if( nearest < 0 || dist < minDist )
+						{
+							nearest = i;
+							minDist = dist;
+						}
+					}
+				}
+
+				// extend the chain if clusters are not reciprocal nearest neighbours
+				if( nearest != previous )
+				{
+					_chain[ chainLength++ ] = nearest;
+					continue;
+				}
+
+				chainLength -= 2;
+
+				// update distances of other clusters to the merged cluster using Lance-Williams formula for average linkage
+				float weightA = (float)_sizes[ current ] / ( _sizes[ current ] + _sizes[ previous ] );
+				float weightB = 1.0f - weightA;
+				for( int i = 0; i < _count; i++ )
+				{
+					if( i != current && i != previous && _active[ i ] )
+					{
+						float& dist = GetDistance( previous, i );
+						dist = weightA * GetDistance( current, i ) + weightB * dist;
+					}
+				}
+
+				// merged cluster is represented by the previous cluster in the chain
+				_sizes[ previous ] += _sizes[ current ];
+				_active[ current ] = false;
+
+				GaMerge& merge = _merges[ mergeCount++ ];
+				merge._clusterA = previous;
+				merge._clusterB = current;
+				merge._height = minDist;
+			}
+
+			// apply merges with lowest heights
+			std::stable_sort( _merges.GetArray(), _merges.GetArray() + mergeCount );
+			for( int i = 0; i < required; i++ )
+				_parents[ FindSet( _merges[ i ]._clusterB ) ] = FindSet( _merges[ i ]._clusterA );
+		}
+
+		// number clusters
+		_clusterCount = 0;
+		for( int i = 0; i < _count; i++ )
+			_clusters[ i ] = -1;
+		for( int i = 0; i < _count; i++ )
+		{
+			int root = FindSet( i );
+			if( _clusters[ root ] < 0 )
+				_clusters[ root ] = _clusterCount++;
+
+			_clusters[ i ] = _clusters[ root ];
+		}
+
+		// count members of clusters
+		for( int i = 0; i <= _clusterCount; i++ )
+			_clusterStarts[ i ] = 0;
+		for( int i = 0; i < _count; i++ )
+			_clusterStarts[ _clusters[ i ] + 1 ]++;
+		for( int i = 0; i < _clusterCount; i++ )
+		{
+			_clusterStarts[ i + 1 ] += _clusterStarts[ i ];
+			_chain[ i ] = _clusterStarts[ i ];
+		}
+
+		// group points by clusters
+		for( int i = 0; i < _count; i++ )
+			_members[ _chain[ _clusters[ i ] ]++ ] = i;
+	}
+
+	// Finds representative of the set
+	int GaAgglomerativeClustering::FindSet(int point)
+	{
+		int root = point;
+		while( _parents[ root ] != root )
+			root = _parents[ root ];
+
+		// compress path
+		while( _parents[ point ] != root )
+		{
+			int next = _parents[ point ];
+			_parents[ point ] = root;
+			point = next;
+		}
+
+		return root;
+	}
+
+} // Multiobjective
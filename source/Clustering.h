@@ -0,0 +1,204 @@
+/*! \file Clustering.h
+    \brief This file declares classes that implement agglomerative hierarchical clustering of points.
+*/
+
+/*
+ *
+ * website: http://kataklinger.com/
+ * contact: me[at]kataklinger.com
+ *
+ */
+
+#ifndef __GA_CLUSTERING_H__
+#define __GA_CLUSTERING_H__
+
+#include <cmath>
+#include "Array.h"
+
+namespace Multiobjective
+{
+
+	/// <summary><c>GaAgglomerativeClustering</c> class groups points into specified number of clusters using average linkage (UPGMA) hierarchical clustering.
+	/// Distances between all pairs of points are cached in condensed triangular matrix. Distances between clusters are updated using Lance-Williams formula
+	/// when two clusters are merged, and nearest-neighbour chain algorithm is used to build hierarchy in O(n^2) time. Merges are then applied in order
+	/// of their heights, which produces same clusters as repeated merging of two closest clusters.
+	///
+	/// Distance matrix can be filled by multiple threads concurrently, each thread filling its own range of pairs.
+	///
+	/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
+	/// No public or private methods are thread-safe.</summary>
+	class GaAgglomerativeClustering
+	{
+
+	public:
+
+		/// <summary>Maximal number of points that can be clustered.</summary>
+		static const int MAX_POINTS = 65535;
+
+	private:
+
+		/// <summary><c>GaMerge</c> struct stores information about two clusters merged by the algorithm.</summary>
+		struct GaMerge
+		{
+
+			/// <summary>Point that represents the first cluster.</summary>
+			int _clusterA;
+
+			/// <summary>Point that represents the second cluster.</summary>
+			int _clusterB;
+
+			/// <summary>Distance between clusters at the time they were merged.</summary>
+			float _height;
+
+			/// <summary><c>operator &lt;</c> compares heights of two merges.</summary>
+			/// <param name="rhs">the second merge.</param>
+			/// <returns>Method returns <c>true</c> if this merge has lower height.</returns>
+			inline bool GACALL operator <(const GaMerge& rhs) const { return _height < rhs._height; }
+
+		};
+
+		/// <summary>Number of points.</summary>
+		int _count;
+
+		/// <summary>Number of clusters produced by the last clustering.</summary>
+		int _clusterCount;
+
+		/// <summary>Distances between pairs of points stored in condensed triangular matrix. Rows are overwritten by distances between clusters during merging.</summary>
+		Common::Data::GaSingleDimensionArray<float> _distances;
+
+		/// <summary>Number of points in cluster represented by each point.</summary>
+		Common::Data::GaSingleDimensionArray<int> _sizes;
+
+		/// <summary>Marks points that still represent clusters during merging.</summary>
+		Common::Data::GaSingleDimensionArray<bool> _active;
+
+		/// <summary>Chain of nearest neighbours.</summary>
+		Common::Data::GaSingleDimensionArray<int> _chain;
+
+		/// <summary>Merges performed by nearest-neighbour chain algorithm.</summary>
+		Common::Data::GaSingleDimensionArray<GaMerge> _merges;
+
+		/// <summary>Disjoint sets of points used to apply merges.</summary>
+		Common::Data::GaSingleDimensionArray<int> _parents;
+
+		/// <summary>Cluster to which each point belongs.</summary>
+		Common::Data::GaSingleDimensionArray<int> _clusters;
+
+		/// <summary>Position of the first member of each cluster in <c>_members</c> array.</summary>
+		Common::Data::GaSingleDimensionArray<int> _clusterStarts;
+
+		/// <summary>Points grouped by clusters.</summary>
+		Common::Data::GaSingleDimensionArray<int> _members;
+
+	public:
+
+		/// <summary>This constructor initializes empty clustering.</summary>
+		GaAgglomerativeClustering() : _count(0),
+			_clusterCount(0) { }
+
+		/// <summary><c>SetSize</c> method sets number of points that should be clustered.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="count">number of points.</param>
+		/// <exception cref="GaArgumentOutOfRangeException" />Thrown if number of points is negative or exceeds <c>MAX_POINTS</c>.</exception>
+		GAL_API
+		void GACALL SetSize(int count);
+
+		/// <summary><c>CalculateDistances</c> method calculates distances for range of pairs in condensed distance matrix.
+		/// Pairs are ordered row by row, so the pair at position <c>i * (i - 1) / 2 + j</c> is pair of points <c>i</c> and <c>j</c> where <c>j &lt; i</c>.
+		///
+		/// This method is thread-safe as long as ranges of concurrent calls do not overlap.</summary>
+		/// <typeparam name="DISTANCE">type of functor that calculates distance between two points.</typeparam>
+		/// <param name="distance">functor that calculates distance between two points.</param>
+		/// <param name="start">position of the first pair.</param>
+		/// <param name="count">number of pairs.</param>
+		template<typename DISTANCE>
+		void GACALL CalculateDistances(DISTANCE& distance,
+			int start,
+			int count)
+		{
+			if( count <= 0 )
+				return;
+
+			// find row of the first pair
+			int i = (int)( ( 1 + std::sqrt( 1.0 + 8.0 * start ) ) / 2 );
+			while( GetRowStart( i ) > start )
+				i--;
+			while( GetRowStart( i + 1 ) <= start )
+				i++;
+
+			for( int j = (int)( start - GetRowStart( i ) ), end = start + count; start < end; start++ )
+			{
+				_distances[ start ] = distance( i, j );
+
+				// move to the next row
+				if( ++j == i )
+				{
+					i++;
+					j = 0;
+				}
+			}
+		}
+
+		/// <summary><c>Merge</c> method groups points into specified number of clusters using distances stored in the matrix.
+		/// Distance matrix is destroyed by the operation.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="clusterCount">number of clusters that should be produced.</param>
+		GAL_API
+		void GACALL Merge(int clusterCount);
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns number of pairs of points.</returns>
+		inline int GACALL GetPairCount() const { return (int)GetRowStart( _count ); }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns number of points.</returns>
+		inline int GACALL GetCount() const { return _count; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns number of clusters produced by the last clustering.</returns>
+		inline int GACALL GetClusterCount() const { return _clusterCount; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <param name="cluster">index of the cluster.</param>
+		/// <returns>Method returns number of points that belong to the cluster.</returns>
+		inline int GACALL GetClusterSize(int cluster) const { return _clusterStarts[ cluster + 1 ] - _clusterStarts[ cluster ]; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <param name="cluster">index of the cluster.</param>
+		/// <param name="index">index of the member within the cluster.</param>
+		/// <returns>Method returns point that is member of the cluster.</returns>
+		inline int GACALL GetClusterMember(int cluster,
+			int index) const { return _members[ _clusterStarts[ cluster ] + index ]; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <param name="point">index of the point.</param>
+		/// <returns>Method returns cluster to which the point belongs.</returns>
+		inline int GACALL GetCluster(int point) const { return _clusters[ point ]; }
+
+	private:
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <param name="point1">the first point.</param>
+		/// <param name="point2">the second point.</param>
+		/// <returns>Method returns reference to stored distance between two points or clusters they represent.</returns>
+		inline float& GACALL GetDistance(int point1,
+			int point2) { return point1 > point2 ? _distances[ (int)( GetRowStart( point1 ) + point2 ) ] : _distances[ (int)( GetRowStart( point2 ) + point1 ) ]; }
+
+		/// <summary><c>GetRowStart</c> method calculates position of the first pair in the row of the distance matrix.
+		/// Position is calculated using 64-bit arithmetic, since intermediate product overflows <c>int</c> for large number of points.</summary>
+		/// <param name="point">index of the point that defines the row.</param>
+		/// <returns>Method returns position of pair of specified point and the first point.</returns>
+		static inline long long GACALL GetRowStart(int point) { return (long long)point * ( point - 1 ) / 2; }
+
+		/// <summary><c>FindSet</c> method finds representative of the set to which the point belongs.</summary>
+		/// <param name="point">index of the point.</param>
+		/// <returns>Method returns representative point of the set.</returns>
+		int GACALL FindSet(int point);
+
+	};
+
+} // Multiobjective
+
+#endif // __GA_CLUSTERING_H__
@@ -39,24 +39,37 @@ namespace Population
 
 			GaCouplingCounters counters( population, GADV_COUPLING_TIME );
 
-			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
-				output.Clear();
-
 			const Chromosome::GaMatingConfig& matingConf = configuration.GetMating().GetConfiguration();
 			int parentPerCrossover = matingConf.GetParentCount(), offspringCount = matingConf.GetOffspringCount();
+			int matingCount = parameters.GetNumberOfOffsprings() / offspringCount;
+
+			// reserve positions for offspring of all matings
+			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
+			{
+				output.Clear();
+				output.SetCount( matingCount * offspringCount );
+			}
 
 			GaCrossoverStorageBuffer& crossoverBuffer = population.GetTagByID<GaPartialCrossoverBuffer>( parameters.GetCrossoverBuffersTagID() )[ branch->GetFilteredID() ];
 			GaChromosomeGroup& parents = crossoverBuffer.GetParents();
-			GaChromosomeGroup& offspring = crossoverBuffer.GetOffspring();
+
+			// improving-only mutations require fitness values of offspring before mutation is performed
+			const Chromosome::GaMutationSetup& mutation = matingConf.GetMutation();
+			bool improvingMutations = mutation.HasParameters() && mutation.GetParameters().GetImprovingMutationsFlag();
+
+			crossoverBuffer.SetEvaluationChunkSize( improvingMutations ? 0 : parameters.GetEvaluationChunkSize() );
 
 			// get workload for this branch
 			int start, work;
-			branch->SplitWork( parameters.GetNumberOfOffsprings() / offspringCount, work, start );
+			branch->SplitWork( matingCount, work, start );
 			int end = start + work;
 
 			int round = 0, parentCount = input.GetSize();
 			for( int i = start; i < end; i++ )
 			{
+				// random numbers used by mating operation are mapped to substream of the offspring
+				branch->SelectRandomSubstream( i );
+
 				// get enough parents to perofrm to produce offspring usign mating operation
 				int s = i * parentPerCrossover;
 				for( int j = 0; j < parentPerCrossover; j++ )
@@ -65,9 +78,8 @@ namespace Population
 				// produce offspring
 				configuration.Mate( crossoverBuffer );
 
-				// store offspring to result set
-				while( GaChromosomeStorage* child = offspring.PopLast( true ) )
-					output.AddAtomic( child );
+				// store offspring to result set at positions reserved for the mating
+				crossoverBuffer.CollectOffspring( output, i * offspringCount );
 
 				// update operation counters
 				counters.CollectCrossoverBufferCounters( crossoverBuffer );
@@ -75,6 +87,13 @@ namespace Population
 				crossoverBuffer.Clear();
 			}
 
+			// evaluate offspring whose evaluation is deferred
+			crossoverBuffer.FlushOffspring();
+
+			// remove positions of offspring that matings have not produced
+			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
+				output.Compact();
+
 			// update population statistics with new state of counters
 			counters.UpdateStatistics();
 		}
@@ -109,7 +128,11 @@ namespace Population
 			Common::Workflows::GaBranch* branch) const
 		{
 			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
+			{
+				// shuffle should not depend on the branch which performs it
+				branch->SelectSharedRandomSubstream();
 				input.Shuffle( true );
+			}
 
 			struct ToIndex { inline int GACALL operator ()(int index, int size) const { return index < size ? index : GaGlobalRandomIntegerGenerator->Generate( size - 1 ); } };
 			GaCouplingFlow( ToIndex(), input, output, parameters, configuration, branch );
@@ -13,6 +13,7 @@
 #ifndef __GA_FITNESS_H__
 #define __GA_FITNESS_H__
 
+#include <vector>
 #include "Operation.h"
 #include "Catalogue.h"
 #include "Statistics.h"
@@ -118,6 +119,19 @@ namespace Fitness
 		/// <returns>Operator returns reference to <c>this</c> object.</returns>
 		virtual GaFitness& GACALL operator =(const GaFitness& rhs) { _parameters = rhs._parameters; return *this; }
 
+		/// <summary><c>Serialize</c> method appends fitness value to the buffer, so it can be transfered to another process.
+		/// Fitness parameters are not serialized.</summary>
+		/// <param name="buffer">buffer to which the value is appended.</param>
+		/// <returns>Default implementation returns <c>false</c> which indicates that fitness object does not support serialization.</returns>
+		virtual bool GACALL Serialize(std::vector<char>& buffer) const { return false; }
+
+		/// <summary><c>Deserialize</c> method restores fitness value from data produced by <see cref="Serialize" /> method.</summary>
+		/// <param name="data">pointer to serialized value.</param>
+		/// <param name="size">size of serialized value in bytes.</param>
+		/// <returns>Method returns <c>true</c> if the value is restored. Default implementation returns <c>false</c>.</returns>
+		virtual bool GACALL Deserialize(const char* data,
+			int size) { return false; }
+
 		/// <summary>This operator tests two fitness object for equality.</summary>
 		/// <param name="rhs">reference to fitness object which is compared to this object.</param>
 		/// <returns>Operator returns <c>true</c> if the two fitness objects are equal.</returns>
@@ -160,6 +174,33 @@ namespace Fitness
 			const GaFitness& fitness2,
 			const GaFitnessComparatorParams& parameters) const = 0;
 
+		/// <summary><c>GetSortKey</c> method extracts key from fitness value, so sorting algorithms can compare keys instead of calling comparator.
+		/// Key of the better fitness value must be lower. Comparators that can represent fitness values with a single key should override this method.
+		///
+		/// This method is thread-safe.</summary>
+		/// <param name="fitness">reference to fitness value whose key should be extracted.</param>
+		/// <param name="parameters">reference to parameters of fitness comparison operation.</param>
+		/// <param name="key">reference to variable that will store extracted key.</param>
+		/// <returns>Default implementation returns <c>false</c> which indicates that comparator does not support key extraction.</returns>
+		virtual bool GACALL GetSortKey(const GaFitness& fitness,
+			const GaFitnessComparatorParams& parameters,
+			double& key) const { return false; }
+
+		/// <summary><c>GetObjectiveKeys</c> method extracts one key for each objective from fitness value, so multiobjective algorithms can determine
+		/// pareto dominance by comparing packed keys instead of calling comparator. Key of the better objective value must be lower.
+		/// Only comparators that implement pareto dominance should override this method.
+		///
+		/// This method is thread-safe.</summary>
+		/// <param name="fitness">reference to fitness value whose keys should be extracted.</param>
+		/// <param name="parameters">reference to parameters of fitness comparison operation.</param>
+		/// <param name="keys">pointer to array that will store extracted keys.</param>
+		/// <param name="count">number of objectives.</param>
+		/// <returns>Default implementation returns <c>false</c> which indicates that comparator does not support key extraction.</returns>
+		virtual bool GACALL GetObjectiveKeys(const GaFitness& fitness,
+			const GaFitnessComparatorParams& parameters,
+			double* keys,
+			int count) const { return false; }
+
 		/// <summary>More details are given in specification of <see cref="GaOperation::CreateConfiguration" /> method.
 		///
 		/// This method is thread-safe.</summary>
@@ -261,6 +302,9 @@ namespace Fitness
 		/// <summary>Type of object whose fitness value should be calculated.</summary>
 		typedef OBJECT_TYPE GaObjectType;
 
+		/// <summary>Maximal number of objects that can be evaluated by single call to <see cref="EvaluateBatch" /> method.</summary>
+		static const int MAX_BATCH_SIZE = 64;
+
 		/// <summary>This operator calculates fitness value of the chromosome.</summary>
 		/// <param name="object">reference to object whose fitness is calculated.</param>
 		/// <param name="fitness">reference to fitness object to which teh evaluated fitness value is stored.</param>
@@ -269,6 +313,26 @@ namespace Fitness
 			GaFitness& fitness,
 			const GaFitnessOperationParams& operationParams) const = 0;
 
+		/// <summary><c>EvaluateBatch</c> method calculates fitness values of multiple objects. Operations that can evaluate several objects at once
+		/// (i.e. by gathering their codes into contiguous buffers and processing them with vector instructions) should override this method
+		/// along with <see cref="GetBatchSize" /> method. Default implementation evaluates objects one by one.</summary>
+		/// <param name="objects">array of pointers to objects whose fitness values are calculated.</param>
+		/// <param name="fitness">array of pointers to fitness objects to which the evaluated fitness values are stored.</param>
+		/// <param name="count">number of objects in the batch. It is never greater then <c>MAX_BATCH_SIZE</c>.</param>
+		/// <param name="operationParams">reference to parameters of fitness operation.</param>
+		virtual void GACALL EvaluateBatch(const GaObjectType* const* objects,
+			GaFitness* const* fitness,
+			int count,
+			const GaFitnessOperationParams& operationParams) const
+		{
+			for( int i = 0; i < count; i++ )
+				( *this )( *objects[ i ], *fitness[ i ], operationParams );
+		}
+
+		/// <summary><c>GetBatchSize</c> method returns preferred number of objects that should be evaluated by single call to <see cref="EvaluateBatch" /> method.</summary>
+		/// <returns>Default implementation returns 1 which indicates that operation does not benefit from batch evaluation.</returns>
+		virtual int GACALL GetBatchSize() const { return 1; }
+
 		/// <summary>More details are given in specification of <see cref="GaOperation::CreateConfiguration" /> method.
 		///
 		/// This method is thread-safe.</summary>
@@ -26,6 +26,19 @@ namespace Fitness
 			return ( (const GaSimpleComparatorParams&)parameters ).GetType() * ( (Representation::GaSVFitnessBase&)fitness1 ).CompareValues( (Representation::GaSVFitnessBase&)fitness2 );
 		}
 
+		bool GaSimpleComparator::GetSortKey(const GaFitness& fitness,
+			const GaFitnessComparatorParams& parameters,
+			double& key) const
+		{
+			double value;
+			if( !( (const Representation::GaSVFitnessBase&)fitness ).GetValue( value ) )
+				return false;
+
+			// greater value is better when maximizing, so it should have lower key
+			key = -( (const GaSimpleComparatorParams&)parameters ).GetType() * value;
+			return true;
+		}
+
 		int GaPositionalComparator::operator ()(const GaFitness& fitness1,
 			const GaFitness& fitness2,
 			const GaFitnessComparatorParams& parameters) const
@@ -72,6 +85,27 @@ namespace Fitness
 			return result;
 		}
 
+		// Extracts keys of all objectives
+		bool GaDominanceComparator::GetObjectiveKeys(const GaFitness& fitness,
+			const GaFitnessComparatorParams& parameters,
+			double* keys,
+			int count) const
+		{
+			const Representation::GaMVFitnessBase& f = (const Representation::GaMVFitnessBase&)fitness;
+			int type = ( (const GaSimpleComparatorParams&)parameters ).GetType();
+
+			for( int i = count - 1; i >= 0; i-- )
+			{
+				if( !f.GetValue( i, keys[ i ] ) )
+					return false;
+
+				// greater value is better when maximizing, so it should have lower key
+				keys[ i ] *= -type;
+			}
+
+			return true;
+		}
+
 		// Comparator that compare only a single value 
 		int GaVegaComparator::operator ()(const GaFitness& fitness1,
 			const GaFitness& fitness2,
@@ -87,6 +87,14 @@ namespace Fitness
 				const GaFitness& fitness2,
 				const GaFitnessComparatorParams& parameters) const;
 
+			/// <summary>More details are given in specification of <see cref="GaFitnessComparator::GetSortKey" /> method.
+			///
+			/// This method is thread-safe.</summary>
+			GAL_API
+			virtual bool GACALL GetSortKey(const GaFitness& fitness,
+				const GaFitnessComparatorParams& parameters,
+				double& key) const;
+
 			/// <summary>More details are given in specification of <see cref="GaOperation::CreateParameters" /> method.
 			///
 			/// This method is thread-safe.</summary>
@@ -137,6 +145,15 @@ namespace Fitness
 				const GaFitness& fitness2,
 				const GaFitnessComparatorParams& parameters) const;
 
+			/// <summary>More details are given in specification of <see cref="GaFitnessComparator::GetObjectiveKeys" /> method.
+			///
+			/// This method is thread-safe.</summary>
+			GAL_API
+			virtual bool GACALL GetObjectiveKeys(const GaFitness& fitness,
+				const GaFitnessComparatorParams& parameters,
+				double* keys,
+				int count) const;
+
 			/// <summary>More details are given in specification of <see cref="GaOperation::CreateParameters" /> method.
 			///
 			/// This method is thread-safe.</summary>
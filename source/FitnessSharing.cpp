@@ -261,6 +261,7 @@ namespace Population
 
 				// recalculate partial fitness sharing for all chromosomes in population
 				Common::Workflows::GaParallelExec2<GaPopulation, GaChromosomeStorage> shareWorkDist( *branch, population );
+				shareWorkDist.SetScheduling( Common::Workflows::GAPS_DYNAMIC );
 				shareWorkDist.Execute( GaFitnessSharingOp( getPartialSum, comparator, cutoff, alpha, branchID ), false );
 
 				// mark population that all chromosomes are updated
@@ -288,6 +289,9 @@ namespace Population
 			Common::Workflows::GaParallelExec1<GaPopulation, GaChromosomeStorage> workDist( *branch, population );
 			workDist.Execute( GaSumFitnessSharingOp<GaStoreOp>( getPartialSum, GaStoreOp() ), false );
 
+			// scaled fitness values of all chromosomes are changed
+			population.MarkModified();
+
 			// update operation time statistics
 			timer.UpdateStatistics();
 		}
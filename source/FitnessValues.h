@@ -14,6 +14,8 @@
 #define __GA_FITNESS_VALUES_H__
 
 //#include <math.h>
+#include <algorithm>
+#include <limits>
 #include "Array.h"
 #include "Fitness.h"
 
@@ -24,6 +26,18 @@ namespace Fitness
 	namespace Representation
 	{
 
+		/// <summary><c>GaExactDoubleConversion</c> template checks whether all values of specified type can be converted to <c>double</c> without rounding.
+		/// Integer types that are wider than mantissa of <c>double</c> (such as <c>long long</c>) and extended floating point types do not satisfy this condition.</summary>
+		/// <typeparam name="VALUE_TYPE">type of values that are converted.</typeparam>
+		template<typename VALUE_TYPE>
+		struct GaExactDoubleConversion
+		{
+
+			/// <summary><c>true</c> if conversion of the values to <c>double</c> is exact.</summary>
+			static const bool VALUE = std::numeric_limits<VALUE_TYPE>::is_specialized && std::numeric_limits<VALUE_TYPE>::digits <= std::numeric_limits<double>::digits;
+
+		};
+
 		/// <summary><c>GaSVFitnessBase</c> is base class for fitness objects that contain only one value.</summary>
 		class GaSVFitnessBase : public GaFitness
 		{
@@ -42,6 +56,11 @@ namespace Fitness
 			/// <br/>c.  1 if the value of first fitness object is worse.</returns>
 			virtual int GACALL CompareValues(const GaSVFitnessBase& fitness) const = 0;
 
+			/// <summary><c>GetValue</c> method converts value stored in fitness object to <c>double</c>.</summary>
+			/// <param name="value">reference to variable that will store converted value.</param>
+			/// <returns>Default implementation returns <c>false</c> which indicates that the value cannot be converted without losing precision.</returns>
+			virtual bool GACALL GetValue(double& value) const { return false; }
+
 		};
 
 		/// <summary><c>GaSVFitness</c> template class represent fitness objecst which contain only one value.
@@ -117,6 +136,20 @@ namespace Fitness
 				return _value > value ? -1 : ( value > _value ? 1 : 0 );
 			}
 
+			/// <summary>More details are given in specification of <see cref="GaSVFitnessBase::GetValue" /> method.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <returns>Method returns <c>false</c> if the type of value cannot be converted to <c>double</c> exactly,
+			/// so distinct values that would be rounded to the same <c>double</c> are still compared by the fitness comparator.</returns>
+			virtual bool GACALL GetValue(double& value) const
+			{
+				if( !GaExactDoubleConversion<GaValueType>::VALUE )
+					return false;
+
+				value = (double)_value;
+				return true;
+			}
+
 			/// <summary>More details are given in specification of <see cref="GaFitness::operator +" /> method.
 			///
 			/// This method is not thread-safe.</summary>
@@ -159,6 +192,28 @@ namespace Fitness
 				return GaFitness::operator=( rhs );
 			}
 
+			/// <summary>More details are given in specification of <see cref="GaFitness::Serialize" /> method.
+			///
+			/// This method is not thread-safe.</summary>
+			virtual bool GACALL Serialize(std::vector<char>& buffer) const
+			{
+				buffer.insert( buffer.end(), (const char*)&_value, (const char*)&_value + sizeof( GaValueType ) );
+				return true;
+			}
+
+			/// <summary>More details are given in specification of <see cref="GaFitness::Deserialize" /> method.
+			///
+			/// This method is not thread-safe.</summary>
+			virtual bool GACALL Deserialize(const char* data,
+				int size)
+			{
+				if( size != sizeof( GaValueType ) )
+					return false;
+
+				std::copy( data, data + size, (char*)&_value );
+				return true;
+			}
+
 			/// <summary>More details are given in specification of <see cref="GaFitness::operator ==" /> method.
 			///
 			/// This method is not thread-safe.</summary>
@@ -215,6 +270,13 @@ namespace Fitness
 			/// <returns>Method returns array of values stored in fitness object.</returns>
 			virtual const Common::Data::GaArrayBase& GACALL GetValues() const = 0;
 
+			/// <summary><c>GetValue</c> method converts value at specified index stored in fitness object to <c>double</c>.</summary>
+			/// <param name="index">index of the value.</param>
+			/// <param name="value">reference to variable that will store converted value.</param>
+			/// <returns>Default implementation returns <c>false</c> which indicates that the value cannot be converted without losing precision.</returns>
+			virtual bool GACALL GetValue(int index,
+				double& value) const { return false; }
+
 		};
 
 		/// <summary><c>GaMVFitnessParams</c> class represents parameters for fitness objects that contain multiple values.
@@ -399,6 +461,20 @@ namespace Fitness
 			virtual float GACALL Distance(const GaMVFitnessBase& fitness,
 				int index) const { return (float)( _values[ index ] - ( (const GaMVFitness<GaValueType>&)fitness )._values[ index ] ); }
 
+			/// <summary>More details are given in specification of <see cref="GaMVFitnessBase::GetValue" /> method.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <returns>Method returns <c>false</c> if the type of values cannot be converted to <c>double</c> exactly.</returns>
+			virtual bool GACALL GetValue(int index,
+				double& value) const
+			{
+				if( !GaExactDoubleConversion<GaValueType>::VALUE )
+					return false;
+
+				value = (double)_values[ index ];
+				return true;
+			}
+
 			/// <summary></summary>
 			virtual Common::Data::GaArrayBase& GACALL GetValues() { return _values; }
 
@@ -487,6 +563,29 @@ namespace Fitness
 				return GaFitness::operator=( rhs );
 			}
 
+			/// <summary>More details are given in specification of <see cref="GaFitness::Serialize" /> method.
+			///
+			/// This method is not thread-safe.</summary>
+			virtual bool GACALL Serialize(std::vector<char>& buffer) const
+			{
+				const char* data = (const char*)_values.GetArray();
+				buffer.insert( buffer.end(), data, data + _values.GetSize() * sizeof( GaValueType ) );
+				return true;
+			}
+
+			/// <summary>More details are given in specification of <see cref="GaFitness::Deserialize" /> method.
+			///
+			/// This method is not thread-safe.</summary>
+			virtual bool GACALL Deserialize(const char* data,
+				int size)
+			{
+				if( size != _values.GetSize() * (int)sizeof( GaValueType ) )
+					return false;
+
+				std::copy( data, data + size, (char*)_values.GetArray() );
+				return true;
+			}
+
 			/// <summary>More details are given in specification of <see cref="GaFitness::operator ==" /> method.
 			///
 			/// This method is not thread-safe.</summary>
@@ -754,6 +853,24 @@ namespace Fitness
 				return GaFitness::operator=( rhs );
 			}
 
+			/// <summary>More details are given in specification of <see cref="GaFitness::Serialize" /> method.
+			///
+			/// This method is not thread-safe.</summary>
+			virtual bool GACALL Serialize(std::vector<char>& buffer) const { return _values.Serialize( buffer ); }
+
+			/// <summary>More details are given in specification of <see cref="GaFitness::Deserialize" /> method.
+			///
+			/// This method is not thread-safe.</summary>
+			virtual bool GACALL Deserialize(const char* data,
+				int size)
+			{
+				if( !_values.Deserialize( data, size ) )
+					return false;
+
+				CalculateWeightedSum();
+				return true;
+			}
+
 			/// <summary>More details are given in specification of <see cref="GaFitness::operator ==" /> method.
 			///
 			/// This method is not thread-safe.</summary>
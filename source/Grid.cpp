@@ -62,6 +62,262 @@ namespace Common
 			_buffer.SetSize( size );
 		}
 
+		// Sets number of items and coordinates
+		void GaSparseHyperGrid::SetSize(int size,
+			int dimensions)
+		{
+			GA_ARG_ASSERT( Exceptions::GaArgumentOutOfRangeException, size >= 0, "size", "Size of the grid cannot be negative.", "Grid" );
+			GA_ARG_ASSERT( Exceptions::GaArgumentOutOfRangeException, dimensions > 0, "dimensions", "Number of coordinates must be positive.", "Grid" );
+
+			_dimensions = dimensions;
+
+			// divide key among coordinates
+			_keyBits = 64 / dimensions;
+			if( _keyBits > 32 )
+				_keyBits = 32;
+			else if( _keyBits < 1 )
+				_keyBits = 1;
+
+			if( _itemCells.GetSize() != size )
+			{
+				_cells.SetSize( size );
+				_freeCells.SetSize( size );
+				_itemCells.SetSize( size );
+				_itemNext.SetSize( size );
+				_itemPrevious.SetSize( size );
+				_crowding.SetSize( size + 1 );
+
+				// table is kept at most half full
+				for( _tableBits = 1; ( 1 << _tableBits ) < 2 * size; _tableBits++ )
+					;
+				_table.SetSize( 1 << _tableBits );
+
+				for( int i = _table.GetSize() - 1; i >= 0; i-- )
+					_table[ i ] = -1;
+
+				for( int i = size; i >= 0; i-- )
+					_crowding[ i ] = -1;
+
+				for( int i = size - 1; i >= 0; i-- )
+					_itemCells[ i ] = -1;
+
+				_cellCount = _freeCellCount = _itemCount = _maxCount = 0;
+			}
+			else
+				Clear();
+
+			if( _coordinates.GetSize() != size * dimensions )
+				_coordinates.SetSize( size * dimensions );
+		}
+
+		// Removes all items and hyperboxes
+		void GaSparseHyperGrid::Clear()
+		{
+			for( int i = _cellCount - 1; i >= 0; i-- )
+			{
+				GaCell& cell = _cells[ i ];
+
+				// entries of released hyperboxes do not reference the table
+				if( !cell._count )
+					continue;
+
+				// release slot of the table and items of the hyperbox
+				_table[ cell._slot ] = -1;
+				for( int item = cell._first; item >= 0; item = _itemNext[ item ] )
+					_itemCells[ item ] = -1;
+			}
+
+			for( int i = _maxCount; i > 0; i-- )
+				_crowding[ i ] = -1;
+
+			_cellCount = _freeCellCount = _itemCount = _maxCount = 0;
+		}
+
+		// Places item into hyperbox
+		int GaSparseHyperGrid::Insert(int item,
+			const GaHyperBox& hyperBox)
+		{
+			GA_ARG_ASSERT( Exceptions::GaArgumentOutOfRangeException, item >= 0 && item < _itemCells.GetSize() && _itemCells[ item ] < 0,
+				"item", "Item is out of range or it is already in the grid.", "Grid" );
+			GA_ARG_ASSERT( Exceptions::GaArgumentOutOfRangeException, hyperBox.GetSize() == _dimensions, "hyperBox", "Number of coordinates does not match the grid.", "Grid" );
+
+			const int* coordinates = hyperBox.GetArray();
+			unsigned long long key = GetKey( coordinates );
+			int slot = FindSlot( key, coordinates );
+
+			int index = _table[ slot ];
+			if( index < 0 )
+			{
+				// hyperbox is not in the table - add it using entry of released hyperbox if there is one
+				index = _freeCellCount > 0 ? _freeCells[ --_freeCellCount ] : _cellCount++;
+				_table[ slot ] = index;
+
+				GaCell& cell = _cells[ index ];
+				cell._key = key;
+				cell._slot = slot;
+				cell._count = 0;
+				cell._first = -1;
+
+				int* destination = _coordinates.GetArray() + index * _dimensions;
+				for( int i = _dimensions - 1; i >= 0; i-- )
+					destination[ i ] = coordinates[ i ];
+			}
+
+			GaCell& cell = _cells[ index ];
+
+			// add item to the list of the hyperbox
+			_itemCells[ item ] = index;
+			_itemPrevious[ item ] = -1;
+			_itemNext[ item ] = cell._first;
+			if( cell._first >= 0 )
+				_itemPrevious[ cell._first ] = item;
+			cell._first = item;
+
+			// move hyperbox to the list of higher occupancy
+			if( cell._count > 0 )
+				Unlink( index );
+			cell._count++;
+			Link( index );
+
+			if( cell._count > _maxCount )
+				_maxCount = cell._count;
+
+			_itemCount++;
+			return index;
+		}
+
+		// Removes item from its hyperbox
+		void GaSparseHyperGrid::Remove(int item)
+		{
+			GA_ARG_ASSERT( Exceptions::GaArgumentOutOfRangeException, item >= 0 && item < _itemCells.GetSize() && _itemCells[ item ] >= 0,
+				"item", "Item is out of range or it is not in the grid.", "Grid" );
+
+			int index = _itemCells[ item ];
+			GaCell& cell = _cells[ index ];
+
+			// remove item from the list of the hyperbox
+			int previous = _itemPrevious[ item ], next = _itemNext[ item ];
+			if( previous >= 0 )
+				_itemNext[ previous ] = next;
+			else
+				cell._first = next;
+			if( next >= 0 )
+				_itemPrevious[ next ] = previous;
+
+			_itemCells[ item ] = -1;
+
+			// move hyperbox to the list of lower occupancy or release it if it is empty
+			Unlink( index );
+			if( --cell._count > 0 )
+				Link( index );
+			else
+				Release( index );
+
+			// occupancy of the most crowded hyperbox can drop only by one
+			if( _crowding[ _maxCount ] < 0 )
+				_maxCount--;
+
+			_itemCount--;
+		}
+
+		// Locates hyperbox in the table
+		int GaSparseHyperGrid::Find(const GaHyperBox& hyperBox) const
+		{
+			if( hyperBox.GetSize() != _dimensions || !_table.GetSize() )
+				return -1;
+
+			const int* coordinates = hyperBox.GetArray();
+			return _table[ FindSlot( GetKey( coordinates ), coordinates ) ];
+		}
+
+		// Queries item of the hyperbox by its position
+		int GaSparseHyperGrid::GetItem(int cell,
+			int index) const
+		{
+			int item = _cells[ cell ]._first;
+			for( ; index > 0 && item >= 0; index-- )
+				item = _itemNext[ item ];
+
+			return item;
+		}
+
+		// Searches hash table for the hyperbox
+		int GaSparseHyperGrid::FindSlot(unsigned long long key,
+			const int* coordinates) const
+		{
+			int mask = _table.GetSize() - 1;
+			for( int slot = GetSlot( key ); ; slot = ( slot + 1 ) & mask )
+			{
+				int index = _table[ slot ];
+				if( index < 0 )
+					return slot;
+
+				if( _cells[ index ]._key == key )
+				{
+					// hyperboxes that share the key must have same coordinates
+					const int* stored = _coordinates.GetArray() + index * _dimensions;
+					int i = _dimensions - 1;
+					while( i >= 0 && stored[ i ] == coordinates[ i ] )
+						i--;
+
+					if( i < 0 )
+						return slot;
+				}
+			}
+		}
+
+		// Removes empty hyperbox from the table
+		void GaSparseHyperGrid::Release(int cell)
+		{
+			int mask = _table.GetSize() - 1;
+			int hole = _cells[ cell ]._slot;
+
+			// shift following hyperboxes of the probe sequence to fill the released slot
+			for( int slot = ( hole + 1 ) & mask; _table[ slot ] >= 0; slot = ( slot + 1 ) & mask )
+			{
+				int moved = _table[ slot ];
+				int home = GetSlot( _cells[ moved ]._key );
+
+				// hyperbox can be moved only if the hole is between its home slot and its current slot
+				if( ( ( slot - home ) & mask ) >= ( ( slot - hole ) & mask ) )
+				{
+					_table[ hole ] = moved;
+					_cells[ moved ]._slot = hole;
+					hole = slot;
+				}
+			}
+
+			_table[ hole ] = -1;
+			_freeCells[ _freeCellCount++ ] = cell;
+		}
+
+		// Inserts hyperbox into the list of its occupancy
+		void GaSparseHyperGrid::Link(int cell)
+		{
+			GaCell& c = _cells[ cell ];
+			int& head = _crowding[ c._count ];
+
+			c._previous = -1;
+			c._next = head;
+			if( head >= 0 )
+				_cells[ head ]._previous = cell;
+			head = cell;
+		}
+
+		// Removes hyperbox from the list of its occupancy
+		void GaSparseHyperGrid::Unlink(int cell)
+		{
+			GaCell& c = _cells[ cell ];
+
+			if( c._previous >= 0 )
+				_cells[ c._previous ]._next = c._next;
+			else
+				_crowding[ c._count ] = c._next;
+
+			if( c._next >= 0 )
+				_cells[ c._next ]._previous = c._previous;
+		}
+
 		// Restart iterator to the first hyperbox that should be visited
 		void GaHyperBoxNeighbour::Begin(const Common::Grid::GaHyperBox& center,
 			const int* limits,
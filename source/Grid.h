@@ -351,6 +351,254 @@ namespace Common
 
 		};
 
+		/// <summary><c>GaSparseHyperGrid</c> class stores occupancy of hypergrid in hash table that contains only hyperboxes which have items.
+		/// Coordinates of hyperbox are packed into integer key which is used to locate hyperbox in the table, so memory and time required
+		/// do not depend on number of hyperboxes in the grid. Number of items in each hyperbox is updated incrementally when items are inserted
+		/// or removed and occupied hyperboxes are kept in lists by their occupancy, so the most crowded hyperbox can be found in constant time.
+		/// Hyperboxes are released as soon as they become empty, so the grid can be updated incrementally for as long as it is used.
+		///
+		/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
+		/// No public or private methods are thread-safe.</summary>
+		class GaSparseHyperGrid
+		{
+
+		private:
+
+			/// <summary><c>GaCell</c> struct stores information about single hyperbox in the table.</summary>
+			struct GaCell
+			{
+
+				/// <summary>Packed coordinates of the hyperbox.</summary>
+				unsigned long long _key;
+
+				/// <summary>Slot of the hash table that references the hyperbox.</summary>
+				int _slot;
+
+				/// <summary>Number of items currently in the hyperbox.</summary>
+				int _count;
+
+				/// <summary>The first item in the list of items that belong to the hyperbox.</summary>
+				int _first;
+
+				/// <summary>Previous hyperbox in the list of hyperboxes with same occupancy.</summary>
+				int _previous;
+
+				/// <summary>Next hyperbox in the list of hyperboxes with same occupancy.</summary>
+				int _next;
+
+			};
+
+			/// <summary>Number of coordinates that hyperboxes have.</summary>
+			int _dimensions;
+
+			/// <summary>Number of bits of the key dedicated to each coordinate.</summary>
+			int _keyBits;
+
+			/// <summary>Occupied hyperboxes.</summary>
+			Data::GaSingleDimensionArray<GaCell> _cells;
+
+			/// <summary>Number of hyperbox entries that have been used since the grid was cleared.</summary>
+			int _cellCount;
+
+			/// <summary>Entries of released hyperboxes that can be reused.</summary>
+			Data::GaSingleDimensionArray<int> _freeCells;
+
+			/// <summary>Number of entries of released hyperboxes.</summary>
+			int _freeCellCount;
+
+			/// <summary>Coordinates of occupied hyperboxes stored row by row.</summary>
+			Data::GaSingleDimensionArray<int> _coordinates;
+
+			/// <summary>Hash table that maps packed coordinates to hyperboxes using linear probing. Empty slots are marked with -1.</summary>
+			Data::GaSingleDimensionArray<int> _table;
+
+			/// <summary>Number of bits used to address slots of the hash table.</summary>
+			int _tableBits;
+
+			/// <summary>Hyperbox to which each item belongs or -1 if the item is not in the grid.</summary>
+			Data::GaSingleDimensionArray<int> _itemCells;
+
+			/// <summary>Next item that belong to same hyperbox.</summary>
+			Data::GaSingleDimensionArray<int> _itemNext;
+
+			/// <summary>Previous item that belong to same hyperbox.</summary>
+			Data::GaSingleDimensionArray<int> _itemPrevious;
+
+			/// <summary>The first hyperbox in the list of hyperboxes for each occupancy.</summary>
+			Data::GaSingleDimensionArray<int> _crowding;
+
+			/// <summary>Occupancy of the most crowded hyperbox.</summary>
+			int _maxCount;
+
+			/// <summary>Number of items in the grid.</summary>
+			int _itemCount;
+
+		public:
+
+			/// <summary>This constructor initializes empty grid.</summary>
+			GaSparseHyperGrid() : _dimensions(0),
+				_keyBits(0),
+				_cellCount(0),
+				_freeCellCount(0),
+				_tableBits(0),
+				_maxCount(0),
+				_itemCount(0) { }
+
+			/// <summary><c>SetSize</c> method sets number of items that grid can store and number of coordinates that hyperboxes have.
+			/// All items are removed from the grid.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="size">number of items that grid can store.</param>
+			/// <param name="dimensions">number of coordinates that hyperboxes have.</param>
+			/// <exception cref="GaArgumentOutOfRangeException" />Thrown if size is negative or number of coordinates is not positive.</exception>
+			GAL_API
+			void GACALL SetSize(int size,
+				int dimensions);
+
+			/// <summary><c>Clear</c> method removes all items and hyperboxes from the grid.
+			///
+			/// This method is not thread-safe.</summary>
+			GAL_API
+			void GACALL Clear();
+
+			/// <summary><c>Insert</c> method places item into specified hyperbox and updates occupancy of the hyperbox.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="item">index of the item.</param>
+			/// <param name="hyperBox">coordinates of hyperbox to which the item belongs.</param>
+			/// <returns>Method returns index of hyperbox in which the item is placed.</returns>
+			/// <exception cref="GaArgumentOutOfRangeException" />Thrown if index of the item is out of range, the item is already in the grid or
+			/// number of coordinates does not match the grid.</exception>
+			GAL_API
+			int GACALL Insert(int item,
+				const GaHyperBox& hyperBox);
+
+			/// <summary><c>Remove</c> method removes item from its hyperbox and updates occupancy of the hyperbox. Hyperbox is released if it becomes empty.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="item">index of the item.</param>
+			/// <exception cref="GaArgumentOutOfRangeException" />Thrown if index of the item is out of range or the item is not in the grid.</exception>
+			GAL_API
+			void GACALL Remove(int item);
+
+			/// <summary><c>Find</c> method locates hyperbox in the table.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="hyperBox">coordinates of the hyperbox.</param>
+			/// <returns>Method returns index of the hyperbox or -1 if the hyperbox is empty.</returns>
+			GAL_API
+			int GACALL Find(const GaHyperBox& hyperBox) const;
+
+			/// <summary><c>GetItem</c> method queries item of the hyperbox by its position in the list of hyperbox's items.
+			/// Time required by this method is proportional to the position of the item.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="cell">index of the hyperbox.</param>
+			/// <param name="index">position of the item in the list.</param>
+			/// <returns>Method returns index of queried item.</returns>
+			GAL_API
+			int GACALL GetItem(int cell,
+				int index) const;
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <param name="hyperBox">coordinates of the hyperbox.</param>
+			/// <returns>Method returns number of items currently in the hyperbox.</returns>
+			inline int GACALL GetOccupancy(const GaHyperBox& hyperBox) const
+			{
+				int cell = Find( hyperBox );
+				return cell >= 0 ? _cells[ cell ]._count : 0;
+			}
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns index of the most crowded hyperbox or -1 if the grid is empty.</returns>
+			inline int GACALL GetMostCrowded() const { return _maxCount > 0 ? _crowding[ _maxCount ] : -1; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns number of items in the most crowded hyperbox.</returns>
+			inline int GACALL GetMaxCount() const { return _maxCount; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <param name="cell">index of the hyperbox.</param>
+			/// <returns>Method returns number of items currently in the hyperbox.</returns>
+			inline int GACALL GetCount(int cell) const { return _cells[ cell ]._count; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <param name="cell">index of the hyperbox.</param>
+			/// <returns>Method returns the first item of the hyperbox or -1 if the hyperbox is empty.</returns>
+			inline int GACALL GetFirstItem(int cell) const { return _cells[ cell ]._first; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <param name="item">index of the item.</param>
+			/// <returns>Method returns next item that belongs to same hyperbox or -1 if this is the last item of the hyperbox.</returns>
+			inline int GACALL GetNextItem(int item) const { return _itemNext[ item ]; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <param name="item">index of the item.</param>
+			/// <returns>Method returns index of hyperbox to which the item belongs or -1 if the item is not in the grid.</returns>
+			inline int GACALL GetItemCell(int item) const { return _itemCells[ item ]; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <param name="cell">index of the hyperbox.</param>
+			/// <returns>Method returns pointer to coordinates of the hyperbox.</returns>
+			inline const int* GACALL GetCoordinates(int cell) const { return _coordinates.GetArray() + cell * _dimensions; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns number of occupied hyperboxes.</returns>
+			inline int GACALL GetCellCount() const { return _cellCount - _freeCellCount; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns number of items currently in the grid.</returns>
+			inline int GACALL GetItemCount() const { return _itemCount; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns number of items that grid can store.</returns>
+			inline int GACALL GetSize() const { return _itemCells.GetSize(); }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns number of coordinates that hyperboxes have.</returns>
+			inline int GACALL GetDimensionCount() const { return _dimensions; }
+
+		private:
+
+			/// <summary><c>GetKey</c> method packs coordinates of hyperbox into integer key. Each coordinate occupies its own bits of the key
+			/// as long as it fits them, otherwise coordinates are folded into the key and hyperboxes that share the key are distinguished by their coordinates.</summary>
+			/// <param name="coordinates">coordinates of the hyperbox.</param>
+			/// <returns>Method returns packed coordinates.</returns>
+			inline unsigned long long GACALL GetKey(const int* coordinates) const
+			{
+				unsigned long long key = 0;
+				for( int i = 0; i < _dimensions; i++ )
+					key = ( ( key << _keyBits ) | ( key >> ( 64 - _keyBits ) ) ) ^ (unsigned int)coordinates[ i ];
+
+				return key;
+			}
+
+			/// <summary><c>GetSlot</c> method calculates slot of the hash table at which the search for the key starts.</summary>
+			/// <param name="key">packed coordinates of hyperbox.</param>
+			/// <returns>Method returns slot of the hash table.</returns>
+			inline int GACALL GetSlot(unsigned long long key) const { return (int)( ( key * 0x9e3779b97f4a7c15ULL ) >> ( 64 - _tableBits ) ); }
+
+			/// <summary><c>FindSlot</c> method searches hash table for the hyperbox.</summary>
+			/// <param name="key">packed coordinates of the hyperbox.</param>
+			/// <param name="coordinates">coordinates of the hyperbox.</param>
+			/// <returns>Method returns slot that references the hyperbox or empty slot at which the hyperbox should be stored.</returns>
+			int GACALL FindSlot(unsigned long long key,
+				const int* coordinates) const;
+
+			/// <summary><c>Release</c> method removes empty hyperbox from hash table and makes its entry available for reuse.</summary>
+			/// <param name="cell">index of the hyperbox.</param>
+			void GACALL Release(int cell);
+
+			/// <summary><c>Link</c> method inserts hyperbox into the list of hyperboxes that have same occupancy.</summary>
+			/// <param name="cell">index of the hyperbox.</param>
+			void GACALL Link(int cell);
+
+			/// <summary><c>Unlink</c> method removes hyperbox from the list of hyperboxes that have same occupancy.</summary>
+			/// <param name="cell">index of the hyperbox.</param>
+			void GACALL Unlink(int cell);
+
+		};
+
 		/// <summary><c>GaHyperGridBounds</c> class stores and manages bounds of hypergid as points in hyperspace.
 		///
 		/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
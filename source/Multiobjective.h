@@ -88,6 +88,9 @@ namespace Multiobjective
 		/// <summary>ID of the brach that executes operation.</summary>
 		int _branchID;
 
+		/// <summary>Packed matrix of objective values or <c>NULL</c> if fitness comparator should be used.</summary>
+		const Population::GaObjectiveMatrix* _matrix;
+
 	public:
 
 		/// <summary>Initalizes operation.</summary>
@@ -95,13 +98,16 @@ namespace Multiobjective
 		/// <param name="domCount">chromosome tag that contains partial count of dominant chromosome.</param>
 		/// <param name="domList">chromosome tag that contains partial list of dominated chromosome.</param>
 		/// <param name="branchID">ID of the brach that executes operation.</param>
+		/// <param name="matrix">packed matrix of objective values. If this parameter is <c>NULL</c>, fitness comparator is used.</param>
 		GaDominanceOp(Population::GaPopulation& population,
 			const Population::GaChromosomeTagGetter<Common::Threading::GaAtomic<int> >& domCount,
 			const Population::GaChromosomeTagGetter<GaDominanceList>& domList,
-			int branchID) : _population(population),
+			int branchID,
+			const Population::GaObjectiveMatrix* matrix = NULL) : _population(population),
 			_domCount(domCount),
 			_domList(domList),
-			_branchID(branchID) { }
+			_branchID(branchID),
+			_matrix(matrix) { }
 
 		/// <summary>Dummy operator to satisfy interface.</summary>
 		inline void GACALL operator ()(Population::GaChromosomeStorage& chromosome,
@@ -118,7 +124,7 @@ namespace Multiobjective
 			int index2)
 		{
 			// get dominant chromosome
-			int res = _population.CompareFitness( chromosome1, chromosome2 );
+			int res = _matrix ? _matrix->Compare( index1, index2 ) : _population.CompareFitness( chromosome1, chromosome2 );
 
 			// is the first chromosome dominant?
 			if( res < 0 )
@@ -50,6 +50,26 @@ namespace Multiobjective
 			/// <summary>Minimal fitness found by each workflow branch.</summary>
 			Common::Data::GaSingleDimensionArray<float> _minBuffer;
 
+			/// <summary>Sorter that identifies pareto fronts in advance when sorting algorithm is selected.</summary>
+			GaNondominatedSorter _sorter;
+
+			/// <summary><c>StoreFront</c> method assigns dummy fitness to chromosomes in pareto front identified by the sorter and stores them to buffer of processed chromosomes.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="front">index of pareto front.</param>
+			/// <param name="processedBuffer">buffer to which the processed chromosomes are stored.</param>
+			inline void GACALL StoreFront(int front,
+				Population::GaChromosomeGroup& processedBuffer)
+			{
+				for( int i = _sorter.GetFrontSize( front ) - 1; i >= 0; i-- )
+				{
+					Population::GaChromosomeStorage& chromosome = _sorter.GetFrontMember( front, i );
+
+					( (GaNSGAFitness&)chromosome.GetFitness( Population::GaChromosomeStorage::GAFT_SCALED ) ).SetValue( _dummyFitness );
+					processedBuffer.Add( &chromosome );
+				}
+			}
+
 			/// <summary><c>UpdateDummyFitness</c> determins global minimal assigned dummy fitness that was assigned by any branch.
 			///
 			/// This method is not thread-safe.</summary>
@@ -118,17 +138,23 @@ namespace Multiobjective
 			/// <summary>Chromosome tag that indicates whether the pareto front to which chromosome belongs is already determined.</summary>
 			Population::GaChromosomeTagGetter<int> _processed;
 
+			/// <summary>Packed matrix of objective values or <c>NULL</c> if fitness comparator should be used.</summary>
+			const Population::GaObjectiveMatrix* _matrix;
+
 		public:
 
 			/// <summary>Initializes operaion.</summary>
 			/// <param name="population">population over whose chromosomes dominance is determined.</param>
 			/// <param name="dominated">chromosome tag that stores information whether the chromosome is dominated by any other chromosome in the population.</param>
 			/// <param name="processed">chromosome tag that indicates whether the pareto front to which chromosome belongs is already determined.</param>
+			/// <param name="matrix">packed matrix of objective values. If this parameter is <c>NULL</c>, fitness comparator is used.</param>
 			GaNSGADominanceOp(Population::GaPopulation& population,
 				const Population::GaChromosomeTagGetter<int>& dominated,
-				const Population::GaChromosomeTagGetter<int>& processed) : _population(population),
+				const Population::GaChromosomeTagGetter<int>& processed,
+				const Population::GaObjectiveMatrix* matrix = NULL) : _population(population),
 				_dominated(dominated),
-				_processed(processed) { }
+				_processed(processed),
+				_matrix(matrix) { }
 
 			/// <summary>Dummy operator to satisfy interface.</summary>
 			inline void GACALL operator ()(Population::GaChromosomeStorage& chromosome,
@@ -150,7 +176,7 @@ namespace Multiobjective
 					&& ( !_dominated( chromosome1 ) || !_dominated( chromosome2 ) ) )
 				{
 					// get dominant chromosome
-					int dom = _population.CompareFitness( chromosome1, chromosome2 );
+					int dom = _matrix ? _matrix->Compare( index1, index2 ) : _population.CompareFitness( chromosome1, chromosome2 );
 
 					// is the first one is dominant
 					if( dom > 0 )
@@ -348,6 +374,7 @@ namespace Multiobjective
 			{
 				// mark population as re-scaled
 				population.GetFlags().SetFlags( Population::GaPopulation::GAPF_COMPLETE_SCALED_FITNESS_UPDATE );
+				population.MarkModified();
 
 				// update buffer sizes when population size is changed
 				processedBuffer.Clear();
@@ -367,17 +394,34 @@ namespace Multiobjective
 
 			Common::Workflows::GaParallelExec1<Population::GaPopulation, Population::GaChromosomeStorage> popWorkDist( *branch, population );
 			Common::Workflows::GaParallelExec2<Population::GaPopulation, Population::GaChromosomeStorage> domWorkDist( *branch, population );
+			domWorkDist.SetScheduling( Common::Workflows::GAPS_DYNAMIC );
 
 			// clear chromosome tags before execution of the algorithm
 			popWorkDist.Execute( GaNSGACleanOp( getProcessed, getSum ), true );
 
+			// identify all pareto fronts in advance when sorting algorithm is selected
+			bool sorted = parameters.GetSortingType() != GANST_PAIRWISE && dummyStorage._sorter.Sort( population, parameters.GetSortingType(), branch );
+
+			// pack objective values of chromosomes for pairwise comparison
+			const Population::GaObjectiveMatrix* matrix = !sorted && population.GetObjectiveMatrix().Update( population, branch )
+				? &population.GetObjectiveMatrix() : NULL;
+
 			// identify each pareto front
 			int orderIndexStart = 0;
-			while( orderIndexStart < population.GetCount() )
+			for( int frontIndex = 0; orderIndexStart < population.GetCount(); frontIndex++ )
 			{
-				// identify nondominated chromosome for the current pareto front and assign dummy fitness value to them 
-				domWorkDist.Execute( GaNSGADominanceOp( population, getDominated, getProcessed ), true );
-				popWorkDist.Execute( GaNSGADummyFitnessOp( dummyStorage._dummyFitness, getDominated, getProcessed, processedBuffer ), true );
+				if( sorted )
+				{
+					// assign dummy fitness value to chromosomes in the current pareto front
+					GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+						dummyStorage.StoreFront( frontIndex, processedBuffer );
+				}
+				else
+				{
+					// identify nondominated chromosome for the current pareto front and assign dummy fitness value to them 
+					domWorkDist.Execute( GaNSGADominanceOp( population, getDominated, getProcessed, matrix ), true );
+					popWorkDist.Execute( GaNSGADummyFitnessOp( dummyStorage._dummyFitness, getDominated, getProcessed, processedBuffer ), true );
+				}
 
 				typedef Common::Workflows::GaLimitedItemProvider1<Population::GaChromosomeGroup, Population::GaChromosomeStorage> GaProvider;
 				GaProvider provider( orderIndexStart );
@@ -446,6 +490,9 @@ namespace Multiobjective
 
 			Fitness::Comparators::GaVegaComparator _vega;
 
+			/// <summary>Sorter that identifies pareto fronts in advance when sorting algorithm is selected.</summary>
+			GaNondominatedSorter _sorter;
+
 		public:
 
 			/// <summary>This constructor initializes empty pareto front.</summary>
@@ -458,6 +505,22 @@ namespace Multiobjective
 			/// <param name="chromosome">chromosome that should be inserted.</param>
 			inline void GACALL QueueChromosome(Population::GaChromosomeStorage* chromosome) { _front[ _currentCount++ ] = chromosome; }
 
+			/// <summary><c>QueueFront</c> method inserts all chromosomes of pareto front identified in advance.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="fronts">sorter or incremental dominance structure that has identified pareto fronts.</param>
+			/// <param name="front">index of pareto front. If the front has not been identified, no chromosomes are inserted.</param>
+			template<typename FRONTS>
+			inline void GACALL QueueFront(const FRONTS& fronts,
+				int front)
+			{
+				if( front < fronts.GetFrontCount() )
+				{
+					for( int i = fronts.GetFrontSize( front ) - 1; i >= 0; i-- )
+						QueueChromosome( &fronts.GetFrontMember( front, i ) );
+				}
+			}
+
 			/// <summary><c>AcquireQueuedChromosomes</c> method creates chromosome group in the front that is sorted according to specified objective.
 			/// Different threads can safely execute this method simultaneously, but only for differen objectives and no other methods on this object
 			/// should be executed from other threads at that time.
@@ -542,6 +605,10 @@ namespace Multiobjective
 			/// <returns>Method returns number of chromosomes that front can store.</returns>
 			inline int GACALL GetFrontSize() const { return _front.GetSize(); }
 
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns reference to sorter that identifies pareto fronts in advance.</returns>
+			inline GaNondominatedSorter& GACALL GetSorter() { return _sorter; }
+
 		};
 
 		/// <summary><c>GaNSGA2FirstFrontOp</c> class represents operation that identify chromosomes that belongs to the first pareto front and assigns ranking to the chromosome.</summary>
@@ -593,6 +660,43 @@ namespace Multiobjective
 
 		};
 
+		/// <summary><c>GaNSGA2RankOp</c> class represents operation that assigns ranking to the chromosome according to pareto front identified in advance.</summary>
+		/// <param name="FRONTS">type of sorter or incremental dominance structure that has identified pareto fronts.</param>
+		template<typename FRONTS>
+		class GaNSGA2RankOp
+		{
+
+		private:
+
+			/// <summary>Sorter or incremental dominance structure that has identified pareto fronts.</summary>
+			const FRONTS& _fronts;
+
+			/// <summary>Rank that chromosomes that belongs to the first pareto front should get.</summary>
+			int _rank;
+
+		public:
+
+			/// <summary>Initializes operation.</summary>
+			/// <param name="fronts">sorter or incremental dominance structure that has identified pareto fronts.</param>
+			/// <param name="rank">rank that chromosomes that belongs to the first pareto front should get.</param>
+			GaNSGA2RankOp(const FRONTS& fronts,
+				int rank) : _fronts(fronts),
+				_rank(rank) { }
+
+			/// <summary><c>operator ()</c> assigns ranking to the chromosome and clears its crowding distance.</summary>
+			/// <param name="chromosome">chromosome to which the ranking should be assigned.</param>
+			/// <param name="index">index of chromosome.</param>
+			inline void GACALL operator ()(Population::GaChromosomeStorage& chromosome,
+				int index)
+			{
+				GaNSGA2Fitness& fitness = (GaNSGA2Fitness&)chromosome.GetFitness( Population::GaChromosomeStorage::GAFT_SCALED );
+
+				fitness.SetValue( 0, 1 );
+				fitness.SetValue( (float)( _rank - _fronts.GetFront( index ) ), 0 );
+			}
+
+		};
+
 		/// <summary><c>GaNSGA2NextFrontOp</c> class represents operation that identify chromosomes that belongs to next pareto front and assigns ranking to the chromosome.</summary>
 		class GaNSGA2NextFrontOp
 		{
@@ -716,6 +820,11 @@ namespace Multiobjective
 
 			// add required population tags
 			population.GetTagManager().AddTag( ( (const GaNSGA2Params&)parameters ).GetFrontTagID(), Common::Data::GaTypedTagLifecycle<GaNSGA2Front>() );
+			if( ( (const GaNSGA2Params&)parameters ).GetIncrementalDominanceTagID() >= 0 )
+			{
+				population.GetTagManager().AddTag( ( (const GaNSGA2Params&)parameters ).GetIncrementalDominanceTagID(),
+					Common::Data::GaTypedTagLifecycle<GaIncrementalDominance>() );
+			}
 
 			GaScalingOperation::Prepare( population, parameters, configuration, branchCount );
 		}
@@ -732,6 +841,8 @@ namespace Multiobjective
 
 			// remove required population tags
 			population.GetTagManager().RemoveTag( ( (const GaNSGA2Params&)parameters ).GetFrontTagID() );
+			if( ( (const GaNSGA2Params&)parameters ).GetIncrementalDominanceTagID() >= 0 )
+				population.GetTagManager().RemoveTag( ( (const GaNSGA2Params&)parameters ).GetIncrementalDominanceTagID() );
 
 			GaScalingOperation::Clear( population, parameters, configuration, branchCount );
 		}
@@ -768,6 +879,7 @@ namespace Multiobjective
 			{
 				// mark population as re-scaled
 				population.GetFlags().SetFlags( Population::GaPopulation::GAPF_COMPLETE_SCALED_FITNESS_UPDATE );
+				population.MarkModified();
 
 				// update buffer sizes when population size is changed
 				front.SetFrontSize( population.GetPopulationParams().GetPopulationSize(), objectivesCount, branchCount );
@@ -779,12 +891,45 @@ namespace Multiobjective
 
 			Common::Workflows::GaParallelExec1<Population::GaPopulation, Population::GaChromosomeStorage> popWorkDist( *branch, population );
 			Common::Workflows::GaParallelExec2<Population::GaPopulation, Population::GaChromosomeStorage> domWorkDist( *branch, population );
+			domWorkDist.SetScheduling( Common::Workflows::GAPS_DYNAMIC );
 
 			int rank = population.GetCount();
 
-			// identify nondominated chromosome and create the first pareto front
-			domWorkDist.Execute( GaDominanceOp( population, getDomCount, getDomList, branchID ), true );
-			popWorkDist.Execute( GaNSGA2FirstFrontOp( front, getDomCount, rank ), true );
+			// pareto fronts are maintained across generations when incremental dominance is used
+			GaIncrementalDominance* dominance = NULL;
+			bool incremental = false;
+			if( parameters.GetIncrementalDominanceTagID() >= 0 )
+			{
+				dominance = &population.GetTagByID<GaIncrementalDominance>( parameters.GetIncrementalDominanceTagID() );
+				incremental = dominance->Update( population, population.GetFlags().IsFlagSetAny( Population::GaPopulation::GAPF_COMPLETE_FITNESS_UPDATE |
+					Population::GaPopulation::GAPF_FITNESS_COMPARATOR_CHANGED ), false, branch );
+			}
+
+			// identify all pareto fronts in advance when sorting algorithm is selected
+			bool sorted = !incremental && parameters.GetSortingType() != GANST_PAIRWISE && front.GetSorter().Sort( population, parameters.GetSortingType(), branch );
+			if( incremental )
+			{
+				// assign ranking to all chromosomes and create the first pareto front
+				popWorkDist.Execute( GaNSGA2RankOp<GaIncrementalDominance>( *dominance, rank ), true );
+				GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+					front.QueueFront( *dominance, 0 );
+			}
+			else if( sorted )
+			{
+				// assign ranking to all chromosomes and create the first pareto front
+				popWorkDist.Execute( GaNSGA2RankOp<GaNondominatedSorter>( front.GetSorter(), rank ), true );
+				GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+					front.QueueFront( front.GetSorter(), 0 );
+			}
+			else
+			{
+				// pack objective values of chromosomes for pairwise comparison
+				const Population::GaObjectiveMatrix* matrix = population.GetObjectiveMatrix().Update( population, branch ) ? &population.GetObjectiveMatrix() : NULL;
+
+				// identify nondominated chromosome and create the first pareto front
+				domWorkDist.Execute( GaDominanceOp( population, getDomCount, getDomList, branchID, matrix ), true );
+				popWorkDist.Execute( GaNSGA2FirstFrontOp( front, getDomCount, rank ), true );
+			}
 
 			Fitness::Comparators::GaComparisonType sortType = ( (Fitness::Comparators::GaSimpleComparatorParams&)population.GetFitnessComparator().GetParameters() ).GetType();
 
@@ -792,7 +937,7 @@ namespace Multiobjective
 			branch->SplitWork( objectivesCount, count, start );
 
 			// identify each front and assign fitness
-			while( front.GetCurrentCount() )
+			for( int frontIndex = 1; front.GetCurrentCount(); frontIndex++ )
 			{
 				// create sorted groups for current front for each objective
 				for( int i = start + count - 1; i >= start; i-- )
@@ -820,9 +965,24 @@ namespace Multiobjective
 					}
 				}
 
-				// identify next pareto front and assign rank to chromosomes
-				Common::Workflows::GaParallelExec1<Population::GaChromosomeGroup, Population::GaChromosomeStorage> frontWorkDist( *branch, front.GetSortedFront( 0 ) );
-				frontWorkDist.Execute( GaNSGA2NextFrontOp( getDomCount, getDomList, front, --rank ), true );
+				if( incremental )
+				{
+					// next pareto front is already identified
+					GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+						front.QueueFront( *dominance, frontIndex );
+				}
+				else if( sorted )
+				{
+					// next pareto front is already identified
+					GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+						front.QueueFront( front.GetSorter(), frontIndex );
+				}
+				else
+				{
+					// identify next pareto front and assign rank to chromosomes
+					Common::Workflows::GaParallelExec1<Population::GaChromosomeGroup, Population::GaChromosomeStorage> frontWorkDist( *branch, front.GetSortedFront( 0 ) );
+					frontWorkDist.Execute( GaNSGA2NextFrontOp( getDomCount, getDomList, front, --rank ), true );
+				}
 			}
 
 			// update operation time statistics
@@ -14,6 +14,7 @@
 #define __GA_NSGA_H__
 
 #include "FitnessSharing.h"
+#include "NondominatedSorting.h"
 
 namespace Multiobjective
 {
@@ -46,6 +47,9 @@ namespace Multiobjective
 			/// <summary>ID of population tag that stores chromosomes after pareto front to which they belong is determined.</summary>
 			int _processedBufferTagID;
 
+			/// <summary>Algorithm used for sorting chromosomes into pareto fronts.</summary>
+			GaNondominatedSortingType _sortingType;
+
 		public:
 
 			/// <summary>This constructor initializes parameters with used-defined values.</summary>
@@ -57,6 +61,7 @@ namespace Multiobjective
 			/// <param name="cutoff">distance cutoff.</param>
 			/// <param name="alpha">curvature of sharing function.</param>
 			/// <param name="partialSumTagID">ID of the chromosome that that contains partially calculated shared fitness.</param>
+			/// <param name="sortingType">algorithm used for sorting chromosomes into pareto fronts.</param>
 			GaNSGAParams(float delta,
 				int dominatedTagID,
 				int processedTagID,
@@ -64,18 +69,21 @@ namespace Multiobjective
 				int processedBufferTagID,
 				float cutoff,
 				float alpha,
-				int partialSumTagID) : GaShareFitnessParams(cutoff, alpha, partialSumTagID),
+				int partialSumTagID,
+				GaNondominatedSortingType sortingType = GANST_PAIRWISE) : GaShareFitnessParams(cutoff, alpha, partialSumTagID),
 				_dominatedTagID(dominatedTagID),
 				_processedTagID(processedTagID),
 				_dummyTagID(dummyTagID),
-				_processedBufferTagID(processedBufferTagID) { SetDelta( delta ); }
+				_processedBufferTagID(processedBufferTagID),
+				_sortingType(sortingType) { SetDelta( delta ); }
 
 			/// <summary>This constructor initializes parameters with default values.</summary>
 			GaNSGAParams() : _delta(0.1f),
 				_dominatedTagID(-1),
 				_processedTagID(-1),
 				_dummyTagID(-1),
-				_processedBufferTagID(-1) { }
+				_processedBufferTagID(-1),
+				_sortingType(GANST_PAIRWISE) { }
 
 			/// <summary>More details are given in specification of <see cref="GaParameters::Clone" /> method.
 			///
@@ -136,6 +144,17 @@ namespace Multiobjective
 			/// <returns>Method returns ID of population tag that stores chromosomes after pareto front to which they belong is determined.</returns>
 			inline int GACALL GetProcessedBufferTagID() const { return _processedBufferTagID; }
 
+			/// <summary><c>SetSortingType</c> method sets algorithm used for sorting chromosomes into pareto fronts.
+			/// Algorithms other then <c>GANST_PAIRWISE</c> require fitness objects that can provide their values. Operation falls back to pairwise comparison otherwise.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="type">sorting algorithm.</param>
+			inline void GACALL SetSortingType(GaNondominatedSortingType type) { _sortingType = type; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns algorithm used for sorting chromosomes into pareto fronts.</returns>
+			inline GaNondominatedSortingType GACALL GetSortingType() const { return _sortingType; }
+
 		};
 
 		/// <summary><c>GaNSGAFitness</c> defines fitness type that NSGA uses to scaled fitness. Detailed description can be found in specification of
@@ -229,22 +248,36 @@ namespace Multiobjective
 			/// <summary>ID of population tag that stores chromosome that belongs to currently processed pareto front.</summary>
 			int _frontTagID;
 
+			/// <summary>Algorithm used for sorting chromosomes into pareto fronts.</summary>
+			GaNondominatedSortingType _sortingType;
+
+			/// <summary>ID of population tag that stores incremental dominance structure. Incremental ranking is disabled if ID is negative.</summary>
+			int _incrementalDominanceTagID;
+
 		public:
 
 			/// <summary>This constructor initializes parameters with used-defined values.</summary>
 			/// <param name="dominatedCountTagID">ID of chromosome tag that stores number of chromosomes that dominates the chromosome.</param>
 			/// <param name="dominatedListTagID">ID of chromosome tag that stores partial list of chromosomes that are dominated by the chromosome.</param>
 			/// <param name="frontTagID">ID of population tag that stores chromosome that belongs to currently processed pareto front.</param>
+			/// <param name="sortingType">algorithm used for sorting chromosomes into pareto fronts.</param>
+			/// <param name="incrementalDominanceTagID">ID of population tag that stores incremental dominance structure.</param>
 			GaNSGA2Params(int dominatedCountTagID,
 				int dominatedListTagID,
-				int frontTagID) : _dominatedCountTagID(dominatedCountTagID),
+				int frontTagID,
+				GaNondominatedSortingType sortingType = GANST_PAIRWISE,
+				int incrementalDominanceTagID = -1) : _dominatedCountTagID(dominatedCountTagID),
 				_dominatedListTagID(dominatedListTagID),
-				_frontTagID(frontTagID) { }
+				_frontTagID(frontTagID),
+				_sortingType(sortingType),
+				_incrementalDominanceTagID(incrementalDominanceTagID) { }
 
 			/// <summary>This constructor initializes parameters with default values.</summary>
 			GaNSGA2Params() : _dominatedCountTagID(-1),
 				_dominatedListTagID(-1),
-				_frontTagID(-1) { }
+				_frontTagID(-1),
+				_sortingType(GANST_PAIRWISE),
+				_incrementalDominanceTagID(-1) { }
 
 			/// <summary>More details are given in specification of <see cref="GaParameters::Clone" /> method.
 			///
@@ -281,6 +314,30 @@ namespace Multiobjective
 			/// <returns>Method returns ID of population tag that stores chromosome that belongs to currently processed pareto front.</returns>
 			inline int GACALL GetFrontTagID() const { return _frontTagID; }
 
+			/// <summary><c>SetSortingType</c> method sets algorithm used for sorting chromosomes into pareto fronts.
+			/// Algorithms other then <c>GANST_PAIRWISE</c> require fitness objects that can provide their values. Operation falls back to pairwise comparison otherwise.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="type">sorting algorithm.</param>
+			inline void GACALL SetSortingType(GaNondominatedSortingType type) { _sortingType = type; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns algorithm used for sorting chromosomes into pareto fronts.</returns>
+			inline GaNondominatedSortingType GACALL GetSortingType() const { return _sortingType; }
+
+			/// <summary><c>SetIncrementalDominanceTagID</c> method sets population tag that stores incremental dominance structure.
+			/// When the tag is set, pareto fronts are maintained across generations and updated only for chromosomes that were replaced,
+			/// which is suitable for steady-state algorithms that replace small number of chromosomes in each generation.
+			/// Incremental ranking requires fitness objects that can provide their values. Operation falls back to sorting algorithm otherwise.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="tagID">ID of the tag. Negative value disables incremental ranking.</param>
+			inline void GACALL SetIncrementalDominanceTagID(int tagID) { _incrementalDominanceTagID = tagID; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns ID of population tag that stores incremental dominance structure.</returns>
+			inline int GACALL GetIncrementalDominanceTagID() const { return _incrementalDominanceTagID; }
+
 		};
 
 		/// <summary><c>GaNSGAFitness</c> defines fitness type that NSGA uses to scaled fitness. Detailed description can be found in specification of
@@ -0,0 +1,1117 @@
+/*! \file NondominatedSorting.cpp
+    \brief This file contains implementation of classes that implement fast nondominated sorting of chromosomes into pareto fronts.
+*/
+
+/*
+ *
+ * website: http://kataklinger.com/
+ * contact: me[at]kataklinger.com
+ *
+ */
+
+#include <algorithm>
+#include "FitnessComparators.h"
+#include "NondominatedSorting.h"
+
+namespace Multiobjective
+{
+
+	/// <summary><c>GaNondominatedValuesOp</c> class represents operation that extracts objective values of chromosomes for sorter.</summary>
+	class GaNondominatedValuesOp
+	{
+
+	private:
+
+		/// <summary>Sorter that stores extracted values.</summary>
+		GaNondominatedSorter& _sorter;
+
+	public:
+
+		/// <summary>Initializes operation.</summary>
+		/// <param name="sorter">sorter that stores extracted values.</param>
+		GaNondominatedValuesOp(GaNondominatedSorter& sorter) : _sorter(sorter) { }
+
+		/// <summary><c>operator ()</c> extracts objective values of the chromosome.</summary>
+		/// <param name="chromosome">chromosome whose values should be extracted.</param>
+		/// <param name="index">index of the chromosome.</param>
+		inline void GACALL operator ()(Population::GaChromosomeStorage& chromosome,
+			int index) { _sorter.StoreValues( chromosome, index ); }
+
+	};
+
+	/// <summary><c>GaLexicographicalCriteria</c> class compares rows of objective values lexicographically.
+	/// Rows with equal values are ordered by their indices.</summary>
+	class GaLexicographicalCriteria
+	{
+
+	private:
+
+		/// <summary>Objective values stored row by row.</summary>
+		const double* _values;
+
+		/// <summary>Number of values in each row.</summary>
+		int _objectivesCount;
+
+	public:
+
+		/// <summary>Initializes criteria.</summary>
+		/// <param name="values">objective values stored row by row.</param>
+		/// <param name="objectivesCount">number of values in each row.</param>
+		GaLexicographicalCriteria(const double* values,
+			int objectivesCount) : _values(values),
+			_objectivesCount(objectivesCount) { }
+
+		/// <summary><c>operator ()</c> compares two rows.</summary>
+		/// <param name="index1">index of the first row.</param>
+		/// <param name="index2">index of the second row.</param>
+		/// <returns>Method returns <c>true</c> if the first row should be placed before the second.</returns>
+		inline bool GACALL operator ()(int index1,
+			int index2) const
+		{
+			const double* values1 = _values + index1 * _objectivesCount;
+			const double* values2 = _values + index2 * _objectivesCount;
+
+			for( int i = 0; i < _objectivesCount; i++ )
+			{
+				if( values1[ i ] != values2[ i ] )
+					return values1[ i ] < values2[ i ];
+			}
+
+			return index1 < index2;
+		}
+
+	};
+
+	/// <summary><c>GaObjectiveCriteria</c> class compares distinct points by a single objective.
+	/// Points with equal values are ordered by their lexicographical order.</summary>
+	class GaObjectiveCriteria
+	{
+
+	private:
+
+		/// <summary>Objective values of distinct points stored row by row.</summary>
+		const double* _values;
+
+		/// <summary>Number of values in each row.</summary>
+		int _objectivesCount;
+
+		/// <summary>Index of compared objective.</summary>
+		int _objective;
+
+	public:
+
+		/// <summary>Initializes criteria.</summary>
+		/// <param name="values">objective values of distinct points stored row by row.</param>
+		/// <param name="objectivesCount">number of values in each row.</param>
+		/// <param name="objective">index of compared objective.</param>
+		GaObjectiveCriteria(const double* values,
+			int objectivesCount,
+			int objective) : _values(values),
+			_objectivesCount(objectivesCount),
+			_objective(objective) { }
+
+		/// <summary><c>operator ()</c> compares two points.</summary>
+		/// <param name="point1">index of the first point.</param>
+		/// <param name="point2">index of the second point.</param>
+		/// <returns>Method returns <c>true</c> if the first point should be placed before the second.</returns>
+		inline bool GACALL operator ()(int point1,
+			int point2) const
+		{
+			double value1 = _values[ point1 * _objectivesCount + _objective ];
+			double value2 = _values[ point2 * _objectivesCount + _objective ];
+			return value1 < value2 || ( value1 == value2 && point1 < point2 );
+		}
+
+	};
+
+	/// <summary><c>GaFenwickQuery</c> function queries maximal front stored in Fenwick tree for the first <c>position</c> keys.</summary>
+	/// <param name="tree">Fenwick tree.</param>
+	/// <param name="position">number of keys that should be queried.</param>
+	/// <returns>Method returns maximal front or -1 if there are no points stored for queried keys.</returns>
+	inline int GACALL GaFenwickQuery(const int* tree,
+		int position)
+	{
+		int result = -1;
+		for( ; position > 0; position -= position & -position )
+		{
+			if( tree[ position ] > result )
+				result = tree[ position ];
+		}
+
+		return result;
+	}
+
+	/// <summary><c>GaFenwickUpdate</c> function stores front of a point with specified key position to Fenwick tree.</summary>
+	/// <param name="tree">Fenwick tree.</param>
+	/// <param name="size">number of keys stored by the tree.</param>
+	/// <param name="position">position of key (1-based).</param>
+	/// <param name="rank">front of the point.</param>
+	inline void GACALL GaFenwickUpdate(int* tree,
+		int size,
+		int position,
+		int rank)
+	{
+		for( ; position <= size; position += position & -position )
+		{
+			if( tree[ position ] < rank )
+				tree[ position ] = rank;
+		}
+	}
+
+	// Sorts chromosomes into pareto fronts
+	bool GaNondominatedSorter::Sort(Population::GaPopulation& population,
+		GaNondominatedSortingType type,
+		Common::Workflows::GaBranch* branch)
+	{
+		int branchCount = branch->GetBarrierCount();
+
+		GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+			Prepare( population, type );
+
+		if( !_supported )
+			return false;
+
+		// extract objective values of all chromosomes
+		Common::Workflows::GaParallelExec1<Population::GaPopulation, Population::GaChromosomeStorage> popWorkDist( *branch, population );
+		popWorkDist.Execute( GaNondominatedValuesOp( *this ), true );
+
+		// sort chromosomes lexicographically and merge duplicates
+		GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+			Presort();
+
+		if( type == GANST_BEST_ORDER )
+		{
+			// each branch sorts points by different objectives
+			int count, start;
+			branch->SplitWork( _objectivesCount, count, start );
+			for( int i = start + count - 1; i >= start; i-- )
+				SortObjective( i );
+		}
+
+		// identify fronts
+		GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+		{
+			switch( type )
+			{
+
+			case GANST_ENS_BINARY:
+				RankEfficient( true );
+				break;
+
+			case GANST_DIVIDE_AND_CONQUER:
+				RankDivideAndConquer();
+				break;
+
+			case GANST_BEST_ORDER:
+				RankBestOrder();
+				break;
+
+			default:
+				RankEfficient( false );
+				break;
+
+			}
+
+			BuildFronts();
+		}
+
+		return true;
+	}
+
+	// Prepares buffers for sorting
+	void GaNondominatedSorter::Prepare(Population::GaPopulation& population,
+		GaNondominatedSortingType type)
+	{
+		_count = population.GetCount();
+		_objectivesCount = ( (const Fitness::Representation::GaMVFitnessParams&)population.GetFitnessParams() ).GetValueCount();
+		_comparisonType = ( (const Fitness::Comparators::GaSimpleComparatorParams&)population.GetFitnessComparator().GetParameters() ).GetType();
+		_uniqueCount = _frontCount = 0;
+
+		// fitness objects must provide objective values
+		double value;
+		_supported = _count == 0 || ( (const Fitness::Representation::GaMVFitnessBase&)population[ 0 ].GetFitness(
+			Population::GaChromosomeStorage::GAFT_RAW ) ).GetValue( 0, value );
+
+		if( _supported )
+		{
+			int size = _count * _objectivesCount;
+			int listSize = type == GANST_BEST_ORDER ? size : _count;
+
+			_chromosomes.SetSize( _count );
+			_values.SetSize( size );
+			_points.SetSize( size );
+			_order.SetSize( _count );
+			_groups.SetSize( _count );
+			_ranks.SetSize( _count );
+			_fronts.SetSize( _count );
+			_objectiveOrders.SetSize( type == GANST_BEST_ORDER ? size : 0 );
+			_lists.SetSize( listSize );
+			_links.SetSize( listSize + 1 );
+			_work.SetSize( _count );
+			_keys.SetSize( _count );
+		}
+	}
+
+	// Sorts chromosomes lexicographically and merges duplicates
+	void GaNondominatedSorter::Presort()
+	{
+		int* order = _order.GetArray();
+		for( int i = _count - 1; i >= 0; i-- )
+			order[ i ] = i;
+
+		std::sort( order, order + _count, GaLexicographicalCriteria( _values.GetArray(), _objectivesCount ) );
+
+		// copy distinct points and map chromosomes to them
+		const double* previous = NULL;
+		for( int i = 0; i < _count; i++ )
+		{
+			const double* current = &_values[ order[ i ] * _objectivesCount ];
+			if( !previous || !std::equal( current, current + _objectivesCount, previous ) )
+			{
+				std::copy( current, current + _objectivesCount, &_points[ _uniqueCount * _objectivesCount ] );
+				_ranks[ _uniqueCount++ ] = 0;
+				previous = current;
+			}
+
+			_groups[ i ] = _uniqueCount - 1;
+		}
+	}
+
+	// Sorts distinct points by an objective
+	void GaNondominatedSorter::SortObjective(int objective)
+	{
+		int* order = _objectiveOrders.GetArray() + objective * _uniqueCount;
+		for( int i = _uniqueCount - 1; i >= 0; i-- )
+			order[ i ] = i;
+
+		std::sort( order, order + _uniqueCount, GaObjectiveCriteria( _points.GetArray(), _objectivesCount, objective ) );
+	}
+
+	// Groups chromosomes by fronts
+	void GaNondominatedSorter::BuildFronts()
+	{
+		_frontCount = 0;
+		for( int i = _uniqueCount - 1; i >= 0; i-- )
+		{
+			if( _ranks[ i ] >= _frontCount )
+				_frontCount = _ranks[ i ] + 1;
+		}
+
+		// count chromosomes in each front
+		_frontStarts.SetSize( _frontCount + 1 );
+		for( int i = _frontCount; i >= 0; i-- )
+			_frontStarts[ i ] = 0;
+
+		for( int i = _count - 1; i >= 0; i-- )
+			_frontStarts[ _ranks[ _groups[ i ] ] + 1 ]++;
+
+		for( int i = 0; i < _frontCount; i++ )
+		{
+			_frontStarts[ i + 1 ] += _frontStarts[ i ];
+			_work[ i ] = _frontStarts[ i ];
+		}
+
+		// place chromosomes in their fronts preserving lexicographical order
+		_frontMembers.SetSize( _count );
+		for( int i = 0; i < _count; i++ )
+		{
+			int front = _ranks[ _groups[ i ] ];
+			_fronts[ _order[ i ] ] = front;
+			_frontMembers[ _work[ front ]++ ] = _chromosomes[ _order[ i ] ];
+		}
+	}
+
+	// Efficient nondominated sort
+	void GaNondominatedSorter::RankEfficient(bool binary)
+	{
+		// last point added to each front and links to previously added points
+		int* heads = _lists.GetArray();
+		int* previous = _links.GetArray();
+		int frontCount = 0;
+
+		// points are processed in lexicographical order so they can be dominated only by already processed points
+		for( int point = 0; point < _uniqueCount; point++ )
+		{
+			int low = 0, high = frontCount;
+			while( low < high )
+			{
+				int front = binary ? low + ( high - low ) / 2 : low;
+
+				// check whether the point is dominated by any point in the front, starting with the last added
+				bool dominated = false;
+				for( int other = heads[ front ]; other >= 0 && !dominated; other = previous[ other ] )
+					dominated = WeaklyDominates( other, point, 1, _objectivesCount - 1 );
+
+				if( dominated )
+					low = front + 1;
+				else
+					high = front;
+			}
+
+			// new front is required?
+			if( low == frontCount )
+				heads[ frontCount++ ] = -1;
+
+			previous[ point ] = heads[ low ];
+			heads[ low ] = point;
+			_ranks[ point ] = low;
+		}
+	}
+
+	// Jensen's divide and conquer sorting
+	void GaNondominatedSorter::RankDivideAndConquer()
+	{
+		// each distinct point with single objective dominates all points that follow it
+		if( _objectivesCount == 1 )
+		{
+			for( int i = _uniqueCount - 1; i >= 0; i-- )
+				_ranks[ i ] = i;
+
+			return;
+		}
+
+		int* set = _lists.GetArray();
+		for( int i = _uniqueCount - 1; i >= 0; i-- )
+			set[ i ] = i;
+
+		HelperA( set, _uniqueCount, _objectivesCount - 1 );
+	}
+
+	// Best order sort
+	void GaNondominatedSorter::RankBestOrder()
+	{
+		// lists of points for each objective and front are stored as linked lists
+		int* heads = _lists.GetArray();
+		int* next = _links.GetArray();
+		for( int i = _uniqueCount * _objectivesCount - 1; i >= 0; i-- )
+			heads[ i ] = -1;
+
+		for( int i = _uniqueCount - 1; i >= 0; i-- )
+			_ranks[ i ] = -1;
+
+		int frontCount = 0, ranked = 0;
+		for( int i = 0; i < _uniqueCount && ranked < _uniqueCount; i++ )
+		{
+			for( int objective = 0; objective < _objectivesCount; objective++ )
+			{
+				int base = objective * _uniqueCount;
+				int point = _objectiveOrders[ base + i ];
+				int* lists = heads + base;
+
+				// point is seen for the first time?
+				if( _ranks[ point ] < 0 )
+				{
+					// all points that can dominate current point are already in the lists for this objective
+					// and they are not worse in this objective, so it can be skipped
+					int front = 0;
+					for( ; front < frontCount; front++ )
+					{
+						bool dominated = false;
+						for( int node = lists[ front ]; node >= 0 && !dominated; node = next[ node ] )
+							dominated = WeaklyDominates( node - base, point, 0, _objectivesCount - 1, objective );
+
+						if( !dominated )
+							break;
+					}
+
+					if( front == frontCount )
+						frontCount++;
+
+					_ranks[ point ] = front;
+					ranked++;
+				}
+
+				// insert point to the list of its front for this objective
+				next[ base + point ] = lists[ _ranks[ point ] ];
+				lists[ _ranks[ point ] ] = base + point;
+			}
+		}
+	}
+
+	// Assigns fronts to points of the set
+	void GaNondominatedSorter::HelperA(int* set,
+		int size,
+		int objective)
+	{
+		if( size < 2 )
+			return;
+
+		if( size == 2 )
+		{
+			// first point in lexicographical order is the only one that can be dominant
+			if( WeaklyDominates( set[ 0 ], set[ 1 ], 0, objective ) )
+				UpdateRank( set[ 1 ], _ranks[ set[ 0 ] ] );
+
+			return;
+		}
+
+		if( objective == 1 )
+		{
+			SweepA( set, size );
+			return;
+		}
+
+		// find range of objective values in the set
+		double min = GetPoint( set[ 0 ] )[ objective ], max = min;
+		for( int i = size - 1; i > 0; i-- )
+		{
+			double value = GetPoint( set[ i ] )[ objective ];
+			if( value < min )
+				min = value;
+			else if( value > max )
+				max = value;
+		}
+
+		// all points have same value - objective does not affect dominance
+		if( min == max )
+		{
+			HelperA( set, size, objective - 1 );
+			return;
+		}
+
+		// split set into points with lower and higher objective values
+		ExtractKeys( set, size, objective, 0 );
+		double pivot = Median( size );
+		int low = Split( set, size, objective, pivot, false );
+		if( !low )
+			low = Split( set, size, objective, pivot, true );
+
+		// points in higher part cannot dominate points in lower part
+		HelperA( set, low, objective );
+		HelperB( set, low, set + low, size - low, objective - 1 );
+		HelperA( set + low, size - low, objective );
+
+		Merge( set, low, size );
+	}
+
+	// Updates fronts of the higher set using points from the lower set
+	void GaNondominatedSorter::HelperB(int* low,
+		int lowSize,
+		int* high,
+		int highSize,
+		int objective)
+	{
+		if( !lowSize || !highSize )
+			return;
+
+		if( lowSize == 1 || highSize == 1 )
+		{
+			// compare all pairs
+			for( int i = 0; i < highSize; i++ )
+			{
+				for( int j = 0; j < lowSize; j++ )
+				{
+					if( WeaklyDominates( low[ j ], high[ i ], 0, objective ) )
+						UpdateRank( high[ i ], _ranks[ low[ j ] ] );
+				}
+			}
+
+			return;
+		}
+
+		if( objective == 1 )
+		{
+			SweepB( low, lowSize, high, highSize );
+			return;
+		}
+
+		// find ranges of objective values in both sets
+		double lowMin = GetPoint( low[ 0 ] )[ objective ], lowMax = lowMin;
+		for( int i = lowSize - 1; i > 0; i-- )
+		{
+			double value = GetPoint( low[ i ] )[ objective ];
+			if( value < lowMin )
+				lowMin = value;
+			else if( value > lowMax )
+				lowMax = value;
+		}
+
+		double highMin = GetPoint( high[ 0 ] )[ objective ], highMax = highMin;
+		for( int i = highSize - 1; i > 0; i-- )
+		{
+			double value = GetPoint( high[ i ] )[ objective ];
+			if( value < highMin )
+				highMin = value;
+			else if( value > highMax )
+				highMax = value;
+		}
+
+		// all points in lower set are not worse in this objective
+		if( lowMax <= highMin )
+		{
+			HelperB( low, lowSize, high, highSize, objective - 1 );
+			return;
+		}
+
+		// no point in lower set can dominate points in higher set
+		if( lowMin > highMax )
+			return;
+
+		// find pivot that splits both sets
+		ExtractKeys( low, lowSize, objective, 0 );
+		ExtractKeys( high, highSize, objective, lowSize );
+		double pivot = Median( lowSize + highSize );
+
+		int low1 = Split( low, lowSize, objective, pivot, false );
+		int high1 = Split( high, highSize, objective, pivot, false );
+		if( !low1 && !high1 )
+		{
+			low1 = Split( low, lowSize, objective, pivot, true );
+			high1 = Split( high, highSize, objective, pivot, true );
+		}
+
+		// points in upper part of lower set cannot dominate points in lower part of higher set
+		HelperB( low, low1, high, high1, objective );
+		HelperB( low, low1, high + high1, highSize - high1, objective - 1 );
+		HelperB( low + low1, lowSize - low1, high + high1, highSize - high1, objective );
+
+		Merge( low, low1, lowSize );
+		Merge( high, high1, highSize );
+	}
+
+	// Sweep line algorithm for two objectives
+	void GaNondominatedSorter::SweepA(const int* set,
+		int size)
+	{
+		int count = CompressKeys( set, size );
+		const double* keys = _keys.GetArray();
+
+		int* tree = _links.GetArray();
+		for( int i = count; i >= 0; i-- )
+			tree[ i ] = -1;
+
+		// points are processed in lexicographical order so the first objective is not worse for already processed points
+		for( int i = 0; i < size; i++ )
+		{
+			int position = (int)( std::lower_bound( keys, keys + count, GetPoint( set[ i ] )[ 1 ] ) - keys ) + 1;
+
+			int dominant = GaFenwickQuery( tree, position );
+			if( dominant >= 0 )
+				UpdateRank( set[ i ], dominant );
+
+			GaFenwickUpdate( tree, count, position, _ranks[ set[ i ] ] );
+		}
+	}
+
+	// Sweep line algorithm for two objectives and two sets
+	void GaNondominatedSorter::SweepB(const int* low,
+		int lowSize,
+		const int* high,
+		int highSize)
+	{
+		int count = CompressKeys( low, lowSize );
+		const double* keys = _keys.GetArray();
+
+		int* tree = _links.GetArray();
+		for( int i = count; i >= 0; i-- )
+			tree[ i ] = -1;
+
+		for( int i = 0, j = 0; i < highSize; i++ )
+		{
+			// insert points from lower set that precede current point in lexicographical order
+			for( ; j < lowSize && low[ j ] < high[ i ]; j++ )
+			{
+				int position = (int)( std::lower_bound( keys, keys + count, GetPoint( low[ j ] )[ 1 ] ) - keys ) + 1;
+				GaFenwickUpdate( tree, count, position, _ranks[ low[ j ] ] );
+			}
+
+			// find the highest front among points that are not worse in the second objective
+			int position = (int)( std::upper_bound( keys, keys + count, GetPoint( high[ i ] )[ 1 ] ) - keys );
+			int dominant = GaFenwickQuery( tree, position );
+			if( dominant >= 0 )
+				UpdateRank( high[ i ], dominant );
+		}
+	}
+
+	// Stable split of the set
+	int GaNondominatedSorter::Split(int* set,
+		int size,
+		int objective,
+		double pivot,
+		bool inclusive)
+	{
+		int* higher = _work.GetArray();
+		int lowCount = 0, highCount = 0;
+
+		for( int i = 0; i < size; i++ )
+		{
+			double value = GetPoint( set[ i ] )[ objective ];
+			if( value < pivot || ( inclusive && value == pivot ) )
+				set[ lowCount++ ] = set[ i ];
+			else
+				higher[ highCount++ ] = set[ i ];
+		}
+
+		std::copy( higher, higher + highCount, set + lowCount );
+		return lowCount;
+	}
+
+	// Merges sorted parts of the set
+	void GaNondominatedSorter::Merge(int* set,
+		int first,
+		int size)
+	{
+		if( first > 0 && first < size )
+		{
+			std::merge( set, set + first, set + first, set + size, _work.GetArray() );
+			std::copy( _work.GetArray(), _work.GetArray() + size, set );
+		}
+	}
+
+	// Extracts values of objective
+	void GaNondominatedSorter::ExtractKeys(const int* set,
+		int size,
+		int objective,
+		int offset)
+	{
+		double* keys = _keys.GetArray() + offset;
+		for( int i = size - 1; i >= 0; i-- )
+			keys[ i ] = GetPoint( set[ i ] )[ objective ];
+	}
+
+	// Finds median of extracted values
+	double GaNondominatedSorter::Median(int size)
+	{
+		double* keys = _keys.GetArray();
+		std::nth_element( keys, keys + size / 2, keys + size );
+		return keys[ size / 2 ];
+	}
+
+	// Extract distinct values of the second objective
+	int GaNondominatedSorter::CompressKeys(const int* set,
+		int size)
+	{
+		ExtractKeys( set, size, 1, 0 );
+
+		double* keys = _keys.GetArray();
+		std::sort( keys, keys + size );
+		return (int)( std::unique( keys, keys + size ) - keys );
+	}
+
+	// Updates dominance relations using changes of the population
+	bool GaIncrementalDominance::Update(Population::GaPopulation& population,
+		bool complete,
+		bool trackStrength,
+		Common::Workflows::GaBranch* branch)
+	{
+		GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
+			_rebuilding = Prepare( population, complete, trackStrength );
+
+		if( !_supported )
+			return false;
+
+		// comparison of all chromosomes is distributed among branches
+		if( _rebuilding )
+			Rebuild( population, branch );
+
+		return true;
+	}
+
+	// Applies small changes or prepares structure for rebuilding
+	bool GaIncrementalDominance::Prepare(Population::GaPopulation& population,
+		bool complete,
+		bool trackStrength)
+	{
+		int objectivesCount = ( (const Fitness::Representation::GaMVFitnessParams&)population.GetFitnessParams() ).GetValueCount();
+		int comparisonType = ( (const Fitness::Comparators::GaSimpleComparatorParams&)population.GetFitnessComparator().GetParameters() ).GetType();
+
+		// fitness objects must provide objective values
+		double value;
+		_supported = population.GetCount() == 0 || ( (const Fitness::Representation::GaMVFitnessBase&)population[ 0 ].GetFitness(
+			Population::GaChromosomeStorage::GAFT_RAW ) ).GetValue( 0, value );
+
+		if( !_supported )
+		{
+			Clear();
+			return false;
+		}
+
+		// stored values and relations are no longer valid if the comparison has changed
+		if( objectivesCount != _objectivesCount || comparisonType != _comparisonType || trackStrength != _trackStrength )
+		{
+			_objectivesCount = objectivesCount;
+			_comparisonType = comparisonType;
+			_trackStrength = trackStrength;
+			complete = true;
+		}
+
+		Population::GaChromosomeGroup& removed = population.GetRemovedChromosomes();
+		Population::GaChromosomeGroup& added = population.GetNewChromosomes();
+
+		// rebuilding is cheaper when large part of the population has been replaced
+		if( !complete && ( removed.GetCount() + added.GetCount() ) * 4 <= _count )
+		{
+			for( int i = removed.GetCount() - 1; i >= 0; i-- )
+			{
+				GaMembersTable::iterator it = _members.find( &removed[ i ] );
+				if( it != _members.end() )
+					Remove( it->second );
+			}
+
+			for( int i = 0; i < added.GetCount(); i++ )
+			{
+				GaMembersTable::iterator it = _members.find( &added[ i ] );
+				if( it != _members.end() )
+					Remove( it->second );
+
+				Insert( &added[ i ] );
+			}
+
+			// structure is out of sync if population was changed without tracking
+			complete = !Export( population );
+		}
+		else
+			complete = true;
+
+		if( complete )
+		{
+			Clear();
+			for( int i = 0; i < population.GetCount(); i++ )
+				Store( &population[ i ] );
+
+			// chromosome can only be dominated by chromosomes that precede it in lexicographical order
+			int* order = _affected.GetArray();
+			for( int i = _count - 1; i >= 0; i-- )
+				order[ i ] = i;
+
+			std::sort( order, order + _count, GaLexicographicalCriteria( _values.GetArray(), _objectivesCount ) );
+		}
+
+		return complete;
+	}
+
+	// Removes all chromosomes
+	void GaIncrementalDominance::Clear()
+	{
+		_members.clear();
+		_count = _frontCount = 0;
+	}
+
+	// Computes dominance relations between all chromosomes
+	void GaIncrementalDominance::Rebuild(Population::GaPopulation& population,
+		Common::Workflows::GaBranch* branch)
+	{
+		int branchID = branch->GetFilteredID();
+		int branchCount = branch->GetBarrierCount();
+
+		const int* order = _affected.GetArray();
+
+		// fronts of chromosomes depend on fronts of their dominators, so sorted chromosomes are processed in blocks
+		int blockCount = branchCount > 1 ? 16 * branchCount : 1;
+		int blockSize = ( _count + blockCount - 1 ) / blockCount;
+
+		for( int blockStart = 0; blockStart < _count; blockStart += blockSize )
+		{
+			int blockEnd = blockStart + blockSize < _count ? blockStart + blockSize : _count;
+
+			// compare chromosomes of the block to chromosomes of previous blocks whose fronts are known,
+			// branches take interleaved chromosomes so they have similar amount of work
+			for( int i = blockStart + branchID; i < blockEnd; i += branchCount )
+			{
+				int slot = order[ i ];
+
+				for( int j = blockStart - 1; j >= 0; j-- )
+				{
+					int dominant = order[ j ];
+					if( Dominates( dominant, slot ) )
+					{
+						_dominators[ slot ]++;
+
+						if( _fronts[ slot ] <= _fronts[ dominant ] )
+							_fronts[ slot ] = _fronts[ dominant ] + 1;
+					}
+				}
+
+				for( int j = i + 1; j < _count; j++ )
+				{
+					if( Dominates( slot, order[ j ] ) )
+						_strengths[ slot ]++;
+				}
+			}
+
+			// compare chromosomes within the block
+			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+			{
+				for( int i = blockStart + 1; i < blockEnd; i++ )
+				{
+					int slot = order[ i ];
+					for( int j = i - 1; j >= blockStart; j-- )
+					{
+						int dominant = order[ j ];
+						if( Dominates( dominant, slot ) )
+						{
+							_dominators[ slot ]++;
+
+							if( _fronts[ slot ] <= _fronts[ dominant ] )
+								_fronts[ slot ] = _fronts[ dominant ] + 1;
+						}
+					}
+				}
+			}
+		}
+
+		// strengths are known only after all relations are identified
+		if( _trackStrength )
+		{
+			for( int i = branchID; i < _count; i += branchCount )
+			{
+				int slot = order[ i ];
+				for( int j = i - 1; j >= 0; j-- )
+				{
+					if( Dominates( order[ j ], slot ) )
+						_rawFitness[ slot ] += _strengths[ order[ j ] ];
+				}
+			}
+		}
+
+		GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+			Export( population );
+	}
+
+	// Inserts chromosome
+	void GaIncrementalDominance::Insert(Population::GaChromosomeStorage* chromosome)
+	{
+		int slot = Store( chromosome );
+
+		int dominantCount, affectedCount;
+		FindRelations( slot, dominantCount, affectedCount );
+
+		_dominators[ slot ] = dominantCount;
+		_strengths[ slot ] = affectedCount;
+
+		for( int i = dominantCount - 1; i >= 0; i-- )
+		{
+			int dominant = _dominant[ i ];
+			_strengths[ dominant ]++;
+
+			if( _fronts[ slot ] <= _fronts[ dominant ] )
+				_fronts[ slot ] = _fronts[ dominant ] + 1;
+		}
+
+		for( int i = affectedCount - 1; i >= 0; i-- )
+			_dominators[ _affected[ i ] ]++;
+
+		if( _trackStrength )
+		{
+			for( int i = dominantCount - 1; i >= 0; i-- )
+				_rawFitness[ slot ] += _strengths[ _dominant[ i ] ];
+
+			// dominated chromosomes gain new dominator and all its dominators have increased strength
+			for( int i = affectedCount - 1; i >= 0; i-- )
+				_rawFitness[ _affected[ i ] ] += affectedCount + dominantCount;
+
+			// other chromosomes are affected only through increased strength of their dominators
+			if( dominantCount )
+			{
+				for( int i = _count - 1; i >= 0; i-- )
+				{
+					if( i != slot && !_marks[ i ] )
+					{
+						for( int j = dominantCount - 1; j >= 0; j-- )
+						{
+							if( Dominates( _dominant[ j ], i ) )
+								_rawFitness[ i ]++;
+						}
+					}
+				}
+			}
+		}
+
+		UpdateFronts( slot, affectedCount, true );
+	}
+
+	// Removes chromosome
+	void GaIncrementalDominance::Remove(int slot)
+	{
+		int dominantCount, affectedCount;
+		FindRelations( slot, dominantCount, affectedCount );
+
+		for( int i = dominantCount - 1; i >= 0; i-- )
+			_strengths[ _dominant[ i ] ]--;
+
+		for( int i = affectedCount - 1; i >= 0; i-- )
+			_dominators[ _affected[ i ] ]--;
+
+		if( _trackStrength )
+		{
+			for( int i = affectedCount - 1; i >= 0; i-- )
+				_rawFitness[ _affected[ i ] ] -= affectedCount + dominantCount;
+
+			if( dominantCount )
+			{
+				for( int i = _count - 1; i >= 0; i-- )
+				{
+					if( i != slot && !_marks[ i ] )
+					{
+						for( int j = dominantCount - 1; j >= 0; j-- )
+						{
+							if( Dominates( _dominant[ j ], i ) )
+								_rawFitness[ i ]--;
+						}
+					}
+				}
+			}
+		}
+
+		UpdateFronts( slot, affectedCount, false );
+
+		// move chromosome from the last slot to the released one
+		_members.erase( _chromosomes[ slot ] );
+		int last = --_count;
+		if( slot != last )
+		{
+			_chromosomes[ slot ] = _chromosomes[ last ];
+			std::copy( GetValues( last ), GetValues( last ) + _objectivesCount, &_values[ slot * _objectivesCount ] );
+			_fronts[ slot ] = _fronts[ last ];
+			_dominators[ slot ] = _dominators[ last ];
+			_strengths[ slot ] = _strengths[ last ];
+			_rawFitness[ slot ] = _rawFitness[ last ];
+
+			_members[ _chromosomes[ slot ] ] = slot;
+		}
+	}
+
+	// Stores chromosome in a new slot
+	int GaIncrementalDominance::Store(Population::GaChromosomeStorage* chromosome)
+	{
+		int slot = _count++;
+
+		if( _count > _chromosomes.GetSize() )
+		{
+			int size = _count * 2;
+
+			_chromosomes.SetSize( size );
+			_values.SetSize( size * _objectivesCount );
+			_fronts.SetSize( size );
+			_dominators.SetSize( size );
+			_strengths.SetSize( size );
+			_rawFitness.SetSize( size );
+			_dominant.SetSize( size );
+			_affected.SetSize( size );
+			_marks.SetSize( size, false );
+		}
+
+		const Fitness::Representation::GaMVFitnessBase& fitness =
+			(const Fitness::Representation::GaMVFitnessBase&)chromosome->GetFitness( Population::GaChromosomeStorage::GAFT_RAW );
+
+		double* values = &_values[ slot * _objectivesCount ];
+		for( int i = _objectivesCount - 1; i >= 0; i-- )
+		{
+			fitness.GetValue( i, values[ i ] );
+
+			// greater value is better when maximizing, so it should be lower
+			values[ i ] *= -_comparisonType;
+		}
+
+		_chromosomes[ slot ] = chromosome;
+		_fronts[ slot ] = _dominators[ slot ] = _strengths[ slot ] = _rawFitness[ slot ] = 0;
+		_members[ chromosome ] = slot;
+
+		return slot;
+	}
+
+	// Identifies dominating and dominated chromosomes
+	void GaIncrementalDominance::FindRelations(int slot,
+		int& dominantCount,
+		int& affectedCount)
+	{
+		dominantCount = affectedCount = 0;
+		for( int i = _count - 1; i >= 0; i-- )
+		{
+			if( i != slot )
+			{
+				int relation = Compare( i, slot );
+				if( relation < 0 )
+					_dominant[ dominantCount++ ] = i;
+				else if( relation > 0 )
+				{
+					_affected[ affectedCount++ ] = i;
+					_marks[ i ] = true;
+				}
+			}
+		}
+	}
+
+	// Recomputes fronts of affected chromosomes
+	void GaIncrementalDominance::UpdateFronts(int slot,
+		int affectedCount,
+		bool inserted)
+	{
+		int* affected = _affected.GetArray();
+
+		// fronts of dominating chromosomes must be updated first
+		std::sort( affected, affected + affectedCount, GaLexicographicalCriteria( _values.GetArray(), _objectivesCount ) );
+
+		for( int i = 0; i < affectedCount; i++ )
+		{
+			int current = affected[ i ];
+			_marks[ current ] = false;
+
+			if( inserted )
+			{
+				// fronts can only be pushed back and only by the new chromosome or by chromosomes it has pushed back
+				if( _fronts[ current ] <= _fronts[ slot ] )
+					_fronts[ current ] = _fronts[ slot ] + 1;
+
+				for( int j = i - 1; j >= 0; j-- )
+				{
+					if( _fronts[ current ] <= _fronts[ affected[ j ] ] && Dominates( affected[ j ], current ) )
+						_fronts[ current ] = _fronts[ affected[ j ] ] + 1;
+				}
+			}
+			else
+			{
+				// fronts can move forward so all remaining dominators have to be checked
+				_fronts[ current ] = 0;
+				for( int j = _count - 1; j >= 0; j-- )
+				{
+					if( j != slot && _fronts[ current ] <= _fronts[ j ] && Dominates( j, current ) )
+						_fronts[ current ] = _fronts[ j ] + 1;
+				}
+			}
+		}
+	}
+
+	// Maps chromosomes of the population to slots and groups them by fronts
+	bool GaIncrementalDominance::Export(Population::GaPopulation& population)
+	{
+		int count = population.GetCount();
+		if( count != _count )
+			return false;
+
+		_frontCount = 0;
+		_indices.SetSize( count );
+		for( int i = count - 1; i >= 0; i-- )
+		{
+			GaMembersTable::iterator it = _members.find( &population[ i ] );
+			if( it == _members.end() )
+				return false;
+
+			_indices[ i ] = it->second;
+			if( _fronts[ it->second ] >= _frontCount )
+				_frontCount = _fronts[ it->second ] + 1;
+		}
+
+		// count chromosomes in each front
+		_frontStarts.SetSize( _frontCount + 1 );
+		for( int i = _frontCount; i >= 0; i-- )
+			_frontStarts[ i ] = 0;
+
+		for( int i = count - 1; i >= 0; i-- )
+			_frontStarts[ _fronts[ _indices[ i ] ] + 1 ]++;
+
+		int* positions = _dominant.GetArray();
+		for( int i = 0; i < _frontCount; i++ )
+		{
+			_frontStarts[ i + 1 ] += _frontStarts[ i ];
+			positions[ i ] = _frontStarts[ i ];
+		}
+
+		_frontMembers.SetSize( count );
+		for( int i = 0; i < count; i++ )
+			_frontMembers[ positions[ _fronts[ _indices[ i ] ] ]++ ] = &population[ i ];
+
+		return true;
+	}
+
+} // Multiobjective
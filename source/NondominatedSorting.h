@@ -0,0 +1,606 @@
+/*! \file NondominatedSorting.h
+    \brief This file declares classes that implement fast nondominated sorting of chromosomes into pareto fronts.
+*/
+
+/*
+ *
+ * website: http://kataklinger.com/
+ * contact: me[at]kataklinger.com
+ *
+ */
+
+#ifndef __GA_NONDOMINATED_SORTING_H__
+#define __GA_NONDOMINATED_SORTING_H__
+
+#include "HashMap.h"
+#include "Population.h"
+#include "FitnessValues.h"
+
+namespace Multiobjective
+{
+
+	/// <summary>This enumeration defines algorithms that can be used to sort chromosomes into pareto fronts.</summary>
+	enum GaNondominatedSortingType
+	{
+
+		/// <summary>Operation compares all pairs of chromosomes using population's fitness comparator.</summary>
+		GANST_PAIRWISE,
+
+		/// <summary>Efficient nondominated sort with sequential search for the front to which chromosome belongs (ENS-SS).</summary>
+		GANST_ENS_SEQUENTIAL,
+
+		/// <summary>Efficient nondominated sort with binary search for the front to which chromosome belongs (ENS-BS).</summary>
+		GANST_ENS_BINARY,
+
+		/// <summary>Jensen's divide and conquer algorithm generalized to handle equal objective values.</summary>
+		GANST_DIVIDE_AND_CONQUER,
+
+		/// <summary>Best order sort. Sorting by each objective is distributed among workflow branches.</summary>
+		GANST_BEST_ORDER
+
+	};
+
+	/// <summary><c>GaNondominatedSorter</c> class sorts chromosomes of the population into pareto fronts.
+	/// Sorter extracts objective values from raw fitness objects of chromosomes, so it can only be used with fitness objects
+	/// that implement <see cref="GaMVFitnessBase::GetValue" /> method. Fronts are numbered from 0 which is the front of nondominated chromosomes.
+	///
+	/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
+	/// No public or private methods are thread-safe.</summary>
+	class GaNondominatedSorter
+	{
+
+	private:
+
+		/// <summary>Number of objectives that fitness objects have.</summary>
+		int _objectivesCount;
+
+		/// <summary>Number of sorted chromosomes.</summary>
+		int _count;
+
+		/// <summary>Number of distinct points in objective space.</summary>
+		int _uniqueCount;
+
+		/// <summary>Number of identified pareto fronts.</summary>
+		int _frontCount;
+
+		/// <summary>Type of fitness comparison used to orient objective values.</summary>
+		int _comparisonType;
+
+		/// <summary>Indicates whether the fitness objects of the population support extraction of objective values.</summary>
+		bool _supported;
+
+		/// <summary>Sorted chromosomes.</summary>
+		Common::Data::GaSingleDimensionArray<Population::GaChromosomeStorage*> _chromosomes;
+
+		/// <summary>Objective values of chromosomes stored row by row. Values are oriented so lower value is better.</summary>
+		Common::Data::GaSingleDimensionArray<double> _values;
+
+		/// <summary>Distinct points in objective space stored row by row in lexicographical order.</summary>
+		Common::Data::GaSingleDimensionArray<double> _points;
+
+		/// <summary>Indices of chromosomes sorted lexicographically by their objective values.</summary>
+		Common::Data::GaSingleDimensionArray<int> _order;
+
+		/// <summary>Index of distinct point for each chromosome in lexicographical order.</summary>
+		Common::Data::GaSingleDimensionArray<int> _groups;
+
+		/// <summary>Front to which each distinct point belongs.</summary>
+		Common::Data::GaSingleDimensionArray<int> _ranks;
+
+		/// <summary>Front to which each chromosome belongs.</summary>
+		Common::Data::GaSingleDimensionArray<int> _fronts;
+
+		/// <summary>Position of the first chromosome of each front in <c>_frontMembers</c> array.</summary>
+		Common::Data::GaSingleDimensionArray<int> _frontStarts;
+
+		/// <summary>Chromosomes grouped by fronts.</summary>
+		Common::Data::GaSingleDimensionArray<Population::GaChromosomeStorage*> _frontMembers;
+
+		/// <summary>Distinct points sorted by each objective. Used by best order sort.</summary>
+		Common::Data::GaSingleDimensionArray<int> _objectiveOrders;
+
+		/// <summary>Buffer that holds lists of points or sets processed by sorting algorithms.</summary>
+		Common::Data::GaSingleDimensionArray<int> _lists;
+
+		/// <summary>Buffer that holds links between points or partitioned sets used by sorting algorithms.</summary>
+		Common::Data::GaSingleDimensionArray<int> _links;
+
+		/// <summary>Temporary buffer used for partitioning and merging sets of points.</summary>
+		Common::Data::GaSingleDimensionArray<int> _work;
+
+		/// <summary>Temporary buffer used for selecting medians and compressing objective values.</summary>
+		Common::Data::GaSingleDimensionArray<double> _keys;
+
+	public:
+
+		/// <summary>This constructor initializes empty sorter.</summary>
+		GaNondominatedSorter() : _objectivesCount(0),
+			_count(0),
+			_uniqueCount(0),
+			_frontCount(0),
+			_comparisonType(1),
+			_supported(false) { }
+
+		/// <summary><c>Sort</c> method sorts chromosomes of the population into pareto fronts. This method must be executed by all branches of the workflow.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="population">population whose chromosomes should be sorted.</param>
+		/// <param name="type">algorithm that should be used for sorting.</param>
+		/// <param name="branch">pointer to workflow branch that executes sorting.</param>
+		/// <returns>Method returns <c>false</c> if fitness objects of the population do not support extraction of objective values
+		/// in which case chromosomes are not sorted.</returns>
+		GAL_API
+		bool GACALL Sort(Population::GaPopulation& population,
+			GaNondominatedSortingType type,
+			Common::Workflows::GaBranch* branch);
+
+		/// <summary><c>StoreValues</c> method extracts objective values from raw fitness of the chromosome.
+		/// Different threads can safely execute this method simultaneously for different chromosomes.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="chromosome">chromosome whose objective values should be extracted.</param>
+		/// <param name="index">index of chromosome in population.</param>
+		inline void GACALL StoreValues(Population::GaChromosomeStorage& chromosome,
+			int index)
+		{
+			const Fitness::Representation::GaMVFitnessBase& fitness =
+				(const Fitness::Representation::GaMVFitnessBase&)chromosome.GetFitness( Population::GaChromosomeStorage::GAFT_RAW );
+
+			double* values = &_values[ index * _objectivesCount ];
+			for( int i = _objectivesCount - 1; i >= 0; i-- )
+			{
+				fitness.GetValue( i, values[ i ] );
+
+				// greater value is better when maximizing, so it should be lower
+				values[ i ] *= -_comparisonType;
+			}
+
+			_chromosomes[ index ] = &chromosome;
+		}
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns number of identified pareto fronts.</returns>
+		inline int GACALL GetFrontCount() const { return _frontCount; }
+
+		/// <summary><c>GetFront</c> method returns pareto front to which the chromosome belongs.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="index">index of chromosome in population at the time it was sorted.</param>
+		/// <returns>Method returns index of pareto front.</returns>
+		inline int GACALL GetFront(int index) const { return _fronts[ index ]; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <param name="front">index of pareto front.</param>
+		/// <returns>Method returns number of chromosomes in specified pareto front.</returns>
+		inline int GACALL GetFrontSize(int front) const { return _frontStarts[ front + 1 ] - _frontStarts[ front ]; }
+
+		/// <summary><c>GetFrontMember</c> method returns chromosome that belongs to specified pareto front.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="front">index of pareto front.</param>
+		/// <param name="index">index of chromosome in pareto front.</param>
+		/// <returns>Method returns reference to chromosome.</returns>
+		inline Population::GaChromosomeStorage& GACALL GetFrontMember(int front,
+			int index) const { return *_frontMembers[ _frontStarts[ front ] + index ]; }
+
+	private:
+
+		/// <summary><c>Prepare</c> method prepares buffers for sorting population.</summary>
+		/// <param name="population">population whose chromosomes should be sorted.</param>
+		/// <param name="type">algorithm that will be used for sorting.</param>
+		void GACALL Prepare(Population::GaPopulation& population,
+			GaNondominatedSortingType type);
+
+		/// <summary><c>Presort</c> method sorts chromosomes lexicographically by objective values and merges chromosomes with equal values.</summary>
+		void GACALL Presort();
+
+		/// <summary><c>SortObjective</c> method sorts distinct points by a single objective. Ties are resolved by lexicographical order.</summary>
+		/// <param name="objective">index of objective.</param>
+		void GACALL SortObjective(int objective);
+
+		/// <summary><c>BuildFronts</c> method assigns fronts to chromosomes and groups chromosomes by fronts.</summary>
+		void GACALL BuildFronts();
+
+		/// <summary><c>RankEfficient</c> method implements ENS-SS and ENS-BS sorting algorithms.</summary>
+		/// <param name="binary">if this parameter is set to <c>true</c>, binary search is used to find front of the point.</param>
+		void GACALL RankEfficient(bool binary);
+
+		/// <summary><c>RankDivideAndConquer</c> method implements Jensen's divide and conquer sorting algorithm.</summary>
+		void GACALL RankDivideAndConquer();
+
+		/// <summary><c>RankBestOrder</c> method implements best order sorting algorithm. Points must be presorted by all objectives.</summary>
+		void GACALL RankBestOrder();
+
+		/// <summary><c>HelperA</c> method assigns fronts to points of a set considering the first <c>objective + 1</c> objectives.</summary>
+		/// <param name="set">set of points sorted lexicographically.</param>
+		/// <param name="size">number of points in the set.</param>
+		/// <param name="objective">index of the last objective that should be considered.</param>
+		void GACALL HelperA(int* set,
+			int size,
+			int objective);
+
+		/// <summary><c>HelperB</c> method updates fronts of points in the higher set using points in the lower set
+		/// considering the first <c>objective + 1</c> objectives.</summary>
+		/// <param name="low">set of points that can dominate points in the other set.</param>
+		/// <param name="lowSize">number of points in the lower set.</param>
+		/// <param name="high">set of points whose fronts should be updated.</param>
+		/// <param name="highSize">number of points in the higher set.</param>
+		/// <param name="objective">index of the last objective that should be considered.</param>
+		void GACALL HelperB(int* low,
+			int lowSize,
+			int* high,
+			int highSize,
+			int objective);
+
+		/// <summary><c>SweepA</c> method assigns fronts to points of a set considering only the first two objectives.</summary>
+		/// <param name="set">set of points sorted lexicographically.</param>
+		/// <param name="size">number of points in the set.</param>
+		void GACALL SweepA(const int* set,
+			int size);
+
+		/// <summary><c>SweepB</c> method updates fronts of points in the higher set using points in the lower set considering only the first two objectives.</summary>
+		/// <param name="low">set of points that can dominate points in the other set.</param>
+		/// <param name="lowSize">number of points in the lower set.</param>
+		/// <param name="high">set of points whose fronts should be updated.</param>
+		/// <param name="highSize">number of points in the higher set.</param>
+		void GACALL SweepB(const int* low,
+			int lowSize,
+			const int* high,
+			int highSize);
+
+		/// <summary><c>Split</c> method moves points which have value of objective lower then pivot to the beginning of the set preserving their order.</summary>
+		/// <param name="set">set of points that should be split.</param>
+		/// <param name="size">number of points in the set.</param>
+		/// <param name="objective">index of objective used for splitting.</param>
+		/// <param name="pivot">pivot value.</param>
+		/// <param name="inclusive">if this parameter is set to <c>true</c>, points with values equal to pivot are also moved to the beginning.</param>
+		/// <returns>Method returns number of points moved to the beginning of the set.</returns>
+		int GACALL Split(int* set,
+			int size,
+			int objective,
+			double pivot,
+			bool inclusive);
+
+		/// <summary><c>Merge</c> method merges two sorted consecutive parts of a set.</summary>
+		/// <param name="set">set whose parts should be merged.</param>
+		/// <param name="first">number of points in the first part.</param>
+		/// <param name="size">total number of points in the set.</param>
+		void GACALL Merge(int* set,
+			int first,
+			int size);
+
+		/// <summary><c>ExtractKeys</c> method copies values of specified objective of a set of points to temporary buffer.</summary>
+		/// <param name="set">set of points.</param>
+		/// <param name="size">number of points in the set.</param>
+		/// <param name="objective">index of objective.</param>
+		/// <param name="offset">position in the buffer at which the first value is stored.</param>
+		void GACALL ExtractKeys(const int* set,
+			int size,
+			int objective,
+			int offset);
+
+		/// <summary><c>Median</c> method finds median of values stored in temporary buffer.</summary>
+		/// <param name="size">number of values in the buffer.</param>
+		/// <returns>Method returns median value.</returns>
+		double GACALL Median(int size);
+
+		/// <summary><c>CompressKeys</c> method extracts values of the second objective from a set of points and stores distinct values in ascending order.</summary>
+		/// <param name="set">set of points.</param>
+		/// <param name="size">number of points in the set.</param>
+		/// <returns>Method returns number of distinct values.</returns>
+		int GACALL CompressKeys(const int* set,
+			int size);
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <param name="point">index of distinct point.</param>
+		/// <returns>Method returns pointer to objective values of the point.</returns>
+		inline const double* GACALL GetPoint(int point) const { return &_points[ point * _objectivesCount ]; }
+
+		/// <summary><c>WeaklyDominates</c> method checks whether the first point is not worse then the second in the range of objectives.</summary>
+		/// <param name="point1">index of the first point.</param>
+		/// <param name="point2">index of the second point.</param>
+		/// <param name="first">index of the first objective that should be compared.</param>
+		/// <param name="last">index of the last objective that should be compared.</param>
+		/// <param name="skip">index of objective that should not be compared.</param>
+		/// <returns>Method returns <c>true</c> if the first point is not worse in any of compared objectives.</returns>
+		inline bool GACALL WeaklyDominates(int point1,
+			int point2,
+			int first,
+			int last,
+			int skip = -1) const
+		{
+			const double* values1 = GetPoint( point1 );
+			const double* values2 = GetPoint( point2 );
+
+			for( int i = first; i <= last; i++ )
+			{
+				if( values1[ i ] > values2[ i ] && i != skip )
+					return false;
+			}
+
+			return true;
+		}
+
+		/// <summary><c>UpdateRank</c> method pushes the point to the front behind specified front if it is not already placed in later front.</summary>
+		/// <param name="point">index of point.</param>
+		/// <param name="dominantRank">front of dominant point.</param>
+		inline void GACALL UpdateRank(int point,
+			int dominantRank)
+		{
+			if( _ranks[ point ] <= dominantRank )
+				_ranks[ point ] = dominantRank + 1;
+		}
+
+	};
+
+	/// <summary><c>GaIncrementalDominance</c> class maintains dominance relations between chromosomes of the population across generations.
+	/// Structure keeps pareto front, number of dominating chromosomes, strength and raw strength fitness (sum of strengths of all dominating chromosomes)
+	/// for each chromosome and updates them when chromosomes are inserted into or removed from the population,
+	/// so the cost of update is proportional to number of replaced chromosomes rather then to the square of population size.
+	/// Like <see cref="GaNondominatedSorter" />, this structure can only be used with fitness objects
+	/// that implement <see cref="GaMVFitnessBase::GetValue" /> method. Fronts are numbered from 0 which is the front of nondominated chromosomes.
+	///
+	/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
+	/// No public or private methods are thread-safe.</summary>
+	class GaIncrementalDominance
+	{
+
+	private:
+
+		/// <summary>Type of table that maps chromosomes to slots of the structure.</summary>
+		typedef STLEXT::hash_map<Population::GaChromosomeStorage*, int> GaMembersTable;
+
+		/// <summary>Number of objectives that fitness objects have.</summary>
+		int _objectivesCount;
+
+		/// <summary>Type of fitness comparison used to orient objective values.</summary>
+		int _comparisonType;
+
+		/// <summary>Number of chromosomes stored in the structure.</summary>
+		int _count;
+
+		/// <summary>Number of identified pareto fronts.</summary>
+		int _frontCount;
+
+		/// <summary>Indicates whether the structure maintains raw strength fitness of chromosomes.</summary>
+		bool _trackStrength;
+
+		/// <summary>Indicates whether the fitness objects of the population support extraction of objective values.</summary>
+		bool _supported;
+
+		/// <summary>Indicates whether the structure is rebuilt by the current update.</summary>
+		bool _rebuilding;
+
+		/// <summary>Table that maps chromosomes to slots of the structure.</summary>
+		GaMembersTable _members;
+
+		/// <summary>Chromosome stored in each slot.</summary>
+		Common::Data::GaSingleDimensionArray<Population::GaChromosomeStorage*> _chromosomes;
+
+		/// <summary>Objective values of chromosomes stored slot by slot. Values are oriented so lower value is better.</summary>
+		Common::Data::GaSingleDimensionArray<double> _values;
+
+		/// <summary>Front to which chromosome in each slot belongs.</summary>
+		Common::Data::GaSingleDimensionArray<int> _fronts;
+
+		/// <summary>Number of chromosomes that dominate chromosome in each slot.</summary>
+		Common::Data::GaSingleDimensionArray<int> _dominators;
+
+		/// <summary>Number of chromosomes dominated by chromosome in each slot.</summary>
+		Common::Data::GaSingleDimensionArray<int> _strengths;
+
+		/// <summary>Sum of strengths of chromosomes that dominate chromosome in each slot.</summary>
+		Common::Data::GaSingleDimensionArray<int> _rawFitness;
+
+		/// <summary>Slot of each chromosome in the population at the time of the last update.</summary>
+		Common::Data::GaSingleDimensionArray<int> _indices;
+
+		/// <summary>Position of the first chromosome of each front in <c>_frontMembers</c> array.</summary>
+		Common::Data::GaSingleDimensionArray<int> _frontStarts;
+
+		/// <summary>Chromosomes grouped by fronts.</summary>
+		Common::Data::GaSingleDimensionArray<Population::GaChromosomeStorage*> _frontMembers;
+
+		/// <summary>Slots of chromosomes that dominate inserted or removed chromosome.</summary>
+		Common::Data::GaSingleDimensionArray<int> _dominant;
+
+		/// <summary>Slots of chromosomes dominated by inserted or removed chromosome.</summary>
+		Common::Data::GaSingleDimensionArray<int> _affected;
+
+		/// <summary>Marks slots of chromosomes dominated by inserted or removed chromosome.</summary>
+		Common::Data::GaSingleDimensionArray<bool> _marks;
+
+	public:
+
+		/// <summary>This constructor initializes empty structure.</summary>
+		GaIncrementalDominance() : _objectivesCount(0),
+			_comparisonType(1),
+			_count(0),
+			_frontCount(0),
+			_trackStrength(false),
+			_supported(false),
+			_rebuilding(false) { }
+
+		/// <summary><c>Update</c> method updates dominance relations using chromosomes that were inserted into and removed from the population
+		/// since the last update. Structure is rebuilt if complete update is requested, if too many chromosomes are changed
+		/// or if it does not match the population. Rebuilding is distributed among branches.
+		/// This method must be executed by all branches of the workflow.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="population">population whose chromosomes are tracked.</param>
+		/// <param name="complete">if this parameter is set to <c>true</c>, structure is rebuilt.</param>
+		/// <param name="trackStrength">if this parameter is set to <c>true</c>, structure maintains raw strength fitness of chromosomes.</param>
+		/// <param name="branch">pointer to workflow branch that executes update.</param>
+		/// <returns>Method returns <c>false</c> if fitness objects of the population do not support extraction of objective values.</returns>
+		GAL_API
+		bool GACALL Update(Population::GaPopulation& population,
+			bool complete,
+			bool trackStrength,
+			Common::Workflows::GaBranch* branch);
+
+		/// <summary><c>Clear</c> method removes all chromosomes from the structure.
+		///
+		/// This method is not thread-safe.</summary>
+		GAL_API
+		void GACALL Clear();
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns <c>true</c> if fitness objects of the population supported extraction of objective values at the time of the last update.</returns>
+		inline bool GACALL IsSupported() const { return _supported; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns number of identified pareto fronts.</returns>
+		inline int GACALL GetFrontCount() const { return _frontCount; }
+
+		/// <summary><c>GetFront</c> method returns pareto front to which the chromosome belongs.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="index">index of chromosome in population at the time of the last update.</param>
+		/// <returns>Method returns index of pareto front.</returns>
+		inline int GACALL GetFront(int index) const { return _fronts[ _indices[ index ] ]; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <param name="index">index of chromosome in population at the time of the last update.</param>
+		/// <returns>Method returns <c>true</c> if the chromosome is dominated by any other chromosome.</returns>
+		inline bool GACALL IsDominated(int index) const { return _dominators[ _indices[ index ] ] > 0; }
+
+		/// <summary><c>GetRawFitness</c> method returns sum of strengths of all chromosomes that dominate the chromosome.
+		/// Value is valid only if the structure maintains raw strength fitness.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="index">index of chromosome in population at the time of the last update.</param>
+		/// <returns>Method returns raw strength fitness of the chromosome.</returns>
+		inline int GACALL GetRawFitness(int index) const { return _rawFitness[ _indices[ index ] ]; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <param name="front">index of pareto front.</param>
+		/// <returns>Method returns number of chromosomes in specified pareto front.</returns>
+		inline int GACALL GetFrontSize(int front) const { return _frontStarts[ front + 1 ] - _frontStarts[ front ]; }
+
+		/// <summary><c>GetFrontMember</c> method returns chromosome that belongs to specified pareto front.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="front">index of pareto front.</param>
+		/// <param name="index">index of chromosome in pareto front.</param>
+		/// <returns>Method returns reference to chromosome.</returns>
+		inline Population::GaChromosomeStorage& GACALL GetFrontMember(int front,
+			int index) const { return *_frontMembers[ _frontStarts[ front ] + index ]; }
+
+	private:
+
+		/// <summary><c>Prepare</c> method applies changes of the population to the structure if only small part of the population is changed.
+		/// Otherwise it stores all chromosomes of the population in the structure and sorts them lexicographically, so they can be compared by <see cref="Rebuild" /> method.</summary>
+		/// <param name="population">population whose chromosomes are tracked.</param>
+		/// <param name="complete">if this parameter is set to <c>true</c>, structure is rebuilt.</param>
+		/// <param name="trackStrength">if this parameter is set to <c>true</c>, structure maintains raw strength fitness of chromosomes.</param>
+		/// <returns>Method returns <c>true</c> if the structure has to be rebuilt.</returns>
+		bool GACALL Prepare(Population::GaPopulation& population,
+			bool complete,
+			bool trackStrength);
+
+		/// <summary><c>Rebuild</c> method computes dominance relations between all chromosomes stored by <see cref="Prepare" /> method.
+		/// This method must be executed by all branches of the workflow.</summary>
+		/// <param name="population">population whose chromosomes are tracked.</param>
+		/// <param name="branch">pointer to workflow branch that executes rebuilding.</param>
+		void GACALL Rebuild(Population::GaPopulation& population,
+			Common::Workflows::GaBranch* branch);
+
+		/// <summary><c>Insert</c> method inserts chromosome into the structure and updates chromosomes that are dominated by it.</summary>
+		/// <param name="chromosome">chromosome that should be inserted.</param>
+		void GACALL Insert(Population::GaChromosomeStorage* chromosome);
+
+		/// <summary><c>Remove</c> method removes chromosome from the structure and updates chromosomes that were dominated by it.</summary>
+		/// <param name="slot">slot of the chromosome.</param>
+		void GACALL Remove(int slot);
+
+		/// <summary><c>Store</c> method places chromosome in a new slot and extracts its objective values.</summary>
+		/// <param name="chromosome">chromosome that should be stored.</param>
+		/// <returns>Method returns slot of the chromosome.</returns>
+		int GACALL Store(Population::GaChromosomeStorage* chromosome);
+
+		/// <summary><c>FindRelations</c> method identifies chromosomes that dominate or are dominated by the chromosome in specified slot.</summary>
+		/// <param name="slot">slot of the chromosome.</param>
+		/// <param name="dominantCount">reference to variable that receives number of dominating chromosomes.</param>
+		/// <param name="affectedCount">reference to variable that receives number of dominated chromosomes.</param>
+		void GACALL FindRelations(int slot,
+			int& dominantCount,
+			int& affectedCount);
+
+		/// <summary><c>UpdateFronts</c> method recomputes fronts of chromosomes dominated by inserted or removed chromosome.</summary>
+		/// <param name="slot">slot of inserted or removed chromosome.</param>
+		/// <param name="affectedCount">number of dominated chromosomes.</param>
+		/// <param name="inserted">if this parameter is set to <c>true</c>, chromosome is inserted, otherwise it is removed.</param>
+		void GACALL UpdateFronts(int slot,
+			int affectedCount,
+			bool inserted);
+
+		/// <summary><c>Export</c> method maps chromosomes of the population to slots and groups them by fronts.</summary>
+		/// <param name="population">population whose chromosomes are tracked.</param>
+		/// <returns>Method returns <c>false</c> if some chromosome of the population is not stored in the structure.</returns>
+		bool GACALL Export(Population::GaPopulation& population);
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <param name="slot">slot of the chromosome.</param>
+		/// <returns>Method returns pointer to objective values of the chromosome.</returns>
+		inline const double* GACALL GetValues(int slot) const { return &_values[ slot * _objectivesCount ]; }
+
+		/// <summary><c>Dominates</c> method checks whether the first chromosome dominates the second.</summary>
+		/// <param name="slot1">slot of the first chromosome.</param>
+		/// <param name="slot2">slot of the second chromosome.</param>
+		/// <returns>Method returns <c>true</c> if the first chromosome is not worse in any objective and it is better in at least one.</returns>
+		inline bool GACALL Dominates(int slot1,
+			int slot2) const
+		{
+			const double* values1 = GetValues( slot1 );
+			const double* values2 = GetValues( slot2 );
+
+			bool better = false;
+			for( int i = 0; i < _objectivesCount; i++ )
+			{
+				if( values1[ i ] > values2[ i ] )
+					return false;
+
+				if( values1[ i ] < values2[ i ] )
+					better = true;
+			}
+
+			return better;
+		}
+
+		/// <summary><c>Compare</c> method identifies dominance relation between two chromosomes.</summary>
+		/// <param name="slot1">slot of the first chromosome.</param>
+		/// <param name="slot2">slot of the second chromosome.</param>
+		/// <returns>Method returns -1 if the first chromosome dominates the second, 1 if the second dominates the first and 0 otherwise.</returns>
+		inline int GACALL Compare(int slot1,
+			int slot2) const
+		{
+			const double* values1 = GetValues( slot1 );
+			const double* values2 = GetValues( slot2 );
+
+			int result = 0;
+			for( int i = 0; i < _objectivesCount; i++ )
+			{
+				if( values1[ i ] < values2[ i ] )
+				{
+					if( result > 0 )
+						return 0;
+
+					result = -1;
+				}
+				else if( values1[ i ] > values2[ i ] )
+				{
+					if( result < 0 )
+						return 0;
+
+					result = 1;
+				}
+			}
+
+			return result;
+		}
+
+	};
+
+} // Multiobjective
+
+#endif // __GA_NONDOMINATED_SORTING_H__
@@ -13,6 +13,7 @@
 #ifndef __GA_OBJECT_POOL_H__
 #define __GA_OBJECT_POOL_H__
 
+#include <vector>
 #include "Exceptions.h"
 #include "SmartPtr.h"
 #include "AtomicList.h"
@@ -99,13 +100,67 @@ namespace Common
 
 		};
 
+		/// <summary><c>GaObjectPoolStatistics</c> struct stores statistical information about operations performed by thread-local magazines of an object pool.</summary>
+		struct GaObjectPoolStatistics
+		{
+
+			/// <summary>Number of acquired objects that were served directly from thread-local magazines.</summary>
+			long long _hits;
+
+			/// <summary>Number of acquisitions that found thread-local magazine empty.</summary>
+			long long _misses;
+
+			/// <summary>Number of times thread-local magazines were refilled with objects from the shared list.</summary>
+			long long _refills;
+
+			/// <summary>Number of times thread-local magazines were flushed to the shared list.</summary>
+			long long _flushes;
+
+			/// <summary>Number of objects created because neither magazine nor the shared list had free objects.</summary>
+			long long _created;
+
+			/// <summary>Number of objects destroyed during flush because the shared list was full.</summary>
+			long long _destroyed;
+
+			/// <summary>This constructor initializes statistics with zeros.</summary>
+			GaObjectPoolStatistics() : _hits(0),
+				_misses(0),
+				_refills(0),
+				_flushes(0),
+				_created(0),
+				_destroyed(0) { }
+
+			/// <summary><c>operator +=</c> adds values of another statistics object to this object.</summary>
+			/// <param name="rhs">statistics that should be added.</param>
+			/// <returns>Method returns reference to this object.</returns>
+			inline GaObjectPoolStatistics& GACALL operator +=(const GaObjectPoolStatistics& rhs)
+			{
+				_hits += rhs._hits;
+				_misses += rhs._misses;
+				_refills += rhs._refills;
+				_flushes += rhs._flushes;
+				_created += rhs._created;
+				_destroyed += rhs._destroyed;
+
+				return *this;
+			}
+
+		};
+
 		/// <summary><c>GaObjectPool</c> template class manages object pools. Object pools are used for recycling object to improve performace. 
 		/// Recycling only cleans and initializes only nessesry parts of object and it releases object's memory only when the pool is full and it cannot be stored or
 		/// when the pool is invalidate. Object pool uses four lifecycle control objects (creation, pereparation, cleanup and destruction objects) to menaged
 		/// life of objects used by the pool.
 		///
 		/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros
-		/// cannot be used with instances of this class. Only <c>AcquireObject</c> and <c>ReleaseObject</c> methods are thread-safe other methods are not thread-safe.</summary>
+		/// cannot be used with instances of this class. Only <c>AcquireObject</c> and <c>ReleaseObject</c> methods are thread-safe other methods are not thread-safe.
+		///
+		/// Pool can keep thread-local magazines of free objects in front of the shared list. When magazines are enabled, objects are acquired and released
+		/// without atomic operations as long as the magazine of the calling thread is neither empty nor full. Full magazine is flushed by moving half of its capacity
+		/// to the shared list using single atomic operation. Empty magazine is refilled with up to half of its capacity by popping objects from the shared list one by one,
+		/// since objects that follow the head of the list can be acquired and destroyed by other threads in the meantime. Objects cached in magazines are not counted
+		/// against size of the pool, so the pool can hold up to <c>magazine size * thread count</c> objects more then its size.
+		/// Objects cached by threads that have exited stay in their magazines until the pool is invalidated.</summary>
 		/// <typeparam name="TYPE">type of objects in the pool.</typeparam>
 		/// <typeparam name="CREATE_POLICY">type of creation policy.</typeparam>
 		/// <typeparam name="DELETE_POLICY">type of deletion policy.</typeparam>
@@ -139,8 +194,38 @@ namespace Common
 			/// <summary>Type of update policy.</summary>
 			typedef GaPoolObjectUpdate<GaType> GaUpdate;
 
+			/// <summary>Default number of objects that thread-local magazine can store.</summary>
+			static const int DEFAULT_MAGAZINE_SIZE = 32;
+
 		private:
 
+			/// <summary><c>GaMagazine</c> struct stores free objects cached by a single thread.</summary>
+			struct GaMagazine
+			{
+
+				/// <summary>Cached objects. The last object is the most recently released.</summary>
+				GaType** _objects;
+
+				/// <summary>Number of cached objects.</summary>
+				int _count;
+
+				/// <summary>Number of objects that magazine can store.</summary>
+				int _size;
+
+				/// <summary>Statistical information about operations performed by the magazine.</summary>
+				GaObjectPoolStatistics _statistics;
+
+				/// <summary>This constructor initializes empty magazine.</summary>
+				/// <param name="size">number of objects that magazine can store.</param>
+				GaMagazine(int size) : _objects(new GaType*[ size ]),
+					_count(0),
+					_size(size) { }
+
+				/// <summary>Frees memory used by the magazine. Cached objects are not destroyed.</summary>
+				~GaMagazine() { delete[] _objects; }
+
+			};
+
 			/// <summary><c>GaPoolDeletionPolicy</c> class implements deletion policy that returns object to its pool.</summary>
 			class GaPoolDeletionPolicy : public GaDeletionPolicy<GaType>
 			{
@@ -186,6 +271,18 @@ namespace Common
 			/// <summary>Pointer to object that is used by smart pointer as deletion policy.</summary>
 			GaPoolDeletionPolicy _deletionPolicy;
 
+			/// <summary>Number of objects that thread-local magazines can store. If it is 0, magazines are not used.</summary>
+			int _magazineSize;
+
+			/// <summary>Magazines of all threads that have used the pool.</summary>
+			std::vector<GaMagazine*> _magazines;
+
+			/// <summary>Protects list of magazines.</summary>
+			GA_DECLARE_SPINLOCK( _lock );
+
+			/// <summary>Thread-local slot that stores magazine of the current thread.</summary>
+			Threading::GaThreadLocalSlot _currentMagazine;
+
 		public:
 
 			/// <summary>This constructor initializes pool with all lifecycle control objects (pool takes respnsibility for memory used by these object).</summary>
@@ -203,14 +300,21 @@ namespace Common
 				_create(create),
 				_delete(del),
 				_init(init),
-				_clean(clean)
+				_clean(clean),
+				_magazineSize(0)
 			{
 				_deletionPolicy.SetPool( this );
 				SetSize( size );
 			}
 
 			/// <summary>Destorys object left in the pool.</summary>
-			~GaObjectPool() { Invalidate(); }
+			~GaObjectPool()
+			{
+				Invalidate();
+
+				for( typename std::vector<GaMagazine*>::iterator it = _magazines.begin(); it != _magazines.end(); ++it )
+					delete *it;
+			}
 
 			/// <summary><c>AcquireObject</c> returns pointer to object retrieved from the pool. The object is initialized using preparation object if it is provided.
 			/// If the pool is empty this method creates new object using provided creation object.
@@ -219,6 +323,40 @@ namespace Common
 			/// <returns>Method returns pointer to retrieved object.</returns>
 			GaType* GACALL AcquireObject()
 			{
+				if( _magazineSize > 0 )
+				{
+					GaMagazine& magazine = GetMagazine();
+
+					if( magazine._count > 0 )
+						magazine._statistics._hits++;
+					else
+					{
+						// refill empty magazine from the shared list
+						magazine._statistics._misses++;
+
+						// objects that follow the head of the list can be destroyed by other threads, so they are popped one by one
+						for( int refill = ( magazine._size + 1 ) / 2; magazine._count < refill; magazine._count++ )
+						{
+							if( !( magazine._objects[ magazine._count ] = _entries.Pop() ) )
+								break;
+						}
+
+						if( !magazine._count )
+						{
+							// create new object if the pool is empty
+							magazine._statistics._created++;
+							return _create();
+						}
+
+						magazine._statistics._refills++;
+					}
+
+					// initialize retrieved object
+					GaType* entry = magazine._objects[ --magazine._count ];
+					_init( entry );
+					return entry;
+				}
+
 				GaType* entry = _entries.Pop();
 
 				if( !entry )
@@ -259,6 +397,18 @@ namespace Common
 				// cleanup released object
 				_clean( object );
 
+				if( _magazineSize > 0 )
+				{
+					GaMagazine& magazine = GetMagazine();
+
+					// flush full magazine to the shared list
+					if( magazine._count == magazine._size )
+						Flush( magazine, ( magazine._size + 1 ) / 2 );
+
+					magazine._objects[ magazine._count++ ] = object;
+					return;
+				}
+
 				// return object to the pool if it is not full
 				if( _entries.GetCount() < _size )
 					_entries.Push( object );
@@ -267,11 +417,17 @@ namespace Common
 					_delete( object );
 			}
 
-			/// <summary><c>Invalidate</c> method destorys all objects in the pool.
+			/// <summary><c>Invalidate</c> method destorys all objects in the pool including objects cached in thread-local magazines.
 			///
-			/// This method is thread-safe.</summary>
+			/// This method is thread-safe only if magazines are not used.</summary>
 			void GACALL Invalidate()
 			{
+				for( typename std::vector<GaMagazine*>::iterator it = _magazines.begin(); it != _magazines.end(); ++it )
+				{
+					for( ; ( *it )->_count > 0; ( *it )->_count-- )
+						_delete( ( *it )->_objects[ ( *it )->_count - 1 ] );
+				}
+
 				for( GaType *entry = _entries.Clear(), *next = NULL; entry; entry = next )
 				{
 					next = _entries.GetNext( entry );
@@ -279,7 +435,7 @@ namespace Common
 				}
 			}
 
-			/// <summary><c>UpdateObjects</c> method applies changes to all objects in the pool using provided update object.
+			/// <summary><c>UpdateObjects</c> method applies changes to all objects in the pool, including objects cached in thread-local magazines, using provided update object.
 			///
 			/// This method is not thread-safe.</summary>
 			/// <param name="update">pointer to object that implements update method.</param>
@@ -287,6 +443,60 @@ namespace Common
 			{
 				for( GaType* entry = _entries.GetHead(); entry; entry = _entries.GetNext( entry ) )
 					update( entry );
+
+				for( typename std::vector<GaMagazine*>::iterator it = _magazines.begin(); it != _magazines.end(); ++it )
+				{
+					for( int i = 0; i < ( *it )->_count; i++ )
+						update( ( *it )->_objects[ i ] );
+				}
+			}
+
+			/// <summary><c>SetMagazineSize</c> method sets number of objects that thread-local magazines can store.
+			/// Objects cached in existing magazines are returned to the shared list.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="size">new size of magazines. If it is 0, magazines are not used.</param>
+			/// <exception cref="GaArgumentOutOfRangeException" />Thrown if the <c>size</c> has negative value.</exception>
+			void GACALL SetMagazineSize(int size)
+			{
+				GA_ARG_ASSERT( Exceptions::GaArgumentOutOfRangeException, size >= 0, "size", "Size cannot be negative value.", "Memory" );
+
+				for( typename std::vector<GaMagazine*>::iterator it = _magazines.begin(); it != _magazines.end(); ++it )
+				{
+					Flush( **it, ( *it )->_count );
+
+					// resize magazine
+					if( ( *it )->_size != size )
+					{
+						delete[] ( *it )->_objects;
+						( *it )->_objects = new GaType*[ size ];
+						( *it )->_size = size;
+					}
+				}
+
+				_magazineSize = size;
+			}
+
+			/// <summary>This method is not thread-safe</summary>
+			/// <returns>Method returns number of objects that thread-local magazines can store.</returns>
+			inline int GACALL GetMagazineSize() const { return _magazineSize; }
+
+			/// <summary><c>GetStatistics</c> method collects statistical information from magazines of all threads.
+			///
+			/// This method is thread-safe, but values may be stale if other threads use the pool concurrently.</summary>
+			/// <returns>Method returns statistical information about operations performed by thread-local magazines.</returns>
+			GaObjectPoolStatistics GACALL GetStatistics() const
+			{
+				GaObjectPoolStatistics statistics;
+
+				GA_LOCK( _lock );
+
+				for( typename std::vector<GaMagazine*>::const_iterator it = _magazines.begin(); it != _magazines.end(); ++it )
+					statistics += ( *it )->_statistics;
+
+				GA_UNLOCK( _lock );
+
+				return statistics;
 			}
 
 			/// <summary>This method is not thread-safe</summary>
@@ -360,6 +570,58 @@ namespace Common
 			/// <returns>Method returns reference to object that cleanup objects before they get returned to the pool.</returns>
 			inline const GaClean& GACALL GetObjectClean() const { return _clean; }
 
+		private:
+
+			/// <summary>This method is thread-safe.</summary>
+			/// <returns>Method returns magazine of the calling thread.</returns>
+			inline GaMagazine& GACALL GetMagazine()
+			{
+				GaMagazine* magazine = (GaMagazine*)_currentMagazine.GetValue();
+				return magazine ? *magazine : MakeMagazine();
+			}
+
+			/// <summary><c>MakeMagazine</c> method makes new magazine for the calling thread and stores it to thread-local slot.</summary>
+			/// <returns>Method returns reference to the new magazine.</returns>
+			GaMagazine& GACALL MakeMagazine()
+			{
+				GaMagazine* magazine = new GaMagazine( _magazineSize );
+
+				GA_LOCK( _lock );
+				_magazines.push_back( magazine );
+				GA_UNLOCK( _lock );
+
+				_currentMagazine.SetValue( magazine );
+				return *magazine;
+			}
+
+			/// <summary><c>Flush</c> method moves the oldest objects from the magazine to the shared list.
+			/// Objects that cannot be stored because the shared list is full are destroyed.</summary>
+			/// <param name="magazine">magazine that should be flushed.</param>
+			/// <param name="count">number of objects that should be flushed.</param>
+			void GACALL Flush(GaMagazine& magazine,
+				int count)
+			{
+				if( count <= 0 )
+					return;
+
+				// store as many objects as the shared list can accept
+				int free = _size - _entries.GetCount();
+				int stored = free < count ? ( free > 0 ? free : 0 ) : count;
+				_entries.PushRange( magazine._objects, stored );
+
+				// destroy the rest
+				for( int i = stored; i < count; i++ )
+					_delete( magazine._objects[ i ] );
+
+				magazine._statistics._flushes++;
+				magazine._statistics._destroyed += count - stored;
+
+				// keep the most recently released objects
+				magazine._count -= count;
+				for( int i = 0; i < magazine._count; i++ )
+					magazine._objects[ i ] = magazine._objects[ i + count ];
+			}
+
 		};
 
 	} // Memory
@@ -0,0 +1,314 @@
+/*! \file ObjectiveMatrix.cpp
+    \brief This file contains implementation of class that stores objective values of chromosomes in packed matrix and vectorized kernels that compare them.
+*/
+
+/*
+ *
+ * website: http://kataklinger.com/
+ * contact: me[at]kataklinger.com
+ *
+ */
+
+#include <cmath>
+#include "FitnessValues.h"
+#include "Population.h"
+#include "ObjectiveMatrix.h"
+
+#if defined( _M_IX86 ) || defined( _M_X64 ) || defined( __i386__ ) || defined( __x86_64__ )
+
+	#include <immintrin.h>
+
+	#define GAL_SIMD_X86
+
+	#if defined( GAL_SYNTAX_GNUC )
+
+		// GNU compiler requires instruction sets to be enabled for each function that uses them
+		#define GAL_TARGET_SSE2 __attribute__((target("sse2")))
+		#define GAL_TARGET_AVX2 __attribute__((target("avx2")))
+
+	#else
+
+		#define GAL_TARGET_SSE2
+		#define GAL_TARGET_AVX2
+
+	#endif
+
+#endif
+
+namespace Population
+{
+
+	/// <summary><c>GaDominanceResult</c> function converts results of comparison of all objectives to dominance relation.</summary>
+	/// <param name="better">indicates whether the first row has better value of at least one objective.</param>
+	/// <param name="worse">indicates whether the first row has worse value of at least one objective.</param>
+	/// <returns>Method returns -1 if the first row dominates, 1 if the second row dominates and 0 otherwise.</returns>
+	inline int GACALL GaDominanceResult(bool better,
+		bool worse) { return better == worse ? 0 : ( better ? -1 : 1 ); }
+
+	// Determines dominance using scalar code
+	static int GACALL GaDominanceScalar(const double* values1,
+		const double* values2,
+		int stride)
+	{
+		bool better = false, worse = false;
+		for( int i = 0; i < stride; i++ )
+		{
+			if( values1[ i ] < values2[ i ] )
+				better = true;
+			else if( values1[ i ] > values2[ i ] )
+				worse = true;
+
+			// neither row can dominate
+			if( better && worse )
+				return 0;
+		}
+
+		return GaDominanceResult( better, worse );
+	}
+
+	// Calculates distance using scalar code
+	static float GACALL GaDistanceScalar(const double* values1,
+		const double* values2,
+		int stride)
+	{
+		double distance = 0;
+		for( int i = 0; i < stride; i++ )
+		{
+			double difference = values1[ i ] - values2[ i ];
+			distance += difference * difference;
+		}
+
+		return (float)sqrt( distance );
+	}
+
+#if defined( GAL_SIMD_X86 )
+
+	// Determines dominance using SSE2 instructions
+	GAL_TARGET_SSE2
+	static int GACALL GaDominanceSSE2(const double* values1,
+		const double* values2,
+		int stride)
+	{
+		__m128d better = _mm_setzero_pd(), worse = _mm_setzero_pd();
+		for( int i = 0; i < stride; i += 4 )
+		{
+			__m128d a0 = _mm_load_pd( values1 + i ), b0 = _mm_load_pd( values2 + i );
+			__m128d a1 = _mm_load_pd( values1 + i + 2 ), b1 = _mm_load_pd( values2 + i + 2 );
+
+			better = _mm_or_pd( better, _mm_or_pd( _mm_cmplt_pd( a0, b0 ), _mm_cmplt_pd( a1, b1 ) ) );
+			worse = _mm_or_pd( worse, _mm_or_pd( _mm_cmpgt_pd( a0, b0 ), _mm_cmpgt_pd( a1, b1 ) ) );
+
+			// neither row can dominate
+			if( _mm_movemask_pd( better ) && _mm_movemask_pd( worse ) )
+				return 0;
+		}
+
+		return GaDominanceResult( _mm_movemask_pd( better ) != 0, _mm_movemask_pd( worse ) != 0 );
+	}
+
+	// Calculates distance using SSE2 instructions
+	GAL_TARGET_SSE2
+	static float GACALL GaDistanceSSE2(const double* values1,
+		const double* values2,
+		int stride)
+	{
+		__m128d sum0 = _mm_setzero_pd(), sum1 = _mm_setzero_pd();
+		for( int i = 0; i < stride; i += 4 )
+		{
+			__m128d d0 = _mm_sub_pd( _mm_load_pd( values1 + i ), _mm_load_pd( values2 + i ) );
+			__m128d d1 = _mm_sub_pd( _mm_load_pd( values1 + i + 2 ), _mm_load_pd( values2 + i + 2 ) );
+
+			sum0 = _mm_add_pd( sum0, _mm_mul_pd( d0, d0 ) );
+			sum1 = _mm_add_pd( sum1, _mm_mul_pd( d1, d1 ) );
+		}
+
+		sum0 = _mm_add_pd( sum0, sum1 );
+		sum0 = _mm_add_sd( sum0, _mm_unpackhi_pd( sum0, sum0 ) );
+
+		return (float)sqrt( _mm_cvtsd_f64( sum0 ) );
+	}
+
+	// Determines dominance using AVX2 instructions
+	GAL_TARGET_AVX2
+	static int GACALL GaDominanceAVX2(const double* values1,
+		const double* values2,
+		int stride)
+	{
+		__m256d better = _mm256_setzero_pd(), worse = _mm256_setzero_pd();
+		for( int i = 0; i < stride; i += 4 )
+		{
+			__m256d a = _mm256_load_pd( values1 + i ), b = _mm256_load_pd( values2 + i );
+
+			better = _mm256_or_pd( better, _mm256_cmp_pd( a, b, _CMP_LT_OQ ) );
+			worse = _mm256_or_pd( worse, _mm256_cmp_pd( a, b, _CMP_GT_OQ ) );
+
+			// neither row can dominate
+			if( _mm256_movemask_pd( better ) && _mm256_movemask_pd( worse ) )
+				return 0;
+		}
+
+		return GaDominanceResult( _mm256_movemask_pd( better ) != 0, _mm256_movemask_pd( worse ) != 0 );
+	}
+
+	// Calculates distance using AVX2 instructions
+	GAL_TARGET_AVX2
+	static float GACALL GaDistanceAVX2(const double* values1,
+		const double* values2,
+		int stride)
+	{
+		__m256d sum = _mm256_setzero_pd();
+		for( int i = 0; i < stride; i += 4 )
+		{
+			__m256d d = _mm256_sub_pd( _mm256_load_pd( values1 + i ), _mm256_load_pd( values2 + i ) );
+			sum = _mm256_add_pd( sum, _mm256_mul_pd( d, d ) );
+		}
+
+		__m128d half = _mm_add_pd( _mm256_castpd256_pd128( sum ), _mm256_extractf128_pd( sum, 1 ) );
+		half = _mm_add_sd( half, _mm_unpackhi_pd( half, half ) );
+
+		return (float)sqrt( _mm_cvtsd_f64( half ) );
+	}
+
+#endif
+
+	/// <summary><c>GaObjectiveValuesOp</c> class represents operation that copies objective values of chromosomes to packed matrix.</summary>
+	class GaObjectiveValuesOp
+	{
+
+	private:
+
+		/// <summary>Population whose values are copied.</summary>
+		const GaPopulation& _population;
+
+		/// <summary>Matrix that stores values.</summary>
+		GaObjectiveMatrix& _matrix;
+
+	public:
+
+		/// <summary>Initializes operation.</summary>
+		/// <param name="population">population whose values are copied.</param>
+		/// <param name="matrix">matrix that stores values.</param>
+		GaObjectiveValuesOp(const GaPopulation& population,
+			GaObjectiveMatrix& matrix) : _population(population),
+			_matrix(matrix) { }
+
+		/// <summary><c>operator ()</c> copies objective values of the chromosome.</summary>
+		/// <param name="chromosome">chromosome whose values should be copied.</param>
+		/// <param name="index">index of the chromosome.</param>
+		inline void GACALL operator ()(GaChromosomeStorage& chromosome,
+			int index) { _matrix.StoreValues( _population, chromosome, index ); }
+
+	};
+
+	// Copies objective values of all chromosomes
+	bool GaObjectiveMatrix::Update(GaPopulation& population,
+		Common::Workflows::GaBranch* branch,
+		const GaChromosomeStorage* reference)
+	{
+		int branchCount = branch->GetBarrierCount();
+
+		GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+			Prepare( population, reference );
+
+		if( !_ready )
+			return false;
+
+		Common::Workflows::GaParallelExec1<GaPopulation, GaChromosomeStorage> popWorkDist( *branch, population );
+		popWorkDist.Execute( GaObjectiveValuesOp( population, *this ), true );
+
+		return true;
+	}
+
+	// Copies objective values of the chromosome
+	void GaObjectiveMatrix::StoreValues(const GaPopulation& population,
+		const GaChromosomeStorage& chromosome,
+		int index) { population.GetFitnessObjectiveKeys( chromosome, _values + index * _stride, _objectivesCount ); }
+
+	// Returns kernel that determines dominance
+	GaDominanceKernel GaObjectiveMatrix::GetDominanceKernel(GaSimdInstructionSet instructionSet)
+	{
+		switch( instructionSet )
+		{
+
+#if defined( GAL_SIMD_X86 )
+
+		case GASIS_AVX2:
+			return GaDominanceAVX2;
+
+		case GASIS_SSE2:
+			return GaDominanceSSE2;
+
+#endif
+
+		default:
+			return GaDominanceScalar;
+
+		}
+	}
+
+	// Returns kernel that calculates distance
+	GaDistanceKernel GaObjectiveMatrix::GetDistanceKernel(GaSimdInstructionSet instructionSet)
+	{
+		switch( instructionSet )
+		{
+
+#if defined( GAL_SIMD_X86 )
+
+		case GASIS_AVX2:
+			return GaDistanceAVX2;
+
+		case GASIS_SSE2:
+			return GaDistanceSSE2;
+
+#endif
+
+		default:
+			return GaDistanceScalar;
+
+		}
+	}
+
+	// Allocates memory for the matrix
+	void GaObjectiveMatrix::Prepare(GaPopulation& population,
+		const GaChromosomeStorage* reference)
+	{
+		_ready = false;
+		_count = population.GetCount();
+		_objectivesCount = ( (const Fitness::Representation::GaMVFitnessParams&)population.GetFitnessParams() ).GetValueCount();
+
+		// rows are padded to multiple of 4 values so all of them are aligned on 32 bytes boundary
+		_stride = ( _objectivesCount + 3 ) & ~3;
+
+		// additional row stores reference chromosome and additional values are required to align the first row
+		int size = ( _count + 1 ) * _stride;
+		_buffer.SetSize( size + 3 );
+		_values = (double*)( ( (GaIntPtr<sizeof( double* )>::GaType)_buffer.GetArray() + 31 ) & ~(GaIntPtr<sizeof( double* )>::GaType)31 );
+
+		// padding must not affect comparison
+		for( int i = size - 1; i >= 0; i-- )
+			_values[ i ] = 0;
+
+		double* referenceRow = _values + _count * _stride;
+		if( reference )
+		{
+			if( !population.GetFitnessObjectiveKeys( *reference, referenceRow, _objectivesCount ) )
+				return;
+		}
+		else if( _count )
+		{
+			// check whether the comparator supports extraction of objective keys
+			if( !population.GetFitnessObjectiveKeys( population[ 0 ], referenceRow, _objectivesCount ) )
+				return;
+
+			for( int i = _objectivesCount - 1; i >= 0; i-- )
+				referenceRow[ i ] = 0;
+		}
+
+		GaSimdInstructionSet instructionSet = GaCpuInfo::GetInstance().GetSimdInstructionSet();
+		_dominanceKernel = GetDominanceKernel( instructionSet );
+		_distanceKernel = GetDistanceKernel( instructionSet );
+
+		_ready = true;
+	}
+
+} // Population
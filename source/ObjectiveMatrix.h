@@ -0,0 +1,196 @@
+/*! \file ObjectiveMatrix.h
+    \brief This file declares class that stores objective values of chromosomes in packed matrix and vectorized kernels that compare them.
+*/
+
+/*
+ *
+ * website: http://kataklinger.com/
+ * contact: me[at]kataklinger.com
+ *
+ */
+
+#ifndef __GA_OBJECTIVE_MATRIX_H__
+#define __GA_OBJECTIVE_MATRIX_H__
+
+#include "Array.h"
+#include "SysInfo.h"
+
+namespace Common
+{
+	namespace Workflows
+	{
+		class GaBranch;
+	} // Workflows
+} // Common
+
+namespace Population
+{
+
+	class GaChromosomeStorage;
+	class GaPopulation;
+
+	/// <summary>Type of kernel that determines pareto dominance between two rows of packed objective matrix.
+	/// Kernel returns -1 if the first row dominates the second, 1 if the second row dominates the first and 0 otherwise.</summary>
+	typedef int (GACALL *GaDominanceKernel)(const double* values1,
+		const double* values2,
+		int stride);
+
+	/// <summary>Type of kernel that calculates euclidean distance between two rows of packed objective matrix.</summary>
+	typedef float (GACALL *GaDistanceKernel)(const double* values1,
+		const double* values2,
+		int stride);
+
+	/// <summary><c>GaObjectiveMatrix</c> class stores objective values of all chromosomes in the population in a single packed matrix,
+	/// so multiobjective algorithms can determine dominance and distance between chromosomes without calling fitness comparator
+	/// and accessing fitness objects. Each row of the matrix is aligned on 32 bytes boundary and padded with zeros,
+	/// so vectorized kernels can process whole rows. Values are stored as keys extracted by fitness comparator, so lower value is always better.
+	/// Kernels that use AVX2 or SSE2 instructions are selected according to instruction sets supported by CPU
+	/// with fallback to scalar code on CPUs that do not support any of them.
+	///
+	/// Matrix can be used only if population's fitness comparator supports extraction of objective keys.
+	/// Content of the matrix is valid only until the population is changed, so it should be updated by operation that uses it.
+	///
+	/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class,
+	/// but some methods are thread-safe.</summary>
+	class GaObjectiveMatrix
+	{
+
+	private:
+
+		/// <summary>Number of objectives that fitness objects have.</summary>
+		int _objectivesCount;
+
+		/// <summary>Number of values stored in each row including padding.</summary>
+		int _stride;
+
+		/// <summary>Number of chromosomes whose values are stored in the matrix.</summary>
+		int _count;
+
+		/// <summary>Indicates whether the population's fitness comparator supports extraction of objective keys.</summary>
+		bool _ready;
+
+		/// <summary>Memory that stores the matrix.</summary>
+		Common::Data::GaSingleDimensionArray<double> _buffer;
+
+		/// <summary>Pointer to the first row of the matrix aligned on 32 bytes boundary.</summary>
+		double* _values;
+
+		/// <summary>Kernel that determines pareto dominance between rows.</summary>
+		GaDominanceKernel _dominanceKernel;
+
+		/// <summary>Kernel that calculates distance between rows.</summary>
+		GaDistanceKernel _distanceKernel;
+
+	public:
+
+		/// <summary>This constructor initializes empty matrix.</summary>
+		GaObjectiveMatrix() : _objectivesCount(0),
+			_stride(0),
+			_count(0),
+			_ready(false),
+			_values(NULL),
+			_dominanceKernel(NULL),
+			_distanceKernel(NULL) { }
+
+		/// <summary><c>Update</c> method copies objective values of all chromosomes in the population to the matrix.
+		/// This method must be executed by all branches of the workflow.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="population">population whose values should be stored.</param>
+		/// <param name="branch">pointer to workflow branch that executes update.</param>
+		/// <param name="reference">chromosome whose values should be stored in additional row at index <c>GetReferenceIndex</c>.
+		/// This parameter can be <c>NULL</c>.</param>
+		/// <returns>Method returns <c>false</c> if fitness comparator of the population does not support extraction of objective keys
+		/// in which case matrix cannot be used.</returns>
+		GAL_API
+		bool GACALL Update(GaPopulation& population,
+			Common::Workflows::GaBranch* branch,
+			const GaChromosomeStorage* reference = NULL);
+
+		/// <summary><c>StoreValues</c> method extracts objective keys from raw fitness of the chromosome and stores them in the matrix.
+		/// Different threads can safely execute this method simultaneously for different rows.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="population">population to which the chromosome belongs.</param>
+		/// <param name="chromosome">chromosome whose values should be stored.</param>
+		/// <param name="index">index of row.</param>
+		GAL_API
+		void GACALL StoreValues(const GaPopulation& population,
+			const GaChromosomeStorage& chromosome,
+			int index);
+
+		/// <summary><c>Compare</c> method determines pareto dominance between two chromosomes.
+		///
+		/// This method is thread-safe.</summary>
+		/// <param name="index1">index of the first chromosome.</param>
+		/// <param name="index2">index of the second chromosome.</param>
+		/// <returns>Method returns:
+		/// <br/>a. -1 if the first chromosome dominates the second.
+		/// <br/>b.  0 if neither of chromosomes dominates the other.
+		/// <br/>c.  1 if the second chromosome dominates the first.</returns>
+		inline int GACALL Compare(int index1,
+			int index2) const { return _dominanceKernel( GetRow( index1 ), GetRow( index2 ), _stride ); }
+
+		/// <summary><c>Distance</c> method calculates euclidean distance between objective values of two chromosomes.
+		///
+		/// This method is thread-safe.</summary>
+		/// <param name="index1">index of the first chromosome.</param>
+		/// <param name="index2">index of the second chromosome.</param>
+		/// <returns>Method returns distance between chromosomes.</returns>
+		inline float GACALL Distance(int index1,
+			int index2) const { return _distanceKernel( GetRow( index1 ), GetRow( index2 ), _stride ); }
+
+		/// <summary>This method is thread-safe.</summary>
+		/// <param name="index">index of chromosome.</param>
+		/// <returns>Method returns pointer to the row that stores objective values of the chromosome.</returns>
+		inline const double* GACALL GetRow(int index) const { return _values + index * _stride; }
+
+		/// <summary>This method is thread-safe.</summary>
+		/// <returns>Method returns index of the row that stores values of reference chromosome.</returns>
+		inline int GACALL GetReferenceIndex() const { return _count; }
+
+		/// <summary>This method is thread-safe.</summary>
+		/// <returns>Method returns <c>true</c> if the matrix stores values of chromosomes and it can be used.</returns>
+		inline bool GACALL IsReady() const { return _ready; }
+
+		/// <summary>This method is thread-safe.</summary>
+		/// <returns>Method returns number of chromosomes whose values are stored in the matrix.</returns>
+		inline int GACALL GetCount() const { return _count; }
+
+		/// <summary>This method is thread-safe.</summary>
+		/// <returns>Method returns number of objectives that fitness objects have.</returns>
+		inline int GACALL GetObjectivesCount() const { return _objectivesCount; }
+
+		/// <summary>This method is thread-safe.</summary>
+		/// <returns>Method returns number of values stored in each row including padding.</returns>
+		inline int GACALL GetStride() const { return _stride; }
+
+		/// <summary><c>GetDominanceKernel</c> method returns kernel that determines dominance using specified instruction set.
+		///
+		/// This method is thread-safe.</summary>
+		/// <param name="instructionSet">instruction set that kernel should use.</param>
+		/// <returns>Method returns pointer to kernel function.</returns>
+		GAL_API
+		static GaDominanceKernel GACALL GetDominanceKernel(GaSimdInstructionSet instructionSet);
+
+		/// <summary><c>GetDistanceKernel</c> method returns kernel that calculates distance using specified instruction set.
+		///
+		/// This method is thread-safe.</summary>
+		/// <param name="instructionSet">instruction set that kernel should use.</param>
+		/// <returns>Method returns pointer to kernel function.</returns>
+		GAL_API
+		static GaDistanceKernel GACALL GetDistanceKernel(GaSimdInstructionSet instructionSet);
+
+	private:
+
+		/// <summary><c>Prepare</c> method allocates memory for the matrix and checks whether it can be used with the population.</summary>
+		/// <param name="population">population whose values should be stored.</param>
+		/// <param name="reference">chromosome whose values should be stored in additional row.</param>
+		void GACALL Prepare(GaPopulation& population,
+			const GaChromosomeStorage* reference);
+
+	};
+
+} // Population
+
+#endif // __GA_OBJECTIVE_MATRIX_H__
@@ -43,33 +43,62 @@ namespace Multiobjective
 		{
 			Population::GaCouplingCounters counters( population, Population::GADV_SELECTION_TIME );
 
+			const GaPAESSelectionParams& params = (const GaPAESSelectionParams&)parameters;
 			Population::GaCrossoverStorageBuffer& buffer = population.GetTagByID<Population::GaPartialCrossoverBuffer>( parameters.GetCrossoverBuffersTagID() )[ branch->GetFilteredID() ];
 
+			// first generation?
+			bool first = population.GetCount() == 0;
+
 			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
 			{
 				output.Clear();
 
-				// first generation?
-				if( population.GetCount() > 0 )
+				if( first )
+				{
+					// make random solution for the first generation
+					Population::GaChromosomeStorage* chromosome = population.MakeFromPrototype();
+					output.Add( chromosome );
+					population.SetTagByID( params.GetCurrentSolutionTagID(), chromosome );
+				}
+				else
+				{
+					if( output.GetSize() < params.GetBatchSize() )
+						output.SetSize( params.GetBatchSize() );
+
+					// reserve positions for new solutions
+					output.SetCount( params.GetBatchSize() );
+				}
+			}
+
+			if( !first )
+			{
+				// each branch produces its share of new solutions
+				int start, count;
+				branch->SplitWork( params.GetBatchSize(), count, start );
+
+				Population::GaChromosomeStorage* currentSolution = population.GetTagByID<Population::GaChromosomeStorage*>( params.GetCurrentSolutionTagID() );
+				for( ; count > 0; count-- )
 				{
+					// random numbers used by mating operation are mapped to substream of the new solution
+					int index = start + count - 1;
+					branch->SelectRandomSubstream( index );
+
 					// use current solution as parent for new chromosome
-					buffer.GetParents().Add( population.GetTagByID<Population::GaChromosomeStorage*>( ( (const GaPAESSelectionParams&)parameters ).GetCurrentSolutionTagID() ) );
+					buffer.GetParents().Add( currentSolution );
 
-					// create offspring solution
+					// create offspring solution and store it at position reserved for it
 					configuration.Mate( buffer );
-					output.Add( buffer.GetOffspring().PopLast( true ) );
+					if( Population::GaChromosomeStorage* offspring = buffer.GetOffspring().PopLast( true ) )
+						output.SetAt( index, offspring );
 
 					// update statistics
 					counters.CollectCrossoverBufferCounters( buffer );
 					buffer.Clear();
 				}
-				else
-				{
-					// make random solution for the first generation
-					Population::GaChromosomeStorage* chromosome = population.MakeFromPrototype();
-					output.Add( chromosome );
-					population.SetTagByID( ( (const GaPAESSelectionParams&)parameters ).GetCurrentSolutionTagID(), chromosome );
-				}
+
+				// remove positions of solutions that were not produced
+				GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
+					output.Compact();
 			}
 
 			// update operation time and counters statistics
@@ -105,17 +134,23 @@ namespace Multiobjective
 			/// <summary>New solution that should be checked whether it should be archived.</summary>
 			Population::GaChromosomeStorage& _newSolution;
 
+			/// <summary>Packed matrix of objective values or <c>NULL</c> if fitness comparator should be used.</summary>
+			const Population::GaObjectiveMatrix* _matrix;
+
 		public:
 
 			/// <summary>Initializes operation.</summary>
 			/// <param name="population">population over whose chromosomes dominance is determined.</param>
 			/// <param name="dominance">chromosome tag that indicates dominance status of chromosome compared to others.</param>
 			/// <param name="newSolution">new solution that should be checked whether it should be archived.</param>
+			/// <param name="matrix">packed matrix of objective values whose reference row stores new solution. If this parameter is <c>NULL</c>, fitness comparator is used.</param>
 			GaPAESDominanceOp(Population::GaPopulation& population,
 				const Population::GaChromosomeTagGetter<Common::Threading::GaAtomic<int> >& dominance,
-				Population::GaChromosomeStorage& newSolution) : _population(population),
+				Population::GaChromosomeStorage& newSolution,
+				const Population::GaObjectiveMatrix* matrix = NULL) : _population(population),
 				_dominance(dominance),
-				_newSolution(newSolution) { }
+				_newSolution(newSolution),
+				_matrix(matrix) { }
 
 			/// <summary><c>operator ()</c> check whether currently archived chromosome dominates new solution.</summary>
 			/// <param name="chromosome">archived chromosome whose dominance over new solution should be checked.</param>
@@ -124,7 +159,7 @@ namespace Multiobjective
 				int index)
 			{
 				// get dominant chromosome
-				int dom = _population.CompareFitness( _newSolution, chromosome );
+				int dom = _matrix ? _matrix->Compare( _matrix->GetReferenceIndex(), index ) : _population.CompareFitness( _newSolution, chromosome );
 
 				// new solution dominates archived one?
 				if( dom < 0 )
@@ -161,6 +196,10 @@ namespace Multiobjective
 			population.GetTagManager().AddTag( params.GetCurrentSolutionTagID(), Common::Data::GaTypedTagLifecycle<Population::GaChromosomeStorage*>() );
 			population.GetTagManager().AddTag( params.GetCrowdingStorageTagID(), Common::Data::GaTypedTagLifecycle<GaCrowdingStorage>() );
 			population.GetTagManager().AddTag( params.GetHyperBoxInfoBufferTagID(), Common::Data::GaTypedTagLifecycle<Common::Grid::GaHyperBoxInfoBuffer>() );
+			if( params.GetSparseGridTagID() >= 0 )
+				population.GetTagManager().AddTag( params.GetSparseGridTagID(), Common::Data::GaTypedTagLifecycle<Common::Grid::GaSparseHyperGrid>() );
+			if( params.GetArchiveTagID() >= 0 )
+				population.GetTagManager().AddTag( params.GetArchiveTagID(), Common::Data::GaTypedTagLifecycle<GaParetoArchive>() );
 
 			GaReplacementOperation::Prepare( input, population, parameters, configuration, branchCount );
 		}
@@ -183,6 +222,10 @@ namespace Multiobjective
 			population.GetTagManager().RemoveTag( params.GetCurrentSolutionTagID() );
 			population.GetTagManager().RemoveTag( params.GetCrowdingStorageTagID() );
 			population.GetTagManager().RemoveTag( params.GetHyperBoxInfoBufferTagID() );
+			if( params.GetSparseGridTagID() >= 0 )
+				population.GetTagManager().RemoveTag( params.GetSparseGridTagID() );
+			if( params.GetArchiveTagID() >= 0 )
+				population.GetTagManager().RemoveTag( params.GetArchiveTagID() );
 
 			GaReplacementOperation::Clear( input, population, parameters, configuration, branchCount );
 		}
@@ -209,6 +252,13 @@ namespace Multiobjective
 		{
 			Population::GaOperationTime timer( population, Population::GADV_SCALING_TIME );
 
+			// use dedicated archive if it is available
+			if( parameters.GetArchiveTagID() >= 0 && ExecArchive( input, population, parameters, configuration, branch ) )
+			{
+				timer.UpdateStatistics();
+				return;
+			}
+
 			int branchID = branch->GetFilteredID();
 			int branchCount = branch->GetBarrierCount();
 
@@ -216,6 +266,8 @@ namespace Multiobjective
 			Common::Grid::GaHyperBoxInfoBuffer& hyperBoxInfoBuffer = population.GetTagByID<Common::Grid::GaHyperBoxInfoBuffer>( parameters.GetHyperBoxInfoBufferTagID() );
 			GaCrowdingStorage& crowding = population.GetTagByID<GaCrowdingStorage>( parameters.GetCrowdingStorageTagID() );
 			Population::GaChromosomeStorage* currentSolution = population.GetTagByID<Population::GaChromosomeStorage*>( parameters.GetCurrentSolutionTagID() );
+			Common::Grid::GaSparseHyperGrid* sparseGrid = parameters.GetSparseGridTagID() >= 0
+				? &population.GetTagByID<Common::Grid::GaSparseHyperGrid>( parameters.GetSparseGridTagID() ) : NULL;
 
 			Population::GaChromosomeStorage* newSolution = input.PopLast( true );
 
@@ -231,17 +283,23 @@ namespace Multiobjective
 				getDominance( newSolution ) = 0;
 
 				// update size of chromosome tag that stores coordinates of hyperbox to which the chromosome belongs
-				population.GetChromosomeTagManager().UpdateTag( parameters.GetHyperBoxTagID(),
-					Common::Grid::GaHyperBoxUpdate( ( (const Fitness::Representation::GaMVFitnessParams&)population.GetFitnessParams() ).GetValueCount() ) );
+				int objectiveCount = ( (const Fitness::Representation::GaMVFitnessParams&)population.GetFitnessParams() ).GetValueCount();
+				population.GetChromosomeTagManager().UpdateTag( parameters.GetHyperBoxTagID(), Common::Grid::GaHyperBoxUpdate( objectiveCount ) );
 
 				// update buffer sizes when population size is changed
 				int populationSize = population.GetPopulationParams().GetPopulationSize();
-				hyperBoxInfoBuffer.SetSize( populationSize, branchCount );
+				if( sparseGrid )
+					sparseGrid->SetSize( populationSize, objectiveCount );
+				else
+					hyperBoxInfoBuffer.SetSize( populationSize, branchCount );
 			}
 
+			// pack objective values of archived chromosomes and the new solution for pairwise comparison
+			const Population::GaObjectiveMatrix* matrix = population.GetObjectiveMatrix().Update( population, branch, newSolution ) ? &population.GetObjectiveMatrix() : NULL;
+
 			// determins whether the new solution should be archived and which archived chromosomes should be removed
 			Common::Workflows::GaParallelExec1<Population::GaPopulation, Population::GaChromosomeStorage> popWorkDist( *branch, population );
-			popWorkDist.Execute( GaPAESDominanceOp( population, getDominance, *newSolution ), true );
+			popWorkDist.Execute( GaPAESDominanceOp( population, getDominance, *newSolution, matrix ), true );
 
 			int dominance = getDominance( newSolution );
 
@@ -251,14 +309,27 @@ namespace Multiobjective
 				// identify hyperboxes
 				popWorkDist.Execute( GaHyperBoxOp( configuration.GetGrid(), getHyperBox ), false );
 
-				// sort archived chromosomes according to hyperbox coordinates and fill hyperbox info object buffer
-				GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
-					GaGridDensityOp( population, hyperBoxInfoBuffer, getHyperBox, getHyperBoxInfo );
-
-				// identify mostcrowded hyperbox
-				crowding[ branchID ].Clear();
-				Common::Workflows::GaParallelExec1<Common::Grid::GaHyperBoxInfoBuffer, Common::Grid::GaHyperBoxInfo> hbiWorkDist( *branch, hyperBoxInfoBuffer );
-				hbiWorkDist.Execute( GaCrowdingOp( crowding[ branchID ] ), false );
+				if( sparseGrid )
+				{
+					// place archived chromosomes into occupied hyperboxes, the most crowded hyperbox is tracked by the grid
+					GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+					{
+						sparseGrid->Clear();
+						for( int i = population.GetCount() - 1; i >= 0; i-- )
+							sparseGrid->Insert( i, getHyperBox( population[ i ] ) );
+					}
+				}
+				else
+				{
+					// sort archived chromosomes according to hyperbox coordinates and fill hyperbox info object buffer
+					GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+						GaGridDensityOp( population, hyperBoxInfoBuffer, getHyperBox, getHyperBoxInfo );
+
+					// identify mostcrowded hyperbox
+					crowding[ branchID ].Clear();
+					Common::Workflows::GaParallelExec1<Common::Grid::GaHyperBoxInfoBuffer, Common::Grid::GaHyperBoxInfo> hbiWorkDist( *branch, hyperBoxInfoBuffer );
+					hbiWorkDist.Execute( GaCrowdingOp( crowding[ branchID ] ), false );
+				}
 			}
 
 			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
@@ -266,7 +337,30 @@ namespace Multiobjective
 				// only nondominated solutions are archived
 				if( ( dominance & GaPAESDominanceOp::GAPD_DOMINATED ) == 0 )
 				{
-					if( ( dominance & GaPAESDominanceOp::GAPD_DOMINANT ) == 0 )
+					if( ( dominance & GaPAESDominanceOp::GAPD_DOMINANT ) == 0 && sparseGrid )
+					{
+						int cell = sparseGrid->GetMostCrowded();
+						int item = sparseGrid->GetFirstItem( cell );
+						Population::GaChromosomeStorage* remove = &population[ item ];
+
+						// remove archived chromosome that is located in most crowded region if population is full
+						if( population.GetCount() > population.GetPopulationParams().GetPermanentSpaceSize() )
+						{
+							// do not remove current solution if another chromosome can be removed from same hyperbox
+							if( ( remove == currentSolution || remove == newSolution ) && sparseGrid->GetCount( cell ) > 1 )
+								remove = &population[ item = sparseGrid->GetNextItem( item ) ];
+
+							// remove chromosome
+							remove->GetFlags().SetFlags( Population::GaChromosomeStorage::GACF_REMOVE_CHROMOSOME );
+							sparseGrid->Remove( item );
+						}
+
+						// accept new solution if it is located in less crowded region than current solution
+						if( ( sparseGrid->GetOccupancy( getHyperBox( newSolution ) ) < sparseGrid->GetOccupancy( getHyperBox( currentSolution ) ) ||
+							remove == currentSolution ) && remove != newSolution )
+							population.SetTagByID( parameters.GetCurrentSolutionTagID(), newSolution );
+					}
+					else if( ( dominance & GaPAESDominanceOp::GAPD_DOMINANT ) == 0 )
 					{
 						// synchronize crowding results from different branches
 						Common::Grid::GaHyperBoxInfo& hbi = hyperBoxInfoBuffer[ crowding.CalculateGlobalMaxCrowding() ];
@@ -304,5 +398,168 @@ namespace Multiobjective
 			timer.UpdateStatistics();
 		}
 
+		// Executes replacement operation using dedicated archive
+		bool GaPAES::ExecArchive(Population::GaChromosomeGroup& input,
+			Population::GaPopulation& population,
+			const GaPAESParams& parameters,
+			const GaPAESConfig& configuration,
+			Common::Workflows::GaBranch* branch) const
+		{
+			int branchCount = branch->GetBarrierCount();
+
+			// population tags
+			GaParetoArchive& archive = population.GetTagByID<GaParetoArchive>( parameters.GetArchiveTagID() );
+
+			// chromosome tags
+			Population::GaChromosomeTagGetter<Common::Grid::GaHyperBox> getHyperBox( parameters.GetHyperBoxTagID(), population.GetChromosomeTagManager() );
+
+			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+			{
+				// update size of chromosome tag that stores coordinates of hyperbox to which the chromosome belongs
+				int objectiveCount = ( (const Fitness::Representation::GaMVFitnessParams&)population.GetFitnessParams() ).GetValueCount();
+				population.GetChromosomeTagManager().UpdateTag( parameters.GetHyperBoxTagID(), Common::Grid::GaHyperBoxUpdate( objectiveCount ) );
+
+				// archive has room for one more solution then permanent space of the population, so new solution can be inserted before crowded solution is removed
+				int permanentSize = population.GetPopulationParams().GetPermanentSpaceSize();
+				if( archive.GetSize() != permanentSize + 1 || archive.GetObjectiveCount() != objectiveCount )
+					archive.SetSize( permanentSize + 1, objectiveCount );
+
+				bool supported = true;
+
+				// rebuild archive if population was changed by other operations
+				if( archive.GetCount() != population.GetCount() )
+				{
+					archive.Clear();
+					archive.BeginBatch( 1 );
+
+					for( int i = 0; i < population.GetCount(); i++ )
+					{
+						Population::GaChromosomeStorage& chromosome = population[ i ];
+						if( !( supported = population.GetFitnessObjectiveKeys( chromosome, archive.GetBatchValues( 0 ), objectiveCount ) ) )
+							break;
+
+						configuration.GetGrid().GetHyperBox( chromosome.GetFitness( Population::GaChromosomeStorage::GAFT_RAW ), getHyperBox( chromosome ) );
+
+						// remove dominated chromosomes
+						if( archive.Insert( &chromosome, archive.GetBatchValues( 0 ), getHyperBox( chromosome ) ) < 0 )
+							chromosome.GetFlags().SetFlags( Population::GaChromosomeStorage::GACF_REMOVE_CHROMOSOME );
+						for( int j = archive.GetRemovedCount() - 1; j >= 0; j-- )
+							archive.GetRemoved( j )->GetFlags().SetFlags( Population::GaChromosomeStorage::GACF_REMOVE_CHROMOSOME );
+
+						// remove chromosomes located in the most crowded region that cannot fit permanent space
+						if( archive.GetCount() > permanentSize )
+						{
+							int item = archive.GetGrid().GetFirstItem( archive.GetGrid().GetMostCrowded() );
+							archive.GetChromosome( item )->GetFlags().SetFlags( Population::GaChromosomeStorage::GACF_REMOVE_CHROMOSOME );
+							archive.Remove( item );
+						}
+					}
+
+					// current solution has to be archived
+					Population::GaChromosomeStorage* currentSolution = population.GetTagByID<Population::GaChromosomeStorage*>( parameters.GetCurrentSolutionTagID() );
+					if( supported && archive.GetCount() > 0 && currentSolution->GetFlags().IsFlagSetAny( Population::GaChromosomeStorage::GACF_REMOVE_CHROMOSOME ) )
+						population.SetTagByID( parameters.GetCurrentSolutionTagID(), archive.GetChromosome( archive.GetGrid().GetFirstItem( archive.GetGrid().GetMostCrowded() ) ) );
+
+					population.Remove();
+				}
+
+				// extract objective keys of new solutions
+				archive.BeginBatch( supported ? input.GetCount() : 0 );
+				for( int i = archive.GetBatchCount() - 1; i >= 0; i-- )
+				{
+					if( !population.GetFitnessObjectiveKeys( input[ i ], archive.GetBatchValues( i ), objectiveCount ) )
+					{
+						archive.BeginBatch( 0 );
+						break;
+					}
+				}
+
+				// archive is rebuilt next time it is used
+				if( !archive.GetBatchCount() )
+					archive.Clear();
+			}
+
+			// fitness comparator cannot extract objective keys
+			if( !archive.GetBatchCount() )
+				return false;
+
+			// identify hyperboxes of new solutions and filter out those dominated by archived chromosomes
+			int start, count;
+			branch->SplitWork( archive.GetBatchCount(), count, start );
+			for( int i = start + count - 1; i >= start; i-- )
+			{
+				configuration.GetGrid().GetHyperBox( input[ i ].GetFitness( Population::GaChromosomeStorage::GAFT_RAW ), getHyperBox( input[ i ] ) );
+				archive.Filter( i );
+			}
+
+			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+			{
+				Population::GaChromosomeStorage* currentSolution = population.GetTagByID<Population::GaChromosomeStorage*>( parameters.GetCurrentSolutionTagID() );
+				const Common::Grid::GaSparseHyperGrid& grid = archive.GetGrid();
+
+				// archive new solutions one by one
+				for( int i = 0; i < archive.GetBatchCount(); i++ )
+				{
+					Population::GaChromosomeStorage* newSolution = &input[ i ];
+
+					// new solution is dominated - discard it
+					int entry = archive.IsFiltered( i ) ? -1 : archive.Insert( newSolution, archive.GetBatchValues( i ), getHyperBox( newSolution ) );
+					if( entry < 0 )
+					{
+						population.ReleaseStorageObject( newSolution );
+						continue;
+					}
+
+					// make room for new solution by removing chromosomes that are marked for removal
+					if( population.GetCount() == population.GetPopulationParams().GetPopulationSize() )
+						population.Remove();
+
+					population.Insert( newSolution );
+
+					if( archive.GetRemovedCount() > 0 )
+					{
+						// remove archived chromosomes dominated by new solution
+						for( int j = archive.GetRemovedCount() - 1; j >= 0; j-- )
+							archive.GetRemoved( j )->GetFlags().SetFlags( Population::GaChromosomeStorage::GACF_REMOVE_CHROMOSOME );
+
+						// new solution was dominant over some archived chromosome - accept it as current solution
+						currentSolution = newSolution;
+					}
+					else
+					{
+						Population::GaChromosomeStorage* remove = NULL;
+
+						// remove archived chromosome that is located in most crowded region if population is full
+						if( archive.GetCount() > population.GetPopulationParams().GetPermanentSpaceSize() )
+						{
+							int cell = grid.GetMostCrowded();
+							int item = grid.GetFirstItem( cell );
+
+							// do not remove current solution if another chromosome can be removed from same hyperbox
+							if( ( archive.GetChromosome( item ) == currentSolution || item == entry ) && grid.GetCount( cell ) > 1 )
+								item = grid.GetNextItem( item );
+
+							// remove chromosome
+							remove = archive.GetChromosome( item );
+							remove->GetFlags().SetFlags( Population::GaChromosomeStorage::GACF_REMOVE_CHROMOSOME );
+							archive.Remove( item );
+						}
+
+						// accept new solution if it is located in less crowded region than current solution
+						if( ( remove == currentSolution || grid.GetOccupancy( getHyperBox( newSolution ) ) < grid.GetOccupancy( getHyperBox( currentSolution ) ) ) && remove != newSolution )
+							currentSolution = newSolution;
+					}
+				}
+
+				population.SetTagByID( parameters.GetCurrentSolutionTagID(), currentSolution );
+
+				// remove chromosomes from population that were removed from archive
+				population.Remove();
+				input.Clear( true );
+			}
+
+			return true;
+		}
+
 	} // PAES
 } // Multiobjective
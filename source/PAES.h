@@ -16,6 +16,7 @@
 #include "Population.h"
 #include "FitnessValues.h"
 #include "Multiobjective.h"
+#include "ParetoArchive.h"
 
 namespace Multiobjective
 {
@@ -96,18 +97,24 @@ namespace Multiobjective
 			/// <summary>ID of population tag that stores chromosome that represents current solution used to continue the search.</summary>
 			int _currentSolutionTagID;
 
+			/// <summary>Number of new solutions produced from current solution in each generation.</summary>
+			int _batchSize;
+
 		public:
 
 			/// <summary>This constructor initializes parameters with used-defined values.</summary>
 			/// <param name="currentSolutionTagID">ID of population tag that stores chromosome that represents current solution used to continue the search.</param>
 			/// <param name="crossoverBuffersTagID">ID of the tag that stores crossover buffers.
 			/// This parameter should be set to negative value if selection operation should not produce offspring chromosomes.</param>
+			/// <param name="batchSize">number of new solutions produced from current solution in each generation.</param>
 			GaPAESSelectionParams(int currentSolutionTagID,
-				int crossoverBuffersTagID) : GaSelectionParams(1, crossoverBuffersTagID),
-				_currentSolutionTagID(currentSolutionTagID) { }
+				int crossoverBuffersTagID,
+				int batchSize = 1) : GaSelectionParams(1, crossoverBuffersTagID),
+				_currentSolutionTagID(currentSolutionTagID) { SetBatchSize( batchSize ); }
 
 			/// <summary>This constructor initializes parameters without specifing any tags.</summary>
-			GaPAESSelectionParams() : _currentSolutionTagID(-1) { }
+			GaPAESSelectionParams() : _currentSolutionTagID(-1),
+				_batchSize(1) { }
 
 			/// <summary>More details are given in specification of <see cref="GaParameters::Clone" /> method.</summary>
 			virtual Common::GaParameters* GACALL Clone() const { return new GaPAESSelectionParams( *this ); }
@@ -122,6 +129,23 @@ namespace Multiobjective
 			/// <returns>Method returns ID of population tag that stores chromosome that represents current solution used to continue the search.</returns>
 			inline int GACALL GetCurrentSolutionTagID() const { return _currentSolutionTagID; }
 
+			/// <summary><c>SetBatchSize</c> method sets number of new solutions produced from current solution in each generation.
+			/// New solutions are produced concurrently by workflow branches. Batches of more then one solution are processed by <see cref="GaPAES" />
+			/// only when it uses dedicated archive, otherwise only the last solution is considered.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="size">number of new solutions.</param>
+			/// <exception cref="GaArgumentOutOfRangeException" />Thrown if <c>size</c> is negative value or 0.</exception>
+			inline void GACALL SetBatchSize(int size)
+			{
+				GA_ARG_ASSERT( Common::Exceptions::GaArgumentOutOfRangeException, size > 0, "size", "Number of new solutions must be greater then 0.", "Multiobjective" );
+				_batchSize = size;
+			}
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns number of new solutions produced from current solution in each generation.</returns>
+			inline int GACALL GetBatchSize() const { return _batchSize; }
+
 		};
 
 		/// <summary><c>GaPAESSelection</c> class represents selection operation that produces new solutions for Pareto Archived Evolution Strategy.
@@ -178,6 +202,12 @@ namespace Multiobjective
 			/// <summary>ID of population tag that stores currently most crowded hyperboxes.</summary>
 			int _crowdingStorageTagID;
 
+			/// <summary>ID of population tag that stores sparse hypergrid. Hyperboxes are found by sorting archived chromosomes if ID is negative.</summary>
+			int _sparseGridTagID;
+
+			/// <summary>ID of population tag that stores dedicated archive of nondominated solutions. Archive is not used if ID is negative.</summary>
+			int _archiveTagID;
+
 		public:
 
 			/// <summary>This constructor initializes parameters with used-defined values.</summary>
@@ -187,17 +217,23 @@ namespace Multiobjective
 			/// <param name="hyperBoxInfoBufferTagID">ID of population tag that stores hyperbox info objects.</param>
 			/// <param name="currentSolutionTagID">ID of population tag that stores chromosome that represents current solution used to continue the search</param>
 			/// <param name="crowdingStorageTagID">ID of population tag that stores currently most crowded hyperboxes.</param>
+			/// <param name="sparseGridTagID">ID of population tag that stores sparse hypergrid.</param>
+			/// <param name="archiveTagID">ID of population tag that stores dedicated archive of nondominated solutions.</param>
 			GaPAESParams(int dominanceTagID,
 				int hyperBoxTagID,
 				int hyperBoxInfoTagID,
 				int hyperBoxInfoBufferTagID,
 				int currentSolutionTagID,
-				int crowdingStorageTagID) : _dominanceTagID(dominanceTagID),
+				int crowdingStorageTagID,
+				int sparseGridTagID = -1,
+				int archiveTagID = -1) : _dominanceTagID(dominanceTagID),
 				_hyperBoxTagID(hyperBoxTagID),
 				_hyperBoxInfoTagID(hyperBoxInfoTagID),
 				_hyperBoxInfoBufferTagID(hyperBoxInfoBufferTagID),
 				_currentSolutionTagID(currentSolutionTagID),
-				_crowdingStorageTagID(crowdingStorageTagID) { }
+				_crowdingStorageTagID(crowdingStorageTagID),
+				_sparseGridTagID(sparseGridTagID),
+				_archiveTagID(archiveTagID) { }
 
 			/// <summary>This constructor initializes parameters without specifing any tags.</summary>
 			GaPAESParams() : _dominanceTagID(-1),
@@ -205,7 +241,9 @@ namespace Multiobjective
 				_hyperBoxInfoTagID(-1),
 				_hyperBoxInfoBufferTagID(-1),
 				_currentSolutionTagID(-1),
-				_crowdingStorageTagID(-1) { }
+				_crowdingStorageTagID(-1),
+				_sparseGridTagID(-1),
+				_archiveTagID(-1) { }
 
 			/// <summary>More details are given in specification of <see cref="GaParameters::Clone" /> method.
 			///
@@ -273,6 +311,31 @@ namespace Multiobjective
 			/// <returns>Method returns ID of population tag that stores currently most crowded hyperboxes.</returns>
 			inline int GACALL GetCrowdingStorageTagID() const { return _crowdingStorageTagID; }
 
+			/// <summary><c>SetSparseGridTagID</c> method sets population tag that stores sparse hypergrid.
+			/// When the tag is set, archived chromosomes are placed into hash table of occupied hyperboxes instead of being sorted by their hyperboxes,
+			/// so hyperbox info buffer and crowding storage are not used.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="tagID">ID of the tag. Negative value disables sparse hypergrid.</param>
+			inline void GACALL SetSparseGridTagID(int tagID) { _sparseGridTagID = tagID; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns ID of population tag that stores sparse hypergrid.</returns>
+			inline int GACALL GetSparseGridTagID() const { return _sparseGridTagID; }
+
+			/// <summary><c>SetArchiveTagID</c> method sets population tag that stores dedicated archive of nondominated solutions.
+			/// When the tag is set, new solutions are filtered against archive that indexes objective values of archived chromosomes and tracks crowding of hyperboxes,
+			/// so archived chromosomes do not have to be compared and placed into hyperboxes in each generation. The archive requires fitness comparator
+			/// that can extract objective keys, otherwise archived chromosomes are compared as if the tag is not set.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="tagID">ID of the tag. Negative value disables the archive.</param>
+			inline void GACALL SetArchiveTagID(int tagID) { _archiveTagID = tagID; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns ID of population tag that stores dedicated archive of nondominated solutions.</returns>
+			inline int GACALL GetArchiveTagID() const { return _archiveTagID; }
+
 		};
 
 		/// <summary><c>GaPAESConfig</c> class represents configuration for implementation of Pareto Archived Evolution Strategy.
@@ -386,6 +449,16 @@ namespace Multiobjective
 				const GaPAESConfig& configuration,
 				Common::Workflows::GaBranch* branch) const;
 
+			/// <summary><c>ExecArchive</c> method executes operation using dedicated archive of nondominated solutions.
+			/// Paramenters has same meaning that is defined by <c>operator ()</c>.</summary>
+			/// <returns>Method returns <c>false</c> if fitness comparator cannot extract objective keys so the archive cannot be used.</returns>
+			GAL_API
+			bool GACALL ExecArchive(Population::GaChromosomeGroup& input,
+				Population::GaPopulation& population,
+				const GaPAESParams& parameters,
+				const GaPAESConfig& configuration,
+				Common::Workflows::GaBranch* branch) const;
+
 		};
 
 	} // PAES
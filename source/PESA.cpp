@@ -30,14 +30,20 @@ namespace Multiobjective
 			/// <summary>Chromosome tag that stores information whether the chromosome is dominated by any other chromosome in the population.</summary>
 			Population::GaChromosomeTagGetter<int> _dominated;
 
+			/// <summary>Packed matrix of objective values or <c>NULL</c> if fitness comparator should be used.</summary>
+			const Population::GaObjectiveMatrix* _matrix;
+
 		public:
 
 			/// <summary>Initializes operation.</summary>
 			/// <param name="population">population over whose chromosomes dominance is determined.</param>
 			/// <param name="dominated">chromosome tag that stores information whether the chromosome is dominated by any other chromosome.</param>
+			/// <param name="matrix">packed matrix of objective values. If this parameter is <c>NULL</c>, fitness comparator is used.</param>
 			GaPESADominanceOp(Population::GaPopulation& population,
-				const Population::GaChromosomeTagGetter<int>& dominated) : _population(population),
-				_dominated(dominated)  { }
+				const Population::GaChromosomeTagGetter<int>& dominated,
+				const Population::GaObjectiveMatrix* matrix = NULL) : _population(population),
+				_dominated(dominated),
+				_matrix(matrix) { }
 
 			/// <summary><c>operator ()</c> operators determins dominated chromosome and marks it.</summary>
 			/// <param name="chromosome1">the first chromosomes that is checked.</param>
@@ -53,7 +59,7 @@ namespace Multiobjective
 				if( !_dominated( chromosome1 ) || !_dominated( chromosome2 ) )
 				{
 					// get dominant chromosome
-					int dom = _population.CompareFitness( chromosome1, chromosome2 );
+					int dom = _matrix ? _matrix->Compare( index1, index2 ) : _population.CompareFitness( chromosome1, chromosome2 );
 
 					// the first one is dominant
 					if( dom < 0 )
@@ -112,9 +118,15 @@ namespace Multiobjective
 			/// <summary>Chromosome tag that stores information whether the chromosome is dominated by any other chromosome in the population.</summary>
 			Population::GaChromosomeTagGetter<int> _dominated;
 
+			/// <summary>Chromosome tag that contains coordinates of hyperbox to which the chromosome belongs.</summary>
+			Population::GaChromosomeTagGetter<Common::Grid::GaHyperBox> _hyperBox;
+
 			/// <summary>Chromosome tag that references info object of hyperbox to which the chromosome belongs.</summary>
 			Population::GaChromosomeTagGetter<Common::Grid::GaHyperBoxInfo*> _hyperBoxInfo;
 
+			/// <summary>Sparse hypergrid that stores occupancy of hyperboxes or <c>NULL</c> if hyperbox info objects should be used.</summary>
+			const Common::Grid::GaSparseHyperGrid* _sparseGrid;
+
 			/// <summary>Indicates whether the sharing of fitness for a region (hyperbox) should be engaged.</summary>
 			bool _regionSharing;
 
@@ -122,12 +134,18 @@ namespace Multiobjective
 
 			/// <summary>Initializes operation.</summary>
 			/// <param name="dominated">chromosome tag that stores information whether the chromosome is dominated by any other chromosome in the population.</param>
+			/// <param name="hyperBox">chromosome tag that contains coordinates of hyperbox to which the chromosome belongs.</param>
 			/// <param name="hyperBoxInfo">chromosome tag that references info object of hyperbox to which the chromosome belongs</param>
+			/// <param name="sparseGrid">sparse hypergrid that stores occupancy of hyperboxes. If this parameter is <c>NULL</c>, hyperbox info objects are used.</param>
 			/// <param name="regionSharing">if this parameters is set to <c>true</c> chromosomes in same region (hyperbox) share fitness value.</param>
 			GaPESAFitnessAssignOp(const Population::GaChromosomeTagGetter<int>& dominated,
+				const Population::GaChromosomeTagGetter<Common::Grid::GaHyperBox>& hyperBox,
 				const Population::GaChromosomeTagGetter<Common::Grid::GaHyperBoxInfo*>& hyperBoxInfo,
+				const Common::Grid::GaSparseHyperGrid* sparseGrid,
 				bool regionSharing) : _dominated(dominated),
+				_hyperBox(hyperBox),
 				_hyperBoxInfo(hyperBoxInfo),
+				_sparseGrid(sparseGrid),
 				_regionSharing(regionSharing) { }
 
 			/// <summary><c>operator ()</c> calculates and assigns scaled fitness value to chromosome.</summary>
@@ -141,11 +159,17 @@ namespace Multiobjective
 				// only nondomnated chromosomes have scaled fitness other then 0
 				if( !_dominated( chromosome ) )
 				{
-					Common::Grid::GaHyperBoxInfo* info = _hyperBoxInfo( chromosome );
-					if( info )
+					// get number of chromosomes in same hyperbox
+					int count = 0;
+					if( _sparseGrid )
+						count = _sparseGrid->GetOccupancy( _hyperBox( chromosome ) );
+					else if( Common::Grid::GaHyperBoxInfo* info = _hyperBoxInfo( chromosome ) )
+						count = info->GetCount();
+
+					if( count > 0 )
 					{
-						// get number of chromosomes in same hyperbox and use sharing if required
-						int value = _regionSharing ? info->GetCount() * info->GetCount() : info->GetCount();
+						// use sharing if required
+						int value = _regionSharing ? count * count : count;
 
 						// assign fitness
 						fitness.SetValue( 1.0f / value );
@@ -176,6 +200,8 @@ namespace Multiobjective
 			population.GetTagManager().AddTag( params.GetNondominatedTagID(), Common::Data::GaTypedTagLifecycle<Population::GaChromosomeGroup>() );
 			population.GetTagManager().AddTag( params.GetCrowdingStorageTagID(), Common::Data::GaTypedTagLifecycle<GaCrowdingStorage>() );
 			population.GetTagManager().AddTag( params.GetHyperBoxInfoBufferTagID(), Common::Data::GaTypedTagLifecycle<Common::Grid::GaHyperBoxInfoBuffer>() );
+			if( params.GetSparseGridTagID() >= 0 )
+				population.GetTagManager().AddTag( params.GetSparseGridTagID(), Common::Data::GaTypedTagLifecycle<Common::Grid::GaSparseHyperGrid>() );
 
 			GaScalingOperation::Prepare( population, parameters, configuration, branchCount );
 		}
@@ -197,6 +223,8 @@ namespace Multiobjective
 			population.GetTagManager().RemoveTag( params.GetCrowdingStorageTagID() );
 			population.GetTagManager().RemoveTag( params.GetNondominatedTagID() );
 			population.GetTagManager().RemoveTag( params.GetHyperBoxInfoBufferTagID() );
+			if( params.GetSparseGridTagID() >= 0 )
+				population.GetTagManager().RemoveTag( params.GetSparseGridTagID() );
 
 			GaScalingOperation::Clear( population, parameters, configuration, branchCount );
 		}
@@ -228,20 +256,27 @@ namespace Multiobjective
 			Population::GaChromosomeGroup& nondminated = population.GetTagByID<Population::GaChromosomeGroup>( parameters.GetNondominatedTagID() );
 			Common::Grid::GaHyperBoxInfoBuffer& hyperBoxInfoBuffer = population.GetTagByID<Common::Grid::GaHyperBoxInfoBuffer>( parameters.GetHyperBoxInfoBufferTagID() );
 			GaCrowdingStorage& crowding = population.GetTagByID<GaCrowdingStorage>( parameters.GetCrowdingStorageTagID() );
+			Common::Grid::GaSparseHyperGrid* sparseGrid = parameters.GetSparseGridTagID() >= 0
+				? &population.GetTagByID<Common::Grid::GaSparseHyperGrid>( parameters.GetSparseGridTagID() ) : NULL;
 
 			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
 			{
 				// mark population as re-scaled
 				population.GetFlags().SetFlags( Population::GaPopulation::GAPF_COMPLETE_SCALED_FITNESS_UPDATE );
+				population.MarkModified();
 
 				// update size of chromosome tag that stores coordinates of hyperbox to which the chromosome belongs
-				population.GetChromosomeTagManager().UpdateTag( parameters.GetHyperBoxTagID(),
-					Common::Grid::GaHyperBoxUpdate( ( (const Fitness::Representation::GaMVFitnessParams&)population.GetFitnessParams() ).GetValueCount() ) );
+				int objectiveCount = ( (const Fitness::Representation::GaMVFitnessParams&)population.GetFitnessParams() ).GetValueCount();
+				population.GetChromosomeTagManager().UpdateTag( parameters.GetHyperBoxTagID(), Common::Grid::GaHyperBoxUpdate( objectiveCount ) );
 
 				// update buffer sizes when population size is changed
 				int populationSize = population.GetPopulationParams().GetPopulationSize();
 				nondminated.SetSize( populationSize );
-				hyperBoxInfoBuffer.SetSize( populationSize, branchCount );
+
+				if( sparseGrid )
+					sparseGrid->SetSize( populationSize, objectiveCount );
+				else
+					hyperBoxInfoBuffer.SetSize( populationSize, branchCount );
 
 				nondminated.Clear();
 				crowding.RestartGlobalMaxCrowding();
@@ -258,49 +293,82 @@ namespace Multiobjective
 			Common::Workflows::GaParallelExec1<Population::GaPopulation, Population::GaChromosomeStorage> popWorkDist( *branch, population );
 			Common::Workflows::GaParallelExec2<Population::GaPopulation, Population::GaChromosomeStorage> domWorkDist( *branch, population );
 
+			// pack objective values of chromosomes for pairwise comparison
+			const Population::GaObjectiveMatrix* matrix = population.GetObjectiveMatrix().Update( population, branch ) ? &population.GetObjectiveMatrix() : NULL;
+
 			// identify hyperboxes and nondominated chromosomes
-			domWorkDist.Execute( GaHyperBoxOp( configuration.GetGrid(), getHyperBox ), GaPESADominanceOp( population, getDominated ), true );
+			domWorkDist.Execute( GaHyperBoxOp( configuration.GetGrid(), getHyperBox ), GaPESADominanceOp( population, getDominated, matrix ), true );
 			popWorkDist.Execute( GaPESAFrontOp( getDominated, nondminated ), true );
 
-			// sort nondominated chromosomes according to hyperbox coordinates and fill hyperbox info object buffer
-			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
-				GaGridDensityOp( nondminated, hyperBoxInfoBuffer, getHyperBox, getHyperBoxInfo );
-
-			Common::Workflows::GaParallelExec1<Common::Grid::GaHyperBoxInfoBuffer, Common::Grid::GaHyperBoxInfo> hbiWorkDist( *branch, hyperBoxInfoBuffer );
-
-			// select chromosome in most crowded hyperboxes which should be removed
 			int requiredCount = population.GetPopulationParams().GetPermanentSpaceSize();
-			for( int nondominatedCount = nondminated.GetCount(); nondominatedCount > requiredCount; nondominatedCount-- )
+
+			if( sparseGrid )
 			{
-				// has the chromosome from hyperbox selected by this branch been removed?
-				if( crowding.RequiresUpdate( branchID ) )
+				GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
 				{
-					// yes - branch should search again for most crowded hyperbox
-					maxCrowd.Clear();
-					hbiWorkDist.Execute( GaCrowdingOp( maxCrowd ), false );
-				}
+					// chromosomes that are removed should not depend on the branch which performs removal
+					branch->SelectSharedRandomSubstream();
+
+					// place nondominated chromosomes into occupied hyperboxes
+					sparseGrid->Clear();
+					for( int i = nondminated.GetCount() - 1; i >= 0; i-- )
+						sparseGrid->Insert( i, getHyperBox( nondminated[ i ] ) );
+
+					// remove random chromosome from the most crowded hyperbox until the archive is small enough
+					for( int nondominatedCount = nondminated.GetCount(); nondominatedCount > requiredCount; nondominatedCount-- )
+					{
+						int cell = sparseGrid->GetMostCrowded();
+						int item = sparseGrid->GetItem( cell, GaGlobalRandomIntegerGenerator->Generate( 0, sparseGrid->GetCount( cell ) - 1 ) );
 
+						nondminated[ item ].GetFlags().SetFlags( Population::GaChromosomeStorage::GACF_REMOVE_CHROMOSOME );
+						sparseGrid->Remove( item );
+					}
+				}
+			}
+			else
+			{
+				// sort nondominated chromosomes according to hyperbox coordinates and fill hyperbox info object buffer
 				GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+					GaGridDensityOp( nondminated, hyperBoxInfoBuffer, getHyperBox, getHyperBoxInfo );
+
+				Common::Workflows::GaParallelExec1<Common::Grid::GaHyperBoxInfoBuffer, Common::Grid::GaHyperBoxInfo> hbiWorkDist( *branch, hyperBoxInfoBuffer );
+
+				// select chromosome in most crowded hyperboxes which should be removed
+				for( int nondominatedCount = nondminated.GetCount(); nondominatedCount > requiredCount; nondominatedCount-- )
 				{
-					// get most crowded hyperbox
-					Common::Grid::GaHyperBoxInfo& hb = hyperBoxInfoBuffer[ crowding.CalculateGlobalMaxCrowding() ];
-					Population::GaChromosomeStorage* chromosome = NULL;
-					
-					// remove random chromosome from the hyperbox
-					do
+					// has the chromosome from hyperbox selected by this branch been removed?
+					if( crowding.RequiresUpdate( branchID ) )
 					{
-						chromosome = &nondminated[ GaGlobalRandomIntegerGenerator->Generate( hb.GetStart(), hb.GetEnd() ) ];
-					} while( chromosome->GetFlags().IsFlagSetAny( Population::GaChromosomeStorage::GACF_REMOVE_CHROMOSOME ) );
+						// yes - branch should search again for most crowded hyperbox
+						maxCrowd.Clear();
+						hbiWorkDist.Execute( GaCrowdingOp( maxCrowd ), false );
+					}
 
-					// mark chromosome for removing
-					chromosome->GetFlags().SetFlags( Population::GaChromosomeStorage::GACF_REMOVE_CHROMOSOME );
+					GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+					{
+						// chromosomes that are removed should not depend on the branch which performs removal
+						branch->SelectSharedRandomSubstream( nondominatedCount );
 
-					hb.RemoveItem();
+						// get most crowded hyperbox
+						Common::Grid::GaHyperBoxInfo& hb = hyperBoxInfoBuffer[ crowding.CalculateGlobalMaxCrowding() ];
+						Population::GaChromosomeStorage* chromosome = NULL;
+					
+						// remove random chromosome from the hyperbox
+						do
+						{
+							chromosome = &nondminated[ GaGlobalRandomIntegerGenerator->Generate( hb.GetStart(), hb.GetEnd() ) ];
+						} while( chromosome->GetFlags().IsFlagSetAny( Population::GaChromosomeStorage::GACF_REMOVE_CHROMOSOME ) );
+
+						// mark chromosome for removing
+						chromosome->GetFlags().SetFlags( Population::GaChromosomeStorage::GACF_REMOVE_CHROMOSOME );
+
+						hb.RemoveItem();
+					}
 				}
 			}
 
 			// assign scaled fitness to chromosomes
-			popWorkDist.Execute( GaPESAFitnessAssignOp( getDominated, getHyperBoxInfo, parameters.GetRegionSharing() ), false );
+			popWorkDist.Execute( GaPESAFitnessAssignOp( getDominated, getHyperBox, getHyperBoxInfo, sparseGrid, parameters.GetRegionSharing() ), false );
 
 			// update operation time statistics
 			timer.UpdateStatistics();
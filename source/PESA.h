@@ -54,6 +54,9 @@ namespace Multiobjective
 			/// <summary>Indicates whether the sharing of fitness for a region (hyperbox) should be engaged.</summary>
 			bool _regionSharing;
 
+			/// <summary>ID of population tag that stores sparse hypergrid. Hyperboxes are found by sorting nondominated chromosomes if ID is negative.</summary>
+			int _sparseGridTagID;
+
 		public:
 
 			/// <summary>This constructor initializes parameters with used-defined values.</summary>
@@ -64,19 +67,22 @@ namespace Multiobjective
 			/// <param name="nondominatedTagID">ID of population tag that stores list of nondominated chromosomes.</param>
 			/// <param name="crowdingStorageTagID">ID of population tag that stores currently most crowded hyperboxes.</param>
 			/// <param name="regionSharing">if this parameters is set to <c>true</c> chromosomes in same region (hyperbox) share fitness value.</param>
+			/// <param name="sparseGridTagID">ID of population tag that stores sparse hypergrid.</param>
 			GaPESAParams(int dominatedTagID,
 				int hyperBoxTagID,
 				int hyperBoxInfoTagID,
 				int hyperBoxInfoBufferTagID,
 				int nondominatedTagID,
 				int crowdingStorageTagID,
-				bool regionSharing) : _dominatedTagID(dominatedTagID),
+				bool regionSharing,
+				int sparseGridTagID = -1) : _dominatedTagID(dominatedTagID),
 				_hyperBoxTagID(hyperBoxTagID),
 				_hyperBoxInfoTagID(hyperBoxInfoTagID),
 				_hyperBoxInfoBufferTagID(hyperBoxInfoBufferTagID),
 				_nondominatedTagID(nondominatedTagID),
 				_crowdingStorageTagID(crowdingStorageTagID),
-				_regionSharing(regionSharing) { }
+				_regionSharing(regionSharing),
+				_sparseGridTagID(sparseGridTagID) { }
 
 			/// <summary>This constructor initializes parameters without specifing any tags and engaged sharing of fitness for a region (hyperbox).</summary>
 			GaPESAParams() :  _dominatedTagID(-1),
@@ -85,7 +91,8 @@ namespace Multiobjective
 				_hyperBoxInfoBufferTagID(-1),
 				_nondominatedTagID(-1),
 				_crowdingStorageTagID(-1),
-				_regionSharing(true) { }
+				_regionSharing(true),
+				_sparseGridTagID(-1) { }
 
 			/// <summary>More details are given in specification of <see cref="GaParameters::Clone" /> method.
 			///
@@ -163,6 +170,18 @@ namespace Multiobjective
 			/// <returns>Method returns <c>true</c> if chromosomes in same region (hyperbox) share fitness value.</returns>
 			inline bool GACALL GetRegionSharing() const { return _regionSharing; }
 
+			/// <summary><c>SetSparseGridTagID</c> method sets population tag that stores sparse hypergrid.
+			/// When the tag is set, nondominated chromosomes are placed into hash table of occupied hyperboxes instead of being sorted by their hyperboxes,
+			/// and chromosomes are removed from the most crowded hyperbox that is tracked by the grid, so hyperbox info buffer and crowding storage are not used.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="tagID">ID of the tag. Negative value disables sparse hypergrid.</param>
+			inline void GACALL SetSparseGridTagID(int tagID) { _sparseGridTagID = tagID; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns ID of population tag that stores sparse hypergrid.</returns>
+			inline int GACALL GetSparseGridTagID() const { return _sparseGridTagID; }
+
 		};
 
 		/// <summary><c>GaPESAConfig</c> class represents configuration for implementation of Pareto Envelope-based Selection Algorithm and Region-based Selection.
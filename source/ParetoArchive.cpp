@@ -0,0 +1,483 @@
+/*! \file ParetoArchive.cpp
+    \brief This file contains implementation of classes that implement bounded archive of nondominated solutions.
+*/
+
+/*
+ *
+ * website: http://kataklinger.com/
+ * contact: me[at]kataklinger.com
+ *
+ */
+
+#include "ParetoArchive.h"
+
+namespace Multiobjective
+{
+
+	// Sets size of the archive
+	void GaParetoArchive::SetSize(int size,
+		int objectiveCount)
+	{
+		GA_ARG_ASSERT( Common::Exceptions::GaArgumentOutOfRangeException, size >= 0, "size", "Size of the archive cannot be negative.", "Multiobjective" );
+		GA_ARG_ASSERT( Common::Exceptions::GaArgumentOutOfRangeException, objectiveCount > 0, "objectiveCount", "Number of objectives must be positive.", "Multiobjective" );
+
+		if( _size != size || _objectiveCount != objectiveCount )
+		{
+			_size = size;
+			_objectiveCount = objectiveCount;
+
+			_values.SetSize( size * objectiveCount );
+			_chromosomes.SetSize( size );
+			_entryLeaves.SetSize( size );
+			_entryPositions.SetSize( size );
+			_freeEntries.SetSize( size );
+			_removedEntries.SetSize( size );
+			_removed.SetSize( size );
+
+			// each leaf node except the root stores at least one solution
+			int nodes = size + 1;
+			_nodes.SetSize( nodes );
+			_freeNodes.SetSize( nodes );
+			_children.SetSize( nodes * ( NODE_SIZE + 1 ) );
+			_bounds.SetSize( nodes * 2 * objectiveCount );
+
+			_seeds.SetSize( 3 * objectiveCount );
+			_grid.SetSize( size, objectiveCount );
+
+			_batchCount = 0;
+		}
+
+		Clear();
+	}
+
+	// Removes all solutions
+	void GaParetoArchive::Clear()
+	{
+		for( int i = 0; i < _size; i++ )
+			_freeEntries[ i ] = _size - i - 1;
+
+		_freeEntryCount = _size;
+		_count = _nodeCount = _freeNodeCount = _removedCount = 0;
+		_root = -1;
+
+		_grid.Clear();
+	}
+
+	// Inserts solution into the archive
+	int GaParetoArchive::Insert(Population::GaChromosomeStorage* chromosome,
+		const double* values,
+		const Common::Grid::GaHyperBox& hyperBox)
+	{
+		_removedCount = 0;
+
+		if( _root >= 0 )
+		{
+			if( IsDominated( _root, values ) )
+				return -1;
+
+			// remove solutions dominated by the new solution
+			CollectDominated( _root, values );
+			for( int i = 0; i < _removedCount; i++ )
+			{
+				_removed[ i ] = _chromosomes[ _removedEntries[ i ] ];
+				Remove( _removedEntries[ i ] );
+			}
+		}
+
+		GA_ASSERT( Common::Exceptions::GaInvalidOperationException, _count < _size, "Archive is full.", "Multiobjective" );
+
+		int entry = _freeEntries[ --_freeEntryCount ];
+		_count++;
+
+		for( int i = 0; i < _objectiveCount; i++ )
+			_values[ entry * _objectiveCount + i ] = values[ i ];
+		_chromosomes[ entry ] = chromosome;
+		_grid.Insert( entry, hyperBox );
+
+		if( _root < 0 )
+		{
+			_root = AllocateNode( true, -1 );
+
+			double* bounds = GetBounds( _root );
+			for( int i = 0; i < _objectiveCount; i++ )
+				bounds[ i ] = bounds[ _objectiveCount + i ] = values[ i ];
+		}
+
+		// descend to the leaf whose center is nearest to the solution and extend bounds of visited nodes
+		int node = _root;
+		while( true )
+		{
+			double* bounds = GetBounds( node );
+			for( int i = 0; i < _objectiveCount; i++ )
+			{
+				if( values[ i ] < bounds[ i ] )
+					bounds[ i ] = values[ i ];
+				if( values[ i ] > bounds[ _objectiveCount + i ] )
+					bounds[ _objectiveCount + i ] = values[ i ];
+			}
+
+			if( _nodes[ node ]._leaf )
+				break;
+
+			const int* children = GetChildren( node );
+			int nearest = children[ 0 ];
+			double minDistance = GetDistance( false, nearest, values );
+			for( int i = _nodes[ node ]._count - 1; i > 0; i-- )
+			{
+				double distance = GetDistance( false, children[ i ], values );
+				if( distance < minDistance )
+				{
+					nearest = children[ i ];
+					minDistance = distance;
+				}
+			}
+
+			node = nearest;
+		}
+
+		AddChild( node, entry );
+		if( _nodes[ node ]._count > NODE_SIZE )
+			Split( node );
+
+		return entry;
+	}
+
+	// Removes solution from the archive
+	void GaParetoArchive::Remove(int entry)
+	{
+		GA_ARG_ASSERT( Common::Exceptions::GaArgumentOutOfRangeException, entry >= 0 && entry < _size, "entry", "Entry is out of range.", "Multiobjective" );
+
+		_grid.Remove( entry );
+		_freeEntries[ _freeEntryCount++ ] = entry;
+		_count--;
+
+		// remove solution from its leaf by moving the last child to its position
+		int node = _entryLeaves[ entry ];
+		int last = _children[ node * ( NODE_SIZE + 1 ) + --_nodes[ node ]._count ];
+		_children[ node * ( NODE_SIZE + 1 ) + _entryPositions[ entry ] ] = last;
+		_entryPositions[ last ] = _entryPositions[ entry ];
+
+		// release empty nodes
+		while( _nodes[ node ]._count == 0 )
+		{
+			_freeNodes[ _freeNodeCount++ ] = node;
+
+			int parent = _nodes[ node ]._parent;
+			if( parent < 0 )
+			{
+				_root = -1;
+				return;
+			}
+
+			last = _children[ parent * ( NODE_SIZE + 1 ) + --_nodes[ parent ]._count ];
+			_children[ parent * ( NODE_SIZE + 1 ) + _nodes[ node ]._position ] = last;
+			_nodes[ last ]._position = _nodes[ node ]._position;
+
+			node = parent;
+		}
+
+		// shrink bounds of nodes on the path to the root
+		for( ; node >= 0 && UpdateBounds( node ); node = _nodes[ node ]._parent )
+			;
+
+		// remove root nodes that have single child
+		while( !_nodes[ _root ]._leaf && _nodes[ _root ]._count == 1 )
+		{
+			_freeNodes[ _freeNodeCount++ ] = _root;
+			_root = GetChildren( _root )[ 0 ];
+			_nodes[ _root ]._parent = -1;
+		}
+	}
+
+	// Prepares buffer for batch of candidates
+	void GaParetoArchive::BeginBatch(int count)
+	{
+		if( _batchFiltered.GetSize() < count || _batchValues.GetSize() < count * _objectiveCount )
+		{
+			_batchFiltered.SetSize( count );
+			_batchValues.SetSize( count * _objectiveCount );
+		}
+
+		for( int i = count - 1; i >= 0; i-- )
+			_batchFiltered[ i ] = false;
+
+		_batchCount = count;
+	}
+
+	// Checks whether the solution is dominated by solutions in the subtree
+	bool GaParetoArchive::IsDominated(int node,
+		const double* values) const
+	{
+		const double* bounds = GetBounds( node );
+
+		// no solution in the subtree can dominate the point if ideal point is worse in some objective
+		if( !Covers( bounds, values ) )
+			return false;
+
+		// every solution in the subtree dominates the point if nadir point dominates it
+		if( Dominates( bounds + _objectiveCount, values ) )
+			return true;
+
+		const GaNode& n = _nodes[ node ];
+		const int* children = GetChildren( node );
+		for( int i = n._count - 1; i >= 0; i-- )
+		{
+			if( n._leaf ? Dominates( &_values[ children[ i ] * _objectiveCount ], values ) : IsDominated( children[ i ], values ) )
+				return true;
+		}
+
+		return false;
+	}
+
+	// Collects solutions dominated by the point
+	void GaParetoArchive::CollectDominated(int node,
+		const double* values)
+	{
+		const double* bounds = GetBounds( node );
+
+		// the point cannot dominate any solution in the subtree if it is worse then nadir point in some objective
+		if( !Covers( values, bounds + _objectiveCount ) )
+			return;
+
+		// the point dominates all solutions in the subtree if it dominates ideal point
+		if( Dominates( values, bounds ) )
+		{
+			CollectAll( node );
+			return;
+		}
+
+		const GaNode& n = _nodes[ node ];
+		const int* children = GetChildren( node );
+		for( int i = n._count - 1; i >= 0; i-- )
+		{
+			if( !n._leaf )
+				CollectDominated( children[ i ], values );
+			else if( Dominates( values, &_values[ children[ i ] * _objectiveCount ] ) )
+				_removedEntries[ _removedCount++ ] = children[ i ];
+		}
+	}
+
+	// Collects all solutions in the subtree
+	void GaParetoArchive::CollectAll(int node)
+	{
+		const GaNode& n = _nodes[ node ];
+		const int* children = GetChildren( node );
+		for( int i = n._count - 1; i >= 0; i-- )
+		{
+			if( n._leaf )
+				_removedEntries[ _removedCount++ ] = children[ i ];
+			else
+				CollectAll( children[ i ] );
+		}
+	}
+
+	// Splits overflowed node
+	void GaParetoArchive::Split(int node)
+	{
+		bool leaf = _nodes[ node ]._leaf;
+
+		int items[ NODE_SIZE + 1 ];
+		int count = _nodes[ node ]._count;
+		for( int i = 0; i < count; i++ )
+			items[ i ] = GetChildren( node )[ i ];
+
+		double* seedA = &_seeds[ 0 ];
+		double* seedB = seedA + _objectiveCount;
+		double* center = seedB + _objectiveCount;
+
+		// choose two distant children as seeds of the new nodes
+		int a = 0, b = 0;
+		double maxDistance = -1;
+		GetCenter( leaf, items[ 0 ], center );
+		for( int i = 1; i < count; i++ )
+		{
+			double distance = GetDistance( leaf, items[ i ], center );
+			if( distance > maxDistance )
+			{
+				a = i;
+				maxDistance = distance;
+			}
+		}
+
+		maxDistance = -1;
+		GetCenter( leaf, items[ a ], seedA );
+		for( int i = 0; i < count; i++ )
+		{
+			double distance = GetDistance( leaf, items[ i ], seedA );
+			if( i != a && distance > maxDistance )
+			{
+				b = i;
+				maxDistance = distance;
+			}
+		}
+		GetCenter( leaf, items[ b ], seedB );
+
+		int sibling = AllocateNode( leaf, _nodes[ node ]._parent );
+
+		// distribute children to the seed which is closer
+		_nodes[ node ]._count = 0;
+		for( int i = 0; i < count; i++ )
+		{
+			bool second = i == b || ( i != a && GetDistance( leaf, items[ i ], seedB ) < GetDistance( leaf, items[ i ], seedA ) );
+			AddChild( second ? sibling : node, items[ i ] );
+		}
+
+		UpdateBounds( node );
+		UpdateBounds( sibling );
+
+		int parent = _nodes[ node ]._parent;
+		if( parent < 0 )
+		{
+			// grow the tree
+			_root = AllocateNode( false, -1 );
+			AddChild( _root, node );
+			AddChild( _root, sibling );
+			UpdateBounds( _root );
+		}
+		else
+		{
+			AddChild( parent, sibling );
+			if( _nodes[ parent ]._count > NODE_SIZE )
+				Split( parent );
+		}
+	}
+
+	// Inserts child into node
+	void GaParetoArchive::AddChild(int node,
+		int child)
+	{
+		int position = _nodes[ node ]._count++;
+		_children[ node * ( NODE_SIZE + 1 ) + position ] = child;
+
+		if( _nodes[ node ]._leaf )
+		{
+			_entryLeaves[ child ] = node;
+			_entryPositions[ child ] = position;
+		}
+		else
+		{
+			_nodes[ child ]._parent = node;
+			_nodes[ child ]._position = position;
+		}
+	}
+
+	// Makes new node
+	int GaParetoArchive::AllocateNode(bool leaf,
+		int parent)
+	{
+		int node;
+		if( _freeNodeCount > 0 )
+			node = _freeNodes[ --_freeNodeCount ];
+		else
+		{
+			node = _nodeCount++;
+
+			// internal nodes that have single child can increase number of nodes
+			if( node == _nodes.GetSize() )
+			{
+				int nodes = 2 * node;
+				_nodes.SetSize( nodes );
+				_freeNodes.SetSize( nodes );
+				_children.SetSize( nodes * ( NODE_SIZE + 1 ) );
+				_bounds.SetSize( nodes * 2 * _objectiveCount );
+			}
+		}
+
+		GaNode& n = _nodes[ node ];
+		n._parent = parent;
+		n._position = -1;
+		n._count = 0;
+		n._leaf = leaf;
+
+		return node;
+	}
+
+	// Calculates bounds of the node
+	bool GaParetoArchive::UpdateBounds(int node)
+	{
+		const GaNode& n = _nodes[ node ];
+		const int* children = GetChildren( node );
+		double* bounds = GetBounds( node );
+
+		bool changed = false;
+		for( int i = 0; i < _objectiveCount; i++ )
+		{
+			double low, high;
+			if( n._leaf )
+			{
+				low = high = _values[ children[ 0 ] * _objectiveCount + i ];
+				for( int j = n._count - 1; j > 0; j-- )
+				{
+					double value = _values[ children[ j ] * _objectiveCount + i ];
+					if( value < low )
+						low = value;
+					else if( value > high )
+						high = value;
+				}
+			}
+			else
+			{
+				low = GetBounds( children[ 0 ] )[ i ];
+				high = GetBounds( children[ 0 ] )[ _objectiveCount + i ];
+				for( int j = n._count - 1; j > 0; j-- )
+				{
+					const double* childBounds = GetBounds( children[ j ] );
+					if( childBounds[ i ] < low )
+						low = childBounds[ i ];
+					if( childBounds[ _objectiveCount + i ] > high )
+						high = childBounds[ _objectiveCount + i ];
+				}
+			}
+
+			changed |= bounds[ i ] != low || bounds[ _objectiveCount + i ] != high;
+			bounds[ i ] = low;
+			bounds[ _objectiveCount + i ] = high;
+		}
+
+		return changed;
+	}
+
+	// Calculates distance between center of the child and the point
+	double GaParetoArchive::GetDistance(bool leaf,
+		int child,
+		const double* values) const
+	{
+		double distance = 0;
+		if( leaf )
+		{
+			const double* point = &_values[ child * _objectiveCount ];
+			for( int i = 0; i < _objectiveCount; i++ )
+				distance += ( point[ i ] - values[ i ] ) * ( point[ i ] - values[ i ] );
+		}
+		else
+		{
+			const double* bounds = GetBounds( child );
+			for( int i = 0; i < _objectiveCount; i++ )
+			{
+				double offset = ( bounds[ i ] + bounds[ _objectiveCount + i ] ) / 2 - values[ i ];
+				distance += offset * offset;
+			}
+		}
+
+		return distance;
+	}
+
+	// Calculates center of the child
+	void GaParetoArchive::GetCenter(bool leaf,
+		int child,
+		double* center) const
+	{
+		if( leaf )
+		{
+			for( int i = 0; i < _objectiveCount; i++ )
+				center[ i ] = _values[ child * _objectiveCount + i ];
+		}
+		else
+		{
+			const double* bounds = GetBounds( child );
+			for( int i = 0; i < _objectiveCount; i++ )
+				center[ i ] = ( bounds[ i ] + bounds[ _objectiveCount + i ] ) / 2;
+		}
+	}
+
+} // Multiobjective
@@ -0,0 +1,368 @@
+/*! \file ParetoArchive.h
+    \brief This file declares classes that implement bounded archive of nondominated solutions.
+*/
+
+/*
+ *
+ * website: http://kataklinger.com/
+ * contact: me[at]kataklinger.com
+ *
+ */
+
+#ifndef __GA_PARETO_ARCHIVE_H__
+#define __GA_PARETO_ARCHIVE_H__
+
+#include "Grid.h"
+
+namespace Population
+{
+	class GaChromosomeStorage;
+} // Population
+
+namespace Multiobjective
+{
+
+	/// <summary><c>GaParetoArchive</c> class stores bounded set of mutually nondominated solutions. Objective values of archived solutions are indexed by tree
+	/// whose nodes store ideal and nadir points of their subtrees, so subtrees that cannot contain solution dominating new solution, or solution dominated by it,
+	/// are skipped during dominance filtering. Archived solutions are also placed into sparse hypergrid that tracks the most crowded hyperbox.
+	///
+	/// Objective values must be stored as keys which are minimized. Solution is considered to dominate another if none of its values is greater
+	/// and at least one is lower, so solutions with equal values can be archived together.
+	///
+	/// Candidates can be filtered in batches. Multiple threads can check candidates of the batch against the archive concurrently,
+	/// while the archive itself is updated by single thread.
+	///
+	/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
+	/// No public or private methods are thread-safe, except <c>IsDominated</c> and <c>Filter</c> methods which can be called concurrently while archive is not modified.</summary>
+	class GaParetoArchive
+	{
+
+	public:
+
+		/// <summary>Maximal number of children that node of the tree can have.</summary>
+		static const int NODE_SIZE = 16;
+
+	private:
+
+		/// <summary><c>GaNode</c> struct stores information about node of the tree.</summary>
+		struct GaNode
+		{
+
+			/// <summary>Index of parent node or -1 if this is the root node.</summary>
+			int _parent;
+
+			/// <summary>Position of the node in the list of children of its parent.</summary>
+			int _position;
+
+			/// <summary>Number of children. Children of leaf nodes are archived solutions.</summary>
+			int _count;
+
+			/// <summary>Indicates whether the node is leaf.</summary>
+			bool _leaf;
+
+		};
+
+		/// <summary>Number of objectives.</summary>
+		int _objectiveCount;
+
+		/// <summary>Maximal number of archived solutions.</summary>
+		int _size;
+
+		/// <summary>Number of archived solutions.</summary>
+		int _count;
+
+		/// <summary>Objective keys of archived solutions stored row by row.</summary>
+		Common::Data::GaSingleDimensionArray<double> _values;
+
+		/// <summary>Chromosomes that represent archived solutions.</summary>
+		Common::Data::GaSingleDimensionArray<Population::GaChromosomeStorage*> _chromosomes;
+
+		/// <summary>Leaf node that stores each solution.</summary>
+		Common::Data::GaSingleDimensionArray<int> _entryLeaves;
+
+		/// <summary>Position of each solution in the list of children of its leaf node.</summary>
+		Common::Data::GaSingleDimensionArray<int> _entryPositions;
+
+		/// <summary>Unused entries.</summary>
+		Common::Data::GaSingleDimensionArray<int> _freeEntries;
+
+		/// <summary>Number of unused entries.</summary>
+		int _freeEntryCount;
+
+		/// <summary>Nodes of the tree.</summary>
+		Common::Data::GaSingleDimensionArray<GaNode> _nodes;
+
+		/// <summary>Children of the nodes. Each node has room for one more child then allowed, so it can be split after insertion.</summary>
+		Common::Data::GaSingleDimensionArray<int> _children;
+
+		/// <summary>Ideal and nadir points of subtrees stored for each node.</summary>
+		Common::Data::GaSingleDimensionArray<double> _bounds;
+
+		/// <summary>Number of nodes that have been used since the archive was cleared.</summary>
+		int _nodeCount;
+
+		/// <summary>Unused nodes.</summary>
+		Common::Data::GaSingleDimensionArray<int> _freeNodes;
+
+		/// <summary>Number of unused nodes.</summary>
+		int _freeNodeCount;
+
+		/// <summary>Index of the root node or -1 if the archive is empty.</summary>
+		int _root;
+
+		/// <summary>Entries removed from the archive by the last insertion.</summary>
+		Common::Data::GaSingleDimensionArray<int> _removedEntries;
+
+		/// <summary>Chromosomes removed from the archive by the last insertion.</summary>
+		Common::Data::GaSingleDimensionArray<Population::GaChromosomeStorage*> _removed;
+
+		/// <summary>Number of chromosomes removed from the archive by the last insertion.</summary>
+		int _removedCount;
+
+		/// <summary>Buffer that stores centers of seeds used when node is split.</summary>
+		Common::Data::GaSingleDimensionArray<double> _seeds;
+
+		/// <summary>Hypergrid that tracks crowding of archived solutions.</summary>
+		Common::Grid::GaSparseHyperGrid _grid;
+
+		/// <summary>Objective keys of candidates in the current batch stored row by row.</summary>
+		Common::Data::GaSingleDimensionArray<double> _batchValues;
+
+		/// <summary>Marks candidates of the current batch that are dominated by archived solutions.</summary>
+		Common::Data::GaSingleDimensionArray<bool> _batchFiltered;
+
+		/// <summary>Number of candidates in the current batch.</summary>
+		int _batchCount;
+
+	public:
+
+		/// <summary>This constructor initializes empty archive.</summary>
+		GaParetoArchive() : _objectiveCount(0),
+			_size(0),
+			_count(0),
+			_freeEntryCount(0),
+			_nodeCount(0),
+			_freeNodeCount(0),
+			_root(-1),
+			_removedCount(0),
+			_batchCount(0) { }
+
+		/// <summary><c>SetSize</c> method sets maximal number of archived solutions and number of objectives. All solutions are removed from the archive.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="size">maximal number of archived solutions.</param>
+		/// <param name="objectiveCount">number of objectives.</param>
+		/// <exception cref="GaArgumentOutOfRangeException" />Thrown if size is negative or number of objectives is not positive.</exception>
+		GAL_API
+		void GACALL SetSize(int size,
+			int objectiveCount);
+
+		/// <summary><c>Clear</c> method removes all solutions from the archive.
+		///
+		/// This method is not thread-safe.</summary>
+		GAL_API
+		void GACALL Clear();
+
+		/// <summary><c>Insert</c> method inserts solution into the archive unless it is dominated by an archived solution.
+		/// Archived solutions dominated by the new solution are removed and they can be queried using <c>GetRemoved</c> method.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="chromosome">chromosome that represents the solution.</param>
+		/// <param name="values">objective keys of the solution.</param>
+		/// <param name="hyperBox">hyperbox to which the solution belongs.</param>
+		/// <returns>Method returns entry of the archived solution or -1 if the solution is dominated.</returns>
+		/// <exception cref="GaInvalidOperationException" />Thrown if the archive is full and the new solution does not dominate any archived solution.</exception>
+		GAL_API
+		int GACALL Insert(Population::GaChromosomeStorage* chromosome,
+			const double* values,
+			const Common::Grid::GaHyperBox& hyperBox);
+
+		/// <summary><c>Remove</c> method removes solution from the archive.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="entry">entry of the solution.</param>
+		GAL_API
+		void GACALL Remove(int entry);
+
+		/// <summary>This method is thread-safe as long as the archive is not modified concurrently.</summary>
+		/// <param name="values">objective keys of queried solution.</param>
+		/// <returns>Method returns <c>true</c> if the solution is dominated by an archived solution.</returns>
+		inline bool GACALL IsDominated(const double* values) const { return _root >= 0 && IsDominated( _root, values ); }
+
+		/// <summary><c>BeginBatch</c> method prepares buffer that stores objective keys of candidates that should be filtered.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="count">number of candidates.</param>
+		GAL_API
+		void GACALL BeginBatch(int count);
+
+		/// <summary><c>Filter</c> method checks whether candidate of the current batch is dominated by an archived solution.
+		///
+		/// This method is thread-safe as long as the archive is not modified concurrently and each candidate is filtered by a single thread.</summary>
+		/// <param name="index">index of the candidate in the batch.</param>
+		inline void GACALL Filter(int index) { _batchFiltered[ index ] = IsDominated( &_batchValues[ index * _objectiveCount ] ); }
+
+		/// <summary>This method is thread-safe as long as the candidate is not filtered concurrently.</summary>
+		/// <param name="index">index of the candidate in the batch.</param>
+		/// <returns>Method returns <c>true</c> if the candidate was dominated by an archived solution when it was filtered.</returns>
+		inline bool GACALL IsFiltered(int index) const { return _batchFiltered[ index ]; }
+
+		/// <summary>This method is thread-safe as long as different threads access different candidates.</summary>
+		/// <param name="index">index of the candidate in the batch.</param>
+		/// <returns>Method returns pointer to buffer that should store objective keys of the candidate.</returns>
+		inline double* GACALL GetBatchValues(int index) { return &_batchValues[ index * _objectiveCount ]; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns number of candidates in the current batch.</returns>
+		inline int GACALL GetBatchCount() const { return _batchCount; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns number of archived solutions removed by the last insertion.</returns>
+		inline int GACALL GetRemovedCount() const { return _removedCount; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <param name="index">index of removed solution.</param>
+		/// <returns>Method returns chromosome of archived solution removed by the last insertion.</returns>
+		inline Population::GaChromosomeStorage* GACALL GetRemoved(int index) const { return _removed[ index ]; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <param name="entry">entry of archived solution.</param>
+		/// <returns>Method returns chromosome that represents archived solution.</returns>
+		inline Population::GaChromosomeStorage* GACALL GetChromosome(int entry) const { return _chromosomes[ entry ]; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <param name="entry">entry of archived solution.</param>
+		/// <returns>Method returns objective keys of archived solution.</returns>
+		inline const double* GACALL GetValues(int entry) const { return &_values[ entry * _objectiveCount ]; }
+
+		/// <summary>Items of the grid are entries of archived solutions.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <returns>Method returns reference to hypergrid that tracks crowding of archived solutions.</returns>
+		inline const Common::Grid::GaSparseHyperGrid& GACALL GetGrid() const { return _grid; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns number of archived solutions.</returns>
+		inline int GACALL GetCount() const { return _count; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns maximal number of archived solutions.</returns>
+		inline int GACALL GetSize() const { return _size; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns number of objectives.</returns>
+		inline int GACALL GetObjectiveCount() const { return _objectiveCount; }
+
+	private:
+
+		/// <summary><c>IsDominated</c> method checks whether the solution is dominated by a solution stored in the subtree.</summary>
+		/// <param name="node">root node of the subtree.</param>
+		/// <param name="values">objective keys of the solution.</param>
+		/// <returns>Method returns <c>true</c> if the solution is dominated.</returns>
+		bool GACALL IsDominated(int node,
+			const double* values) const;
+
+		/// <summary><c>CollectDominated</c> method stores entries of solutions in the subtree that are dominated by the specified solution.</summary>
+		/// <param name="node">root node of the subtree.</param>
+		/// <param name="values">objective keys of the solution.</param>
+		void GACALL CollectDominated(int node,
+			const double* values);
+
+		/// <summary><c>CollectAll</c> method stores entries of all solutions in the subtree.</summary>
+		/// <param name="node">root node of the subtree.</param>
+		void GACALL CollectAll(int node);
+
+		/// <summary><c>Split</c> method splits overflowed node into two nodes.</summary>
+		/// <param name="node">index of the node.</param>
+		void GACALL Split(int node);
+
+		/// <summary><c>AddChild</c> method inserts child into node and updates position of the child.</summary>
+		/// <param name="node">index of the node.</param>
+		/// <param name="child">entry of solution if the node is leaf or index of child node.</param>
+		void GACALL AddChild(int node,
+			int child);
+
+		/// <summary><c>AllocateNode</c> method makes new empty node.</summary>
+		/// <param name="leaf">indicates whether the node is leaf.</param>
+		/// <param name="parent">index of parent node.</param>
+		/// <returns>Method returns index of the node.</returns>
+		int GACALL AllocateNode(bool leaf,
+			int parent);
+
+		/// <summary><c>UpdateBounds</c> method calculates ideal and nadir points of the node from its children.</summary>
+		/// <param name="node">index of the node.</param>
+		/// <returns>Method returns <c>true</c> if bounds were changed.</returns>
+		bool GACALL UpdateBounds(int node);
+
+		/// <summary><c>GetDistance</c> method calculates squared distance between center of the child and the point.</summary>
+		/// <param name="leaf">indicates whether the child is solution or node.</param>
+		/// <param name="child">entry of solution or index of node.</param>
+		/// <param name="values">coordinates of the point.</param>
+		/// <returns>Method returns squared distance.</returns>
+		double GACALL GetDistance(bool leaf,
+			int child,
+			const double* values) const;
+
+		/// <summary><c>GetCenter</c> method calculates center of the child.</summary>
+		/// <param name="leaf">indicates whether the child is solution or node.</param>
+		/// <param name="child">entry of solution or index of node.</param>
+		/// <param name="center">buffer that will store coordinates of the center.</param>
+		void GACALL GetCenter(bool leaf,
+			int child,
+			double* center) const;
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <param name="node">index of the node.</param>
+		/// <returns>Method returns pointer to ideal point of the node. Nadir point is stored after ideal point.</returns>
+		inline double* GACALL GetBounds(int node) { return &_bounds[ node * 2 * _objectiveCount ]; }
+
+		/// <summary>This method is thread-safe as long as the archive is not modified concurrently.</summary>
+		/// <param name="node">index of the node.</param>
+		/// <returns>Method returns pointer to ideal point of the node. Nadir point is stored after ideal point.</returns>
+		inline const double* GACALL GetBounds(int node) const { return &_bounds[ node * 2 * _objectiveCount ]; }
+
+		/// <summary>This method is thread-safe as long as the archive is not modified concurrently.</summary>
+		/// <param name="node">index of the node.</param>
+		/// <returns>Method returns pointer to list of children of the node.</returns>
+		inline const int* GACALL GetChildren(int node) const { return &_children[ node * ( NODE_SIZE + 1 ) ]; }
+
+		/// <summary><c>Dominates</c> method checks whether the first point dominates the second.</summary>
+		/// <param name="values1">coordinates of the first point.</param>
+		/// <param name="values2">coordinates of the second point.</param>
+		/// <returns>Method returns <c>true</c> if the first point dominates the second.</returns>
+		inline bool GACALL Dominates(const double* values1,
+			const double* values2) const
+		{
+			bool better = false;
+			for( int i = 0; i < _objectiveCount; i++ )
+			{
+				if( values1[ i ] > values2[ i ] )
+					return false;
+
+				better |= values1[ i ] < values2[ i ];
+			}
+
+			return better;
+		}
+
+		/// <summary><c>Covers</c> method checks whether none of the coordinates of the first point is greater then coordinate of the second point.</summary>
+		/// <param name="values1">coordinates of the first point.</param>
+		/// <param name="values2">coordinates of the second point.</param>
+		/// <returns>Method returns <c>true</c> if the first point is not greater in any coordinate.</returns>
+		inline bool GACALL Covers(const double* values1,
+			const double* values2) const
+		{
+			for( int i = 0; i < _objectiveCount; i++ )
+			{
+				if( values1[ i ] > values2[ i ] )
+					return false;
+			}
+
+			return true;
+		}
+
+	};
+
+} // Multiobjective
+
+#endif // __GA_PARETO_ARCHIVE_H__
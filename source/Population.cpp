@@ -16,6 +16,283 @@
 namespace Population
 {
 
+	// Sets comparator and prepares slots for indexing chromosomes
+	void GaChromosomeHashIndex::Configure(const Chromosome::GaChromosomeComparatorSetup& comparator,
+		int capacity)
+	{
+		_comparator = comparator;
+		_parametersKey = GetParametersKey( comparator );
+
+		// keep load factor of the index below 0.5
+		int size = 16;
+		while( size < 2 * capacity )
+			size *= 2;
+
+		GaSlot empty = { NULL, 0 };
+		_slots.SetSize( size );
+		for( int i = size - 1; i >= 0; i-- )
+			_slots[ i ] = empty;
+
+		_mask = size - 1;
+	}
+
+	// Removes chromosome from the index
+	void GaChromosomeHashIndex::Remove(GaChromosomeStorage* chromosome)
+	{
+		if( _mask < 0 )
+			return;
+
+		// find slot of the chromosome
+		int i = GetSlot( GetHash( *chromosome->GetChromosome() ) );
+		for( int probes = _mask; _slots[ i ]._chromosome != chromosome; i = ( i + 1 ) & _mask, probes-- )
+		{
+			if( !_slots[ i ]._chromosome || probes == 0 )
+				return;
+		}
+
+		// move following entries back to the released slot so probing sequences are not broken
+		for( int j = ( i + 1 ) & _mask, probes = _mask; probes > 0 && _slots[ j ]._chromosome; j = ( j + 1 ) & _mask, probes-- )
+		{
+			// entry can be moved only if the released slot is between its home slot and its current slot
+			if( ( ( j - GetSlot( _slots[ j ]._hash ) ) & _mask ) >= ( ( j - i ) & _mask ) )
+			{
+				_slots[ i ] = _slots[ j ];
+				i = j;
+			}
+		}
+
+		_slots[ i ]._chromosome = NULL;
+	}
+
+	// Builds table of cumulative selection probabilities
+	void GaRouletteWheelTable::Update(GaPopulation& population,
+		Common::Workflows::GaBranch* branch)
+	{
+		// all branches check the table before any of them can change it
+		if( IsCurrent( population ) )
+			return;
+
+		int branchCount = branch->GetBarrierCount();
+		int count = population.GetCount();
+		int blockCount = ( count + BLOCK_SIZE - 1 ) / BLOCK_SIZE;
+
+		GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+		{
+			_cumulative.SetSize( count );
+			_blockSums.SetSize( blockCount );
+		}
+
+		int work, start;
+		branch->SplitWork( blockCount, work, start );
+
+		// sum probabilities within blocks in the same order as they are traversed by roulette wheel
+		for( int i = start; i < start + work; i++ )
+		{
+			int end = ( i + 1 ) * BLOCK_SIZE < count ? ( i + 1 ) * BLOCK_SIZE : count;
+
+			float current = 0;
+			for( int j = i * BLOCK_SIZE; j < end; j++ )
+			{
+				current += population[ j ].GetFitness( GaChromosomeStorage::GAFT_SCALED ).GetProbabilityBase();
+				_cumulative[ j ] = current;
+			}
+
+			_blockSums[ i ] = current;
+		}
+
+		// convert sums of blocks to offsets
+		GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+		{
+			float offset = 0;
+			for( int i = 0; i < blockCount; i++ )
+			{
+				float sum = _blockSums[ i ];
+				_blockSums[ i ] = offset;
+				offset += sum;
+			}
+
+			_built = true;
+			_stamp = population.GetModificationStamp();
+		}
+
+		// add offsets to probabilities of blocks
+		for( int i = start; i < start + work; i++ )
+		{
+			int end = ( i + 1 ) * BLOCK_SIZE < count ? ( i + 1 ) * BLOCK_SIZE : count;
+
+			float offset = _blockSums[ i ];
+			for( int j = i * BLOCK_SIZE; j < end; j++ )
+				_cumulative[ j ] += offset;
+		}
+
+		branch->GetBarrier().Enter( true, branchCount );
+	}
+
+	// Checks whether the table matches the population
+	bool GaRouletteWheelTable::IsCurrent(const GaPopulation& population) const
+	{
+		return _built && _cumulative.GetSize() == population.GetCount() && _stamp == population.GetModificationStamp();
+	}
+
+	/// <summary><c>GaHashIndexInsertOp</c> class represents operation that inserts chromosomes into hash index of the population.</summary>
+	class GaHashIndexInsertOp
+	{
+
+	private:
+
+		/// <summary>Index into which the chromosomes are inserted.</summary>
+		GaChromosomeHashIndex& _index;
+
+	public:
+
+		/// <summary>Initializes operation.</summary>
+		/// <param name="index">index into which the chromosomes are inserted.</param>
+		GaHashIndexInsertOp(GaChromosomeHashIndex& index) : _index(index) { }
+
+		/// <summary><c>operator ()</c> inserts chromosome into hash index.</summary>
+		/// <param name="chromosome">chromosome that should be inserted.</param>
+		/// <param name="index">index of chromosome.</param>
+		inline void GACALL operator ()(GaChromosomeStorage& chromosome,
+			int index) { _index.Insert( &chromosome ); }
+
+	};
+
+	// Removes entries and sets capacity and comparator of the cache
+	void GaFitnessCache::Configure(int size,
+		const Chromosome::GaChromosomeComparatorSetup& comparator)
+	{
+		GA_ARG_ASSERT( Common::Exceptions::GaArgumentOutOfRangeException, size >= 0, "size", "Size of the cache cannot be negative.", "Population" );
+		GA_ARG_ASSERT( Common::Exceptions::GaArgumentException, size == 0 || comparator.HasOperation(), "comparator", "Chromosome comparator must be specified.", "Population" );
+
+		Clear();
+
+		int sets = 0;
+		if( size > 0 )
+		{
+			for( sets = 1; sets * WAYS < size; sets *= 2 )
+				;
+		}
+
+		_entries.SetSize( sets * WAYS );
+		_hands.SetSize( sets );
+		for( int i = sets - 1; i >= 0; i-- )
+			_hands[ i ] = 0;
+
+		_setMask = sets - 1;
+		_comparator = comparator;
+	}
+
+	// Removes all entries from the cache
+	void GaFitnessCache::Clear()
+	{
+		for( int i = _entries.GetSize() - 1; i >= 0; i-- )
+		{
+			GaEntry& entry = _entries[ i ];
+
+			if( entry._fitness )
+			{
+				delete entry._fitness;
+				entry._fitness = NULL;
+			}
+
+			entry._chromosome = Chromosome::GaChromosomePtr::NullPtr;
+			entry._referenced = false;
+		}
+
+		_hits = _misses = 0;
+	}
+
+	// Searches for chromosome with equal code and copies its fitness value
+	bool GaFitnessCache::Find(const Chromosome::GaChromosome& chromosome,
+		unsigned long long hash,
+		Fitness::GaFitness& fitness)
+	{
+		int set = GetSet( hash );
+		GaEntry* entries = &_entries[ set * WAYS ];
+		Common::Threading::GaSpinlock& lock = GetLock( set );
+
+		GA_LOCK( lock );
+
+		for( int i = 0; i < WAYS; i++ )
+		{
+			if( !entries[ i ]._chromosome.IsNull() && entries[ i ]._hash == hash &&
+				_comparator.GetOperation().Equal( *entries[ i ]._chromosome, chromosome, _comparator.GetParameters() ) )
+			{
+				fitness = *entries[ i ]._fitness;
+				entries[ i ]._referenced = true;
+
+				GA_UNLOCK( lock );
+
+				Common::Threading::GaAtomicOps<long>::Inc( &_hits );
+				return true;
+			}
+		}
+
+		GA_UNLOCK( lock );
+
+		Common::Threading::GaAtomicOps<long>::Inc( &_misses );
+		return false;
+	}
+
+	// Stores copies of chromosome and its fitness value
+	void GaFitnessCache::Insert(const Chromosome::GaChromosome& chromosome,
+		unsigned long long hash,
+		const Fitness::GaFitness& fitness)
+	{
+		// chromosome is copied outside of the lock and evicted chromosome is released after the lock is released
+		Chromosome::GaChromosomePtr copy = chromosome.Clone();
+
+		int set = GetSet( hash );
+		GaEntry* entries = &_entries[ set * WAYS ];
+		Common::Threading::GaSpinlock& lock = GetLock( set );
+
+		GA_LOCK( lock );
+
+		GaEntry* victim = NULL;
+		for( int i = 0; i < WAYS; i++ )
+		{
+			if( entries[ i ]._chromosome.IsNull() )
+			{
+				if( !victim )
+					victim = &entries[ i ];
+			}
+			// other thread has already stored the chromosome
+			else if( entries[ i ]._hash == hash && _comparator.GetOperation().Equal( *entries[ i ]._chromosome, chromosome, _comparator.GetParameters() ) )
+			{
+				GA_UNLOCK( lock );
+				return;
+			}
+		}
+
+		// CLOCK: skip entries that have been used since the hand has passed them last time
+		if( !victim )
+		{
+			for( int& hand = _hands[ set ]; ; hand = ( hand + 1 ) % WAYS )
+			{
+				if( !entries[ hand ]._referenced )
+				{
+					victim = &entries[ hand ];
+					hand = ( hand + 1 ) % WAYS;
+					break;
+				}
+
+				entries[ hand ]._referenced = false;
+			}
+		}
+
+		Chromosome::GaChromosomePtr evicted = victim->_chromosome;
+		victim->_chromosome = copy;
+		victim->_hash = hash;
+		victim->_referenced = false;
+
+		if( victim->_fitness )
+			*victim->_fitness = fitness;
+		else
+			victim->_fitness = fitness.Clone();
+
+		GA_UNLOCK( lock );
+	}
+
 	// Constructor population
 	GaPopulation::GaPopulation(const GaPopulationParams& parameters,
 		const Chromosome::GaInitializatorSetup& initializator,
@@ -24,16 +301,19 @@ namespace Population
 		_initializator(initializator),
 		_chromosomes(NULL),
 		_currentSize(0),
+		_modificationStamp(0),
 		_sorting(true),
 		_chromosomeStoragePool(parameters.GetPopulationSize()),
 		_newChromosomes(true, 0, GaChromosomeStorage::GACF_NEW_CHROMOSOME),
 		_removedChromosomes(true, 0, 0, this, true)
 	{
 		_chromosomeStoragePool.GetObjectCreate().SetPopulation( this );
+		_chromosomeStoragePool.GetObjectDelete().SetPopulation( this );
 		_chromosomeStoragePool.GetObjectInit().SetPopulation( this );
 		_chromosomeStoragePool.GetObjectClean().SetPopulation( this );
+		_chromosomeStoragePool.SetMagazineSize( GaChromosomeStoragePool::DEFAULT_MAGAZINE_SIZE );
 
-		_chromosomeTagManager = new Common::Data::GaTagManager( 4, new GaChromosomeTagManagerUpdate( this ) );
+		_chromosomeTagManager = new Common::Data::GaTagManager( 4, new GaChromosomeTagManagerUpdate( this ), true );
 
 		_tagManager = new Common::Data::GaTagManager( 4, new GaPopulationTagManagerUpdate( this ) );
 
@@ -73,6 +353,7 @@ namespace Population
 			{
 				_chromosomes[ i ] = MakeFromPrototype();
 				_newChromosomes.Add( _chromosomes[ i ] );
+				_hashIndex.Insert( _chromosomes[ i ] );
 			}
 
 			_currentSize = fillSize;
@@ -80,6 +361,8 @@ namespace Population
 		else
 			_currentSize = 0;
 
+		_modificationStamp++;
+
 		// mark population as initialized
 		_flags.SetFlags( GAPF_INITIALIZED );
 	}
@@ -89,6 +372,8 @@ namespace Population
 	{
 		_newChromosomes.Clear();
 		_removedChromosomes.Clear();
+		_hashIndex.Disable();
+		_rouletteWheel.Invalidate();
 
 		// remove chromosomes from population
 		for( _currentSize = _currentSize - 1; _currentSize >= 0; _currentSize-- )
@@ -189,10 +474,13 @@ namespace Population
 		// move old chromosome to list of removed chromosomes
 		GaChromosomeStorage* old = _chromosomes[ oldChromosomeIndex ];
 		_removedChromosomes.Add( old );
+		_hashIndex.Remove( old );
 
 		// insert new chromosome int population
 		_chromosomes[ oldChromosomeIndex ] = newChromosome;
 		_newChromosomes.Add( newChromosome );
+		_hashIndex.Insert( newChromosome );
+		_modificationStamp++;
 	}
 
 	// Prepares population for next generation
@@ -220,9 +508,31 @@ namespace Population
 			_events.RaiseEvent( GAPE_NEW_GENERATION, GaPopulationEventData( this ) );
 
 			_flags.ClearFlags( ~GAPF_INITIALIZED );
+			_modificationStamp++;
 		}
 	}
 
+	// Indexes chromosomes by fingerprints of their codes
+	bool GaPopulation::BuildHashIndex(const Chromosome::GaChromosomeComparatorSetup& comparator,
+		Common::Workflows::GaBranch* branch)
+	{
+		// index is maintained by the population after it is built
+		if( _hashIndex.IsBuiltFor( comparator ) )
+			return true;
+
+		unsigned long long hash;
+		if( _currentSize == 0 || !comparator.GetOperation().GetHash( *_chromosomes[ 0 ]->GetChromosome(), comparator.GetParameters(), hash ) )
+			return false;
+
+		GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
+			_hashIndex.Configure( comparator, _parameters.GetPopulationSize() );
+
+		Common::Workflows::GaParallelExec1<GaPopulation, GaChromosomeStorage> popWorkDist( *branch, *this );
+		popWorkDist.Execute( GaHashIndexInsertOp( _hashIndex ), true );
+
+		return true;
+	}
+
 	// Binds tracker to population's statistics object and adds it to population's statistics trackers
 	void GaPopulation::RegisterTracker(int trackerID,
 		GaPopulationStatTracker* tracker)
@@ -277,6 +587,10 @@ namespace Population
 
 		if( _flags.IsFlagSetAll( GAPF_INITIALIZED ) )
 		{
+			// index and table are rebuilt when they are used next time
+			_hashIndex.Disable();
+			_rouletteWheel.Invalidate();
+
 			// calculate number of chromosomes that should be added or removed from the population when size change
 			int diff = newSize - _currentSize;
 			if( !parameters.GetFillOptions().IsFlagSetAny( GaPopulationParams::GAPFO_FILL_CROWDING_SPACE ) )
@@ -318,6 +632,53 @@ namespace Population
 		_events.RaiseEvent( GAPE_POPULATION_PARAMETERS_CHANGED, GaPopulationEventData( this ) );
 	}
 
+	// Evaluates chromosomes using batch evaluation
+	bool GaPopulation::CalculateFitness(GaChromosomeStorage** storage,
+		int count)
+	{
+		if( !_fitnessOperation.GetOperation().AllowsIndividualEvaluation() )
+			return false;
+
+		const int maxSize = Chromosome::GaChromosomeFitnessOperation::MAX_BATCH_SIZE;
+
+		const Chromosome::GaChromosome* objects[ maxSize ];
+		Fitness::GaFitness* fitness[ maxSize ];
+		unsigned long long hashes[ maxSize ];
+		bool hashed[ maxSize ];
+
+		for( int i = 0; i < count; )
+		{
+			// gather chromosomes whose values are not cached
+			int size = 0;
+			for( ; i < count && size < maxSize; i++ )
+			{
+				const Chromosome::GaChromosome& chromosome = *storage[ i ]->GetChromosome();
+				Fitness::GaFitness& value = storage[ i ]->GetFitness( GaChromosomeStorage::GAFT_RAW );
+
+				hashed[ size ] = _fitnessCache.IsEnabled() && _fitnessCache.GetHash( chromosome, hashes[ size ] );
+				if( !hashed[ size ] || !_fitnessCache.Find( chromosome, hashes[ size ], value ) )
+				{
+					objects[ size ] = &chromosome;
+					fitness[ size++ ] = &value;
+				}
+			}
+
+			if( size > 0 )
+			{
+				_fitnessOperation.GetOperation().EvaluateBatch( objects, fitness, size, _fitnessOperation.GetParameters() );
+
+				// store evaluated values to the cache
+				for( int j = 0; j < size; j++ )
+				{
+					if( hashed[ j ] )
+						_fitnessCache.Insert( *objects[ j ], hashes[ j ], *fitness[ j ] );
+				}
+			}
+		}
+
+		return true;
+	}
+
 	// Sets fitness operation that assigns fitness values to chromosomes in the population
 	void GaPopulation::SetFitnessOperation(const GaPopulationFitnessOperationSetup& operation)
 	{
@@ -327,6 +688,9 @@ namespace Population
 		_fitnessOperation = operation;
 		_fitnessPrototype = _fitnessOperation.GetOperation().CreateFitnessObject( _fitnessOperation.GetConfiguration().GetFitnessParams() );
 
+		// cached values were produced by previous operation
+		_fitnessCache.Clear();
+
 		UpdateStorageObjects( GaStorageFitnessObjectsUpdate( _fitnessPrototype.GetRawPtr(), GaChromosomeStorage::GAFT_RAW ) );
 
 		_flags.SetFlags( GAPF_FITNESS_OPERATION_CHANGED );
@@ -338,6 +702,7 @@ namespace Population
 	{
 		_scaledFitnessPrototype = prototype ? prototype->Clone() : NULL;
 		UpdateStorageObjects( GaStorageFitnessObjectsUpdate( _scaledFitnessPrototype.GetRawPtr(), GaChromosomeStorage::GAFT_SCALED ) );
+		_rouletteWheel.Invalidate();
 
 		_flags.SetFlags( GAPF_SCALED_FITNESS_PROTOTYPE_CHANGED );
 		_events.RaiseEvent( GAPE_SCALED_FITNESS_PROTOTYPE_CHANGED, GaPopulationEventData( this ) );
@@ -372,7 +737,8 @@ namespace Population
 		storage->SetChromosome( !chromosome.IsNull() ? chromosome : _parents[ parent ].GetChromosome(), &_parents[ parent ] );
 
 		// evaluate fitness
-		_population->CalculateFitness( *storage );
+		if( !IsEvaluationDeferred() )
+			_population->CalculateFitness( *storage );
 
 		if ( !chromosome.IsNull() )
 			_operationCounters[ GAOC_CROSSOVER_COUNT ] = 1;
@@ -391,7 +757,9 @@ namespace Population
 		_operationCounters[ GAOC_ACCEPTED_MUTATION_COUNT ]++;
 
 		storage.SetChromosome( chromosome, storage.GetParent() );
-		_population->CalculateFitness( storage );
+
+		if( !IsEvaluationDeferred() )
+			_population->CalculateFitness( storage );
 	}
 
 	// Replaces chromosome in the buffer only if new chromosome is better
@@ -402,6 +770,10 @@ namespace Population
 
 		_operationCounters[ GAOC_MUTATION_COUNT ]++;
 
+		// fitness of stored offspring is needed for comparison
+		if( IsEvaluationDeferred() )
+			_population->CalculateFitness( storage );
+
 		// calculate fitness of new chromosome
 		if( _population->CalculateFitness( newChromosome, *_tempFitness ) )
 		{
@@ -438,6 +810,46 @@ namespace Population
 			_operationCounters[ i ] = 0;
 	}
 
+	// Moves offspring to output group
+	void GaCrossoverStorageBuffer::CollectOffspring(GaChromosomeGroup& output,
+		int index)
+	{
+		for( int i = _offspring.GetCount() - 1; i >= 0; i-- )
+		{
+			GaChromosomeStorage* child = _offspring.PopLast( true );
+			output.SetAt( index + i, child );
+
+			// evaluate offspring when the chunk is full
+			if( IsEvaluationDeferred() && _evaluationChunk.Add( child ) + 1 == _evaluationChunk.GetSize() )
+				FlushOffspring();
+		}
+	}
+
+	// Evaluates deferred offspring
+	void GaCrossoverStorageBuffer::FlushOffspring()
+	{
+		if( _evaluationChunk.GetCount() > 0 )
+		{
+			// if fitness operation does not allow individual evaluation, offspring are evaluated later with the rest of the population
+			_population->CalculateFitness( _evaluationChunk.GetChromosomes(), _evaluationChunk.GetCount() );
+
+			// offspring are owned by output group, so they are not recycled
+			_evaluationChunk.Clear();
+		}
+	}
+
+	// Sets number of offspring that are evaluated together
+	void GaCrossoverStorageBuffer::SetEvaluationChunkSize(int size)
+	{
+		GA_ARG_ASSERT( Common::Exceptions::GaArgumentOutOfRangeException, size >= 0, "size", "Size of chunk cannot be negative value.", "Population" );
+
+		if( size != _evaluationChunk.GetSize() )
+		{
+			GA_ASSERT( Common::Exceptions::GaInvalidOperationException, _evaluationChunk.GetCount() == 0, "Chunk contains offspring that are not evaluated.", "Population" );
+			_evaluationChunk.SetSize( size );
+		}
+	}
+
 	// Sets population in which the mating will take place.
 	void GaCrossoverStorageBuffer::SetPopulation(GaPopulation* population)
 	{
@@ -449,6 +861,9 @@ namespace Population
 			_offspring.Clear();
 			_offspring.SetPopulation( population );
 
+			_evaluationChunk.Clear();
+			_evaluationChunk.SetPopulation( population );
+
 			_tempFitness = population ? _population->CreateFitnessObject( GaChromosomeStorage::GAFT_RAW ) : NULL;
 		}
 	}
@@ -17,6 +17,7 @@
 #include "Observing.h"
 #include "Statistics.h"
 #include "PopulationOperations.h"
+#include "ObjectiveMatrix.h"
 
 /// <summary><c>Population</c> namespace contains classes and datatypes that manage chromosome populations.</summary>
 namespace Population
@@ -141,6 +142,435 @@ namespace Population
 	/// <summary><c>GaPopulationStatTracker</c> class is interface for statistic evaluators that evaluates population and produce statistical data.</summary>
 	class GaPopulationStatTracker;
 
+	/// <summary><c>GaChromosomeHashIndex</c> class represents hash table that indexes chromosomes of the population by fingerprints of their codes.
+	/// Once the index is built for a comparator, population keeps it up to date as chromosomes are inserted and removed.
+	/// Index uses open addressing with linear probing, so multiple threads can insert chromosomes concurrently without locking while the index is built.
+	/// Removed entries are not marked but following entries are moved back, so probing sequences do not grow as chromosomes are replaced.
+	///
+	/// Index is built only if comparator can calculate fingerprints of chromosomes using <see cref="GaChromosomeComparator::GetHash" /> method.
+	/// Populations whose comparators do not implement it are not indexed and duplicates are detected by comparing chromosomes directly.
+	///
+	/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class,
+	/// but some methods are thread-safe.</summary>
+	class GaChromosomeHashIndex
+	{
+
+	private:
+
+		/// <summary><c>GaSlot</c> struct represents single entry of the index.</summary>
+		struct GaSlot
+		{
+
+			/// <summary>Indexed chromosome or <c>NULL</c> if the slot is empty.</summary>
+			GaChromosomeStorage* _chromosome;
+
+			/// <summary>Fingerprint of the chromosome.</summary>
+			unsigned long long _hash;
+
+		};
+
+		/// <summary>Entries of the index.</summary>
+		Common::Data::GaSingleDimensionArray<GaSlot> _slots;
+
+		/// <summary>Mask used to map hash to slot or -1 if the index is disabled. Number of slots is always power of 2.</summary>
+		int _mask;
+
+		/// <summary>Comparator used for calculating fingerprints and confirming equality of chromosomes.</summary>
+		Chromosome::GaChromosomeComparatorSetup _comparator;
+
+		/// <summary>Address of comparator parameters for which the index is built. It is used only to detect change of parameters.</summary>
+		const void* _parametersKey;
+
+	public:
+
+		/// <summary>Initializes disabled index.</summary>
+		GaChromosomeHashIndex() : _mask(-1),
+			_parametersKey(NULL) { }
+
+		/// <summary><c>Configure</c> method removes all chromosomes from the index, sets its comparator and prepares enough slots for the specified number of chromosomes.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="comparator">comparator used for calculating fingerprints and confirming equality of chromosomes.</param>
+		/// <param name="capacity">maximal number of chromosomes that is going to be indexed.</param>
+		GAL_API
+		void GACALL Configure(const Chromosome::GaChromosomeComparatorSetup& comparator,
+			int capacity);
+
+		/// <summary><c>Disable</c> method removes all chromosomes from the index and stops tracking changes of the population.
+		/// Index has to be configured again before it can be used.
+		///
+		/// This method is not thread-safe.</summary>
+		inline void GACALL Disable() { _mask = -1; }
+
+		/// <summary><c>Insert</c> method inserts chromosome to the index. Call has no effect if the index is disabled.
+		///
+		/// This method is thread-safe.</summary>
+		/// <param name="chromosome">pointer to chromosome that should be inserted.</param>
+		void GACALL Insert(GaChromosomeStorage* chromosome)
+		{
+			if( _mask < 0 )
+				return;
+
+			unsigned long long hash = GetHash( *chromosome->GetChromosome() );
+			for( int i = GetSlot( hash ), probes = _mask; ; i = ( i + 1 ) & _mask, probes-- )
+			{
+				GA_ASSERT( Common::Exceptions::GaInvalidOperationException, probes >= 0, "Hash index is full.", "Population" );
+
+				// reserve empty slot and publish chromosome only after its fingerprint is stored, so concurrent search never reads stale fingerprint
+				if( Common::Threading::GaAtomicOps<GaChromosomeStorage*>::CmpXchg( &_slots[ i ]._chromosome, NULL, GetReservation() ) )
+				{
+					_slots[ i ]._hash = hash;
+					Common::Threading::GaAtomicOps<GaChromosomeStorage*>::Xchg( &_slots[ i ]._chromosome, chromosome );
+					break;
+				}
+			}
+		}
+
+		/// <summary><c>Remove</c> method removes chromosome from the index. Call has no effect if the index is disabled.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="chromosome">pointer to chromosome that should be removed.</param>
+		GAL_API
+		void GACALL Remove(GaChromosomeStorage* chromosome);
+
+		/// <summary><c>Find</c> method searches for indexed chromosome whose code is equal to the code of specified chromosome.
+		/// Chromosomes are compared only if their fingerprints match.
+		///
+		/// This method is thread-safe.</summary>
+		/// <param name="chromosome">chromosome that is searched.</param>
+		/// <returns>Method returns pointer to found chromosome or <c>NULL</c> if there is no such chromosome.</returns>
+		GaChromosomeStorage* GACALL Find(const Chromosome::GaChromosome& chromosome) const
+		{
+			if( _mask < 0 )
+				return NULL;
+
+			unsigned long long hash = GetHash( chromosome );
+			for( int i = GetSlot( hash ), probes = _mask; probes >= 0; i = ( i + 1 ) & _mask, probes-- )
+			{
+				GaChromosomeStorage* indexed = _slots[ i ]._chromosome;
+				if( !indexed )
+					break;
+
+				// skip slots whose chromosomes are not published yet
+				if( indexed != GetReservation() && _slots[ i ]._hash == hash &&
+					_comparator.GetOperation().Equal( chromosome, *indexed->GetChromosome(), _comparator.GetParameters() ) )
+					return indexed;
+			}
+
+			return NULL;
+		}
+
+		/// <summary>This method is thread-safe.</summary>
+		/// <returns>Method returns <c>true</c> if the index is enabled.</returns>
+		inline bool GACALL IsEnabled() const { return _mask >= 0; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <param name="comparator">comparator that should be checked.</param>
+		/// <returns>Method returns <c>true</c> if the index is enabled and built using specified comparator.</returns>
+		inline bool GACALL IsBuiltFor(const Chromosome::GaChromosomeComparatorSetup& comparator) const
+			{ return _mask >= 0 && &_comparator.GetOperation() == &comparator.GetOperation() && _parametersKey == GetParametersKey( comparator ); }
+
+	private:
+
+		/// <summary><c>GetHash</c> method calculates fingerprint of the chromosome using index's comparator.</summary>
+		/// <param name="chromosome">chromosome whose fingerprint should be calculated.</param>
+		/// <returns>Method returns fingerprint of the chromosome.</returns>
+		inline unsigned long long GACALL GetHash(const Chromosome::GaChromosome& chromosome) const
+		{
+			unsigned long long hash = 0;
+			_comparator.GetOperation().GetHash( chromosome, _comparator.GetParameters(), hash );
+			return hash;
+		}
+
+		/// <summary>Reserved slots store address of the index instead of chromosome while their fingerprints are written.</summary>
+		/// <returns>Method returns value that marks reserved slot.</returns>
+		inline GaChromosomeStorage* GACALL GetReservation() const { return (GaChromosomeStorage*)this; }
+
+		/// <summary><c>GetSlot</c> method maps fingerprint to the first slot that should be probed.
+		/// Bits of the fingerprint are mixed first, so fingerprints which differ only in higher bits are spread across the index.</summary>
+		/// <param name="hash">fingerprint of the chromosome.</param>
+		/// <returns>Method returns index of the slot.</returns>
+		inline int GACALL GetSlot(unsigned long long hash) const
+		{
+			hash ^= hash >> 33;
+			hash *= 0xff51afd7ed558ccdULL;
+			hash ^= hash >> 33;
+
+			return (int)hash & _mask;
+		}
+
+		/// <summary>This method is thread-safe.</summary>
+		/// <param name="comparator">comparator setup.</param>
+		/// <returns>Method returns address of comparator parameters or <c>NULL</c> if comparator has no parameters.</returns>
+		static inline const void* GACALL GetParametersKey(const Chromosome::GaChromosomeComparatorSetup& comparator)
+			{ return comparator.HasParameters() ? &comparator.GetParameters() : NULL; }
+
+	};
+
+	class GaPopulation;
+
+	/// <summary><c>GaRouletteWheelTable</c> class stores cumulative selection probabilities of chromosomes in the population,
+	/// so roulette wheel mechanism can find selected chromosome using binary search instead of summing probabilities for each selection.
+	/// Table is shared by all branches and it is rebuilt only when modification stamp of the population is changed.
+	/// Probabilities are summed in blocks of fixed size, so the table does not depend on number of branches that build it.
+	///
+	/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class,
+	/// but some methods are thread-safe.</summary>
+	class GaRouletteWheelTable
+	{
+
+	public:
+
+		/// <summary>Number of chromosomes whose probabilities are summed by a single branch before the partial sums are combined.</summary>
+		static const int BLOCK_SIZE = 256;
+
+	private:
+
+		/// <summary>Cumulative selection probabilities of chromosomes.</summary>
+		Common::Data::GaSingleDimensionArray<float> _cumulative;
+
+		/// <summary>Sums of selection probabilities of chromosomes in each block.</summary>
+		Common::Data::GaSingleDimensionArray<float> _blockSums;
+
+		/// <summary>Indicates whether the table has been built.</summary>
+		bool _built;
+
+		/// <summary>Modification stamp of the population at the time the table was built.</summary>
+		long _stamp;
+
+	public:
+
+		/// <summary>Initializes empty table.</summary>
+		GaRouletteWheelTable() : _built(false),
+			_stamp(0) { }
+
+		/// <summary><c>Update</c> method builds table of cumulative selection probabilities if it does not match the current state of the population.
+		/// This method must be executed by all branches of the workflow.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="population">population over which the selection operation is performed.</param>
+		/// <param name="branch">pointer to workflow branch that executes the method.</param>
+		GAL_API
+		void GACALL Update(GaPopulation& population,
+			Common::Workflows::GaBranch* branch);
+
+		/// <summary><c>Invalidate</c> method forces the table to be rebuilt next time it is updated.
+		///
+		/// This method is not thread-safe.</summary>
+		inline void GACALL Invalidate() { _built = false; }
+
+		/// <summary><c>GetIndex</c> method implements roulette wheel mechanism for selection chromosomes.
+		///
+		/// This method is thread-safe.</summary>
+		/// <param name="totalProbability">sum of selection probabilities of all chromosomes in the population.</param>
+		/// <returns>Method returns index of selected chromosome.</returns>
+		int GACALL GetIndex(float totalProbability) const
+		{
+			// generate random value
+			float random = GaGlobalRandomFloatGenerator->Generate( totalProbability );
+
+			// find the first chromosome whose cumulative probability reaches random value
+			int low = 0, high = _cumulative.GetSize() - 1;
+			while( low < high )
+			{
+				int middle = ( low + high ) / 2;
+
+				if( _cumulative[ middle ] >= random )
+					high = middle;
+				else
+					low = middle + 1;
+			}
+
+			return low;
+		}
+
+	private:
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <param name="population">population over which the selection operation is performed.</param>
+		/// <returns>Method returns <c>true</c> if the table matches the current state of the population.</returns>
+		bool GACALL IsCurrent(const GaPopulation& population) const;
+
+	};
+
+	/// <summary><c>GaFitnessCache</c> class stores fitness values of recently evaluated chromosomes, so evaluation of chromosomes whose codes are equal
+	/// to codes of already evaluated chromosomes can be skipped. Entries are located by fingerprints of chromosome codes and equality of codes is confirmed
+	/// by chromosome comparator. Cache is set-associative: fingerprint selects set of <c>WAYS</c> entries and victim within the set is chosen
+	/// using CLOCK algorithm. Sets are protected by striped spinlocks, so multiple threads can use the cache concurrently.
+	///
+	/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class,
+	/// but some methods are thread-safe.</summary>
+	class GaFitnessCache
+	{
+
+	public:
+
+		/// <summary>Number of entries in a single set.</summary>
+		static const int WAYS = 4;
+
+		/// <summary>Number of spinlocks that protect sets. It must be power of 2.</summary>
+		static const int LOCK_COUNT = 64;
+
+	private:
+
+		/// <summary><c>GaEntry</c> struct represents single entry of the cache.</summary>
+		struct GaEntry
+		{
+
+			/// <summary>Copy of evaluated chromosome or <c>NULL</c> if the entry is empty.</summary>
+			Chromosome::GaChromosomePtr _chromosome;
+
+			/// <summary>Fitness value of the chromosome.</summary>
+			Fitness::GaFitness* _fitness;
+
+			/// <summary>Fingerprint of the chromosome.</summary>
+			unsigned long long _hash;
+
+			/// <summary>Indicates that the entry has been used since CLOCK hand has passed it last time.</summary>
+			bool _referenced;
+
+			/// <summary>Initializes empty entry.</summary>
+			GaEntry() : _fitness(NULL),
+				_hash(0),
+				_referenced(false) { }
+
+		};
+
+		/// <summary>Entries of the cache grouped by sets.</summary>
+		Common::Data::GaSingleDimensionArray<GaEntry> _entries;
+
+		/// <summary>Positions of CLOCK hands of the sets.</summary>
+		Common::Data::GaSingleDimensionArray<int> _hands;
+
+		/// <summary>Mask used to map hash to set or -1 if the cache is disabled. Number of sets is always power of 2.</summary>
+		int _setMask;
+
+		/// <summary>Comparator used for calculating fingerprints and confirming equality of chromosomes.</summary>
+		Chromosome::GaChromosomeComparatorSetup _comparator;
+
+		/// <summary>Number of successful lookups since counters were taken last time.</summary>
+		volatile long _hits;
+
+		/// <summary>Number of failed lookups since counters were taken last time.</summary>
+		volatile long _misses;
+
+		/// <summary>Spinlocks that protect sets.</summary>
+		mutable Common::Threading::GaSpinlock _locks[ LOCK_COUNT ];
+
+	public:
+
+		/// <summary>Initializes disabled cache.</summary>
+		GaFitnessCache() : _setMask(-1),
+			_hits(0),
+			_misses(0) { }
+
+		/// <summary>Frees memory used by cached fitness values.</summary>
+		~GaFitnessCache() { Clear(); }
+
+		/// <summary><c>Configure</c> method removes all entries from the cache and sets its capacity and comparator.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="size">number of chromosomes that cache can store. It is rounded up so the number of sets is power of 2.
+		/// If this parameter is set to 0, cache is disabled.</param>
+		/// <param name="comparator">comparator used for calculating fingerprints and confirming equality of chromosomes.</param>
+		/// <exception cref="GaArgumentOutOfRangeException" />Thrown if <c>size</c> is negative.</exception>
+		/// <exception cref="GaArgumentException" />Thrown if cache is enabled but comparator is not specified.</exception>
+		GAL_API
+		void GACALL Configure(int size,
+			const Chromosome::GaChromosomeComparatorSetup& comparator);
+
+		/// <summary><c>Clear</c> method removes all entries from the cache, but it keeps the configuration.
+		///
+		/// This method is not thread-safe.</summary>
+		GAL_API
+		void GACALL Clear();
+
+		/// <summary><c>Find</c> method searches for chromosome whose code is equal to the code of specified chromosome and copies its cached fitness value.
+		///
+		/// This method is thread-safe.</summary>
+		/// <param name="chromosome">chromosome whose fitness value is queried.</param>
+		/// <param name="hash">fingerprint of the chromosome.</param>
+		/// <param name="fitness">reference to object that will store cached fitness value.</param>
+		/// <returns>Method returns <c>true</c> if the cache has fitness value of the chromosome.</returns>
+		GAL_API
+		bool GACALL Find(const Chromosome::GaChromosome& chromosome,
+			unsigned long long hash,
+			Fitness::GaFitness& fitness);
+
+		/// <summary><c>Insert</c> method stores copies of the chromosome and its fitness value in the cache.
+		/// If the set selected by fingerprint is full, CLOCK algorithm chooses the entry that is going to be replaced.
+		///
+		/// This method is thread-safe.</summary>
+		/// <param name="chromosome">chromosome whose fitness value should be stored.</param>
+		/// <param name="hash">fingerprint of the chromosome.</param>
+		/// <param name="fitness">fitness value of the chromosome.</param>
+		GAL_API
+		void GACALL Insert(const Chromosome::GaChromosome& chromosome,
+			unsigned long long hash,
+			const Fitness::GaFitness& fitness);
+
+		/// <summary><c>GetHash</c> method calculates fingerprint of the chromosome using cache's comparator.
+		///
+		/// This method is thread-safe.</summary>
+		/// <param name="chromosome">chromosome whose fingerprint should be calculated.</param>
+		/// <param name="hash">reference to variable that will store calculated fingerprint.</param>
+		/// <returns>Method returns <c>true</c> if the fingerprint is calculated.</returns>
+		/// <exception cref="GaInvalidOperationException" />Thrown if the comparator does not support hashing, since such cache would never be used.</exception>
+		inline bool GACALL GetHash(const Chromosome::GaChromosome& chromosome,
+			unsigned long long& hash) const
+		{
+			bool hashed = _comparator.GetOperation().GetHash( chromosome, _comparator.GetParameters(), hash );
+			GA_ASSERT( Common::Exceptions::GaInvalidOperationException, hashed, "Chromosome comparator used by fitness cache does not support hashing.", "Population" );
+
+			return hashed;
+		}
+
+		/// <summary><c>TakeCounters</c> method returns number of hits and misses and restarts counters.
+		///
+		/// This method is thread-safe.</summary>
+		/// <param name="hits">reference to variable that will store number of successful lookups.</param>
+		/// <param name="misses">reference to variable that will store number of failed lookups.</param>
+		inline void GACALL TakeCounters(int& hits,
+			int& misses)
+		{
+			hits = (int)Common::Threading::GaAtomicOps<long>::Xchg( &_hits, 0 );
+			misses = (int)Common::Threading::GaAtomicOps<long>::Xchg( &_misses, 0 );
+		}
+
+		/// <summary>This method is thread-safe.</summary>
+		/// <returns>Method returns <c>true</c> if the cache is enabled.</returns>
+		inline bool GACALL IsEnabled() const { return _setMask >= 0; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns number of chromosomes that cache can store.</returns>
+		inline int GACALL GetSize() const { return _entries.GetSize(); }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns comparator used for calculating fingerprints and confirming equality of chromosomes.</returns>
+		inline const Chromosome::GaChromosomeComparatorSetup& GACALL GetComparator() const { return _comparator; }
+
+	private:
+
+		/// <summary><c>GetSet</c> method maps fingerprint to the set. Bits of the fingerprint are mixed first, so fingerprints which differ
+		/// only in higher bits are spread across the cache.</summary>
+		/// <param name="hash">fingerprint of the chromosome.</param>
+		/// <returns>Method returns index of the set.</returns>
+		inline int GACALL GetSet(unsigned long long hash) const
+		{
+			hash ^= hash >> 33;
+			hash *= 0xff51afd7ed558ccdULL;
+			hash ^= hash >> 33;
+
+			return (int)hash & _setMask;
+		}
+
+		/// <summary>This method is thread-safe.</summary>
+		/// <param name="set">index of the set.</param>
+		/// <returns>Method returns spinlock that protects specified set.</returns>
+		inline Common::Threading::GaSpinlock& GACALL GetLock(int set) const { return _locks[ set & ( LOCK_COUNT - 1 ) ]; }
+
+	};
+
 	/// <summary><c>GaPopulation</c> class stores chromosomes and track their statistics. Population also defines genetic operations that will be used on chromosomes.
 	///
 	/// This class has built-in synchronizator so it is allowed to use <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros with instances of this class,
@@ -242,20 +672,27 @@ namespace Population
 			/// <summary>Lifecycle manager of new tag.</summary>
 			const Common::Data::GaTagLifecycle& _tagLifecycle;
 
+			/// <summary>Tag manager that handles chromosomes' tags.</summary>
+			const Common::Data::GaTagManager& _tagManager;
+
 		public:
 
 			/// <summary>Initializes update policy.</summary>
 			/// <param name="index">in buffer at which the new tag should be added.</param>
 			/// <param name="tagLifecycle">lifecycle manager of new tag.</param>
+			/// <param name="tagManager">tag manager that handles chromosomes' tags.</param>
 			GaAddStorageTag(int index,
-				const Common::Data::GaTagLifecycle& tagLifecycle) : _index(index),
-				_tagLifecycle(tagLifecycle) { }
+				const Common::Data::GaTagLifecycle& tagLifecycle,
+				const Common::Data::GaTagManager& tagManager) : _index(index),
+				_tagLifecycle(tagLifecycle),
+				_tagManager(tagManager) { }
 
-			/// <summary><c>operator()</c> add tag at specified position using prototype to create new tag.
+			/// <summary><c>operator()</c> add tag at specified position using prototype to create new tag or binds tag stored in column.
 			///
 			/// This operator is thread-safe.</summary>
 			/// <param name="object">pointer to chromosome storage object which should be updated.</param>
-			virtual void GACALL operator ()(GaChromosomeStorage* object) const { object->GetTags().SetTag( _index, _tagLifecycle.CreateTag() ); }
+			virtual void GACALL operator ()(GaChromosomeStorage* object) const
+				{ _tagManager.InitTag( object->GetTags(), _index, object->GetTagSlot(), _tagLifecycle ); }
 
 		};
 
@@ -358,7 +795,8 @@ namespace Population
 			/// <param name="index">index at which the tag should be inserted into buffer.</param>
 			/// <param name="tagLifecycle">lifecycle manager of new tag.</param>
 			virtual void GACALL AddTag(int index,
-				const Common::Data::GaTagLifecycle& tagLifecycle) const { _population->UpdateStorageObjects( GaAddStorageTag( index, tagLifecycle ) ); }
+				const Common::Data::GaTagLifecycle& tagLifecycle) const
+				{ _population->UpdateStorageObjects( GaAddStorageTag( index, tagLifecycle, _population->GetChromosomeTagManager() ) ); }
 
 			/// <summary><c>RemoveTag</c> method removes tag from the buffers of all chromosomes in the population.
 			///
@@ -452,7 +890,9 @@ namespace Population
 				GaChromosomeStorage* storage = new GaChromosomeStorage( _population->CreateFitnessObject( GaChromosomeStorage::GAFT_RAW ),
 					_population->CreateFitnessObject( GaChromosomeStorage::GAFT_SCALED ) );
 
-				_population->GetChromosomeTagManager().InitBuffer( storage->GetTags() );
+				// assign slot in tag columns
+				storage->SetTagSlot( _population->GetChromosomeTagManager().AcquireSlot() );
+				_population->GetChromosomeTagManager().InitBuffer( storage->GetTags(), storage->GetTagSlot() );
 
 				return storage;
 			}
@@ -463,8 +903,32 @@ namespace Population
 
 		};
 
-		/// <summary><c>GaStorageDelete</c> type defines object pool deletion policy for chromosome storage objects.</summary>
-		typedef Common::Memory::GaPoolObjectDelete<GaChromosomeStorage> GaDeleteStorage;
+		/// <summary><c>GaDeleteStorage</c> class implements object pool deletion policy for chromosome storage objects.</summary>
+		class GaDeleteStorage
+		{
+
+		private:
+
+			/// <summary>Population for which chromosomes storage objects were created.</summary>
+			GaPopulation* _population;
+
+		public:
+
+			/// <summary><c>operator()</c> releases slot in tag columns and destroys chromosome storage object.
+			///
+			/// This operator is thread-safe.</summary>
+			/// <param name="object">pointer to chromosome storage object which should be destroyed.</param>
+			inline void GACALL operator ()(GaChromosomeStorage* object) const
+			{
+				_population->GetChromosomeTagManager().ReleaseSlot( object->GetTagSlot() );
+				delete object;
+			}
+
+			/// <summary>Sets population for which the chromosomes storage objects are created.<summary>
+			/// <param name="population">pointer to the population.</param>
+			inline void SetPopulation(GaPopulation* population) { _population = population; }
+
+		};
 
 		/// <summary><c>GaInitStorage</c> class implements object pool initialization policy for chromosome storage objects.</summary>
 		class GaInitStorage
@@ -553,6 +1017,9 @@ namespace Population
 		/// <summary>Number of chromosomes currently in the population.</summary>
 		int _currentSize;
 
+		/// <summary>Counter of changes of chromosomes' membership, order and scaled fitness values. It is used to detect stale data derived from the population.</summary>
+		volatile long _modificationStamp;
+
 		/// <summary>Sorting algorithm used for sorting chromosomes in the population.</summary>
 		Common::Sorting::GaMergeSortAlgorithm<GaChromosomeStorage*> _sorting;
 
@@ -589,6 +1056,18 @@ namespace Population
 		/// <summary>Stores registered statistical trackers of the population.</summary>
 		STLEXT::hash_map<int, std::pair<bool, GaPopulationStatTracker*> > _registeredTrackers;
 
+		/// <summary>Index of chromosomes by fingerprints of their codes.</summary>
+		GaChromosomeHashIndex _hashIndex;
+
+		/// <summary>Cache of fitness values of recently evaluated chromosomes.</summary>
+		GaFitnessCache _fitnessCache;
+
+		/// <summary>Cumulative selection probabilities used by roulette wheel selections.</summary>
+		GaRouletteWheelTable _rouletteWheel;
+
+		/// <summary>Packed matrix of objective values used by multiobjective operations.</summary>
+		GaObjectiveMatrix _objectiveMatrix;
+
 	public:
 
 		/// <summary>Constructs population.</summary>
@@ -603,7 +1082,13 @@ namespace Population
 			const Fitness::GaFitnessComparatorSetup& fitnessComparator);
 
 		/// <summary>Frees resources used by the popyulation.</summary>
-		~GaPopulation() { Clear( true ); }
+		~GaPopulation()
+		{
+			Clear( true );
+
+			// storage objects should release their slots before tag manager is destroyed
+			_chromosomeStoragePool.Invalidate();
+		}
 
 		/// <summary><c>Initialize</c> method prepares population to be used by genetic algorithm. 
 		///
@@ -627,6 +1112,8 @@ namespace Population
 		{
 			_chromosomes[ _currentSize++ ] = chromosome;
 			_newChromosomes.Add( chromosome );
+			_hashIndex.Insert( chromosome );
+			_modificationStamp++;
 		}
 
 		/// <summary><c>Insert</c> method inserts multiple chromosomes into population.
@@ -713,6 +1200,7 @@ namespace Population
 		}
 
 		/// <summary><c>CalculateFitness</c> method calculate fitness value of chromosome storage object and store that value in specified fitness object.
+		/// If fitness cache is enabled and it has the value for chromosome with equal code, evaluation is skipped and cached value is copied.
 		///
 		/// This method is not thread-safe.</summary>
 		/// <param name="chromosome">smart pointer to chromosome whose fitness value should be evaluated.</param>
@@ -724,7 +1212,18 @@ namespace Population
 		{
 			bool calculate = _fitnessOperation.GetOperation().AllowsIndividualEvaluation();
 			if( calculate )
-				_fitnessOperation.GetOperation()( *chromosome, fitness, _fitnessOperation.GetParameters() );
+			{
+				unsigned long long hash;
+				bool cache = _fitnessCache.IsEnabled() && _fitnessCache.GetHash( *chromosome, hash );
+
+				if( !cache || !_fitnessCache.Find( *chromosome, hash, fitness ) )
+				{
+					_fitnessOperation.GetOperation()( *chromosome, fitness, _fitnessOperation.GetParameters() );
+
+					if( cache )
+						_fitnessCache.Insert( *chromosome, hash, fitness );
+				}
+			}
 
 			return calculate;
 		}
@@ -737,6 +1236,18 @@ namespace Population
 		/// does not allow individual-based fitness evaluation of chromosomes this method returns <c>false</c></returns>
 		inline bool GACALL CalculateFitness(GaChromosomeStorage& storage) { return CalculateFitness( storage.GetChromosome(), storage.GetFitness( GaChromosomeStorage::GAFT_RAW ) ); }
 
+		/// <summary><c>CalculateFitness</c> method calculate fitness values of multiple chromosome storage objects using batch evaluation
+		/// provided by fitness operation. Chromosomes whose values are found in fitness cache are not passed to fitness operation.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="storage">array of pointers to storage objects that contain chromosomes whose values should be evaluated.</param>
+		/// <param name="count">number of storage objects in the array.</param>
+		/// <returns>Method returns <c>true</c>if fitness values of chromosomes are evaluated. If fitness operation used by population
+		/// does not allow individual-based fitness evaluation of chromosomes this method returns <c>false</c></returns>
+		GAL_API
+		bool GACALL CalculateFitness(GaChromosomeStorage** storage,
+			int count);
+
 		/// <summary><c>NextGeneration</c> evaluates population's statistics and prepares population for the next generation.
 		///
 		/// This method is not thread-safe.</summary>
@@ -750,7 +1261,31 @@ namespace Population
 		/// <typeparam name="CRITERIA">type of sorting criteria used for sorting.</typeparam>
 		/// <param name="criteria">reference to criteria used for sorting population.</param>
 		template<typename CRITERIA>
-		inline void GACALL Sort(const CRITERIA& criteria) { _chromosomes = _sorting.Sort( criteria ); }
+		inline void GACALL Sort(const CRITERIA& criteria)
+		{
+			_chromosomes = _sorting.Sort( criteria );
+			_modificationStamp++;
+		}
+
+		/// <summary><c>Sort</c> method sorts population using provided sorting criteria and splits the work among branches that execute current flow step.
+		/// All branches that execute current flow step must call this method.
+		///
+		/// This method is thread-safe.</summary>
+		/// <typeparam name="CRITERIA">type of sorting criteria used for sorting.</typeparam>
+		/// <param name="branch">pointer to branch that execute operation.</param>
+		/// <param name="criteria">reference to criteria used for sorting population.</param>
+		template<typename CRITERIA>
+		inline void GACALL Sort(Common::Workflows::GaBranch* branch,
+			const CRITERIA& criteria)
+		{
+			GaChromosomeStorage** sorted = _sorting.Sort( branch, criteria );
+
+			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
+			{
+				_chromosomes = sorted;
+				_modificationStamp++;
+			}
+		}
 
 		/// <summary><c>Sort</c> method sorts chromosomes in specified range using provided sorting criteria.
 		/// Method can be executed concurently from different threads only when sorting non-overlapping portions of the array.
@@ -763,12 +1298,20 @@ namespace Population
 		template<typename CRITERIA>
 		inline void GACALL Sort(int begin,
 			int end,
-			const CRITERIA& criteria) { _chromosomes = _sorting.Sort( begin, end, criteria ); }
+			const CRITERIA& criteria)
+		{
+			_chromosomes = _sorting.Sort( begin, end, criteria );
+			Common::Threading::GaAtomicOps<long>::Inc( &_modificationStamp );
+		}
 
 		/// <summary><c>Shuffle</c> method arranges chromosomes of the group in random order.
 		///
 		/// This method is not thread-safe.</summary>
-		inline void GACALL Shuffle() { Common::Random::GaShuffle( _chromosomes, _currentSize ); }
+		inline void GACALL Shuffle()
+		{
+			Common::Random::GaShuffle( _chromosomes, _currentSize );
+			_modificationStamp++;
+		}
 
 		/// <summary><c>MakeFromPrototype</c> method produces new chromosome using provided chromosome initializator.
 		///
@@ -814,6 +1357,26 @@ namespace Population
 		/// <br/>c.  1 if the first chromosome has worse fitness value then the second.</returns>
 		inline int GACALL CompareFitness(const GaChromosomeStorage& chromosome1,
 			const GaChromosomeStorage& chromosome2) const { return CompareFitness( chromosome1.GetFitness( GaChromosomeStorage::GAFT_RAW ), chromosome2.GetFitness( GaChromosomeStorage::GAFT_RAW ) ); }
+
+		/// <summary><c>GetFitnessSortKey</c> method extracts sort key from fitness value of the chromosome using population's default fitness comparator.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="chromosome">reference to chromosome whose fitness value is used.</param>
+		/// <param name="key">reference to variable that will store extracted key.</param>
+		/// <returns>Method returns <c>false</c> if the comparator does not support key extraction.</returns>
+		inline bool GACALL GetFitnessSortKey(const GaChromosomeStorage& chromosome,
+			double& key) const { return _fitnessComparator.GetOperation().GetSortKey( chromosome.GetFitness( GaChromosomeStorage::GAFT_RAW ), _fitnessComparator.GetParameters(), key ); }
+
+		/// <summary><c>GetFitnessObjectiveKeys</c> method extracts keys of all objectives from fitness value of the chromosome using population's default fitness comparator.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="chromosome">reference to chromosome whose fitness value is used.</param>
+		/// <param name="keys">pointer to array that will store extracted keys.</param>
+		/// <param name="count">number of objectives.</param>
+		/// <returns>Method returns <c>false</c> if the comparator does not support extraction of objective keys.</returns>
+		inline bool GACALL GetFitnessObjectiveKeys(const GaChromosomeStorage& chromosome,
+			double* keys,
+			int count) const { return _fitnessComparator.GetOperation().GetObjectiveKeys( chromosome.GetFitness( GaChromosomeStorage::GAFT_RAW ), _fitnessComparator.GetParameters(), keys, count ); }
 		
 		/// <summary><c>RegisterTracker</c> method adds tracket to list of population's statistical trackers and bounds it to population's statistics object.
 		///
@@ -1074,6 +1637,17 @@ namespace Population
 		/// <returns>Method returns reference to flag object that stores current stats of population's flags.</returns>
 		inline const GaFlagType& GACALL GetFlags() const { return _flags; }
 
+		/// <summary><c>MarkModified</c> method changes modification stamp of the population. Operations that change scaled fitness values of chromosomes
+		/// must call this method, so data derived from the population, like roulette wheel table, is rebuilt. Insertion, removal and sorting
+		/// of chromosomes change the stamp automatically.
+		///
+		/// This method is thread-safe.</summary>
+		inline void GACALL MarkModified() { Common::Threading::GaAtomicOps<long>::Inc( &_modificationStamp ); }
+
+		/// <summary>This method is thread-safe.</summary>
+		/// <returns>Method returns current modification stamp of the population.</returns>
+		inline long GACALL GetModificationStamp() const { return _modificationStamp; }
+
 		/// <summary>This method is not thread-safe.</summary>
 		/// <returns>Method returns reference to population's flags manager.</returns>
 		inline Common::Data::GaFlagManager<GaChromosomeStorage::GaFlagType::GaDataType>& GACALL GetChromosomeFlagManager() { return _chromosomeFlagManager; }
@@ -1090,6 +1664,57 @@ namespace Population
 		/// <returns>Method returns reference to object that stores statistical information about this population.</returns>
 		inline const Statistics::GaStatistics& GACALL GetStatistics() const { return _statistics; }
 
+		/// <summary><c>BuildHashIndex</c> method indexes chromosomes of the population by fingerprints calculated by specified comparator.
+		/// Index is built only if it does not exist or if it was built for another comparator, otherwise it is already up to date
+		/// since the population maintains it when chromosomes are inserted or removed. This method must be executed by all branches of the workflow.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="comparator">comparator used for calculating fingerprints and confirming equality of chromosomes.</param>
+		/// <param name="branch">pointer to workflow branch that executes the method.</param>
+		/// <returns>Method returns <c>false</c> if the comparator does not support hashing in which case the index is not built.</returns>
+		GAL_API
+		bool GACALL BuildHashIndex(const Chromosome::GaChromosomeComparatorSetup& comparator,
+			Common::Workflows::GaBranch* branch);
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns reference to index of chromosomes by fingerprints of their codes.</returns>
+		inline const GaChromosomeHashIndex& GACALL GetHashIndex() const { return _hashIndex; }
+
+		/// <summary><c>SetFitnessCache</c> method enables or disables caching of fitness values of evaluated chromosomes.
+		/// Cache can be used only with comparators that support hashing of chromosomes and only if fitness value depends solely on chromosome's code.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="size">number of chromosomes that cache can store. If this parameter is set to 0, cache is disabled.</param>
+		/// <param name="comparator">comparator used for calculating fingerprints and confirming equality of chromosomes.</param>
+		/// <summary><c>SetFitnessCache</c> method sets capacity of the cache of fitness values and comparator used to find chromosomes with equal codes.
+		/// Comparator must implement <see cref="GaChromosomeComparator::GetHash" /> method, otherwise the first evaluation that uses the cache fails.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="size">number of chromosomes that cache can store. If this parameter is set to 0, cache is disabled.</param>
+		/// <param name="comparator">comparator used for calculating fingerprints and confirming equality of chromosomes.</param>
+		inline void GACALL SetFitnessCache(int size,
+			const Chromosome::GaChromosomeComparatorSetup& comparator) { _fitnessCache.Configure( size, comparator ); }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns reference to cache of fitness values of recently evaluated chromosomes.</returns>
+		inline GaFitnessCache& GACALL GetFitnessCache() { return _fitnessCache; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns reference to cache of fitness values of recently evaluated chromosomes.</returns>
+		inline const GaFitnessCache& GACALL GetFitnessCache() const { return _fitnessCache; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns reference to packed matrix of objective values used by multiobjective operations.</returns>
+		inline GaObjectiveMatrix& GACALL GetObjectiveMatrix() { return _objectiveMatrix; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns reference to cumulative selection probabilities used by roulette wheel selections.</returns>
+		inline GaRouletteWheelTable& GACALL GetRouletteWheel() { return _rouletteWheel; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns reference to packed matrix of objective values used by multiobjective operations.</returns>
+		inline const GaObjectiveMatrix& GACALL GetObjectiveMatrix() const { return _objectiveMatrix; }
+
 		/// <summary>This method is thread-safe.</summary>
 		/// <returns>Method returns reference to event manager of the population.</returns>
 		inline Common::Observing::GaEventManager& GACALL GetEventManager() { return _events; }
@@ -1115,6 +1740,10 @@ namespace Population
 		/// This method is not thread-safe.</summary>
 		inline void GACALL InvalidateStoragePool() { _chromosomeStoragePool.Invalidate(); }
 
+		/// <summary>This method is thread-safe, but values may be stale if other threads use the pool concurrently.</summary>
+		/// <returns>Method returns statistical information about operations performed by thread-local magazines of the pool that recycles storage objects.</returns>
+		inline Common::Memory::GaObjectPoolStatistics GACALL GetStoragePoolStatistics() const { return _chromosomeStoragePool.GetStatistics(); }
+
 		/// <summary><c>UpdateStorageObjects</c> method updates storage objects of the population (both used and currently unused objects).
 		///
 		/// This method is not thread-safe.</summary>
@@ -1134,6 +1763,8 @@ namespace Population
 
 			// move specified chromosome to list of removed chromosomes
 			_removedChromosomes.Add( chromosome );
+			_hashIndex.Remove( chromosome );
+			_modificationStamp++;
 		}
 
 	};
@@ -1168,6 +1799,12 @@ namespace Population
 		inline int GACALL operator ()(GaConstType& object1,
 			GaConstType& object2) const { return _population->CompareFitness( *object1, *object2 ); }
 
+		/// <summary>More details are given in specification of <see cref="GaSortingCriteria::GetSortKey" /> method.
+		///
+		/// This method is thread-safe.</summary>
+		inline bool GACALL GetSortKey(GaConstType& object,
+			double& key) const { return _population->GetFitnessSortKey( *object, key ); }
+
 		/// <summary>This method is thread-safe.</summary>
 		/// <returns>Method returns pointer to population whose fitness comparator is used as sorting criteria.</returns>
 		inline GaPopulation* GetPopulation() { return _population; }
@@ -1217,6 +1854,14 @@ namespace Population
 		virtual int GACALL operator ()(GaConstType& object1,
 			GaConstType& object2) const { return _comparator.GetOperation()( object1->GetFitness( _fitnessType ), object2->GetFitness( _fitnessType ), _comparator.GetParameters() ); }
 
+		/// <summary>More details are given in specification of <see cref="GaSortingCriteria::GetSortKey" /> method.
+		/// Method is virtual like the comparison operator, so sorting uses keys of derived criteria. Derived criteria that change the comparison
+		/// must also override this method, either to return consistent keys or to return <c>false</c>.
+		///
+		/// This method is thread-safe.</summary>
+		virtual bool GACALL GetSortKey(GaConstType& object,
+			double& key) const { return _comparator.GetOperation().GetSortKey( object->GetFitness( _fitnessType ), _comparator.GetParameters(), key ); }
+
 		/// <summary>This method is thread-safe.</summary>
 		/// <returns>Method returns pointer to setup that stores fitness comparator and its paramter that is used as sorting criteria.</returns>
 		inline Fitness::GaFitnessComparatorSetup& GACALL GetComparator() { return _comparator; }
@@ -1269,6 +1914,10 @@ namespace Population
 		/// <summary>Group that stores offspring chromosomes.</summary>
 		GaChromosomeGroup _offspring;
 
+		/// <summary>Group that stores offspring chromosomes produced by previous matings whose evaluation is deferred.
+		/// Size of the group defines number of offspring that are evaluated together. If size is 0, offspring are evaluated as soon as they are stored.</summary>
+		GaChromosomeGroup _evaluationChunk;
+
 		/// <summary>Temporary fitness value used for fitness calculations.</summary>
 		Common::Memory::GaAutoPtr<Fitness::GaFitness> _tempFitness;
 
@@ -1286,7 +1935,8 @@ namespace Population
 			int parentCount,
 			int offspringCount) : _population(population),
 			_parents(false, parentCount),
-			_offspring(false, offspringCount, 0, NULL, true)
+			_offspring(false, offspringCount, 0, NULL, true),
+			_evaluationChunk(false, 0, 0, NULL, false)
 		{
 			SetPopulation( population );
 			Clear();
@@ -1295,7 +1945,8 @@ namespace Population
 		/// <summary>This constructor initializes new buffer by copying settings of existing buffer.</summary>
 		/// <param name="rhs">buffer that should be copied.</param>
 		GaCrossoverStorageBuffer(const GaCrossoverStorageBuffer& rhs) : _parents(false, rhs._parents.GetSize()),
-			_offspring(false, rhs._offspring.GetSize(), 0, NULL, true)
+			_offspring(false, rhs._offspring.GetSize(), 0, NULL, true),
+			_evaluationChunk(false, rhs._evaluationChunk.GetSize(), 0, NULL, false)
 		{
 			SetPopulation( rhs._population );
 			Clear();
@@ -1335,11 +1986,49 @@ namespace Population
 			Chromosome::GaChromosomePtr newChromosome);
 
 		/// <summary><c>Clear</c> method removes all parent and offspring chromosomes from the buffer and prepares buffer for next execution of the operation.
+		/// Offspring whose evaluation is deferred are not removed.
 		///
 		/// This method is thread-safe.</summary>
 		GAL_API
 		void GACALL Clear();
 
+		/// <summary><c>CollectOffspring</c> method removes offspring chromosomes produced by the last mating from the buffer and stores them to output group
+		/// at positions reserved for the mating, so the order of offspring in the output group does not depend on the order in which branches perform matings.
+		/// If evaluation of offspring is deferred, offspring are also collected to the chunk which is evaluated when it is full.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="output">group that will store offspring chromosomes. Positions must be reserved using <see cref="GaChromosomeGroup::SetCount" /> method.</param>
+		/// <param name="index">position in output group at which the first offspring of the mating is stored.</param>
+		GAL_API
+		void GACALL CollectOffspring(GaChromosomeGroup& output,
+			int index);
+
+		/// <summary><c>FlushOffspring</c> method evaluates offspring chromosomes whose evaluation is deferred.
+		///
+		/// This method is not thread-safe.</summary>
+		GAL_API
+		void GACALL FlushOffspring();
+
+		/// <summary><c>SetEvaluationChunkSize</c> method sets number of offspring chromosomes that are evaluated together.
+		/// When size is greater then 0, offspring are not evaluated when they are stored or mutated, but they are collected and evaluated in chunks
+		/// using batch evaluation of the population's fitness operation. Mating operations that use <see cref="ReplaceIfBetter" /> method still trigger
+		/// evaluation of the offspring, so deferred evaluation should not be used with them.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="size">number of offspring chromosomes in chunk. If it is set to 0, offspring are evaluated as soon as they are stored.</param>
+		/// <exception cref="GaArgumentOutOfRangeException" />Thrown if <c>size</c> is negative value.</exception>
+		/// <exception cref="GaInvalidOperationException" />Thrown if size is changed while there are offspring whose evaluation is deferred.</exception>
+		GAL_API
+		void GACALL SetEvaluationChunkSize(int size);
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns number of offspring chromosomes that are evaluated together or 0 if evaluation is not deferred.</returns>
+		inline int GACALL GetEvaluationChunkSize() const { return _evaluationChunk.GetSize(); }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns <c>true</c> if evaluation of offspring chromosomes is deferred.</returns>
+		inline bool GACALL IsEvaluationDeferred() const { return _evaluationChunk.GetSize() > 0; }
+
 		/// <summary>More details are given in specification of <see cref="GaCrossoverBuffer::GetOffspringChromosome" /> method.
 		///
 		/// This method is thread-safe.</summary>
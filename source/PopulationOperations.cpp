@@ -39,6 +39,57 @@ namespace Population
 
 	};
 
+	/// <summary><c>GaAssignFitnessBatchOp</c> class represents operation that collects chromosomes into batches, evaluates them together and assign fitness values.</summary>
+	class GaAssignFitnessBatchOp
+	{
+
+	private:
+
+		/// <summary>Population whose chromosomes is evaluated.</summary>
+		GaPopulation& _population;
+
+		/// <summary>Chromosomes collected for evaluation.</summary>
+		GaChromosomeStorage* _batch[ Chromosome::GaChromosomeFitnessOperation::MAX_BATCH_SIZE ];
+
+		/// <summary>Number of chromosomes which triggers evaluation of the batch.</summary>
+		int _batchSize;
+
+		/// <summary>Number of collected chromosomes.</summary>
+		int _count;
+
+	public:
+
+		/// <summary>Initializes operation.</summary>
+		/// <param name="population">population whose chromosomes is evaluated.</param>
+		/// <param name="batchSize">number of chromosomes which triggers evaluation of the batch.</param>
+		GaAssignFitnessBatchOp(GaPopulation& population,
+			int batchSize) : _population(population),
+			_batchSize(batchSize < Chromosome::GaChromosomeFitnessOperation::MAX_BATCH_SIZE ? batchSize : Chromosome::GaChromosomeFitnessOperation::MAX_BATCH_SIZE),
+			_count(0) { }
+
+		/// <summary><c>operator ()</c> adds chromosome to the batch and evaluates the batch when it is full.</summary>
+		/// <param name="chromosome">storage object of the chromosome that should be evaluated.</param>
+		/// <param name="index">index of the chromosomes.</param>
+		inline void GACALL operator ()(GaChromosomeStorage& chromosome,
+			int index)
+		{
+			_batch[ _count++ ] = &chromosome;
+			if( _count == _batchSize )
+				Flush();
+		}
+
+		/// <summary><c>Flush</c> method evaluates chromosomes that are left in the batch.</summary>
+		inline void GACALL Flush()
+		{
+			if( _count > 0 )
+			{
+				_population.CalculateFitness( _batch, _count );
+				_count = 0;
+			}
+		}
+
+	};
+
 	// Evaluate and assign fitness value to all chromosomes in the population
 	void GaCombinedFitnessOperation::operator ()(GaPopulation& population,
 		const Fitness::GaFitnessOperationParams& params,
@@ -52,7 +103,20 @@ namespace Population
 		{
 			// re-evaluate fitnesses of the chromosomes
 			Common::Workflows::GaParallelExec1<GaPopulation, GaChromosomeStorage> workDist( *branch, population );
-			workDist.Execute( GaAssignFitnessOp( population ), false );
+
+			// cost of fitness evaluation can vary greatly among chromosomes, so branches should steal work from each other
+			workDist.SetScheduling( Common::Workflows::GAPS_WORK_STEALING );
+
+			int batchSize = GetBatchSize();
+			if( batchSize > 1 )
+			{
+				// evaluate chromosomes in batches and then evaluate the rest of chromosomes processed by the branch
+				GaAssignFitnessBatchOp op( population, batchSize );
+				workDist.Execute( op, false );
+				op.Flush();
+			}
+			else
+				workDist.Execute( GaAssignFitnessOp( population ), false );
 
 			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
 				flags.CopyMaskedFlags( GaPopulation::GAPF_COMPLETE_FITNESS_UPDATE, GaPopulation::GAPF_COMPLETE_FITNESS_UPDATE | GaPopulation::GAPF_FITNESS_OPERATION_CHANGED );
@@ -201,6 +265,32 @@ namespace Population
 		}
 	}
 
+	// Performs selection that produces offspring and evaluates offspring in chunks
+	void GaBreedStep::operator ()(Common::Workflows::GaBranch* branch)
+	{
+		int crossoverBufferTagID = _setup.GetParameters().GetCrossoverBuffersTagID();
+
+		// selection does not produce offspring
+		if( crossoverBufferTagID < 0 )
+		{
+			GaSelectionStep::operator ()( branch );
+			return;
+		}
+
+		GaCrossoverStorageBuffer& crossoverBuffer = _inData.GetData().GetTagByID<GaPartialCrossoverBuffer>( crossoverBufferTagID )[ branch->GetFilteredID() ];
+
+		// improving-only mutations require fitness values of offspring before mutation is performed
+		const Chromosome::GaMutationSetup& mutation = _setup.GetConfiguration().GetMating().GetConfiguration().GetMutation();
+		bool improvingMutations = mutation.HasParameters() && mutation.GetParameters().GetImprovingMutationsFlag();
+
+		crossoverBuffer.SetEvaluationChunkSize( improvingMutations ? 0 : _chunkSize );
+
+		GaSelectionStep::operator ()( branch );
+
+		// evaluate offspring from the last incomplete chunk
+		crossoverBuffer.FlushOffspring();
+	}
+
 	// Prepares data for coupling operation
 	void GaCouplingOperation::Prepare(GaChromosomeGroup& input,
 		GaChromosomeGroup& output,
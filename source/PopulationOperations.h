@@ -128,6 +128,21 @@ namespace Population
 			Fitness::GaFitness& fitness,
 			const Fitness::GaFitnessOperationParams& parameters) const { ( *_fitnessOperation )( object, fitness, parameters ); }
 
+		/// <summary><c>EvaluateBatch</c> method performes batch evaluation of specified chromosomes using provided fitness operation.
+		/// More details are given in specification of <see cref="GaRawFitnessOperation::EvaluateBatch" /> method.
+		///
+		/// This method is not thread-safe.</summary>
+		virtual void GACALL EvaluateBatch(const Chromosome::GaChromosome* const* objects,
+			Fitness::GaFitness* const* fitness,
+			int count,
+			const Fitness::GaFitnessOperationParams& parameters) const { _fitnessOperation->EvaluateBatch( objects, fitness, count, parameters ); }
+
+		/// <summary>More details are given in specification of <see cref="GaRawFitnessOperation::GetBatchSize" /> method.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <returns>Method returns preferred batch size of provided fitness operation.</returns>
+		virtual int GACALL GetBatchSize() const { return _fitnessOperation->GetBatchSize(); }
+
 		/// <summary>More details are given in specification of <see cref="GaPopulationFitnessOperation::AllowsIndividualEvaluation" /> method.
 		///
 		/// This method is not thread-safe.</summary>
@@ -503,6 +518,70 @@ namespace Population
 	/// selection operation. Detailed description can be found in specification of <see cref="GaOperationStep2" /> template class.</summary>
 	typedef Common::Workflows::GaOperationStep2<GaSelectionSetup, GaPopulation, GaChromosomeGroup> GaSelectionStep;
 
+	/// <summary><c>GaBreedStep</c> class represents workflow step that fuses selection, mating and evaluation of offspring chromosomes.
+	/// Selection operation must be configured to produce offspring chromosomes (ID of crossover buffers tag must be specified in selection parameters),
+	/// so parents are passed to mating operation as soon as they are selected. Evaluation of offspring is deferred and performed in small chunks,
+	/// so each branch processes its share of the work while parents and offspring are still in cache and fitness operation can use batch evaluation.
+	/// Evaluated offspring are stored directly to the output group of the step, so separate coupling step is not needed. If selection does not produce
+	/// offspring chromosomes, this step behaves as ordinary selection step. Evaluation is not deferred if mating uses improving-only mutations,
+	/// since it requires fitness values of offspring before they are mutated.
+	///
+	/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
+	/// No public or private methods are thread-safe.</summary>
+	class GaBreedStep : public GaSelectionStep
+	{
+
+	public:
+
+		/// <summary>Default number of offspring chromosomes that are evaluated together.</summary>
+		static const int DEFAULT_CHUNK_SIZE = 16;
+
+	private:
+
+		/// <summary>Number of offspring chromosomes that are evaluated together.</summary>
+		int _chunkSize;
+
+	public:
+
+		/// <summary>Initializes step with selection operation and data used by the operation.</summary>
+		/// <param name="setup">setup of selection operation.</param>
+		/// <param name="inDataStorage">pointer to workflow that stores population.</param>
+		/// <param name="inDataID">ID of population in workflow storage.</param>
+		/// <param name="outDataStorage">pointer to workflow that stores group which will store offspring chromosomes.</param>
+		/// <param name="outDataID">ID of output group in workflow storage.</param>
+		/// <param name="chunkSize">number of offspring chromosomes that are evaluated together. If it is set to 0 offspring are evaluated as soon as they are produced.</param>
+		/// <exception cref="GaArgumentOutOfRangeException" />Thrown if <c>chunkSize</c> is negative value.</exception>
+		GaBreedStep(const GaSelectionSetup& setup,
+			Common::Workflows::GaDataStorage* inDataStorage,
+			int inDataID,
+			Common::Workflows::GaDataStorage* outDataStorage,
+			int outDataID,
+			int chunkSize = DEFAULT_CHUNK_SIZE) : GaSelectionStep(setup, inDataStorage, inDataID, outDataStorage, outDataID) { SetChunkSize( chunkSize ); }
+
+		/// <summary><c>operator ()</c> executes selection operation that produces offspring and evaluates offspring in chunks.
+		///
+		/// This operator is not thread-safe.</summary>
+		/// <param name="branch">pointer to workflow branch that executes this step.</param>
+		GAL_API
+		virtual void GACALL operator ()(Common::Workflows::GaBranch* branch);
+
+		/// <summary><c>SetChunkSize</c> method sets number of offspring chromosomes that are evaluated together.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="size">number of offspring chromosomes. If it is set to 0 offspring are evaluated as soon as they are produced.</param>
+		/// <exception cref="GaArgumentOutOfRangeException" />Thrown if <c>size</c> is negative value.</exception>
+		inline void GACALL SetChunkSize(int size)
+		{
+			GA_ARG_ASSERT( Common::Exceptions::GaArgumentOutOfRangeException, size >= 0, "size", "Size of chunk cannot be negative value.", "Population" );
+			_chunkSize = size;
+		}
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns number of offspring chromosomes that are evaluated together.</returns>
+		inline int GACALL GetChunkSize() const { return _chunkSize; }
+
+	};
+
 	/// <summary>This class is base for parameters of coupling operation.
 	///
 	/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
@@ -515,16 +594,26 @@ namespace Population
 		/// <summary>Number of chromosomes which should be produces.</summary>
 		int _numberOfOffsprings;
 
+		/// <summary>Number of offspring chromosomes that are evaluated together.</summary>
+		int _evaluationChunkSize;
+
 	public:
 
 		/// <summary>This constructor initializes coupling parameters with user-defined number of produced offspring size.</summary>
 		/// <param name="numberOfOffsprings">number of chromosomes which should be produced.</param>
 		/// <param name="crossoverBuffersTagID">ID of the tag that stores crossover buffers.</param>
+		/// <param name="evaluationChunkSize">number of offspring chromosomes that are evaluated together.</param>
 		GaCouplingParams(int numberOfOffsprings,
-			int crossoverBuffersTagID) : GaCouplingParamsBase(crossoverBuffersTagID) { SetNumberOfOffsprings( numberOfOffsprings ); }
+			int crossoverBuffersTagID,
+			int evaluationChunkSize = 0) : GaCouplingParamsBase(crossoverBuffersTagID)
+		{
+			SetNumberOfOffsprings( numberOfOffsprings );
+			SetEvaluationChunkSize( evaluationChunkSize );
+		}
 
 		/// <summary>This constructor initializes coupling parameters with default values. Default number of produced offspring is 2.</summary>
-		GaCouplingParams() : _numberOfOffsprings(2) { }
+		GaCouplingParams() : _numberOfOffsprings(2),
+			_evaluationChunkSize(0) { }
 
 		/// <summary>More details are given in specification of <see cref="GaParameters::Clone" /> method.</summary>
 		virtual Common::GaParameters* GACALL Clone() const { return new GaCouplingParams( *this ); }
@@ -546,6 +635,23 @@ namespace Population
 			_numberOfOffsprings = number;
 		}
 
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns number of offspring chromosomes that are evaluated together.</returns>
+		inline int GACALL GetEvaluationChunkSize() const { return _evaluationChunkSize; }
+
+		/// <summary><c>SetEvaluationChunkSize</c> method sets number of offspring chromosomes that are evaluated together.
+		/// Evaluation of offspring is deferred only by couplings that pair parents from the input group (simple, inverse and random coupling),
+		/// other couplings evaluate offspring as soon as they are produced.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="size">number of offspring chromosomes. If it is set to 0 offspring are evaluated as soon as they are produced.</param>
+		/// <exception cref="GaArgumentOutOfRangeException" />Thrown if <c>size</c> is negative value.</exception>
+		inline void GACALL SetEvaluationChunkSize(int size)
+		{
+			GA_ARG_ASSERT( Common::Exceptions::GaArgumentOutOfRangeException, size >= 0, "size", "Size of chunk cannot be negative value.", "Population" );
+			_evaluationChunkSize = size;
+		}
+
 	};
 
 	/// <summary>This class is interface for coupling operations which produce offspring from selected chromosomes.</summary>
@@ -1007,15 +1113,11 @@ namespace Population
 		/// <returns>Method returns reference to sort criteria used for sorting population.</returns>
 		inline const GaCriteria& GACALL GetCriteria() const { return _criteria.GetCriteria(); }
 
-		/// <summary><c>operator ()</c> executes method over specified object.
+		/// <summary><c>operator ()</c> sorts population. Sorting is split among all branches that execute this step.
 		///
-		/// This operator is not thread-safe.</summary>
+		/// This operator is thread-safe.</summary>
 		/// <param name="branch">pointer to workflow branch that executes this step.</param>
-		virtual void GACALL operator ()(Common::Workflows::GaBranch* branch)
-		{
-			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
-				_population.GetData().Sort( _criteria.GetCriteria() );
-		}
+		virtual void GACALL operator ()(Common::Workflows::GaBranch* branch) { _population.GetData().Sort( branch, _criteria.GetCriteria() ); }
 
 		/// <summary><c>SetPopulation</c> method sets population object that should be used by the operation executed by this step.
 		///
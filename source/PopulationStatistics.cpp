@@ -41,7 +41,8 @@ namespace Population
 		&_sumIntCombiner, &_sumIntCombiner, &_sumIntCombiner, &_sumIntCombiner, 
 		&_sumIntCombiner,
 		&_sumInt64Combiner, &_sumInt64Combiner, &_sumInt64Combiner, &_sumInt64Combiner, 
-		&_sumInt64Combiner
+		&_sumInt64Combiner,
+		&_sumIntCombiner, &_sumIntCombiner
 	};
 
 	/// <summary>Default evaluator for calculating average raw fitness value.</summary>
@@ -76,7 +77,8 @@ namespace Population
 		NULL, NULL, NULL, NULL, 
 		NULL,
 		NULL, NULL, NULL, NULL, 
-		NULL
+		NULL,
+		NULL, NULL
 	};
 
 	// Global instance of default factory
@@ -109,6 +111,8 @@ namespace Population
 		case GADV_REPLACEMENT_TIME:
 		case GADV_SCALING_TIME:
 		case GADV_GENERATION_TIME:
+		case GADV_FITNESS_CACHE_HIT_COUNT:
+		case GADV_FITNESS_CACHE_MISS_COUNT:
 			return CreateValue( statistics, valueID, _defaultCombiners[ valueID ], historyDepth );
 
 		case GADV_AVG_FITNESS:
@@ -143,6 +147,8 @@ namespace Population
 		case GADV_MUTATION_COUNT:
 		case GADV_ACCEPTED_MUTATION_COUNT:
 		case GADV_SELECTION_COUNT:
+		case GADV_FITNESS_CACHE_HIT_COUNT:
+		case GADV_FITNESS_CACHE_MISS_COUNT:
 
 			accumulating = true;
 
@@ -724,4 +730,43 @@ namespace Population
 		}
 	}
 
+	// Tracked values
+	const int GaFitnessCacheTracker::BindingValues[ GaFitnessCacheTracker::BindingValuesCount ] =
+	{
+		GADV_FITNESS_CACHE_HIT_COUNT,
+		GADV_FITNESS_CACHE_MISS_COUNT
+	};
+
+	// Adds tracked values to population's statistics
+	void GaFitnessCacheTracker::Bind(GaPopulation& population)
+	{
+		InsertValues( population.GetStatistics(), *GaDefaultValueHistoryFactory::GetInstance(), BindingValues, BindingValuesCount );
+	}
+
+	// Removes tracked values from population's statistics
+	void GaFitnessCacheTracker::Unbind(GaPopulation& population)
+	{
+		RemoveValues( population.GetStatistics(), BindingValues, BindingValuesCount );
+	}
+
+	// Update statistics
+	void GaFitnessCacheTracker::Evaluate(GaPopulation& population,
+		Common::Workflows::GaBranch* branch) const
+	{
+		Statistics::GaStatistics& stats = population.GetStatistics();
+
+		GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
+		{
+			// move counters of the cache to statistics
+			int hits, misses;
+			population.GetFitnessCache().TakeCounters( hits, misses );
+
+			Statistics::GaValueHistory<int>& hitCount = stats.GetValue<int>( GADV_FITNESS_CACHE_HIT_COUNT );
+			hitCount.SetCurrent( hitCount.GetCurrentValue() + hits );
+
+			Statistics::GaValueHistory<int>& missCount = stats.GetValue<int>( GADV_FITNESS_CACHE_MISS_COUNT );
+			missCount.SetCurrent( missCount.GetCurrentValue() + misses );
+		}
+	}
+
 } // Population
@@ -99,6 +99,12 @@ namespace Population
 		/// <summary>CPU time used for evolving single generation.</summary>
 		GADV_GENERATION_TIME,
 
+		/// <summary>Count of fitness evaluations skipped because the value was found in fitness cache.</summary>
+		GADV_FITNESS_CACHE_HIT_COUNT,
+
+		/// <summary>Count of fitness cache lookups that failed.</summary>
+		GADV_FITNESS_CACHE_MISS_COUNT,
+
 		/// <summary>Number of defined built-in values.</summary>
 		GADV_NUMBER_OF_BUILTIN_VALUES
 
@@ -560,6 +566,46 @@ namespace Population
 
 	};
 
+	/// <summary><c>GaFitnessCacheTracker</c> class tracks number of hits and misses of population's fitness cache.
+	///
+	/// This class has no built-in synchronizator, so <c>LOCK_OBJECT</c> and <c>LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
+	/// No public or private methods are thread-safe.
+	class GaFitnessCacheTracker : public GaPopulationStatTracker
+	{
+
+	public:
+
+		/// <summary>ID used for registring tracker.</summary>
+		static const int TRACKER_ID = 8;
+
+		/// <summary>Number of statistical values that is being tracked.</summary>
+		static const int BindingValuesCount = 2;
+
+		/// <summary>IDs of statistical values that is being tracked.</summary>
+		GAL_API
+		static const int BindingValues[ BindingValuesCount ];
+
+		/// <summary>More details are given in specification of <see cref="GaPopulationStatTracker::Bind" /> method.
+		///
+		/// This method is not thread-safe.</summary>
+		GAL_API
+		virtual void GACALL Bind(GaPopulation& population);
+
+		/// <summary>More details are given in specification of <see cref="GaPopulationStatTracker::Unbind" /> method.
+		///
+		/// This method is not thread-safe.</summary>
+		GAL_API
+		virtual void GACALL Unbind(GaPopulation& population);
+
+		/// <summary>More details are given in specification of <see cref="GaPopulationStatTracker::Evaluate" /> method.
+		///
+		/// This method is not thread-safe.</summary>
+		GAL_API
+		virtual void GACALL Evaluate(GaPopulation& population,
+			Common::Workflows::GaBranch* branch) const;
+
+	};
+
 } // Population
 
 #endif // __GA_POPULATION_STATISTICS_H__
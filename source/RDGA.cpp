@@ -589,8 +589,11 @@ namespace Multiobjective
 			gridBounds.SetLowerBounds( population[ 0 ].GetFitness( Population::GaChromosomeStorage::GAFT_RAW ) );
 			gridBounds.SetUpperBounds( gridBounds.GetLowerBounds() );
 
+			// pack objective values of chromosomes for pairwise comparison
+			const Population::GaObjectiveMatrix* matrix = population.GetObjectiveMatrix().Update( population, branch ) ? &population.GetObjectiveMatrix() : NULL;
+
 			// determine size of fixed hypergird and identify nondominated chromosomes
-			domWorkDist.Execute( GaRDGAGridOp( adaptiveGrid, gridBounds, getRank ), GaDominanceOp( population, getDomCount, getDomList, branchID ), false );
+			domWorkDist.Execute( GaRDGAGridOp( adaptiveGrid, gridBounds, getRank ), GaDominanceOp( population, getDomCount, getDomList, branchID, matrix ), false );
 
 			// update or create fixed hypergird according to determined size
 			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
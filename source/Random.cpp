@@ -12,12 +12,6 @@
 
 #include "Random.h"
 
-#if defined (GAL_SYNTAX_GNUC) || defined (GAL_SYNTAX_SUNC)
-
-inline unsigned int _lrotl(unsigned int x, int r) { return ( x<< r ) | ( x >> ( sizeof( x ) * 8 - 1 ) ); }
-
-#endif
-
 namespace Common
 {
 	namespace Random
@@ -26,67 +20,97 @@ namespace Common
 		// Global instance of random generator
 		GaRandomGenerator GaRandomGenerator::_instance;
 
-		// Generator of random bits
-		unsigned int GaRandomGenerator::Generate()
+		// Initializes state of the stream
+		void GaRandomStream::Seed(unsigned long long seed)
 		{
-			GaState newState, oldState;
-			do
+			// state is expanded from the seed using splitmix64 so similar seeds produce unrelated states
+			for( int i = 0; i < 2; i++ )
 			{
-				oldState = newState = _currentState;
-
-				// calculate new state of the generator
-				newState._z = 0x9069 * ( newState._z & 0xffff ) + ( newState._z >> 16 );
-				newState._w = 0x4650 * ( newState._w & 0xffff ) + ( newState._w >> 16 );
+				unsigned long long z = ( seed += 0x9E3779B97F4A7C15ULL );
+				z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+				z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBULL;
+				_state[ i ] = z ^ ( z >> 31 );
+			}
+
+			// state must not be all zeros
+			if( !_state[ 0 ] && !_state[ 1 ] )
+				_state[ 0 ] = 0x1f123bb5159a55e5ULL;
+		}
 
-				// assure that another thread have not modified the state
-			} while( !Threading::GaCmpXchg2<GaState>::Op( &_currentState, &oldState, newState ) );
+		// Initializes state of the stream as substream of the seed
+		void GaRandomStream::Seed(unsigned long long seed,
+			unsigned long long epoch,
+			unsigned long long item)
+		{
+			// epoch and item are mixed into seed one at the time, so that different pairs produce unrelated seeds
+			GaRandomStream mixer( seed ^ ( epoch * 0xD1B54A32D192ED03ULL ) );
+			mixer.Seed( mixer.Generate64() ^ ( item * 0x9E3779B97F4A7C15ULL ) );
 
-			// generate new random value
-			//return ( newState._w << 16 ) + (unsigned short)newState._z;
-			return ( newState._z << 16 ) + newState._w;
+			*this = mixer;
 		}
 
-		// Generate random single precision floating point number in interval 0..1
-		float GaRandomGenerator::GenerateFloat()
+		// Advances state of the stream by 2^64 numbers
+		void GaRandomStream::Jump()
 		{
-			GaUnsignedIntToFloat converter;
+			static const unsigned long long jump[] = { 0xdf900294d8f554a5ULL, 0x170865df4b3201fcULL };
+
+			unsigned long long s0 = 0, s1 = 0;
+			for( int i = 0; i < 2; i++ )
+			{
+				for( int b = 0; b < 64; b++ )
+				{
+					if( jump[ i ] & ( 1ULL << b ) )
+					{
+						s0 ^= _state[ 0 ];
+						s1 ^= _state[ 1 ];
+					}
+
+					Generate64();
+				}
+			}
+
+			_state[ 0 ] = s0;
+			_state[ 1 ] = s1;
+		}
 
-			// generate random bits
-			converter.bits = Generate();
+		// Frees streams made for threads
+		GaRandomGenerator::~GaRandomGenerator()
+		{
+			for( std::vector<GaRandomStream*>::iterator it = _streams.begin(); it != _streams.end(); ++it )
+				delete *it;
+		}
 
-			// covert to double
-			converter.bits = ( converter.bits & 0x007FFFFF ) | 0x3F800000;
+		// Sets new seed and reinitializes existing streams
+		void GaRandomGenerator::SetSeed(unsigned long long seed)
+		{
+			_seed = seed;
+			_nextStream.Seed( seed );
 
-			return converter.number - 1;
+			// existing streams get the same states they would get if they were made after the seed is set
+			for( std::vector<GaRandomStream*>::iterator it = _streams.begin(); it != _streams.end(); ++it )
+			{
+				**it = _nextStream;
+				_nextStream.Jump();
+			}
 		}
 
-		// Generate random double precision floating point number in interval 0..1
-		double GaRandomGenerator::GenerateDouble()
+		// Makes new stream for calling thread
+		GaRandomStream& GaRandomGenerator::MakeStream()
 		{
-			GaUnsignedIntToDouble converter;
+			GaRandomStream* stream = new GaRandomStream();
 
-			// generate random bits
-			converter.bits[ 0 ] = Generate();
-			converter.bits[ 1 ] = Generate();
+			GA_LOCK( _lock );
 
-			// covert to double
-			converter.bits[ _littleEndian ] = ( converter.bits[ 0 ] & 0x000FFFFF ) | 0x3FF00000;
+			// new stream starts where the previous stream has jumped to
+			*stream = _nextStream;
+			_nextStream.Jump();
 
-			return converter.number - 1;
-		}
+			_streams.push_back( stream );
 
-		// Initialization of random generator
-		void GaRandomGenerator::Initalization(unsigned int seed1,
-			unsigned int seed2)
-		{
-			// initialize seed
-			_currentState._w = seed1 ? seed1 : 0x1f123bb5;
-			_currentState._z = seed2 ? seed2 : 0x159a55e5;
-
-			// detecting big or little endian
-			GaUnsignedIntToDouble converter;
-			converter.number = 1;
-			_littleEndian = converter.bits[ 1 ] == 0x3FF00000;
+			GA_UNLOCK( _lock );
+
+			_currentStream.SetValue( stream );
+			return *stream;
 		}
 
 	} // Random
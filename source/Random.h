@@ -14,6 +14,7 @@
 #define __GA_RANDOM_H__
 
 #include <time.h>
+#include <vector>
 
 #include "Synchronization.h"
 
@@ -44,17 +45,128 @@ namespace Common
 			/// <summary>This field is used to store 64-bit long integer number.</summary>
 			unsigned int bits[ 2 ];
 
+			/// <summary>This field is used to store 64-bit long integer number as single value.</summary>
+			unsigned long long wideBits;
+
 			/// <summary>This field is used to read 64-bit long integer number as mantissa of single precision floating point number.</summary>
 			double number;
 
 		};
 
+		/// <summary><c>GaRandomStream</c> class represents single stream of random numbers. It implements xoroshiro128** algorithm which supports
+		/// jump-ahead, so that multiple non-overlapping streams can be derived from a single seed. Primary purpose of this class is to provide
+		/// per-thread state for <see cref="GaRandomGenerator" /> class, so generating numbers does not require any synchronization.
+		///
+		/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
+		/// No public or private methods are thread-safe.</summary>
+		class GaRandomStream
+		{
+
+		private:
+
+			/// <summary>Current state of the stream.</summary>
+			unsigned long long _state[ 2 ];
+
+		public:
+
+			/// <summary>This constructor initializes stream with default seed.</summary>
+			GaRandomStream() { Seed( 0 ); }
+
+			/// <summary>This constructor initializes stream with user-defined seed.</summary>
+			/// <param name="seed">user-defined seed.</param>
+			GaRandomStream(unsigned long long seed) { Seed( seed ); }
+
+			/// <summary><c>Seed</c> method initializes state of the stream from the specified seed.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="seed">seed from which the state is derived.</param>
+			GAL_API
+			void GACALL Seed(unsigned long long seed);
+
+			/// <summary><c>Seed</c> method initializes state of the stream as substream identified by epoch and item of the specified seed.
+			/// State depends only on the values of the parameters, so same substream is produced regardless of the thread that makes it.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="seed">seed from which the state is derived.</param>
+			/// <param name="epoch">epoch of the substream.</param>
+			/// <param name="item">item of the substream within the epoch.</param>
+			GAL_API
+			void GACALL Seed(unsigned long long seed,
+				unsigned long long epoch,
+				unsigned long long item);
+
+			/// <summary><c>Jump</c> method advances state of the stream by 2^64 numbers. It is used to make streams that do not overlap.
+			///
+			/// This method is not thread-safe.</summary>
+			GAL_API
+			void GACALL Jump();
+
+			/// <summary><c>Generate64</c> method generates and returns 64-bit wide unsigned integer.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <returns>Method returns generated number.</returns>
+			inline unsigned long long GACALL Generate64()
+			{
+				unsigned long long s0 = _state[ 0 ], s1 = _state[ 1 ];
+				unsigned long long result = Rotate( s0 * 5, 7 ) * 9;
+
+				// calculate new state of the stream
+				s1 ^= s0;
+				_state[ 0 ] = Rotate( s0, 24 ) ^ s1 ^ ( s1 << 16 );
+				_state[ 1 ] = Rotate( s1, 37 );
+
+				return result;
+			}
+
+			/// <summary><c>Generate</c> method generates and returns 32-bit wide unsigned integer.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <returns>Method returns generated number.</returns>
+			inline unsigned int GACALL Generate() { return (unsigned int)( Generate64() >> 32 ); }
+
+			/// <summary><c>GeneratrFloat</c> method generates single precision floating point number in interval (0, 1).
+			///
+			/// This method is not thread-safe.</summary>
+			/// <returns>Method returns generated number.</returns>
+			inline float GACALL GenerateFloat()
+			{
+				GaUnsignedIntToFloat converter;
+				converter.bits = ( Generate() >> 9 ) | 0x3F800000;
+
+				return converter.number - 1;
+			}
+
+			/// <summary><c>GeneratrDouble</c> method generates double precision floating point number in interval (0, 1).
+			///
+			/// This method is not thread-safe.</summary>
+			/// <returns>Method returns generated number.</returns>
+			inline double GACALL GenerateDouble()
+			{
+				GaUnsignedIntToDouble converter;
+				converter.wideBits = ( Generate64() >> 12 ) | 0x3FF0000000000000ULL;
+
+				return converter.number - 1;
+			}
+
+		private:
+
+			/// <summary><c>Rotate</c> method performs left bitwise rotation of 64-bit wide integer.</summary>
+			/// <param name="x">integer that should be rotated.</param>
+			/// <param name="r">number of bits by which the integer is rotated.</param>
+			/// <returns>Method returns rotated integer.</returns>
+			static inline unsigned long long GACALL Rotate(unsigned long long x,
+				int r) { return ( x << r ) | ( x >> ( 64 - r ) ); }
+
+		};
+
 		/// <summary><c>GaRandomGenerator</c> class implements algorithm for generating 32-bit wide random unsigned integers and floating-point numbers.
-		/// It takes care of architecture's endianness, but underlying CPU architecture must support floating-point by IEEE 754 standard.
-		/// Primary purpose of this class is to provide service for generating random numbers for <see cref="GaRandom" /> template class.
+		/// Underlying CPU architecture must support floating-point by IEEE 754 standard. Each thread that uses the generator gets its own
+		/// stream of random numbers (<see cref="GaRandomStream" />) so generating numbers does not touch any shared state. Streams are derived
+		/// from the seed of the generator by jump-ahead, so the streams do not overlap. Primary purpose of this class is to provide service for
+		/// generating random numbers for <see cref="GaRandom" /> template class.
 		///
 		/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class,
-		/// but all public methods are thread-safe.</summary>
+		/// but all public methods are thread-safe except <see cref="SetSeed" /> method.</summary>
 		class GaRandomGenerator
 		{
 
@@ -63,24 +175,23 @@ namespace Common
 			/// <summary>Global instance of random generator.</summary>
 			static GaRandomGenerator _instance;
 
-			/// <summary>Defines representations of random generator's state.</summary>
-			struct GaState
-			{
+			/// <summary>Seed from which streams are derived.</summary>
+			unsigned long long _seed;
+
+			/// <summary>State from which the next stream will be made.</summary>
+			GaRandomStream _nextStream;
 
-				/// <summary>The first part of random generator state.</summary>
-				unsigned int _w;
+			/// <summary>Streams made for threads that have used this generator, in order in which they were made.</summary>
+			std::vector<GaRandomStream*> _streams;
 
-				/// <summary>The second part of random generator state.</summary>
-				unsigned int _z;
+			/// <summary>Protects creation of new streams.</summary>
+			GA_DECLARE_SPINLOCK( _lock );
 
-			};
-			
-			/// <summary>Current state of random generator.</summary>
-			GaState _currentState;
+			/// <summary>Thread-local slot that stores stream of the calling thread.</summary>
+			Threading::GaThreadLocalSlot _currentStream;
 
-			/// <summary>This attribute indicates endianness of architecture. If it is set to <c>true</c>, the architecture is little-endian,
-			/// if the architecture is big-endian this attribute is set to <c>false</c>.</summary>
-			bool _littleEndian;
+			/// <summary>Indicates whether the generator works in deterministic mode.</summary>
+			bool _deterministic;
 
 		public:
 
@@ -89,45 +200,88 @@ namespace Common
 			static inline GaRandomGenerator* GACALL GetInstance() { return &_instance; }
 
 			/// <summary>This constructor initialize random generator with current time as seed.</summary>
-			GaRandomGenerator()
-			{
-				unsigned long long x = (unsigned long long)time( NULL );
-				Initalization( (unsigned int)( x >> 16 ), (unsigned int)x );
-			}
+			GaRandomGenerator() : _deterministic(false) { SetSeed( (unsigned long long)time( NULL ) ); }
 
 			/// <summary>This constructor initialize random generator with user-defined seed.</summary>
 			/// <param name="seed">user-defined seed.</param>
-			GaRandomGenerator(unsigned int seed) { Initalization( seed, 0 ); }
+			GaRandomGenerator(unsigned int seed) : _deterministic(false) { SetSeed( seed ); }
+
+			/// <summary>Frees streams made for threads.</summary>
+			GAL_API
+			~GaRandomGenerator();
+
+			/// <summary><c>GetStream</c> method returns stream of random numbers that belongs to the calling thread.
+			/// If the thread has not used the generator before, new stream is made for it.
+			///
+			/// This method is thread-safe.</summary>
+			/// <returns>Method returns reference to the stream of the calling thread.</returns>
+			inline GaRandomStream& GACALL GetStream()
+			{
+				GaRandomStream* stream = (GaRandomStream*)_currentStream.GetValue();
+				return stream ? *stream : MakeStream();
+			}
 
 			/// <summary><c>Generate</c> method generates and returns 32-bit wide unsigned integer.
 			///
 			/// This method is thread-safe.</summary>
 			/// <returns>Method returns generated number.</returns>
-			GAL_API
-			unsigned int GACALL Generate();
+			inline unsigned int GACALL Generate() { return GetStream().Generate(); }
 
 			/// <summary><c>GeneratrFloat</c> method generates single precision floating point number in interval (0, 1).
 			///
 			/// This method is thread-safe.</summary>
 			/// <returns>Method returns generated number.</returns>
-			GAL_API
-			float GACALL GenerateFloat();
+			inline float GACALL GenerateFloat() { return GetStream().GenerateFloat(); }
 
 			/// <summary><c>GeneratrFloat</c> method generates double precision floating point number in interval (0, 1).
 			///
 			/// This method is thread-safe.</summary>
 			/// <returns>Method returns generated number.</returns>
+			inline double GACALL GenerateDouble() { return GetStream().GenerateDouble(); }
+
+			/// <summary><c>SetSeed</c> method sets new seed of the generator. Streams that were already made are reinitialized
+			/// in order in which they were made, so they continue to produce non-overlapping sequences derived from the new seed.
+			///
+			/// This method is not thread-safe. It should not be called while other threads are using the generator.</summary>
+			/// <param name="seed">new seed.</param>
 			GAL_API
-			double GACALL GenerateDouble();
+			void GACALL SetSeed(unsigned long long seed);
+
+			/// <summary>This method is thread-safe.</summary>
+			/// <returns>Method returns seed from which the streams are derived.</returns>
+			inline unsigned long long GACALL GetSeed() const { return _seed; }
+
+			/// <summary><c>SetDeterministic</c> method turns deterministic mode of the generator on or off. In deterministic mode users of the generator
+			/// select substreams (see <see cref="SelectSubstream" />) that depend only on the seed and identity of the work that is being done,
+			/// so generated numbers do not depend on how the work is scheduled among threads.
+			///
+			/// This method is not thread-safe. It should not be called while other threads are using the generator.</summary>
+			/// <param name="deterministic">if this parameter is set to <c>true</c> deterministic mode is turned on.</param>
+			inline void GACALL SetDeterministic(bool deterministic) { _deterministic = deterministic; }
+
+			/// <summary>This method is thread-safe.</summary>
+			/// <returns>Method returns <c>true</c> if the generator works in deterministic mode.</returns>
+			inline bool GACALL IsDeterministic() const { return _deterministic; }
+
+			/// <summary><c>SelectSubstream</c> method reinitializes stream of the calling thread to substream identified by epoch and item.
+			/// Call has no effect if the generator does not work in deterministic mode.
+			///
+			/// This method is thread-safe.</summary>
+			/// <param name="epoch">epoch of the substream.</param>
+			/// <param name="item">item of the substream within the epoch.</param>
+			inline void GACALL SelectSubstream(unsigned long long epoch,
+				unsigned long long item)
+			{
+				if( _deterministic )
+					GetStream().Seed( _seed, epoch, item );
+			}
 
 		private:
 
-			/// <summary>Initializes random generator with specified seed. <c>Initialization</c> method is called by constructor.</summary>
-			/// <param name="seed1">seed used to initialize the first part of generator's state.</param>
-			/// <param name="seed2">seed used to initialize the second part of generator's state.</param>
+			/// <summary><c>MakeStream</c> method makes new stream for the calling thread and stores it to thread-local slot.</summary>
+			/// <returns>Method returns reference to the new stream.</returns>
 			GAL_API
-			void GACALL Initalization(unsigned int seed1,
-				unsigned int seed2);
+			GaRandomStream& GACALL MakeStream();
 
 		};
 
@@ -193,6 +347,10 @@ namespace Common
 			/// <param name="generator">pointer to random generator that is used as source for generating numbers.</param>
 			GaRandom(GaRandomGenerator* generator) : _generator(generator) { }
 
+			/// <summary>This method is thread-safe.</summary>
+			/// <returns>Method returns pointer to random generator that is used as source for generating numbers.</returns>
+			inline GaRandomGenerator* GACALL GetGenerator() const { return _generator; }
+
 			/// <summary>This method generates random values in interval [0, 2^31].
 			///
 			/// This method is thread-safe.</summary>
@@ -253,6 +411,10 @@ namespace Common
 			/// <param name="generator">pointer to random generator that is used as source for generating numbers.</param>
 			GaRandom(GaRandomGenerator* generator) : _generator(generator) { }
 
+			/// <summary>This method is thread-safe.</summary>
+			/// <returns>Method returns pointer to random generator that is used as source for generating numbers.</returns>
+			inline GaRandomGenerator* GACALL GetGenerator() const { return _generator; }
+
 			/// <summary>This method generates random values in interval [0, 2^63].
 			///
 			/// This method is thread-safe.</summary>
@@ -311,6 +473,10 @@ namespace Common
 			/// <param name="generator">pointer to random generator that is used as source for generating numbers.</param>
 			GaRandom(GaRandomGenerator* generator) : _generator(generator) { }
 
+			/// <summary>This method is thread-safe.</summary>
+			/// <returns>Method returns pointer to random generator that is used as source for generating numbers.</returns>
+			inline GaRandomGenerator* GACALL GetGenerator() const { return _generator; }
+
 			/// <summary>This method generates random values in interval [0, 1].
 			///
 			/// This method is thread-safe.</summary>
@@ -369,6 +535,10 @@ namespace Common
 			/// <param name="generator">pointer to random generator that is used as source for generating numbers.</param>
 			GaRandom(GaRandomGenerator* generator) : _generator(generator) { }
 
+			/// <summary>This method is thread-safe.</summary>
+			/// <returns>Method returns pointer to random generator that is used as source for generating numbers.</returns>
+			inline GaRandomGenerator* GACALL GetGenerator() const { return _generator; }
+
 			/// <summary>This method generates random values in interval [0, 1].
 			///
 			/// This method is thread-safe.</summary>
@@ -427,6 +597,10 @@ namespace Common
 			/// <param name="generator">pointer to random generator that is used as source for generating numbers.</param>
 			GaRandom(GaRandomGenerator* generator) : _generator(generator) { }
 
+			/// <summary>This method is thread-safe.</summary>
+			/// <returns>Method returns pointer to random generator that is used as source for generating numbers.</returns>
+			inline GaRandomGenerator* GACALL GetGenerator() const { return _generator; }
+
 			/// <summary>This method generates random Boolean values.
 			///
 			/// This method is thread-safe.</summary>
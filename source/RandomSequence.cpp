@@ -41,12 +41,15 @@ namespace Common
 			GA_ARG_ASSERT( Exceptions::GaArgumentOutOfRangeException, count > 0 && ( !unique || count <= max - min + 1 ),
 				"count", "Count must be greater then 0 and lower then or equal to size of the interval.", "Random" );
 
+			// stream of the calling thread is looked up only once
+			GaRandomStream& stream = GaGlobalRandomIntegerGenerator->GetGenerator()->GetStream();
+
 			if( unique )
 			{
 				for( int i = 0, j; i < count; i++ )
 				{
 					// generate index of random number
-					int num = T::GenerateUnique( max - min /*+ 1*/, i );
+					int num = T::GenerateUnique( stream, max - min /*+ 1*/, i );
 
 					// convert index of random number to actual number and find place for it in output array
 					for( j = count - i; j < count; j++, T::Correct( &num ) )
@@ -66,7 +69,7 @@ namespace Common
 				for( int i = 0, j; i < count; i++ )
 				{
 					// generate random number
-					int num = T::Generate( min, max );
+					int num = T::Generate( stream, min, max );
 
 					// find place for generated number in output array
 					for( j = count - i; j < count; j++ )
@@ -95,12 +98,14 @@ namespace Common
 			{
 
 				// generates random number
-				static inline int Generate(int min,
-					int max) { return GaGlobalRandomIntegerGenerator->Generate( min, max ); }
+				static inline int Generate(GaRandomStream& stream,
+					int min,
+					int max) { return min + GaGenerateIndex( stream, max - min ); }
 
 				// generates index of unique random number
-				static inline int GenerateUnique(int max,
-					int left) { return GaGlobalRandomIntegerGenerator->Generate( max - left ); }
+				static inline int GenerateUnique(GaRandomStream& stream,
+					int max,
+					int left) { return GaGenerateIndex( stream, max - left ); }
 
 				// compare two random numbers
 				static inline int Compare(int a,
@@ -126,12 +131,14 @@ namespace Common
 			{
 
 				// generates random number
-				static inline int Generate(int min,
-					int max) { return GaGlobalRandomIntegerGenerator->Generate( min, max ); }
+				static inline int Generate(GaRandomStream& stream,
+					int min,
+					int max) { return min + GaGenerateIndex( stream, max - min ); }
 
 				// generates index of unique random number
-				static inline int GenerateUnique(int max,
-					int left) { return max - GaGlobalRandomIntegerGenerator->Generate( max - left )/* - 1*/; }
+				static inline int GenerateUnique(GaRandomStream& stream,
+					int max,
+					int left) { return max - GaGenerateIndex( stream, max - left )/* - 1*/; }
 
 				// compare two random numbers
 				static inline int Compare(int a,
@@ -157,6 +164,9 @@ namespace Common
 			GA_ARG_ASSERT( Exceptions::GaArgumentOutOfRangeException, count > 0 && ( !unique || count <= max - min + 1 ),
 				"count", "Count must be greater then 0 and lower then or equal to size of the interval.", "Random" );
 
+			// stream of the calling thread is looked up only once
+			GaRandomStream& stream = GaGlobalRandomIntegerGenerator->GetGenerator()->GetStream();
+
 			for( int i = 0; i < count; i++ )
 			{
 				bool found = false;
@@ -164,7 +174,7 @@ namespace Common
 				do
 				{
 					// generate random number
-					p = min + GaGlobalRandomIntegerGenerator->Generate( max - min );
+					p = min + GaGenerateIndex( stream, max - min );
 					found = false;
 
 					// check whether the generated numbe is already in the sequence if required
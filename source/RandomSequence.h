@@ -20,6 +20,14 @@ namespace Common
 	namespace Random
 	{
 
+		/// <summary><c>GaGenerateIndex</c> method generates random integer number in interval [0, <c>max</c>] using specified stream.
+		/// It produces same distribution as <see cref="GaRandom&lt;int&gt;::Generate" /> method, but it does not look up stream of the calling thread.</summary>
+		/// <param name="stream">stream of random numbers that should be used.</param>
+		/// <param name="max">maximal value which can be generated.</param>
+		/// <returns>Method returns generated number.</returns>
+		inline int GACALL GaGenerateIndex(GaRandomStream& stream,
+			int max) { return (int)( ( max + 1 ) * stream.GenerateDouble() ) % ( max + 1 ); }
+
 		/// <summary><c>GaGenerateRandomSequenceAsc</c> method generates sequence of random integer numbers
 		/// in ascendent order withing given interval (<c>min</c>, <c>max</c>).</summary>
 		/// <param name="min">minimal value that can be generated.</param>
@@ -97,11 +105,14 @@ namespace Common
 			GA_ARG_ASSERT( Exceptions::GaNullArgumentException, arr != NULL, "arr", "Input array must be specified.", "Random" );
 			GA_ARG_ASSERT( Exceptions::GaArgumentOutOfRangeException, count >= 0, "count", "Count of elements in the array must be positive number.", "Random" );
 
+			// stream of the calling thread is looked up only once
+			GaRandomStream& stream = GaGlobalRandomIntegerGenerator->GetGenerator()->GetStream();
+
 			// shuffle array
 			while( count > 1 )
 			{
 				// generate random position of next element
-				int j = GaGlobalRandomIntegerGenerator->Generate( --count );
+				int j = GaGenerateIndex( stream, --count );
 
 				// swap elements
 				TYPE t = arr[ count ];
@@ -131,11 +142,14 @@ namespace Common
 			for( int i = count - 1; i >= 0; i-- )
 				outputArray[ i ] = inputArray[ i ];
 
+			// stream of the calling thread is looked up only once
+			GaRandomStream& stream = GaGlobalRandomIntegerGenerator->GetGenerator()->GetStream();
+
 			// shuffle output array
 			while( count > 1 )
 			{
 				// generate random position of next element
-				int j = GaGlobalRandomIntegerGenerator->Generate( --count );
+				int j = GaGenerateIndex( stream, --count );
 
 				// swap elements
 				TYPE t = outputArray[ count ];
@@ -0,0 +1,919 @@
+
+/*! \file RemoteFitness.cpp
+    \brief This file contains implementation of classes that implement evaluation of fitness values in separate worker processes.
+*/
+
+/*
+ *
+ * website: http://kataklinger.com/
+ * contact: me[at]kataklinger.com
+ *
+ */
+
+#include "RemoteFitness.h"
+#include "Population.h"
+
+#if defined(GAL_PLATFORM_WIN)
+
+	#include <io.h>
+	#include <fcntl.h>
+	#include <stdio.h>
+
+#elif defined(GAL_PLATFORM_NIX)
+
+	#include <errno.h>
+	#include <fcntl.h>
+	#include <poll.h>
+	#include <signal.h>
+	#include <unistd.h>
+	#include <sys/wait.h>
+
+#endif
+
+namespace Population
+{
+
+	// Initializes channel
+	GaMessageChannel::GaMessageChannel(GaPipeHandle input,
+		GaPipeHandle output,
+		bool overlapped) : _input(input),
+		_output(output)
+	{
+		#if defined(GAL_PLATFORM_WIN)
+
+		_overlapped = overlapped;
+		_watching = false;
+
+		memset( &_operation, 0, sizeof( _operation ) );
+		if( overlapped && !( _operation.hEvent = CreateEvent( NULL, TRUE, FALSE, NULL ) ) )
+		{
+			DWORD error = GetLastError();
+			Close();
+
+			GA_SYS_THROW_CODE( error, "Population" );
+		}
+
+		#endif
+	}
+
+	// Writes message to the channel
+	void GaMessageChannel::Send(int id,
+		const std::vector<char>& data)
+	{
+		GaHeader header;
+		header._id = id;
+		header._size = (int)data.size();
+
+		Write( (const char*)&header, sizeof( header ) );
+		if( header._size )
+			Write( &data[ 0 ], header._size );
+	}
+
+	// Reads message from the channel
+	bool GaMessageChannel::Receive(int& id,
+		std::vector<char>& data)
+	{
+		GaHeader header;
+		int read = Read( (char*)&header, sizeof( header ) );
+
+		// other side closed the channel?
+		if( !read )
+			return false;
+
+		GA_ASSERT( Common::Exceptions::GaInvalidOperationException, read == sizeof( header ), "Channel is closed in the middle of the message.", "Population" );
+
+		id = header._id;
+		data.resize( header._size );
+		if( header._size )
+		{
+			GA_ASSERT( Common::Exceptions::GaInvalidOperationException, Read( &data[ 0 ], header._size ) == header._size,
+				"Channel is closed in the middle of the message.", "Population" );
+		}
+
+		return true;
+	}
+
+	// Closes writing end of the channel
+	void GaMessageChannel::CloseOutput() { ClosePipe( _output ); }
+
+	// Closes the channel
+	void GaMessageChannel::Close()
+	{
+		#if defined(GAL_PLATFORM_WIN)
+
+		// pending operation must complete before its state is released
+		if( _watching )
+		{
+			DWORD ignored = 0;
+			CancelIo( _input );
+			GetOverlappedResult( _input, &_operation, &ignored, TRUE );
+			_watching = false;
+		}
+
+		#endif
+
+		ClosePipe( _input );
+		ClosePipe( _output );
+
+		#if defined(GAL_PLATFORM_WIN)
+
+		if( _operation.hEvent )
+		{
+			CloseHandle( _operation.hEvent );
+			_operation.hEvent = NULL;
+		}
+
+		#endif
+	}
+
+	#if defined(GAL_PLATFORM_WIN)
+
+	// Starts waiting for data
+	HANDLE GaMessageChannel::Watch()
+	{
+		GA_ASSERT( Common::Exceptions::GaInvalidOperationException, _overlapped, "Channel is not created for overlapped operations.", "Population" );
+
+		if( !_watching )
+		{
+			// zero-byte read completes when data becomes available without removing it from the pipe
+			char dummy;
+			if( ReadFile( _input, &dummy, 0, NULL, &_operation ) )
+				return NULL;
+
+			DWORD error = GetLastError();
+
+			// broken pipe is also reported as available data, so receiving detects failure of the other side
+			if( error == ERROR_BROKEN_PIPE )
+				return NULL;
+
+			if( error != ERROR_IO_PENDING )
+				GA_SYS_THROW_CODE( error, "Population" );
+
+			_watching = true;
+		}
+
+		return _operation.hEvent;
+	}
+
+	// Creates pipe
+	void GaMessageChannel::CreatePipe(GaPipeHandle& readEnd,
+		GaPipeHandle& writeEnd,
+		bool overlapped)
+	{
+		if( !overlapped )
+		{
+			GA_SYS_ASSERT( ::CreatePipe( &readEnd, &writeEnd, NULL, 0 ), "Population" );
+			return;
+		}
+
+		// anonymous pipes do not support overlapped operations, so named pipe with unique name is used
+		static volatile long counter = 0;
+		char name[ 64 ];
+		sprintf( name, "\\\\.\\pipe\\galex-%lu-%ld", GetCurrentProcessId(), Common::Threading::GaAtomicOps<long>::Inc( &counter ) );
+
+		readEnd = CreateNamedPipeA( name, PIPE_ACCESS_INBOUND | FILE_FLAG_OVERLAPPED | FILE_FLAG_FIRST_PIPE_INSTANCE,
+			PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT, 1, 0, 0, 0, NULL );
+		GA_SYS_ASSERT( readEnd != INVALID_HANDLE_VALUE, "Population" );
+
+		writeEnd = CreateFileA( name, GENERIC_WRITE, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+		if( writeEnd == INVALID_HANDLE_VALUE )
+		{
+			DWORD error = GetLastError();
+			CloseHandle( readEnd );
+
+			GA_SYS_THROW_CODE( error, "Population" );
+		}
+	}
+
+	// Closes end of the pipe
+	void GaMessageChannel::ClosePipe(GaPipeHandle& handle)
+	{
+		if( handle != GA_INVALID_PIPE_HANDLE )
+		{
+			CloseHandle( handle );
+			handle = GA_INVALID_PIPE_HANDLE;
+		}
+	}
+
+	// Reads data from the pipe
+	int GaMessageChannel::Read(char* buffer,
+		int size)
+	{
+		// completes operation that waits for data, data has arrived or the pipe is broken
+		if( _watching )
+		{
+			DWORD ignored = 0;
+			GetOverlappedResult( _input, &_operation, &ignored, TRUE );
+			_watching = false;
+		}
+
+		int total = 0;
+		while( total < size )
+		{
+			DWORD read = 0;
+			BOOL done;
+
+			if( _overlapped )
+			{
+				done = ReadFile( _input, buffer + total, size - total, NULL, &_operation );
+				if( done || GetLastError() == ERROR_IO_PENDING )
+					done = GetOverlappedResult( _input, &_operation, &read, TRUE );
+			}
+			else
+				done = ReadFile( _input, buffer + total, size - total, &read, NULL );
+
+			if( !done )
+			{
+				// other side closed the pipe
+				if( GetLastError() == ERROR_BROKEN_PIPE )
+					break;
+
+				GA_SYS_THROW( "Population" );
+			}
+
+			if( !read )
+				break;
+
+			total += read;
+		}
+
+		return total;
+	}
+
+	// Writes data to the pipe
+	void GaMessageChannel::Write(const char* buffer,
+		int size)
+	{
+		for( int total = 0; total < size; )
+		{
+			DWORD written = 0;
+			GA_SYS_ASSERT( WriteFile( _output, buffer + total, size - total, &written, NULL ), "Population" );
+			total += written;
+		}
+	}
+
+	#elif defined(GAL_PLATFORM_NIX)
+
+	// Creates pipe
+	void GaMessageChannel::CreatePipe(GaPipeHandle& readEnd,
+		GaPipeHandle& writeEnd)
+	{
+		int ends[ 2 ];
+		if( pipe( ends ) )
+			GA_SYS_THROW_CODE( errno, "Population" );
+
+		// child processes should not inherit handles implicitly
+		fcntl( ends[ 0 ], F_SETFD, FD_CLOEXEC );
+		fcntl( ends[ 1 ], F_SETFD, FD_CLOEXEC );
+
+		readEnd = ends[ 0 ];
+		writeEnd = ends[ 1 ];
+	}
+
+	// Closes end of the pipe
+	void GaMessageChannel::ClosePipe(GaPipeHandle& handle)
+	{
+		if( handle != GA_INVALID_PIPE_HANDLE )
+		{
+			close( handle );
+			handle = GA_INVALID_PIPE_HANDLE;
+		}
+	}
+
+	// Reads data from the pipe
+	int GaMessageChannel::Read(char* buffer,
+		int size)
+	{
+		int total = 0;
+		while( total < size )
+		{
+			ssize_t result = read( _input, buffer + total, size - total );
+			if( result < 0 )
+			{
+				if( errno == EINTR )
+					continue;
+
+				GA_SYS_THROW_CODE( errno, "Population" );
+			}
+
+			// other side closed the pipe
+			if( !result )
+				break;
+
+			total += (int)result;
+		}
+
+		return total;
+	}
+
+	// Writes data to the pipe
+	void GaMessageChannel::Write(const char* buffer,
+		int size)
+	{
+		// SIGPIPE is blocked only for the calling thread, so writing to the pipe of crashed worker fails with EPIPE
+		// instead of terminating the process and disposition of the signal in the host process is not changed
+		sigset_t pipeSignal, previousMask, pending;
+		sigemptyset( &pipeSignal );
+		sigaddset( &pipeSignal, SIGPIPE );
+		pthread_sigmask( SIG_BLOCK, &pipeSignal, &previousMask );
+
+		sigpending( &pending );
+		bool wasPending = sigismember( &pending, SIGPIPE ) != 0;
+
+		int error = 0;
+		for( int total = 0; total < size && !error; )
+		{
+			ssize_t result = write( _output, buffer + total, size - total );
+			if( result >= 0 )
+				total += (int)result;
+			else if( errno != EINTR )
+				error = errno;
+		}
+
+		// consume signal raised by failed write, so it is not delivered once the signal is unblocked
+		if( error == EPIPE && !wasPending )
+		{
+			int number;
+			sigwait( &pipeSignal, &number );
+		}
+
+		pthread_sigmask( SIG_SETMASK, &previousMask, NULL );
+
+		if( error )
+			GA_SYS_THROW_CODE( error, "Population" );
+	}
+
+	#endif
+
+	// Initializes worker
+	GaFitnessWorker::GaFitnessWorker(Chromosome::GaChromosomePtr prototype,
+		const Chromosome::GaChromosomeFitnessOperationSetup& fitnessOperation) : _fitnessOperation(fitnessOperation)
+	{
+		GA_ARG_ASSERT( Common::Exceptions::GaNullArgumentException, !prototype.IsNull(), "prototype", "Prototype chromosome must be specified.", "Population" );
+
+		_chromosome = prototype->Clone();
+		_fitness = _fitnessOperation.GetOperation().CreateFitnessObject( _fitnessOperation.GetConfiguration().GetFitnessParams() );
+	}
+
+	// Processes requests received over the channel
+	void GaFitnessWorker::Run(GaMessageChannel& channel)
+	{
+		int id;
+		std::vector<char> request, response;
+
+		while( channel.Receive( id, request ) )
+		{
+			response.clear();
+
+			if( _chromosome->Deserialize( request.empty() ? NULL : &request[ 0 ], (int)request.size() ) )
+			{
+				_fitnessOperation.GetOperation()( *_chromosome, *_fitness, _fitnessOperation.GetParameters() );
+
+				// empty response reports failure
+				if( !_fitness->Serialize( response ) )
+					response.clear();
+			}
+
+			channel.Send( id, response );
+		}
+	}
+
+	// Processes requests received over standard streams
+	void GaFitnessWorker::Run()
+	{
+		#if defined(GAL_PLATFORM_WIN)
+
+		_setmode( _fileno( stdin ), _O_BINARY );
+		_setmode( _fileno( stdout ), _O_BINARY );
+
+		GaMessageChannel channel( GetStdHandle( STD_INPUT_HANDLE ), GetStdHandle( STD_OUTPUT_HANDLE ) );
+
+		#elif defined(GAL_PLATFORM_NIX)
+
+		GaMessageChannel channel( STDIN_FILENO, STDOUT_FILENO );
+
+		#endif
+
+		Run( channel );
+	}
+
+	/// <summary><c>GaLocalFitnessWorker</c> struct stores worker object and channel used by local stub worker.</summary>
+	struct GaLocalFitnessWorker
+	{
+
+		/// <summary>Worker object.</summary>
+		GaFitnessWorker _worker;
+
+		/// <summary>Channel used by the worker.</summary>
+		GaMessageChannel _channel;
+
+		#if defined(GAL_PLATFORM_NIX)
+
+		/// <summary>Thread that executes the worker.</summary>
+		pthread_t _thread;
+
+		#endif
+
+		/// <summary>Initializes local worker.</summary>
+		/// <param name="prototype">prototype of chromosomes that are evaluated.</param>
+		/// <param name="fitnessOperation">fitness operation used by the worker.</param>
+		/// <param name="input">end of the pipe from which requests are read.</param>
+		/// <param name="output">end of the pipe to which responses are written.</param>
+		GaLocalFitnessWorker(Chromosome::GaChromosomePtr prototype,
+			const Chromosome::GaChromosomeFitnessOperationSetup& fitnessOperation,
+			GaPipeHandle input,
+			GaPipeHandle output) : _worker(prototype, fitnessOperation),
+			_channel(input, output) { }
+
+	};
+
+	#if defined(GAL_PLATFORM_WIN)
+
+	// Thread function of local worker
+	DWORD WINAPI GaLocalWorkerThread(LPVOID params)
+	{
+		GaLocalFitnessWorker* local = (GaLocalFitnessWorker*)params;
+
+		// pool might close the channel while the worker is writing response
+		try
+		{
+			local->_worker.Run( local->_channel );
+		}
+		catch( ... ) { }
+
+		return 0;
+	}
+
+	#elif defined(GAL_PLATFORM_NIX)
+
+	// Thread function of local worker
+	extern "C" void* GaLocalWorkerThread(void* params)
+	{
+		GaLocalFitnessWorker* local = (GaLocalFitnessWorker*)params;
+
+		// pool might close the channel while the worker is writing response
+		try
+		{
+			local->_worker.Run( local->_channel );
+		}
+		catch( ... ) { }
+
+		return NULL;
+	}
+
+	#endif
+
+	// Initializes pool
+	GaFitnessWorkerPool::GaFitnessWorkerPool(int depth) : _depth(depth)
+	{
+		GA_ARG_ASSERT( Common::Exceptions::GaArgumentOutOfRangeException, depth > 0, "depth", "Depth of the pool must be positive.", "Population" );
+	}
+
+	// Shuts down workers
+	GaFitnessWorkerPool::~GaFitnessWorkerPool()
+	{
+		try
+		{
+			Shutdown();
+		}
+		catch( ... ) { }
+	}
+
+	// Starts worker process
+	void GaFitnessWorkerPool::StartProcess(const std::string& commandLine)
+	{
+		GA_LOCK_THIS_OBJECT( lock );
+
+		// request pipe: pool -> worker, response pipe: worker -> pool
+		GaPipeHandle requestRead, requestWrite, responseRead, responseWrite;
+		GaMessageChannel::CreatePipe( requestRead, requestWrite );
+
+		try
+		{
+			GaMessageChannel::CreatePipe( responseRead, responseWrite, true );
+		}
+		catch( ... )
+		{
+			GaMessageChannel::ClosePipe( requestRead );
+			GaMessageChannel::ClosePipe( requestWrite );
+			throw;
+		}
+
+		GaWorker* worker;
+		try
+		{
+			// worker takes ownership of the ends used by the pool
+			worker = new GaWorker( responseRead, requestWrite );
+		}
+		catch( ... )
+		{
+			GaMessageChannel::ClosePipe( requestRead );
+			GaMessageChannel::ClosePipe( responseWrite );
+			throw;
+		}
+
+		#if defined(GAL_PLATFORM_WIN)
+
+		// only ends used by the worker should be inherited
+		SetHandleInformation( requestRead, HANDLE_FLAG_INHERIT, HANDLE_FLAG_INHERIT );
+		SetHandleInformation( responseWrite, HANDLE_FLAG_INHERIT, HANDLE_FLAG_INHERIT );
+
+		STARTUPINFOA startup;
+		ZeroMemory( &startup, sizeof( startup ) );
+		startup.cb = sizeof( startup );
+		startup.dwFlags = STARTF_USESTDHANDLES;
+		startup.hStdInput = requestRead;
+		startup.hStdOutput = responseWrite;
+		startup.hStdError = GetStdHandle( STD_ERROR_HANDLE );
+
+		// CreateProcess may modify command line
+		std::vector<char> command( commandLine.begin(), commandLine.end() );
+		command.push_back( 0 );
+
+		PROCESS_INFORMATION process;
+		BOOL started = CreateProcessA( NULL, &command[ 0 ], NULL, NULL, TRUE, 0, NULL, NULL, &startup, &process );
+		DWORD error = GetLastError();
+
+		GaMessageChannel::ClosePipe( requestRead );
+		GaMessageChannel::ClosePipe( responseWrite );
+
+		if( !started )
+		{
+			delete worker;
+			GA_SYS_THROW_CODE( error, "Population" );
+		}
+
+		CloseHandle( process.hThread );
+		worker->_handle = process.hProcess;
+
+		#elif defined(GAL_PLATFORM_NIX)
+
+		pid_t pid = fork();
+		if( !pid )
+		{
+			// worker process: redirect standard streams to pipes and execute command
+			dup2( requestRead, STDIN_FILENO );
+			dup2( responseWrite, STDOUT_FILENO );
+
+			execl( "/bin/sh", "sh", "-c", commandLine.c_str(), (char*)NULL );
+			_exit( 127 );
+		}
+
+		int error = errno;
+
+		GaMessageChannel::ClosePipe( requestRead );
+		GaMessageChannel::ClosePipe( responseWrite );
+
+		if( pid < 0 )
+		{
+			delete worker;
+			GA_SYS_THROW_CODE( error, "Population" );
+		}
+
+		worker->_handle = pid;
+
+		#endif
+
+		_workers.push_back( worker );
+	}
+
+	// Starts local stub worker
+	void GaFitnessWorkerPool::StartLocal(Chromosome::GaChromosomePtr prototype,
+		const Chromosome::GaChromosomeFitnessOperationSetup& fitnessOperation)
+	{
+		GA_LOCK_THIS_OBJECT( lock );
+
+		GaPipeHandle requestRead, requestWrite, responseRead, responseWrite;
+		GaMessageChannel::CreatePipe( requestRead, requestWrite );
+
+		try
+		{
+			GaMessageChannel::CreatePipe( responseRead, responseWrite, true );
+		}
+		catch( ... )
+		{
+			GaMessageChannel::ClosePipe( requestRead );
+			GaMessageChannel::ClosePipe( requestWrite );
+			throw;
+		}
+
+		GaWorker* worker;
+		try
+		{
+			// worker takes ownership of the ends used by the pool
+			worker = new GaWorker( responseRead, requestWrite );
+		}
+		catch( ... )
+		{
+			GaMessageChannel::ClosePipe( requestRead );
+			GaMessageChannel::ClosePipe( responseWrite );
+			throw;
+		}
+
+		try
+		{
+			worker->_local = new GaLocalFitnessWorker( prototype, fitnessOperation, requestRead, responseWrite );
+		}
+		catch( ... )
+		{
+			GaMessageChannel::ClosePipe( requestRead );
+			GaMessageChannel::ClosePipe( responseWrite );
+			delete worker;
+			throw;
+		}
+
+		#if defined(GAL_PLATFORM_WIN)
+
+		worker->_handle = CreateThread( NULL, 0, GaLocalWorkerThread, worker->_local, 0, NULL );
+		if( !worker->_handle )
+		{
+			DWORD error = GetLastError();
+
+		#elif defined(GAL_PLATFORM_NIX)
+
+		int error = pthread_create( &worker->_local->_thread, NULL, GaLocalWorkerThread, worker->_local );
+		if( error )
+		{
+
+		#endif
+
+			delete worker->_local;
+			delete worker;
+			GA_SYS_THROW_CODE( error, "Population" );
+		}
+
+		_workers.push_back( worker );
+	}
+
+	// Stops all workers
+	void GaFitnessWorkerPool::Shutdown()
+	{
+		GA_LOCK_THIS_OBJECT( lock );
+
+		// signal end of requests to all workers before waiting, so they can finish concurrently
+		for( std::vector<GaWorker*>::iterator it = _workers.begin(); it != _workers.end(); ++it )
+			( *it )->_channel.CloseOutput();
+
+		for( std::vector<GaWorker*>::iterator it = _workers.begin(); it != _workers.end(); ++it )
+			Stop( *it );
+
+		_workers.clear();
+	}
+
+	// Evaluates chromosomes using workers
+	void GaFitnessWorkerPool::Evaluate(const Chromosome::GaChromosome* const* objects,
+		Fitness::GaFitness* const* fitness,
+		int count)
+	{
+		GA_LOCK_THIS_OBJECT( lock );
+
+		GA_ASSERT( Common::Exceptions::GaInvalidOperationException, !_workers.empty(), "Pool has no workers.", "Population" );
+
+		try
+		{
+			for( int next = 0, inFlight = 0; next < count || inFlight > 0; )
+			{
+				// send requests while there are workers with free slots
+				for( int i; next < count && ( i = GetFreeWorker() ) >= 0; next++, inFlight++ )
+				{
+					GaWorker& worker = *_workers[ i ];
+
+					_buffer.clear();
+					GA_ASSERT( Common::Exceptions::GaInvalidOperationException, objects[ next ]->Serialize( _buffer ),
+						"Chromosome does not support serialization.", "Population" );
+
+					try
+					{
+						worker._channel.Send( next, _buffer );
+					}
+					catch( ... )
+					{
+						// worker cannot receive requests anymore
+						worker._broken = true;
+						throw;
+					}
+
+					worker._pending.push_back( next );
+				}
+
+				// read response of any worker that has finished evaluation, so its slot can be reused
+				bool received = Receive( *_workers[ WaitResponse() ], fitness );
+				inFlight--;
+
+				GA_ASSERT( Common::Exceptions::GaInvalidOperationException, received, "Worker has failed to evaluate chromosome.", "Population" );
+			}
+		}
+		catch( ... )
+		{
+			// responses of requests that are still in flight must not be read by the next evaluation
+			Recover();
+			throw;
+		}
+	}
+
+	// Finds worker with the fewest requests in flight
+	int GaFitnessWorkerPool::GetFreeWorker() const
+	{
+		int free = -1;
+		for( int i = (int)_workers.size() - 1; i >= 0; i-- )
+		{
+			int pending = (int)_workers[ i ]->_pending.size();
+			if( pending < _depth && ( free < 0 || pending < (int)_workers[ free ]->_pending.size() ) )
+				free = i;
+		}
+
+		return free;
+	}
+
+	#if defined(GAL_PLATFORM_WIN)
+
+	// Waits for response of any worker
+	int GaFitnessWorkerPool::WaitResponse()
+	{
+		std::vector<HANDLE> handles;
+		std::vector<int> indices;
+
+		// waiting is limited by number of handles, but remaining workers respond eventually since they have requests in flight
+		for( int i = (int)_workers.size() - 1; i >= 0 && handles.size() < MAXIMUM_WAIT_OBJECTS; i-- )
+		{
+			if( !_workers[ i ]->_pending.empty() )
+			{
+				HANDLE handle = _workers[ i ]->_channel.Watch();
+
+				// response is already available or the worker has failed, which is detected by receiving
+				if( !handle )
+					return i;
+
+				handles.push_back( handle );
+				indices.push_back( i );
+			}
+		}
+
+		DWORD result = WaitForMultipleObjects( (DWORD)handles.size(), &handles[ 0 ], FALSE, INFINITE );
+		GA_SYS_ASSERT( result < WAIT_OBJECT_0 + handles.size(), "Population" );
+
+		return indices[ result - WAIT_OBJECT_0 ];
+	}
+
+	#elif defined(GAL_PLATFORM_NIX)
+
+	// Waits for response of any worker
+	int GaFitnessWorkerPool::WaitResponse()
+	{
+		std::vector<pollfd> handles;
+		std::vector<int> indices;
+
+		for( int i = (int)_workers.size() - 1; i >= 0; i-- )
+		{
+			if( !_workers[ i ]->_pending.empty() )
+			{
+				pollfd handle;
+				handle.fd = _workers[ i ]->_channel.GetInput();
+				handle.events = POLLIN;
+				handle.revents = 0;
+
+				handles.push_back( handle );
+				indices.push_back( i );
+			}
+		}
+
+		for( ; ; )
+		{
+			if( poll( &handles[ 0 ], (nfds_t)handles.size(), -1 ) < 0 )
+			{
+				if( errno == EINTR )
+					continue;
+
+				GA_SYS_THROW_CODE( errno, "Population" );
+			}
+
+			// closed or broken pipe is also reported as response, so receiving detects failure of the worker
+			for( int i = 0; i < (int)handles.size(); i++ )
+			{
+				if( handles[ i ].revents )
+					return indices[ i ];
+			}
+		}
+	}
+
+	#endif
+
+	// Reads the oldest pending response of the worker
+	bool GaFitnessWorkerPool::Receive(GaWorker& worker,
+		Fitness::GaFitness* const* fitness)
+	{
+		int id, expected = worker._pending.front();
+		worker._pending.pop_front();
+
+		bool received = false;
+		try
+		{
+			// workers respond in the same order in which the requests are sent
+			received = worker._channel.Receive( id, _buffer ) && id == expected;
+		}
+		catch( ... ) { }
+
+		// channel is closed or out of sync, so other responses of the worker cannot be trusted
+		if( !received )
+		{
+			worker._broken = true;
+			return false;
+		}
+
+		return !fitness || fitness[ id ]->Deserialize( _buffer.empty() ? NULL : &_buffer[ 0 ], (int)_buffer.size() );
+	}
+
+	// Discards responses in flight and removes failed workers
+	void GaFitnessWorkerPool::Recover()
+	{
+		for( int i = (int)_workers.size() - 1; i >= 0; i-- )
+		{
+			GaWorker* worker = _workers[ i ];
+
+			while( !worker->_broken && !worker->_pending.empty() )
+				Receive( *worker, NULL );
+
+			if( worker->_broken )
+			{
+				try
+				{
+					Stop( worker );
+				}
+				catch( ... ) { }
+
+				_workers.erase( _workers.begin() + i );
+			}
+		}
+	}
+
+	// Stops the worker
+	void GaFitnessWorkerPool::Stop(GaWorker* worker)
+	{
+		worker->_channel.Close();
+
+		#if defined(GAL_PLATFORM_WIN)
+
+		WaitForSingleObject( worker->_handle, INFINITE );
+		CloseHandle( worker->_handle );
+
+		#elif defined(GAL_PLATFORM_NIX)
+
+		if( worker->_local )
+			pthread_join( worker->_local->_thread, NULL );
+		else
+		{
+			int status;
+			while( waitpid( worker->_handle, &status, 0 ) < 0 && errno == EINTR ) { }
+		}
+
+		#endif
+
+		if( worker->_local )
+			delete worker->_local;
+
+		delete worker;
+	}
+
+	// Evaluates new chromosomes using workers
+	void GaRemoteFitnessOperation::operator ()(GaPopulation& population,
+		const Fitness::GaFitnessOperationParams& parameters,
+		const Common::GaConfiguration& configuration,
+		Common::Workflows::GaBranch* branch) const
+	{
+		GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
+		{
+			GaPopulation::GaFlagType& flags = population.GetFlags();
+			bool all = flags.IsFlagSetAny( GaPopulation::GAPF_FITNESS_OPERATION_CHANGED );
+
+			std::vector<const Chromosome::GaChromosome*> objects;
+			std::vector<Fitness::GaFitness*> fitness;
+
+			// gather chromosomes that should be evaluated
+			if( all )
+			{
+				for( int i = population.GetCount() - 1; i >= 0; i-- )
+				{
+					objects.push_back( &*population[ i ].GetChromosome() );
+					fitness.push_back( &population[ i ].GetFitness( GaChromosomeStorage::GAFT_RAW ) );
+				}
+			}
+			else
+			{
+				GaChromosomeGroup& newChromosomes = population.GetNewChromosomes();
+				for( int i = newChromosomes.GetCount() - 1; i >= 0; i-- )
+				{
+					objects.push_back( &*newChromosomes[ i ].GetChromosome() );
+					fitness.push_back( &newChromosomes[ i ].GetFitness( GaChromosomeStorage::GAFT_RAW ) );
+				}
+			}
+
+			// workers evaluate chromosomes while other branches wait at the barrier
+			if( !objects.empty() )
+				_pool->Evaluate( &objects[ 0 ], &fitness[ 0 ], (int)objects.size() );
+
+			if( all )
+				flags.CopyMaskedFlags( GaPopulation::GAPF_COMPLETE_FITNESS_UPDATE, GaPopulation::GAPF_COMPLETE_FITNESS_UPDATE | GaPopulation::GAPF_FITNESS_OPERATION_CHANGED );
+		}
+	}
+
+} // Population
@@ -0,0 +1,511 @@
+
+/*! \file RemoteFitness.h
+    \brief This file declares classes that implement evaluation of fitness values in separate worker processes.
+*/
+
+/*
+ *
+ * website: http://kataklinger.com/
+ * contact: me[at]kataklinger.com
+ *
+ */
+
+#ifndef __GA_REMOTE_FITNESS_H__
+#define __GA_REMOTE_FITNESS_H__
+
+#include <deque>
+#include <string>
+#include <vector>
+#include "Threading.h"
+#include "PopulationOperations.h"
+#include "ChromosomeOperations.h"
+
+namespace Population
+{
+
+	#ifdef __GAL_DOCUMENTATION__
+
+		/// <summary>Type of system handle that represents an end of a pipe.</summary>
+		typedef _SYSTEM_OR_COMPILER_SPECIFIC_ GaPipeHandle;
+
+		/// <summary>Type of system handle that represents worker process or thread.</summary>
+		typedef _SYSTEM_OR_COMPILER_SPECIFIC_ GaWorkerHandle;
+
+	#endif
+
+	#if defined(GAL_PLATFORM_WIN)
+
+		typedef HANDLE GaPipeHandle;
+		typedef HANDLE GaWorkerHandle;
+
+		/// <summary>Value of pipe handle which does not represent any pipe.</summary>
+		#define GA_INVALID_PIPE_HANDLE INVALID_HANDLE_VALUE
+
+	#elif defined(GAL_PLATFORM_NIX)
+
+		typedef int GaPipeHandle;
+		typedef pid_t GaWorkerHandle;
+
+		/// <summary>Value of pipe handle which does not represent any pipe.</summary>
+		#define GA_INVALID_PIPE_HANDLE -1
+
+	#endif
+
+	/// <summary><c>GaMessageChannel</c> class represents bidirectional channel built from two pipes which transfers messages between the library and
+	/// fitness worker. Each message has header which contains ID of the message and size of its payload.
+	///
+	/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
+	/// No public or private methods are thread-safe.</summary>
+	class GaMessageChannel
+	{
+
+	private:
+
+		/// <summary><c>GaHeader</c> struct represents header of a message.</summary>
+		struct GaHeader
+		{
+
+			/// <summary>ID of the message.</summary>
+			int _id;
+
+			/// <summary>Size of message's payload in bytes.</summary>
+			int _size;
+
+		};
+
+		/// <summary>End of the pipe from which messages are read.</summary>
+		GaPipeHandle _input;
+
+		/// <summary>End of the pipe to which messages are written.</summary>
+		GaPipeHandle _output;
+
+		#if defined(GAL_PLATFORM_WIN)
+
+		/// <summary>Indicates whether the end of the pipe from which messages are read is opened for overlapped operations.</summary>
+		bool _overlapped;
+
+		/// <summary>State of overlapped operation performed on the end of the pipe from which messages are read.</summary>
+		OVERLAPPED _operation;
+
+		/// <summary>Indicates whether overlapped operation that waits for data (see <see cref="Watch" />) is in progress.</summary>
+		bool _watching;
+
+		#endif
+
+	public:
+
+		/// <summary>Initializes channel with specified ends of pipes. Channel takes ownership of the handles.</summary>
+		/// <param name="input">end of the pipe from which messages are read.</param>
+		/// <param name="output">end of the pipe to which messages are written.</param>
+		/// <param name="overlapped">if this parameter is set to <c>true</c>, <c>input</c> must be created for overlapped operations (see <see cref="CreatePipe" />),
+		/// so the channel can wait for data without blocking. This parameter is used only on Windows.</param>
+		/// <exception cref="GaSystemException" />Thrown if the event used by overlapped operations cannot be created.</exception>
+		GAL_API
+		GaMessageChannel(GaPipeHandle input,
+			GaPipeHandle output,
+			bool overlapped = false);
+
+		/// <summary>Closes both ends of the channel.</summary>
+		~GaMessageChannel() { Close(); }
+
+		/// <summary><c>Send</c> method writes message to the channel. Method blocks until the whole message is written.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="id">ID of the message.</param>
+		/// <param name="data">payload of the message.</param>
+		/// <exception cref="GaSystemException" />Thrown if writing to the pipe fails.</exception>
+		GAL_API
+		void GACALL Send(int id,
+			const std::vector<char>& data);
+
+		/// <summary><c>Receive</c> method reads message from the channel. Method blocks until the whole message is read.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="id">reference to variable that receives ID of the message.</param>
+		/// <param name="data">reference to buffer that receives payload of the message.</param>
+		/// <returns>Method returns <c>false</c> if the other side has closed the channel before new message was started.</returns>
+		/// <exception cref="GaSystemException" />Thrown if reading from the pipe fails.</exception>
+		/// <exception cref="GaInvalidOperationException" />Thrown if the channel is closed in the middle of the message.</exception>
+		GAL_API
+		bool GACALL Receive(int& id,
+			std::vector<char>& data);
+
+		/// <summary><c>CloseOutput</c> method closes end of the pipe to which messages are written, so the other side receives end-of-stream.
+		///
+		/// This method is not thread-safe.</summary>
+		GAL_API
+		void GACALL CloseOutput();
+
+		/// <summary><c>Close</c> method closes both ends of the channel.
+		///
+		/// This method is not thread-safe.</summary>
+		GAL_API
+		void GACALL Close();
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns end of the pipe from which messages are read.</returns>
+		inline GaPipeHandle GACALL GetInput() const { return _input; }
+
+		#if defined(GAL_PLATFORM_WIN)
+
+		/// <summary><c>Watch</c> method starts overlapped operation that waits for data in the pipe from which messages are read without removing it from the pipe.
+		/// The operation stays in progress until the next message is read or the channel is closed. Channel must be created for overlapped operations.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <returns>Method returns event which is signaled when data becomes available or <c>NULL</c> if data is already available or the other side has closed the pipe.</returns>
+		/// <exception cref="GaInvalidOperationException" />Thrown if the channel is not created for overlapped operations.</exception>
+		/// <exception cref="GaSystemException" />Thrown if the operation cannot be started.</exception>
+		GAL_API
+		HANDLE GACALL Watch();
+
+		#endif
+
+		/// <summary><c>CreatePipe</c> method creates new pipe. Handles are not inherited by child processes.
+		///
+		/// This method is thread-safe.</summary>
+		/// <param name="readEnd">reference to variable that receives end of the pipe from which data is read.</param>
+		/// <param name="writeEnd">reference to variable that receives end of the pipe to which data is written.</param>
+		/// <param name="overlapped">if this parameter is set to <c>true</c>, end of the pipe from which data is read is opened for overlapped operations.
+		/// On Windows anonymous pipes do not support overlapped operations, so named pipe with unique name is created instead.
+		/// This parameter is used only on Windows.</param>
+		/// <exception cref="GaSystemException" />Thrown if the pipe cannot be created.</exception>
+		GAL_API
+		static void GACALL CreatePipe(GaPipeHandle& readEnd,
+			GaPipeHandle& writeEnd,
+			bool overlapped = false);
+
+		/// <summary><c>ClosePipe</c> method closes specified end of a pipe if it is valid and invalidates the handle.
+		///
+		/// This method is thread-safe.</summary>
+		/// <param name="handle">reference to the handle that should be closed.</param>
+		GAL_API
+		static void GACALL ClosePipe(GaPipeHandle& handle);
+
+	private:
+
+		/// <summary><c>Read</c> method reads specified number of bytes from the pipe.</summary>
+		/// <param name="buffer">buffer that receives data.</param>
+		/// <param name="size">number of bytes that should be read.</param>
+		/// <returns>Method returns number of bytes that are read. It is less then <c>size</c> only if the other side closed the pipe.</returns>
+		int GACALL Read(char* buffer,
+			int size);
+
+		/// <summary><c>Write</c> method writes specified number of bytes to the pipe.</summary>
+		/// <param name="buffer">data that should be written.</param>
+		/// <param name="size">number of bytes that should be written.</param>
+		void GACALL Write(const char* buffer,
+			int size);
+
+	};
+
+	/// <summary><c>GaFitnessWorker</c> class implements worker side of out-of-process fitness evaluation. Worker receives serialized chromosomes,
+	/// evaluates them using provided fitness operation and sends serialized fitness values back. Responses are sent in the same order in which the requests
+	/// are received. Empty response indicates that the worker was not able to evaluate the chromosome.
+	///
+	/// Worker executable should construct the same prototype chromosome and fitness operation as the library process and call <see cref="Run" /> method.
+	///
+	/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
+	/// No public or private methods are thread-safe.</summary>
+	class GaFitnessWorker
+	{
+
+	private:
+
+		/// <summary>Chromosome to which received chromosomes are deserialized.</summary>
+		Chromosome::GaChromosomePtr _chromosome;
+
+		/// <summary>Fitness object that stores evaluated fitness values.</summary>
+		Common::Memory::GaAutoPtr<Fitness::GaFitness> _fitness;
+
+		/// <summary>Fitness operation used to evaluate chromosomes.</summary>
+		Chromosome::GaChromosomeFitnessOperationSetup _fitnessOperation;
+
+	public:
+
+		/// <summary>Initializes worker.</summary>
+		/// <param name="prototype">prototype of chromosomes that are evaluated. Worker makes its own copy of the prototype.</param>
+		/// <param name="fitnessOperation">fitness operation used to evaluate chromosomes.</param>
+		/// <exception cref="GaNullArgumentException" />Thrown if <c>prototype</c> is not specified.</exception>
+		GAL_API
+		GaFitnessWorker(Chromosome::GaChromosomePtr prototype,
+			const Chromosome::GaChromosomeFitnessOperationSetup& fitnessOperation);
+
+		/// <summary><c>Run</c> method processes requests received over specified channel until the other side closes the channel.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="channel">channel over which requests are received and responses are sent.</param>
+		GAL_API
+		void GACALL Run(GaMessageChannel& channel);
+
+		/// <summary><c>Run</c> method processes requests received over standard input and sends responses to standard output
+		/// until the standard input is closed. This method should be used by worker executables.
+		///
+		/// This method is not thread-safe.</summary>
+		GAL_API
+		void GACALL Run();
+
+	};
+
+	struct GaLocalFitnessWorker;
+
+	/// <summary><c>GaFitnessWorkerPool</c> class manages group of workers that evaluate fitness values of chromosomes out of the process.
+	/// Each chromosome is sent to the worker that has the fewest requests in flight and several requests are kept in flight for each worker,
+	/// so serialization and transfer of data overlap with evaluation. When all workers are full, the pool waits for response of any worker,
+	/// so a worker that is slow to evaluate its chromosomes does not delay dispatching of requests to other workers. Number of requests in flight is limited by depth of the pool so responses waiting to be read
+	/// always fit into pipe buffers and workers are never blocked by writing while the pool is blocked by sending new requests.
+	///
+	/// Workers can be separate processes started by <see cref="StartProcess" /> method or local stub workers started by <see cref="StartLocal" /> method
+	/// which run in a thread of the current process, but communicate over the same kind of pipes. Local workers are intended for testing.
+	///
+	/// If a worker fails or its responses are out of order, the pool reads responses of other requests that are still in flight, stops and removes
+	/// the failed worker and then reports the failure, so the next evaluation does not receive stale responses. Writing to pipe of a crashed worker
+	/// is reported as exception. On Unix-like systems <c>SIGPIPE</c> signal is blocked only for the thread that writes to the pipe,
+	/// so disposition of the signal in the host process is not changed.
+	///
+	/// This class has built-in synchronizator so it is allowed to use <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros with instances of this class.
+	/// All public methods are thread-safe.</summary>
+	class GaFitnessWorkerPool
+	{
+
+		GA_SYNC_CLASS
+
+	public:
+
+		/// <summary>Default number of requests in flight per worker.</summary>
+		static const int DEFAULT_DEPTH = 4;
+
+	private:
+
+		/// <summary><c>GaWorker</c> struct stores information about single worker.</summary>
+		struct GaWorker
+		{
+
+			/// <summary>Channel used to communicate with the worker.</summary>
+			GaMessageChannel _channel;
+
+			/// <summary>Handle of worker process or thread of local worker.</summary>
+			GaWorkerHandle _handle;
+
+			/// <summary>Worker object and its channel if the worker runs in a thread of the current process.</summary>
+			GaLocalFitnessWorker* _local;
+
+			/// <summary>IDs of requests that are sent but whose responses are not received yet.</summary>
+			std::deque<int> _pending;
+
+			/// <summary>Indicates that communication with the worker has failed and that it should be removed from the pool.</summary>
+			bool _broken;
+
+			/// <summary>Initializes worker information.</summary>
+			/// <param name="input">end of the pipe from which responses are read. It must be opened for overlapped operations.</param>
+			/// <param name="output">end of the pipe to which requests are written.</param>
+			GaWorker(GaPipeHandle input,
+				GaPipeHandle output) : _channel(input, output, true),
+				_local(NULL),
+				_broken(false) { }
+
+		};
+
+		/// <summary>Workers managed by the pool.</summary>
+		std::vector<GaWorker*> _workers;
+
+		/// <summary>Maximal number of requests in flight per worker.</summary>
+		int _depth;
+
+		/// <summary>Buffer used for serialization of chromosomes and fitness values.</summary>
+		std::vector<char> _buffer;
+
+	public:
+
+		/// <summary>Initializes pool without workers.</summary>
+		/// <param name="depth">maximal number of requests in flight per worker.</param>
+		/// <exception cref="GaArgumentOutOfRangeException" />Thrown if <c>depth</c> is not positive.</exception>
+		GAL_API
+		GaFitnessWorkerPool(int depth = DEFAULT_DEPTH);
+
+		/// <summary>Shuts down all workers.</summary>
+		GAL_API
+		~GaFitnessWorkerPool();
+
+		/// <summary><c>StartProcess</c> method starts new worker process with specified command line. Standard input and output of the process are
+		/// redirected to pipes connected to the pool.
+		///
+		/// This method is thread-safe.</summary>
+		/// <param name="commandLine">command line of the worker process.</param>
+		/// <exception cref="GaSystemException" />Thrown if the process cannot be started.</exception>
+		GAL_API
+		void GACALL StartProcess(const std::string& commandLine);
+
+		/// <summary><c>StartLocal</c> method starts local stub worker that runs in a thread of the current process.
+		///
+		/// This method is thread-safe.</summary>
+		/// <param name="prototype">prototype of chromosomes that are evaluated.</param>
+		/// <param name="fitnessOperation">fitness operation used by the worker.</param>
+		/// <exception cref="GaSystemException" />Thrown if the thread cannot be started.</exception>
+		GAL_API
+		void GACALL StartLocal(Chromosome::GaChromosomePtr prototype,
+			const Chromosome::GaChromosomeFitnessOperationSetup& fitnessOperation);
+
+		/// <summary><c>Shutdown</c> method closes channels to all workers and waits for them to finish.
+		///
+		/// This method is thread-safe.</summary>
+		GAL_API
+		void GACALL Shutdown();
+
+		/// <summary><c>Evaluate</c> method evaluates fitness values of specified chromosomes using workers managed by the pool.
+		/// Method returns after fitness values of all chromosomes are received.
+		///
+		/// This method is thread-safe.</summary>
+		/// <param name="objects">array of pointers to chromosomes which should be evaluated.</param>
+		/// <param name="fitness">array of pointers to fitness objects which receive evaluated values.</param>
+		/// <param name="count">number of chromosomes.</param>
+		/// <exception cref="GaInvalidOperationException" />Thrown if the pool has no workers, if chromosome or fitness value do not support
+		/// serialization or if worker fails to evaluate chromosome.</exception>
+		/// <exception cref="GaSystemException" />Thrown if communication with worker fails.</exception>
+		GAL_API
+		void GACALL Evaluate(const Chromosome::GaChromosome* const* objects,
+			Fitness::GaFitness* const* fitness,
+			int count);
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns number of workers managed by the pool.</returns>
+		inline int GACALL GetWorkerCount() const { return (int)_workers.size(); }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns maximal number of requests in flight per worker.</returns>
+		inline int GACALL GetDepth() const { return _depth; }
+
+	private:
+
+		/// <summary><c>GetFreeWorker</c> method finds worker that has the fewest requests in flight.</summary>
+		/// <returns>Method returns index of the worker or -1 if all workers have maximal number of requests in flight.</returns>
+		int GACALL GetFreeWorker() const;
+
+		/// <summary><c>WaitResponse</c> method waits until any worker that has requests in flight sends response.
+		/// At least one worker must have requests in flight.</summary>
+		/// <returns>Method returns index of the worker whose response is available.</returns>
+		/// <exception cref="GaSystemException" />Thrown if waiting fails.</exception>
+		int GACALL WaitResponse();
+
+		/// <summary><c>Receive</c> method reads the oldest pending response of specified worker and stores received fitness value.
+		/// If the channel is closed or response does not match the request, worker is marked as broken.</summary>
+		/// <param name="worker">worker whose response should be read.</param>
+		/// <param name="fitness">array of pointers to fitness objects which receive evaluated values or <c>NULL</c> if response should be discarded.</param>
+		/// <returns>Method returns <c>true</c> if the response is received and fitness value is stored successfully.</returns>
+		bool GACALL Receive(GaWorker& worker,
+			Fitness::GaFitness* const* fitness);
+
+		/// <summary><c>Recover</c> method discards responses of requests that are still in flight and stops and removes workers that have failed.</summary>
+		void GACALL Recover();
+
+		/// <summary><c>Stop</c> method closes channel to specified worker, waits for it to finish and frees its resources.</summary>
+		/// <param name="worker">worker that should be stopped.</param>
+		void GACALL Stop(GaWorker* worker);
+
+	};
+
+	/// <summary><c>GaRemoteFitnessOperation</c> class represents population fitness operation that evaluates chromosomes in worker processes
+	/// managed by <see cref="GaFitnessWorkerPool" />. Since evaluation is done in batches, operation does not allow individual-based evaluation,
+	/// so the algorithm evaluates chromosomes in fitness step. Only new chromosomes are evaluated, unless the fitness operation of the population
+	/// has been changed in which case all chromosomes are evaluated. Fitness operation parameters used by workers are the parameters with which
+	/// the workers are set up, parameters provided to this operation are ignored.
+	///
+	/// Chromosomes and their fitness values must support serialization (see <see cref="GaChromosome::Serialize" /> and <see cref="GaFitness::Serialize" />).
+	///
+	/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
+	/// No public or private methods are thread-safe.</summary>
+	class GaRemoteFitnessOperation : public GaPopulationFitnessOperation
+	{
+
+	private:
+
+		/// <summary>Fitness operation used by workers. It is used to create fitness objects and parameters.</summary>
+		Chromosome::GaChromosomeFitnessOperation* _fitnessOperation;
+
+		/// <summary>Pool of workers which evaluate chromosomes.</summary>
+		GaFitnessWorkerPool* _pool;
+
+	public:
+
+		/// <summary>Initializes operation.</summary>
+		/// <param name="fitnessOperation">fitness operation used by workers.</param>
+		/// <param name="pool">pool of workers which evaluate chromosomes.</param>
+		GaRemoteFitnessOperation(Chromosome::GaChromosomeFitnessOperation* fitnessOperation,
+			GaFitnessWorkerPool* pool) : _fitnessOperation(fitnessOperation),
+			_pool(pool) { }
+
+		/// <summary>More details are given in specification of <see cref="GaFitnessOperation::CreateFitnessObject" /> method.
+		///
+		/// This method is not thread-safe.</summary>
+		virtual Fitness::GaFitness* GACALL CreateFitnessObject(Common::Memory::GaSmartPtr<const Fitness::GaFitnessParams> params) const
+			{ return _fitnessOperation->CreateFitnessObject( params ); }
+
+		/// <summary><c>operator ()</c> evaluates single chromosome using workers.
+		/// More details are given in specification of <see cref="GaPopulationFitnessOperation::operator ()" /> method.
+		///
+		/// This method is not thread-safe.</summary>
+		virtual void GACALL operator ()(const Chromosome::GaChromosome& object,
+			Fitness::GaFitness& fitness,
+			const Fitness::GaFitnessOperationParams& parameters) const
+		{
+			const Chromosome::GaChromosome* objects = &object;
+			Fitness::GaFitness* values = &fitness;
+			_pool->Evaluate( &objects, &values, 1 );
+		}
+
+		/// <summary><c>EvaluateBatch</c> method evaluates chromosomes using workers.
+		/// More details are given in specification of <see cref="GaRawFitnessOperation::EvaluateBatch" /> method.
+		///
+		/// This method is not thread-safe.</summary>
+		virtual void GACALL EvaluateBatch(const Chromosome::GaChromosome* const* objects,
+			Fitness::GaFitness* const* fitness,
+			int count,
+			const Fitness::GaFitnessOperationParams& parameters) const { _pool->Evaluate( objects, fitness, count ); }
+
+		/// <summary>More details are given in specification of <see cref="GaRawFitnessOperation::GetBatchSize" /> method.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <returns>Method returns <c>MAX_BATCH_SIZE</c>.</returns>
+		virtual int GACALL GetBatchSize() const { return MAX_BATCH_SIZE; }
+
+		/// <summary>More details are given in specification of <see cref="GaPopulationFitnessOperation::AllowsIndividualEvaluation" /> method.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <returns>This method always returns <c>false</c>.</returns>
+		virtual bool GACALL AllowsIndividualEvaluation() const { return false; }
+
+		/// <summary><c>operator ()</c> sends new chromosomes in the population to workers and waits for their fitness values.
+		/// Single branch dispatches chromosomes while other branches wait at the barrier.
+		/// More details are given in specification of <see cref="GaPopulationFitnessOperation::operator ()" /> method.
+		///
+		/// This method is not thread-safe.</summary>
+		GAL_API
+		virtual void GACALL operator ()(GaPopulation& population,
+			const Fitness::GaFitnessOperationParams& parameters,
+			const Common::GaConfiguration& configuration,
+			Common::Workflows::GaBranch* branch) const;
+
+		/// <summary><c>CreateParameters</c> method creates prameters for fitness operation used by workers.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <returns>Method returns pointer to created parameters.</returns>
+		virtual Common::GaParameters* GACALL CreateParameters() const { return _fitnessOperation->CreateParameters(); }
+
+		/// <summary><c>SetPool</c> method sets pool of workers which evaluate chromosomes.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="pool">pointer to the pool.</param>
+		inline void GACALL SetPool(GaFitnessWorkerPool* pool) { _pool = pool; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns pointer to pool of workers which evaluate chromosomes.</returns>
+		inline GaFitnessWorkerPool* GACALL GetPool() const { return _pool; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns pointer to fitness operation used by workers.</returns>
+		inline const Chromosome::GaChromosomeFitnessOperation* GACALL GetFitnessOperation() const { return _fitnessOperation; }
+
+	};
+
+} // Population
+
+#endif // __GA_REMOTE_FITNESS_H__
@@ -32,14 +32,21 @@ namespace Population
 			/// <summary>Comparator that is used for comparing chromosomes.</summary>
 			const Chromosome::GaChromosomeComparatorSetup& _comparator;
 
+			/// <summary>Hash index of chromosomes in the population or <c>NULL</c> if comparator does not support hashing.</summary>
+			const GaChromosomeHashIndex* _index;
+
 		public:
 
 			/// <summary>Initializes operation.</summary>
 			/// <param name="population">population against which the chromosomes are checked.</param>
 			/// <param name="comparator">comparator that will be used for comparing chromosomes.</param>
+			/// <param name="index">hash index of chromosomes in the population. If this parameter is <c>NULL</c>
+			/// chromosomes are compared against all chromosomes in the population.</param>
 			GaCheckDuplicatesOp(const GaPopulation& population,
-				const Chromosome::GaChromosomeComparatorSetup& comparator) : _population(population),
-				_comparator(comparator) { }
+				const Chromosome::GaChromosomeComparatorSetup& comparator,
+				const GaChromosomeHashIndex* index) : _population(population),
+				_comparator(comparator),
+				_index(index) { }
 
 			/// <summary><c>operator ()</c> checks whether the chromosomes is a duplicate of a chromosome in the population.</summary>
 			/// <param name="chromosome">chromosome that should be checked.</param>
@@ -50,6 +57,16 @@ namespace Population
 				// chromosome is alredy identified as duplicate?
 				if( !chromosome.GetFlags().IsFlagSetAny( GaChromosomeStorage::GACF_REMOVE_CHROMOSOME ) )
 				{
+					// only chromosomes with same hash are compared when the index is available
+					if( _index )
+					{
+						// new chromosome is duplicate and it should not be inserted
+						if( _index->Find( *chromosome.GetChromosome() ) )
+							chromosome.GetFlags().SetFlags( GaChromosomeStorage::GACF_REMOVE_CHROMOSOME );
+
+						return;
+					}
+
 					// compare chromosome against the ones in population
 					for( int i = _population.GetCount() - 1; i >= 0; i-- )
 					{
@@ -84,7 +101,8 @@ namespace Population
 
 		};
 
-		/// <summary><c>IdentifyDuplicates</c> function identifies and marks duplicates in the group of chromosomes that should be inserted into population.</summary>
+		/// <summary><c>IdentifyDuplicates</c> function identifies and marks duplicates in the group of chromosomes that should be inserted into population.
+		/// Hash index of the population is used if it is built for the comparator, see <see cref="GaPopulation::BuildHashIndex" />.</summary>
 		/// <param name="input">group of chromosomes that should be inserted int population.</param>
 		/// <param name="population">population into which the chromosomes should be inserted.</param>
 		/// <param name="comparator">comparator that will be used gor comparing chromosomes against each other.</param>
@@ -97,8 +115,11 @@ namespace Population
 			// identify duplicates ofly if chromosome comparator is supplied
 			if( comparator.HasOperation() )
 			{
+				const GaChromosomeHashIndex* index = population.GetHashIndex().IsBuiltFor( comparator ) ? &population.GetHashIndex() : NULL;
+
 				Common::Workflows::GaParallelExec1<GaChromosomeGroup, GaChromosomeStorage> popWorkDist( *branch, input );
-				popWorkDist.Execute( GaCheckDuplicatesOp( population, comparator ), false );
+				popWorkDist.SetScheduling( index ? Common::Workflows::GAPS_STATIC : Common::Workflows::GAPS_DYNAMIC );
+				popWorkDist.Execute( GaCheckDuplicatesOp( population, comparator, index ), false );
 			}
 		}
 
@@ -136,6 +157,10 @@ namespace Population
 		{
 			GaOperationTime timer( population, GADV_REPLACEMENT_TIME );
 
+			// population maintains the index once it is built
+			if( configuration.GetChromosomeComparator().HasOperation() )
+				population.BuildHashIndex( configuration.GetChromosomeComparator(), branch );
+
 			IdentifyDuplicates( input, population, configuration.GetChromosomeComparator(), branch );
 
 			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
@@ -164,6 +189,10 @@ namespace Population
 		{
 			GaOperationTime timer( population, GADV_REPLACEMENT_TIME );
 
+			// population maintains the index once it is built
+			if( configuration.GetChromosomeComparator().HasOperation() )
+				population.BuildHashIndex( configuration.GetChromosomeComparator(), branch );
+
 			IdentifyDuplicates( input, population, configuration.GetChromosomeComparator(), branch );
 
 			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
@@ -209,6 +238,10 @@ namespace Population
 		{
 			GaOperationTime timer( population, GADV_REPLACEMENT_TIME );
 
+			// population maintains the index once it is built
+			if( configuration.GetChromosomeComparator().HasOperation() )
+				population.BuildHashIndex( configuration.GetChromosomeComparator(), branch );
+
 			IdentifyDuplicates( input, population, configuration.GetChromosomeComparator(), branch );
 
 			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
@@ -241,6 +274,10 @@ namespace Population
 		{
 			GaOperationTime timer( population, GADV_REPLACEMENT_TIME );
 
+			// population maintains the index once it is built
+			if( configuration.GetChromosomeComparator().HasOperation() )
+				population.BuildHashIndex( configuration.GetChromosomeComparator(), branch );
+
 			IdentifyDuplicates( input, population, configuration.GetChromosomeComparator(), branch );
 
 			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
@@ -772,6 +772,87 @@ namespace Chromosome
 		GENE_VISITOR_CREATOR(GaDoubleDominanceWithAlleleSetGene, GaDominanceBase)
 		GENE_VISITOR_CREATOR(GaDoubleDominanceWithAlleleSetGene, GaAlleleSetBase)
 
+		using Chromosome::GaSerializeValue;
+		using Chromosome::GaDeserializeValue;
+
+		/// <summary><c>GaSerializeValue</c> function serializes value stored in simple gene.</summary>
+		/// <typeparam name="VALUE_TYPE">type of value stored in the gene.</typeparam>
+		/// <param name="gene">gene that should be serialized.</param>
+		/// <param name="buffer">buffer to which the value is appended.</param>
+		/// <returns>Function returns <c>true</c> if value of the gene is serialized.</returns>
+		template<typename VALUE_TYPE>
+		inline bool GACALL GaSerializeValue(const GaGene<VALUE_TYPE>& gene,
+			std::vector<char>& buffer) { return GaSerializeValue( gene.GetValue(), buffer ); }
+
+		/// <summary><c>GaDeserializeValue</c> function restores value stored in simple gene.</summary>
+		/// <typeparam name="VALUE_TYPE">type of value stored in the gene.</typeparam>
+		/// <param name="gene">gene whose value should be restored.</param>
+		/// <param name="data">pointer to serialized value.</param>
+		/// <param name="size">number of available bytes.</param>
+		/// <returns>Function returns number of consumed bytes or -1 if value cannot be restored.</returns>
+		template<typename VALUE_TYPE>
+		inline int GACALL GaDeserializeValue(GaGene<VALUE_TYPE>& gene,
+			const char* data,
+			int size)
+		{
+			VALUE_TYPE value;
+			int used = GaDeserializeValue( value, data, size );
+			if( used >= 0 )
+				gene.SetValue( value );
+
+			return used;
+		}
+
+		/// <summary><c>GaSerializeValue</c> function serializes genes stored in single-dimensional array. Number of genes is stored before genes.</summary>
+		/// <typeparam name="GENE_TYPE">type of genes.</typeparam>
+		/// <param name="genes">array that stores genes.</param>
+		/// <param name="buffer">buffer to which the genes are appended.</param>
+		/// <returns>Function returns <c>true</c> if all genes are serialized.</returns>
+		template<typename GENE_TYPE>
+		inline bool GACALL GaSerializeValue(const Common::Data::GaSingleDimensionArray<GENE_TYPE>& genes,
+			std::vector<char>& buffer)
+		{
+			int count = genes.GetSize();
+			GaSerializeValue( count, buffer );
+
+			for( int i = 0; i < count; i++ )
+			{
+				if( !GaSerializeValue( genes[ i ], buffer ) )
+					return false;
+			}
+
+			return true;
+		}
+
+		/// <summary><c>GaDeserializeValue</c> function restores genes stored in single-dimensional array.</summary>
+		/// <typeparam name="GENE_TYPE">type of genes.</typeparam>
+		/// <param name="genes">array that will store restored genes.</param>
+		/// <param name="data">pointer to serialized genes.</param>
+		/// <param name="size">number of available bytes.</param>
+		/// <returns>Function returns number of consumed bytes or -1 if genes cannot be restored.</returns>
+		template<typename GENE_TYPE>
+		inline int GACALL GaDeserializeValue(Common::Data::GaSingleDimensionArray<GENE_TYPE>& genes,
+			const char* data,
+			int size)
+		{
+			int count;
+			int used = GaDeserializeValue( count, data, size );
+			if( used < 0 || count < 0 )
+				return -1;
+
+			genes.SetSize( count );
+			for( int i = 0; i < count; i++ )
+			{
+				int gene = GaDeserializeValue( genes[ i ], data + used, size - used );
+				if( gene < 0 )
+					return -1;
+
+				used += gene;
+			}
+
+			return used;
+		}
+
 		/// <summary><c>GaSingleGeneChromosome</c> class represents chromosome which contains only a single gene.
 		///
 		/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
@@ -848,6 +929,17 @@ namespace Chromosome
 			/// <returns>Method returns chromosome's gene.</returns>
 			inline const GaGeneType& GACALL GetGene() const { return _gene; }
 
+			/// <summary>More details are given in specification of <see cref="GaChromosome::Serialize" /> method.
+			///
+			/// This method is not thread-safe.</summary>
+			virtual bool GACALL Serialize(std::vector<char>& buffer) const { return GaSerializeValue( _gene, buffer ); }
+
+			/// <summary>More details are given in specification of <see cref="GaChromosome::Deserialize" /> method.
+			///
+			/// This method is not thread-safe.</summary>
+			virtual bool GACALL Deserialize(const char* data,
+				int size) { return GaDeserializeValue( _gene, data, size ) == size; }
+
 		};
 
 		/// <summary><c>GaMultiGeneChromosome</c> class is base class for chromosomes that contains mulitple genes.
@@ -906,6 +998,23 @@ namespace Chromosome
 
 		};
 
+		/// <summary><c>GaBindGeneAllocator</c> function binds data structure that stores chromosome's genes to gene allocator.
+		/// This version is used for data structures which cannot use the allocator and it does nothing.</summary>
+		/// <typeparam name="STRUCTURE">type of data structure.</typeparam>
+		/// <param name="genes">data structure that stores genes.</param>
+		/// <param name="allocator">gene allocator.</param>
+		template<typename STRUCTURE>
+		inline void GACALL GaBindGeneAllocator(STRUCTURE& genes,
+			Common::Memory::GaSmartPtr<Common::Memory::GaSlabAllocator> allocator) { }
+
+		/// <summary><c>GaBindGeneAllocator</c> function binds single-dimensional array that stores chromosome's genes to gene allocator.</summary>
+		/// <typeparam name="GENE_TYPE">type of genes.</typeparam>
+		/// <param name="genes">array that stores genes.</param>
+		/// <param name="allocator">gene allocator.</param>
+		template<typename GENE_TYPE>
+		inline void GACALL GaBindGeneAllocator(Common::Data::GaSingleDimensionArray<GENE_TYPE>& genes,
+			Common::Memory::GaSmartPtr<Common::Memory::GaSlabAllocator> allocator) { genes.SetAllocator( allocator ); }
+
 		/// <summary><c>GaTemplateChromosome</c> template class represent chromosome that has multiple genes of specified type stored in defined data structure.
 		///
 		/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
@@ -937,14 +1046,14 @@ namespace Chromosome
 
 		public:
 
-			/// <summary>This constructor initializes chromosome with CCB that it should use.</summary>
+			/// <summary>This constructor initializes chromosome with CCB that it should use. Genes use allocator provided by the CCB.</summary>
 			/// <param name="configBlock">smart pointer to CCB.</param>
-			GaTemplateChromosome(Common::Memory::GaSmartPtr<GaChromosomeConfigBlock> configBlock) : GaStructuredChromosome(configBlock) { }
+			GaTemplateChromosome(Common::Memory::GaSmartPtr<GaChromosomeConfigBlock> configBlock) : GaStructuredChromosome(configBlock) { BindGeneAllocator(); }
 
 			/// <summary>Copy constructor. The constructor copies reference to CCB from source chromosome.</summary>
 			/// <param name="rhs">source chromosome that should be copied.</param>
 			GaTemplateChromosome(const GaTemplateChromosome& rhs) : GaStructuredChromosome(rhs),
-				_genes(rhs._genes) { }
+				_genes(rhs._genes) { BindGeneAllocator(); }
 
 			/// <summary>More details are given in specification of <see cref="GaChromosome::Clone" /> method.
 			///
@@ -975,6 +1084,17 @@ namespace Chromosome
 			/// <returns>Method returns reference to data structure that stores chromosome's genes.</returns>
 			inline const GaStructure& GACALL GetGenes() const { return _genes; }
 
+			/// <summary>More details are given in specification of <see cref="GaChromosome::Serialize" /> method.
+			///
+			/// This method is not thread-safe.</summary>
+			virtual bool GACALL Serialize(std::vector<char>& buffer) const { return GaSerializeValue( _genes, buffer ); }
+
+			/// <summary>More details are given in specification of <see cref="GaChromosome::Deserialize" /> method.
+			///
+			/// This method is not thread-safe.</summary>
+			virtual bool GACALL Deserialize(const char* data,
+				int size) { return GaDeserializeValue( _genes, data, size ) == size; }
+
 			/// <summary>More details are given in specification of <see cref="GaChromosome::MutationEvent" /> method.
 			///
 			/// This method is not thread-safe.</summary>
@@ -1001,6 +1121,18 @@ namespace Chromosome
 				}
 			}
 
+		protected:
+
+			/// <summary><c>BindGeneAllocator</c> method binds genes and their backup to gene allocator provided by CCB.</summary>
+			inline void GACALL BindGeneAllocator()
+			{
+				if( !_configBlock.IsNull() )
+				{
+					GaBindGeneAllocator( _genes, _configBlock->GetGeneAllocator() );
+					GaBindGeneAllocator( _backup, _configBlock->GetGeneAllocator() );
+				}
+			}
+
 		};
 
 		/// <summary><c>GaAdvanceTemplateChromosome</c> template class represent chromosome that has multiple genes of specified type stored in defined data structure
@@ -13,6 +13,8 @@
 #include <limits>
 #include "PopulationStatistics.h"
 #include "Multiobjective.h"
+#include "NondominatedSorting.h"
+#include "Clustering.h"
 #include "SPEA.h"
 
 namespace Multiobjective
@@ -20,296 +22,110 @@ namespace Multiobjective
 	namespace SPEA
 	{
 
-		/// <summary><c>GaSPEACluster</c> class stores list of nearby chromosomes that form a cluster.
+		/// <summary><c>GaSPEAClusterStorage</c> class stores nondominated chromosomes and groups them into clusters.
+		/// Each nondominated chromosome forms a point of agglomerative clustering which reduces number of nondominated chromosomes.
 		///
 		/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
 		/// No public or private methods are thread-safe.</summary>
-		class GaSPEACluster
+		class GaSPEAClusterStorage
 		{
 
 		private:
 
-			/// <summary>Chromosomes that form cluster.</summary>
-			Common::Data::GaList<Population::GaChromosomeStorage*> _chromosomes;
+			/// <summary>Nondominated chromosomes that should be clustered.</summary>
+			Common::Data::GaSingleDimensionArray<Population::GaChromosomeStorage*> _chromosomes;
 
-		public:
+			/// <summary>Indices of nondominated chromosomes in the population.</summary>
+			Common::Data::GaSingleDimensionArray<int> _indices;
 
-			/// <summary><c>AddChromosome</c> method adds chromosome to the cluster.
-			///
-			/// This method is not thread-safe.</summary>
-			/// <param name="chromosome">chromosome that should be added to cluster.</param>
-			inline void GACALL AddChromosome(Population::GaChromosomeStorage* chromosome) { _chromosomes.InsertTail( chromosome ); }
+			/// <summary>Number of chromosomes in the buffer.</summary>
+			Common::Threading::GaAtomic<int> _count;
 
-			/// <summary><c>Clear</c> removes all chromosomes from the cluster.
+			/// <summary>Agglomerative clustering of stored chromosomes.</summary>
+			GaAgglomerativeClustering _clustering;
+
+		public:
+
+			/// <summary><c>CreateCluster</c> method creates cluster with only one chromosome and insets is into buffer.
 			///
-			/// This method is not thread-safe.</summary>
-			inline void GACALL Clear() { _chromosomes.Clear(); }
+			/// This method is thread-safe.</summary>
+			/// <param name="chromosome">chromosome that should form new cluster.</param>
+			/// <param name="index">index of chromosome in the population.</param>
+			inline void GACALL CreateCluster(Population::GaChromosomeStorage* chromosome,
+				int index)
+			{
+				int point = _count++;
+				_chromosomes[ point ] = chromosome;
+				_indices[ point ] = index;
+			}
 
-			/// <summary><c>Merge</c> method moves all chromosomes from specified cluster to this cluster.
+			/// <summary><c>SetSize</c> method sets sizes of buffers that handles chromosome clusters.
 			///
 			/// This method is not thread-safe.</summary>
-			/// <param name="cluster">cluster whose chromosomes should be moved.</param>
-			inline void GACALL Merge(GaSPEACluster& cluster) { _chromosomes.MergeLists( &cluster._chromosomes ); }
-
-			/// <summary>This method is not thread-safe.</summary>
-			/// <returns>Method returns chromosome which is closest to the center of cluster.</returns>
-			const Population::GaChromosomeStorage* GACALL GetCenter() const
+			/// <param name="size">maximal number of chromosomes that buffer should store.</param>
+			inline void SetSize(int size)
 			{
-				const Common::Data::GaListNode<Population::GaChromosomeStorage*>* center = _chromosomes.GetHead();
-				float minDist = std::numeric_limits<float>::infinity();
-
-				if( _chromosomes.GetCount() > 2 )
-				{
-					// find chromosome whose average distance to other chromosomes in the cluster is smallest
-					for( const Common::Data::GaListNode<Population::GaChromosomeStorage*>* it1 = _chromosomes.GetHead(); it1; it1 = it1->GetNext() )
-					{
-						// get sum of distances to other chromosomes in cluster for current chromosome
-						float totalDist = 0;
-						int count = 0;
-						for( const Common::Data::GaListNode<Population::GaChromosomeStorage*>* it2 = _chromosomes.GetHead(); it2; it2 = it2->GetNext() )
-						{
-							if( it1 != it2 )
-							{
-								// sum distance
-								float d = ChromosomeDistance( it1->GetValue(), it2->GetValue() );
-								if( d > 0 )
-								{
-									totalDist += d;
-									count++;
-								}
-							}
-						}
-
-						// average distance of current chromosomes to other chromosomes in cluster
-						totalDist /= count;
-
-						// is current chromosome closre in average to othe chromosomes then previous one?
-						if( totalDist < minDist )
-						{
-							// current chromosome is new center of the cluster
-							minDist = totalDist;
-							center = it1;
-						}
-					}
-				}
-				// whene there is only two chromosomes - randomly select one
-				else if( _chromosomes.GetCount() > 1 )
-					center = GaGlobalRandomBoolGenerator->Generate() ? _chromosomes.GetHead() : _chromosomes.GetTail();
+				// set sizes of buffers
+				_chromosomes.SetSize( size );
+				_indices.SetSize( size );
 
-				return center ? center->GetValue() : NULL;
+				// clear buffers
+				_count = 0;
 			}
 
 			/// <summary>This method is not thread-safe.</summary>
-			/// <returns>Method returns list of chromosomes that belongs to this cluster.</returns>
-			inline Common::Data::GaList<Population::GaChromosomeStorage*>& GACALL GetChromosomes() { return _chromosomes; }
+			/// <returns>Method returns number of chromosomes currently in the buffer.</returns>
+			inline int GACALL GetCount() const { return _count; }
 
 			/// <summary>This method is not thread-safe.</summary>
-			/// <returns>Method returns list of chromosomes that belongs to this cluster.</returns>
-			inline const Common::Data::GaList<Population::GaChromosomeStorage*>& GACALL GetChromosomes() const { return _chromosomes; }
+			/// <param name="point">position of chromosome in the buffer.</param>
+			/// <returns>Method returns chromosome stored at specified position in the buffer.</returns>
+			inline Population::GaChromosomeStorage* GACALL GetChromosome(int point) const { return _chromosomes[ point ]; }
 
 			/// <summary>This method is not thread-safe.</summary>
-			/// <returns>Method returns number of chromosomes in the cluster.</returns>
-			inline int GACALL GetCount() const { return _chromosomes.GetCount(); }
-
-			/// <summary><c>operator -</c> calculates average distance between chromosomes in two cluster.
-			///
-			/// This operator is not thread-safe.</summary>
-			/// <param name="rhs">cluster to which the average distance is calculated.</param>
-			/// <returns>Operator returns calculated distance.</returns>
-			float GACALL operator -(const GaSPEACluster& rhs) const
-			{
-				float distance = 0;
+			/// <param name="point">position of chromosome in the buffer.</param>
+			/// <returns>Method returns index in the population of chromosome stored at specified position in the buffer.</returns>
+			inline int GACALL GetIndex(int point) const { return _indices[ point ]; }
 
-				// sum all distances between chromosomes
-				for( const Common::Data::GaListNode<Population::GaChromosomeStorage*>* it1 = _chromosomes.GetHead(); it1; it1 = it1->GetNext() )
-				{
-					for( const Common::Data::GaListNode<Population::GaChromosomeStorage*>* it2 = rhs._chromosomes.GetHead(); it2; it2 = it2->GetNext() )
-						distance += ChromosomeDistance( it1->GetValue(), it2->GetValue() );
-				}
-
-				// calculate average distance
-				return distance / ( _chromosomes.GetCount() * rhs._chromosomes.GetCount() );
-			}
-
-		protected:
-
-			/// <summary><c>ChromosomeDistance</c> method calculates distance between two chromosomes.</summary>
-			/// <param name="chromosome1">the first chromosome.</param>
-			/// <param name="chromosome2">the second chromosome.</param>
-			/// <returns>Method returns calculated distance.</returns>
-			inline float ChromosomeDistance(Population::GaChromosomeStorage* chromosome1,
-				Population::GaChromosomeStorage* chromosome2) const
-				{ return chromosome1->GetFitness( Population::GaChromosomeStorage::GAFT_RAW ).Distance( chromosome2->GetFitness( Population::GaChromosomeStorage::GAFT_RAW ) ); }
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns agglomerative clustering of stored chromosomes.</returns>
+			inline GaAgglomerativeClustering& GACALL GetClustering() { return _clustering; }
 
 		};
 
-		/// <summary><c>GaSPEAClusterStorage</c> class stores and manages chromosome clusters.
-		///
-		/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
-		/// No public or private methods are thread-safe.</summary>
-		class GaSPEAClusterStorage
+		/// <summary><c>GaSPEAClusterDistance</c> class calculates distances between chromosomes stored in cluster buffer.</summary>
+		class GaSPEAClusterDistance
 		{
 
 		private:
 
-			/// <summary><c>GaSPEAClusterDistance</c> structure stores distances between chromosome clusters.</summary>
-			struct GaSPEAClusterDistance
-			{
-
-				/// <summary>The first cluster.</summary>
-				GaSPEACluster* _clusterA;
-
-				/// <summary>The second cluster.</summary>
-				GaSPEACluster* _clusterB;
-
-				/// <summary>Distance between two clusters.</summary>
-				float _distance;
-
-				/// <summary>Initailizes empty distance object.</summary>
-				GaSPEAClusterDistance() : _clusterA(NULL),
-					_clusterB(NULL),
-					_distance(std::numeric_limits<float>::infinity()) { }
-
-				/// <summary><c>Clear</c> method clears data stored in distance object.</summary>
-				inline void GACALL Clear()
-				{
-					_clusterA = _clusterB = NULL;
-					_distance = std::numeric_limits<float>::infinity();
-				}
-
-			};
+			/// <summary>Buffer that stores nondominated chromosomes.</summary>
+			const GaSPEAClusterStorage& _clusters;
 
-			/// <summary>Buffer that stores chromosome clusters.</summary>
-			Common::Data::GaSingleDimensionArray<GaSPEACluster> _clusters;
-
-			/// <summary>Number of clusters in the buffer.</summary>
-			Common::Threading::GaAtomic<int> _clusterCount;
-
-			/// <summary>Distances to the closest clusters identified by each workflow branch.</summary>
-			Common::Data::GaSingleDimensionArray<GaSPEAClusterDistance> _minDistances;
-
-			/// <summary>DIstance to the two closest clusters identified by all branches.</summary>
-			GaSPEAClusterDistance* _globalMinDistance;
+			/// <summary>Packed matrix of objective values or <c>NULL</c> if fitness objects should be used.</summary>
+			const Population::GaObjectiveMatrix* _matrix;
 
 		public:
 
-			/// <summary>This constructor initializes empty clusters buffer.</summary>
-			GaSPEAClusterStorage() : _globalMinDistance(NULL) { }
+			/// <summary>Initializes distance functor.</summary>
+			/// <param name="clusters">buffer that stores nondominated chromosomes.</param>
+			/// <param name="matrix">packed matrix of objective values. If this parameter is <c>NULL</c>, fitness objects are used.</param>
+			GaSPEAClusterDistance(const GaSPEAClusterStorage& clusters,
+				const Population::GaObjectiveMatrix* matrix) : _clusters(clusters),
+				_matrix(matrix) { }
 
-			/// <summary><c>CreateCluster</c> method creates cluster with only one chromosome and insets is into buffer.
-			///
-			/// This method is not thread-safe.</summary>
-			/// <param name="first">chromosome that should form new cluster.</param>
-			inline void GACALL CreateCluster(Population::GaChromosomeStorage* first)
-			{
-				GaSPEACluster& cluster = _clusters[ _clusterCount++ ];
-				cluster.Clear();
-				cluster.AddChromosome( first );
-			}
-
-			/// <summary><c>StoreDistance</c> method stores distance between two clusters if it is smaller than previously stored distance for the specified branch.
-			///
-			/// This method is not thread-safe.</summary>
-			/// <param name="clusterA">the first cluster.</param>
-			/// <param name="clusterB">the second cluster.</param>
-			/// <param name="branchID">ID of branch that executes operation.</param>
-			inline void GACALL StoreDistance(GaSPEACluster& clusterA,
-				GaSPEACluster& clusterB,
-				int branchID)
-			{
-				GaSPEAClusterDistance& minDistance = _minDistances[ branchID ];
-
-				// calculate distance between clusters
-				float dist = clusterA - clusterB;
-
-				// is the distance smaller than praviously stored distance?
-				if( dist < minDistance._distance )
-				{
-					// store new distance to storage object
-					minDistance._distance = dist;
-
-					minDistance._clusterA = &clusterA;
-					minDistance._clusterB = &clusterB;
-				}
-			}
-
-			/// <summary><c>MergeClosest</c> finds and merges closest clusters.
-			///
-			/// This method is not thread-safe.</summary>
-			inline void GACALL MergeClosest()
-			{
-				// find two closest clusters among the ones that are identified by the branches
-				_globalMinDistance = &_minDistances[ 0 ];
-				for( int i = _minDistances.GetSize() - 1; i > 0; i-- )
-				{
-					if( _minDistances[ i ]._distance < _globalMinDistance->_distance )
-						_globalMinDistance = &_minDistances[ i ];
-				}
-
-				// merge clusters
-				if( _globalMinDistance->_clusterA != NULL  )
-					_globalMinDistance->_clusterA->Merge( *_globalMinDistance->_clusterB );
-			}
-
-			/// <summary><c>ClearDistanceInfo</c> method clears distance inforamtions of closest clusters for specified branch.
-			///
-			/// This method is not thread-safe.</summary>
-			/// <param name="branchID">ID of branch for which the distance information should be cleared.</param>
-			inline void GACALL ClearDistanceInfo(int branchID) { _minDistances[ branchID ].Clear(); }
-
-			/// <summary><c>GetMerged</c> method returns pointer to cluster that is formed by merging closest clusters.
-			///
-			/// This method is not thread-safe.</summary>
-			/// <returns></returns>
-			inline GaSPEACluster* GACALL GetMerged() { return _globalMinDistance->_clusterA; }
-
-			/// <summary><c>IsMerged</c> method checks whether the merged clusters was identified by specified branch.
-			///
-			/// This method is not thread-safe.</summary>
-			/// <param name="branchID">ID of branch that should be checked.</param>
-			/// <returns>Method returns <c>true</c> if merged clusters was identified by specified branch.</returns>
-			inline bool GACALL IsMerged(int branchID) const
+			/// <summary><c>operator ()</c> calculates distance between two chromosomes.</summary>
+			/// <param name="point1">position of the first chromosome in the buffer.</param>
+			/// <param name="point2">position of the second chromosome in the buffer.</param>
+			/// <returns>Operator returns calculated distance.</returns>
+			inline float GACALL operator ()(int point1,
+				int point2) const
 			{
-				const GaSPEAClusterDistance& dist = _minDistances[ branchID ];
-				return !_globalMinDistance || 
-					dist._clusterA == _globalMinDistance->_clusterA || dist._clusterB == _globalMinDistance->_clusterA || dist._clusterB == _globalMinDistance->_clusterB;
+				return _matrix ? _matrix->Distance( _clusters.GetIndex( point1 ), _clusters.GetIndex( point2 ) )
+					: _clusters.GetChromosome( point1 )->GetFitness( Population::GaChromosomeStorage::GAFT_RAW ).Distance(
+					_clusters.GetChromosome( point2 )->GetFitness( Population::GaChromosomeStorage::GAFT_RAW ) );
 			}
 
-			/// <summary><c>SetSize</c> method sets sizes of buffers that handles chromosome clusters.
-			///
-			/// This method is not thread-safe.</summary>
-			/// <param name="size">number of clusters that buffer should store.</param>
-			/// <param name="branchCount">number of branches that will use bufer.</param>
-			inline void SetSize(int size,
-				int branchCount)
-			{
-				// set sizes of buffers
-				_clusters.SetSize( size );
-				_minDistances.SetSize( branchCount );
-
-				// clear buffers
-				_clusterCount = 0;
-				_globalMinDistance = NULL;
-			}
-
-			/// <summary>This method is not thread-safe.</summary>
-			/// <returns>Method returns number of clusters currently in the buffer.</returns>
-			inline int GACALL GetCount() const { return _clusterCount; }
-
-			/// <summary><c>operator []</c> provides access to chromosome cluster at specified location in the buffer.
-			///
-			/// This operator is not thread-safe.</summary>
-			/// <param name="index">index of cluster in the buffer.</param>
-			/// <returns>Method returns reference to queried buffer.</returns>
-			inline GaSPEACluster& GACALL operator [](int index) { return _clusters[ index ]; }
-
-			/// <summary><c>operator []</c> provides access to chromosome cluster at specified location in the buffer.
-			///
-			/// This operator is not thread-safe.</summary>
-			/// <param name="index">index of cluster in the buffer.</param>
-			/// <returns>Method returns reference to queried buffer.</returns>
-			inline const GaSPEACluster& GACALL operator [](int index) const { return _clusters[ index ]; }
-
 		};
 
 		/// <summary><c>GaSPEADominanceOp</c> class represents operation that compares and determins dominant chromosome and updates dominated chromosome lists.</summary>
@@ -330,6 +146,9 @@ namespace Multiobjective
 			/// <summary>ID of the brach that executes operation.</summary>
 			int _branchID;
 
+			/// <summary>Packed matrix of objective values or <c>NULL</c> if fitness comparator should be used.</summary>
+			const Population::GaObjectiveMatrix* _matrix;
+
 		public:
 
 			/// <summary>Initializes operation.</summary>
@@ -337,13 +156,16 @@ namespace Multiobjective
 			/// <param name="domList">chromosome tag that contains partial list of dominated chromosome.</param>
 			/// <param name="dominated">chromosome tag that stores information whether the chromosome is dominated by any other chromosome in the population.</param>
 			/// <param name="branchID">ID of the brach that executes operation.</param>
+			/// <param name="matrix">packed matrix of objective values. If this parameter is <c>NULL</c>, fitness comparator is used.</param>
 			GaSPEADominanceOp(Population::GaPopulation& population,
 				const Population::GaChromosomeTagGetter<GaDominanceList>& domList,
 				const Population::GaChromosomeTagGetter<int>& dominated,
-				int branchID) : _population(population),
+				int branchID,
+				const Population::GaObjectiveMatrix* matrix = NULL) : _population(population),
 				_domList(domList),
 				_dominated(dominated),
-				_branchID(branchID) { }
+				_branchID(branchID),
+				_matrix(matrix) { }
 
 			/// <summary>Dummy operator to satisfy interface.</summary>
 			inline void GACALL operator ()(Population::GaChromosomeStorage& chromosome,
@@ -363,7 +185,7 @@ namespace Multiobjective
 				if( !_dominated( chromosome1 ) || !_dominated( chromosome2 ) )
 				{
 					// get dominant chromosome
-					int dom = _population.CompareFitness( chromosome1, chromosome2 );
+					int dom = _matrix ? _matrix->Compare( index1, index2 ) : _population.CompareFitness( chromosome1, chromosome2 );
 
 					// is the first chromosome dominant?
 					if( dom < 0 )
@@ -446,7 +268,7 @@ namespace Multiobjective
 					}
 
 					// create cluster and place chromosome in it
-					_clusters.CreateCluster( &chromosome );
+					_clusters.CreateCluster( &chromosome, index );
 				}
 				else
 				{
@@ -501,110 +323,80 @@ namespace Multiobjective
 			}
 		};
 
-		/// <summary><c>GaSPEAFindClosestOp</c> class represents operation that searches for closes clusters.</summary>
-		class GaSPEAFindClosestOp
+		/// <summary><c>GaSPEAPurgeClusterOp</c> class reprsents operation that adds all chromosomes in cluster except the central chromosome to remove buffer.</summary>
+		class GaSPEAPurgeClusterOp
 		{
 
 		private:
 
-			/// <summary>Buffer that stores indentified chromosome clusters.</summary>
+			/// <summary>Buffer that stores clustered chromosomes.</summary>
 			GaSPEAClusterStorage& _clusters;
 
-			/// <summary>ID of the brach that executes operation.</summary>
-			int _branchID;
+			/// <summary>Functor that calculates distances between chromosomes.</summary>
+			GaSPEAClusterDistance _distance;
 
 		public:
 
 			/// <summary>Initializes operation.</summary>
-			/// <param name="clusters">buffer that stores indentified chromosome clusters.</param>
-			/// <param name="branchID">ID of the brach that executes operation.</param>
-			GaSPEAFindClosestOp(GaSPEAClusterStorage& clusters,
-				int branchID) : _clusters(clusters),
-				_branchID(branchID) { }
-
-			/// <summary><c>operator ()</c> calculates distance of cluster to other clusters and stores the minimal distance if it is found.</summary>
-			/// <param name="cluster">cluster who is compared to other clusters.</param>
-			/// <param name="index">index of cluster.</param>
-			inline void GACALL operator ()(GaSPEACluster& cluster,
-				int index)
-			{
-				// only for non-empty clusters
-				if( cluster.GetCount() )
-				{
-					// get distances to all other clusters
-					for( int j = _clusters.GetCount() - 1; j >= 0; j-- )
-					{
-						// except for self and other empty clusters
-						if( index != j && _clusters[ j ].GetCount() )
-							// calcualte distance and store it if it is smaller then previously found minimum
-							_clusters.StoreDistance( cluster, _clusters[ j ], _branchID );
-					}
-				}
-			}
-
-		};
-
-		/// <summary><c>GaSPEAUpdateClosestOp</c> class represents operation that updates distance information after clusters has been merged.</summary>
-		class GaSPEAUpdateClosestOp
-		{
-
-		private:
-
-			/// <summary>Buffer that stores indentified chromosome clusters.</summary>
-			GaSPEAClusterStorage& _clusters;
-
-			/// <summary>New cluster tha was formaed by merging closest cluster.</summary>
-			GaSPEACluster& _merged;
-
-			/// <summary>ID of the brach that executes operation.</summary>
-			int _branchID;
-
-		public:
-
-			/// <summary>Initializes operation.</summary>
-			/// <param name="clusters">buffer that stores indentified chromosome clusters.</param>
-			/// <param name="merged">new cluster tha was formaed by merging closest cluster.</param>
-			/// <param name="branchID">ID of the brach that executes operation.</param>
-			GaSPEAUpdateClosestOp(GaSPEAClusterStorage& clusters,
-				GaSPEACluster& merged,
-				int branchID) : _clusters(clusters),
-				_merged(merged),
-				_branchID(branchID) { }
-
-			/// <summary><c>operator ()</c> calculates distance of cluster to merged cluster and stores the minimal distance if it is found.</summary>
-			/// <param name="cluster">cluster who is compared to merged clusters.</param>
-			/// <param name="index">index of cluster.</param>
-			inline void GACALL operator ()(GaSPEACluster& cluster,
-				int index) { _clusters.StoreDistance( cluster, _merged, _branchID ); }
-
-		};
-
-		/// <summary><c>GaSPEAPurgeClustersOp</c> class reprsents operation that adds all chromosomes in cluster except the central chromosome to remove buffer.</summary>
-		class GaSPEAPurgeClustersOp
-		{
-
-		public:
+			/// <param name="clusters">buffer that stores clustered chromosomes.</param>
+			/// <param name="distance">functor that calculates distances between chromosomes.</param>
+			GaSPEAPurgeClusterOp(GaSPEAClusterStorage& clusters,
+				const GaSPEAClusterDistance& distance) : _clusters(clusters),
+				_distance(distance) { }
 
 			/// <summary><c>operator ()</c> adds chromosomes that belongs to the cluster to remove buffer.</summary>
-			/// <param name="cluster">cluster whose chromosomes should be purged.</param>
-			/// <param name="index">indef of cluster.</param>
-			inline void GACALL operator ()(GaSPEACluster& cluster,
-				int index)
+			/// <param name="cluster">index of cluster whose chromosomes should be purged.</param>
+			inline void GACALL operator ()(int cluster)
 			{
-				const Population::GaChromosomeStorage* center = cluster.GetCenter();
+				const GaAgglomerativeClustering& clustering = _clusters.GetClustering();
+				int size = clustering.GetClusterSize( cluster );
 
-				// add all chromosomes in cluster to remove buffer
-				for( const Common::Data::GaListNode<Population::GaChromosomeStorage*>* it1 = cluster.GetChromosomes().GetHead(); it1; it1 = it1->GetNext() )
+				int center = 0;
+				if( size > 2 )
 				{
-					Population::GaChromosomeStorage* current = it1->GetValue();
+					// find chromosome whose average distance to other chromosomes in the cluster is smallest
+					float minDist = std::numeric_limits<float>::infinity();
+					for( int i = 0; i < size; i++ )
+					{
+						// get sum of distances to other chromosomes in cluster for current chromosome
+						float totalDist = 0;
+						int count = 0;
+						for( int j = 0; j < size; j++ )
+						{
+							if( i != j )
+							{
+								// sum distance
+								float d = _distance( clustering.GetClusterMember( cluster, i ), clustering.GetClusterMember( cluster, j ) );
+								if( d > 0 )
+								{
+									totalDist += d;
+									count++;
+								}
+							}
+						}
+
+						// average distance of current chromosomes to other chromosomes in cluster
+						totalDist /= count;
 
-					// just keep central chromosome
-					if( current != center )
-						current->GetFlags().SetFlags( Population::GaChromosomeStorage::GACF_REMOVE_CHROMOSOME );
+						// is current chromosome closre in average to othe chromosomes then previous one?
+						if( totalDist < minDist )
+						{
+							// current chromosome is new center of the cluster
+							minDist = totalDist;
+							center = i;
+						}
+					}
 				}
+				// whene there is only two chromosomes - randomly select one
+				else if( size > 1 )
+					center = GaGlobalRandomBoolGenerator->Generate() ? 0 : 1;
 
-				// clear cluster entry in the buffer
-				cluster.GetChromosomes().Clear();
+				// add all chromosomes in cluster to remove buffer, just keep central chromosome
+				for( int i = 0; i < size; i++ )
+				{
+					if( i != center )
+						_clusters.GetChromosome( clustering.GetClusterMember( cluster, i ) )->GetFlags().SetFlags( Population::GaChromosomeStorage::GACF_REMOVE_CHROMOSOME );
+				}
 			}
 
 		};
@@ -677,10 +469,11 @@ namespace Multiobjective
 			{
 				// mark population as re-scaled
 				population.GetFlags().SetFlags( Population::GaPopulation::GAPF_COMPLETE_SCALED_FITNESS_UPDATE );
+				population.MarkModified();
 
 				// update buffer sizes when population size is changed
 				int populationSize = population.GetPopulationParams().GetPopulationSize();
-				clusters.SetSize( populationSize, branchCount );
+				clusters.SetSize( populationSize );
 			}
 
 			// chromosome tags
@@ -688,45 +481,48 @@ namespace Multiobjective
 			Population::GaChromosomeTagGetter<Common::Threading::GaAtomic<int> > getStrength( parameters.GetStrengthTagID(), population.GetChromosomeTagManager() );
 			Population::GaChromosomeTagGetter<int> getDominated( parameters.GetDominatedTagID(), population.GetChromosomeTagManager() );
 
-			clusters.ClearDistanceInfo( branchID );
-
 			Common::Workflows::GaParallelExec1<Population::GaPopulation, Population::GaChromosomeStorage> popWorkDist( *branch, population );
 			Common::Workflows::GaParallelExec2<Population::GaPopulation, Population::GaChromosomeStorage> domWorkDist( *branch, population );
+			domWorkDist.SetScheduling( Common::Workflows::GAPS_DYNAMIC );
+
+			// pack objective values of chromosomes for pairwise comparison
+			const Population::GaObjectiveMatrix* matrix = population.GetObjectiveMatrix().Update( population, branch ) ? &population.GetObjectiveMatrix() : NULL;
 
 			// determins dominant chromosomes, assign strength and fitness to chromosomes and create clusters
-			domWorkDist.Execute( GaSPEADominanceOp( population, getDomList, getDominated, branchID ), true );
+			domWorkDist.Execute( GaSPEADominanceOp( population, getDomList, getDominated, branchID, matrix ), true );
 			popWorkDist.Execute( GaSPEAStrengthOp( getStrength, getDomList, getDominated, clusters ), true );
 			popWorkDist.Execute( GaSPEAFitnessAssignOp( getStrength, getDominated, population.GetCount() ), false );
 
-			int count, start, clusterCount = clusters.GetCount();
-			branch->SplitWork( clusterCount, count, start );
-			Common::Workflows::GaParallelExec1<GaSPEAClusterStorage, GaSPEACluster> clustWorkDist( *branch, clusters );
-
-			// merge clusters so they can fit 
+			// merge clusters so they can fit
+			int clusterCount = clusters.GetCount();
 			int requiredClusters = population.GetPopulationParams().GetPermanentSpaceSize();
-			for( int currentClusterCount = clusterCount; currentClusterCount > requiredClusters; currentClusterCount-- )
+			if( clusterCount > requiredClusters )
 			{
-				// merge closest clusters
+				GaAgglomerativeClustering& clustering = clusters.GetClustering();
+				GaSPEAClusterDistance distance( clusters, matrix );
+
+				GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+					clustering.SetSize( clusterCount );
+
+				// calculate distances between all pairs of nondominated chromosomes
+				int count, start;
+				branch->SplitWork( clustering.GetPairCount(), count, start );
+				clustering.CalculateDistances( distance, start, count );
+
+				// build hierarchy of clusters
 				GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
-					clusters.MergeClosest();
+					clustering.Merge( requiredClusters );
 
-				// cluster pair found by current branch has been merged?
-				if( clusters.IsMerged( branchID ) )
+				// get chromosomes that should be removed
+				GaSPEAPurgeClusterOp purge( clusters, distance );
+				for( branch->SplitWork( clustering.GetClusterCount(), count, start ); count; count--, start++ )
 				{
-					// compare all clasters again
-					clusters.ClearDistanceInfo( branchID );
-					clustWorkDist.Execute( GaSPEAFindClosestOp( clusters, branchID ), false );
+					// random numbers used for choosing center of the cluster are mapped to substream of the cluster
+					branch->SelectRandomSubstream( start );
+					purge( start );
 				}
-				else
-					// just check new cluster if it is closer to others
-					clustWorkDist.Execute( GaSPEAUpdateClosestOp( clusters, *clusters.GetMerged(), branchID ), false );
 			}
 
-			branch->GetBarrier().Enter( true, branchCount );
-
-			// get chromosomes that should be removed
-			clustWorkDist.Execute( GaSPEAPurgeClustersOp(), false );
-
 			// update operation time statistics
 			timer.UpdateStatistics();
 		}
@@ -1038,6 +834,97 @@ namespace Multiobjective
 
 		};
 
+		/// <summary><c>GaSPEA2SpatialDensity</c> class stores spatial index of chromosomes and distances to their nearest neighbours found by querying the index.
+		///
+		/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
+		/// No public or private methods are thread-safe.</summary>
+		class GaSPEA2SpatialDensity
+		{
+
+		private:
+
+			/// <summary>Spatial index of chromosomes.</summary>
+			GaSpatialIndex _index;
+
+			/// <summary>Index of the nearest neighbour of each chromosome.</summary>
+			Common::Data::GaSingleDimensionArray<int> _nearest;
+
+			/// <summary>Distance to the nearest neighbour of each chromosome.</summary>
+			Common::Data::GaSingleDimensionArray<float> _nearestDistances;
+
+			/// <summary>Distance to the Kth nearest neighbour of each chromosome.</summary>
+			Common::Data::GaSingleDimensionArray<float> _kthDistances;
+
+		public:
+
+			/// <summary><c>Build</c> method indexes chromosomes using their objective values.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="matrix">matrix that stores objective values of chromosomes.</param>
+			/// <param name="type">structure that should be used to index chromosomes.</param>
+			void GACALL Build(const Population::GaObjectiveMatrix& matrix,
+				GaSpatialIndexType type)
+			{
+				int count = matrix.GetCount();
+				if( _nearest.GetSize() < count )
+				{
+					_nearest.SetSize( count );
+					_nearestDistances.SetSize( count );
+					_kthDistances.SetSize( count );
+				}
+
+				_index.Build( matrix.GetRow( 0 ), matrix.GetStride(), matrix.GetObjectivesCount(), count, type );
+			}
+
+			/// <summary><c>Remove</c> method removes chromosome from the index.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="index">index of chromosome.</param>
+			inline void GACALL Remove(int index) { _index.Remove( index ); }
+
+			/// <summary><c>SetNearest</c> method stores nearest neighbour of chromosome.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="index">index of chromosome.</param>
+			/// <param name="nearest">index of the nearest neighbour or -1 if chromosome has no neighbours.</param>
+			/// <param name="distance">distance to the nearest neighbour.</param>
+			inline void GACALL SetNearest(int index,
+				int nearest,
+				float distance)
+			{
+				_nearest[ index ] = nearest;
+				_nearestDistances[ index ] = distance;
+			}
+
+			/// <summary><c>SetKthDistance</c> method stores distance to Kth nearest neighbour of chromosome.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="index">index of chromosome.</param>
+			/// <param name="distance">distance to Kth nearest neighbour.</param>
+			inline void GACALL SetKthDistance(int index,
+				float distance) { _kthDistances[ index ] = distance; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <param name="index">index of chromosome.</param>
+			/// <returns>Method returns index of the nearest neighbour of chromosome or -1 if chromosome has no neighbours.</returns>
+			inline int GACALL GetNearest(int index) const { return _nearest[ index ]; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <param name="index">index of chromosome.</param>
+			/// <returns>Method returns distance to the nearest neighbour of chromosome.</returns>
+			inline float GACALL GetNearestDistance(int index) const { return _nearestDistances[ index ]; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <param name="index">index of chromosome.</param>
+			/// <returns>Method returns distance to Kth nearest neighbour of chromosome.</returns>
+			inline float GACALL GetKthDistance(int index) const { return _kthDistances[ index ]; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns spatial index of chromosomes.</returns>
+			inline const GaSpatialIndex& GACALL GetIndex() const { return _index; }
+
+		};
+
 		/// <summary><c>GaSPEA2DominanceOp</c> class represents operation that compares and determins dominant chromosome, updates dominated chromosome lists
 		/// and calculates distances between chromosomes.</summary>
 		class GaSPEA2DominanceOp
@@ -1060,6 +947,12 @@ namespace Multiobjective
 			/// <summary>ID of the brach that executes operation.</summary>
 			int _branchID;
 
+			/// <summary>Packed matrix of objective values or <c>NULL</c> if fitness comparator should be used.</summary>
+			const Population::GaObjectiveMatrix* _matrix;
+
+			/// <summary>Indicates whether the distances between chromosomes should be stored to neighbour buffers.</summary>
+			bool _distances;
+
 		public:
 
 			/// <summary>Initializes operation.</summary>
@@ -1068,15 +961,21 @@ namespace Multiobjective
 			/// <param name="dominated">chromosome tag that stores information whether the chromosome is dominated by any other chromosome in the population.</param>
 			/// <param name="kthNeighbour">chromosome tag that stores chromosome's neighbour buffer.</param>
 			/// <param name="branchID">ID of the brach that executes operation.</param>
+			/// <param name="matrix">packed matrix of objective values. If this parameter is <c>NULL</c>, fitness comparator is used.</param>
+			/// <param name="distances">if this parameter is set to <c>false</c>, distances between chromosomes are not calculated.</param>
 			GaSPEA2DominanceOp(Population::GaPopulation& population,
 				const Population::GaChromosomeTagGetter<GaDominanceList>& domList,
 				const Population::GaChromosomeTagGetter<int>& dominated,
 				const Population::GaChromosomeTagGetter<GaSPEA2NeighbourBuffer> kthNeighbour,
-				int branchID) : _population(population),
+				int branchID,
+				const Population::GaObjectiveMatrix* matrix = NULL,
+				bool distances = true) : _population(population),
 				_domList(domList),
 				_dominated(dominated),
 				_kthNeighbour(kthNeighbour),
-				_branchID(branchID) { }
+				_branchID(branchID),
+				_matrix(matrix),
+				_distances(distances) { }
 
 			/// <summary><c>operator ()</c> preapres chromosome's neighbour buffer.</summary>
 			/// <param name="chromosome">chromosome whose buffer should be prepared.</param>
@@ -1084,6 +983,9 @@ namespace Multiobjective
 			inline void GACALL operator ()(Population::GaChromosomeStorage& chromosome,
 				int index)
 			{
+				if( !_distances )
+					return;
+
 				GaSPEA2NeighbourBuffer& neighbours = _kthNeighbour( chromosome );
 
 				// prepare buffer
@@ -1102,7 +1004,7 @@ namespace Multiobjective
 				int index2)
 			{
 				// get dominant chromosome
-				int dom = _population.CompareFitness( chromosome1, chromosome2 );
+				int dom = _matrix ? _matrix->Compare( index1, index2 ) : _population.CompareFitness( chromosome1, chromosome2 );
 
 				// is the first chromosome dominant?
 				if( dom < 0 )
@@ -1119,8 +1021,12 @@ namespace Multiobjective
 					_dominated( chromosome1 ) = 1;
 				}
 
+				if( !_distances )
+					return;
+
 				// calculate and store distance between chromosomes
-				float dist = chromosome1.GetFitness( Population::GaChromosomeStorage::GAFT_RAW ).Distance( chromosome2.GetFitness( Population::GaChromosomeStorage::GAFT_RAW ) );
+				float dist = _matrix ? _matrix->Distance( index1, index2 )
+					: chromosome1.GetFitness( Population::GaChromosomeStorage::GAFT_RAW ).Distance( chromosome2.GetFitness( Population::GaChromosomeStorage::GAFT_RAW ) );
 				_kthNeighbour( chromosome1 ).Insert( index2, dist );
 				_kthNeighbour( chromosome2 ).Insert( index1, dist );
 			}
@@ -1172,8 +1078,9 @@ namespace Multiobjective
 			inline void GACALL operator ()(Population::GaChromosomeStorage& chromosome,
 				int index)
 			{
-				// sort chromosome's neighbours according to their distance
-				_kthNeighbour( chromosome ).Sort();
+				// sort chromosome's neighbours according to their distance (buffers are empty when spatial index is used)
+				if( _kthNeighbour( chromosome ).GetCount() > 0 )
+					_kthNeighbour( chromosome ).Sort();
 
 				GaDominanceList& lst = _domList( chromosome );
 
@@ -1198,6 +1105,126 @@ namespace Multiobjective
 
 		};
 
+		/// <summary><c>GaSPEA2NeighbourDistanceOp</c> class represents operation that calculates distances between chromosomes
+		/// when dominance relations are maintained by incremental dominance structure.</summary>
+		class GaSPEA2NeighbourDistanceOp
+		{
+
+		private:
+
+			/// <summary>Population over which the operation is performed.</summary>
+			Population::GaPopulation& _population;
+
+			/// <summary>Chromosome tag that stores chromosome's neighbour buffer.</summary>
+			Population::GaChromosomeTagGetter<GaSPEA2NeighbourBuffer> _kthNeighbour;
+
+			/// <summary>Packed matrix of objective values or <c>NULL</c> if fitness comparator should be used.</summary>
+			const Population::GaObjectiveMatrix* _matrix;
+
+		public:
+
+			/// <summary>Initializes operation.</summary>
+			/// <param name="population">population over which the operation is performed.</param>
+			/// <param name="kthNeighbour">chromosome tag that stores chromosome's neighbour buffer.</param>
+			/// <param name="matrix">packed matrix of objective values. If this parameter is <c>NULL</c>, fitness comparator is used.</param>
+			GaSPEA2NeighbourDistanceOp(Population::GaPopulation& population,
+				const Population::GaChromosomeTagGetter<GaSPEA2NeighbourBuffer> kthNeighbour,
+				const Population::GaObjectiveMatrix* matrix = NULL) : _population(population),
+				_kthNeighbour(kthNeighbour),
+				_matrix(matrix) { }
+
+			/// <summary><c>operator ()</c> preapres chromosome's neighbour buffer.</summary>
+			/// <param name="chromosome">chromosome whose buffer should be prepared.</param>
+			/// <param name="index">indx of chromosome.</param>
+			inline void GACALL operator ()(Population::GaChromosomeStorage& chromosome,
+				int index)
+			{
+				GaSPEA2NeighbourBuffer& neighbours = _kthNeighbour( chromosome );
+
+				// prepare buffer
+				neighbours.SetCount( _population.GetCount() );
+				neighbours.Insert( index, -1.0f );
+			}
+
+			/// <summary><c>operator ()</c> calculates distance between chromosomes.</summary>
+			/// <param name="chromosome1">the first chromosome.</param>
+			/// <param name="chromosome2">the second chromosome.</param>
+			/// <param name="index1">index of the the first chromosome.</param>
+			/// <param name="index2">index of the the second chromosome.</param>
+			inline void GACALL operator ()(Population::GaChromosomeStorage& chromosome1,
+				Population::GaChromosomeStorage& chromosome2,
+				int index1,
+				int index2)
+			{
+				float dist = _matrix ? _matrix->Distance( index1, index2 )
+					: chromosome1.GetFitness( Population::GaChromosomeStorage::GAFT_RAW ).Distance( chromosome2.GetFitness( Population::GaChromosomeStorage::GAFT_RAW ) );
+				_kthNeighbour( chromosome1 ).Insert( index2, dist );
+				_kthNeighbour( chromosome2 ).Insert( index1, dist );
+			}
+
+		};
+
+		/// <summary><c>GaSPEA2IncrementalStrengthOp</c> class represents operation that assigns strength to chromosomes
+		/// using relations maintained by incremental dominance structure.</summary>
+		class GaSPEA2IncrementalStrengthOp
+		{
+
+		private:
+
+			/// <summary>Structure that maintains dominance relations between chromosomes.</summary>
+			const GaIncrementalDominance& _dominance;
+
+			/// <summary>Chromosome tag that stores strength value of the chromosome used to calculate scaled fitness.</summary>
+			Population::GaChromosomeTagGetter<Common::Threading::GaAtomic<int> > _strength;
+
+			/// <summary>Chromosome tag that stores information whether the chromosome is dominated by any other chromosome in the population.</summary>
+			Population::GaChromosomeTagGetter<int> _dominated;
+
+			/// <summary>Chromosome tag that stores chromosome's neighbour buffer.</summary>
+			Population::GaChromosomeTagGetter<GaSPEA2NeighbourBuffer> _kthNeighbour;
+
+			/// <summary>Reference to variable that stores number of nondomnated chromosomes that are identified in the population.</summary>
+			Common::Threading::GaAtomic<int>& _nondominatedCount;
+
+		public:
+
+			/// <summary>Initializes operation.</summary>
+			/// <param name="dominance">structure that maintains dominance relations between chromosomes.</param>
+			/// <param name="strength">chromosome tag that stores strength value of the chromosome used to calculate scaled fitness.</param>
+			/// <param name="dominated">chromosome tag that stores information whether the chromosome is dominated by any other chromosome in the population.</param>
+			/// <param name="kthNeighbour">chromosome tag that stores chromosome's neighbour buffer.</param>
+			/// <param name="nondominatedCount">reference to variable that stores number of nondomnated chromosomes that are identified in the population.</param>
+			GaSPEA2IncrementalStrengthOp(const GaIncrementalDominance& dominance,
+				const Population::GaChromosomeTagGetter<Common::Threading::GaAtomic<int> >& strength,
+				const Population::GaChromosomeTagGetter<int>& dominated,
+				const Population::GaChromosomeTagGetter<GaSPEA2NeighbourBuffer> kthNeighbour,
+				Common::Threading::GaAtomic<int>& nondominatedCount) : _dominance(dominance),
+				_strength(strength),
+				_dominated(dominated),
+				_kthNeighbour(kthNeighbour),
+				_nondominatedCount(nondominatedCount) { }
+
+			/// <summary><c>operator ()</c> assigns strength to chromosome and counts nondominated chromosomes.</summary>
+			/// <param name="chromosome">chromosome whose strength should be assigned.</param>
+			/// <param name="index">index of chromosome.</param>
+			inline void GACALL operator ()(Population::GaChromosomeStorage& chromosome,
+				int index)
+			{
+				// sort chromosome's neighbours according to their distance (buffers are empty when spatial index is used)
+				if( _kthNeighbour( chromosome ).GetCount() > 0 )
+					_kthNeighbour( chromosome ).Sort();
+
+				_strength( chromosome ) = _dominance.GetRawFitness( index );
+
+				// count if chromosome is nondominated
+				if( _dominance.IsDominated( index ) )
+					_dominated( chromosome ) = 1;
+				else
+					++_nondominatedCount;
+			}
+
+		};
+
 		/// <summary><c>GaSPEAFitnessAssignOp</c> class represents operation that assigns scaled fitness to chromosomes based on their strength
 		/// and distance from their neighbours.</summary>
 		class GaSPEA2FitnessAssignOp
@@ -1217,6 +1244,9 @@ namespace Multiobjective
 			/// <summary>Kth nearest neighbour whose distances is incorporated in calculation of scaled fitness.</summary>
 			int _k;
 
+			/// <summary>Distances to neighbours found using spatial index or <c>NULL</c> if neighbour buffers should be used.</summary>
+			const GaSPEA2SpatialDensity* _density;
+
 		public:
 
 			/// <summary>Initializes operation.</summary>
@@ -1224,13 +1254,16 @@ namespace Multiobjective
 			/// <param name="dominated">chromosome tag that contains partial list of dominated chromosome.</param>
 			/// <param name="kthNeighbour">chromosome tag that stores chromosome's neighbour buffer.</param>
 			/// <param name="k">Kth nearest neighbour whose distances is incorporated in calculation of scaled fitness</param>
+			/// <param name="density">distances to neighbours found using spatial index. If this parameter is <c>NULL</c>, neighbour buffers are used.</param>
 			GaSPEA2FitnessAssignOp(const Population::GaChromosomeTagGetter<Common::Threading::GaAtomic<int> >& strength,
 				const Population::GaChromosomeTagGetter<int>& dominated,
 				const Population::GaChromosomeTagGetter<GaSPEA2NeighbourBuffer> kthNeighbour,
-				int k) : _strength(strength),
+				int k,
+				const GaSPEA2SpatialDensity* density = NULL) : _strength(strength),
 				_dominated(dominated),
 				_kthNeighbour(kthNeighbour),
-				_k(k) { }
+				_k(k),
+				_density(density) { }
 
 			/// <summary><c>operator ()</c> calculates and assigns scaled fitness to chromosome.</summary>
 			/// <param name="chromosome">chromosome whose fitness should be calculated.</param>
@@ -1239,16 +1272,15 @@ namespace Multiobjective
 				int index)
 			{
 				// get distance to kth neighbour
-				float kth = 1 + _kthNeighbour( chromosome )[ _k ];
+				float kth = 1 + ( _density ? _density->GetKthDistance( index ) : _kthNeighbour( chromosome )[ _k ] );
 
 				// calculate fitness and assign it to chromosome
 				float value =  _dominated( chromosome ) ? 1 / ( 1 / kth + _strength( chromosome ) ) : kth;
 				//float value =  _dominated( chromosome ) ? kth / ( 1 + _strength( chromosome ) ) : kth;
 				( (GaSPEAFitness&)chromosome.GetFitness( Population::GaChromosomeStorage::GAFT_SCALED ) ).SetValue( value );
 
-				// clear chromosome tags for next generation
+				// clear chromosome tag for next generation, dominance flag is needed by truncation and it is cleared afterwards
 				_strength( chromosome ) = 0;
-				_dominated( chromosome ) = 0;
 			}
 		};
 
@@ -1287,7 +1319,7 @@ namespace Multiobjective
 			{
 				GaSPEA2NeighbourBuffer& neighbours1 = _kthNeighbour( chromosome );
 
-				// skip nondominated and removed chromosomes
+				// skip dominated and removed chromosomes
 				if( !_dominated( chromosome ) && neighbours1[ 0 ] > -1.5f )
 				{
 					// get nearest neighbour
@@ -1369,6 +1401,202 @@ namespace Multiobjective
 
 		};
 
+		/// <summary><c>GaSPEA2ClearDominatedOp</c> class represents operation that clears dominance flags of chromosomes after the truncation.</summary>
+		class GaSPEA2ClearDominatedOp
+		{
+
+		private:
+
+			/// <summary>Chromosome tag that stores information whether the chromosome is dominated by any other chromosome in the population.</summary>
+			Population::GaChromosomeTagGetter<int> _dominated;
+
+		public:
+
+			/// <summary>Initializes operation.</summary>
+			/// <param name="dominated">chromosome tag that stores information whether the chromosome is dominated by any other chromosome in the population.</param>
+			GaSPEA2ClearDominatedOp(const Population::GaChromosomeTagGetter<int>& dominated) : _dominated(dominated) { }
+
+			/// <summary><c>operator ()</c> clears dominance flag of chromosome for next generation.</summary>
+			/// <param name="chromosome">chromosome whose flag should be cleared.</param>
+			/// <param name="index">index of chromosome.</param>
+			inline void GACALL operator ()(Population::GaChromosomeStorage& chromosome,
+				int index) { _dominated( chromosome ) = 0; }
+
+		};
+
+		/// <summary><c>GaSPEA2SpatialDensityOp</c> class represents operation that finds nearest and Kth nearest neighbours of chromosomes using spatial index.</summary>
+		class GaSPEA2SpatialDensityOp
+		{
+
+		private:
+
+			/// <summary>Spatial index of chromosomes and distances to their neighbours.</summary>
+			GaSPEA2SpatialDensity& _density;
+
+			/// <summary>Kth nearest neighbour whose distances is incorporated in calculation of scaled fitness.</summary>
+			int _k;
+
+			/// <summary>Buffer that stores neighbours found by the query.</summary>
+			Common::Data::GaSingleDimensionArray<GaSpatialNeighbour> _neighbours;
+
+		public:
+
+			/// <summary>Initializes operation.</summary>
+			/// <param name="density">spatial index of chromosomes and distances to their neighbours.</param>
+			/// <param name="k">Kth nearest neighbour whose distances is incorporated in calculation of scaled fitness.</param>
+			GaSPEA2SpatialDensityOp(GaSPEA2SpatialDensity& density,
+				int k) : _density(density),
+				_k(k),
+				_neighbours(k > 1 ? k : 1) { }
+
+			/// <summary><c>operator ()</c> finds neighbours of chromosome.</summary>
+			/// <param name="chromosome">chromosome whose neighbours should be found.</param>
+			/// <param name="index">index of chromosome.</param>
+			inline void GACALL operator ()(Population::GaChromosomeStorage& chromosome,
+				int index)
+			{
+				int found = _density.GetIndex().Query( index, _neighbours.GetSize(), _neighbours.GetArray() );
+				if( found == 0 )
+				{
+					_density.SetNearest( index, -1, std::numeric_limits<float>::infinity() );
+					_density.SetKthDistance( index, 0 );
+					return;
+				}
+
+				_density.SetNearest( index, _neighbours[ 0 ]._index, (float)_neighbours[ 0 ]._distance );
+
+				// use the farthest found neighbour if there is less then K chromosomes, same as for neighbour buffers chromosome itself is 0th neighbour
+				_density.SetKthDistance( index, _k > 0 ? (float)_neighbours[ found - 1 ]._distance : -1.0f );
+			}
+
+		};
+
+		/// <summary><c>GaSPEA2SpatialFindNearestOp</c> class represents operation that finds pair of nearest chromosomes using spatial index.</summary>
+		class GaSPEA2SpatialFindNearestOp
+		{
+
+		private:
+
+			/// <summary>Spatial index of chromosomes and distances to their neighbours.</summary>
+			const GaSPEA2SpatialDensity& _density;
+
+			/// <summary>Chromosome tag that stores information whether the chromosome is dominated by any other chromosome in the population.</summary>
+			Population::GaChromosomeTagGetter<int> _dominated;
+
+			/// <summary>Object that stores distance information of pair of nearest chromosomes.</summary>
+			GaSPEA2Distance& _minDist;
+
+			/// <summary>Buffer that stores neighbours of current chromosome when tie is resolved.</summary>
+			Common::Data::GaSingleDimensionArray<GaSpatialNeighbour> _neighbours1;
+
+			/// <summary>Buffer that stores neighbours of previously identified chromosome when tie is resolved.</summary>
+			Common::Data::GaSingleDimensionArray<GaSpatialNeighbour> _neighbours2;
+
+		public:
+
+			/// <summary>Initializes operation.</summary>
+			/// <param name="density">spatial index of chromosomes and distances to their neighbours.</param>
+			/// <param name="dominated">chromosome tag that stores information whether the chromosome is dominated by any other chromosome in the population.</param>
+			/// <param name="minDist">object that stores distance information of pair of nearest chromosomes.</param>
+			GaSPEA2SpatialFindNearestOp(const GaSPEA2SpatialDensity& density,
+				const Population::GaChromosomeTagGetter<int>& dominated,
+				GaSPEA2Distance& minDist) : _density(density),
+				_dominated(dominated),
+				_minDist(minDist) { }
+
+			/// <summary><c>operator ()</c> finds distance to its nearest neighbour and store distance if it is smalles distance found so far.</summary>
+			/// <param name="chromosome">chromosome whose distance to nearest neighbour should be calculated.</param>
+			/// <param name="index">index of chromosome.</param>
+			inline void GACALL operator ()(Population::GaChromosomeStorage& chromosome,
+				int index)
+			{
+				// skip dominated and removed chromosomes, dominated chromosomes stay in the index as neighbours of nondominated ones
+				if( _dominated( chromosome ) || _density.GetIndex().IsRemoved( index ) || _density.GetNearest( index ) < 0 )
+					return;
+
+				float dist = _density.GetNearestDistance( index );
+
+				// are they closer then previously identified pair or they have the same distance, but the next neighbours are closer?
+				if( dist < _minDist._distance || ( dist == _minDist._distance && IsCloser( index, _minDist._indexA ) ) )
+					_minDist.Store( index, _density.GetNearest( index ), dist, NULL );
+			}
+
+		private:
+
+			/// <summary><c>IsCloser</c> method compares distances of two chromosomes to their neighbours, starting from the second nearest neighbour,
+			/// until one chromosome has closer neighbour.</summary>
+			/// <param name="index1">index of the first chromosome.</param>
+			/// <param name="index2">index of the second chromosome.</param>
+			/// <returns>Method returns <c>true</c> if the first chromosome is closer to its neighbours.</returns>
+			bool GACALL IsCloser(int index1,
+				int index2)
+			{
+				// query more neighbours each round until distances differ
+				for( int k = 2, compared = 1; ; compared = k, k *= 2 )
+				{
+					if( _neighbours1.GetSize() < k )
+					{
+						_neighbours1.SetSize( k );
+						_neighbours2.SetSize( k );
+					}
+
+					int found1 = _density.GetIndex().Query( index1, k, _neighbours1.GetArray() );
+					int found2 = _density.GetIndex().Query( index2, k, _neighbours2.GetArray() );
+
+					for( int i = compared, count = found1 < found2 ? found1 : found2; i < count; i++ )
+					{
+						if( _neighbours1[ i ]._distance != _neighbours2[ i ]._distance )
+							return _neighbours1[ i ]._distance < _neighbours2[ i ]._distance;
+					}
+
+					// all remaining neighbours are compared
+					if( found1 < k || found2 < k )
+						return false;
+				}
+			}
+
+		};
+
+		/// <summary><c>GaSPEA2SpatialNeighbourUpdateOp</c> class represents operation that finds new nearest neighbours of chromosomes
+		/// whose nearest neighbour has been removed from spatial index.</summary>
+		class GaSPEA2SpatialNeighbourUpdateOp
+		{
+
+		private:
+
+			/// <summary>Spatial index of chromosomes and distances to their neighbours.</summary>
+			GaSPEA2SpatialDensity& _density;
+
+			/// <summary>Index of chromosome that is remved.</summary>
+			int _removedIndex;
+
+		public:
+
+			/// <summary>Initializes operation.</summary>
+			/// <param name="density">spatial index of chromosomes and distances to their neighbours.</param>
+			/// <param name="removedIndex">index of chromosome that is remved.</param>
+			GaSPEA2SpatialNeighbourUpdateOp(GaSPEA2SpatialDensity& density,
+				int removedIndex) : _density(density),
+				_removedIndex(removedIndex) { }
+
+			/// <summary><c>operator ()</c> finds new nearest neighbour of chromosome if its nearest neighbour has been removed.</summary>
+			/// <param name="chromosome">chromosome whose nearest neighbour should be updated.</param>
+			/// <param name="index">index of chromosome.</param>
+			inline void GACALL operator ()(Population::GaChromosomeStorage& chromosome,
+				int index)
+			{
+				if( _density.GetNearest( index ) == _removedIndex && !_density.GetIndex().IsRemoved( index ) )
+				{
+					GaSpatialNeighbour nearest;
+					if( _density.GetIndex().Query( index, 1, &nearest ) )
+						_density.SetNearest( index, nearest._index, (float)nearest._distance );
+					else
+						_density.SetNearest( index, -1, std::numeric_limits<float>::infinity() );
+				}
+			}
+
+		};
+
 		// Prepares population for scaling operation
 		void GaSPEA2::Prepare(Population::GaPopulation& population,
 			const Population::GaScalingParams& parameters,
@@ -1386,6 +1614,10 @@ namespace Multiobjective
 			// add required population tags
 			population.GetTagManager().AddTag( params.GetNondominatedCountTagID(), Common::Data::GaTypedTagLifecycle<Common::Threading::GaAtomic<int> >() );
 			population.GetTagManager().AddTag( params.GetDistanceStorageTagID(), Common::Data::GaTypedTagLifecycle<GaSPEA2DistanceStorage>() );
+			if( params.GetIncrementalDominanceTagID() >= 0 )
+				population.GetTagManager().AddTag( params.GetIncrementalDominanceTagID(), Common::Data::GaTypedTagLifecycle<GaIncrementalDominance>() );
+			if( params.GetSpatialIndexTagID() >= 0 )
+				population.GetTagManager().AddTag( params.GetSpatialIndexTagID(), Common::Data::GaTypedTagLifecycle<GaSPEA2SpatialDensity>() );
 
 			GaScalingOperation::Prepare( population, parameters, configuration, branchCount );
 		}
@@ -1407,6 +1639,10 @@ namespace Multiobjective
 			// remove required population tags
 			population.GetTagManager().RemoveTag( params.GetNondominatedCountTagID() );
 			population.GetTagManager().RemoveTag( params.GetDistanceStorageTagID() );
+			if( params.GetIncrementalDominanceTagID() >= 0 )
+				population.GetTagManager().RemoveTag( params.GetIncrementalDominanceTagID() );
+			if( params.GetSpatialIndexTagID() >= 0 )
+				population.GetTagManager().RemoveTag( params.GetSpatialIndexTagID() );
 
 			GaScalingOperation::Clear( population, parameters, configuration, branchCount );
 		}
@@ -1440,24 +1676,46 @@ namespace Multiobjective
 			// population tags
 			Common::Threading::GaAtomic<int>& nondominatedCount = population.GetTagByID<Common::Threading::GaAtomic<int> >( parameters.GetNondominatedCountTagID() );
 			GaSPEA2DistanceStorage& distances = population.GetTagByID<GaSPEA2DistanceStorage>( parameters.GetDistanceStorageTagID() );
+			GaIncrementalDominance* dominance = parameters.GetIncrementalDominanceTagID() >= 0
+				? &population.GetTagByID<GaIncrementalDominance>( parameters.GetIncrementalDominanceTagID() ) : NULL;
+			GaSPEA2SpatialDensity* density = parameters.GetSpatialIndexTagID() >= 0
+				? &population.GetTagByID<GaSPEA2SpatialDensity>( parameters.GetSpatialIndexTagID() ) : NULL;
+
+			// pack objective values of chromosomes for pairwise comparison
+			const Population::GaObjectiveMatrix* matrix = population.GetObjectiveMatrix().Update( population, branch ) ? &population.GetObjectiveMatrix() : NULL;
+
+			// spatial index is built from packed objective values
+			if( !matrix )
+				density = NULL;
 
 			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
 			{
 				// mark population as re-scaled
 				population.GetFlags().SetFlags( Population::GaPopulation::GAPF_COMPLETE_SCALED_FITNESS_UPDATE );
+				population.MarkModified();
 
-				// update buffer sizes when population size is changed
+				// update buffer sizes when population size is changed, buffers are not used when distances are provided by spatial index
 				int populationSize = population.GetPopulationParams().GetPopulationSize();
-				population.GetChromosomeTagManager().UpdateTag( parameters.GetKthNeighbourTagID(), GaSPEA2NeighbourBufferUpdate( populationSize ) );
+				population.GetChromosomeTagManager().UpdateTag( parameters.GetKthNeighbourTagID(), GaSPEA2NeighbourBufferUpdate( density ? 0 : populationSize ) );
+
+				if( density )
+					density->Build( *matrix, parameters.GetSpatialIndexType() );
 
 				distances.RestartGlobalMinDistance();
 				nondominatedCount = 0;
 			}
 
+			// apply changes of the population to dominance relations maintained across generations
+			if( dominance )
+			{
+				dominance->Update( population, population.GetFlags().IsFlagSetAny( Population::GaPopulation::GAPF_COMPLETE_FITNESS_UPDATE |
+					Population::GaPopulation::GAPF_FITNESS_COMPARATOR_CHANGED ), true, branch );
+			}
+
 			// chromosome tags
 			Population::GaChromosomeTagGetter<GaDominanceList> getDomList( parameters.GetDominanceListTagID(), population.GetChromosomeTagManager() );
 			Population::GaChromosomeTagGetter<Common::Threading::GaAtomic<int> > getStrength( parameters.GetStrengthTagID(), population.GetChromosomeTagManager() );
-			Population::GaChromosomeTagGetter<int> getDominated( parameters.GetDominanceListTagID(), population.GetChromosomeTagManager() );
+			Population::GaChromosomeTagGetter<int> getDominated( parameters.GetDominatedTagID(), population.GetChromosomeTagManager() );
 			Population::GaChromosomeTagGetter<GaSPEA2NeighbourBuffer> getKthNeighbour( parameters.GetKthNeighbourTagID(), population.GetChromosomeTagManager() );
 
 			GaSPEA2Distance& minDist = distances[ branchID ];
@@ -1465,11 +1723,29 @@ namespace Multiobjective
 
 			Common::Workflows::GaParallelExec1<Population::GaPopulation, Population::GaChromosomeStorage> popWorkDist( *branch, population );
 			Common::Workflows::GaParallelExec2<Population::GaPopulation, Population::GaChromosomeStorage> domWorkDist( *branch, population );
+			domWorkDist.SetScheduling( Common::Workflows::GAPS_DYNAMIC );
+
+			if( dominance && dominance->IsSupported() )
+			{
+				// strengths are already known, so only distances between chromosomes have to be determined
+				if( !density )
+					domWorkDist.Execute( GaSPEA2NeighbourDistanceOp( population, getKthNeighbour, matrix ), true );
+
+				popWorkDist.Execute( GaSPEA2IncrementalStrengthOp( *dominance, getStrength, getDominated, getKthNeighbour, nondominatedCount ), true );
+			}
+			else
+			{
+				// determins dominant chromosomes, assign strength and fitness to chromosomes and determins distances between chromosomes
+				domWorkDist.Execute( GaSPEA2DominanceOp( population, getDomList, getDominated, getKthNeighbour, branchID, matrix, !density ), true );
+				popWorkDist.Execute( GaSPEA2StrengthOp( getStrength, getDomList, getDominated, getKthNeighbour, nondominatedCount ), true );
+			}
 
-			// determins dominant chromosomes, assign strength and fitness to chromosomes and determins distances between chromosomes
-			domWorkDist.Execute( GaSPEA2DominanceOp( population, getDomList, getDominated, getKthNeighbour, branchID ), true );
-			popWorkDist.Execute( GaSPEA2StrengthOp( getStrength, getDomList, getDominated, getKthNeighbour, nondominatedCount ), true );
-			popWorkDist.Execute( GaSPEA2FitnessAssignOp( getStrength, getDominated, getKthNeighbour, parameters.GetKthNeighbourSize() ), false );
+			// find nearest neighbours of chromosomes using spatial index
+			if( density )
+				popWorkDist.Execute( GaSPEA2SpatialDensityOp( *density, parameters.GetKthNeighbourSize() ), false );
+
+			// assign fitness to chromosomes using their strength and distance from their neighbours
+			popWorkDist.Execute( GaSPEA2FitnessAssignOp( getStrength, getDominated, getKthNeighbour, parameters.GetKthNeighbourSize(), density ), false );
 
 			// identify chromosoms that are closest to their neighbours
 			int requiredCount = population.GetPopulationParams().GetPermanentSpaceSize();
@@ -1480,17 +1756,33 @@ namespace Multiobjective
 				{
 					// branch should find another pair
 					minDist.Clear();
-					popWorkDist.Execute( GaSPEA2FindNearestOp( getDominated, getKthNeighbour, minDist ), false );
+
+					if( density )
+						popWorkDist.Execute( GaSPEA2SpatialFindNearestOp( *density, getDominated, minDist ), false );
+					else
+						popWorkDist.Execute( GaSPEA2FindNearestOp( getDominated, getKthNeighbour, minDist ), false );
 				}
 
 				// get closest chromosome among the ones chosen by the branches and add it to remove buffer
 				GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
-					population[ distances.CalculateGlobalMinDistance() ].GetFlags().SetFlags( Population::GaChromosomeStorage::GACF_REMOVE_CHROMOSOME );
+				{
+					int removed = distances.CalculateGlobalMinDistance();
+					population[ removed ].GetFlags().SetFlags( Population::GaChromosomeStorage::GACF_REMOVE_CHROMOSOME );
+
+					if( density )
+						density->Remove( removed );
+				}
 
 				// remove selected chromsome for neighbours buffers of other chromosomes
-				popWorkDist.Execute( GaSPEA2NeighbourUpdateOp( getKthNeighbour, distances.GetGlobalMinDistance() ), true );
+				if( density )
+					popWorkDist.Execute( GaSPEA2SpatialNeighbourUpdateOp( *density, distances.GetGlobalMinDistance() ), true );
+				else
+					popWorkDist.Execute( GaSPEA2NeighbourUpdateOp( getKthNeighbour, distances.GetGlobalMinDistance() ), true );
 			}
 
+			// only nondominated chromosomes are candidates for truncation, so dominance flags are cleared after it
+			popWorkDist.Execute( GaSPEA2ClearDominatedOp( getDominated ), false );
+
 			// update operation time statistics
 			timer.UpdateStatistics();
 		}
@@ -15,6 +15,7 @@
 
 #include "Population.h"
 #include "FitnessValues.h"
+#include "SpatialIndex.h"
 
 namespace Multiobjective
 {
@@ -228,6 +229,15 @@ namespace Multiobjective
 			/// <summary>Chromosome's Kth nearest neighbour whose distances is incorporated in calculation of scaled fitness.</summary>
 			int _kthNeighbourSize;
 
+			/// <summary>ID of population tag that stores incremental dominance structure. Incremental ranking is disabled if ID is negative.</summary>
+			int _incrementalDominanceTagID;
+
+			/// <summary>ID of population tag that stores spatial index of chromosomes. Distances are stored in chromosomes' neighbour buffers if ID is negative.</summary>
+			int _spatialIndexTagID;
+
+			/// <summary>Structure used to index chromosomes in objective space.</summary>
+			GaSpatialIndexType _spatialIndexType;
+
 		public:
 
 			/// <summary>This constructor initializes parameters with used-defined values.</summary>
@@ -238,23 +248,35 @@ namespace Multiobjective
 			/// <param name="nondominatedCountTagID">ID of population tag that stores number of nondominated chromosomes in the population.</param>
 			/// <param name="kthNeighbourTagID">ID of chromosomes tag that stores distances of chromosome to other chromosomes.</param>
 			/// <param name="kthNeighbourSize">chromosome's Kth nearest neighbour whose distances is incorporated in calculation of scaled fitness.</param>
+			/// <param name="incrementalDominanceTagID">ID of population tag that stores incremental dominance structure.</param>
+			/// <param name="spatialIndexTagID">ID of population tag that stores spatial index of chromosomes.</param>
+			/// <param name="spatialIndexType">structure used to index chromosomes in objective space.</param>
 			GaSPEA2Params(int dominanceListTagID,
 				int strengthTagID,
 				int dominatedTagID,
 				int distanceStorageTagID,
 				int nondominatedCountTagID,
 				int kthNeighbourTagID,
-				int kthNeighbourSize) : GaSPEAParamsBase(dominanceListTagID, strengthTagID, dominatedTagID),
+				int kthNeighbourSize,
+				int incrementalDominanceTagID = -1,
+				int spatialIndexTagID = -1,
+				GaSpatialIndexType spatialIndexType = GASIT_AUTO) : GaSPEAParamsBase(dominanceListTagID, strengthTagID, dominatedTagID),
 				_distanceStorageTagID(distanceStorageTagID),
 				_nondominatedCountTagID(nondominatedCountTagID),
 				_kthNeighbourTagID(kthNeighbourTagID),
-				_kthNeighbourSize(kthNeighbourSize) { }
+				_kthNeighbourSize(kthNeighbourSize),
+				_incrementalDominanceTagID(incrementalDominanceTagID),
+				_spatialIndexTagID(spatialIndexTagID),
+				_spatialIndexType(spatialIndexType) { }
 
 			/// <summary>This constructor initializes parameters with default values.</summary>
 			GaSPEA2Params() : _distanceStorageTagID(-1),
 				_nondominatedCountTagID(-1),
 				_kthNeighbourTagID(-1),
-				_kthNeighbourSize(0) { }
+				_kthNeighbourSize(0),
+				_incrementalDominanceTagID(-1),
+				_spatialIndexTagID(-1),
+				_spatialIndexType(GASIT_AUTO) { }
 
 			/// <summary>More details are given in specification of <see cref="GaParameters::Clone" /> method.
 			///
@@ -305,6 +327,42 @@ namespace Multiobjective
 			/// <returns>Method returns chromosome's Kth nearest neighbour whose distances is incorporated in calculation of scaled fitness.</returns>
 			inline int GACALL GetKthNeighbourSize() const { return _kthNeighbourSize; }
 
+			/// <summary><c>SetIncrementalDominanceTagID</c> method sets population tag that stores incremental dominance structure.
+			/// When the tag is set, strengths of chromosomes are maintained across generations and updated only for chromosomes that were replaced.
+			/// Distances between chromosomes are still calculated for all pairs.
+			/// Incremental ranking requires fitness objects that can provide their values. Operation falls back to pairwise comparison otherwise.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="tagID">ID of the tag. Negative value disables incremental ranking.</param>
+			inline void GACALL SetIncrementalDominanceTagID(int tagID) { _incrementalDominanceTagID = tagID; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns ID of population tag that stores incremental dominance structure.</returns>
+			inline int GACALL GetIncrementalDominanceTagID() const { return _incrementalDominanceTagID; }
+
+			/// <summary><c>SetSpatialIndexTagID</c> method sets population tag that stores spatial index of chromosomes.
+			/// When the tag is set, distances to nearest neighbours are found by querying the index, so distances between all pairs
+			/// of chromosomes are neither calculated nor stored. The index also maintains nearest neighbours during archive truncation.
+			/// Spatial index requires fitness objects that can provide their values. Operation falls back to neighbour buffers otherwise.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="tagID">ID of the tag. Negative value disables spatial index.</param>
+			inline void GACALL SetSpatialIndexTagID(int tagID) { _spatialIndexTagID = tagID; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns ID of population tag that stores spatial index of chromosomes.</returns>
+			inline int GACALL GetSpatialIndexTagID() const { return _spatialIndexTagID; }
+
+			/// <summary><c>SetSpatialIndexType</c> method sets structure used to index chromosomes in objective space.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="type">type of the structure.</param>
+			inline void GACALL SetSpatialIndexType(GaSpatialIndexType type) { _spatialIndexType = type; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns structure used to index chromosomes in objective space.</returns>
+			inline GaSpatialIndexType GACALL GetSpatialIndexType() const { return _spatialIndexType; }
+
 		};
 
 		/// <summary><c>GaSPEA2</c> class repesents scaling operation that implements Improved Strength Pareto Evolutionary Algorithm.
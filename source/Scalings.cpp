@@ -41,17 +41,25 @@ namespace Population
 			{
 				// rescale all chromosomes in population
 				Common::Workflows::GaParallelExec1<GaPopulation, GaChromosomeStorage> workDist( *branch, population );
+				workDist.SetScheduling( Common::Workflows::GAPS_GUIDED );
 				workDist.Execute( operation, false );
 
 				// mark population as rescaled
 				GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
+				{
 					population.GetFlags().SetFlags( GaPopulation::GAPF_COMPLETE_SCALED_FITNESS_UPDATE );
+					population.MarkModified();
+				}
 			}
 			else
 			{
 				// perform scaling only on new chromosomes
 				Common::Workflows::GaParallelExec1<GaChromosomeGroup, GaChromosomeStorage> workDist( *branch, population.GetNewChromosomes() );
+				workDist.SetScheduling( Common::Workflows::GAPS_GUIDED );
 				workDist.Execute( operation, false );
+
+				// scaled fitness values of new chromosomes are changed
+				population.MarkModified();
 			}
 		}
 
@@ -176,11 +184,15 @@ namespace Population
 
 			// scale chromosomes
 			Common::Workflows::GaParallelExec1<GaPopulation, GaChromosomeStorage> workDist( *branch, population );
+			workDist.SetScheduling( Common::Workflows::GAPS_GUIDED );
 			workDist.Execute( GaRankingScalingOp( population.GetCount() - 1 ), false );
 
 			// mark population as rescaled
 			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
+			{
 				population.GetFlags().SetFlags( GaPopulation::GAPF_COMPLETE_SCALED_FITNESS_UPDATE );
+				population.MarkModified();
+			}
 
 			// update operation time statistics
 			timer.UpdateStatistics();
@@ -274,7 +286,10 @@ namespace Population
 
 			// mark population as rescaled
 			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
+			{
 				population.GetFlags().SetFlags( GaPopulation::GAPF_COMPLETE_SCALED_FITNESS_UPDATE );
+				population.MarkModified();
+			}
 
 			// get stats needed to calculate a and b
 			float max = population.GetStatistics().GetValue<Fitness::GaFitness>( GADV_BEST_FITNESS ).GetCurrentValue().GetProbabilityBase();
@@ -313,6 +328,7 @@ namespace Population
 
 			// scale chromosomes
 			Common::Workflows::GaParallelExec1<GaPopulation, GaChromosomeStorage> workDist( *branch, population );
+			workDist.SetScheduling( Common::Workflows::GAPS_GUIDED );
 			workDist.Execute( GaLinearScalingOp( a, b ), false );
 
 			// update operation time statistics
@@ -372,13 +388,17 @@ namespace Population
 
 			// mark population as rescaled
 			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
+			{
 				population.GetFlags().SetFlags( GaPopulation::GAPF_COMPLETE_SCALED_FITNESS_UPDATE );
+				population.MarkModified();
+			}
 
 			float avg = population.GetStatistics().GetValue<Fitness::GaFitness>( GADV_AVG_FITNESS ).GetCurrentValue().GetProbabilityBase();
 			float dev = population.GetStatistics().GetValue<float>( GADV_DEVIATION ).GetCurrentValue();
 
 			// scale chromosomes
 			Common::Workflows::GaParallelExec1<GaPopulation, GaChromosomeStorage> workDist( *branch, population );
+			workDist.SetScheduling( Common::Workflows::GAPS_GUIDED );
 			workDist.Execute( GaSigmaTruncationScalingOp( avg, dev, ( (const GaScalingFactorParams&)parameters ).GetFactor() ), false );
 
 			// update operation time statistics
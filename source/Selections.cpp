@@ -20,7 +20,9 @@ namespace Population
 	namespace SelectionOperations
 	{
 
-		/// <summary><c>GetSelectedChromosome</c> function returns chromosomes storage object at specifed index in population and marks it as selected.</summary>
+		/// <summary><c>GetSelectedChromosome</c> function returns chromosomes storage object at specifed index in population and marks it as selected.
+		/// When duplicates are not allowed, the branch which marks chromosome first gets it, so the selection does not produce the same results
+		/// for the same seed when it is performed by multiple branches.</summary>
 		/// <param name="population">population tho whic the chromosome belongs.</param>
 		/// <param name="selectedIndex">index of queried chromosome.</param>
 		/// <param name="duplicate">tag that contains information whether the chromosomes is already selected or not. If tag does not exist chromosome is always selected.</param>
@@ -39,12 +41,14 @@ namespace Population
 		/// If crossover buffer is specified this operation puts chromosomes in it instead of result set and when the buffer is fuul mating operation 
 		/// is performed and offspring chromosomes are stored in result set.</summary>
 		/// <param name="chromosome">chromosome that should be stored to selection result set.</param>
+		/// <param name="index">index of the selection. It determines position of chromosome or its offspring in the selection result set.</param>
 		/// <param name="output">selection result set.</param>
 		/// <param name="crossoverBuffer">crossover buffer that will be used for producing offspring chromosomes. If this parameter is set <c>NULL</c>,
 		/// specified chromosome will be put streight into result set.</param>
 		/// <param name="counters">counters of performed operations.</param>
 		/// <param name="configuration">selection configuration.</param>
 		void GACALL StoreSelectedChromosome(GaChromosomeStorage* chromosome,
+			int index,
 			GaChromosomeGroup& output,
 			GaCrossoverStorageBuffer* crossoverBuffer,
 			GaCouplingCounters& counters,
@@ -60,10 +64,8 @@ namespace Population
 					// buffer is full - performe crossover
 					configuration.Mate( *crossoverBuffer );
 
-					// add offspring chromosomes to output buffer
-					GaChromosomeGroup& offspring = crossoverBuffer->GetOffspring(); 
-					while( GaChromosomeStorage* child = offspring.PopLast( true ) )
-						output.AddAtomic( child );
+					// add offspring chromosomes to output buffer at positions reserved for the mating
+					crossoverBuffer->CollectOffspring( output, index / parents.GetSize() * configuration.GetMating().GetConfiguration().GetOffspringCount() );
 
 					// update operation counters
 					counters.CollectCrossoverBufferCounters( *crossoverBuffer );
@@ -72,7 +74,56 @@ namespace Population
 			}
 			else
 				// just add selected chromosome to result set
-				output.AddAtomic( chromosome );
+				output.SetAt( index, chromosome );
+		}
+
+		/// <summary><c>PrepareSelection</c> function clears selection result set, reserves positions for selected chromosomes or produced offspring chromosomes
+		/// and calculates workload of the branch. If the selection operation produces offspring, workload is split in whole matings,
+		/// so all parents of a single mating are selected by the same branch.</summary>
+		/// <param name="output">selection result set.</param>
+		/// <param name="total">total number of chromosomes that should be selected.</param>
+		/// <param name="crossoverBuffer">crossover buffer used by the branch for producing offspring chromosomes or <c>NULL</c> if the operation just selects chromosomes.</param>
+		/// <param name="configuration">selection configuration.</param>
+		/// <param name="branch">workflow branch that executes selecteion operation.</param>
+		/// <param name="count">reference to variable that will store number of selections that the branch should perform.</param>
+		/// <param name="start">reference to variable that will store index of the first selection that the branch should perform.</param>
+		void GACALL PrepareSelection(GaChromosomeGroup& output,
+			int total,
+			GaCrossoverStorageBuffer* crossoverBuffer,
+			const GaCouplingConfig& configuration,
+			Common::Workflows::GaBranch* branch,
+			int& count,
+			int& start)
+		{
+			const Chromosome::GaMatingConfig& matingConfig = configuration.GetMating().GetConfiguration();
+			int unit = crossoverBuffer ? matingConfig.GetParentCount() : 1;
+
+			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
+			{
+				output.Clear();
+				output.SetCount( crossoverBuffer ? total / unit * matingConfig.GetOffspringCount() : total );
+			}
+
+			branch->SplitWork( total / unit, count, start );
+			count *= unit;
+			start *= unit;
+		}
+
+		/// <summary><c>CompleteSelection</c> function removes positions reserved for offspring chromosomes that mating operations have not produced.
+		/// All branches that execute selection operation must call this function after they have stored their results.</summary>
+		/// <param name="output">selection result set.</param>
+		/// <param name="crossoverBuffer">crossover buffer used by the branch for producing offspring chromosomes or <c>NULL</c> if the operation just selects chromosomes.</param>
+		/// <param name="branch">workflow branch that executes selecteion operation.</param>
+		inline void GACALL CompleteSelection(GaChromosomeGroup& output,
+			GaCrossoverStorageBuffer* crossoverBuffer,
+			Common::Workflows::GaBranch* branch)
+		{
+			// selected chromosomes fill all reserved positions, only matings can leave them empty
+			if( crossoverBuffer )
+			{
+				GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
+					output.Compact();
+			}
 		}
 
 		/// <summary><c>GaClearDuplicateFlagsOp</c> class represents operation that clears chromosomes tag which indicates whether the chromosome was selected.</summary>
@@ -139,25 +190,25 @@ namespace Population
 		{
 			GaSelectionCounters counters( population, GADV_SELECTION_TIME );
 
-			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
-				output.Clear();
-
 			GaCrossoverStorageBuffer* crossoverBuffer = GetCrossoverBuffer( population, parameters, branch );
 
 			// get workload for this branch
 			int count, start;
-			branch->SplitWork( GetSelectionCount( parameters, &configuration.GetMating().GetConfiguration() ), count, start );
+			PrepareSelection( output, GetSelectionCount( parameters, &configuration.GetMating().GetConfiguration() ), crossoverBuffer, configuration, branch, count, start );
 
 			// fill result set
 			for( int i = start + count - 1; i >= start; i-- )
 			{
 				// store selected chromosome to result set
-				StoreSelectedChromosome( &population[ i ], output, crossoverBuffer, counters, configuration );
+				StoreSelectedChromosome( &population[ i ], i, output, crossoverBuffer, counters, configuration );
 
 				// update selection counter
 				counters.IncSelectionCounter();
 			}
 
+			// remove positions of offspring that were not produced
+			CompleteSelection( output, crossoverBuffer, branch );
+
 			// update population statistics with new state of counters
 			counters.UpdateStatistics();
 		}
@@ -171,26 +222,26 @@ namespace Population
 		{
 			GaSelectionCounters counters( population, GADV_SELECTION_TIME );
 
-			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
-				output.Clear();
-
 			GaCrossoverStorageBuffer* crossoverBuffer = GetCrossoverBuffer( population, parameters, branch );
 
 			// get workload for this branch
 			int count, start, total = GetSelectionCount( parameters, &configuration.GetMating().GetConfiguration() );
-			branch->SplitWork( total, count, start );
-			start += population.GetCount() - total;
+			PrepareSelection( output, total, crossoverBuffer, configuration, branch, count, start );
+			int offset = population.GetCount() - total;
 
 			// fill result set
 			for( int i = start + count - 1; i >= start; i-- )
 			{
 				// store selected chromosome to result set
-				StoreSelectedChromosome( &population[ i ], output, crossoverBuffer, counters, configuration );
+				StoreSelectedChromosome( &population[ offset + i ], i, output, crossoverBuffer, counters, configuration );
 
 				// update selection counter
 				counters.IncSelectionCounter();
 			}
 
+			// remove positions of offspring that were not produced
+			CompleteSelection( output, crossoverBuffer, branch );
+
 			// update population statistics with new state of counters
 			counters.UpdateStatistics();
 		}
@@ -234,31 +285,37 @@ namespace Population
 		{
 			GaSelectionCounters counters( population, GADV_SELECTION_TIME );
 
-			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
-				output.Clear();
-
 			GaCrossoverStorageBuffer* crossoverBuffer = GetCrossoverBuffer( population, parameters, branch );
 			GaChromosomeTagGetter<Common::Threading::GaAtomic<int> > getDuplicate( parameters.GetSelectedTagID(), population.GetChromosomeTagManager() );
 
 			// get workload for this branch and fill the result set
-			int count,  maxIndex = population.GetCount() - 1;
-			for( branch->SplitWork( GetSelectionCount( parameters, &configuration.GetMating().GetConfiguration() ), count ); count ; )
+			int count, start, maxIndex = population.GetCount() - 1;
+			PrepareSelection( output, GetSelectionCount( parameters, &configuration.GetMating().GetConfiguration() ), crossoverBuffer, configuration, branch, count, start );
+			for( ; count ; count-- )
 			{
-				// get random chromosome
-				GaChromosomeStorage* selected = GetSelectedChromosome( population, GaGlobalRandomIntegerGenerator->Generate( 0, maxIndex ), getDuplicate );
+				// random numbers used for selecting each chromosome are mapped to substream of the selection
+				int index = start + count - 1;
+				branch->SelectRandomSubstream( index );
+
+				GaChromosomeStorage* selected = NULL;
 
 				// chromosome successfully selected?
-				if( selected )
+				while( !selected )
 				{
-					// store selected chromosome to result set
-					StoreSelectedChromosome( selected, output, crossoverBuffer, counters, configuration );
-					count--;
+					// get random chromosome
+					selected = GetSelectedChromosome( population, GaGlobalRandomIntegerGenerator->Generate( 0, maxIndex ), getDuplicate );
+
+					// update selection counter
+					counters.IncSelectionCounter();
 				}
 
-				// update selection counter
-				counters.IncSelectionCounter();
+				// store selected chromosome to result set
+				StoreSelectedChromosome( selected, index, output, crossoverBuffer, counters, configuration );
 			}
 
+			// remove positions of offspring that were not produced
+			CompleteSelection( output, crossoverBuffer, branch );
+
 			// clear indication of selection duplicates
 			ClearDuplicateFlags( population, getDuplicate, branch );
 
@@ -266,36 +323,10 @@ namespace Population
 			counters.UpdateStatistics();
 		}
 
-		/// <summary><c>GaRouletteWheelIndex</c> function implements roulette wheel mechanism for selection chromosomes.</summary>
-		/// <param name="population">population over which the selection operation is perofmed.</param>
-		/// <param name="totalProbability">sum of selection probabilities of all chromosomes in the population.</param>
-		/// <returns>Method returns index of selected chromosome.</returns>
-		int GACALL GaRouletteWheelIndex(GaPopulation& population,
-			float totalProbability)
-		{
-			// generate random value
-			float random = GaGlobalRandomFloatGenerator->Generate( totalProbability );
-			float current = 0;
-
-			// choose chromosome using roulette wheel mechanism
-			int selected = 0;
-			for( int maxIndex = population.GetCount() - 1; selected < maxIndex; selected++ )
-			{
-				current += population[ selected ].GetFitness( GaChromosomeStorage::GAFT_SCALED ).GetProbabilityBase();
-
-				if( current >= random )
-					break;
-			}
-
-			return selected;
-		}
-
 		/// <summary><c>GaRandomIndex</c> function implements mechansim for random chromosomes selection.</summary>
 		/// <param name="population">population over which the selection operation is perofmed.</param>
-		/// <param name="totalProbability">sum of selection probabilities of all chromosomes in the population.</param>
 		/// <returns>Method returns index of selected chromosome.</returns>
-		int GACALL GaRandomIndex(GaPopulation& population,
-			float totalProbability) { return GaGlobalRandomIntegerGenerator->Generate( 0, population.GetCount() - 1 ); }
+		inline int GACALL GaRandomIndex(GaPopulation& population) { return GaGlobalRandomIntegerGenerator->Generate( 0, population.GetCount() - 1 ); }
 
 		// Performs roulette wheel selection of chromosomes in the population
 		void GaRouletteWheelSelection::Exec(GaPopulation& population,
@@ -306,34 +337,44 @@ namespace Population
 		{
 			GaSelectionCounters counters( population, GADV_SELECTION_TIME );
 
-			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
-				output.Clear();
-
 			GaCrossoverStorageBuffer* crossoverBuffer = GetCrossoverBuffer( population, parameters, branch );
 			GaChromosomeTagGetter<Common::Threading::GaAtomic<int> > getDuplicate( parameters.GetSelectedTagID(), population.GetChromosomeTagManager() );
 
 			// get sum of selection probabilities of all chromosomes in the population.
 			float totalProbability = population.GetStatistics().GetValue<Fitness::GaFitness>( GADV_TOTAL_FITNESS_SCALED ).GetCurrentValue().GetProbabilityBase();
 
+			// cumulative probabilities are shared by all branches and built only once after the population is scaled
+			GaRouletteWheelTable& table = population.GetRouletteWheel();
+			table.Update( population, branch );
+
 			// get workload for this branch and fill the result set
-			int count,  maxIndex = population.GetCount() - 1;
-			for( branch->SplitWork( GetSelectionCount( parameters, &configuration.GetMating().GetConfiguration() ), count ); count ; )
+			int count, start;
+			PrepareSelection( output, GetSelectionCount( parameters, &configuration.GetMating().GetConfiguration() ), crossoverBuffer, configuration, branch, count, start );
+			for( ; count ; count-- )
 			{
-				// get chromosome with cerian probability
-				GaChromosomeStorage* selected = GetSelectedChromosome( population, GaRouletteWheelIndex( population, totalProbability ), getDuplicate );
+				// random numbers used for selecting each chromosome are mapped to substream of the selection
+				int index = start + count - 1;
+				branch->SelectRandomSubstream( index );
+
+				GaChromosomeStorage* selected = NULL;
 
 				// chromosome successfully selected?
-				if( selected )
+				while( !selected )
 				{
-					// store selected chromosome to result set
-					StoreSelectedChromosome( selected, output, crossoverBuffer, counters, configuration );
-					count--;
+					// get chromosome with cerian probability
+					selected = GetSelectedChromosome( population, table.GetIndex( totalProbability ), getDuplicate );
+
+					// update selection counter
+					counters.IncSelectionCounter();
 				}
 
-				// update selection counter
-				counters.IncSelectionCounter();
+				// store selected chromosome to result set
+				StoreSelectedChromosome( selected, index, output, crossoverBuffer, counters, configuration );
 			}
 
+			// remove positions of offspring that were not produced
+			CompleteSelection( output, crossoverBuffer, branch );
+
 			// clear indication of selection duplicates
 			ClearDuplicateFlags( population, getDuplicate, branch );
 
@@ -350,9 +391,6 @@ namespace Population
 		{
 			GaSelectionCounters counters( population, GADV_SELECTION_TIME );
 
-			GA_BARRIER_SYNC( lock, branch->GetBarrier(), branch->GetBarrierCount() )
-				output.Clear();
-
 			GaCrossoverStorageBuffer* crossoverBuffer = GetCrossoverBuffer( population, parameters, branch );
 			GaChromosomeTagGetter<Common::Threading::GaAtomic<int> > getDuplicate( parameters.GetSelectedTagID(), population.GetChromosomeTagManager() );
 
@@ -360,19 +398,29 @@ namespace Population
 			float totalProbability = population.GetStatistics().GetValue<Fitness::GaFitness>( GADV_TOTAL_FITNESS_SCALED ).GetCurrentValue().GetProbabilityBase();
 
 			// underlying selection mechanism
-			int (GACALL *indexMethod )(GaPopulation&, float) = parameters.GetType() == GaTournamentSelectionParams::GATST_RANDOM_SELECTION ? GaRandomIndex : GaRouletteWheelIndex;
+			bool randomSelection = parameters.GetType() == GaTournamentSelectionParams::GATST_RANDOM_SELECTION;
+
+			// cumulative probabilities are shared by all branches and built only once after the population is scaled
+			GaRouletteWheelTable& table = population.GetRouletteWheel();
+			if( !randomSelection )
+				table.Update( population, branch );
 
 			// get workload for this branch and fill the result set
-			int count;
-			for( branch->SplitWork( GetSelectionCount( parameters, &configuration.GetMating().GetConfiguration() ), count ); count ; count-- )
+			int count, start;
+			PrepareSelection( output, GetSelectionCount( parameters, &configuration.GetMating().GetConfiguration() ), crossoverBuffer, configuration, branch, count, start );
+			for( ; count ; count-- )
 			{
+				// random numbers used for selecting each chromosome are mapped to substream of the selection
+				int index = start + count - 1;
+				branch->SelectRandomSubstream( index );
+
 				GaChromosomeStorage* selected = NULL;
 
 				// chromosome successfully selected?
 				while( !selected )
 				{
 					// get chromosome using choosen selection method
-					selected = GetSelectedChromosome( population, indexMethod( population, totalProbability ), getDuplicate );
+					selected = GetSelectedChromosome( population, randomSelection ? GaRandomIndex( population ) : table.GetIndex( totalProbability ), getDuplicate );
 
 					// update selection counter
 					counters.IncSelectionCounter();
@@ -387,7 +435,7 @@ namespace Population
 					while( !newSelected )
 					{
 						// get chromosome using choosen selection method
-						newSelected = GetSelectedChromosome( population, indexMethod( population, totalProbability ), getDuplicate );
+						newSelected = GetSelectedChromosome( population, randomSelection ? GaRandomIndex( population ) : table.GetIndex( totalProbability ), getDuplicate );
 
 						// update selection counter
 						counters.IncSelectionCounter();
@@ -399,9 +447,12 @@ namespace Population
 				}
 
 				// store the best chromosome to result set
-				StoreSelectedChromosome( selected, output, crossoverBuffer, counters, configuration );
+				StoreSelectedChromosome( selected, index, output, crossoverBuffer, counters, configuration );
 			}
 
+			// remove positions of offspring that were not produced
+			CompleteSelection( output, crossoverBuffer, branch );
+
 			// clear indication of selection duplicates
 			ClearDuplicateFlags( population, getDuplicate, branch );
 
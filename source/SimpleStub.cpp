@@ -30,7 +30,9 @@ namespace Algorithm
 			const Population::GaCouplingSetup& coupling,
 			const Population::GaReplacementSetup& replacement,
 			const Population::GaScalingSetup& scaling,
-			const Population::GaFitnessComparatorSortingCriteria& populationSort) : GaBasicStub(populationID, statisticsID)
+			const Population::GaFitnessComparatorSortingCriteria& populationSort) : GaBasicStub(populationID, statisticsID),
+			_breedChunkSize(0),
+			_couplingChunkSize(0)
 		{
 			// stores operations and their parameters
 			SetPopulationParameters( populationParameters );
@@ -126,6 +128,11 @@ namespace Algorithm
 		{
 			_coupling = coupling;
 
+			// offspring produced by coupling are evaluated in chunks of the same size as when selection produces them,
+			// unless the user has specified chunk size in coupling parameters
+			_couplingChunkSize = _coupling.HasParameters() ? _coupling.GetParameters().GetEvaluationChunkSize() : 0;
+			UpdateCouplingChunkSize();
+
 			// update coupling operation setup stored in flow step if stub is connected
 			if( IsConnected() )
 			{
@@ -248,7 +255,7 @@ namespace Algorithm
 			_initStep = new Common::Workflows::GaSimpleMethodExecStep<Population::GaPopulation, Common::Workflows::GaMethodExecIgnoreBranch<Population::GaPopulation> >
 				( &Population::GaPopulation::Initialize, GetWorkflowStorage(), _populationID );
 
-			_selectionStep = new Population::GaSelectionStep( _selection, GetWorkflowStorage(), _populationID, bgStorage, GADID_SELECTION_OUTPUT );
+			_selectionStep = new Population::GaBreedStep( _selection, GetWorkflowStorage(), _populationID, bgStorage, GADID_SELECTION_OUTPUT, _breedChunkSize );
 
 			_couplingStep = new Population::GaCouplingStep( _coupling, bgStorage, GADID_SELECTION_OUTPUT, bgStorage, GADID_COUPLING_OUTPUT );
 
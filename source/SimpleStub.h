@@ -49,8 +49,11 @@ namespace Algorithm
 			/// <summary>Setup of the selection operation used by the algorithm.</summary>
 			Population::GaSelectionSetup _selection;
 
-			/// <summary>Flow step that performs selection operation.</summary>
-			Population::GaSelectionStep* _selectionStep;
+			/// <summary>Number of offspring chromosomes that are evaluated together when selection operation produces offspring.</summary>
+			int _breedChunkSize;
+
+			/// <summary>Flow step that performs selection operation. If selection produces offspring, the step also evaluates them in chunks.</summary>
+			Population::GaBreedStep* _selectionStep;
 
 			/// <summary>Flow connection between selection operation and coupling operation. Indicates whether the coupling operation is used.</summary>
 			Common::Workflows::GaFlowConnection* _couplingConnection;
@@ -58,6 +61,10 @@ namespace Algorithm
 			/// <summary>Setup of the coupling operation used by the algorithm.</summary>
 			Population::GaCouplingSetup _coupling;
 
+			/// <summary>Evaluation chunk size that is specified by parameters of the coupling operation provided by the user.
+			/// If it is 0, coupling operation uses breed chunk size.</summary>
+			int _couplingChunkSize;
+
 			/// <summary>Flow connection between selection operation and coupling operation. Indicates whether the couling operation is used.</summary>
 			Population::GaCouplingStep* _couplingStep;
 
@@ -135,7 +142,8 @@ namespace Algorithm
 				const Population::GaFitnessComparatorSortingCriteria& populationSort);
 
 			/// <summary>Initializes simple algorithm stub without population on which it will operate and with default operations and parameters.</summary>
-			GaSimpleGAStub() { Clear(); }
+			GaSimpleGAStub() : _breedChunkSize(0),
+				_couplingChunkSize(0) { Clear(); }
 
 			/// <summary><c>SetPopulationParameters</c> method new parameters for the population.
 			///
@@ -211,6 +219,43 @@ namespace Algorithm
 			GAL_API
 			void GACALL SetStatsTrackers(const GaStatTrackersCollection& trackers);
 
+			/// <summary><c>SetBreedChunkSize</c> method sets number of offspring chromosomes that are evaluated together.
+			/// When selection operation produces offspring, selection, mating and evaluation of offspring are fused into single step
+			/// (see <see cref="GaBreedStep" /> class). Otherwise chunk size is passed to parameters of coupling operation
+			/// (see <see cref="GaCouplingParams::SetEvaluationChunkSize" /> method), unless the parameters already specify their own chunk size.
+			/// By default chunk size is 0, so the fused step is not used unless it is requested explicitly.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="size">number of offspring chromosomes. If it is set to 0 offspring are evaluated as soon as they are produced.</param>
+			/// <exception cref="GaArgumentOutOfRangeException" />Thrown if <c>size</c> is negative value.</exception>
+			inline void GACALL SetBreedChunkSize(int size)
+			{
+				GA_ARG_ASSERT( Common::Exceptions::GaArgumentOutOfRangeException, size >= 0, "size", "Size of chunk cannot be negative value.", "Algorithm" );
+				_breedChunkSize = size;
+				UpdateCouplingChunkSize();
+
+				// update chunk size stored in flow steps if stub is connected
+				if( IsConnected() )
+				{
+					_selectionStep->SetChunkSize( _breedChunkSize );
+					_couplingStep->SetSetup( _coupling );
+				}
+			}
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns number of offspring chromosomes that are evaluated together when selection operation produces offspring.</returns>
+			inline int GACALL GetBreedChunkSize() const { return _breedChunkSize; }
+
+		private:
+
+			/// <summary><c>UpdateCouplingChunkSize</c> method sets evaluation chunk size of coupling operation to breed chunk size
+			/// if the user has not specified it in parameters of the coupling operation.</summary>
+			inline void GACALL UpdateCouplingChunkSize()
+			{
+				if( _coupling.HasParameters() )
+					_coupling.GetParameters().SetEvaluationChunkSize( _couplingChunkSize ? _couplingChunkSize : _breedChunkSize );
+			}
+
 		protected:
 
 			/// <summary><c>UseFitnessStep</c> method determins whether the step that re-evaluates whole population is used.</summary>
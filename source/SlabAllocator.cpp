@@ -0,0 +1,83 @@
+
+/*! \file SlabAllocator.cpp
+    \brief This file contains implementation of class that implements allocator of fixed-size memory slots.
+*/
+
+/*
+ *
+ * website: http://kataklinger.com/
+ * contact: me[at]kataklinger.com
+ *
+ */
+
+#include "SlabAllocator.h"
+
+namespace Common
+{
+	namespace Memory
+	{
+
+		// Initializes allocator
+		GaSlabAllocator::GaSlabAllocator(int slotSize,
+			int blockSlots) : _next(NULL),
+			_end(NULL)
+		{
+			GA_ARG_ASSERT( Exceptions::GaArgumentOutOfRangeException, slotSize > 0, "slotSize", "Slot size must be positive.", "Memory" );
+			GA_ARG_ASSERT( Exceptions::GaArgumentOutOfRangeException, blockSlots > 0, "blockSlots", "Number of slots in a block must be positive.", "Memory" );
+
+			// slot must be able to store link to next free slot
+			if( slotSize < (int)sizeof( GaSlot ) )
+				slotSize = (int)sizeof( GaSlot );
+
+			_slotSize = ( slotSize + SLOT_ALIGNMENT - 1 ) / SLOT_ALIGNMENT * SLOT_ALIGNMENT;
+			_blockSlots = blockSlots;
+		}
+
+		// Frees blocks
+		GaSlabAllocator::~GaSlabAllocator()
+		{
+			for( std::vector<char*>::iterator it = _blocks.begin(); it != _blocks.end(); ++it )
+				delete[] *it;
+		}
+
+		// Allocates slot
+		void* GaSlabAllocator::Allocate()
+		{
+			// reuse freed slot
+			void* slot = _free.Pop();
+			if( slot )
+				return slot;
+
+			GA_LOCK( _lock );
+
+			// allocate new block if the last one is exhausted
+			if( _next == _end )
+			{
+				// extra space is allocated so slots can be aligned
+				char* block = new char[ _slotSize * _blockSlots + SLOT_ALIGNMENT ];
+				_blocks.push_back( block );
+
+				_next = block + ( SLOT_ALIGNMENT - (size_t)block % SLOT_ALIGNMENT ) % SLOT_ALIGNMENT;
+				_end = _next + _slotSize * _blockSlots;
+			}
+
+			slot = _next;
+			_next += _slotSize;
+
+			GA_UNLOCK( _lock );
+
+			return slot;
+		}
+
+		// Returns number of blocks
+		int GaSlabAllocator::GetBlockCount() const
+		{
+			GA_LOCK( _lock );
+			int count = (int)_blocks.size();
+			GA_UNLOCK( _lock );
+
+			return count;
+		}
+
+	} // Memory
+} // Common
@@ -0,0 +1,127 @@
+
+/*! \file SlabAllocator.h
+    \brief This file declares class that implements allocator of fixed-size memory slots.
+*/
+
+/*
+ *
+ * website: http://kataklinger.com/
+ * contact: me[at]kataklinger.com
+ *
+ */
+
+#ifndef __GA_SLAB_ALLOCATOR_H__
+#define __GA_SLAB_ALLOCATOR_H__
+
+#include <vector>
+#include "SmartPtr.h"
+
+namespace Common
+{
+	namespace Memory
+	{
+
+		/// <summary><c>GaSlabAllocator</c> class allocates memory slots of fixed size. Slots are carved from large contiguous blocks and freed slots are
+		/// recycled through lock-free list, so allocation and deallocation of slots do not touch system heap once the allocator has enough blocks.
+		/// Memory used by blocks is released only when the allocator is destroyed, so the allocator must outlive all slots it has allocated.
+		///
+		/// This class also implements deletion policy, so auto and smart pointers can return slots to the allocator.
+		///
+		/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
+		/// All public methods are thread-safe.</summary>
+		class GaSlabAllocator : public GaDeletionPolicy<char>
+		{
+
+		public:
+
+			/// <summary>Alignment of slots in bytes.</summary>
+			static const int SLOT_ALIGNMENT = 16;
+
+			/// <summary>Default number of slots in a block.</summary>
+			static const int DEFAULT_BLOCK_SLOTS = 256;
+
+		private:
+
+			/// <summary><c>GaSlot</c> struct represents free slot stored in the list of free slots.</summary>
+			struct GaSlot
+			{
+				GA_DEFINE_ATOM_NODE( GaSlot )
+			};
+
+			/// <summary>Size of a slot in bytes.</summary>
+			int _slotSize;
+
+			/// <summary>Number of slots in a block.</summary>
+			int _blockSlots;
+
+			/// <summary>List of freed slots.</summary>
+			mutable Data::GaAtomicList<GaSlot> _free;
+
+			/// <summary>Allocated blocks.</summary>
+			std::vector<char*> _blocks;
+
+			/// <summary>The first slot of the last block that has never been allocated.</summary>
+			char* _next;
+
+			/// <summary>End of the last block.</summary>
+			char* _end;
+
+			/// <summary>Protects list of blocks.</summary>
+			GA_DECLARE_SPINLOCK( _lock );
+
+		public:
+
+			/// <summary>This constructor initializes allocator without allocating any blocks.</summary>
+			/// <param name="slotSize">minimal size of a slot in bytes. Actual size is rounded up to <c>SLOT_ALIGNMENT</c>.</param>
+			/// <param name="blockSlots">number of slots in a block.</param>
+			/// <exception cref="GaArgumentOutOfRangeException" />Thrown if <c>slotSize</c> or <c>blockSlots</c> is not positive.</exception>
+			GAL_API
+			GaSlabAllocator(int slotSize,
+				int blockSlots = DEFAULT_BLOCK_SLOTS);
+
+			/// <summary>Frees memory used by all blocks.</summary>
+			GAL_API
+			virtual ~GaSlabAllocator();
+
+			/// <summary><c>Allocate</c> method allocates single slot. New block is allocated only if there are no free slots.
+			///
+			/// This method is thread-safe.</summary>
+			/// <returns>Method returns pointer to allocated slot.</returns>
+			GAL_API
+			void* GACALL Allocate();
+
+			/// <summary><c>Free</c> method returns slot to the allocator so it can be reused.
+			///
+			/// This method is thread-safe.</summary>
+			/// <param name="slot">pointer to slot previously allocated by this allocator.</param>
+			inline void GACALL Free(void* slot) const { _free.Push( (GaSlot*)slot ); }
+
+			/// <summary>This operator implements deletion policy by returning slot to the allocator.
+			///
+			/// This operator is thread-safe.</summary>
+			/// <param name="memory">pointer to slot that should be freed.</param>
+			virtual void GACALL operator ()(char* memory) const { Free( memory ); }
+
+			/// <summary>This method is thread-safe.</summary>
+			/// <returns>Method returns size of a slot in bytes.</returns>
+			inline int GACALL GetSlotSize() const { return _slotSize; }
+
+			/// <summary>This method is thread-safe.</summary>
+			/// <returns>Method returns number of slots in a block.</returns>
+			inline int GACALL GetBlockSlots() const { return _blockSlots; }
+
+			/// <summary>This method is thread-safe.</summary>
+			/// <returns>Method returns number of allocated blocks.</returns>
+			GAL_API
+			int GACALL GetBlockCount() const;
+
+			/// <summary>This method is thread-safe.</summary>
+			/// <returns>Method returns number of freed slots which are waiting to be reused.</returns>
+			inline int GACALL GetFreeCount() const { return _free.GetCount(); }
+
+		};
+
+	} // Memory
+} // Common
+
+#endif // __GA_SLAB_ALLOCATOR_H__
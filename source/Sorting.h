@@ -13,7 +13,9 @@
 #ifndef __GA_SORTING_H__
 #define __GA_SORTING_H__
 
+#include <vector>
 #include "SmartPtr.h"
+#include "Workflows.h"
 
 namespace Common
 {
@@ -35,6 +37,50 @@ namespace Common
 			/// <summary>Constant type of date used by this criteria.</summary>
 			typedef const TYPE GaConstType;
 
+			/// <summary><c>GetSortKey</c> method extracts key from the object, so sorting algorithm can compare keys instead of objects.
+			/// Comparing extracted keys in ascending order must give the same result as comparing objects using criteria.
+			/// Criteria that support extraction should hide this method. If the method returns <c>false</c> for the first object in the array,
+			/// sorting algorithm does not use keys at all, so criteria must support extraction either for all or for none of the objects.
+			///
+			/// This method is thread-safe.</summary>
+			/// <param name="object">reference to the object whose key should be extracted.</param>
+			/// <param name="key">reference to variable that will store extracted key.</param>
+			/// <returns>Default implementation returns <c>false</c> which indicates that the criteria does not support key extraction.</returns>
+			inline bool GACALL GetSortKey(GaConstType& object,
+				double& key) const { return false; }
+
+		};
+
+		/// <summary><c>GaSortKey</c> struct stores key extracted from an element of the array and position of the element in the array.</summary>
+		struct GaSortKey
+		{
+
+			/// <summary>Extracted key.</summary>
+			double _key;
+
+			/// <summary>Position of the element in the array.</summary>
+			int _index;
+
+		};
+
+		/// <summary><c>GaSortKeyCriteria</c> class represents criteria that sorts extracted keys in ascending order.
+		///
+		/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
+		/// Because this genetic operation is stateless all public method are thread-safe.</summary>
+		class GaSortKeyCriteria : public GaSortingCriteria<GaSortKey>
+		{
+
+		public:
+
+			/// <summary><c>operator ()</c> compares two extracted keys.
+			///
+			/// This operator is thread-safe.</summary>
+			/// <param name="object1">reference to the first key.</param>
+			/// <param name="object2">reference to the second key.</param>
+			/// <returns>Method returns -1 if the first key is lower, 1 if the second key is lower or 0 if the keys are equal.</returns>
+			inline int GACALL operator ()(GaConstType& object1,
+				GaConstType& object2) const { return object1._key < object2._key ? -1 : ( object2._key < object1._key ? 1 : 0 ); }
+
 		};
 
 		/// <summary><c>GaAscendingSortingCriteria</c> template class represents simple comparison that using operator > to sort itemse in ascending order.
@@ -260,6 +306,11 @@ namespace Common
 		class GaMergeSortAlgorithm
 		{
 
+		public:
+
+			/// <summary>Minimal number of elements per branch for which sorting is split among branches.</summary>
+			static const int MIN_PARALLEL_RUN_SIZE = 32;
+
 		private:
 
 			/// <summary>Pointer to the array that should be sorted.</summary>
@@ -274,6 +325,12 @@ namespace Common
 			/// <summary>Indicates that helper array can returned as sorted array instead of original to improve performance.</summary>
 			bool _swapable;
 
+			/// <summary>Keys extracted from elements of the array when sorting criteria supports key extraction.</summary>
+			std::vector<GaSortKey> _keys;
+
+			/// <summary>Helper array for sorting extracted keys.</summary>
+			std::vector<GaSortKey> _keyHelper;
+
 		public:
 
 			/// <summary>Initializes mergesort algorithm with no array for sorting.</summary>
@@ -299,6 +356,7 @@ namespace Common
 
 			/// <summary><c>Sort</c> method sorts array using provided sorting criteria. Algorithm may take ownership of he original array
 			/// and return heler array as sorted one if it improves performances and user allowed taking of the ownership.
+			/// If criteria supports key extraction (see <see cref="GaSortingCriteria::GetSortKey" />), keys are extracted once and sorted instead of elements.
 			///
 			/// This method is not thread-safe.</summary>
 			/// <typeparam name="CRITERIA">type of sorting criteria used for sorting.</typeparam>
@@ -307,7 +365,8 @@ namespace Common
 			template<typename CRITERIA>
 			T* Sort(const CRITERIA& criteria)
 			{
-				T* sortedArray = Sort( _array, *_count, _helperArray, criteria );
+				double key;
+				T* sortedArray = *_count > 1 && criteria.GetSortKey( _array[ 0 ], key ) ? SortKeys( criteria ) : Sort( _array, *_count, _helperArray, criteria );
 
 				// resulting array is not same as original?
 				if( sortedArray != _array )
@@ -377,6 +436,91 @@ namespace Common
 					return Sort( criteria );
 			}
 
+			/// <summary><c>Sort</c> method sorts array using provided sorting criteria and splits the work among branches that execute current flow step.
+			/// Each branch sorts its own run of the array and then runs are merged in pairs. Merging of each pair of runs is split among branches
+			/// using merge-path partitioning, so every branch produces the same number of elements in each pass. Ordering of elements
+			/// that are equal according to the criteria is preserved. If criteria supports key extraction, keys are extracted and sorted instead of elements.
+			/// Algorithm may take ownership of the original array and return helper array as sorted one the same way as single-threaded version does.
+			/// All branches that execute current flow step must call this method.
+			///
+			/// This method is thread-safe.</summary>
+			/// <typeparam name="CRITERIA">type of sorting criteria used for sorting.</typeparam>
+			/// <param name="branch">pointer to workflow branch that executes sorting.</param>
+			/// <param name="criteria">reference to criteria used to sort array.</param>
+			/// <returns>Method returns pointer to sorted array (sorted array is not nesseserily the same memory location as original one).</returns>
+			template<typename CRITERIA>
+			T* Sort(Workflows::GaBranch* branch,
+				const CRITERIA& criteria)
+			{
+				int branchCount = branch->GetBarrierCount();
+				int count = *_count;
+
+				// there is not enough elements to split sorting
+				if( branchCount < 2 || count < branchCount * MIN_PARALLEL_RUN_SIZE )
+				{
+					GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+						Sort( criteria );
+
+					return _array;
+				}
+
+				int branchID = branch->GetFilteredID();
+				int runStart = GetRunStart( branchID, branchCount, count );
+				int runEnd = GetRunStart( branchID + 1, branchCount, count );
+
+				T* sortedArray;
+				double key;
+				if( criteria.GetSortKey( _array[ 0 ], key ) )
+				{
+					// resize buffers for keys
+					if( (int)_keys.size() < count )
+					{
+						GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+						{
+							_keys.resize( count );
+							_keyHelper.resize( count );
+						}
+					}
+
+					for( int i = runStart; i < runEnd; i++ )
+					{
+						criteria.GetSortKey( _array[ i ], _keys[ i ]._key );
+						_keys[ i ]._index = i;
+					}
+
+					GaSortKey* sortedKeys = Sort( branch, &_keys[ 0 ], &_keyHelper[ 0 ], count, GaSortKeyCriteria() );
+
+					// branch has produced sorted keys in its range by itself, so it can permute elements without synchronization
+					for( int i = runStart; i < runEnd; i++ )
+						_helperArray[ i ] = _array[ sortedKeys[ i ]._index ];
+
+					sortedArray = _helperArray;
+				}
+				else
+					sortedArray = Sort( branch, _array, _helperArray, count, criteria );
+
+				// copy sorted elements to original array if the array cannot be swapped
+				if( !_swapable && sortedArray != _array )
+				{
+					branch->GetBarrier().Enter( true, branchCount );
+
+					for( int i = runStart; i < runEnd; i++ )
+						_array[ i ] = sortedArray[ i ];
+				}
+
+				GA_BARRIER_SYNC( lock, branch->GetBarrier(), branchCount )
+				{
+					// only swap the arrays to improve performance
+					if( _swapable && sortedArray != _array )
+					{
+						_helperArray = _array;
+						_array = sortedArray;
+					}
+				}
+
+				return _array;
+			}
+
 			/// <summary><c>SetArray</c> method sets pointer to array that should be sorted by the algorithm and its size as well as pointer
 			/// to variable that stores current number of elements in the array.
 			///
@@ -436,46 +580,48 @@ namespace Common
 			/// Method can be used concurently only when sorting non-overlapping portions of the array.
 			///
 			/// This method is not thread-safe.</summary>
+			/// <typeparam name="ITEM">type of elements in the array.</typeparam>
 			/// <typeparam name="CRITERIA">type of sorting criteria used for sorting.</typeparam>
 			/// <param name="array">pointer to the first element of the array that should be sorted.</param>
 			/// <param name="arraySize">number of elements of the array that should be sorted.</param>
 			/// <param name="helperArray">pointer to the first element of helper array used for sorting.</param>
 			/// <param name="criteria">reference to criteria used to sort array.</param>
 			/// <returns>Method returns pointer to sorted array (sorted array is not nesseserily the same memory location as original one).</returns>
-			template<typename CRITERIA>
-			T* Sort(T* array,
+			template<typename ITEM,
+				typename CRITERIA>
+			static ITEM* GACALL Sort(ITEM* array,
 				int arraySize,
-				T* helperArray,
+				ITEM* helperArray,
 				const CRITERIA& criteria)
 			{
 				if( arraySize < 2 )
 					return array;
 
-				T* helperArrayEnd = helperArray + arraySize;
-				T* mergeDestination = helperArray;
+				ITEM* helperArrayEnd = helperArray + arraySize;
+				ITEM* mergeDestination = helperArray;
 
 				// perform merging of sorted blocks of array, each step doubles size of merging blocks
 				for( int blockSize = 1; blockSize < arraySize; blockSize *= 2 )
 				{
 					// beginings of two sorted blocks of the array that should be merged
-					T* mergeBlock1 = mergeDestination == helperArray ? array : helperArray;
-					T* mergeBlock2 = mergeBlock1 + blockSize;
+					ITEM* mergeBlock1 = mergeDestination == helperArray ? array : helperArray;
+					ITEM* mergeBlock2 = mergeBlock1 + blockSize;
 
-					T* mergeSourceEnd = mergeBlock1 + arraySize;
-					T* mergeDestinationEnd = mergeDestination + arraySize;
+					ITEM* mergeSourceEnd = mergeBlock1 + arraySize;
+					ITEM* mergeDestinationEnd = mergeDestination + arraySize;
 
 					// until all pairs of blocks are merged
 					while( mergeBlock2 < mergeSourceEnd )
 					{
 						// ends of two sorted blocks of the array that should be merged
-						T* mergeBlock1End = mergeBlock2 - 1;
-						T* mergeBlock2End = mergeBlock2 + blockSize - 1;
+						ITEM* mergeBlock1End = mergeBlock2 - 1;
+						ITEM* mergeBlock2End = mergeBlock2 + blockSize - 1;
 						if( mergeBlock2End >= mergeSourceEnd )
 							mergeBlock2End = mergeSourceEnd - 1;
 
-						// merge blocks to helper array preserving sorting
+						// merge blocks to helper array preserving sorting and order of equal elements
 						for( ; mergeBlock1 <= mergeBlock1End && mergeBlock2 <= mergeBlock2End; )
-							*( mergeDestination++ ) = criteria( *mergeBlock1, *mergeBlock2 ) < 0 ? *( mergeBlock1++ ) : *( mergeBlock2++ );
+							*( mergeDestination++ ) = criteria( *mergeBlock2, *mergeBlock1 ) < 0 ? *( mergeBlock2++ ) : *( mergeBlock1++ );
 
 						// copy any element left in merging blocks to helper array
 						while( mergeBlock1 <= mergeBlock1End )
@@ -500,6 +646,170 @@ namespace Common
 				return mergeDestination == array ? helperArray : array;
 			}
 
+			/// <summary><c>SortKeys</c> method extracts keys from all elements of the array, sorts them and stores elements to helper array in sorted order.</summary>
+			/// <typeparam name="CRITERIA">type of sorting criteria used for sorting.</typeparam>
+			/// <param name="criteria">reference to criteria used to extract keys.</param>
+			/// <returns>Method returns pointer to helper array which contains sorted elements.</returns>
+			template<typename CRITERIA>
+			T* SortKeys(const CRITERIA& criteria)
+			{
+				int count = *_count;
+				if( (int)_keys.size() < count )
+				{
+					_keys.resize( count );
+					_keyHelper.resize( count );
+				}
+
+				for( int i = count - 1; i >= 0; i-- )
+				{
+					criteria.GetSortKey( _array[ i ], _keys[ i ]._key );
+					_keys[ i ]._index = i;
+				}
+
+				GaSortKey* sortedKeys = Sort( &_keys[ 0 ], count, &_keyHelper[ 0 ], GaSortKeyCriteria() );
+
+				for( int i = count - 1; i >= 0; i-- )
+					_helperArray[ i ] = _array[ sortedKeys[ i ]._index ];
+
+				return _helperArray;
+			}
+
+			/// <summary><c>Sort</c> method sorts array by splitting the work among branches that execute current flow step.
+			/// Each branch sorts its own run and then runs are merged in passes. When method returns, each branch has produced only
+			/// its own range of sorted array, so branches should be synchronized before they access the rest of the sorted array.</summary>
+			/// <typeparam name="ITEM">type of elements in the array.</typeparam>
+			/// <typeparam name="CRITERIA">type of sorting criteria used for sorting.</typeparam>
+			/// <param name="branch">pointer to workflow branch that executes sorting.</param>
+			/// <param name="array">pointer to the first element of the array that should be sorted.</param>
+			/// <param name="helperArray">pointer to the first element of helper array used for sorting.</param>
+			/// <param name="count">number of elements in the array.</param>
+			/// <param name="criteria">reference to criteria used to sort array.</param>
+			/// <returns>Method returns pointer to sorted array (sorted array is not nesseserily the same memory location as original one).</returns>
+			template<typename ITEM,
+				typename CRITERIA>
+			static ITEM* GACALL Sort(Workflows::GaBranch* branch,
+				ITEM* array,
+				ITEM* helperArray,
+				int count,
+				const CRITERIA& criteria)
+			{
+				int branchCount = branch->GetBarrierCount();
+				int branchID = branch->GetFilteredID();
+				int runStart = GetRunStart( branchID, branchCount, count );
+				int runEnd = GetRunStart( branchID + 1, branchCount, count );
+
+				// sort run that belongs to this branch and keep it in the original array
+				if( Sort( array + runStart, runEnd - runStart, helperArray + runStart, criteria ) != array + runStart )
+				{
+					for( int i = runStart; i < runEnd; i++ )
+						array[ i ] = helperArray[ i ];
+				}
+
+				branch->GetBarrier().Enter( true, branchCount );
+
+				ITEM* source = array;
+				ITEM* destination = helperArray;
+
+				// each pass merges pairs of neighbouring blocks of runs
+				for( int width = 1; width < branchCount; width *= 2 )
+				{
+					// find blocks which contain output range of this branch
+					int first = branchID - branchID % ( 2 * width );
+					int blockStart = GetRunStart( first, branchCount, count );
+					int blockMiddle = GetRunStart( first + width < branchCount ? first + width : branchCount, branchCount, count );
+					int blockEnd = GetRunStart( first + 2 * width < branchCount ? first + 2 * width : branchCount, branchCount, count );
+
+					MergeRange( source + blockStart, blockMiddle - blockStart, source + blockMiddle, blockEnd - blockMiddle,
+						destination + blockStart, runStart - blockStart, runEnd - blockStart, criteria );
+
+					ITEM* temp = source;
+					source = destination;
+					destination = temp;
+
+					// synchronization after the last pass is left to the caller
+					if( width * 2 < branchCount )
+						branch->GetBarrier().Enter( true, branchCount );
+				}
+
+				return source;
+			}
+
+			/// <summary><c>GetRunStart</c> method calculates index of the first element of the run that is sorted by the specified branch.</summary>
+			/// <param name="run">index of the run.</param>
+			/// <param name="runCount">total number of runs.</param>
+			/// <param name="count">number of elements in the array.</param>
+			/// <returns>Method returns index of the first element of the run.</returns>
+			static inline int GACALL GetRunStart(int run,
+				int runCount,
+				int count) { return (int)( (long long)count * run / runCount ); }
+
+			/// <summary><c>FindMergePath</c> method performs binary search along the diagonal of merge matrix to find how many elements
+			/// of the left block are among the first elements of merged output.</summary>
+			/// <typeparam name="ITEM">type of elements in the array.</typeparam>
+			/// <typeparam name="CRITERIA">type of sorting criteria used for sorting.</typeparam>
+			/// <param name="left">pointer to the first element of the left block.</param>
+			/// <param name="leftSize">number of elements in the left block.</param>
+			/// <param name="right">pointer to the first element of the right block.</param>
+			/// <param name="rightSize">number of elements in the right block.</param>
+			/// <param name="diagonal">number of elements of merged output.</param>
+			/// <param name="criteria">reference to criteria used to sort array.</param>
+			/// <returns>Method returns number of elements that are taken from the left block.</returns>
+			template<typename ITEM,
+				typename CRITERIA>
+			static int GACALL FindMergePath(const ITEM* left,
+				int leftSize,
+				const ITEM* right,
+				int rightSize,
+				int diagonal,
+				const CRITERIA& criteria)
+			{
+				int low = diagonal > rightSize ? diagonal - rightSize : 0;
+				int high = diagonal < leftSize ? diagonal : leftSize;
+
+				while( low < high )
+				{
+					int middle = ( low + high ) / 2;
+
+					// element of the left block goes first unless the element of the right block is strictly better
+					if( criteria( right[ diagonal - middle - 1 ], left[ middle ] ) < 0 )
+						high = middle;
+					else
+						low = middle + 1;
+				}
+
+				return low;
+			}
+
+			/// <summary><c>MergeRange</c> method produces specified range of the output that is created by merging two sorted blocks.
+			/// Method can be used concurently only when producing non-overlapping ranges of the output.</summary>
+			/// <typeparam name="ITEM">type of elements in the array.</typeparam>
+			/// <typeparam name="CRITERIA">type of sorting criteria used for sorting.</typeparam>
+			/// <param name="left">pointer to the first element of the left block.</param>
+			/// <param name="leftSize">number of elements in the left block.</param>
+			/// <param name="right">pointer to the first element of the right block.</param>
+			/// <param name="rightSize">number of elements in the right block.</param>
+			/// <param name="destination">pointer to the first element of merged output.</param>
+			/// <param name="begin">index of the first element of output range that should be produced.</param>
+			/// <param name="end">index of the element after the last element of output range that should be produced.</param>
+			/// <param name="criteria">reference to criteria used to sort array.</param>
+			template<typename ITEM,
+				typename CRITERIA>
+			static void GACALL MergeRange(const ITEM* left,
+				int leftSize,
+				const ITEM* right,
+				int rightSize,
+				ITEM* destination,
+				int begin,
+				int end,
+				const CRITERIA& criteria)
+			{
+				int i = FindMergePath( left, leftSize, right, rightSize, begin, criteria );
+				int j = begin - i;
+
+				for( ITEM* output = destination + begin, *outputEnd = destination + end; output < outputEnd; output++ )
+					*output = i < leftSize && ( j >= rightSize || criteria( right[ j ], left[ i ] ) >= 0 ) ? left[ i++ ] : right[ j++ ];
+			}
+
 		};
 
 	} // Sorting
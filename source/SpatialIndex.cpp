@@ -0,0 +1,370 @@
+/*! \file SpatialIndex.cpp
+    \brief This file contains implementation of classes that implement spatial indices used for nearest neighbour queries in objective space.
+*/
+
+/*
+ *
+ * website: http://kataklinger.com/
+ * contact: me[at]kataklinger.com
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include "SpatialIndex.h"
+
+namespace Multiobjective
+{
+
+	/// <summary><c>GaCoordinateLess</c> class compares points by single coordinate.</summary>
+	class GaCoordinateLess
+	{
+
+	private:
+
+		/// <summary>Buffer that stores coordinates of the points.</summary>
+		const double* _values;
+
+		/// <summary>Distance between rows of the coordinate buffer.</summary>
+		int _stride;
+
+		/// <summary>Coordinate that is compared.</summary>
+		int _dimension;
+
+	public:
+
+		/// <summary>Initializes comparator.</summary>
+		/// <param name="values">buffer that stores coordinates of the points.</param>
+		/// <param name="stride">distance between rows of the coordinate buffer.</param>
+		/// <param name="dimension">coordinate that is compared.</param>
+		GaCoordinateLess(const double* values,
+			int stride,
+			int dimension) : _values(values),
+			_stride(stride),
+			_dimension(dimension) { }
+
+		/// <summary><c>operator ()</c> compares coordinates of two points.</summary>
+		/// <param name="index1">index of the first point.</param>
+		/// <param name="index2">index of the second point.</param>
+		/// <returns>Method returns <c>true</c> if coordinate of the first point is lower.</returns>
+		inline bool GACALL operator ()(int index1,
+			int index2) const { return _values[ index1 * _stride + _dimension ] < _values[ index2 * _stride + _dimension ]; }
+
+	};
+
+	/// <summary><c>GaNeighbourLess</c> function compares neighbours by their distances.</summary>
+	/// <param name="neighbour1">the first neighbour.</param>
+	/// <param name="neighbour2">the second neighbour.</param>
+	/// <returns>Method returns <c>true</c> if the first neighbour is closer.</returns>
+	inline bool GaNeighbourLess(const GaSpatialNeighbour& neighbour1,
+		const GaSpatialNeighbour& neighbour2) { return neighbour1._distance < neighbour2._distance; }
+
+	// Indexes points
+	void GaSpatialIndex::Build(const double* values,
+		int stride,
+		int dimensions,
+		int count,
+		GaSpatialIndexType type)
+	{
+		GA_ARG_ASSERT( Common::Exceptions::GaNullArgumentException, values != NULL || count == 0, "values", "Buffer must be specified.", "Multiobjective" );
+		GA_ARG_ASSERT( Common::Exceptions::GaArgumentOutOfRangeException, dimensions > 0 && stride >= dimensions, "dimensions", "Number of coordinates must be positive and cannot exceed stride.", "Multiobjective" );
+
+		if( type == GASIT_AUTO )
+			type = dimensions <= KD_TREE_DIMENSIONS ? GASIT_KD_TREE : GASIT_VP_TREE;
+
+		_type = type;
+		_values = values;
+		_stride = stride;
+		_dimensions = dimensions;
+		_count = count;
+		_live = count;
+		_nodeCount = 0;
+
+		// each node of the tree holds at least one point
+		if( _nodes.GetSize() < 2 * count + 1 )
+			_nodes.SetSize( 2 * count + 1 );
+		if( _order.GetSize() < count )
+		{
+			_order.SetSize( count );
+			_owners.SetSize( count );
+			_removed.SetSize( count );
+		}
+
+		for( int i = 0; i < count; i++ )
+		{
+			_order[ i ] = i;
+			_removed[ i ] = false;
+		}
+
+		if( count > 0 )
+		{
+			if( _type == GASIT_KD_TREE )
+				BuildKdTree( 0, count, -1 );
+			else
+			{
+				if( _partition.GetSize() < count )
+					_partition.SetSize( count );
+
+				BuildVpTree( 0, count, -1 );
+			}
+		}
+	}
+
+	// Excludes point from subsequent queries
+	void GaSpatialIndex::Remove(int index)
+	{
+		GA_ARG_ASSERT( Common::Exceptions::GaArgumentOutOfRangeException, index >= 0 && index < _count, "index", "Index is out of range.", "Multiobjective" );
+
+		if( !_removed[ index ] )
+		{
+			_removed[ index ] = true;
+			_live--;
+
+			// update number of live points in all nodes that contain removed point
+			for( int node = _owners[ index ]; node >= 0; node = _nodes[ node ]._parent )
+				_nodes[ node ]._live--;
+		}
+	}
+
+	// Finds nearest neighbours of the point
+	int GaSpatialIndex::Query(int index,
+		int k,
+		GaSpatialNeighbour* neighbours) const
+	{
+		GA_ARG_ASSERT( Common::Exceptions::GaArgumentOutOfRangeException, index >= 0 && index < _count, "index", "Index is out of range.", "Multiobjective" );
+
+		int found = 0;
+		if( k > 0 && _nodeCount > 0 )
+		{
+			if( _type == GASIT_KD_TREE )
+				SearchKdTree( 0, index, k, neighbours, found );
+			else
+				SearchVpTree( 0, index, k, neighbours, found );
+
+			// heap of found neighbours is turned into sorted list
+			std::sort_heap( neighbours, neighbours + found, GaNeighbourLess );
+			for( int i = 0; i < found; i++ )
+				neighbours[ i ]._distance = std::sqrt( neighbours[ i ]._distance );
+		}
+
+		return found;
+	}
+
+	// Builds k-d subtree
+	int GaSpatialIndex::BuildKdTree(int begin,
+		int end,
+		int parent)
+	{
+		int node = CreateNode( begin, end, parent );
+		if( end - begin <= LEAF_SIZE )
+			return node;
+
+		// find coordinate with the largest spread
+		int dimension = 0;
+		double spread = 0;
+		for( int d = 0; d < _dimensions; d++ )
+		{
+			double low = GetCoordinate( _order[ begin ], d ), high = low;
+			for( int i = begin + 1; i < end; i++ )
+			{
+				double value = GetCoordinate( _order[ i ], d );
+				if( value < low )
+					low = value;
+				else if( value > high )
+					high = value;
+			}
+
+			if( high - low > spread )
+			{
+				spread = high - low;
+				dimension = d;
+			}
+		}
+
+		// all points are equal, so they cannot be split
+		if( spread == 0 )
+			return node;
+
+		// split points by median value of the chosen coordinate
+		int middle = ( begin + end ) / 2;
+		std::nth_element( _order.GetArray() + begin, _order.GetArray() + middle, _order.GetArray() + end, GaCoordinateLess( _values, _stride, dimension ) );
+
+		_nodes[ node ]._pivot = dimension;
+		_nodes[ node ]._split = GetCoordinate( _order[ middle ], dimension );
+
+		int left = BuildKdTree( begin, middle, node );
+		int right = BuildKdTree( middle, end, node );
+
+		_nodes[ node ]._left = left;
+		_nodes[ node ]._right = right;
+
+		return node;
+	}
+
+	// Builds VP subtree
+	int GaSpatialIndex::BuildVpTree(int begin,
+		int end,
+		int parent)
+	{
+		int node = CreateNode( begin, end, parent );
+		if( end - begin <= LEAF_SIZE )
+			return node;
+
+		// the first point of the range is used as vantage point
+		int vantage = _order[ begin ];
+		_owners[ vantage ] = node;
+
+		// calculate distances of other points to the vantage point
+		for( int i = begin + 1; i < end; i++ )
+		{
+			_partition[ i ]._index = _order[ i ];
+			_partition[ i ]._distance = GetDistance( vantage, _order[ i ] );
+		}
+
+		// split points by median distance from the vantage point
+		int middle = ( begin + 1 + end ) / 2;
+		std::nth_element( _partition.GetArray() + begin + 1, _partition.GetArray() + middle, _partition.GetArray() + end, GaNeighbourLess );
+
+		for( int i = begin + 1; i < end; i++ )
+			_order[ i ] = _partition[ i ]._index;
+
+		_nodes[ node ]._pivot = vantage;
+		_nodes[ node ]._split = std::sqrt( _partition[ middle ]._distance );
+
+		int left = BuildVpTree( begin + 1, middle, node );
+		int right = BuildVpTree( middle, end, node );
+
+		_nodes[ node ]._left = left;
+		_nodes[ node ]._right = right;
+
+		return node;
+	}
+
+	// Initializes new leaf node
+	int GaSpatialIndex::CreateNode(int begin,
+		int end,
+		int parent)
+	{
+		int node = _nodeCount++;
+
+		GaNode& n = _nodes[ node ];
+		n._begin = begin;
+		n._end = end;
+		n._parent = parent;
+		n._left = -1;
+		n._right = -1;
+		n._pivot = -1;
+		n._split = 0;
+		n._live = end - begin;
+
+		// nodes that are split later will update owners of their points
+		for( int i = begin; i < end; i++ )
+			_owners[ _order[ i ] ] = node;
+
+		return node;
+	}
+
+	// Searches k-d subtree
+	void GaSpatialIndex::SearchKdTree(int node,
+		int index,
+		int k,
+		GaSpatialNeighbour* neighbours,
+		int& found) const
+	{
+		const GaNode& n = _nodes[ node ];
+		if( n._live == 0 )
+			return;
+
+		if( n._left < 0 )
+		{
+			SearchLeaf( n, index, k, neighbours, found );
+			return;
+		}
+
+		// search half-space that contains the point first
+		double offset = GetCoordinate( index, n._pivot ) - n._split;
+		SearchKdTree( offset < 0 ? n._left : n._right, index, k, neighbours, found );
+
+		// search the other half-space only if it can contain closer points
+		if( found < k || offset * offset <= neighbours[ 0 ]._distance )
+			SearchKdTree( offset < 0 ? n._right : n._left, index, k, neighbours, found );
+	}
+
+	// Searches VP subtree
+	void GaSpatialIndex::SearchVpTree(int node,
+		int index,
+		int k,
+		GaSpatialNeighbour* neighbours,
+		int& found) const
+	{
+		const GaNode& n = _nodes[ node ];
+		if( n._live == 0 )
+			return;
+
+		if( n._left < 0 )
+		{
+			SearchLeaf( n, index, k, neighbours, found );
+			return;
+		}
+
+		double distance = GetDistance( index, n._pivot );
+		if( n._pivot != index && !_removed[ n._pivot ] )
+			Offer( n._pivot, distance, k, neighbours, found );
+
+		distance = std::sqrt( distance );
+		if( distance < n._split )
+		{
+			// search inner ball first and outer shell only if it can contain closer points
+			SearchVpTree( n._left, index, k, neighbours, found );
+			if( found < k || distance + std::sqrt( neighbours[ 0 ]._distance ) >= n._split )
+				SearchVpTree( n._right, index, k, neighbours, found );
+		}
+		else
+		{
+			// search outer shell first and inner ball only if it can contain closer points
+			SearchVpTree( n._right, index, k, neighbours, found );
+			if( found < k || distance - std::sqrt( neighbours[ 0 ]._distance ) <= n._split )
+				SearchVpTree( n._left, index, k, neighbours, found );
+		}
+	}
+
+	// Offers all points of leaf node
+	void GaSpatialIndex::SearchLeaf(const GaNode& node,
+		int index,
+		int k,
+		GaSpatialNeighbour* neighbours,
+		int& found) const
+	{
+		for( int i = node._begin; i < node._end; i++ )
+		{
+			int point = _order[ i ];
+			if( point != index && !_removed[ point ] )
+				Offer( point, GetDistance( index, point ), k, neighbours, found );
+		}
+	}
+
+	// Inserts neighbour to the heap
+	void GaSpatialIndex::Offer(int neighbour,
+		double distance,
+		int k,
+		GaSpatialNeighbour* neighbours,
+		int& found)
+	{
+		if( found < k )
+		{
+			// heap is not full
+			neighbours[ found ]._index = neighbour;
+			neighbours[ found ]._distance = distance;
+			std::push_heap( neighbours, neighbours + ++found, GaNeighbourLess );
+		}
+		else if( distance < neighbours[ 0 ]._distance )
+		{
+			// replace the farthest neighbour
+			std::pop_heap( neighbours, neighbours + found, GaNeighbourLess );
+			neighbours[ found - 1 ]._index = neighbour;
+			neighbours[ found - 1 ]._distance = distance;
+			std::push_heap( neighbours, neighbours + found, GaNeighbourLess );
+		}
+	}
+
+} // Multiobjective
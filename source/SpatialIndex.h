@@ -0,0 +1,308 @@
+/*! \file SpatialIndex.h
+    \brief This file declares classes that implement spatial indices used for nearest neighbour queries in objective space.
+*/
+
+/*
+ *
+ * website: http://kataklinger.com/
+ * contact: me[at]kataklinger.com
+ *
+ */
+
+#ifndef __GA_SPATIAL_INDEX_H__
+#define __GA_SPATIAL_INDEX_H__
+
+#include "Array.h"
+
+namespace Multiobjective
+{
+
+	/// <summary>This enumeration defines structures that can be used to index points in objective space.</summary>
+	enum GaSpatialIndexType
+	{
+
+		/// <summary>Structure is chosen according to number of objectives. K-d tree is used for low number of objectives and VP-tree otherwise.</summary>
+		GASIT_AUTO,
+
+		/// <summary>K-d tree which splits space by median value of coordinate with the largest spread.</summary>
+		GASIT_KD_TREE,
+
+		/// <summary>Vantage point tree which splits space by median distance from selected point. It is suitable for high number of objectives.</summary>
+		GASIT_VP_TREE
+
+	};
+
+	/// <summary><c>GaSpatialNeighbour</c> struct stores neighbour found by the spatial index.</summary>
+	struct GaSpatialNeighbour
+	{
+
+		/// <summary>Index of the neighbour point.</summary>
+		int _index;
+
+		/// <summary>Distance to the neighbour point. Squared distance is stored while query is in progress.</summary>
+		double _distance;
+
+	};
+
+	/// <summary><c>GaSpatialIndex</c> class indexes points in objective space and answers k-nearest neighbour queries using Euclidean distance.
+	/// Index references points stored in external row-major buffer, so the buffer must not be changed while the index is used.
+	/// Points can be removed from the index one by one, which excludes them from results of all subsequent queries.
+	///
+	/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
+	/// No public or private methods are thread-safe, but concurrent queries are allowed as long as points are not removed.</summary>
+	class GaSpatialIndex
+	{
+
+	public:
+
+		/// <summary>Maximal number of points stored in leaf node of the tree.</summary>
+		static const int LEAF_SIZE = 8;
+
+		/// <summary>Maximal number of objectives for which k-d tree is chosen when type of the index is <c>GASIT_AUTO</c>.</summary>
+		static const int KD_TREE_DIMENSIONS = 6;
+
+	private:
+
+		/// <summary><c>GaNode</c> struct represents node of the tree.</summary>
+		struct GaNode
+		{
+
+			/// <summary>Position of the first point of the node in <c>_order</c> array.</summary>
+			int _begin;
+
+			/// <summary>Position after the last point of the node in <c>_order</c> array.</summary>
+			int _end;
+
+			/// <summary>Index of parent node or -1 if this is the root node.</summary>
+			int _parent;
+
+			/// <summary>Index of the first child node or -1 if this is a leaf node.</summary>
+			int _left;
+
+			/// <summary>Index of the second child node or -1 if this is a leaf node.</summary>
+			int _right;
+
+			/// <summary>Splitting coordinate for k-d tree nodes or vantage point for VP-tree nodes.</summary>
+			int _pivot;
+
+			/// <summary>Splitting value for k-d tree nodes or radius of inner ball for VP-tree nodes.</summary>
+			double _split;
+
+			/// <summary>Number of points in the subtree that are not removed.</summary>
+			int _live;
+
+		};
+
+		/// <summary>Type of structure currently used by the index.</summary>
+		GaSpatialIndexType _type;
+
+		/// <summary>Buffer that stores coordinates of the points.</summary>
+		const double* _values;
+
+		/// <summary>Distance between rows of the coordinate buffer.</summary>
+		int _stride;
+
+		/// <summary>Number of coordinates that each point has.</summary>
+		int _dimensions;
+
+		/// <summary>Number of indexed points.</summary>
+		int _count;
+
+		/// <summary>Number of points that are not removed.</summary>
+		int _live;
+
+		/// <summary>Nodes of the tree. The first node is the root.</summary>
+		Common::Data::GaSingleDimensionArray<GaNode> _nodes;
+
+		/// <summary>Number of used nodes.</summary>
+		int _nodeCount;
+
+		/// <summary>Points ordered so each node covers a continuous range.</summary>
+		Common::Data::GaSingleDimensionArray<int> _order;
+
+		/// <summary>Node that stores each point.</summary>
+		Common::Data::GaSingleDimensionArray<int> _owners;
+
+		/// <summary>Marks removed points.</summary>
+		Common::Data::GaSingleDimensionArray<bool> _removed;
+
+		/// <summary>Buffer used for partitioning points by their distances while VP-tree is built.</summary>
+		Common::Data::GaSingleDimensionArray<GaSpatialNeighbour> _partition;
+
+	public:
+
+		/// <summary>This constructor initializes empty index.</summary>
+		GaSpatialIndex() : _type(GASIT_KD_TREE),
+			_values(NULL),
+			_stride(0),
+			_dimensions(0),
+			_count(0),
+			_live(0),
+			_nodeCount(0) { }
+
+		/// <summary><c>Build</c> method indexes points stored in the buffer. Previously indexed points are discarded.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="values">buffer that stores coordinates of the points row by row.</param>
+		/// <param name="stride">distance between rows of the buffer.</param>
+		/// <param name="dimensions">number of coordinates that each point has.</param>
+		/// <param name="count">number of points.</param>
+		/// <param name="type">structure that should be used to index points.</param>
+		GAL_API
+		void GACALL Build(const double* values,
+			int stride,
+			int dimensions,
+			int count,
+			GaSpatialIndexType type);
+
+		/// <summary><c>Clear</c> method removes all points from the index.
+		///
+		/// This method is not thread-safe.</summary>
+		inline void GACALL Clear()
+		{
+			_count = _live = _nodeCount = 0;
+			_values = NULL;
+		}
+
+		/// <summary><c>Remove</c> method excludes point from results of subsequent queries.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="index">index of the point.</param>
+		GAL_API
+		void GACALL Remove(int index);
+
+		/// <summary><c>Query</c> method finds nearest points to the specified point that are not removed.
+		///
+		/// This method is thread-safe as long as points are not removed concurrently.</summary>
+		/// <param name="index">index of the point whose neighbours should be found. The point itself is not included in results.</param>
+		/// <param name="k">number of neighbours that should be found.</param>
+		/// <param name="neighbours">buffer that will store neighbours sorted by their distances. Buffer must be able to store <c>k</c> neighbours.</param>
+		/// <returns>Method returns number of found neighbours which can be less then <c>k</c> if there is not enough points in the index.</returns>
+		GAL_API
+		int GACALL Query(int index,
+			int k,
+			GaSpatialNeighbour* neighbours) const;
+
+		/// <summary>This method is thread-safe as long as points are not removed concurrently.</summary>
+		/// <param name="index">index of the queried point.</param>
+		/// <returns>Method returns <c>true</c> if the point is removed from the index.</returns>
+		inline bool GACALL IsRemoved(int index) const { return _removed[ index ]; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns structure currently used by the index.</returns>
+		inline GaSpatialIndexType GACALL GetType() const { return _type; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns number of indexed points.</returns>
+		inline int GACALL GetCount() const { return _count; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <returns>Method returns number of points that are not removed.</returns>
+		inline int GACALL GetLiveCount() const { return _live; }
+
+	private:
+
+		/// <summary><c>BuildKdTree</c> method builds k-d subtree that covers specified range of points.</summary>
+		/// <param name="begin">position of the first point in <c>_order</c> array.</param>
+		/// <param name="end">position after the last point in <c>_order</c> array.</param>
+		/// <param name="parent">index of the parent node.</param>
+		/// <returns>Method returns index of root node of the subtree.</returns>
+		int GACALL BuildKdTree(int begin,
+			int end,
+			int parent);
+
+		/// <summary><c>BuildVpTree</c> method builds VP subtree that covers specified range of points.</summary>
+		/// <param name="begin">position of the first point in <c>_order</c> array.</param>
+		/// <param name="end">position after the last point in <c>_order</c> array.</param>
+		/// <param name="parent">index of the parent node.</param>
+		/// <returns>Method returns index of root node of the subtree.</returns>
+		int GACALL BuildVpTree(int begin,
+			int end,
+			int parent);
+
+		/// <summary><c>CreateNode</c> method initializes new leaf node that covers specified range of points.</summary>
+		/// <param name="begin">position of the first point in <c>_order</c> array.</param>
+		/// <param name="end">position after the last point in <c>_order</c> array.</param>
+		/// <param name="parent">index of the parent node.</param>
+		/// <returns>Method returns index of the node.</returns>
+		int GACALL CreateNode(int begin,
+			int end,
+			int parent);
+
+		/// <summary><c>SearchKdTree</c> method searches k-d subtree for nearest neighbours.</summary>
+		/// <param name="node">index of root node of the subtree.</param>
+		/// <param name="index">index of the point whose neighbours are searched.</param>
+		/// <param name="k">number of neighbours that should be found.</param>
+		/// <param name="neighbours">heap of neighbours found so far.</param>
+		/// <param name="found">number of neighbours found so far.</param>
+		void GACALL SearchKdTree(int node,
+			int index,
+			int k,
+			GaSpatialNeighbour* neighbours,
+			int& found) const;
+
+		/// <summary><c>SearchVpTree</c> method searches VP subtree for nearest neighbours.</summary>
+		/// <param name="node">index of root node of the subtree.</param>
+		/// <param name="index">index of the point whose neighbours are searched.</param>
+		/// <param name="k">number of neighbours that should be found.</param>
+		/// <param name="neighbours">heap of neighbours found so far.</param>
+		/// <param name="found">number of neighbours found so far.</param>
+		void GACALL SearchVpTree(int node,
+			int index,
+			int k,
+			GaSpatialNeighbour* neighbours,
+			int& found) const;
+
+		/// <summary><c>SearchLeaf</c> method offers all points of leaf node as neighbours.</summary>
+		/// <param name="node">leaf node.</param>
+		/// <param name="index">index of the point whose neighbours are searched.</param>
+		/// <param name="k">number of neighbours that should be found.</param>
+		/// <param name="neighbours">heap of neighbours found so far.</param>
+		/// <param name="found">number of neighbours found so far.</param>
+		void GACALL SearchLeaf(const GaNode& node,
+			int index,
+			int k,
+			GaSpatialNeighbour* neighbours,
+			int& found) const;
+
+		/// <summary><c>Offer</c> method inserts neighbour to the heap if it is closer then the farthest neighbour found so far.</summary>
+		/// <param name="neighbour">index of the neighbour.</param>
+		/// <param name="distance">squared distance to the neighbour.</param>
+		/// <param name="k">number of neighbours that should be found.</param>
+		/// <param name="neighbours">heap of neighbours found so far.</param>
+		/// <param name="found">number of neighbours found so far.</param>
+		static void GACALL Offer(int neighbour,
+			double distance,
+			int k,
+			GaSpatialNeighbour* neighbours,
+			int& found);
+
+		/// <summary><c>GetDistance</c> method calculates squared distance between two points.</summary>
+		/// <param name="index1">index of the first point.</param>
+		/// <param name="index2">index of the second point.</param>
+		/// <returns>Method returns squared distance between the points.</returns>
+		inline double GACALL GetDistance(int index1,
+			int index2) const
+		{
+			const double* a = _values + index1 * _stride;
+			const double* b = _values + index2 * _stride;
+
+			double distance = 0;
+			for( int i = 0; i < _dimensions; i++ )
+				distance += ( a[ i ] - b[ i ] ) * ( a[ i ] - b[ i ] );
+
+			return distance;
+		}
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <param name="index">index of the point.</param>
+		/// <param name="dimension">coordinate that should be returned.</param>
+		/// <returns>Method returns specified coordinate of the point.</returns>
+		inline double GACALL GetCoordinate(int index,
+			int dimension) const { return _values[ index * _stride + dimension ]; }
+
+	};
+
+} // Multiobjective
+
+#endif // __GA_SPATIAL_INDEX_H__
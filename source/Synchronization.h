@@ -13,6 +13,7 @@
 #ifndef __GA_SYNCHRONIZATION_H__
 #define __GA_SYNCHRONIZATION_H__
 
+#include <vector>
 #include "AtomicList.h"
 
 #if defined(GAL_PLATFORM_NIX)
@@ -95,6 +96,10 @@ namespace Common
 			/// <c>SIGNAL_EVENT</c> macros.</summary>
 			typedef _SYSTEM_OR_COMPILER_SPECIFIC_ SysEventObject;
 
+			/// <summary>This type defines system specific type for storing thread-local storage slots or handles to them.
+			/// System specific thread-local storage is wrapped by <see cref="GaThreadLocalSlot" /> class.</summary>
+			typedef _SYSTEM_OR_COMPILER_SPECIFIC_ SysTlsObject;
+
 			/// <summary>Yields logical processor to another thread.</summary>
 			inline void GACALL GaYieldProcessor() { }
 
@@ -108,6 +113,7 @@ namespace Common
 			typedef CRITICAL_SECTION SysSyncObject;
 			typedef HANDLE SysSemaphoreObject;
 			typedef HANDLE SysEventObject;
+			typedef DWORD SysTlsObject;
 
 			inline void GACALL GaYieldProcessor() { __asm { rep nop } }
 			inline void GACALL GaYieldThread() { SwitchToThread(); }
@@ -128,6 +134,8 @@ namespace Common
 
 			#endif
 
+			typedef pthread_key_t SysTlsObject;
+
 			inline void GACALL GaYieldProcessor() { asm( "rep nop" ); }
 			inline void GACALL GaYieldThread() { sched_yield(); }
 		
@@ -297,6 +305,106 @@ namespace Common
 
 		};
 		
+		/// <summary><c>GaThreadLocalEntry</c> struct stores value of single thread-local slot in the table of a thread.</summary>
+		struct GaThreadLocalEntry
+		{
+
+			/// <summary>Key of the slot that has stored the value.</summary>
+			unsigned long long _key;
+
+			/// <summary>Value stored by the thread.</summary>
+			void* _value;
+
+			/// <summary>Initializes entry that does not belong to any slot.</summary>
+			GaThreadLocalEntry() : _key(0),
+				_value(NULL) { }
+
+		};
+
+		/// <summary><c>GaThreadLocalTable</c> type represents table that stores values of all thread-local slots for single thread.</summary>
+		typedef std::vector<GaThreadLocalEntry> GaThreadLocalTable;
+
+		/// <summary><c>GaThreadLocalSlot</c> class manages thread-local storage slot.
+		/// Each thread sees its own value stored in the slot and initial value of the slot is <c>NULL</c> for all threads.
+		///
+		/// Operating systems limit number of thread-local storage slots per process, so slots do not allocate system slots.
+		/// Instead, all slots share single system slot that stores table of values for each thread and each slot owns one entry in those tables.
+		/// Entries of destroyed slots are reused, but each slot also has unique key, so values stored through destroyed slot are not visible through new one.
+		/// Tables are freed when their threads exit.
+		///
+		/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class,
+		/// but all public methods are thread-safe.</summary>
+		class GaThreadLocalSlot
+		{
+
+		private:
+
+			/// <summary>System specific object that represents thread-local storage slot which stores tables of threads.</summary>
+			GAL_API
+			static SysTlsObject _tables;
+
+			/// <summary>Index of the entry that stores value of this slot in tables of threads.</summary>
+			int _index;
+
+			/// <summary>Unique key of the slot.</summary>
+			unsigned long long _key;
+
+		public:
+
+			/// <summary>The constructor reserves entry in tables of threads.</summary>
+			/// <exception cref="GaSystemException" />Thrown if the system slot that stores tables cannot be allocated.</exception>
+			GAL_API
+			GaThreadLocalSlot();
+
+			/// <summary>The destructor releases entry of the slot. Values stored by threads are not freed.</summary>
+			GAL_API
+			~GaThreadLocalSlot();
+
+			/// <summary>This method is thread-safe.</summary>
+			/// <returns>Method returns value that calling thread has stored in the slot or <c>NULL</c> if the thread has not stored any value.</returns>
+			inline void* GACALL GetValue() const
+			{
+				const GaThreadLocalTable* table = GetTable();
+				return table && _index < (int)table->size() && ( *table )[ _index ]._key == _key ? ( *table )[ _index ]._value : NULL;
+			}
+
+			/// <summary><c>SetValue</c> method stores value in the slot. Stored value is visible only to the calling thread.
+			///
+			/// This method is thread-safe.</summary>
+			/// <param name="value">value that should be stored.</param>
+			inline void GACALL SetValue(void* value)
+			{
+				GaThreadLocalTable* table = GetTable();
+				GaThreadLocalEntry& entry = table && _index < (int)table->size() ? ( *table )[ _index ] : MakeEntry();
+
+				entry._key = _key;
+				entry._value = value;
+			}
+
+		private:
+
+			/// <summary>This method is thread-safe.</summary>
+			/// <returns>Method returns table of the calling thread or <c>NULL</c> if the thread has not stored values in any slot.</returns>
+			static inline GaThreadLocalTable* GACALL GetTable()
+			{
+				#if defined(GAL_PLATFORM_WIN)
+
+				return (GaThreadLocalTable*)FlsGetValue( _tables );
+
+				#elif defined(GAL_PLATFORM_NIX)
+
+				return (GaThreadLocalTable*)pthread_getspecific( _tables );
+
+				#endif
+			}
+
+			/// <summary><c>MakeEntry</c> method makes table for the calling thread or expands it, so it contains entry of this slot.</summary>
+			/// <returns>Method returns reference to the entry of this slot in the table of calling thread.</returns>
+			GAL_API
+			GaThreadLocalEntry& GACALL MakeEntry();
+
+		};
+
 		/// <summary><c>GaSectionLock</c> class is used for automatic access control with help of <see cref="GaCriticalSection" /> class.
 		/// Synchronization object can be automatically acquired when instance of <c>GaSectionLock</c> is created. If synchronization object
 		/// is locked by instance of <c>GaSectionLock</c> it is released when the instance goes out of scope. This mechanism provides simple
@@ -58,8 +58,90 @@
 
 #endif
 
+#if defined( GAL_SYNTAX_MSVC ) && ( defined( _M_IX86 ) || defined( _M_X64 ) )
+
+	#include <intrin.h>
+
+	// Executes CPUID instruction
+	static void GACALL GaCpuId(int function,
+		int subfunction,
+		int* registers) { __cpuidex( registers, function, subfunction ); }
+
+	// Reads extended control register
+	static unsigned long long GACALL GaReadXcr0() { return _xgetbv( 0 ); }
+
+	#define GAL_CPUID_SUPPORTED
+
+#elif defined( GAL_SYNTAX_GNUC ) && ( defined( __i386__ ) || defined( __x86_64__ ) )
+
+	#include <cpuid.h>
+
+	// Executes CPUID instruction
+	static void GACALL GaCpuId(int function,
+		int subfunction,
+		int* registers)
+	{
+		unsigned int a = 0, b = 0, c = 0, d = 0;
+		__cpuid_count( function, subfunction, a, b, c, d );
+
+		registers[ 0 ] = a;
+		registers[ 1 ] = b;
+		registers[ 2 ] = c;
+		registers[ 3 ] = d;
+	}
+
+	// Reads extended control register
+	static unsigned long long GACALL GaReadXcr0()
+	{
+		unsigned int low, high;
+		__asm__ __volatile__( "xgetbv" : "=a"( low ), "=d"( high ) : "c"( 0 ) );
+		return ( (unsigned long long)high << 32 ) | low;
+	}
+
+	#define GAL_CPUID_SUPPORTED
+
+#endif
+
+GaSimdInstructionSet GACALL GetSimdInstructionSet()
+{
+	GaSimdInstructionSet result = GASIS_NONE;
+
+#if defined( GAL_CPUID_SUPPORTED )
+
+	int registers[ 4 ];
+	GaCpuId( 0, 0, registers );
+	int maxFunction = registers[ 0 ];
+
+	if( maxFunction >= 1 )
+	{
+		GaCpuId( 1, 0, registers );
+
+		// EDX bit 26 - SSE2
+		if( registers[ 3 ] & ( 1 << 26 ) )
+			result = GASIS_SSE2;
+
+		// ECX bit 27 - OS uses XSAVE, ECX bit 28 - AVX
+		// operating system must also preserve YMM registers on context switch
+		if( result == GASIS_SSE2 && maxFunction >= 7 && ( registers[ 2 ] & ( 1 << 27 ) ) && ( registers[ 2 ] & ( 1 << 28 ) ) && ( GaReadXcr0() & 6 ) == 6 )
+		{
+			// EBX bit 5 - AVX2
+			GaCpuId( 7, 0, registers );
+			if( registers[ 1 ] & ( 1 << 5 ) )
+				result = GASIS_AVX2;
+		}
+	}
+
+#endif
+
+	return result;
+}
+
 // Pointer to global instance of CPU info class
 GaCpuInfo* GaCpuInfo::_instance = NULL;
 
 // Collects CPU info
-GaCpuInfo::GaCpuInfo() { _cacheLineSize = ::GetCacheLineSize(); }
+GaCpuInfo::GaCpuInfo()
+{
+	_cacheLineSize = ::GetCacheLineSize();
+	_simdInstructionSet = ::GetSimdInstructionSet();
+}
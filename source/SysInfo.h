@@ -19,6 +19,25 @@
 /// <returns>Method returns size of the largest CPU cache line in bytes.</returns>
 int GACALL GetCacheLineSize();
 
+/// <summary>This enumeration defines SIMD instruction sets that can be used by vectorized kernels of the library.</summary>
+enum GaSimdInstructionSet
+{
+
+	/// <summary>Processor does not support any of instruction sets used by the library, so only scalar code can be used.</summary>
+	GASIS_NONE,
+
+	/// <summary>Processor supports SSE2 instruction set.</summary>
+	GASIS_SSE2,
+
+	/// <summary>Processor and operating system support AVX2 instruction set.</summary>
+	GASIS_AVX2
+
+};
+
+/// <summary><c>GetSimdInstructionSet</c> method queries the most advanced SIMD instruction set supported by CPU and operating system.</summary>
+/// <returns>Method returns supported instruction set.</returns>
+GaSimdInstructionSet GACALL GetSimdInstructionSet();
+
 /// <summary><c>GaCpuInfo</c> class provides information about installed processor(s).
 ///
 /// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class,
@@ -59,6 +78,9 @@ private:
 	/// <summary>Size of the largest CPU cache line in bytes.</summary>
 	int _cacheLineSize;
 
+	/// <summary>The most advanced SIMD instruction set supported by CPU.</summary>
+	GaSimdInstructionSet _simdInstructionSet;
+
 public:
 
 	/// <summary>Constructor collects required information about processor(s).</summary>
@@ -69,6 +91,10 @@ public:
 	/// <returns>Method returns size of the largest CPU cache line in bytes.</returns>
 	inline int GACALL GetCacheLineSize() const { return _cacheLineSize; }
 
+	/// <summary>This method is tread-safe.</summary>
+	/// <returns>Method returns the most advanced SIMD instruction set supported by CPU.</returns>
+	inline GaSimdInstructionSet GACALL GetSimdInstructionSet() const { return _simdInstructionSet; }
+
 };
 
 #endif // __SYS_INFO_H__
@@ -37,6 +37,9 @@ namespace Common
 			int index = _freeIndices[ --_freeIndicesCount ];
 			_tagIndices[ tagID ] = std::make_pair( index, tagLifecycle.Clone() );
 
+			// create column that stores tag
+			_columns[ index ] = CreateColumn( tagLifecycle );
+
 			// insert tag to tag buffers
 			if( !_update.IsNull() )
 				_update->AddTag( index, tagLifecycle );
@@ -65,6 +68,13 @@ namespace Common
 			if( !_update.IsNull() )
 				_update->RemoveTag( index );
 
+			// tag buffers do not reference column anymore
+			if( _columns[ index ] )
+			{
+				delete _columns[ index ];
+				_columns[ index ] = NULL;
+			}
+
 			// shrink size of buffers
 			ShrinkTagBuffer();
 
@@ -89,10 +99,17 @@ namespace Common
 			delete it->second.second;
 			it->second.second = tagLifecycle.Clone();
 
+			// old column is kept until tag buffers are bound to the new one
+			GaTagColumn* oldColumn = _columns[ index ];
+			_columns[ index ] = CreateColumn( tagLifecycle );
+
 			// insert tag to tag buffers
 			if( !_update.IsNull() )
 				_update->AddTag( index, tagLifecycle );
 
+			if( oldColumn )
+				delete oldColumn;
+
 			return index;
 		}
 
@@ -109,8 +126,10 @@ namespace Common
 				// perform update on tag lifecycle policies
 				tagUpdate( *it->second.second );
 
-				// update tags in all buffers
-				if( !_update.IsNull() )
+				// update tags in the column, which also covers all buffers bound to it, or update tags in all buffers
+				if( _columns[ it->second.first ] )
+					_columns[ it->second.first ]->Update( tagUpdate );
+				else if( !_update.IsNull() )
 					_update->UpdateTag( it->second.first, tagUpdate );
 			}
 		}
@@ -210,10 +229,68 @@ namespace Common
 			// use new array that stores indices of unused slots
 			_freeIndices = Memory::GaAutoPtr<int>( newFreeIndicesBuffer, Memory::GaArrayDeletionPolicy<int>::GetInstance() );
 
+			// update size of column table
+			_columns.SetSize( _bufferSize, NULL );
+
 			// update size of buffers
 			if( !_update.IsNull() )
 				_update->SetBufferSize( _bufferSize );
 		}
 
+		// Assigns slot in columns
+		int GaTagManager::AcquireSlot()
+		{
+			if( !_columnStorage )
+				return -1;
+
+			GA_LOCK_SECTION( lock, _slotLock );
+
+			// reuse released slot if there is any
+			if( _freeSlotsCount )
+				return _freeSlots[ --_freeSlotsCount ];
+
+			int slot = _slotCount++;
+
+			// grow columns so they can store tags for the new slot
+			for( GaTagIndicesTable::iterator it = _tagIndices.begin(); it != _tagIndices.end(); ++it )
+			{
+				if( _columns[ it->second.first ] )
+					_columns[ it->second.first ]->SetSize( _slotCount, *it->second.second );
+			}
+
+			return slot;
+		}
+
+		// Frees slot in columns
+		void GaTagManager::ReleaseSlot(int slot)
+		{
+			if( slot < 0 )
+				return;
+
+			GA_LOCK_SECTION( lock, _slotLock );
+
+			// double size of the array if it is full
+			if( _freeSlotsCount == _freeSlots.GetSize() )
+				_freeSlots.SetSize( _freeSlotsCount ? 2 * _freeSlotsCount : 16 );
+
+			_freeSlots[ _freeSlotsCount++ ] = slot;
+		}
+
+		// Creates column for the tag
+		GaTagColumn* GaTagManager::CreateColumn(const GaTagLifecycle& tagLifecycle)
+		{
+			if( !_columnStorage )
+				return NULL;
+
+			GA_LOCK_SECTION( lock, _slotLock );
+
+			// column should be able to store tags for all assigned slots
+			GaTagColumn* column = tagLifecycle.CreateColumn();
+			if( column )
+				column->SetSize( _slotCount, tagLifecycle );
+
+			return column;
+		}
+
 	} // Data
 } // Common
@@ -18,6 +18,7 @@
 #include "Array.h"
 #include "List.h"
 #include "Flags.h"
+#include "Synchronization.h"
 
 namespace Common
 {
@@ -35,6 +36,8 @@ namespace Common
 
 		};
 
+		class GaTagColumn;
+
 		/// <summary><c>GaTagLifecycle</c> is interface for managing tag lifecycle.</summary>
 		class GaTagLifecycle
 		{
@@ -60,6 +63,11 @@ namespace Common
 			/// <param name="tag">tag that should be cleaned after use.</param>
 			virtual void GACALL CleanTag(GaTag& tag) const = 0;
 
+			/// <summary><c>CreateColumn</c> method creates column that can store tags of all objects in a single contiguous storage.
+			/// Default implementation does not support column storage.</summary>
+			/// <returns>Method returns pointer to a newly created column or <c>NULL</c> if tags cannot be stored in column.</returns>
+			virtual GaTagColumn* GACALL CreateColumn() const { return NULL; }
+
 		};
 
 		/// <summary><c>GaTagUpdate</c> base class for tag update policy.</summary>
@@ -135,6 +143,184 @@ namespace Common
 
 		};
 
+		/// <summary><c>GaTagColumn</c> class is interface for storage that keeps single tag of all objects in contiguous blocks of memory.
+		/// Tags are indexed by slot that is assigned to object by tag manager. Once the column is grown, addresses of its tags do not change.</summary>
+		class GaTagColumn
+		{
+
+		public:
+
+			/// <summary>Virtual destructor must be defined because this is base class.</summary>
+			virtual ~GaTagColumn() { }
+
+			/// <summary><c>SetSize</c> method grows column so it can store tags for specified number of slots. Column never shrinks.</summary>
+			/// <param name="size">number of slots that column should be able to store.</param>
+			/// <param name="tagLifecycle">lifecycle manager of the tag that is used for constructing new tags.</param>
+			virtual void GACALL SetSize(int size,
+				const GaTagLifecycle& tagLifecycle) = 0;
+
+			/// <summary><c>Update</c> method performs update operation over tags in all slots of the column.</summary>
+			/// <param name="update">update operation that should be performed.</param>
+			virtual void GACALL Update(const GaTagUpdate& update) = 0;
+
+			/// <summary><c>GetAt</c> method retrieves tag from the column.</summary>
+			/// <param name="slot">slot of the tag.</param>
+			/// <returns>Method returns reference to tag stored in the specified slot.</returns>
+			virtual GaTag& GACALL GetAt(int slot) = 0;
+
+			/// <summary><c>GetAt</c> method retrieves tag from the column.</summary>
+			/// <param name="slot">slot of the tag.</param>
+			/// <returns>Method returns reference to tag stored in the specified slot.</returns>
+			virtual const GaTag& GACALL GetAt(int slot) const = 0;
+
+		};
+
+		/// <summary><c>GaTypedTagColumn</c> template class stores tags of specified type in blocks of contiguous memory.
+		///
+		/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
+		/// Growing the column is not thread-safe, but it does not move tags that are already stored so they can be accessed concurrently.</summary>
+		/// <typeparam name="DATA_TYPE">type of data stored in the tag.</typeparam>
+		template<typename DATA_TYPE>
+		class GaTypedTagColumn : public GaTagColumn
+		{
+
+		public:
+
+			/// <summary>Type of data stored in the tag.</summary>
+			typedef DATA_TYPE GaDataType;
+
+			/// <summary>Type of tags stored in the column.</summary>
+			typedef GaTypedTag<GaDataType> GaTagType;
+
+			/// <summary>Binary logarithm of number of tags stored in a single block.</summary>
+			static const int BLOCK_SHIFT = 8;
+
+			/// <summary>Number of tags stored in a single block.</summary>
+			static const int BLOCK_SIZE = 1 << BLOCK_SHIFT;
+
+			/// <summary>Maximal number of blocks that column can have.</summary>
+			static const int MAX_BLOCKS = 4096;
+
+		private:
+
+			/// <summary>Blocks that store tags. Table has fixed size so growing column does not affect threads that access existing blocks.</summary>
+			GaTagType* _blocks[ MAX_BLOCKS ];
+
+			/// <summary>Number of allocated blocks.</summary>
+			int _blockCount;
+
+		public:
+
+			/// <summary>This constructor initializes empty column.</summary>
+			GaTypedTagColumn() : _blockCount(0) { }
+
+			/// <summary>Destroys all tags and frees memory used by blocks.</summary>
+			virtual ~GaTypedTagColumn()
+			{
+				for( int i = _blockCount - 1; i >= 0; i-- )
+				{
+					for( int j = BLOCK_SIZE - 1; j >= 0; j-- )
+						_blocks[ i ][ j ].~GaTagType();
+
+					delete[] (char*)_blocks[ i ];
+				}
+			}
+
+			/// <summary>More details are given in specification of <see cref="GaTagColumn::SetSize" /> method.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <exception cref="GaArgumentOutOfRangeException" />Thrown if column cannot store required number of slots.</exception>
+			virtual void GACALL SetSize(int size,
+				const GaTagLifecycle& tagLifecycle)
+			{
+				int count = ( size + BLOCK_SIZE - 1 ) >> BLOCK_SHIFT;
+				GA_ARG_ASSERT( Exceptions::GaArgumentOutOfRangeException, count <= MAX_BLOCKS, "size", "Column cannot store required number of tags.", "Data" );
+
+				for( ; _blockCount < count; _blockCount++ )
+				{
+					GaTagType* block = (GaTagType*)new char[ BLOCK_SIZE * sizeof( GaTagType ) ];
+
+					// construct tags in new block
+					for( int i = 0; i < BLOCK_SIZE; i++ )
+						ConstructTag( block + i, tagLifecycle );
+
+					_blocks[ _blockCount ] = block;
+				}
+			}
+
+			/// <summary>More details are given in specification of <see cref="GaTagColumn::Update" /> method.
+			///
+			/// This method is not thread-safe.</summary>
+			virtual void GACALL Update(const GaTagUpdate& update)
+			{
+				for( int i = _blockCount - 1; i >= 0; i-- )
+				{
+					for( int j = BLOCK_SIZE - 1; j >= 0; j-- )
+						update( _blocks[ i ][ j ] );
+				}
+			}
+
+			/// <summary>More details are given in specification of <see cref="GaTagColumn::GetAt" /> method.
+			///
+			/// This method is thread-safe.</summary>
+			virtual GaTag& GACALL GetAt(int slot) { return GetTag( slot ); }
+
+			/// <summary>More details are given in specification of <see cref="GaTagColumn::GetAt" /> method.
+			///
+			/// This method is thread-safe.</summary>
+			virtual const GaTag& GACALL GetAt(int slot) const { return GetTag( slot ); }
+
+			/// <summary><c>GetTag</c> method retrieves typed tag from the column without virtual call.
+			///
+			/// This method is thread-safe.</summary>
+			/// <param name="slot">slot of the tag.</param>
+			/// <returns>Method returns reference to tag stored in the specified slot.</returns>
+			inline GaTagType& GACALL GetTag(int slot) { return _blocks[ slot >> BLOCK_SHIFT ][ slot & ( BLOCK_SIZE - 1 ) ]; }
+
+			/// <summary><c>GetTag</c> method retrieves typed tag from the column without virtual call.
+			///
+			/// This method is thread-safe.</summary>
+			/// <param name="slot">slot of the tag.</param>
+			/// <returns>Method returns reference to tag stored in the specified slot.</returns>
+			inline const GaTagType& GACALL GetTag(int slot) const { return _blocks[ slot >> BLOCK_SHIFT ][ slot & ( BLOCK_SIZE - 1 ) ]; }
+
+		protected:
+
+			/// <summary><c>ConstructTag</c> method constructs tag in provided memory.</summary>
+			/// <param name="place">memory in which the tag should be constructed.</param>
+			/// <param name="tagLifecycle">lifecycle manager of the tag.</param>
+			virtual void GACALL ConstructTag(GaTagType* place,
+				const GaTagLifecycle& tagLifecycle) const = 0;
+
+		};
+
+		/// <summary><c>GaLifecycleTagColumn</c> template class implements column that constructs tags using specified lifecycle manager.
+		///
+		/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
+		/// Growing the column is not thread-safe, but it does not move tags that are already stored so they can be accessed concurrently.</summary>
+		/// <typeparam name="LIFECYCLE">type of tag lifecycle manager.</typeparam>
+		template<typename LIFECYCLE>
+		class GaLifecycleTagColumn : public GaTypedTagColumn<typename LIFECYCLE::GaDataType>
+		{
+
+		public:
+
+			/// <summary>Type of tag lifecycle manager.</summary>
+			typedef LIFECYCLE GaLifecycleType;
+
+			/// <summary>Type of tags stored in the column.</summary>
+			typedef GaTypedTag<typename GaLifecycleType::GaDataType> GaTagType;
+
+		protected:
+
+			/// <summary>More details are given in specification of <see cref="GaTypedTagColumn::ConstructTag" /> method.
+			///
+			/// This method is not thread-safe.</summary>
+			virtual void GACALL ConstructTag(GaTagType* place,
+				const GaTagLifecycle& tagLifecycle) const { ( (const GaLifecycleType&)tagLifecycle ).ConstructTag( place ); }
+
+		};
+
 		/// <summary><c>GaTypedTagLifecycle</c> class implements lifecycle manager for tags that stores data of specified type.
 		///
 		/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
@@ -161,6 +347,17 @@ namespace Common
 			/// This method is thread-safe.</summary>
 			virtual GaTag* GACALL CreateTag() const { return new GaTypedTag<GaDataType>(); }
 
+			/// <summary>More details are given in specification of <see cref="GaTagLifecycle::CreateColumn" /> method.
+			///
+			/// This method is thread-safe.</summary>
+			virtual GaTagColumn* GACALL CreateColumn() const { return new GaLifecycleTagColumn<GaTypedTagLifecycle<GaDataType> >(); }
+
+			/// <summary><c>ConstructTag</c> method constructs tag in memory provided by column.
+			///
+			/// This method is thread-safe.</summary>
+			/// <param name="place">memory in which the tag should be constructed.</param>
+			inline void GACALL ConstructTag(GaTypedTag<GaDataType>* place) const { new ( place, GaAllocatorHelper() ) GaTypedTag<GaDataType>(); }
+
 			/// <summary>More details are given in specification of <see cref="GaTagLifecycle::PrepareTag" /> method.
 			///
 			/// This method is thread-safe.</summary>
@@ -185,11 +382,15 @@ namespace Common
 			/// <summary>Array that stores pointers to tags.</summary>
 			Data::GaSingleDimensionArray<GaTag*> _tags;
 
+			/// <summary>Array of flags that indicate which tags are stored in a column and not owned by the buffer.</summary>
+			Data::GaSingleDimensionArray<bool> _bound;
+
 		public:
 
 			/// <summary>Initializes buffer with defined initial size.</summary>
 			/// <param name="initialSize">initial size of the buffer.</param>
-			GaTagBuffer(int initialSize) : _tags(initialSize) { }
+			GaTagBuffer(int initialSize) : _tags(initialSize),
+				_bound(initialSize, false) { }
 
 			/// <summary>Initializes empty tag buffer.</summary>
 			GaTagBuffer() { }
@@ -197,10 +398,10 @@ namespace Common
 			/// <summary>Free resource used by the tags stored in this buffer and buffer itself.</summary>
 			~GaTagBuffer()
 			{
-				// delete all tags in buffer
+				// delete all tags owned by buffer
 				for( int i = _tags.GetSize() - 1; i >= 0; i-- )
 				{
-					if( _tags[ i ] )
+					if( _tags[ i ] && !_bound[ i ] )
 						delete _tags[ i ];
 				}
 			}
@@ -215,10 +416,24 @@ namespace Common
 				GaTag* tag)
 			{
 				// delete old tag
-				if( _tags[ index ] )
+				if( _tags[ index ] && !_bound[ index ] )
 					delete _tags[ index ];
 
 				_tags[ index ] = tag;
+				_bound[ index ] = false;
+			}
+
+			/// <summary><c>BindTag</c> method stores pointer to the tag that is owned by a column at the specified position in the buffer.
+			/// If there is already tag at specified position, this method deletes old tag if it is owned by the buffer.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="index">index at whic the tag should be stored in the buffer.</param>
+			/// <param name="tag">reference to the tag stored in column.</param>
+			inline void GACALL BindTag(int index,
+				GaTag& tag)
+			{
+				SetTag( index, &tag );
+				_bound[ index ] = true;
 			}
 
 			/// <summary><c>RemoveTag</c> method deletes tag at specified index if it exists.
@@ -250,11 +465,12 @@ namespace Common
 				// delete shrinked tags
 				for( int i = _tags.GetSize() - 1; i >= size; i-- )
 				{
-					if( _tags[ i ] )
+					if( _tags[ i ] && !_bound[ i ] )
 						delete _tags[ i ];
 				}
 
 				_tags.SetSize( size );
+				_bound.SetSize( size, false );
 			}
 
 			/// <summary>This method is not thread-safe.</summary>
@@ -309,6 +525,10 @@ namespace Common
 		};
 
 		/// <summary><c>GaTagManager</c> class manages tags and tag buffers.
+		///
+		/// Tag manager can store tags in columns instead of creating separate tag object for each tag of each object. Each object that uses column storage
+		/// has its slot assigned by the manager and all its tags are stored at that slot in the columns of the tags. Tag buffers of such objects only
+		/// reference tags stored in columns. Tags whose lifecycle managers do not support columns are always stored as separate objects.
 		/// 
 		/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
 		/// No public or private methods are thread-safe.</summary>
@@ -335,26 +555,54 @@ namespace Common
 			/// <summary>Number of tags that currently tag buffers can store.</summary>
 			int _bufferSize;
 
+			/// <summary>Indicates whether the tags are stored in columns.</summary>
+			bool _columnStorage;
+
+			/// <summary>Columns that store tags. Columns are indexed by slot index of the tag in tag buffer.</summary>
+			Data::GaSingleDimensionArray<GaTagColumn*> _columns;
+
+			/// <summary>Number of slots that are assigned to objects or are free for reuse.</summary>
+			int _slotCount;
+
+			/// <summary>Slots that are released and can be reused.</summary>
+			Data::GaSingleDimensionArray<int> _freeSlots;
+
+			/// <summary>Number of slots that are released and can be reused.</summary>
+			int _freeSlotsCount;
+
+			/// <summary>Critical section that protects slot assignment.</summary>
+			mutable Threading::GaCriticalSection _slotLock;
+
 		public:
 
 			/// <summary>Initialize tag manager with population which it manages and initial size of tag buffers.</summary>
 			/// <param name="initialSize">initial size of tag buffers that should be created.</param>
 			/// <param name="update">pointer to object used for updating tag buffers when tags are added, removed or modified. Tag manager takes ownership of the update object.</param>
+			/// <param name="columnStorage">if this parameter is set to <c>true</c> tags are stored in columns.</param>
 			/// <exception cref="GaArgumentOutOfRangeException" />Thrown if <c>initialSize</c> is negative value or 0.</exception>
 			GaTagManager(int initialSize,
-				GaTagBufferUpdate* update) : _update(update),
+				GaTagBufferUpdate* update,
+				bool columnStorage = false) : _update(update),
 				_freeIndicesCount(0),
-				_bufferSize(0)
+				_bufferSize(0),
+				_columnStorage(columnStorage),
+				_slotCount(0),
+				_freeSlotsCount(0)
 			{
 				GA_ARG_ASSERT( Exceptions::GaArgumentOutOfRangeException, initialSize > 0, "initialSize", "Initial size cannot be negative value or zero", "Data" );
 				ChangeBufferSize( initialSize );
 			}
 
-			/// <summary>Deletes tag prototypes.</summary>
+			/// <summary>Deletes tag prototypes and columns.</summary>
 			~GaTagManager()
 			{
 				for( GaTagIndicesTable::iterator it = _tagIndices.begin(); it != _tagIndices.end(); ++it )
+				{
 					delete it->second.second;
+
+					if( _columns[ it->second.first ] )
+						delete _columns[ it->second.first ];
+				}
 			}
 
 			/// <summary><c>AddTag</c> inserts new tag to tag buffers and maps ID of new tag to index of slot int tag buffer that will be used to store tag.
@@ -428,15 +676,61 @@ namespace Common
 			///
 			/// This method is not thread-safe.</summary>
 			/// <param name="buffer">reference to buffer that should be initialized.</param>
-			void GACALL InitBuffer(GaTagBuffer& buffer) const
+			/// <param name="slot">slot assigned to the object that owns the buffer or -1 if the object does not use column storage.</param>
+			void GACALL InitBuffer(GaTagBuffer& buffer,
+				int slot = -1) const
 			{
 				buffer.SetSize( _bufferSize );
 
-				// fill buffer with tag created using stored prototypes
+				// fill buffer with tag created using stored prototypes or bind tags stored in columns
 				for( GaTagIndicesTable::const_iterator it = _tagIndices.begin(); it != _tagIndices.end(); ++it )
-					buffer.SetTag( it->second.first, it->second.second->CreateTag() );
+					InitTag( buffer, it->second.first, slot, *it->second.second );
 			}
 
+			/// <summary><c>InitTag</c> method stores tag at specified index in the buffer. If the tag is stored in a column,
+			/// method binds tag at specified slot of the column, otherwise it creates new tag.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="buffer">reference to buffer in which the tag is stored.</param>
+			/// <param name="index">index of the tag in buffer.</param>
+			/// <param name="slot">slot assigned to the object that owns the buffer or -1 if the object does not use column storage.</param>
+			/// <param name="tagLifecycle">lifecycle manager of the tag.</param>
+			inline void GACALL InitTag(GaTagBuffer& buffer,
+				int index,
+				int slot,
+				const GaTagLifecycle& tagLifecycle) const
+			{
+				if( slot >= 0 && _columns[ index ] )
+					buffer.BindTag( index, _columns[ index ]->GetAt( slot ) );
+				else
+					buffer.SetTag( index, tagLifecycle.CreateTag() );
+			}
+
+			/// <summary><c>AcquireSlot</c> method assigns slot in columns to an object.
+			///
+			/// This method is thread-safe.</summary>
+			/// <returns>Method returns assigned slot or -1 if the manager does not use column storage.</returns>
+			GAL_API
+			int GACALL AcquireSlot();
+
+			/// <summary><c>ReleaseSlot</c> method frees slot so it can be assigned to another object.
+			///
+			/// This method is thread-safe.</summary>
+			/// <param name="slot">slot that should be released.</param>
+			GAL_API
+			void GACALL ReleaseSlot(int slot);
+
+			/// <summary><c>GetColumn</c> method returns column that stores tag with specified index.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="index">index of the tag in tag buffers.</param>
+			/// <returns>Method returns pointer to the column or <c>NULL</c> if the tag is not stored in a column.</returns>
+			inline GaTagColumn* GACALL GetColumn(int index) const { return index >= 0 ? _columns[ index ] : NULL; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns <c>true</c> if the manager stores tags in columns.</returns>
+			inline bool GACALL IsColumnStorage() const { return _columnStorage; }
+
 			/// <summary><c>PrepareBuffer</c> method prepares tags in specified buffer before use.
 			///
 			/// This method is not thread-safe.</summary>
@@ -490,6 +784,12 @@ namespace Common
 			GAL_API
 			void GACALL ChangeBufferSize(int delta);
 
+			/// <summary><c>CreateColumn</c> method creates column for the tag if the manager uses column storage and lifecycle manager supports it.</summary>
+			/// <param name="tagLifecycle">lifecycle manager of the tag.</param>
+			/// <returns>Method returns pointer to a newly created column or <c>NULL</c> if the tag should not be stored in a column.</returns>
+			GAL_API
+			GaTagColumn* GACALL CreateColumn(const GaTagLifecycle& tagLifecycle);
+
 		};
 
 		/// <summary><c>GaSizableTagLifecycle</c> class implements lifecycle manager for tags that stores data of specified type, but which also requires size management.
@@ -530,6 +830,17 @@ namespace Common
 			/// This method is not thread-safe.</summary>
 			virtual GaTag* GACALL CreateTag() const { return new GaTypedTag<GaDataType>( _size ); }
 
+			/// <summary>More details are given in specification of <see cref="GaTagLifecycle::CreateColumn" /> method.
+			///
+			/// This method is not thread-safe.</summary>
+			virtual GaTagColumn* GACALL CreateColumn() const { return new GaLifecycleTagColumn<GaSizableTagLifecycle<GaDataType> >(); }
+
+			/// <summary><c>ConstructTag</c> method constructs tag in memory provided by column.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="place">memory in which the tag should be constructed.</param>
+			inline void GACALL ConstructTag(GaTypedTag<GaDataType>* place) const { new ( place, GaAllocatorHelper() ) GaTypedTag<GaDataType>( _size ); }
+
 			/// <summary>More details are given in specification of <see cref="GaTagLifecycle::PrepareTag" /> method.
 			///
 			/// This method is not thread-safe.</summary>
@@ -17,6 +17,59 @@ namespace Common
 	namespace Threading
 	{
 
+		// Adds worker to the list of workers whose queues can be used for stealing
+		void GaWorkerThread::GaWorkerThreadCounter::RegisterWorker(GaWorkerThread* worker)
+		{
+			GA_LOCK( _workersLock );
+			_workers.push_back( worker );
+			GA_UNLOCK( _workersLock );
+		}
+
+		// Removes worker from the list of workers whose queues can be used for stealing
+		void GaWorkerThread::GaWorkerThreadCounter::UnregisterWorker(GaWorkerThread* worker)
+		{
+			GA_LOCK( _workersLock );
+
+			for( std::vector<GaWorkerThread*>::iterator it = _workers.begin(); it != _workers.end(); ++it )
+			{
+				if( *it == worker )
+				{
+					_workers.erase( it );
+					break;
+				}
+			}
+
+			GA_UNLOCK( _workersLock );
+		}
+
+		// Steals work queued to other workers
+		GaWorkItem* GaWorkerThread::GaWorkerThreadCounter::StealWork(GaWorkerThread* thief)
+		{
+			GaWorkItem* item = NULL;
+
+			// workers cannot be destroyed while their queues are searched
+			GA_LOCK( _workersLock );
+
+			int count = (int)_workers.size();
+			if( count > 0 )
+			{
+				// start search from different worker each time to spread contention among queues
+				int start = _nextVictim % count;
+				_nextVictim = start + 1;
+
+				for( int i = 0; i < count && !item; i++ )
+				{
+					GaWorkerThread* victim = _workers[ ( start + i ) % count ];
+					if( victim != thief )
+						item = victim->StealWork();
+				}
+			}
+
+			GA_UNLOCK( _workersLock );
+
+			return item;
+		}
+
 		// Creates thread and initializes worker
 		GaWorkerThread::GaWorkerThread(GaWorkerThreadCounter* threadCounter) : _threadCounter(threadCounter),
 			_currentWork(NULL),
@@ -27,12 +80,16 @@ namespace Common
 			_threadStartParams._functionParameters = this;
 
 			_event = GaEventPool::GetInstance()->GetEventWithAutoPtr( GaEvent::GAET_AUTO );
+
+			_threadCounter->RegisterWorker( this );
 			_thread = new GaThread( _threadStartParams, true );
 		}
 
 		// Frees used resources
 		GaWorkerThread::~GaWorkerThread()
 		{
+			_threadCounter->UnregisterWorker( this );
+
 			_event = NULL;
 			_thread = NULL;
 			_exceptionHandler = NULL;
@@ -45,6 +102,7 @@ namespace Common
 			void* params)
 		{
 			GaWorkerThread* pThis = (GaWorkerThread*)params;
+			pThis->_threadCounter->SetCurrentWorker( pThis );
 
 			while( 1 )
 			{
@@ -52,28 +110,12 @@ namespace Common
 				pThis->_event->Wait();
 
 				// exit if thread is marked for closing
-				if( pThis->_closed && !pThis->_currentWork )
+				if( pThis->_closed && pThis->_queue.IsEmpty() )
 					break;
 
-				try
-				{
-					// execute work item
-					( *pThis->_currentWork )();
-				}
-				catch( Exceptions::GaException& exception )
-				{
-					if( pThis->_currentWork->GetResults() )
-						// store exception in result object
-						pThis->_currentWork->GetResults()->SetException( exception );
-					else if( !pThis->_exceptionHandler.IsNull() )
-						// call generic handler
-						pThis->_exceptionHandler->OnException( exception );
-					else
-						throw;
-				}
-
-				// destroy work item object
-				pThis->_currentWork = NULL;
+				// execute own work items and then steal work from other workers until there is no more queued work
+				for( GaWorkItem* item = NULL; pThis->_queue.Pop( item ) || ( item = pThis->_threadCounter->StealWork( pThis ) ) != NULL; item = NULL )
+					pThis->ExecuteWork( item );
 
 				// return thread to the pool
 				GaPoolPtr ptr = pThis->_pool;
@@ -87,6 +129,32 @@ namespace Common
 			return 0;
 		}
 
+		// Executes single work item
+		void GaWorkerThread::ExecuteWork(GaWorkItem* item)
+		{
+			_currentWork = item;
+
+			try
+			{
+				// execute work item
+				( *_currentWork )();
+			}
+			catch( Exceptions::GaException& exception )
+			{
+				if( _currentWork->GetResults() )
+					// store exception in result object
+					_currentWork->GetResults()->SetException( exception );
+				else if( !_exceptionHandler.IsNull() )
+					// call generic handler
+					_exceptionHandler->OnException( exception );
+				else
+					throw;
+			}
+
+			// destroy work item object
+			_currentWork = NULL;
+		}
+
 		// Pointer to global instance of thread pool
 		GaThreadPool* GaThreadPool::_instance = NULL;
 
@@ -102,7 +170,15 @@ namespace Common
 			GaWorkItem* copy = workItem->MakeCopy( makeResultsObject );
 			GaWorkResults* res = copy->GetResults();
 
-			ptr->AcquireObject()->SetWork( copy, ptr, _exceptionHandler );
+			GaWorkerThread* current = _threadCounter.GetCurrentWorker();
+			if( current )
+			{
+				// queue item to the calling worker and wake available thread that will steal it if the calling worker is still busy
+				current->QueueWork( copy );
+				ptr->AcquireObject()->SetWork( NULL, ptr, _exceptionHandler );
+			}
+			else
+				ptr->AcquireObject()->SetWork( copy, ptr, _exceptionHandler );
 
 			// return pointer to results object of work item or NULL if it is not required
 			return res;
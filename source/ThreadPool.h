@@ -13,6 +13,8 @@
 #ifndef __GA_THREAD_POOL_H__
 #define __GA_THREAD_POOL_H__
 
+#include <deque>
+#include <vector>
 #include "Threading.h"
 #include "EventPool.h"
 
@@ -21,6 +23,108 @@ namespace Common
 	namespace Threading
 	{
 
+		/// <summary><c>GaWorkStealingQueue</c> template class represents double-ended queue of work that is owned by a single thread.
+		/// Owner thread adds and removes work at the bottom of the queue (LIFO order), while other threads steal work from the top (FIFO order),
+		/// so the owner keeps working on the most recent (cache-warm) work and thieves take the oldest and usually the largest pieces of work.
+		///
+		/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class,
+		/// but all public methods are thread-safe.</summary>
+		/// <typeparam name="T">type of work stored in the queue.</typeparam>
+		template<typename T>
+		class GaWorkStealingQueue
+		{
+
+		private:
+
+			GA_DECLARE_SPINLOCK( _lock );
+
+			/// <summary>Queued work.</summary>
+			std::deque<T> _items;
+
+		public:
+
+			/// <summary><c>Push</c> method adds work at the bottom of the queue. It should be called only by the owner of the queue.
+			///
+			/// This method is thread-safe.</summary>
+			/// <param name="item">work that should be queued.</param>
+			inline void GACALL Push(const T& item)
+			{
+				GA_LOCK( _lock );
+				_items.push_back( item );
+				GA_UNLOCK( _lock );
+			}
+
+			/// <summary><c>Pop</c> method removes work from the bottom of the queue. It should be called only by the owner of the queue.
+			///
+			/// This method is thread-safe.</summary>
+			/// <param name="item">reference to variable that will store removed work.</param>
+			/// <returns>Method returns <c>false</c> if the queue is empty.</returns>
+			inline bool GACALL Pop(T& item)
+			{
+				GA_LOCK( _lock );
+
+				bool found = !_items.empty();
+				if( found )
+				{
+					item = _items.back();
+					_items.pop_back();
+				}
+
+				GA_UNLOCK( _lock );
+				return found;
+			}
+
+			/// <summary><c>Steal</c> method removes work from the top of the queue. It is called by threads that do not own the queue.
+			///
+			/// This method is thread-safe.</summary>
+			/// <param name="item">reference to variable that will store stolen work.</param>
+			/// <returns>Method returns <c>false</c> if the queue is empty.</returns>
+			inline bool GACALL Steal(T& item)
+			{
+				GA_LOCK( _lock );
+
+				bool found = !_items.empty();
+				if( found )
+				{
+					item = _items.front();
+					_items.pop_front();
+				}
+
+				GA_UNLOCK( _lock );
+				return found;
+			}
+
+			/// <summary><c>Steal</c> method removes work from the top of the queue only if it is accepted by the provided predicate.
+			/// It is called by threads that do not own the queue.
+			///
+			/// This method is thread-safe.</summary>
+			/// <typeparam name="MATCH">type of predicate that decides whether the work can be stolen.</typeparam>
+			/// <param name="item">reference to variable that will store stolen work.</param>
+			/// <param name="match">predicate that decides whether the work can be stolen.</param>
+			/// <returns>Method returns <c>false</c> if the queue is empty or if the predicate has not accepted work at the top of the queue.</returns>
+			template<typename MATCH>
+			inline bool GACALL Steal(T& item,
+				const MATCH& match)
+			{
+				GA_LOCK( _lock );
+
+				bool found = !_items.empty() && match( _items.front() );
+				if( found )
+				{
+					item = _items.front();
+					_items.pop_front();
+				}
+
+				GA_UNLOCK( _lock );
+				return found;
+			}
+
+			/// <summary>This method is thread-safe, but returned value can be outdated.</summary>
+			/// <returns>Method returns <c>true</c> if there is no queued work.</returns>
+			inline bool GACALL IsEmpty() const { return _items.empty(); }
+
+		};
+
 		class GaThreadPool;
 		class GaWorkItem;
 
@@ -37,6 +141,7 @@ namespace Common
 
 			/// <summary><c>GaWorkerThreadCounter</c> class tracks number of existing worker threads. 
 			/// And provides synchronizatiom method for safe cleaup of resources used by those threads.
+			/// It also keeps list of existing worker threads so idle workers can steal queued work from busy workers.
 			/// 
 			/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class,
 			/// but all public methods are thread-safe.</summary>
@@ -51,15 +156,59 @@ namespace Common
 				/// <summary>Event raises when count of worker threads reache zero.</summary>
 				Memory::GaAutoPtr<GaEvent> _finishEvent;
 
+				GA_DECLARE_SPINLOCK( _workersLock );
+
+				/// <summary>Existing worker threads whose queues can be used for stealing work.</summary>
+				std::vector<GaWorkerThread*> _workers;
+
+				/// <summary>Position in the list of workers from which the next search for work that can be stolen starts.</summary>
+				int _nextVictim;
+
+				/// <summary>Slot that stores pointer to worker object for threads which are managed by this counter.</summary>
+				GaThreadLocalSlot _currentWorker;
+
 			public:
 
 				/// <summary>Initializes counter.</summary>
-				GaWorkerThreadCounter()
+				GaWorkerThreadCounter() : _nextVictim(0)
 				{
 					_finishEvent = GaEventPool::GetInstance()->GetEventWithAutoPtr( GaEvent::GAET_MANUAL );
 					_finishEvent->Signal();
 				}
 
+				/// <summary><c>RegisterWorker</c> method adds worker to the list of workers whose queues can be used for stealing work.
+				///
+				/// This method is thread-safe.</summary>
+				/// <param name="worker">pointer to worker that should be added.</param>
+				GAL_API
+				void GACALL RegisterWorker(GaWorkerThread* worker);
+
+				/// <summary><c>UnregisterWorker</c> method removes worker from the list of workers whose queues can be used for stealing work.
+				///
+				/// This method is thread-safe.</summary>
+				/// <param name="worker">pointer to worker that should be removed.</param>
+				GAL_API
+				void GACALL UnregisterWorker(GaWorkerThread* worker);
+
+				/// <summary><c>StealWork</c> method searches queues of other workers for work that can be stolen.
+				/// Search starts from different worker each time the method is called to spread contention among queues.
+				///
+				/// This method is thread-safe.</summary>
+				/// <param name="thief">pointer to worker that tries to steal work. Queue of this worker is skipped.</param>
+				/// <returns>Method returns pointer to stolen work item or <c>NULL</c> if there is no queued work.</returns>
+				GAL_API
+				GaWorkItem* GACALL StealWork(GaWorkerThread* thief);
+
+				/// <summary><c>SetCurrentWorker</c> method stores pointer to worker object of the calling thread.
+				///
+				/// This method is thread-safe.</summary>
+				/// <param name="worker">pointer to worker object.</param>
+				inline void GACALL SetCurrentWorker(GaWorkerThread* worker) { _currentWorker.SetValue( worker ); }
+
+				/// <summary>This method is thread-safe.</summary>
+				/// <returns>Method returns pointer to worker object of the calling thread or <c>NULL</c> if the thread is not managed by this counter.</returns>
+				inline GaWorkerThread* GACALL GetCurrentWorker() const { return (GaWorkerThread*)_currentWorker.GetValue(); }
+
 				/// <summary><c>WorkerThreadStart</c> method increments count of existing threads, and reset event if it was raised.
 				///
 				/// This method is thread-safe.</summary>
@@ -151,6 +300,9 @@ namespace Common
 			/// <summary>Pointer to work item which is currently executing. This attribut is <c>NULL</c> if the thread waits for work.</summary>
 			Memory::GaAutoPtr<GaWorkItem> _currentWork;
 
+			/// <summary>Work items queued to this worker thread which have not been started yet. Other workers can steal them.</summary>
+			GaWorkStealingQueue<GaWorkItem*> _queue;
+
 			/// <summary>Indicates whether the worker thread is marked for closing.</summary>
 			bool _closed;
 
@@ -173,10 +325,12 @@ namespace Common
 			/// This mehtod is not thread-safe.</summary>
 			inline void GACALL StartWorker() { _thread->Start(); }
 
-			/// <summary><c>SetWork</c> method assigns work item and wakes the thread.
+			/// <summary><c>SetWork</c> method assigns work item and wakes the thread. When the thread finishes assigned work item,
+			/// it executes items from its queue and steals items queued to other workers before it returns to the pool.
 			///
 			/// This mehtod is not thread-safe.</summary>
-			/// <param name="item">pointer to work item which has been assigned to the thread.</param>
+			/// <param name="item">pointer to work item which has been assigned to the thread. If this parameter is <c>NULL</c>
+			/// the thread only tries to steal work queued to other workers.</param>
 			/// <param name="ownerPool">smart pointer to object pool from which this thread is retrieved.</param>
 			/// <param name="exceptionHandler">pointer to generic exception handler for exceptions that occured during the execution of work items
 			/// but are not stored in result object of those items.</param>
@@ -186,10 +340,31 @@ namespace Common
 			{
 				_pool = ownerPool;
 				_exceptionHandler = exceptionHandler;
-				_currentWork = item;
+
+				if( item )
+					_queue.Push( item );
+
 				_event->Signal();
 			}
 
+			/// <summary><c>QueueWork</c> method adds work item to the queue of the worker without waking it.
+			/// Item is executed when the worker finishes its current work or by other worker that steals it.
+			///
+			/// This method is thread-safe.</summary>
+			/// <param name="item">pointer to work item which should be queued.</param>
+			inline void GACALL QueueWork(GaWorkItem* item) { _queue.Push( item ); }
+
+			/// <summary><c>StealWork</c> method removes the oldest work item from the queue of the worker.
+			///
+			/// This method is thread-safe.</summary>
+			/// <returns>Method returns pointer to stolen work item or <c>NULL</c> if the queue is empty.</returns>
+			inline GaWorkItem* GACALL StealWork()
+			{
+				GaWorkItem* item = NULL;
+				_queue.Steal( item );
+				return item;
+			}
+
 			/// <summary><c>Close</c> method marks thread as clased.
 			///
 			/// This mehtod is not thread-safe.</summary>
@@ -220,6 +395,11 @@ namespace Common
 			static ThreadFunctionReturn GACALL WorkerWrapper(GaThread* thread,
 				void* params);
 
+			/// <summary><c>ExecuteWork</c> method executes single work item and handles exceptions raised by the item.</summary>
+			/// <param name="item">pointer to work item that should be executed.</param>
+			GAL_API
+			void GACALL ExecuteWork(GaWorkItem* item);
+
 		};
 
 		class GaWorkItem;
@@ -857,7 +1037,9 @@ namespace Common
 			}
 
 			/// <summary><c>ExecuteWork</c> method creates copy of user's work item object (copy is created using <c>MakeCopy</c> method) and creates bound result object.
-			/// Then it assigns the item to available thread, or if there is no available threads it creates new.
+			/// Then it assigns the item to available thread, or if there is no available threads it creates new. If the method is called by worker thread
+			/// of this pool, the item is pushed to the queue of the calling worker, and available thread is woken to steal it, so the item can be executed
+			/// by the calling worker without thread switch if it finishes its current work first.
 			///
 			/// This method is thread-safe.</summary>
 			/// <param name="workItem">pointer to object of work item whose copy is queued.</param>
@@ -21,6 +21,148 @@ namespace Common
 		// Pointer to global instance of the event object pool
 		GaEventPool* GaEventPool::_instance = NULL;
 
+		// System slot that stores tables of threads
+		SysTlsObject GaThreadLocalSlot::_tables;
+
+		// Manages entries that thread-local slots own in tables of threads
+		class GaThreadLocalRegistry
+		{
+
+		private:
+
+			// system slot that stores tables of threads
+			SysTlsObject& _tables;
+
+			// entries released by destroyed slots
+			std::vector<int> _freeIndices;
+
+			// the first entry that has never been used
+			int _nextIndex;
+
+			// key of the next slot
+			unsigned long long _nextKey;
+
+			// protects entries and keys
+			GA_DECLARE_SPINLOCK( _lock );
+
+		public:
+
+			// Allocates system slot that stores tables of threads
+			GaThreadLocalRegistry(SysTlsObject& tables) : _tables(tables),
+				_nextIndex(0),
+				_nextKey(1)
+			{
+				#if defined(GAL_PLATFORM_WIN)
+
+				// fiber-local storage is used because it frees tables when threads exit
+				_tables = FlsAlloc( DeleteTable );
+				GA_SYS_ASSERT( _tables != FLS_OUT_OF_INDEXES, "Threading" );
+
+				#elif defined(GAL_PLATFORM_NIX)
+
+				int error = pthread_key_create( &_tables, DeleteTable );
+				GA_SYS_ASSERT_CODE( error, "Threading" );
+
+				#endif
+			}
+
+			// Frees system slot
+			~GaThreadLocalRegistry()
+			{
+				#if defined(GAL_PLATFORM_WIN)
+
+				// frees tables of all threads
+				FlsFree( _tables );
+
+				#elif defined(GAL_PLATFORM_NIX)
+
+				delete (GaThreadLocalTable*)pthread_getspecific( _tables );
+				pthread_key_delete( _tables );
+
+				#endif
+			}
+
+			// Reserves entry and key for new slot
+			void Reserve(int& index,
+				unsigned long long& key)
+			{
+				GA_LOCK( _lock );
+
+				if( _freeIndices.empty() )
+					index = _nextIndex++;
+				else
+				{
+					index = _freeIndices.back();
+					_freeIndices.pop_back();
+				}
+
+				key = _nextKey++;
+
+				GA_UNLOCK( _lock );
+			}
+
+			// Releases entry of destroyed slot
+			void Release(int index)
+			{
+				GA_LOCK( _lock );
+				_freeIndices.push_back( index );
+				GA_UNLOCK( _lock );
+			}
+
+		private:
+
+			#if defined(GAL_PLATFORM_WIN)
+
+			// Frees table of exiting thread
+			static void WINAPI DeleteTable(void* table) { delete (GaThreadLocalTable*)table; }
+
+			#elif defined(GAL_PLATFORM_NIX)
+
+			// Frees table of exiting thread
+			static void DeleteTable(void* table) { delete (GaThreadLocalTable*)table; }
+
+			#endif
+
+		};
+
+		// Returns registry of thread-local slots. Registry is made by the first slot, so it outlives slots of static objects.
+		static GaThreadLocalRegistry& GaGetThreadLocalRegistry(SysTlsObject& tables)
+		{
+			static GaThreadLocalRegistry registry( tables );
+			return registry;
+		}
+
+		// Reserves entry in tables of threads
+		GaThreadLocalSlot::GaThreadLocalSlot() { GaGetThreadLocalRegistry( _tables ).Reserve( _index, _key ); }
+
+		// Releases entry
+		GaThreadLocalSlot::~GaThreadLocalSlot() { GaGetThreadLocalRegistry( _tables ).Release( _index ); }
+
+		// Makes or expands table of the calling thread
+		GaThreadLocalEntry& GaThreadLocalSlot::MakeEntry()
+		{
+			GaThreadLocalTable* table = GetTable();
+			if( !table )
+			{
+				table = new GaThreadLocalTable();
+
+				#if defined(GAL_PLATFORM_WIN)
+
+				FlsSetValue( _tables, table );
+
+				#elif defined(GAL_PLATFORM_NIX)
+
+				pthread_setspecific( _tables, table );
+
+				#endif
+			}
+
+			if( _index >= (int)table->size() )
+				table->resize( _index + 1 );
+
+			return ( *table )[ _index ];
+		}
+
 		// Initialize thread parameters
 		GaThread::GaThread(const GaThreadStartInfo& parameters,
 			bool started) : _objectDestroyed(NULL)
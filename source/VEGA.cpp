@@ -56,6 +56,7 @@ namespace Multiobjective
 
 				// mark population as rescaled
 				population.GetFlags().SetFlags( Population::GaPopulation::GAPF_COMPLETE_SCALED_FITNESS_UPDATE );
+				population.MarkModified();
 			}
 
 			// update operation time statistics
@@ -511,13 +511,17 @@ namespace Common
 			_data(GADSL_BRANCH, _branchGroup->GetWorkflow()->GetGlobalData(), _branchGroup->GetWorkflow()->GetWorkflowData(), _branchGroup->GetData()),
 			_previousStep(NULL),
 			_lastDecision(-1),
-			_executingLastStep(false) { }
+			_executingLastStep(false),
+			_stepCounter(0),
+			_splitCounter(0),
+			_randomEpoch(0) { }
 
 		// Executes steps
 		void GaBranch::BranchFlow(GaFlowStep* firstStep)
 		{
 			_previousStep = NULL;
 			_executingLastStep = false;
+			_stepCounter = 0;
 
 			// get step by step, exit loop when there is no next step
 			for( GaFlowStep* step = firstStep; step; step = step->GetNextStep( this ) )
@@ -526,6 +530,12 @@ namespace Common
 				if( !_branchGroup->GetWorkflow()->CheckWorkflowState() )
 					break;
 
+				// random numbers generated by the step outside of its workload are mapped to substream of the step,
+				// so they do not depend on number of branches that execute the step
+				_splitCounter = 0;
+				_randomEpoch = (unsigned long long)++_stepCounter << 32;
+				SelectRandomSubstream( _randomEpoch, GARSD_STEP, 0 );
+
 				// execute step
 				if( step->Enter( this ) )
 				{
@@ -567,6 +577,9 @@ namespace Common
 			else
 				branchCount = _branchGroup->GetBranchCount();
 
+			// each distribution of workload maps to its own epoch of random substreams
+			_randomEpoch = ( (unsigned long long)_stepCounter << 32 ) | (unsigned int)++_splitCounter;
+
 			// branch should execute work?
 			if( branchID >= 0 )
 			{
@@ -597,6 +610,9 @@ namespace Common
 			else
 				branchCount = _branchGroup->GetBranchCount();
 
+			// each distribution of workload maps to its own epoch of random substreams
+			_randomEpoch = ( (unsigned long long)_stepCounter << 32 ) | (unsigned int)++_splitCounter;
+
 			// branch should execute work?
 			if( branchID >= 0 )
 			{
@@ -611,9 +627,165 @@ namespace Common
 				branchWork = branchStart = 0;
 		}
 
+		// Finds or initializes cursor for the operation
+		int GaWorkDistributor::Enter(unsigned long long key,
+			const void* data,
+			int start)
+		{
+			// operations are mapped to cursors by their keys and objects,
+			// bits are mixed so executions that differ only in high bits of the key do not share the cursor
+			unsigned long long hash = key ^ (unsigned long long)(size_t)data;
+			hash = ( hash ^ ( hash >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+			hash = ( hash ^ ( hash >> 27 ) ) * 0x94D049BB133111EBULL;
+			hash ^= hash >> 31;
+			int id = (int)( hash % CURSOR_COUNT );
+			GaCursor& cursor = _cursors[ id ];
+
+			for( bool entered = false; ; Threading::GaYieldThread() )
+			{
+				GA_LOCK( cursor._lock );
+
+				// the first branch that enters the operation initializes cursor
+				if( !cursor._used )
+				{
+					cursor._used = true;
+					cursor._key = key;
+					cursor._data = data;
+					cursor._next = start;
+					cursor._departed = 0;
+				}
+
+				// wait for another operation to release the cursor
+				entered = cursor._key == key && cursor._data == data;
+
+				GA_UNLOCK( cursor._lock );
+
+				if( entered )
+					return id;
+			}
+		}
+
+		// Claims chunk whose size depends on number of unclaimed items
+		bool GaWorkDistributor::ClaimGuided(int cursor,
+			int end,
+			int branchCount,
+			int minChunkSize,
+			int& start,
+			int& count)
+		{
+			if( minChunkSize < 1 )
+				minChunkSize = 1;
+
+			volatile int* next = &_cursors[ cursor ]._next;
+			do
+			{
+				start = *next;
+				if( start >= end )
+					return false;
+
+				// claim half of the items that would be assigned to the branch if unclaimed items were distributed equally
+				count = ( end - start ) / ( 2 * branchCount );
+				if( count < minChunkSize )
+					count = minChunkSize;
+				if( count > end - start )
+					count = end - start;
+
+			} while( !Threading::GaAtomicOps<int>::CmpXchg( next, start, start + count ) );
+
+			return true;
+		}
+
+		// Notifies cursor that the branch has left the operation
+		void GaWorkDistributor::Exit(int cursor,
+			int branchCount)
+		{
+			// the last branch releases the cursor
+			if( ++_cursors[ cursor ]._departed == branchCount )
+			{
+				GA_LOCK( _cursors[ cursor ]._lock );
+				_cursors[ cursor ]._used = false;
+				GA_UNLOCK( _cursors[ cursor ]._lock );
+			}
+		}
+
+		/// <summary><c>GaWorkChunkMatch</c> class accepts chunks that belong to specified execution of an operation.</summary>
+		class GaWorkChunkMatch
+		{
+
+		private:
+
+			/// <summary>Key of the operation execution.</summary>
+			unsigned long long _key;
+
+			/// <summary>Pointer to object on which the operation is performed.</summary>
+			const void* _data;
+
+		public:
+
+			/// <summary>Initializes predicate.</summary>
+			/// <param name="key">key of the operation execution.</param>
+			/// <param name="data">pointer to object on which the operation is performed.</param>
+			GaWorkChunkMatch(unsigned long long key,
+				const void* data) : _key(key),
+				_data(data) { }
+
+			/// <summary><c>operator ()</c> checks whether the chunk belongs to the execution of the operation.</summary>
+			/// <param name="chunk">chunk that should be checked.</param>
+			/// <returns>Operator returns <c>true</c> if the chunk belongs to the execution of the operation.</returns>
+			inline bool GACALL operator ()(const GaWorkChunk& chunk) const { return chunk._key == _key && chunk._data == _data; }
+
+		};
+
+		// Splits workload of the branch into chunks and queues them
+		void GaBranch::QueueWork(unsigned long long key,
+			const void* data,
+			int start,
+			int count,
+			int chunkSize)
+		{
+			if( chunkSize < 1 )
+				chunkSize = 1;
+
+			// chunks at the beginning of the workload are stolen first, while the branch processes chunks from the end
+			for( int end = start + count; start < end; start += chunkSize )
+				_workQueue.Push( GaWorkChunk( key, data, start, end - start < chunkSize ? end - start : chunkSize ) );
+		}
+
+		// Takes next chunk of workload or steals one from other branches
+		bool GaBranch::GetQueuedWork(unsigned long long key,
+			const void* data,
+			int& start,
+			int& count)
+		{
+			GaWorkChunk chunk;
+			bool found = _workQueue.Pop( chunk );
+
+			// only branches that participate in the workload distribution can steal work
+			if( !found && GetFilteredID() >= 0 )
+			{
+				GaWorkChunkMatch match( key, data );
+
+				// search for work starting from the next branch, to spread contention among queues
+				int branchCount = _branchGroup->GetBranchCount();
+				for( int i = 1; i < branchCount && !found; i++ )
+					found = _branchGroup->GetBranch( ( _branchID + i ) % branchCount )->_workQueue.Steal( chunk, match );
+			}
+
+			if( found )
+			{
+				start = chunk._start;
+				count = chunk._count;
+			}
+
+			return found;
+		}
+
 		// Returns barrier that should be used for synchonizing branches
 		Threading::GaBarrier& GaBranch::GetBarrier() { return _currentFilter && _currentFilter->IsActive() ? _currentFilter->GetBarrier() : _branchGroup->GetBarrier(); }
 
+		// Returns cursors used for claiming workload dynamically
+		GaWorkDistributor& GaBranch::GetWorkDistributor() { return _currentFilter && _currentFilter->IsActive() ? _currentFilter->GetWorkDistributor() : _branchGroup->GetWorkDistributor(); }
+
 		// Returns number of branches that must reach barrier
 		int GaBranch::GetBarrierCount() const { return _currentFilter ? _currentFilter->GetBranchCount() : _branchGroup->GetBranchCount(); }
 
@@ -20,6 +20,7 @@
 #include "Flags.h"
 #include "ThreadPool.h"
 #include "Barrier.h"
+#include "Random.h"
 #include "SmartPtr.h"
 #include "Observing.h"
 
@@ -1238,6 +1239,121 @@ namespace Common
 
 		};
 
+		/// <summary><c>GaWorkDistributor</c> class provides shared cursors that branches use to claim chunks of workload of parallel operations dynamically.
+		/// Each parallel operation that is currently executed by the branches occupies one cursor which is identified by key of the execution
+		/// (see <see cref="GaParallelExec::NextWorkKey" />). Cursor is released when all branches leave the operation, so branches that run ahead of the others
+		/// can start next operation while slower branches are still finishing previous one.
+		///
+		/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class,
+		/// but all public methods are thread-safe.</summary>
+		class GaWorkDistributor
+		{
+
+		public:
+
+			/// <summary>Number of operations that can be executed at the same time.</summary>
+			static const int CURSOR_COUNT = 4;
+
+		private:
+
+			/// <summary><c>GaCursor</c> structure stores state of the shared cursor for single operation.</summary>
+			struct GaCursor
+			{
+
+				GA_DECLARE_SPINLOCK( _lock );
+
+				/// <summary>Indicates whether the cursor is occupied by an operation.</summary>
+				bool _used;
+
+				/// <summary>Key of the operation execution that occupies the cursor.</summary>
+				unsigned long long _key;
+
+				/// <summary>Pointer to object on which the operation is performed.</summary>
+				const void* _data;
+
+				/// <summary>Index of the next item that has not been claimed.</summary>
+				volatile int _next;
+
+				/// <summary>Number of branches that have left the operation.</summary>
+				Threading::GaAtomic<int> _departed;
+
+				/// <summary>Initializes unused cursor.</summary>
+				GaCursor() : _used(false),
+					_key(0),
+					_data(NULL),
+					_next(0) { }
+
+			};
+
+			/// <summary>Cursors for operations.</summary>
+			GaCursor _cursors[ CURSOR_COUNT ];
+
+		public:
+
+			/// <summary><c>Enter</c> method finds cursor for the operation, or initializes new one if the calling branch is the first to enter the operation.
+			/// If the cursor is occupied by another operation, the method waits for it to be released.
+			///
+			/// This method is thread-safe.</summary>
+			/// <param name="key">key of the operation execution.</param>
+			/// <param name="data">pointer to object on which the operation is performed.</param>
+			/// <param name="start">index of the first item of the workload.</param>
+			/// <returns>Method returns ID of the cursor that is used by the operation.</returns>
+			GAL_API
+			int GACALL Enter(unsigned long long key,
+				const void* data,
+				int start);
+
+			/// <summary><c>Claim</c> method claims chunk of fixed size.
+			///
+			/// This method is thread-safe.</summary>
+			/// <param name="cursor">ID of the cursor returned by <see cref="Enter" /> method.</param>
+			/// <param name="end">index of the item that follows the last item of the workload.</param>
+			/// <param name="chunkSize">number of items that should be claimed.</param>
+			/// <param name="start">reference to variable that will store index of the first claimed item.</param>
+			/// <param name="count">reference to variable that will store number of claimed items.</param>
+			/// <returns>Method returns <c>false</c> if there are no more items to claim.</returns>
+			inline bool GACALL Claim(int cursor,
+				int end,
+				int chunkSize,
+				int& start,
+				int& count)
+			{
+				start = Threading::GaAtomicOps<int>::Add( &_cursors[ cursor ]._next, chunkSize );
+				count = end - start < chunkSize ? end - start : chunkSize;
+
+				return count > 0;
+			}
+
+			/// <summary><c>ClaimGuided</c> method claims chunk whose size is proportional to number of unclaimed items divided among the branches.
+			///
+			/// This method is thread-safe.</summary>
+			/// <param name="cursor">ID of the cursor returned by <see cref="Enter" /> method.</param>
+			/// <param name="end">index of the item that follows the last item of the workload.</param>
+			/// <param name="branchCount">number of branches that execute the operation.</param>
+			/// <param name="minChunkSize">minimal number of items that should be claimed.</param>
+			/// <param name="start">reference to variable that will store index of the first claimed item.</param>
+			/// <param name="count">reference to variable that will store number of claimed items.</param>
+			/// <returns>Method returns <c>false</c> if there are no more items to claim.</returns>
+			GAL_API
+			bool GACALL ClaimGuided(int cursor,
+				int end,
+				int branchCount,
+				int minChunkSize,
+				int& start,
+				int& count);
+
+			/// <summary><c>Exit</c> method notifies cursor that the calling branch has left the operation.
+			/// Cursor is released when all branches leave the operation.
+			///
+			/// This method is thread-safe.</summary>
+			/// <param name="cursor">ID of the cursor returned by <see cref="Enter" /> method.</param>
+			/// <param name="branchCount">number of branches that execute the operation.</param>
+			GAL_API
+			void GACALL Exit(int cursor,
+				int branchCount);
+
+		};
+
 		/// <summary><c>GaBranchFilter</c> class in addition <c>GaBranchFilterInfo</c> class provides synchronization object for allowed branched.
 		///
 		/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
@@ -1250,6 +1366,9 @@ namespace Common
 			/// <summary>Barrier for synchronization of branches allowed by the filter.</summary>
 			mutable Common::Threading::GaBarrier _barrier;
 
+			/// <summary>Cursors that branches allowed by the filter use to claim workload dynamically.</summary>
+			mutable GaWorkDistributor _workDistributor;
+
 		public:
 
 			/// <summary><c>SetInfo</c> method sets branch information of the filter.
@@ -1262,6 +1381,69 @@ namespace Common
 			/// <returns>Method returns barrier that can be used for synchronization of allowed branches.</returns>
 			inline Common::Threading::GaBarrier& GACALL GetBarrier() const { return _barrier; }
 
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns cursors that allowed branches use to claim workload dynamically.</returns>
+			inline GaWorkDistributor& GACALL GetWorkDistributor() const { return _workDistributor; }
+
+		};
+
+		/// <summary><c>GaWorkChunk</c> structure represents chunk of workload that is queued by a branch and that can be processed
+		/// by any branch of the group which performs the same parallel operation.</summary>
+		struct GaWorkChunk
+		{
+
+		public:
+
+			/// <summary>Key that identifies execution of the operation to which the chunk belongs (see <see cref="GaParallelExec::NextWorkKey" />).</summary>
+			unsigned long long _key;
+
+			/// <summary>Pointer to object on which the operation is performed.</summary>
+			const void* _data;
+
+			/// <summary>Index of the first item in the chunk.</summary>
+			int _start;
+
+			/// <summary>Number of items in the chunk.</summary>
+			int _count;
+
+			/// <summary>This constructor initializes empty chunk.</summary>
+			GaWorkChunk() : _key(0),
+				_data(NULL),
+				_start(0),
+				_count(0) { }
+
+			/// <summary>This constructor initializes chunk with its key and range.</summary>
+			/// <param name="key">key that identifies execution of the operation to which the chunk belongs.</param>
+			/// <param name="data">pointer to object on which the operation is performed.</param>
+			/// <param name="start">index of the first item in the chunk.</param>
+			/// <param name="count">number of items in the chunk.</param>
+			GaWorkChunk(unsigned long long key,
+				const void* data,
+				int start,
+				int count) : _key(key),
+				_data(data),
+				_start(start),
+				_count(count) { }
+
+		};
+
+		/// <summary>This enumeration defines domains of keys that identify random substreams within single epoch.
+		/// Keys that belong to different domains never map to the same substream.</summary>
+		enum GaRandomSubstreamDomain
+		{
+			/// <summary>substreams of single items of the workload.</summary>
+			GARSD_ITEM = 0,
+
+			/// <summary>substreams of pairs of items of the workload.</summary>
+			GARSD_PAIR,
+
+			/// <summary>substreams of steps used for random numbers generated outside of the workload. All branches that execute the step
+			/// share the substream, so work that is split among branches must select substreams of its items.</summary>
+			GARSD_STEP,
+
+			/// <summary>substreams used by work that single branch performs on behalf of all branches (i.e. bodies of barriers).</summary>
+			GARSD_SHARED
+
 		};
 
 		/// <summary><c>GaBranch</c> class represent branch. Each branch represent independent thread of execution of flow steps. Branches are executed as work items of thread pool.
@@ -1295,6 +1477,19 @@ namespace Common
 			/// <summary>Inidicates whether the branch executes its last step.</summary>
 			bool _executingLastStep;
 
+			/// <summary>Number of steps that branch has visited since it was started.
+			/// All branches of the group visit same steps, so the counter does not depend on number of branches.</summary>
+			int _stepCounter;
+
+			/// <summary>Number of workload distributions that branch has calculated in the current step.</summary>
+			int _splitCounter;
+
+			/// <summary>Epoch of random substreams that maps to the workload calculated by the last call to <see cref="SplitWork" /> method.</summary>
+			unsigned long long _randomEpoch;
+
+			/// <summary>Chunks of workload queued by this branch which other branches of the group can steal.</summary>
+			Threading::GaWorkStealingQueue<GaWorkChunk> _workQueue;
+
 		public:
 
 			/// <summary>This constructor initializes branch with information needed for starting the branch.</summary>
@@ -1332,6 +1527,93 @@ namespace Common
 				int& branchWork,
 				int& branchStart);
 
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns epoch of random substreams that maps to the workload calculated by the last call to <see cref="SplitWork" /> method.</returns>
+			inline unsigned long long GACALL GetRandomEpoch() const { return _randomEpoch; }
+
+			/// <summary><c>QueueWork</c> method splits workload of the branch into chunks and queues them, so other branches of the group
+			/// that perform the same operation can steal them when they run out of their own work.
+			///
+			/// This method is thread-safe.</summary>
+			/// <param name="key">key that identifies execution of the operation (see <see cref="GaParallelExec::NextWorkKey" />).</param>
+			/// <param name="data">pointer to object on which the operation is performed.</param>
+			/// <param name="start">index of the first item in the workload of the branch.</param>
+			/// <param name="count">number of items in the workload of the branch.</param>
+			/// <param name="chunkSize">maximal number of items in a single chunk.</param>
+			GAL_API
+			void GACALL QueueWork(unsigned long long key,
+				const void* data,
+				int start,
+				int count,
+				int chunkSize);
+
+			/// <summary><c>GetQueuedWork</c> method takes next chunk of workload queued by this branch. If there are no more chunks in the queue of this branch,
+			/// the method tries to steal chunk that belongs to the same execution of the operation from other branches of the group.
+			///
+			/// This method is thread-safe.</summary>
+			/// <param name="key">key that identifies execution of the operation (see <see cref="GaParallelExec::NextWorkKey" />).</param>
+			/// <param name="data">pointer to object on which the operation is performed.</param>
+			/// <param name="start">reference to variable that will store index of the first item in the chunk.</param>
+			/// <param name="count">reference to variable that will store number of items in the chunk.</param>
+			/// <returns>Method returns <c>false</c> if there are no more chunks that the branch can process.</returns>
+			GAL_API
+			bool GACALL GetQueuedWork(unsigned long long key,
+				const void* data,
+				int& start,
+				int& count);
+
+			/// <summary><c>SelectRandomSubstream</c> method selects substream of global random generator for the calling thread that is identified by
+			/// epoch and item of the workload. When global random generator works in deterministic mode, numbers generated for an item do not depend
+			/// on number of branches or on the branch that process the item. Call has no effect if the generator does not work in deterministic mode.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="epoch">epoch of the workload returned by <see cref="GetRandomEpoch" /> method.</param>
+			/// <param name="domain">domain of the substream key.</param>
+			/// <param name="index">index that identifies substream within the domain. Only the lower 62 bits are used.</param>
+			inline void GACALL SelectRandomSubstream(unsigned long long epoch,
+				GaRandomSubstreamDomain domain,
+				unsigned long long index)
+				{ Common::Random::GaRandomGenerator::GetInstance()->SelectSubstream( epoch, ( (unsigned long long)domain << 62 ) | ( index & 0x3FFFFFFFFFFFFFFFULL ) ); }
+
+			/// <summary><c>SelectRandomSubstream</c> method selects substream of global random generator for the calling thread that is identified by
+			/// epoch and global index of the item in the workload. See <see cref="SelectRandomSubstream" /> for more details.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="epoch">epoch of the workload returned by <see cref="GetRandomEpoch" /> method.</param>
+			/// <param name="item">index of the item in the workload.</param>
+			inline void GACALL SelectRandomSubstream(unsigned long long epoch,
+				int item) { SelectRandomSubstream( epoch, GARSD_ITEM, (unsigned int)item ); }
+
+			/// <summary><c>SelectRandomSubstream</c> method selects substream of global random generator for the calling thread that is identified by
+			/// epoch and pair of items of the workload. Keys of pairs do not collide with keys of single items. See <see cref="SelectRandomSubstream" />
+			/// for more details.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="epoch">epoch of the workload returned by <see cref="GetRandomEpoch" /> method.</param>
+			/// <param name="first">index of the first item of the pair.</param>
+			/// <param name="second">index of the second item of the pair.</param>
+			inline void GACALL SelectRandomSubstream(unsigned long long epoch,
+				int first,
+				int second)
+				{ SelectRandomSubstream( epoch, GARSD_PAIR, ( (unsigned long long)(unsigned int)first << 31 ) | (unsigned int)second ); }
+
+			/// <summary><c>SelectRandomSubstream</c> method selects substream of global random generator for the calling thread that is identified by
+			/// item of the workload calculated by the last call to <see cref="SplitWork" /> method. See <see cref="SelectRandomSubstream" /> for more details.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="item">index of the item in the workload.</param>
+			inline void GACALL SelectRandomSubstream(int item) { SelectRandomSubstream( _randomEpoch, item ); }
+
+			/// <summary><c>SelectSharedRandomSubstream</c> method selects substream of global random generator that should be used by work
+			/// which the branch performs on behalf of all branches, such as body of a barrier. Substream is identified only by the current step
+			/// and specified item, so generated numbers do not depend on the branch which performs the work. See <see cref="SelectRandomSubstream" />
+			/// for more details.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="item">index that distinguishes multiple pieces of shared work performed by the same step.</param>
+			inline void GACALL SelectSharedRandomSubstream(int item = 0)
+				{ SelectRandomSubstream( (unsigned long long)_stepCounter << 32, GARSD_SHARED, (unsigned int)item ); }
+
 			/// <summary>This method is not thread-safe.</summary>
 			/// <returns>Method returns reference to branch group which owns this branch.</returns>
 			inline GaBranchGroup& GACALL GetBranchGroup() { return *_branchGroup; }
@@ -1364,6 +1646,11 @@ namespace Common
 			GAL_API
 			int GACALL GetBarrierCount() const;
 
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns cursors that branches in the group that executes current flow step use to claim workload dynamically.</returns>
+			GAL_API
+			GaWorkDistributor& GACALL GetWorkDistributor();
+
 			/// <summary>This method is not thread-safe.</summary>
 			/// <returns>Method returns filtered ID of the branch if it is currently using filter of raw branch ID if the filter is not used.</returns>
 			GAL_API
@@ -1482,6 +1769,9 @@ namespace Common
 			/// <summary>Barrier that user can use to synchronize branches of the group.</summary>
 			Threading::GaBarrier _barrier;
 
+			/// <summary>Cursors that branches of the group use to claim workload dynamically.</summary>
+			GaWorkDistributor _workDistributor;
+
 		public:
 
 			/// <summary>This constructor creates group and its branches.</summary>
@@ -1558,6 +1848,16 @@ namespace Common
 			/// <returns>Method returns number of branches in the group.</returns>
 			inline int GACALL GetBranchCount() const { return (int)_branches.size(); }
 
+			/// <summary>This method is not thread-safe.</summary>
+			/// <param name="index">ID of the queried branch.</param>
+			/// <returns>Method returns pointer to branch with specified ID.</returns>
+			inline GaBranch* GACALL GetBranch(int index) { return _branches[ index ]; }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <param name="index">ID of the queried branch.</param>
+			/// <returns>Method returns pointer to branch with specified ID.</returns>
+			inline const GaBranch* GACALL GetBranch(int index) const { return _branches[ index ]; }
+
 			/// <summary>This method is not thread-safe.</summary>
 			/// <returns>Method returns pointer to flow that is executed by the branches of this group.</returns>
 			inline GaBranchGroupFlow* GACALL GetBranchGroupFlow() { return &_branchGroupFlow; }
@@ -1578,6 +1878,10 @@ namespace Common
 			/// <returns>Method returns pointer to barrier object that user can use to synchronize branches of the this group.</returns>
 			inline Threading::GaBarrier& GACALL GetBarrier() { return _barrier; }
 
+			/// <summary>This method is thread-safe.<summary>
+			/// <returns>Method returns cursors that branches of the group use to claim workload dynamically.</returns>
+			inline GaWorkDistributor& GACALL GetWorkDistributor() { return _workDistributor; }
+
 		protected:
 
 			/// <summary>For more details see specification of <see cref="GaFlowConnection::CheckConnectionValidity" /> method.
@@ -2863,6 +3167,28 @@ namespace Common
 
 		};
 
+		/// <summary>This enumeration defines how parallel operations distribute workload among branches.</summary>
+		enum GaParallelScheduling
+		{
+			/// <summary>each branch processes fixed range of items calculated by <see cref="GaBranch::SplitWork" /> method.</summary>
+			GAPS_STATIC = 0,
+
+			/// <summary>each branch splits its range of items into chunks and queues them. When a branch runs out of its chunks,
+			/// it steals chunks queued by other branches, so the workload is rebalanced when cost of items varies.</summary>
+			GAPS_WORK_STEALING,
+
+			/// <summary>branches claim chunks of fixed size from shared cursor until all items are processed.
+			/// Operations over pairs of items split the upper triangle of pairs into square tiles that branches claim one by one.
+			/// All branches that participate in workload distribution must execute the operation.</summary>
+			GAPS_DYNAMIC,
+
+			/// <summary>branches claim chunks from shared cursor whose size decreases as the number of unclaimed items decreases.
+			/// Operations over pairs of items claim tiles of pairs in the same way.
+			/// All branches that participate in workload distribution must execute the operation.</summary>
+			GAPS_GUIDED
+
+		};
+
 		/// <summary><c>GaParallelExec</c> is base class for parallel execution of operations.
 		///
 		/// This class has no built-in synchronizator, so <c>GA_LOCK_OBJECT</c> and <c>GA_LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class,
@@ -2875,11 +3201,45 @@ namespace Common
 			/// <summary>Reference to branch that executes operation.</summary>
 			GaBranch& _branch;
 
+			/// <summary>Method used for distributing workload among branches.</summary>
+			GaParallelScheduling _scheduling;
+
+			/// <summary>Maximal number of items in a chunk of workload. If this value is 0, size of chunks is calculated from size of workload.</summary>
+			int _chunkSize;
+
+			/// <summary>Number of keys generated for executions of the operation.</summary>
+			int _executionCount;
+
 		public:
 
 			/// <summary>Initializes parallel operation.</summary>
 			/// <param name="branch">reference to branch that executes operation.</param>
-			GaParallelExec(GaBranch& branch) : _branch(branch) { }
+			GaParallelExec(GaBranch& branch) : _branch(branch),
+				_scheduling(GAPS_STATIC),
+				_chunkSize(0),
+				_executionCount(0) { }
+
+			/// <summary><c>SetScheduling</c> method sets method used for distributing workload among branches.
+			/// All branches that execute the operation should use the same method.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="scheduling">method used for distributing workload.</param>
+			/// <param name="chunkSize">maximal number of items in a chunk of workload. If this parameter is 0, size of chunks is calculated from size of workload.
+			/// Operations over pairs of items that use dynamic or guided scheduling interpret this parameter as number of items along each side of a tile.</param>
+			inline void GACALL SetScheduling(GaParallelScheduling scheduling,
+				int chunkSize = 0)
+			{
+				_scheduling = scheduling;
+				_chunkSize = chunkSize;
+			}
+
+			/// <summary>This method is thread-safe.</summary>
+			/// <returns>Method returns method used for distributing workload among branches.</returns>
+			inline GaParallelScheduling GACALL GetScheduling() const { return _scheduling; }
+
+			/// <summary>This method is thread-safe.</summary>
+			/// <returns>Method returns maximal number of items in a chunk of workload.</returns>
+			inline int GACALL GetChunkSize() const { return _chunkSize; }
 
 			/// <summary>This method is thread-safe.</summary>
 			/// <returns>Method returns reference to branch that executes operation.</returns>
@@ -2894,6 +3254,25 @@ namespace Common
 			/// <summary><c>Sync</c> method synchronize all branches at execute operation.</summary>
 			inline void GACALL Sync() { _branch.GetBarrier().Enter( true, _branch.GetBarrierCount() ); }
 
+			/// <summary><c>NextWorkKey</c> method generates key that identifies the next execution of the operation and which is same for all branches.
+			/// Key combines epoch of the workload distribution with number of executions, so the same operation object can be executed more then once
+			/// without recalculating workload distribution, while branches that run ahead cannot take work of previous executions.</summary>
+			/// <param name="epoch">epoch of the workload distribution.</param>
+			/// <returns>Method returns key of the next execution.</returns>
+			inline unsigned long long GACALL NextWorkKey(unsigned long long epoch) { return epoch ^ ( (unsigned long long)_executionCount++ << 48 ); }
+
+			/// <summary><c>CalculateChunkSize</c> method calculates number of items in chunks of workload for work-stealing scheduling.</summary>
+			/// <param name="branchWork">size of workload assigned to the branch.</param>
+			/// <returns>Method returns number of items in chunks of workload.</returns>
+			inline int GACALL CalculateChunkSize(int branchWork) const
+			{
+				// by default each branch splits its workload into eight chunks
+				if( _chunkSize > 0 )
+					return _chunkSize;
+
+				return branchWork > 8 ? branchWork / 8 : 1;
+			}
+
 		};
 
 		/// <summary><c>GaDefaultItemProvider</c> template represents default work provider of items from storage object used by parallel operations.
@@ -3105,6 +3484,12 @@ namespace Common
 			/// <summary>Number of items that branch should process.</summary>
 			int _branchCount;
 
+			/// <summary>Number of items that all branches should process.</summary>
+			int _totalCount;
+
+			/// <summary>Epoch of random substreams that maps to the workload of the branch.</summary>
+			unsigned long long _randomEpoch;
+
 		public:
 
 			/// <summary>Initializes parallel operation with storage object and accessor.</summary>
@@ -3126,9 +3511,36 @@ namespace Common
 			void GACALL Execute(OPERATION& operation,
 				bool syncOnEnd)
 			{
-				// perform operation on items in the strage
-				for( int i = _branchStart + _branchCount - 1; i >= _branchStart; i-- )
-					operation( _provider( _storage, i ), i );
+				if( _scheduling == GAPS_WORK_STEALING )
+				{
+					// queue workload of the branch and process it along with chunks stolen from other branches
+					unsigned long long key = NextWorkKey( _randomEpoch );
+					_branch.QueueWork( key, &_storage, _branchStart, _branchCount, CalculateChunkSize( _branchCount ) );
+					for( int start, count; _branch.GetQueuedWork( key, &_storage, start, count ); )
+						ExecuteRange( operation, start, count );
+				}
+				else if( ( _scheduling == GAPS_DYNAMIC || _scheduling == GAPS_GUIDED ) && _branch.GetFilteredID() >= 0 )
+				{
+					GaWorkDistributor& distributor = _branch.GetWorkDistributor();
+					int branchCount = _branch.GetBarrierCount(), begin = _provider.GetStart(), end = begin + _totalCount;
+
+					// claim chunks from shared cursor until all items are processed
+					int cursor = distributor.Enter( NextWorkKey( _randomEpoch ), &_storage, begin );
+					if( _scheduling == GAPS_DYNAMIC )
+					{
+						for( int start, count, size = CalculateChunkSize( _totalCount / branchCount ); distributor.Claim( cursor, end, size, start, count ); )
+							ExecuteRange( operation, start, count );
+					}
+					else
+					{
+						for( int start, count; distributor.ClaimGuided( cursor, end, branchCount, _chunkSize, start, count ); )
+							ExecuteRange( operation, start, count );
+					}
+
+					distributor.Exit( cursor, branchCount );
+				}
+				else
+					ExecuteRange( operation, _branchStart, _branchCount );
 
 				// synchronize branches if needed
 				if( syncOnEnd )
@@ -3140,8 +3552,30 @@ namespace Common
 			/// This method is not thread-safe.</summary>
 			inline void GACALL Update()
 			{
-				_branch.SplitWork( _provider.GetCount( _storage ), _branchCount, _branchStart );
+				_totalCount = _provider.GetCount( _storage );
+				_branch.SplitWork( _totalCount, _branchCount, _branchStart );
 				_branchStart += _provider.GetStart();
+				_randomEpoch = _branch.GetRandomEpoch();
+			}
+
+		private:
+
+			/// <summary><c>ExecuteRange</c> method executes specified operation over range of items in the storage.</summary>
+			/// <typeparam name="OPERATION">type of the operation performed.</typeparam>
+			/// <param name="operation">operation that is performed.</param>
+			/// <param name="start">index of the first item in the range.</param>
+			/// <param name="count">number of items in the range.</param>
+			template<typename OPERATION>
+			inline void GACALL ExecuteRange(OPERATION& operation,
+				int start,
+				int count)
+			{
+				// perform operation on items in the strage
+				for( int i = start + count - 1; i >= start; i-- )
+				{
+					_branch.SelectRandomSubstream( _randomEpoch, i );
+					operation( _provider( _storage, i ), i );
+				}
 			}
 
 		};
@@ -3170,8 +3604,21 @@ namespace Common
 			/// <summary>Number of pairs that should be processed by the branch.</summary>
 			int _branchCount;
 
+			/// <summary>Index of the first pair that should be processed by the branch in the linear order of all pairs.</summary>
+			int _branchPairStart;
+
+			/// <summary>Number of items that form pairs.</summary>
+			int _itemCount;
+
+			/// <summary>Epoch of random substreams that maps to the workload of the branch.</summary>
+			unsigned long long _randomEpoch;
+
 		public:
 
+			/// <summary>Default number of items along each side of the tile when pairs are claimed dynamically.
+			/// Tile of this size keeps both rows of items that form pairs in the cache during its processing.</summary>
+			static const int DEFAULT_TILE_SIZE = 64;
+
 			/// <summary>Initializes parallel operation with storage object and accessor.</summary>
 			/// <param name="branch">reference to branch that executes operation.</param>
 			/// <param name="storage">storage object on which the operations are performed.</param>
@@ -3195,24 +3642,21 @@ namespace Common
 				OPERATION2& operation2,
 				bool syncOnEnd)
 			{
-				// perform operation on pair of items in the strage
-				int i = _branchStart[ 0 ];
-				for( int j = _branchStart[ 1 ], count = _branchCount; count; j = ( ++i ) + 1 )
+				if( ( _scheduling == GAPS_DYNAMIC || _scheduling == GAPS_GUIDED ) && _branch.GetFilteredID() >= 0 )
+					ExecuteTiles( operation1, operation2 );
+				else if( _scheduling == GAPS_WORK_STEALING && _branchCount > 0 )
 				{
-					GaItem& item1 = _provider( _storage, i );
-
-					// perform operation on the first item of the pair
-					if( j == i + 1 )
-						operation1( item1, i );
-
-					// perform operation on the pair of items
-					for( ; j < _storageSize && count; j++, count-- )
-						operation2( item1, _provider( _storage, j ), i, j );
+					// queue workload of the branch and process it along with chunks stolen from other branches
+					unsigned long long key = NextWorkKey( _randomEpoch );
+					_branch.QueueWork( key, &_storage, _branchPairStart, _branchCount, CalculateChunkSize( _branchCount ) );
+					for( int start, count, i, j; _branch.GetQueuedWork( key, &_storage, start, count ); )
+					{
+						GetPair( start, i, j );
+						ExecuteRange( operation1, operation2, i, j, count );
+					}
 				}
-
-				// perform operation on the last item
-				if( i == _storageSize - 1 )
-					operation1( _provider( _storage, i ), i );
+				else
+					ExecuteRange( operation1, operation2, _branchStart[ 0 ], _branchStart[ 1 ], _branchCount );
 
 				// synchronize branches if needed
 				if( syncOnEnd )
@@ -3236,9 +3680,11 @@ namespace Common
 			void GACALL Update()
 			{
 				// calculate number of items that branch should process
-				_storageSize = _provider.GetCount( _storage );
+				_itemCount = _storageSize = _provider.GetCount( _storage );
 				int start, size = _storageSize - 1;
 				_branch.SplitWork( ( size * ( size + 1 ) ) / 2, _branchCount, start );
+				_branchPairStart = start;
+				_randomEpoch = _branch.GetRandomEpoch();
 
 				if( _branchCount > 0 )
 				{
@@ -3261,6 +3707,148 @@ namespace Common
 					_storageSize = _branchStart[ 0 ] = _branchStart[ 1 ] = -1;
 			}
 
+		private:
+
+			/// <summary><c>ExecuteRange</c> method executes operations over range of pairs. Operation on the first item of a pair is executed
+			/// when the range contains the first pair in which the item appears as the first item.</summary>
+			/// <typeparam name="OPERATION1">type of operation that should be performed only on the first items of pairs.</typeparam>
+			/// <typeparam name="OPERATION2">type of operation that should be performed pairs of items.</typeparam>
+			/// <param name="operation1">operation that should be performed on the first items on the pairs.</param>
+			/// <param name="operation2">operation that should be performed on pairs.</param>
+			/// <param name="i">index of the first item of the first pair in the range.</param>
+			/// <param name="j">index of the second item of the first pair in the range.</param>
+			/// <param name="count">number of pairs in the range.</param>
+			template<typename OPERATION1,
+				typename OPERATION2>
+			void GACALL ExecuteRange(OPERATION1& operation1,
+				OPERATION2& operation2,
+				int i,
+				int j,
+				int count)
+			{
+				// perform operation on pair of items in the strage
+				for( ; count; j = ( ++i ) + 1 )
+				{
+					GaItem& item1 = _provider( _storage, i );
+
+					// perform operation on the first item of the pair
+					if( j == i + 1 )
+					{
+						_branch.SelectRandomSubstream( _randomEpoch, i );
+						operation1( item1, i );
+					}
+
+					// perform operation on the pair of items
+					for( ; j < _storageSize && count; j++, count-- )
+					{
+						_branch.SelectRandomSubstream( _randomEpoch, i, j );
+						operation2( item1, _provider( _storage, j ), i, j );
+					}
+				}
+
+				// perform operation on the last item
+				if( i == _storageSize - 1 )
+				{
+					_branch.SelectRandomSubstream( _randomEpoch, i );
+					operation1( _provider( _storage, i ), i );
+				}
+			}
+
+			/// <summary><c>ExecuteTiles</c> method splits upper triangle of pairs into square tiles and claims them from shared cursor.
+			/// Operation on single item is performed by the branch that processes the tile on the diagonal which contains the item,
+			/// just before the pairs in which the item is the first item. As with other scheduling methods, the operation is not ordered
+			/// with respect to pairs of the same item processed by other branches.</summary>
+			/// <typeparam name="OPERATION1">type of operation that should be performed only on the first items of pairs.</typeparam>
+			/// <typeparam name="OPERATION2">type of operation that should be performed pairs of items.</typeparam>
+			/// <param name="operation1">operation that should be performed on the first items on the pairs.</param>
+			/// <param name="operation2">operation that should be performed on pairs.</param>
+			template<typename OPERATION1,
+				typename OPERATION2>
+			void GACALL ExecuteTiles(OPERATION1& operation1,
+				OPERATION2& operation2)
+			{
+				GaWorkDistributor& distributor = _branch.GetWorkDistributor();
+				int branchCount = _branch.GetBarrierCount(), first = _provider.GetStart(), end = first + _itemCount;
+
+				int tileSize = _chunkSize > 0 ? _chunkSize : DEFAULT_TILE_SIZE;
+				int tileRows = ( _itemCount + tileSize - 1 ) / tileSize;
+
+				// perform operation on pairs of items in tiles
+				int cursor = distributor.Enter( NextWorkKey( _randomEpoch ), &_storage, 0 );
+				for( int start, count; ClaimWork( distributor, cursor, tileRows * ( tileRows + 1 ) / 2, branchCount, 1, start, count ); )
+				{
+					for( int tile = start; count; tile++, count-- )
+					{
+						// find row and column of the tile
+						int row = 0, column = tile;
+						for( ; column >= tileRows - row; row++ )
+							column -= tileRows - row;
+						column += row;
+
+						int rowEnd = first + ( row + 1 ) * tileSize, columnEnd = first + ( column + 1 ) * tileSize;
+						if( rowEnd > end )
+							rowEnd = end;
+						if( columnEnd > end )
+							columnEnd = end;
+
+						// tiles on the diagonal contain only pairs above it
+						for( int i = first + row * tileSize; i < rowEnd; i++ )
+						{
+							GaItem& item1 = _provider( _storage, i );
+
+							// tile on the diagonal is the first tile of its rows, so it performs operation on their items
+							if( row == column )
+							{
+								_branch.SelectRandomSubstream( _randomEpoch, i );
+								operation1( item1, i );
+							}
+
+							for( int j = row == column ? i + 1 : first + column * tileSize; j < columnEnd; j++ )
+							{
+								_branch.SelectRandomSubstream( _randomEpoch, i, j );
+								operation2( item1, _provider( _storage, j ), i, j );
+							}
+						}
+					}
+				}
+				distributor.Exit( cursor, branchCount );
+			}
+
+			/// <summary><c>ClaimWork</c> method claims chunk of work from shared cursor according to used scheduling method.</summary>
+			/// <param name="distributor">object that stores shared cursor.</param>
+			/// <param name="cursor">ID of the shared cursor.</param>
+			/// <param name="end">index of the item that follows the last item of the workload.</param>
+			/// <param name="branchCount">number of branches that execute the operation.</param>
+			/// <param name="chunkSize">number of items claimed by dynamic scheduling or minimal number of items claimed by guided scheduling.</param>
+			/// <param name="start">reference to variable that will store index of the first claimed item.</param>
+			/// <param name="count">reference to variable that will store number of claimed items.</param>
+			/// <returns>Method returns <c>false</c> if there are no more items to claim.</returns>
+			inline bool GACALL ClaimWork(GaWorkDistributor& distributor,
+				int cursor,
+				int end,
+				int branchCount,
+				int chunkSize,
+				int& start,
+				int& count)
+			{
+				return _scheduling == GAPS_GUIDED ? distributor.ClaimGuided( cursor, end, branchCount, chunkSize, start, count ) : distributor.Claim( cursor, end, chunkSize, start, count );
+			}
+
+			/// <summary><c>GetPair</c> method calculates indices of items that form pair at specified position in the linear order of all pairs.</summary>
+			/// <param name="index">position of the pair.</param>
+			/// <param name="i">reference to variable that will store index of the first item of the pair.</param>
+			/// <param name="j">reference to variable that will store index of the second item of the pair.</param>
+			void GACALL GetPair(int index,
+				int& i,
+				int& j) const
+			{
+				// skip rows of pairs that precede the pair
+				for( i = _provider.GetStart(); index >= _storageSize - i - 1; i++ )
+					index -= _storageSize - i - 1;
+
+				j = i + 1 + index;
+			}
+
 		};
 
 	} // Workflows